@@ -0,0 +1,1114 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/AVSystem.h>
+#include <djvAV/AudioData.h>
+#include <djvAV/Color.h>
+#include <djvAV/IO.h>
+#include <djvAV/ImageResample.h>
+#include <djvAV/OpenGL.h>
+#include <djvAV/Render2D.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/FileSystem.h>
+#include <djvCore/Memory.h>
+#include <djvCore/Path.h>
+#include <djvCore/PicoJSON.h>
+#include <djvCore/Vector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <random>
+
+using namespace djv;
+
+namespace djv
+{
+    //! This namespace provides functionality for djv_bench.
+    namespace bench
+    {
+        namespace
+        {
+            const size_t            frameCountDefault   = 100;
+            const AV::Image::Size   sizeDefault         = AV::Image::Size(1920, 1080);
+            const AV::Image::Type   typeDefault         = AV::Image::Type::RGB_U8;
+            const std::string       extensionDefault    = ".ppm";
+            const size_t            threadCountDefault  = 4;
+            const size_t            queueSizeDefault    = 10;
+            const size_t            cacheSizeDefault    = 1024;
+            const size_t            loopCountDefault    = 2;
+            const size_t            scrubCountDefault   = 50;
+            const float             speedDefault        = 24.F;
+
+            //! \todo Should this be configurable?
+            const std::chrono::seconds frameTimeout(10);
+
+            enum class Mode
+            {
+                Forward,
+                Reverse,
+                Scrub,
+                Jog,
+
+                Count,
+                First = Forward
+            };
+
+            const std::vector<std::string> modeLabels =
+            {
+                "forward",
+                "reverse",
+                "scrub",
+                "jog"
+            };
+
+            //! This struct provides the results of a benchmark pass.
+            struct Result
+            {
+                Mode                    mode            = Mode::First;
+                size_t                  frameCount      = 0;
+                float                   time            = 0.F;
+                float                   firstFrameTime  = 0.F;
+                std::vector<float>      latencies;
+                size_t                  droppedFrames   = 0;
+                size_t                  timeoutCount    = 0;
+                AV::IO::ReadStats       stats;
+            };
+
+            float getPercentile(const std::vector<float>& sorted, float percentile)
+            {
+                float out = 0.F;
+                if (sorted.size())
+                {
+                    const size_t i = std::min(
+                        static_cast<size_t>(percentile / 100.F * sorted.size()),
+                        sorted.size() - 1);
+                    out = sorted[i];
+                }
+                return out;
+            }
+
+            picojson::value toJSON(const Result& value)
+            {
+                std::vector<float> latencies = value.latencies;
+                std::sort(latencies.begin(), latencies.end());
+                picojson::value latency(picojson::object_type, true);
+                latency.get<picojson::object>()["p50"] = djv::toJSON(getPercentile(latencies, 50.F) * 1000.F);
+                latency.get<picojson::object>()["p90"] = djv::toJSON(getPercentile(latencies, 90.F) * 1000.F);
+                latency.get<picojson::object>()["p99"] = djv::toJSON(getPercentile(latencies, 99.F) * 1000.F);
+                latency.get<picojson::object>()["max"] = djv::toJSON((latencies.size() ? latencies.back() : 0.F) * 1000.F);
+
+                // The first frame includes the time to seek, so it is not
+                // included in the sustained frame rate.
+                const float sustainedTime = value.time - value.firstFrameTime;
+                const float fps = value.frameCount > 1 && sustainedTime > 0.F ?
+                    ((value.frameCount - 1) / sustainedTime) :
+                    0.F;
+                const size_t cacheCount = value.stats.cacheHitCount + value.stats.cacheMissCount;
+                const float cacheHitRate = cacheCount ?
+                    (value.stats.cacheHitCount / static_cast<float>(cacheCount)) :
+                    0.F;
+
+                picojson::value out(picojson::object_type, true);
+                auto& object = out.get<picojson::object>();
+                object["mode"] = djv::toJSON(modeLabels[static_cast<size_t>(value.mode)]);
+                object["frames"] = djv::toJSON(value.frameCount);
+                object["time"] = djv::toJSON(value.time);
+                object["fps"] = djv::toJSON(fps);
+                object["firstFrameMs"] = djv::toJSON(value.firstFrameTime * 1000.F);
+                object["latencyMs"] = latency;
+                object["droppedFrames"] = djv::toJSON(value.droppedFrames);
+                object["timeouts"] = djv::toJSON(value.timeoutCount);
+                object["framesRead"] = djv::toJSON(value.stats.readCount);
+                object["bytesRead"] = djv::toJSON(static_cast<size_t>(value.stats.readByteCount));
+                object["cacheHitRate"] = djv::toJSON(cacheHitRate);
+                return out;
+            }
+
+        } // namespace
+
+        class Application : public CmdLine::Application
+        {
+            DJV_NON_COPYABLE(Application);
+
+        protected:
+            void _init(int& argc, char** argv);
+
+            Application();
+
+        public:
+            static std::shared_ptr<Application> create(int& argc, char** argv);
+
+            void tick(float dt) override;
+
+        private:
+            bool _parseArgs();
+            void _printUsage();
+
+            Core::FileSystem::FileInfo _generate();
+            void _open(const Core::FileSystem::FileInfo&);
+            Result _play(AV::IO::Direction);
+            Result _seek(Mode, const std::vector<Core::Frame::Index>&);
+            bool _waitFrame(Core::Frame::Index, std::chrono::high_resolution_clock::time_point&);
+            void _resample();
+            void _audio();
+            void _render();
+            void _writeResults(const std::vector<Result>&);
+            void _writeJSON(const picojson::value&);
+
+            std::string _input;
+            std::string _output;
+            std::vector<Mode> _modes;
+            std::unique_ptr<size_t> _frameCount;
+            std::unique_ptr<AV::Image::Size> _size;
+            std::unique_ptr<AV::Image::Type> _type;
+            std::string _extension = extensionDefault;
+            size_t _threadCount = threadCountDefault;
+            size_t _queueSize = queueSizeDefault;
+            bool _cacheEnabled = false;
+            size_t _cacheSize = cacheSizeDefault;
+            size_t _loopCount = loopCountDefault;
+            size_t _scrubCount = scrubCountDefault;
+            float _speed = speedDefault;
+            std::unique_ptr<float> _resampleScale;
+            std::unique_ptr<size_t> _audioChannelCount;
+            std::unique_ptr<AV::Render::Backend> _renderBackend;
+            std::shared_ptr<AV::IO::IRead> _read;
+            AV::IO::Info _info;
+            size_t _sequenceSize = 0;
+        };
+
+        void Application::_init(int& argc, char** argv)
+        {
+            std::vector<std::string> args;
+            for (int i = 0; i < argc; ++i)
+            {
+                args.push_back(argv[i]);
+            }
+            CmdLine::Application::_init(args);
+
+            if (!_parseArgs())
+            {
+                exit(1);
+                return;
+            }
+
+            if (!_frameCount)
+            {
+                _frameCount.reset(new size_t(frameCountDefault));
+            }
+            if (!_size)
+            {
+                _size.reset(new AV::Image::Size(sizeDefault));
+            }
+            if (!_type)
+            {
+                _type.reset(new AV::Image::Type(typeDefault));
+            }
+            if (_renderBackend)
+            {
+                // The renderer is created before anything requests it so that
+                // the software backend can run without a display.
+                AV::Render::Render2D::create(shared_from_this(), *_renderBackend);
+            }
+            if (!_modes.size())
+            {
+                for (size_t i = 0; i < static_cast<size_t>(Mode::Count); ++i)
+                {
+                    _modes.push_back(static_cast<Mode>(i));
+                }
+            }
+        }
+
+        Application::Application()
+        {}
+
+        std::shared_ptr<Application> Application::create(int& argc, char** argv)
+        {
+            auto out = std::shared_ptr<Application>(new Application);
+            out->_init(argc, argv);
+            return out;
+        }
+
+        void Application::tick(float dt)
+        {
+            CmdLine::Application::tick(dt);
+
+            if (_resampleScale)
+            {
+                _resample();
+                exit(0);
+                return;
+            }
+            if (_audioChannelCount)
+            {
+                _audio();
+                exit(0);
+                return;
+            }
+            if (_renderBackend)
+            {
+                _render();
+                exit(0);
+                return;
+            }
+
+            // The benchmark waits on the I/O queues directly so that the
+            // timings are not limited by the application tick rate.
+            Core::FileSystem::FileInfo fileInfo;
+            if (!_input.empty())
+            {
+                auto io = getSystemT<AV::IO::System>();
+                fileInfo = Core::FileSystem::FileInfo::getFileSequence(
+                    Core::FileSystem::Path(_input),
+                    io->getSequenceExtensions());
+            }
+            else
+            {
+                fileInfo = _generate();
+            }
+            _open(fileInfo);
+
+            std::vector<Result> results;
+            std::minstd_rand rand(1);
+            for (auto mode : _modes)
+            {
+                switch (mode)
+                {
+                case Mode::Forward:
+                    results.push_back(_play(AV::IO::Direction::Forward));
+                    break;
+                case Mode::Reverse:
+                    results.push_back(_play(AV::IO::Direction::Reverse));
+                    break;
+                case Mode::Scrub:
+                {
+                    // Random jumps across the sequence.
+                    std::vector<Core::Frame::Index> frames;
+                    for (size_t i = 0; i < _scrubCount; ++i)
+                    {
+                        frames.push_back(static_cast<Core::Frame::Index>(rand() % _sequenceSize));
+                    }
+                    results.push_back(_seek(mode, frames));
+                    break;
+                }
+                case Mode::Jog:
+                {
+                    // Short steps back and forth, like dragging the timeline.
+                    std::vector<Core::Frame::Index> frames;
+                    Core::Frame::Index frame = 0;
+                    for (size_t i = 0; i < _scrubCount; ++i)
+                    {
+                        frame += (i % 12) < 8 ? 1 : -1;
+                        frames.push_back(frame % static_cast<Core::Frame::Index>(_sequenceSize));
+                    }
+                    results.push_back(_seek(mode, frames));
+                    break;
+                }
+                default: break;
+                }
+            }
+            _writeResults(results);
+            exit(0);
+        }
+
+        Core::FileSystem::FileInfo Application::_generate()
+        {
+            const Core::FileSystem::Path dir(Core::FileSystem::Path::getTemp(), "djv_bench");
+            if (!Core::FileSystem::FileInfo(dir).doesExist())
+            {
+                Core::FileSystem::Path::mkdir(dir);
+            }
+            Core::FileSystem::FileInfo fileInfo(Core::FileSystem::Path(dir, "bench.1" + _extension));
+            fileInfo.evalSequence();
+
+            const AV::Image::Info info(*_size, *_type);
+            AV::IO::Info ioInfo;
+            ioInfo.video.push_back(AV::IO::VideoInfo(info));
+            auto io = getSystemT<AV::IO::System>();
+            auto write = io->write(fileInfo, ioInfo);
+            std::cerr << DJV_TEXT("Generating") << " " << *_frameCount << " " << DJV_TEXT("frames in") << " " << dir << std::endl;
+            size_t frame = 0;
+            while (write->isRunning())
+            {
+                std::shared_ptr<AV::Image::Image> image;
+                if (frame < *_frameCount)
+                {
+                    // Fill the image with a moving ramp so that each frame is
+                    // different and compressed formats do not degenerate.
+                    image = AV::Image::Image::create(info);
+                    uint8_t* p = image->getData();
+                    const size_t byteCount = image->getDataByteCount();
+                    for (size_t i = 0; i < byteCount; ++i)
+                    {
+                        p[i] = static_cast<uint8_t>((i >> 4) + frame * 8);
+                    }
+                }
+                std::unique_lock<std::mutex> lock(write->getMutex());
+                auto& queue = write->getVideoQueue();
+                // The writer wakes the queue when it has finished.
+                queue.wait(
+                    lock,
+                    std::chrono::milliseconds(100),
+                    [&write, &queue]
+                    {
+                        return !write->isRunning() || (!queue.isFinished() && queue.getCount() < queue.getMax());
+                    });
+                if (image && queue.getCount() < queue.getMax())
+                {
+                    queue.addFrame(AV::IO::VideoFrame(frame, image));
+                    ++frame;
+                }
+                if (frame >= *_frameCount)
+                {
+                    queue.setFinished(true);
+                }
+            }
+            return Core::FileSystem::FileInfo::getFileSequence(
+                fileInfo.getPath(),
+                io->getSequenceExtensions());
+        }
+
+        void Application::_open(const Core::FileSystem::FileInfo& fileInfo)
+        {
+            auto io = getSystemT<AV::IO::System>();
+            AV::IO::ReadOptions options;
+            options.videoQueueSize = _queueSize;
+            _read = io->read(fileInfo, options);
+            _read->setThreadCount(_threadCount);
+            _read->setCacheMaxByteCount(_cacheSize * Core::Memory::megabyte);
+            _read->setCacheEnabled(_cacheEnabled);
+            _read->setStatsEnabled(true);
+            _info = _read->getInfo().get();
+            if (!_info.video.size() || !_info.video[0].sequence.getSize())
+            {
+                std::stringstream ss;
+                ss << DJV_TEXT("The file") << " '" << fileInfo << "' " << DJV_TEXT("does not contain any video") << ".";
+                throw Core::FileSystem::Error(ss.str());
+            }
+            _sequenceSize = _info.video[0].sequence.getSize();
+        }
+
+        Result Application::_play(AV::IO::Direction direction)
+        {
+            Result out;
+            out.mode = AV::IO::Direction::Forward == direction ? Mode::Forward : Mode::Reverse;
+            const Core::Frame::Index start = AV::IO::Direction::Forward == direction ? 0 : static_cast<Core::Frame::Index>(_sequenceSize - 1);
+            const size_t frameCount = _sequenceSize * _loopCount;
+            const float frameTime = 1.F / _speed;
+
+            _read->resetStats();
+            const auto t0 = std::chrono::high_resolution_clock::now();
+            _read->setPlayback(true);
+            _read->seek(start, direction);
+            auto t = t0;
+            if (_waitFrame(start, t))
+            {
+                const std::chrono::duration<float> delta = t - t0;
+                out.firstFrameTime = delta.count();
+                out.latencies.push_back(delta.count());
+                out.frameCount = 1;
+            }
+            else
+            {
+                ++out.timeoutCount;
+            }
+            while (out.frameCount > 0 && out.frameCount < frameCount)
+            {
+                std::unique_lock<std::mutex> lock(_read->getMutex());
+                auto& queue = _read->getVideoQueue();
+                if (queue.wait(
+                    lock,
+                    frameTimeout,
+                    [&queue]
+                    {
+                        return !queue.isEmpty() || queue.isFinished();
+                    }) && !queue.isEmpty())
+                {
+                    queue.popFrame();
+                    lock.unlock();
+                    const auto now = std::chrono::high_resolution_clock::now();
+                    const std::chrono::duration<float> delta = now - t;
+                    t = now;
+                    out.latencies.push_back(delta.count());
+                    if (delta.count() > frameTime)
+                    {
+                        ++out.droppedFrames;
+                    }
+                    ++out.frameCount;
+                }
+                else
+                {
+                    ++out.timeoutCount;
+                    break;
+                }
+            }
+            const std::chrono::duration<float> delta = t - t0;
+            out.time = delta.count();
+            _read->setPlayback(false);
+            out.stats = _read->getStats();
+            return out;
+        }
+
+        Result Application::_seek(Mode mode, const std::vector<Core::Frame::Index>& frames)
+        {
+            Result out;
+            out.mode = mode;
+            const float frameTime = 1.F / _speed;
+
+            _read->resetStats();
+            const auto t0 = std::chrono::high_resolution_clock::now();
+            auto t = t0;
+            for (const auto frame : frames)
+            {
+                const auto seekTime = std::chrono::high_resolution_clock::now();
+                _read->seek(frame, AV::IO::Direction::Forward);
+                if (_waitFrame(frame, t))
+                {
+                    const std::chrono::duration<float> delta = t - seekTime;
+                    if (!out.frameCount)
+                    {
+                        out.firstFrameTime = delta.count();
+                    }
+                    out.latencies.push_back(delta.count());
+                    if (delta.count() > frameTime)
+                    {
+                        ++out.droppedFrames;
+                    }
+                    ++out.frameCount;
+                }
+                else
+                {
+                    ++out.timeoutCount;
+                }
+            }
+            const std::chrono::duration<float> delta = t - t0;
+            out.time = delta.count();
+            out.stats = _read->getStats();
+            return out;
+        }
+
+        bool Application::_waitFrame(Core::Frame::Index frame, std::chrono::high_resolution_clock::time_point& t)
+        {
+            // Discard the frames that were queued before the seek.
+            bool out = false;
+            const auto timeout = std::chrono::high_resolution_clock::now() + frameTimeout;
+            while (!out && std::chrono::high_resolution_clock::now() < timeout)
+            {
+                std::unique_lock<std::mutex> lock(_read->getMutex());
+                auto& queue = _read->getVideoQueue();
+                if (queue.wait(
+                    lock,
+                    frameTimeout,
+                    [&queue]
+                    {
+                        return !queue.isEmpty();
+                    }))
+                {
+                    out = queue.popFrame().frame == frame;
+                }
+            }
+            t = std::chrono::high_resolution_clock::now();
+            return out;
+        }
+
+        void Application::_resample()
+        {
+            // Each filter resamples a generated image, the rate is given in
+            // input megapixels per second.
+            const AV::Image::Info inInfo(*_size, *_type);
+            auto in = AV::Image::Data::create(inInfo);
+            uint8_t* p = in->getData();
+            const size_t byteCount = in->getDataByteCount();
+            for (size_t i = 0; i < byteCount; ++i)
+            {
+                p[i] = static_cast<uint8_t>(i >> 4);
+            }
+            const AV::Image::Size outSize(
+                std::max(static_cast<uint32_t>(roundf(inInfo.size.w * *_resampleScale)), static_cast<uint32_t>(1)),
+                std::max(static_cast<uint32_t>(roundf(inInfo.size.h * *_resampleScale)), static_cast<uint32_t>(1)));
+            auto out = AV::Image::Data::create(AV::Image::Info(outSize, inInfo.type));
+            const float megapixels = inInfo.size.w * static_cast<float>(inInfo.size.h) * _loopCount / 1000000.F;
+
+            picojson::value passes(picojson::array_type, true);
+            for (auto filter : AV::Image::getResampleFilterEnums())
+            {
+                const auto t0 = std::chrono::high_resolution_clock::now();
+                for (size_t i = 0; i < _loopCount; ++i)
+                {
+                    AV::Image::resample(*in, *out, filter, _threadCount);
+                }
+                const std::chrono::duration<float> delta = std::chrono::high_resolution_clock::now() - t0;
+                picojson::value pass(picojson::object_type, true);
+                auto& object = pass.get<picojson::object>();
+                std::stringstream ss;
+                ss << filter;
+                object["filter"] = djv::toJSON(ss.str());
+                object["time"] = djv::toJSON(delta.count());
+                object["megapixelsPerSecond"] = djv::toJSON(delta.count() > 0.F ? (megapixels / delta.count()) : 0.F);
+                passes.get<picojson::array>().push_back(pass);
+            }
+
+            picojson::value input(picojson::object_type, true);
+            {
+                auto& object = input.get<picojson::object>();
+                object["size"] = djv::toJSON(inInfo.size);
+                std::stringstream ss;
+                ss << inInfo.type;
+                object["type"] = djv::toJSON(ss.str());
+            }
+            picojson::value options(picojson::object_type, true);
+            {
+                auto& object = options.get<picojson::object>();
+                object["threads"] = djv::toJSON(_threadCount);
+                object["loops"] = djv::toJSON(_loopCount);
+                object["size"] = djv::toJSON(outSize);
+            }
+            picojson::value json(picojson::object_type, true);
+            json.get<picojson::object>()["input"] = input;
+            json.get<picojson::object>()["options"] = options;
+            json.get<picojson::object>()["results"] = passes;
+            _writeJSON(json);
+        }
+
+        void Application::_audio()
+        {
+            // Each pass processes ten seconds of generated audio, the rate is
+            // given in megasamples per second counting every channel.
+            const size_t sampleRate = 48000;
+            const uint8_t channelCount = static_cast<uint8_t>(*_audioChannelCount);
+            const AV::Audio::Info info(channelCount, AV::Audio::Type::F32, sampleRate, sampleRate * 10);
+            auto f32 = AV::Audio::Data::create(info);
+            auto p = reinterpret_cast<AV::Audio::F32_T*>(f32->getData());
+            const size_t size = info.sampleCount * info.channelCount;
+            for (size_t i = 0; i < size; ++i)
+            {
+                p[i] = sinf(i * .01F);
+            }
+            auto s16 = AV::Audio::Data::convert(f32, AV::Audio::Type::S16);
+            auto s32 = AV::Audio::Data::convert(f32, AV::Audio::Type::S32);
+            auto f64 = AV::Audio::Data::convert(f32, AV::Audio::Type::F64);
+            auto tmp = AV::Audio::Data::create(info);
+            const uint8_t downmixChannelCount = std::min(channelCount, static_cast<uint8_t>(2));
+            auto downmix = AV::Audio::Data::create(AV::Audio::Info(
+                downmixChannelCount, AV::Audio::Type::F32, sampleRate, info.sampleCount));
+            const auto downmixMatrix = AV::Audio::Data::getDownmixMatrix(channelCount, downmixChannelCount);
+            const float megasamples = size * _loopCount / 1000000.F;
+
+            const std::vector<std::pair<std::string, std::function<void(void)> > > kernels =
+            {
+                { "convertS16F32", [&] { AV::Audio::Data::convert(*s16, *tmp); } },
+                { "convertF32S16", [&] { AV::Audio::Data::convert(*f32, *s16); } },
+                { "convertS32F32", [&] { AV::Audio::Data::convert(*s32, *tmp); } },
+                { "convertF32S32", [&] { AV::Audio::Data::convert(*f32, *s32); } },
+                { "convertF64F32", [&] { AV::Audio::Data::convert(*f64, *tmp); } },
+                { "planarInterleave", [&] { AV::Audio::Data::planarInterleave(*f32, *tmp); } },
+                { "planarDeinterleave", [&] { AV::Audio::Data::planarDeinterleave(*f32, *tmp); } },
+                { "volume", [&]
+                    {
+                        AV::Audio::Data::volume(
+                            f32->getData(), tmp->getData(), .5F, info.sampleCount, info.channelCount, info.type);
+                    } },
+                { "volumeRamp", [&]
+                    {
+                        AV::Audio::Data::volume(
+                            f32->getData(), tmp->getData(), 0.F, 1.F, info.sampleCount, info.channelCount, info.type);
+                    } },
+                { "downmix", [&]
+                    {
+                        AV::Audio::Data::downmix(
+                            f32->getData(),
+                            downmix->getData(),
+                            info.sampleCount,
+                            channelCount,
+                            downmixChannelCount,
+                            info.type,
+                            downmixMatrix.data());
+                    } }
+            };
+            picojson::value passes(picojson::array_type, true);
+            for (const auto& kernel : kernels)
+            {
+                const auto t0 = std::chrono::high_resolution_clock::now();
+                for (size_t i = 0; i < _loopCount; ++i)
+                {
+                    kernel.second();
+                }
+                const std::chrono::duration<float> delta = std::chrono::high_resolution_clock::now() - t0;
+                picojson::value pass(picojson::object_type, true);
+                auto& object = pass.get<picojson::object>();
+                object["kernel"] = djv::toJSON(kernel.first);
+                object["time"] = djv::toJSON(delta.count());
+                object["megasamplesPerSecond"] = djv::toJSON(delta.count() > 0.F ? (megasamples / delta.count()) : 0.F);
+                passes.get<picojson::array>().push_back(pass);
+            }
+
+            picojson::value input(picojson::object_type, true);
+            {
+                auto& object = input.get<picojson::object>();
+                object["channels"] = djv::toJSON(static_cast<int>(info.channelCount));
+                object["sampleRate"] = djv::toJSON(static_cast<int>(info.sampleRate));
+                object["samples"] = djv::toJSON(info.sampleCount);
+            }
+            picojson::value options(picojson::object_type, true);
+            {
+                auto& object = options.get<picojson::object>();
+                object["loops"] = djv::toJSON(_loopCount);
+            }
+            picojson::value json(picojson::object_type, true);
+            json.get<picojson::object>()["input"] = input;
+            json.get<picojson::object>()["options"] = options;
+            json.get<picojson::object>()["results"] = passes;
+            _writeJSON(json);
+        }
+
+        void Application::_render()
+        {
+            // Each frame draws a new copy of a generated image with color
+            // adjustments and an overlay, like the viewer does during
+            // playback. Only the drawing is timed.
+            const AV::Image::Info info(*_size, *_type);
+            auto source = AV::Image::Data::create(info);
+            uint8_t* p = source->getData();
+            const size_t byteCount = source->getDataByteCount();
+            for (size_t i = 0; i < byteCount; ++i)
+            {
+                p[i] = static_cast<uint8_t>(i >> 4);
+            }
+            AV::Render::ImageOptions options;
+            options.colorEnabled = true;
+            options.color.saturation = .5F;
+            options.levelsEnabled = true;
+            options.levels.gamma = 2.2F;
+
+            auto render = getSystemT<AV::Render::Render2D>();
+            const size_t frameCount = *_frameCount;
+            std::vector<float> frameTimes;
+            size_t primitiveCount = 0;
+            size_t drawCount = 0;
+            for (size_t frame = 0; frame < frameCount; ++frame)
+            {
+                auto image = AV::Image::Image::create(info);
+                memcpy(image->getData(), source->getData(), byteCount);
+
+                const auto t0 = std::chrono::high_resolution_clock::now();
+                render->beginFrame(info.size);
+                render->setFillColor(AV::Image::Color(0.F, 0.F, 0.F));
+                render->drawRect(Core::BBox2f(0.F, 0.F, info.size.w, info.size.h));
+                render->drawImage(image, glm::vec2(0.F, 0.F), options);
+                render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F, .5F));
+                render->drawRect(Core::BBox2f(0.F, info.size.h * .9F, info.size.w, info.size.h * .1F));
+                render->endFrame();
+                if (AV::Render::Backend::OpenGL == render->getBackend())
+                {
+                    glFinish();
+                }
+                const std::chrono::duration<float> delta = std::chrono::high_resolution_clock::now() - t0;
+                frameTimes.push_back(delta.count());
+                primitiveCount = render->getPrimitiveCount();
+                drawCount = render->getDrawCount();
+            }
+            if (AV::Render::Backend::Software == render->getBackend())
+            {
+                auto image = render->getImage();
+                if (!image || image->getSize() != info.size)
+                {
+                    throw std::runtime_error(DJV_TEXT("The software renderer did not produce an image."));
+                }
+            }
+
+            float time = 0.F;
+            for (auto i : frameTimes)
+            {
+                time += i;
+            }
+            std::sort(frameTimes.begin(), frameTimes.end());
+            picojson::value frameTime(picojson::object_type, true);
+            frameTime.get<picojson::object>()["p50"] = djv::toJSON(getPercentile(frameTimes, 50.F) * 1000.F);
+            frameTime.get<picojson::object>()["p90"] = djv::toJSON(getPercentile(frameTimes, 90.F) * 1000.F);
+            frameTime.get<picojson::object>()["max"] = djv::toJSON((frameTimes.size() ? frameTimes.back() : 0.F) * 1000.F);
+            picojson::value result(picojson::object_type, true);
+            {
+                auto& object = result.get<picojson::object>();
+                std::stringstream ss;
+                ss << render->getBackend();
+                object["backend"] = djv::toJSON(ss.str());
+                object["frames"] = djv::toJSON(frameCount);
+                object["time"] = djv::toJSON(time);
+                object["fps"] = djv::toJSON(time > 0.F ? (frameCount / time) : 0.F);
+                object["frameTimeMs"] = frameTime;
+                object["primitives"] = djv::toJSON(primitiveCount);
+                object["drawCalls"] = djv::toJSON(drawCount);
+            }
+
+            picojson::value input(picojson::object_type, true);
+            {
+                auto& object = input.get<picojson::object>();
+                object["size"] = djv::toJSON(info.size);
+                std::stringstream ss;
+                ss << info.type;
+                object["type"] = djv::toJSON(ss.str());
+            }
+            picojson::value passes(picojson::array_type, true);
+            passes.get<picojson::array>().push_back(result);
+            picojson::value json(picojson::object_type, true);
+            json.get<picojson::object>()["input"] = input;
+            json.get<picojson::object>()["results"] = passes;
+            _writeJSON(json);
+        }
+
+        void Application::_writeResults(const std::vector<Result>& results)
+        {
+            const auto& videoInfo = _info.video[0];
+            picojson::value input(picojson::object_type, true);
+            {
+                auto& object = input.get<picojson::object>();
+                object["fileName"] = djv::toJSON(_info.fileName);
+                object["frames"] = djv::toJSON(_sequenceSize);
+                object["size"] = djv::toJSON(videoInfo.info.size);
+                std::stringstream ss;
+                ss << videoInfo.info.type;
+                object["type"] = djv::toJSON(ss.str());
+                object["frameByteCount"] = djv::toJSON(videoInfo.info.getDataByteCount());
+            }
+            picojson::value options(picojson::object_type, true);
+            {
+                auto& object = options.get<picojson::object>();
+                object["threads"] = djv::toJSON(_threadCount);
+                object["queueSize"] = djv::toJSON(_queueSize);
+                object["cache"] = djv::toJSON(_cacheEnabled);
+                object["cacheSize"] = djv::toJSON(_cacheSize);
+                object["loops"] = djv::toJSON(_loopCount);
+                object["speed"] = djv::toJSON(_speed);
+            }
+            picojson::value passes(picojson::array_type, true);
+            for (const auto& i : results)
+            {
+                passes.get<picojson::array>().push_back(toJSON(i));
+            }
+            picojson::value out(picojson::object_type, true);
+            out.get<picojson::object>()["input"] = input;
+            out.get<picojson::object>()["options"] = options;
+            out.get<picojson::object>()["results"] = passes;
+            _writeJSON(out);
+        }
+
+        void Application::_writeJSON(const picojson::value& value)
+        {
+            if (!_output.empty())
+            {
+                Core::FileSystem::FileIO fileIO;
+                fileIO.open(_output, Core::FileSystem::FileIO::Mode::Write);
+                Core::PicoJSON::write(value, fileIO);
+            }
+            else
+            {
+                std::cout << value.serialize(true) << std::endl;
+            }
+        }
+
+        bool Application::_parseArgs()
+        {
+            bool out = true;
+            auto args = getArgs();
+            auto i = args.begin();
+            try
+            {
+                while (i != args.end())
+                {
+                    if ("-h" == *i || "-help" == *i)
+                    {
+                        out = false;
+                        _printUsage();
+                        break;
+                    }
+                    else if ("-mode" == *i)
+                    {
+                        i = args.erase(i);
+                        const auto j = std::find(modeLabels.begin(), modeLabels.end(), *i);
+                        if (j == modeLabels.end())
+                        {
+                            throw std::invalid_argument(*i);
+                        }
+                        i = args.erase(i);
+                        _modes.push_back(static_cast<Mode>(j - modeLabels.begin()));
+                    }
+                    else if ("-frameCount" == *i)
+                    {
+                        i = args.erase(i);
+                        size_t value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _frameCount.reset(new size_t(value));
+                    }
+                    else if ("-size" == *i)
+                    {
+                        i = args.erase(i);
+                        AV::Image::Size value;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _size.reset(new AV::Image::Size(value));
+                    }
+                    else if ("-type" == *i)
+                    {
+                        i = args.erase(i);
+                        AV::Image::Type value = AV::Image::Type::None;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _type.reset(new AV::Image::Type(value));
+                    }
+                    else if ("-format" == *i)
+                    {
+                        i = args.erase(i);
+                        _extension = "." + *i;
+                        i = args.erase(i);
+                    }
+                    else if ("-threads" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _threadCount;
+                        i = args.erase(i);
+                    }
+                    else if ("-queueSize" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _queueSize;
+                        i = args.erase(i);
+                    }
+                    else if ("-cache" == *i)
+                    {
+                        i = args.erase(i);
+                        _cacheEnabled = true;
+                    }
+                    else if ("-cacheSize" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _cacheSize;
+                        i = args.erase(i);
+                    }
+                    else if ("-loops" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _loopCount;
+                        i = args.erase(i);
+                    }
+                    else if ("-scrubCount" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _scrubCount;
+                        i = args.erase(i);
+                    }
+                    else if ("-speed" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _speed;
+                        i = args.erase(i);
+                    }
+                    else if ("-resample" == *i)
+                    {
+                        i = args.erase(i);
+                        float value = 0.F;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        if (value <= 0.F)
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the argument"));
+                        }
+                        _resampleScale.reset(new float(value));
+                    }
+                    else if ("-audio" == *i)
+                    {
+                        i = args.erase(i);
+                        size_t value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        if (value < 1 || value > 8)
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the argument"));
+                        }
+                        _audioChannelCount.reset(new size_t(value));
+                    }
+                    else if ("-render" == *i)
+                    {
+                        i = args.erase(i);
+                        AV::Render::Backend value = AV::Render::Backend::First;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _renderBackend.reset(new AV::Render::Backend(value));
+                    }
+                    else if ("-output" == *i)
+                    {
+                        i = args.erase(i);
+                        _output = *i;
+                        i = args.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+            catch (const std::exception&)
+            {
+                out = false;
+                _printUsage();
+            }
+            if (out)
+            {
+                if (2 == args.size())
+                {
+                    _input = args[1];
+                }
+                else if (args.size() > 2 || 0 == _threadCount || 0 == _queueSize || 0 == _loopCount || _speed <= 0.F)
+                {
+                    out = false;
+                    _printUsage();
+                }
+            }
+            return out;
+        }
+
+        void Application::_printUsage()
+        {
+            std::cout << std::endl;
+            std::cout << DJV_TEXT(" Usage:") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   djv_bench [input] [option, ...]") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   If no input is given a test sequence is generated in the temp directory.") << std::endl;
+            std::cout << DJV_TEXT("   The results are written as JSON.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT(" Options:") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -mode (value)") << std::endl;
+            std::cout << DJV_TEXT("   Add a benchmark pass, this option may be used more than once. Options: forward, reverse, scrub, jog. Default: all") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -threads (value)") << std::endl;
+            std::cout << DJV_TEXT("   The number of I/O threads. Default: ") << threadCountDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -queueSize (value)") << std::endl;
+            std::cout << DJV_TEXT("   The video queue size. Default: ") << queueSizeDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -cache") << std::endl;
+            std::cout << DJV_TEXT("   Enable the frame cache.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -cacheSize (value)") << std::endl;
+            std::cout << DJV_TEXT("   The frame cache size in megabytes. Default: ") << cacheSizeDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -loops (value)") << std::endl;
+            std::cout << DJV_TEXT("   The number of times the playback passes loop through the sequence. Default: ") << loopCountDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -scrubCount (value)") << std::endl;
+            std::cout << DJV_TEXT("   The number of seeks for the scrub and jog passes. Default: ") << scrubCountDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -speed (value)") << std::endl;
+            std::cout << DJV_TEXT("   The target frame rate, frames that take longer are counted as dropped. Default: ") << speedDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -resample (scale)") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark resampling a generated image by the given scale with each filter instead of the I/O passes.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -audio (channels)") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark the audio conversion, channel, and volume functions with generated audio instead of the I/O passes.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -render (backend)") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark drawing a generated image with the given renderer instead of the I/O passes. The software renderer does not need a display. Options: OpenGL, Software") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -output (file)") << std::endl;
+            std::cout << DJV_TEXT("   Write the results to a file instead of the standard output.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -frameCount (value)") << std::endl;
+            std::cout << DJV_TEXT("   The number of frames to generate. Default: ") << frameCountDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -size \"(width) (height)\"") << std::endl;
+            std::cout << DJV_TEXT("   The generated image resolution. Default: ") << sizeDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -type (value)") << std::endl;
+            std::cout << DJV_TEXT("   The generated image type. Default: ") << typeDefault << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   -format (value)") << std::endl;
+            std::cout << DJV_TEXT("   The generated file format extension. Default: ") << extensionDefault.substr(1) << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT(" Examples:") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   > djv_bench") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark a generated HD sequence with the default values.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   > djv_bench -size '3840 2160' -type RGBA_F16 -format exr -threads 8 -cache") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark a generated UHD EXR sequence with eight threads and the cache enabled.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   > djv_bench render.0001.dpx -mode forward -mode scrub -output bench.json") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark forward playback and scrubbing of an existing sequence.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   > djv_bench -resample 0.5 -size '4096 2160' -type RGBA_F16 -threads 8") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark making half resolution proxies of a 4K image.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   > djv_bench -render Software -size '3840 2160' -frameCount 10") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark drawing UHD frames without a display.") << std::endl;
+            std::cout << std::endl;
+            std::cout << DJV_TEXT("   > djv_bench -audio 6 -loops 10") << std::endl;
+            std::cout << DJV_TEXT("   Benchmark the audio functions with 5.1 audio.") << std::endl;
+            std::cout << std::endl;
+        }
+
+    } // namespace bench
+} // namespace djv
+
+int main(int argc, char** argv)
+{
+    int r = 0;
+    try
+    {
+        return bench::Application::create(argc, argv)->run();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+        r = 1;
+    }
+    return r;
+}
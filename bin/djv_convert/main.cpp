@@ -38,6 +38,11 @@
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
 
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
 using namespace djv;
 
 namespace djv
@@ -73,6 +78,8 @@ namespace djv
                 }
                 AV::IO::ReadOptions readOptions;
                 readOptions.videoQueueSize = _readQueueSize;
+                readOptions.colorSpace = _inputColorSpace;
+                readOptions.outputColorSpace = _outputColorSpace;
                 _read = io->read(readFileInfo, readOptions);
                 _read->setThreadCount(_readThreadCount);
                 auto info = _read->getInfo().get();
@@ -86,6 +93,12 @@ namespace djv
                 {
                     video[0].info.size = *_resize;
                 }
+                else if (_scale)
+                {
+                    auto& size = video[0].info.size;
+                    size.w = std::max(static_cast<uint32_t>(roundf(size.w * *_scale)), static_cast<uint32_t>(1));
+                    size.h = std::max(static_cast<uint32_t>(roundf(size.h * *_scale)), static_cast<uint32_t>(1));
+                }
                 const size_t size = videoInfo.sequence.getSize();
                 Core::FileSystem::FileInfo writeFileInfo(argv[2]);
                 if (_writeSeq)
@@ -94,8 +107,19 @@ namespace djv
                 }
                 AV::IO::WriteOptions writeOptions;
                 writeOptions.videoQueueSize = _writeQueueSize;
+                writeOptions.resampleFilter = _resampleFilter;
                 _write = io->write(writeFileInfo, info, writeOptions);
                 _write->setThreadCount(_writeThreadCount);
+
+                // Move the frames from the read queue to the write queue as soon
+                // as they are available, rather than once per application tick.
+                _frame = 0;
+                _running = true;
+                _thread = std::thread(
+                    [this]
+                    {
+                        _transfer();
+                    });
                 
                 _statsTimer = Core::Time::Timer::create(shared_from_this());
                 _statsTimer->setRepeating(true);
@@ -103,26 +127,47 @@ namespace djv
                     Core::Time::getMilliseconds(Core::Time::TimerValue::Slow),
                     [this, size](float)
                 {
-                    Core::Frame::Number frame = 0;
-                    {
-                        std::lock_guard<std::mutex> lock(_read->getMutex());
-                        auto& queue = _read->getVideoQueue();
-                        if (!queue.isEmpty())
-                        {
-                            frame = queue.getFrame().frame;
-                        }
-                    }
+                    const Core::Frame::Number frame = _frame;
                     if (frame && size)
                     {
+                        std::lock_guard<std::mutex> lock(_outputMutex);
                         std::cout << static_cast<size_t>(frame / static_cast<float>(size - 1) * 100.F) << "%" << std::endl;
                     }
                 });
             }
 
-            Application()
+            Application() :
+                _frame(0),
+                _droppedCount(0),
+                _running(false)
             {}
 
         public:
+            ~Application() override
+            {
+                // Acquire the I/O mutexes before waking the transfer thread so that
+                // the notification cannot be missed.
+                _running = false;
+                if (_write)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_write->getMutex());
+                    }
+                    _write->getVideoQueue().notify();
+                }
+                if (_read)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(_read->getMutex());
+                    }
+                    _read->getVideoQueue().notify();
+                }
+                if (_thread.joinable())
+                {
+                    _thread.join();
+                }
+            }
+
             static std::shared_ptr<Application> create(int & argc, char ** argv)
             {
                 auto out = std::shared_ptr<Application>(new Application);
@@ -133,32 +178,85 @@ namespace djv
             void tick(float dt) override
             {
                 CmdLine::Application::tick(dt);
-                if (_read && _write)
+                if (_write && !_write->isRunning())
+                {
+                    exit(0 == _droppedCount ? 0 : 1);
+                }
+            }
+
+        private:
+            void _transfer()
+            {
+                const auto timeout = Core::Time::getMilliseconds(Core::Time::TimerValue::Medium);
+                while (_running)
                 {
-                    std::unique_lock<std::mutex> readLock(_read->getMutex(), std::try_to_lock);
-                    if (readLock.owns_lock())
+                    // Wait for a frame from the read queue.
+                    AV::IO::VideoFrame frame;
+                    bool popped = false;
+                    bool finished = false;
                     {
-                        std::lock_guard<std::mutex> writeLock(_write->getMutex());
-                        auto& readQueue = _read->getVideoQueue();
-                        auto& writeQueue = _write->getVideoQueue();
-                        if (!readQueue.isEmpty() && writeQueue.getCount() < writeQueue.getMax())
+                        std::unique_lock<std::mutex> lock(_read->getMutex());
+                        auto& queue = _read->getVideoQueue();
+                        if (queue.wait(
+                            lock,
+                            timeout,
+                            [this, &queue]
+                            {
+                                return !queue.isEmpty() || queue.isFinished() || !_running;
+                            }))
                         {
-                            auto frame = readQueue.popFrame();
-                            writeQueue.addFrame(frame);
+                            if (!queue.isEmpty())
+                            {
+                                frame = queue.popFrame();
+                                popped = true;
+                            }
+                            else if (queue.isFinished())
+                            {
+                                finished = true;
+                            }
                         }
-                        else if (readQueue.isFinished())
+                    }
+
+                    // Frames that could not be read are not written, report them
+                    // so they are not lost silently.
+                    if (popped && !frame.image)
+                    {
+                        ++_droppedCount;
+                        std::lock_guard<std::mutex> lock(_outputMutex);
+                        std::cout << DJV_TEXT("ERROR: Frame") << " " << frame.frame << " " <<
+                            DJV_TEXT("could not be read and was not written.") << std::endl;
+                    }
+
+                    // Wait for room in the write queue.
+                    if (frame.image || finished)
+                    {
+                        std::unique_lock<std::mutex> lock(_write->getMutex());
+                        auto& queue = _write->getVideoQueue();
+                        if (finished)
                         {
-                            writeQueue.setFinished(true);
+                            queue.setFinished(true);
+                            break;
+                        }
+                        bool ready = false;
+                        while (_running && !ready)
+                        {
+                            ready = queue.wait(
+                                lock,
+                                timeout,
+                                [this, &queue]
+                                {
+                                    return queue.getCount() < queue.getMax() || !_running;
+                                });
+                        }
+                        if (_running)
+                        {
+                            queue.addFrame(frame);
+                            _frame = frame.frame;
                         }
                     }
                 }
-                if (_write && !_write->isRunning())
-                {
-                    exit(0);
-                }
             }
 
-        private:
             bool _parseArgs()
             {
                 bool out = true;
@@ -181,6 +279,42 @@ namespace djv
                         i = args.erase(i);
                         _resize.reset(new AV::Image::Size(resize));
                     }
+                    else if ("-scale" == *i)
+                    {
+                        i = args.erase(i);
+                        float scale = 0.F;
+                        std::stringstream ss(*i);
+                        ss >> scale;
+                        i = args.erase(i);
+                        if (scale <= 0.F)
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the argument"));
+                        }
+                        _scale.reset(new float(scale));
+                    }
+                    else if ("-filter" == *i)
+                    {
+                        i = args.erase(i);
+                        std::stringstream ss(*i);
+                        ss >> _resampleFilter;
+                        i = args.erase(i);
+                    }
+                    else if ("-colorSpace" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the argument"));
+                        }
+                        _inputColorSpace = *i;
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the argument"));
+                        }
+                        _outputColorSpace = *i;
+                        i = args.erase(i);
+                    }
                     else if ("-readSeq" == *i)
                     {
                         i = args.erase(i);
@@ -257,6 +391,21 @@ namespace djv
                 std::cout << DJV_TEXT("   -resize \"(width) (height)\"") << std::endl;
                 std::cout << DJV_TEXT("   Resize the image.") << std::endl;
                 std::cout << std::endl;
+                std::cout << DJV_TEXT("   -scale (value)") << std::endl;
+                std::cout << DJV_TEXT("   Scale the image, for example 0.5 for half resolution proxies.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -filter (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the resampling filter. Options: ");
+                for (auto i : AV::Image::getResampleFilterEnums())
+                {
+                    std::cout << i << " ";
+                }
+                std::cout << DJV_TEXT("Default: ") << AV::Image::ResampleFilter::Mitchell << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -colorSpace (input) (output)") << std::endl;
+                std::cout << DJV_TEXT("   Convert the images between color spaces with the OpenColorIO configuration") << std::endl;
+                std::cout << DJV_TEXT("   given by the OCIO environment variable.") << std::endl;
+                std::cout << std::endl;
                 std::cout << DJV_TEXT("   -readSeq") << std::endl;
                 std::cout << DJV_TEXT("   Interpret the input file name as a sequence.") << std::endl;
                 std::cout << std::endl;
@@ -280,6 +429,10 @@ namespace djv
             std::string _input;
             std::string _output;
             std::unique_ptr<AV::Image::Size> _resize;
+            std::unique_ptr<float> _scale;
+            AV::Image::ResampleFilter _resampleFilter = AV::Image::ResampleFilter::Mitchell;
+            std::string _inputColorSpace;
+            std::string _outputColorSpace;
             bool _readSeq = false;
             bool _writeSeq = false;
             //! \todo What's a good default for this?
@@ -290,6 +443,11 @@ namespace djv
             std::shared_ptr<AV::IO::IRead> _read;
             std::shared_ptr<Core::Time::Timer> _statsTimer;
             std::shared_ptr<AV::IO::IWrite> _write;
+            std::atomic<Core::Frame::Number> _frame;
+            std::atomic<size_t> _droppedCount;
+            std::mutex _outputMutex;
+            std::atomic<bool> _running;
+            std::thread _thread;
         };
 
     } // namespace convert
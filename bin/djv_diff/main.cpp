@@ -0,0 +1,502 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCmdLineApp/Application.h>
+
+#include <djvAV/AVSystem.h>
+#include <djvAV/IO.h>
+#include <djvAV/ImageDiff.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Error.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/Timer.h>
+
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+using namespace djv;
+
+namespace djv
+{
+    //! This namespace provides functionality for djv_diff.
+    namespace diff
+    {
+        class Application : public CmdLine::Application
+        {
+            DJV_NON_COPYABLE(Application);
+
+        protected:
+            void _init(int & argc, char ** argv)
+            {
+                std::vector<std::string> args;
+                for (int i = 0; i < argc; ++i)
+                {
+                    args.push_back(argv[i]);
+                }
+                CmdLine::Application::_init(args);
+
+                if (!_parseArgs())
+                {
+                    exit(1);
+                    return;
+                }
+
+                // The inputs are read in parallel, each reader with its own
+                // queue and threads.
+                auto io = getSystemT<AV::IO::System>();
+                AV::IO::ReadOptions readOptions;
+                readOptions.videoQueueSize = _readQueueSize;
+                size_t size = 0;
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    Core::FileSystem::FileInfo fileInfo(_input[i]);
+                    if (_readSeq)
+                    {
+                        fileInfo.evalSequence();
+                    }
+                    _read[i] = io->read(fileInfo, readOptions);
+                    _read[i]->setThreadCount(_readThreadCount);
+                    const auto info = _read[i]->getInfo().get();
+                    if (!info.video.size())
+                    {
+                        throw std::invalid_argument(DJV_TEXT("Nothing to compare"));
+                    }
+                    _sequenceSize[i] = info.video[0].sequence.getSize();
+                    size = std::max(size, _sequenceSize[i]);
+                }
+
+                // Sequence readers wrap around instead of finishing, so the
+                // inputs are read up to their sizes.
+                if (_sequenceSize[0] && _sequenceSize[1] && _sequenceSize[0] != _sequenceSize[1])
+                {
+                    _frameCountMismatch = true;
+                }
+
+                // Compare the frames as soon as both of them are available.
+                _running = true;
+                _thread = std::thread(
+                    [this]
+                    {
+                        _compare();
+                    });
+
+                _statsTimer = Core::Time::Timer::create(shared_from_this());
+                _statsTimer->setRepeating(true);
+                _statsTimer->start(
+                    Core::Time::getMilliseconds(Core::Time::TimerValue::Slow),
+                    [this, size](float)
+                {
+                    const size_t frameCount = _frameCount;
+                    if (frameCount && size > 1)
+                    {
+                        std::lock_guard<std::mutex> lock(_outputMutex);
+                        std::cout << static_cast<size_t>(frameCount / static_cast<float>(size) * 100.F) << "%" << std::endl;
+                    }
+                });
+            }
+
+            Application() :
+                _frameCount(0),
+                _running(false),
+                _finished(false)
+            {}
+
+        public:
+            ~Application() override
+            {
+                // Acquire the I/O mutexes before waking the compare thread so that
+                // the notification cannot be missed.
+                _running = false;
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    if (_read[i])
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(_read[i]->getMutex());
+                        }
+                        _read[i]->getVideoQueue().notify();
+                    }
+                }
+                if (_thread.joinable())
+                {
+                    _thread.join();
+                }
+            }
+
+            static std::shared_ptr<Application> create(int & argc, char ** argv)
+            {
+                auto out = std::shared_ptr<Application>(new Application);
+                out->_init(argc, argv);
+                return out;
+            }
+
+            void tick(float dt) override
+            {
+                CmdLine::Application::tick(dt);
+                if (_finished)
+                {
+                    _finished = false;
+                    exit(_printSummary() ? 0 : 1);
+                }
+            }
+
+        private:
+            //! Wait for the next frame of an input. Returns false if all of the
+            //! frames of the input have been read, the input is finished, or
+            //! the application is exiting.
+            bool _popFrame(size_t index, AV::IO::VideoFrame& frame)
+            {
+                if (_inputFinished[index])
+                {
+                    return false;
+                }
+                const auto& read = _read[index];
+                const auto timeout = Core::Time::getMilliseconds(Core::Time::TimerValue::Medium);
+                std::unique_lock<std::mutex> lock(read->getMutex());
+                auto& queue = read->getVideoQueue();
+                while (_running)
+                {
+                    if (queue.wait(
+                        lock,
+                        timeout,
+                        [this, &queue]
+                        {
+                            return !queue.isEmpty() || queue.isFinished() || !_running;
+                        }))
+                    {
+                        if (!queue.isEmpty())
+                        {
+                            // Sequence readers wrap around at the end instead of
+                            // finishing, so the input is finished after the last
+                            // frame of the sequence or when the frames wrap.
+                            frame = queue.popFrame();
+                            if (frame.frame <= _lastFrame[index])
+                            {
+                                _inputFinished[index] = true;
+                                break;
+                            }
+                            _lastFrame[index] = frame.frame;
+                            if (_sequenceSize[index] &&
+                                frame.frame >= static_cast<Core::Frame::Index>(_sequenceSize[index]) - 1)
+                            {
+                                _inputFinished[index] = true;
+                            }
+                            return true;
+                        }
+                        else if (queue.isFinished())
+                        {
+                            _inputFinished[index] = true;
+                            break;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            //! Count a frame that is only available in one of the inputs as a
+            //! difference.
+            void _missingFrame(Core::Frame::Index frame, size_t index)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_outputMutex);
+                    ++_failedCount;
+                    std::cout << frame << ": " << DJV_TEXT("missing from") << " " << _input[index] << std::endl;
+                }
+                ++_frameCount;
+            }
+
+            void _compare()
+            {
+                try
+                {
+                    AV::IO::VideoFrame frames[2];
+                    bool valid[2] = { false, false };
+                    while (_running)
+                    {
+                        for (size_t i = 0; i < 2; ++i)
+                        {
+                            if (!valid[i])
+                            {
+                                valid[i] = _popFrame(i, frames[i]);
+                            }
+                        }
+                        if (!_running)
+                        {
+                            break;
+                        }
+                        if (!valid[0] && !valid[1])
+                        {
+                            break;
+                        }
+                        if (!valid[0] || !valid[1])
+                        {
+                            const size_t i = valid[0] ? 0 : 1;
+                            if (_sequenceSize[0] && _sequenceSize[1])
+                            {
+                                // The last frames of the other sequence could not
+                                // be read.
+                                _missingFrame(frames[i].frame, 1 - i);
+                                valid[i] = false;
+                                continue;
+                            }
+                            std::lock_guard<std::mutex> lock(_outputMutex);
+                            _frameCountMismatch = true;
+                            break;
+                        }
+
+                        // Frames that cannot be read are not queued, so the frame
+                        // numbers are matched up.
+                        if (frames[0].frame != frames[1].frame)
+                        {
+                            const size_t i = frames[0].frame < frames[1].frame ? 0 : 1;
+                            _missingFrame(frames[i].frame, 1 - i);
+                            valid[i] = false;
+                            continue;
+                        }
+                        valid[0] = false;
+                        valid[1] = false;
+                        if (!frames[0].image || !frames[1].image)
+                        {
+                            _missingFrame(frames[0].frame, !frames[0].image ? 0 : 1);
+                            continue;
+                        }
+
+                        const auto stats = AV::Image::getDifferenceStats(*frames[0].image, *frames[1].image, _threadCount);
+                        const bool sizeMismatch = frames[0].image->getSize() != frames[1].image->getSize();
+                        const bool failed = sizeMismatch || stats.getMaxError() > _threshold;
+                        {
+                            std::lock_guard<std::mutex> lock(_outputMutex);
+                            _stats.add(stats);
+                            if (failed)
+                            {
+                                ++_failedCount;
+                            }
+                            if (failed || _verbose)
+                            {
+                                std::cout << frames[0].frame << ": " << DJV_TEXT("max error") << " " <<
+                                    stats.getMaxError() << ", " << DJV_TEXT("PSNR") << " " << stats.getPSNR();
+                                if (sizeMismatch)
+                                {
+                                    std::cout << ", " << frames[0].image->getSize() << " != " << frames[1].image->getSize();
+                                }
+                                std::cout << std::endl;
+                            }
+                        }
+                        ++_frameCount;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    std::lock_guard<std::mutex> lock(_outputMutex);
+                    _error = e.what();
+                }
+                _finished = true;
+            }
+
+            //! Print the results, returns false if the inputs differ.
+            bool _printSummary()
+            {
+                std::lock_guard<std::mutex> lock(_outputMutex);
+                if (!_error.empty())
+                {
+                    std::cout << _error << std::endl;
+                    return false;
+                }
+                std::cout << DJV_TEXT("Frames") << ": " << _frameCount << std::endl;
+                std::cout << DJV_TEXT("Max error") << ":";
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    std::cout << " " << _stats.maxError[c];
+                }
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("PSNR") << ": " << _stats.getPSNR() << " dB" << std::endl;
+                std::cout << DJV_TEXT("Frames above threshold") << ": " << _failedCount << std::endl;
+                if (_frameCountMismatch)
+                {
+                    std::cout << DJV_TEXT("The inputs have a different number of frames") << std::endl;
+                }
+                return !_frameCountMismatch && 0 == _failedCount;
+            }
+
+            bool _parseArgs()
+            {
+                bool out = true;
+                auto args = getArgs();
+                auto i = args.begin();
+                while (i != args.end())
+                {
+                    if ("-h" == *i || "-help" == *i)
+                    {
+                        out = false;
+                        _printUsage();
+                        break;
+                    }
+                    else if ("-threshold" == *i)
+                    {
+                        i = args.erase(i);
+                        if (args.end() == i)
+                        {
+                            throw std::invalid_argument(DJV_TEXT("Cannot parse the argument"));
+                        }
+                        float value = 0.F;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _threshold = std::max(value, 0.F);
+                    }
+                    else if ("-verbose" == *i)
+                    {
+                        i = args.erase(i);
+                        _verbose = true;
+                    }
+                    else if ("-readSeq" == *i)
+                    {
+                        i = args.erase(i);
+                        _readSeq = true;
+                    }
+                    else if ("-readQueue" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _readQueueSize = std::max(value, 1);
+                    }
+                    else if ("-readThreads" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _readThreadCount = std::max(value, 1);
+                    }
+                    else if ("-threads" == *i)
+                    {
+                        i = args.erase(i);
+                        int value = 0;
+                        std::stringstream ss(*i);
+                        ss >> value;
+                        i = args.erase(i);
+                        _threadCount = std::max(value, 1);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (3 == args.size())
+                {
+                    _input[0] = args[1];
+                    _input[1] = args[2];
+                }
+                else
+                {
+                    out = false;
+                    _printUsage();
+                }
+                return out;
+            }
+
+            void _printUsage()
+            {
+                std::cout << std::endl;
+                std::cout << DJV_TEXT(" Usage:") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   djv_diff (input) (input) [option, ...]") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   Compare the frames of two inputs. The exit code is non-zero if the") << std::endl;
+                std::cout << DJV_TEXT("   maximum error of any frame is above the threshold.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT(" Options:") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -threshold (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the maximum error allowed for a channel, where one is the full") << std::endl;
+                std::cout << DJV_TEXT("   range of an integer type. Default: 0") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -verbose") << std::endl;
+                std::cout << DJV_TEXT("   Print the statistics of every frame.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readSeq") << std::endl;
+                std::cout << DJV_TEXT("   Interpret the input file names as sequences.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readQueue (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the size of the read queues.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -readThreads (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the number of threads for each reader.") << std::endl;
+                std::cout << std::endl;
+                std::cout << DJV_TEXT("   -threads (value)") << std::endl;
+                std::cout << DJV_TEXT("   Set the number of threads for comparing.") << std::endl;
+                std::cout << std::endl;
+            }
+
+            std::string _input[2];
+            float _threshold = 0.F;
+            bool _verbose = false;
+            bool _readSeq = false;
+            //! \todo What's a good default for this?
+            size_t _readQueueSize = 10;
+            size_t _readThreadCount = 4;
+            size_t _threadCount = 4;
+            std::shared_ptr<AV::IO::IRead> _read[2];
+            size_t _sequenceSize[2] = { 0, 0 };
+            Core::Frame::Index _lastFrame[2] = { -1, -1 };
+            bool _inputFinished[2] = { false, false };
+            std::shared_ptr<Core::Time::Timer> _statsTimer;
+            std::mutex _outputMutex;
+            AV::Image::DifferenceStats _stats;
+            size_t _failedCount = 0;
+            bool _frameCountMismatch = false;
+            std::string _error;
+            std::atomic<size_t> _frameCount;
+            std::atomic<bool> _running;
+            std::atomic<bool> _finished;
+            std::thread _thread;
+        };
+
+    } // namespace diff
+} // namespace djv
+
+int main(int argc, char ** argv)
+{
+    int r = 1;
+    try
+    {
+        return diff::Application::create(argc, argv)->run();
+    }
+    catch (const std::exception & e)
+    {
+        std::cout << Core::Error::format(e) << std::endl;
+    }
+    return r;
+}
@@ -58,9 +58,12 @@ namespace djv
                 CmdLine::Application::_init(args);
 
                 auto io = getSystemT<AV::IO::System>();
-                for (int i = 1; i < argc; ++i)
+                _startupFinished();
+
+                const auto& appArgs = getArgs();
+                for (size_t i = 1; i < appArgs.size(); ++i)
                 {
-                    const Core::FileSystem::FileInfo fileInfo(argv[i]);
+                    const Core::FileSystem::FileInfo fileInfo(appArgs[i]);
                     switch (fileInfo.getType())
                     {
                     case Core::FileSystem::FileType::File:
@@ -58,8 +58,6 @@ namespace djv
             std::shared_ptr<ValueSubject<Time::FPS> > defaultSpeed;
             std::shared_ptr<ValueSubject<Render::ImageFilterOptions> > imageFilterOptions;
             std::shared_ptr<ValueSubject<bool> > lcdText;
-            std::shared_ptr<ThumbnailSystem> thumbnailSystem;
-            std::shared_ptr<Render::Render2D> render2D;
         };
 
         void AVSystem::_init(const std::shared_ptr<Core::Context>& context)
@@ -73,21 +71,20 @@ namespace djv
             p.imageFilterOptions = ValueSubject<Render::ImageFilterOptions>::create();
             p.lcdText = ValueSubject<bool>::create(true);
 
-            auto glfwSystem = GLFW::System::create(context);
             auto ocioSystem = OCIO::System::create(context);
             auto ioSystem = IO::System::create(context);
-            auto fontSystem = Font::System::create(context);
-            p.thumbnailSystem = ThumbnailSystem::create(context);
-            p.render2D = Render::Render2D::create(context);
-            auto audioSystem = Audio::System::create(context);
 
-            addDependency(glfwSystem);
             addDependency(ocioSystem);
             addDependency(ioSystem);
-            addDependency(fontSystem);
-            addDependency(p.thumbnailSystem);
-            addDependency(p.render2D);
-            addDependency(audioSystem);
+
+            // These systems are only needed by some applications, so they are
+            // created the first time they are requested. GLFW requires a
+            // display, so it is only created by the systems that use OpenGL.
+            context->addSystemFactoryT<GLFW::System>();
+            context->addSystemFactoryT<Font::System>();
+            context->addSystemFactoryT<ThumbnailSystem>();
+            context->addSystemFactoryT<Render::Render2D>();
+            context->addSystemFactoryT<Audio::System>();
         }
 
         AVSystem::AVSystem() :
@@ -135,7 +132,13 @@ namespace djv
             if (p.defaultSpeed->setIfChanged(value))
             {
                 Time::setDefaultSpeed(value);
-                p.thumbnailSystem->clearCache();
+                if (auto context = getContext().lock())
+                {
+                    for (const auto& i : context->getSystemsT<ThumbnailSystem>())
+                    {
+                        i->clearCache();
+                    }
+                }
             }
         }
 
@@ -149,7 +152,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.imageFilterOptions->setIfChanged(value))
             {
-                p.render2D->setImageFilterOptions(value);
+                if (auto context = getContext().lock())
+                {
+                    if (auto render2D = context->getSystemT<Render::Render2D>())
+                    {
+                        render2D->setImageFilterOptions(value);
+                    }
+                }
             }
         }
 
@@ -163,7 +172,13 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.lcdText->setIfChanged(value))
             {
-                p.render2D->setLCDText(value);
+                if (auto context = getContext().lock())
+                {
+                    if (auto render2D = context->getSystemT<Render::Render2D>())
+                    {
+                        render2D->setLCDText(value);
+                    }
+                }
             }
         }
 
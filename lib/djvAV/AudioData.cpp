@@ -29,35 +29,419 @@
 
 #include <djvAV/AudioData.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_AUDIO_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
 #define _CONVERT(a, b) \
     { \
-        const a##_T * inP = reinterpret_cast<const a##_T *>(data->getData()); \
-        b##_T * outP = reinterpret_cast<b##_T *>(out->getData()); \
-        for (size_t i = 0; i < sampleCount * channelCount; ++i, ++inP, ++outP) \
+        const a##_T * inP = reinterpret_cast<const a##_T *>(in); \
+        b##_T * outP = reinterpret_cast<b##_T *>(out); \
+        for (size_t i = 0; i < size; ++i, ++inP, ++outP) \
         { \
             a##To##b(*inP, *outP); \
         } \
     }
 
-#define _VOLUME(t) \
-    { \
-        const t##_T* inP = reinterpret_cast<const t##_T*>(in); \
-        t##_T* outP = reinterpret_cast<t##_T*>(out); \
-        t##_T* const endP = outP + sampleCount * channelCount; \
-        for (; outP < endP; ++inP, ++outP) \
-        { \
-            *outP = *inP * volume; \
-        } \
-    }
-
 namespace djv
 {
     namespace AV
     {
         namespace Audio
         {
+            namespace
+            {
+                //! Apply a volume to an integer sample, the result is truncated
+                //! and clamped the same way as the SSE2 code.
+                template<typename T>
+                inline T volumeInt(T value, float volume)
+                {
+                    const float v = value * volume;
+                    return
+                        v >= static_cast<float>(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() :
+                        (v <= static_cast<float>(std::numeric_limits<T>::min()) ? std::numeric_limits<T>::min() :
+                        static_cast<T>(v));
+                }
+
+                inline S8_T  volumeSample(S8_T  value, float volume) { return volumeInt(value, volume); }
+                inline S16_T volumeSample(S16_T value, float volume) { return volumeInt(value, volume); }
+                inline S32_T volumeSample(S32_T value, float volume) { return volumeInt(value, volume); }
+                inline F32_T volumeSample(F32_T value, float volume) { return value * volume; }
+                inline F64_T volumeSample(F64_T value, float volume) { return value * static_cast<F64_T>(volume); }
+
+                template<typename T>
+                void volumeT(const T* in, T* out, float volume, size_t size)
+                {
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        out[i] = volumeSample(in[i], volume);
+                    }
+                }
+
+                template<typename T>
+                void volumeRampT(const T* in, T* out, float start, float end, size_t sampleCount, uint8_t channelCount)
+                {
+                    const float step = sampleCount > 0 ? ((end - start) / sampleCount) : 0.F;
+                    for (size_t i = 0; i < sampleCount; ++i, in += channelCount, out += channelCount)
+                    {
+                        const float volume = start + step * i;
+                        for (uint8_t c = 0; c < channelCount; ++c)
+                        {
+                            out[c] = volumeSample(in[c], volume);
+                        }
+                    }
+                }
+
+                // Speaker positions from the WAVE channel mask.
+                const uint64_t speakerFrontLeft          = 0x1;
+                const uint64_t speakerFrontRight         = 0x2;
+                const uint64_t speakerFrontCenter        = 0x4;
+                const uint64_t speakerBackLeft           = 0x10;
+                const uint64_t speakerBackRight          = 0x20;
+                const uint64_t speakerFrontLeftOfCenter  = 0x40;
+                const uint64_t speakerFrontRightOfCenter = 0x80;
+                const uint64_t speakerBackCenter         = 0x100;
+                const uint64_t speakerSideLeft           = 0x200;
+                const uint64_t speakerSideRight          = 0x400;
+                const uint64_t speakerTopCenter          = 0x800;
+                const uint64_t speakerTopFrontLeft       = 0x1000;
+                const uint64_t speakerTopFrontCenter     = 0x2000;
+                const uint64_t speakerTopFrontRight      = 0x4000;
+                const uint64_t speakerTopBackLeft        = 0x8000;
+                const uint64_t speakerTopBackCenter      = 0x10000;
+                const uint64_t speakerTopBackRight       = 0x20000;
+                const uint64_t speakerMask5_1            = 0x3f;
+                const uint64_t speakerMask7_1            = 0x63f;
+
+                // The positions that are folded into the left, right, or both
+                // channels at -3dB. The LFE and unknown positions are dropped.
+                const uint64_t speakerLeft =
+                    speakerBackLeft | speakerSideLeft | speakerTopFrontLeft | speakerTopBackLeft;
+                const uint64_t speakerRight =
+                    speakerBackRight | speakerSideRight | speakerTopFrontRight | speakerTopBackRight;
+                const uint64_t speakerCenter =
+                    speakerFrontCenter | speakerBackCenter | speakerTopCenter | speakerTopFrontCenter | speakerTopBackCenter;
+
+                template<typename T>
+                inline T downmixSample(double value)
+                {
+                    return
+                        value >= static_cast<double>(std::numeric_limits<T>::max()) ? std::numeric_limits<T>::max() :
+                        (value <= static_cast<double>(std::numeric_limits<T>::min()) ? std::numeric_limits<T>::min() :
+                        static_cast<T>(value));
+                }
+
+                template<>
+                inline F32_T downmixSample(double value)
+                {
+                    return static_cast<F32_T>(value);
+                }
+
+                template<>
+                inline F64_T downmixSample(double value)
+                {
+                    return value;
+                }
+
+                template<typename T>
+                void downmixT(
+                    const T* in,
+                    T* out,
+                    size_t sampleCount,
+                    uint8_t inChannelCount,
+                    uint8_t outChannelCount,
+                    const float* matrix)
+                {
+                    for (size_t i = 0; i < sampleCount; ++i, in += inChannelCount, out += outChannelCount)
+                    {
+                        const float* m = matrix;
+                        for (uint8_t c = 0; c < outChannelCount; ++c, m += inChannelCount)
+                        {
+                            double v = 0.0;
+                            for (uint8_t j = 0; j < inChannelCount; ++j)
+                            {
+                                v += m[j] * static_cast<double>(in[j]);
+                            }
+                            out[c] = downmixSample<T>(v);
+                        }
+                    }
+                }
+
+                // The planes are read starting at the given sample offset.
+                template<typename T>
+                void planarInterleaveT(const uint8_t* const* in, size_t offset, uint8_t* out, size_t sampleCount, uint8_t channelCount)
+                {
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        const T* inP = reinterpret_cast<const T*>(in[c]) + offset;
+                        T* outP = reinterpret_cast<T*>(out) + c;
+                        for (size_t i = 0; i < sampleCount; ++i, outP += channelCount)
+                        {
+                            *outP = inP[i];
+                        }
+                    }
+                }
+
+                // The planes are written starting at the given sample offset.
+                template<typename T>
+                void planarDeinterleaveT(const uint8_t* in, uint8_t* const* out, size_t offset, size_t sampleCount, uint8_t channelCount)
+                {
+                    for (uint8_t c = 0; c < channelCount; ++c)
+                    {
+                        const T* inP = reinterpret_cast<const T*>(in) + c;
+                        T* outP = reinterpret_cast<T*>(out[c]) + offset;
+                        for (size_t i = 0; i < sampleCount; ++i, inP += channelCount)
+                        {
+                            outP[i] = *inP;
+                        }
+                    }
+                }
+
+#if defined(DJV_AUDIO_SSE2)
+                // The SSE2 kernels give the same results as the scalar
+                // conversions in AudioInline.h, the remainder of the data is
+                // finished with the scalar code.
+
+                void convert_S16_F32_SSE2(const S16_T* in, F32_T* out, size_t size)
+                {
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(S16Range.max));
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                        const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+                        const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+                        _mm_storeu_ps(out + i, _mm_div_ps(_mm_cvtepi32_ps(lo), scale));
+                        _mm_storeu_ps(out + i + 4, _mm_div_ps(_mm_cvtepi32_ps(hi), scale));
+                    }
+                    for (; i < size; ++i)
+                    {
+                        S16ToF32(in[i], out[i]);
+                    }
+                }
+
+                void convert_F32_S16_SSE2(const F32_T* in, S16_T* out, size_t size)
+                {
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(S16Range.max));
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i a = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i), scale));
+                        const __m128i b = _mm_cvttps_epi32(_mm_mul_ps(_mm_loadu_ps(in + i + 4), scale));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(a, b));
+                    }
+                    for (; i < size; ++i)
+                    {
+                        F32ToS16(in[i], out[i]);
+                    }
+                }
+
+                void convert_S32_F32_SSE2(const S32_T* in, F32_T* out, size_t size)
+                {
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(S32Range.max));
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                        _mm_storeu_ps(out + i, _mm_div_ps(_mm_cvtepi32_ps(v), scale));
+                    }
+                    for (; i < size; ++i)
+                    {
+                        S32ToF32(in[i], out[i]);
+                    }
+                }
+
+                //! Convert floating point values to 32-bit integers with
+                //! truncation. Values that are too large for the conversion
+                //! are set to the maximum, the conversion already returns the
+                //! minimum for values that are too small.
+                inline __m128i convertS32(__m128 value)
+                {
+                    const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(value, _mm_set1_ps(2147483648.F)));
+                    return _mm_xor_si128(_mm_cvttps_epi32(value), overflow);
+                }
+
+                void convert_F32_S32_SSE2(const F32_T* in, S32_T* out, size_t size)
+                {
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(S32Range.max));
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128i v = convertS32(_mm_mul_ps(_mm_loadu_ps(in + i), scale));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), v);
+                    }
+                    for (; i < size; ++i)
+                    {
+                        F32ToS32(in[i], out[i]);
+                    }
+                }
+
+                void convert_F32_F64_SSE2(const F32_T* in, F64_T* out, size_t size)
+                {
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128 v = _mm_loadu_ps(in + i);
+                        _mm_storeu_pd(out + i, _mm_cvtps_pd(v));
+                        _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+                    }
+                    for (; i < size; ++i)
+                    {
+                        F32ToF64(in[i], out[i]);
+                    }
+                }
+
+                void convert_F64_F32_SSE2(const F64_T* in, F32_T* out, size_t size)
+                {
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128 a = _mm_cvtpd_ps(_mm_loadu_pd(in + i));
+                        const __m128 b = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2));
+                        _mm_storeu_ps(out + i, _mm_movelh_ps(a, b));
+                    }
+                    for (; i < size; ++i)
+                    {
+                        F64ToF32(in[i], out[i]);
+                    }
+                }
+
+                void volume_S16_SSE2(const S16_T* in, S16_T* out, float volume, size_t size)
+                {
+                    const __m128 v = _mm_set1_ps(volume);
+                    const __m128 min = _mm_set1_ps(static_cast<float>(S16Range.min));
+                    const __m128 max = _mm_set1_ps(static_cast<float>(S16Range.max));
+                    size_t i = 0;
+                    for (; i + 8 <= size; i += 8)
+                    {
+                        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                        const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+                        const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+                        _mm_storeu_si128(
+                            reinterpret_cast<__m128i*>(out + i),
+                            _mm_packs_epi32(
+                                _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(_mm_mul_ps(lo, v), max), min)),
+                                _mm_cvttps_epi32(_mm_max_ps(_mm_min_ps(_mm_mul_ps(hi, v), max), min))));
+                    }
+                    volumeT(in + i, out + i, volume, size - i);
+                }
+
+                void volume_S32_SSE2(const S32_T* in, S32_T* out, float volume, size_t size)
+                {
+                    const __m128 v = _mm_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        const __m128 s = _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), convertS32(_mm_mul_ps(s, v)));
+                    }
+                    volumeT(in + i, out + i, volume, size - i);
+                }
+
+                void volume_F32_SSE2(const F32_T* in, F32_T* out, float volume, size_t size)
+                {
+                    const __m128 v = _mm_set1_ps(volume);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), v));
+                    }
+                    volumeT(in + i, out + i, volume, size - i);
+                }
+
+                void volume_F64_SSE2(const F64_T* in, F64_T* out, float volume, size_t size)
+                {
+                    const __m128d v = _mm_set1_pd(static_cast<double>(volume));
+                    size_t i = 0;
+                    for (; i + 2 <= size; i += 2)
+                    {
+                        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(in + i), v));
+                    }
+                    volumeT(in + i, out + i, volume, size - i);
+                }
+
+                //! Interleave stereo data, returns the number of samples that
+                //! were processed.
+                size_t planarInterleave2_SSE2(const uint8_t* l, const uint8_t* r, uint8_t* out, size_t sampleCount, uint8_t byteCount)
+                {
+                    const size_t step = 16 / byteCount;
+                    const size_t count = sampleCount / step * step;
+                    for (size_t i = 0; i < count; i += step, l += 16, r += 16, out += 32)
+                    {
+                        const __m128i lV = _mm_loadu_si128(reinterpret_cast<const __m128i*>(l));
+                        const __m128i rV = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r));
+                        __m128i a;
+                        __m128i b;
+                        switch (byteCount)
+                        {
+                        case 2:
+                            a = _mm_unpacklo_epi16(lV, rV);
+                            b = _mm_unpackhi_epi16(lV, rV);
+                            break;
+                        case 4:
+                            a = _mm_unpacklo_epi32(lV, rV);
+                            b = _mm_unpackhi_epi32(lV, rV);
+                            break;
+                        default:
+                            a = _mm_unpacklo_epi64(lV, rV);
+                            b = _mm_unpackhi_epi64(lV, rV);
+                            break;
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), a);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), b);
+                    }
+                    return count;
+                }
+
+                //! Deinterleave stereo data, returns the number of samples that
+                //! were processed.
+                size_t planarDeinterleave2_SSE2(const uint8_t* in, uint8_t* l, uint8_t* r, size_t sampleCount, uint8_t byteCount)
+                {
+                    const size_t step = 16 / byteCount;
+                    const size_t count = sampleCount / step * step;
+                    for (size_t i = 0; i < count; i += step, in += 32, l += 16, r += 16)
+                    {
+                        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16));
+                        __m128i lV;
+                        __m128i rV;
+                        switch (byteCount)
+                        {
+                        case 2:
+                            // The samples are sign extended so that the pack
+                            // does not saturate.
+                            lV = _mm_packs_epi32(
+                                _mm_srai_epi32(_mm_slli_epi32(a, 16), 16),
+                                _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+                            rV = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+                            break;
+                        case 4:
+                            lV = _mm_castps_si128(_mm_shuffle_ps(
+                                _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0)));
+                            rV = _mm_castps_si128(_mm_shuffle_ps(
+                                _mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)));
+                            break;
+                        default:
+                            lV = _mm_unpacklo_epi64(a, b);
+                            rV = _mm_unpackhi_epi64(a, b);
+                            break;
+                        }
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(l), lV);
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(r), rV);
+                    }
+                    return count;
+                }
+#endif // DJV_AUDIO_SSE2
+
+            } // namespace
+
             bool Info::operator == (const Info & other) const
             {
                 return
@@ -92,174 +476,370 @@ namespace djv
 
             std::shared_ptr<Data> Data::convert(const std::shared_ptr<Data> & data, Type type)
             {
-                const Type dataType = data->getType();
-                const size_t sampleCount = data->getSampleCount();
-                const size_t channelCount = static_cast<size_t>(data->getChannelCount());
-                auto out = Data::create(Info(channelCount, type, data->getSampleRate(), sampleCount));
-                if (dataType == type)
+                auto out = Data::create(Info(data->getChannelCount(), type, data->getSampleRate(), data->getSampleCount()));
+                convert(*data, *out);
+                return out;
+            }
+
+            void Data::convert(const Data& data, Data& out)
+            {
+                convert(
+                    data.getData(),
+                    data.getType(),
+                    out.getData(),
+                    out.getType(),
+                    std::min(data.getSampleCount(), out.getSampleCount()) * std::min(data.getChannelCount(), out.getChannelCount()));
+            }
+
+            void Data::convert(const uint8_t* in, Type inType, uint8_t* out, Type outType, size_t size)
+            {
+                if (inType == outType)
                 {
-                    memcpy(out->getData(), data->getData(), sampleCount * channelCount * Audio::getByteCount(type));
+                    if (in != out)
+                    {
+                        memmove(out, in, size * Audio::getByteCount(inType));
+                    }
+                    return;
                 }
-                else
+                switch (inType)
                 {
-                    switch (dataType)
-                    {
-                        case Type::S8:
-                            switch (type)
-                            {
-                            case Type::S16: _CONVERT(S8, S16); break;
-                            case Type::S32: _CONVERT(S8, S32); break;
-                            case Type::F32: _CONVERT(S8, F32); break;
-                            case Type::F64: _CONVERT(S8, F64); break;
-                            default: break;
-                            }
+                    case Type::S8:
+                        switch (outType)
+                        {
+                        case Type::S16: _CONVERT(S8, S16); break;
+                        case Type::S32: _CONVERT(S8, S32); break;
+                        case Type::F32: _CONVERT(S8, F32); break;
+                        case Type::F64: _CONVERT(S8, F64); break;
+                        default: break;
+                        }
+                        break;
+                    case Type::S16:
+                        switch (outType)
+                        {
+                        case Type::S8:  _CONVERT(S16, S8);  break;
+                        case Type::S32: _CONVERT(S16, S32); break;
+#if defined(DJV_AUDIO_SSE2)
+                        case Type::F32:
+                            convert_S16_F32_SSE2(reinterpret_cast<const S16_T*>(in), reinterpret_cast<F32_T*>(out), size);
                             break;
+#else // DJV_AUDIO_SSE2
+                        case Type::F32: _CONVERT(S16, F32); break;
+#endif // DJV_AUDIO_SSE2
+                        case Type::F64: _CONVERT(S16, F64); break;
+                        default: break;
+                        }
+                        break;
+                    case Type::S32:
+                        switch (outType)
+                        {
+                        case Type::S8:  _CONVERT(S32, S8);  break;
+                        case Type::S16: _CONVERT(S32, S16); break;
+#if defined(DJV_AUDIO_SSE2)
+                        case Type::F32:
+                            convert_S32_F32_SSE2(reinterpret_cast<const S32_T*>(in), reinterpret_cast<F32_T*>(out), size);
+                            break;
+#else // DJV_AUDIO_SSE2
+                        case Type::F32: _CONVERT(S32, F32); break;
+#endif // DJV_AUDIO_SSE2
+                        case Type::F64: _CONVERT(S32, F64); break;
+                        default: break;
+                        }
+                        break;
+                    case Type::F32:
+                        switch (outType)
+                        {
+                        case Type::S8:  _CONVERT(F32, S8);  break;
+#if defined(DJV_AUDIO_SSE2)
                         case Type::S16:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(S16, S8);  break;
-                            case Type::S32: _CONVERT(S16, S32); break;
-                            case Type::F32: _CONVERT(S16, F32); break;
-                            case Type::F64: _CONVERT(S16, F64); break;
-                            default: break;
-                            }
+                            convert_F32_S16_SSE2(reinterpret_cast<const F32_T*>(in), reinterpret_cast<S16_T*>(out), size);
                             break;
                         case Type::S32:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(S32, S8);  break;
-                            case Type::S16: _CONVERT(S32, S16); break;
-                            case Type::F32: _CONVERT(S32, F32); break;
-                            case Type::F64: _CONVERT(S32, F64); break;
-                            default: break;
-                            }
-                            break;
-                        case Type::F32:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(F32, S8);  break;
-                            case Type::S16: _CONVERT(F32, S16); break;
-                            case Type::S32: _CONVERT(F32, S32); break;
-                            case Type::F64: _CONVERT(F32, F64); break;
-                            default: break;
-                            }
+                            convert_F32_S32_SSE2(reinterpret_cast<const F32_T*>(in), reinterpret_cast<S32_T*>(out), size);
                             break;
                         case Type::F64:
-                            switch (type)
-                            {
-                            case Type::S8:  _CONVERT(F64, S8);  break;
-                            case Type::S16: _CONVERT(F64, S16); break;
-                            case Type::S32: _CONVERT(F64, S32); break;
-                            case Type::F32: _CONVERT(F64, F32); break;
-                            default: break;
-                            }
+                            convert_F32_F64_SSE2(reinterpret_cast<const F32_T*>(in), reinterpret_cast<F64_T*>(out), size);
                             break;
+#else // DJV_AUDIO_SSE2
+                        case Type::S16: _CONVERT(F32, S16); break;
+                        case Type::S32: _CONVERT(F32, S32); break;
+                        case Type::F64: _CONVERT(F32, F64); break;
+#endif // DJV_AUDIO_SSE2
                         default: break;
-                    }
+                        }
+                        break;
+                    case Type::F64:
+                        switch (outType)
+                        {
+                        case Type::S8:  _CONVERT(F64, S8);  break;
+                        case Type::S16: _CONVERT(F64, S16); break;
+                        case Type::S32: _CONVERT(F64, S32); break;
+#if defined(DJV_AUDIO_SSE2)
+                        case Type::F32:
+                            convert_F64_F32_SSE2(reinterpret_cast<const F64_T*>(in), reinterpret_cast<F32_T*>(out), size);
+                            break;
+#else // DJV_AUDIO_SSE2
+                        case Type::F32: _CONVERT(F64, F32); break;
+#endif // DJV_AUDIO_SSE2
+                        default: break;
+                        }
+                        break;
+                    default: break;
                 }
+            }
+
+            std::shared_ptr<Data> Data::planarInterleave(const std::shared_ptr<Data> & data)
+            {
+                auto out = Data::create(data->getInfo());
+                planarInterleave(*data, *out);
                 return out;
             }
 
-            namespace
+            void Data::planarInterleave(const Data& data, Data& out)
+            {
+                const uint8_t channelCount = data.getChannelCount();
+                const size_t sampleCount = data.getSampleCount();
+                const size_t planeByteCount = sampleCount * Audio::getByteCount(data.getType());
+                const uint8_t* planes[std::numeric_limits<uint8_t>::max()];
+                for (uint8_t c = 0; c < channelCount; ++c)
+                {
+                    planes[c] = data.getData() + c * planeByteCount;
+                }
+                planarInterleave(planes, out.getData(), sampleCount, channelCount, data.getType());
+            }
+
+            void Data::planarInterleave(const uint8_t* const* in, uint8_t* out, size_t sampleCount, uint8_t channelCount, Type type)
             {
-                template<typename U>
-                void _planarInterleave(const U * value, U * out, size_t channelCount, size_t size)
+                _planarInterleave(in, out, sampleCount, channelCount, Audio::getByteCount(type));
+            }
+
+            std::shared_ptr<Data> Data::planarDeinterleave(const std::shared_ptr<Data> & data)
+            {
+                auto out = Data::create(data->getInfo());
+                planarDeinterleave(*data, *out);
+                return out;
+            }
+
+            void Data::planarDeinterleave(const Data& data, Data& out)
+            {
+                const uint8_t channelCount = data.getChannelCount();
+                const size_t sampleCount = data.getSampleCount();
+                const size_t planeByteCount = sampleCount * Audio::getByteCount(data.getType());
+                uint8_t* planes[std::numeric_limits<uint8_t>::max()];
+                for (uint8_t c = 0; c < channelCount; ++c)
+                {
+                    planes[c] = out.getData() + c * planeByteCount;
+                }
+                planarDeinterleave(data.getData(), planes, sampleCount, channelCount, data.getType());
+            }
+
+            void Data::planarDeinterleave(const uint8_t* in, uint8_t* const* out, size_t sampleCount, uint8_t channelCount, Type type)
+            {
+                _planarDeinterleave(in, out, sampleCount, channelCount, Audio::getByteCount(type));
+            }
+
+            std::vector<float> Data::getDownmixMatrix(uint8_t inChannelCount, uint8_t outChannelCount, uint64_t channelMask)
+            {
+                std::vector<float> out(inChannelCount * outChannelCount, 0.F);
+                if (outChannelCount >= inChannelCount || outChannelCount > 2)
+                {
+                    for (uint8_t c = 0; c < std::min(inChannelCount, outChannelCount); ++c)
+                    {
+                        out[c * inChannelCount + c] = 1.F;
+                    }
+                    return out;
+                }
+
+                // Get the speaker position of each channel. Without a mask
+                // only the 5.1 and 7.1 layouts can be assumed, otherwise just
+                // the front pair is used.
+                size_t maskCount = 0;
+                for (uint64_t i = channelMask; i; i &= i - 1)
+                {
+                    ++maskCount;
+                }
+                if (maskCount != inChannelCount)
+                {
+                    switch (inChannelCount)
+                    {
+                    case 6: channelMask = speakerMask5_1; break;
+                    case 8: channelMask = speakerMask7_1; break;
+                    default: channelMask = speakerFrontLeft | speakerFrontRight; break;
+                    }
+                }
+                std::vector<uint64_t> positions(inChannelCount, 0);
+                uint64_t bit = 1;
+                for (uint8_t c = 0; c < inChannelCount && channelMask; ++c)
+                {
+                    while (!(channelMask & bit))
+                    {
+                        bit <<= 1;
+                    }
+                    positions[c] = bit;
+                    channelMask &= ~bit;
+                }
+
+                // Mix to stereo.
+                const float minus3dB = sqrtf(.5F);
+                std::vector<float> stereo(inChannelCount * 2, 0.F);
+                float* l = stereo.data();
+                float* r = stereo.data() + inChannelCount;
+                for (uint8_t c = 0; c < inChannelCount; ++c)
+                {
+                    const uint64_t position = positions[c];
+                    if (position & (speakerFrontLeft | speakerFrontLeftOfCenter))
+                    {
+                        l[c] = 1.F;
+                    }
+                    else if (position & (speakerFrontRight | speakerFrontRightOfCenter))
+                    {
+                        r[c] = 1.F;
+                    }
+                    else if (position & speakerLeft)
+                    {
+                        l[c] = minus3dB;
+                    }
+                    else if (position & speakerRight)
+                    {
+                        r[c] = minus3dB;
+                    }
+                    else if (position & speakerCenter)
+                    {
+                        l[c] = minus3dB;
+                        r[c] = minus3dB;
+                    }
+                }
+                if (1 == outChannelCount)
                 {
-                    const size_t planeSize = size / channelCount;
-                    for (size_t c = 0; c < channelCount; ++c)
+                    for (uint8_t c = 0; c < inChannelCount; ++c)
                     {
-                        const U * inP = value + c * planeSize;
-                        const U * endP = inP + planeSize;
-                        U * outP = out + c;
-                        for (; inP < endP; ++inP, outP += channelCount)
+                        out[c] = (l[c] + r[c]) * .5F;
+                    }
+                }
+                else
+                {
+                    out = stereo;
+                }
+
+                // Normalize the rows.
+                for (uint8_t i = 0; i < outChannelCount; ++i)
+                {
+                    float* row = out.data() + i * inChannelCount;
+                    float sum = 0.F;
+                    for (uint8_t c = 0; c < inChannelCount; ++c)
+                    {
+                        sum += row[c];
+                    }
+                    if (sum > 1.F)
+                    {
+                        for (uint8_t c = 0; c < inChannelCount; ++c)
                         {
-                            *outP = *inP;
+                            row[c] /= sum;
                         }
                     }
                 }
+                return out;
             }
 
-            std::shared_ptr<Data> Data::planarInterleave(const std::shared_ptr<Data> & data)
+            void Data::downmix(
+                const uint8_t* in,
+                uint8_t* out,
+                size_t sampleCount,
+                uint8_t inChannelCount,
+                uint8_t outChannelCount,
+                Type type,
+                const float* matrix)
             {
-                auto out = Data::create(data->getInfo());
-                const size_t channelCount = data->getChannelCount();
-                const size_t sampleCount = data->getSampleCount();
-                switch (data->getType())
+                switch (type)
                 {
                 case Type::S8:
-                    _planarInterleave(reinterpret_cast<const S8_T *> (data->getData()), reinterpret_cast<S8_T *> (out->getData()), channelCount, sampleCount);
+                    downmixT(reinterpret_cast<const S8_T*>(in), reinterpret_cast<S8_T*>(out), sampleCount, inChannelCount, outChannelCount, matrix);
                     break;
                 case Type::S16:
-                    _planarInterleave(reinterpret_cast<const S16_T *>(data->getData()), reinterpret_cast<S16_T *>(out->getData()), channelCount, sampleCount);
+                    downmixT(reinterpret_cast<const S16_T*>(in), reinterpret_cast<S16_T*>(out), sampleCount, inChannelCount, outChannelCount, matrix);
                     break;
                 case Type::S32:
-                    _planarInterleave(reinterpret_cast<const S32_T *>(data->getData()), reinterpret_cast<S32_T *>(out->getData()), channelCount, sampleCount);
+                    downmixT(reinterpret_cast<const S32_T*>(in), reinterpret_cast<S32_T*>(out), sampleCount, inChannelCount, outChannelCount, matrix);
                     break;
                 case Type::F32:
-                    _planarInterleave(reinterpret_cast<const F32_T *>(data->getData()), reinterpret_cast<F32_T *>(out->getData()), channelCount, sampleCount);
+                    downmixT(reinterpret_cast<const F32_T*>(in), reinterpret_cast<F32_T*>(out), sampleCount, inChannelCount, outChannelCount, matrix);
                     break;
                 case Type::F64:
-                    _planarInterleave(reinterpret_cast<const F64_T *>(data->getData()), reinterpret_cast<F64_T *>(out->getData()), channelCount, sampleCount);
+                    downmixT(reinterpret_cast<const F64_T*>(in), reinterpret_cast<F64_T*>(out), sampleCount, inChannelCount, outChannelCount, matrix);
                     break;
                 default: break;
                 }
-                return out;
-            }
-
-            namespace
-            {
-                template<typename T>
-                void _planarDeinterleave(const T* value, T* out, uint8_t channelCount, size_t size)
-                {
-                    const size_t planeSize = size / channelCount;
-                    for (uint8_t c = 0; c < channelCount; ++c)
-                    {
-                        const T* inP = value + c;
-                        T* outP = out + c * planeSize;
-                        for (size_t i = 0; i < planeSize; ++i, inP += channelCount, ++outP)
-                        {
-                            *outP = *inP;
-                        }
-                    }
-                }
             }
 
-            std::shared_ptr<Data> Data::planarDeinterleave(const std::shared_ptr<Data> & data)
+            void Data::volume(const uint8_t* in, uint8_t* out, float volume, size_t sampleCount, uint8_t channelCount, Type type)
             {
-                auto out = Data::create(data->getInfo());
-                const uint8_t channelCount = data->getChannelCount();
-                const size_t sampleCount = data->getSampleCount();
-                switch (data->getType())
+                const size_t size = sampleCount * channelCount;
+                switch (type)
                 {
                 case Type::S8:
-                    _planarDeinterleave(reinterpret_cast<const S8_T *> (data->getData()), reinterpret_cast<S8_T *> (out->getData()), channelCount, sampleCount);
+                    volumeT(reinterpret_cast<const S8_T*>(in), reinterpret_cast<S8_T*>(out), volume, size);
                     break;
+#if defined(DJV_AUDIO_SSE2)
                 case Type::S16:
-                    _planarDeinterleave(reinterpret_cast<const S16_T *>(data->getData()), reinterpret_cast<S16_T *>(out->getData()), channelCount, sampleCount);
+                    volume_S16_SSE2(reinterpret_cast<const S16_T*>(in), reinterpret_cast<S16_T*>(out), volume, size);
                     break;
                 case Type::S32:
-                    _planarDeinterleave(reinterpret_cast<const S32_T *>(data->getData()), reinterpret_cast<S32_T *>(out->getData()), channelCount, sampleCount);
+                    volume_S32_SSE2(reinterpret_cast<const S32_T*>(in), reinterpret_cast<S32_T*>(out), volume, size);
                     break;
                 case Type::F32:
-                    _planarDeinterleave(reinterpret_cast<const F32_T *>(data->getData()), reinterpret_cast<F32_T *>(out->getData()), channelCount, sampleCount);
+                    volume_F32_SSE2(reinterpret_cast<const F32_T*>(in), reinterpret_cast<F32_T*>(out), volume, size);
                     break;
                 case Type::F64:
-                    _planarDeinterleave(reinterpret_cast<const F64_T *>(data->getData()), reinterpret_cast<F64_T *>(out->getData()), channelCount, sampleCount);
+                    volume_F64_SSE2(reinterpret_cast<const F64_T*>(in), reinterpret_cast<F64_T*>(out), volume, size);
                     break;
+#else // DJV_AUDIO_SSE2
+                case Type::S16:
+                    volumeT(reinterpret_cast<const S16_T*>(in), reinterpret_cast<S16_T*>(out), volume, size);
+                    break;
+                case Type::S32:
+                    volumeT(reinterpret_cast<const S32_T*>(in), reinterpret_cast<S32_T*>(out), volume, size);
+                    break;
+                case Type::F32:
+                    volumeT(reinterpret_cast<const F32_T*>(in), reinterpret_cast<F32_T*>(out), volume, size);
+                    break;
+                case Type::F64:
+                    volumeT(reinterpret_cast<const F64_T*>(in), reinterpret_cast<F64_T*>(out), volume, size);
+                    break;
+#endif // DJV_AUDIO_SSE2
                 default: break;
                 }
-                return out;
             }
 
-            void Data::volume(const uint8_t* in, uint8_t* out, float volume, size_t sampleCount, uint8_t channelCount, Type type)
+            void Data::volume(
+                const uint8_t* in,
+                uint8_t* out,
+                float start,
+                float end,
+                size_t sampleCount,
+                uint8_t channelCount,
+                Type type)
             {
+                if (start == end)
+                {
+                    volume(in, out, start, sampleCount, channelCount, type);
+                    return;
+                }
                 switch (type)
                 {
-                case Type::S8:  _VOLUME(S8);  break;
-                case Type::S16: _VOLUME(S16); break;
-                case Type::S32: _VOLUME(S32); break;
-                case Type::F32: _VOLUME(F32); break;
-                case Type::F64: _VOLUME(F64); break;
+                case Type::S8:
+                    volumeRampT(reinterpret_cast<const S8_T*>(in), reinterpret_cast<S8_T*>(out), start, end, sampleCount, channelCount);
+                    break;
+                case Type::S16:
+                    volumeRampT(reinterpret_cast<const S16_T*>(in), reinterpret_cast<S16_T*>(out), start, end, sampleCount, channelCount);
+                    break;
+                case Type::S32:
+                    volumeRampT(reinterpret_cast<const S32_T*>(in), reinterpret_cast<S32_T*>(out), start, end, sampleCount, channelCount);
+                    break;
+                case Type::F32:
+                    volumeRampT(reinterpret_cast<const F32_T*>(in), reinterpret_cast<F32_T*>(out), start, end, sampleCount, channelCount);
+                    break;
+                case Type::F64:
+                    volumeRampT(reinterpret_cast<const F64_T*>(in), reinterpret_cast<F64_T*>(out), start, end, sampleCount, channelCount);
+                    break;
                 default: break;
                 }
             }
@@ -276,7 +856,78 @@ namespace djv
                 return !(*this == other);
             }
 
+            void Data::_planarInterleave(const uint8_t* const* in, uint8_t* out, size_t sampleCount, uint8_t channelCount, uint8_t byteCount)
+            {
+                if (0 == byteCount)
+                {
+                    return;
+                }
+                switch (channelCount)
+                {
+                case 0: break;
+                case 1:
+                    memcpy(out, in[0], sampleCount * byteCount);
+                    break;
+                default:
+                {
+                    size_t offset = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    if (2 == channelCount && byteCount > 1)
+                    {
+                        offset = planarInterleave2_SSE2(in[0], in[1], out, sampleCount, byteCount);
+                    }
+#endif // DJV_AUDIO_SSE2
+                    out += offset * channelCount * byteCount;
+                    sampleCount -= offset;
+                    switch (byteCount)
+                    {
+                    case 1: planarInterleaveT<uint8_t>(in, offset, out, sampleCount, channelCount); break;
+                    case 2: planarInterleaveT<uint16_t>(in, offset, out, sampleCount, channelCount); break;
+                    case 4: planarInterleaveT<uint32_t>(in, offset, out, sampleCount, channelCount); break;
+                    case 8: planarInterleaveT<uint64_t>(in, offset, out, sampleCount, channelCount); break;
+                    default: break;
+                    }
+                    break;
+                }
+                }
+            }
+
+            void Data::_planarDeinterleave(const uint8_t* in, uint8_t* const* out, size_t sampleCount, uint8_t channelCount, uint8_t byteCount)
+            {
+                if (0 == byteCount)
+                {
+                    return;
+                }
+                switch (channelCount)
+                {
+                case 0: break;
+                case 1:
+                    memcpy(out[0], in, sampleCount * byteCount);
+                    break;
+                default:
+                {
+                    size_t offset = 0;
+#if defined(DJV_AUDIO_SSE2)
+                    if (2 == channelCount && byteCount > 1)
+                    {
+                        offset = planarDeinterleave2_SSE2(in, out[0], out[1], sampleCount, byteCount);
+                    }
+#endif // DJV_AUDIO_SSE2
+                    in += offset * channelCount * byteCount;
+                    sampleCount -= offset;
+                    switch (byteCount)
+                    {
+                    case 1: planarDeinterleaveT<uint8_t>(in, out, offset, sampleCount, channelCount); break;
+                    case 2: planarDeinterleaveT<uint16_t>(in, out, offset, sampleCount, channelCount); break;
+                    case 4: planarDeinterleaveT<uint32_t>(in, out, offset, sampleCount, channelCount); break;
+                    case 8: planarDeinterleaveT<uint64_t>(in, out, offset, sampleCount, channelCount); break;
+                    default: break;
+                    }
+                    break;
+                }
+                }
+            }
+
         } // namespace Audio
     } // namespace AV
 } // namespace djv
-
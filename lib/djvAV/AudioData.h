@@ -32,6 +32,7 @@
 #include <djvAV/Audio.h>
 
 #include <memory>
+#include <vector>
 
 namespace djv
 {
@@ -89,22 +90,103 @@ namespace djv
 
                 void zero();
 
+                //! \name Conversion
+                //! The conversions between S16, S32, F32, and F64 are vectorized.
+                ///@{
+
                 static std::shared_ptr<Data> convert(const std::shared_ptr<Data>&, Type);
 
+                //! Convert into preallocated data. The output should have the
+                //! same channel and sample counts as the input.
+                static void convert(const Data&, Data&);
+
+                //! Convert the given number of values (samples times channels).
+                static void convert(const uint8_t*, Type, uint8_t*, Type, size_t size);
+
+                ///@}
+
+                //! \name Channels
+                //! The planar functions are vectorized for stereo data.
+                ///@{
+
                 template<typename T>
                 static void extract(const T*, T*, size_t sampleCount, uint8_t inChannelCount, uint8_t outChannelCount);
 
                 static std::shared_ptr<Data> planarInterleave(const std::shared_ptr<Data>&);
+
+                //! Interleave into preallocated data with the same information.
+                static void planarInterleave(const Data&, Data&);
+
                 template<typename T>
                 static void planarInterleave(const T**, T*, size_t sampleCount, uint8_t channelCount);
+                static void planarInterleave(const uint8_t* const*, uint8_t*, size_t sampleCount, uint8_t channelCount, Type);
+
                 static std::shared_ptr<Data> planarDeinterleave(const std::shared_ptr<Data>&);
 
+                //! Deinterleave into preallocated data with the same information.
+                static void planarDeinterleave(const Data&, Data&);
+
+                template<typename T>
+                static void planarDeinterleave(const T*, T**, size_t sampleCount, uint8_t channelCount);
+                static void planarDeinterleave(const uint8_t*, uint8_t* const*, size_t sampleCount, uint8_t channelCount, Type);
+
+                //! Get the coefficients for mixing channels down, stored as
+                //! one row of input channel weights for each output channel.
+                //! The speaker positions of the input channels are given by a
+                //! WAVE channel mask (the same bits as the FFmpeg channel
+                //! layout). Mixing to stereo folds the center, back, side, and
+                //! top channels into the left and right at -3dB and drops the
+                //! LFE, mixing to mono averages the stereo mix. Each row is
+                //! normalized so that the mix cannot clip. Without a matching
+                //! mask six and eight channels are mixed as 5.1 and 7.1, other
+                //! channel counts keep the front left and right. Mixing to more
+                //! than two channels keeps the first channels.
+                static std::vector<float> getDownmixMatrix(
+                    uint8_t  inChannelCount,
+                    uint8_t  outChannelCount,
+                    uint64_t channelMask = 0);
+
+                //! Mix interleaved channels down with the given coefficients.
+                static void downmix(
+                    const uint8_t*,
+                    uint8_t*,
+                    size_t sampleCount,
+                    uint8_t inChannelCount,
+                    uint8_t outChannelCount,
+                    Type,
+                    const float* matrix);
+
+                ///@}
+
+                //! \name Volume
+                //! The input and output may be the same. Integer samples are
+                //! truncated and clamped to the range of the type.
+                ///@{
+
                 static void volume(const uint8_t*, uint8_t*, float volume, size_t sampleCount, uint8_t channelCount, Type);
 
+                //! Apply a volume that changes linearly from the start value to
+                //! the end value over the samples, to avoid clicks when the
+                //! volume changes. The end value is reached at the first sample
+                //! after the data.
+                static void volume(
+                    const uint8_t*,
+                    uint8_t*,
+                    float start,
+                    float end,
+                    size_t sampleCount,
+                    uint8_t channelCount,
+                    Type);
+
+                ///@}
+
                 bool operator == (const Data&) const;
                 bool operator != (const Data&) const;
 
             private:
+                static void _planarInterleave(const uint8_t* const*, uint8_t*, size_t sampleCount, uint8_t channelCount, uint8_t byteCount);
+                static void _planarDeinterleave(const uint8_t*, uint8_t* const*, size_t sampleCount, uint8_t channelCount, uint8_t byteCount);
+
                 Info _info;
                 std::vector<uint8_t> _data;
             };
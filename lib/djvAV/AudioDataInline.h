@@ -149,37 +149,23 @@ namespace djv
             template<typename T>
             inline void Data::planarInterleave(const T** value, T* out, size_t sampleCount, uint8_t channelCount)
             {
-                switch (channelCount)
-                {
-                case 1:
-                    memcpy(out, value[0], sampleCount * channelCount * sizeof(T));
-                    break;
-                case 2:
-                {
-                    const T* inP0 = value[0];
-                    const T* inP1 = value[1];
-                    T* outP = out;
-                    T* const endP = out + sampleCount * channelCount;
-                    for (; outP < endP; outP += 2, ++inP0, ++inP1)
-                    {
-                        outP[0] = inP0[0];
-                        outP[1] = inP1[0];
-                    }
-                    break;
-                }
-                default:
-                    for (uint8_t c = 0; c < channelCount; ++c)
-                    {
-                        const T* inP = value[c];
-                        const T* endP = inP + sampleCount;
-                        T* outP = out + c;
-                        for (; inP < endP; ++inP, outP += channelCount)
-                        {
-                            *outP = *inP;
-                        }
-                    }
-                    break;
-                }
+                _planarInterleave(
+                    reinterpret_cast<const uint8_t* const*>(value),
+                    reinterpret_cast<uint8_t*>(out),
+                    sampleCount,
+                    channelCount,
+                    sizeof(T));
+            }
+
+            template<typename T>
+            inline void Data::planarDeinterleave(const T* value, T** out, size_t sampleCount, uint8_t channelCount)
+            {
+                _planarDeinterleave(
+                    reinterpret_cast<const uint8_t*>(value),
+                    reinterpret_cast<uint8_t* const*>(out),
+                    sampleCount,
+                    channelCount,
+                    sizeof(T));
             }
 
         } // namespace Audio
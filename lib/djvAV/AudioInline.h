@@ -200,7 +200,7 @@ namespace djv
             inline void F32ToS32(F32_T value, S32_T& out)
             {
                 out = static_cast<S32_T>(Core::Math::clamp(
-                    static_cast<int64_t>(static_cast<int64_t>(value) * S32Range.max),
+                    static_cast<int64_t>(value * S32Range.max),
                     static_cast<int64_t>(S32Range.min),
                     static_cast<int64_t>(S32Range.max)));
             }
@@ -229,7 +229,7 @@ namespace djv
             inline void F64ToS32(F64_T value, S32_T& out)
             {
                 out = static_cast<S32_T>(Core::Math::clamp(
-                    static_cast<int64_t>(static_cast<int64_t>(value) * S32Range.max),
+                    static_cast<int64_t>(value * S32Range.max),
                     static_cast<int64_t>(S32Range.min),
                     static_cast<int64_t>(S32Range.max)));
             }
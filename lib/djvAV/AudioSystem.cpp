@@ -36,6 +36,8 @@
 
 #include <RtAudio.h>
 
+#include <future>
+
 using namespace djv::Core;
 
 namespace djv
@@ -47,6 +49,7 @@ namespace djv
             struct System::Private
             {
                 std::unique_ptr<RtAudio> rtAudio;
+                std::future<void> probeFuture;
             };
 
             void System::_init(const std::shared_ptr<Core::Context>& context)
@@ -56,107 +59,115 @@ namespace djv
 
                 addDependency(context->getSystemT<CoreSystem>());
 
+                // Probing the audio devices can be slow, so it is done in the
+                // background to avoid delaying startup.
+                p.probeFuture = std::async(
+                    std::launch::async,
+                    [this]
                 {
-                    std::stringstream ss;
-                    ss << "RtAudio version: " << RtAudio::getVersion();
-                    _log(ss.str());
-                }
-                std::vector<RtAudio::Api> rtAudioApis;
-                RtAudio::getCompiledApi(rtAudioApis);
-                for (auto i : rtAudioApis)
-                {
-                    std::stringstream ss;
-                    ss << "RtAudio API: " << RtAudio::getApiDisplayName(i);
-                    _log(ss.str());
-                }
-
-                try
-                {
-                    p.rtAudio.reset(new RtAudio);
-                    const unsigned int deviceCount = p.rtAudio->getDeviceCount();
+                    DJV_PRIVATE_PTR();
+                    {
+                        std::stringstream ss;
+                        ss << "RtAudio version: " << RtAudio::getVersion();
+                        _log(ss.str());
+                    }
+                    std::vector<RtAudio::Api> rtAudioApis;
+                    RtAudio::getCompiledApi(rtAudioApis);
+                    for (auto i : rtAudioApis)
                     {
                         std::stringstream ss;
-                        ss << "Device count: " << deviceCount;
+                        ss << "RtAudio API: " << RtAudio::getApiDisplayName(i);
                         _log(ss.str());
                     }
-                    for (unsigned int i = 0; i < deviceCount; ++i)
+
+                    try
                     {
-                        const RtAudio::DeviceInfo info = p.rtAudio->getDeviceInfo(i);
-                        if (info.probed)
+                        p.rtAudio.reset(new RtAudio);
+                        const unsigned int deviceCount = p.rtAudio->getDeviceCount();
                         {
+                            std::stringstream ss;
+                            ss << "Device count: " << deviceCount;
+                            _log(ss.str());
+                        }
+                        for (unsigned int i = 0; i < deviceCount; ++i)
+                        {
+                            const RtAudio::DeviceInfo info = p.rtAudio->getDeviceInfo(i);
+                            if (info.probed)
                             {
-                                std::stringstream ss;
-                                ss << "Device " << i << " name: " << info.name;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " output channels: " << info.outputChannels;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " inuput channels: " << info.inputChannels;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " duplex channels: " << info.duplexChannels;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " sample rates: ";
-                                for (auto j : info.sampleRates)
                                 {
-                                    ss << j << " ";
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " name: " << info.name;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " output channels: " << info.outputChannels;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " inuput channels: " << info.inputChannels;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " duplex channels: " << info.duplexChannels;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " sample rates: ";
+                                    for (auto j : info.sampleRates)
+                                    {
+                                        ss << j << " ";
+                                    }
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " preferred sample rate: " << info.preferredSampleRate;
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " SINT8: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT8);
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " SINT16: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT16);
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " SINT24: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT24);
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " SINT32: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT32);
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " FLOAT32: " << static_cast<bool>(info.nativeFormats & RTAUDIO_FLOAT32);
+                                    _log(ss.str());
+                                }
+                                {
+                                    std::stringstream ss;
+                                    ss << "Device " << i << " FLOAT64: " << static_cast<bool>(info.nativeFormats & RTAUDIO_FLOAT64);
+                                    _log(ss.str());
                                 }
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " preferred sample rate: " << info.preferredSampleRate;
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " SINT8: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT8);
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " SINT16: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT16);
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " SINT24: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT24);
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " SINT32: " << static_cast<bool>(info.nativeFormats & RTAUDIO_SINT32);
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " FLOAT32: " << static_cast<bool>(info.nativeFormats & RTAUDIO_FLOAT32);
-                                _log(ss.str());
-                            }
-                            {
-                                std::stringstream ss;
-                                ss << "Device " << i << " FLOAT64: " << static_cast<bool>(info.nativeFormats & RTAUDIO_FLOAT64);
-                                _log(ss.str());
                             }
                         }
                     }
-                }
-                catch (const std::exception& e)
-                {
-                    std::stringstream ss;
-                    ss << DJV_TEXT("RtAudio cannot be initialized") << ". " << e.what();
-                    _log(ss.str(), LogLevel::Error);
-                }
+                    catch (const std::exception& e)
+                    {
+                        std::stringstream ss;
+                        ss << DJV_TEXT("RtAudio cannot be initialized") << ". " << e.what();
+                        _log(ss.str(), LogLevel::Error);
+                    }
+                });
             }
 
             System::System() :
@@ -164,7 +175,13 @@ namespace djv
             {}
 
             System::~System()
-            {}
+            {
+                DJV_PRIVATE_PTR();
+                if (p.probeFuture.valid())
+                {
+                    p.probeFuture.wait();
+                }
+            }
 
             std::shared_ptr<System> System::create(const std::shared_ptr<Core::Context>& context)
             {
@@ -251,6 +251,15 @@ namespace djv
                         info.video[0].info.type = Image::getIntType(channels, out.image.elem[0].bitDepth);
                     }
                     break;
+                    case Components::TypeB:
+                        // Method B is converted to method A when the image is read.
+                        if (10 == out.image.elem[0].bitDepth &&
+                            Descriptor::RGB == static_cast<Descriptor>(out.image.elem[0].descriptor))
+                        {
+                            info.video[0].info.type = Image::Type::RGB_U10;
+                            info.video[0].info.layout.alignment = 4;
+                        }
+                        break;
                     case Components::TypeA:
                         switch (out.image.elem[0].bitDepth)
                         {
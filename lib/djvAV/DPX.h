@@ -334,7 +334,7 @@ namespace djv
                     std::shared_ptr<Image::Image> _readImage(const std::string &) override;
 
                 private:
-                    Info _open(const std::string &, Core::FileSystem::FileIO &);
+                    Info _open(const std::string &, Core::FileSystem::FileIO &, Header &);
 
                     DJV_PRIVATE();
                 };
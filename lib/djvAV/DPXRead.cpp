@@ -72,25 +72,52 @@ namespace djv
                 Info Read::_readInfo(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    return _open(fileName, io);
+                    Header header;
+                    return _open(fileName, io, header);
                 }
 
                 std::shared_ptr<Image::Image> Read::_readImage(const std::string & fileName)
                 {
                     FileSystem::FileIO io;
-                    const auto info = _open(fileName, io);
-                    auto out = Cineon::Read::readImage(info, io);
+                    Header header;
+                    const auto info = _open(fileName, io, header);
+                    std::shared_ptr<Image::Image> out;
+                    if (Components::TypeB == static_cast<Components>(header.image.elem[0].packing))
+                    {
+                        // Method B stores the components in the low 30 bits of
+                        // each word, shift them up to match method A.
+                        auto imageInfo = info.video[0].info;
+                        const bool convertEndian = imageInfo.layout.endian != Memory::getEndian();
+                        imageInfo.layout.endian = Memory::getEndian();
+                        out = Image::Image::create(imageInfo);
+                        io.read(out->getData(), io.getSize() - io.getPos());
+                        const size_t size = out->getDataByteCount() / 4;
+                        uint32_t * p = reinterpret_cast<uint32_t *>(out->getData());
+                        if (convertEndian)
+                        {
+                            Memory::endian(p, size, 4);
+                        }
+                        for (size_t i = 0; i < size; ++i)
+                        {
+                            p[i] <<= 2;
+                        }
+                        out->setTags(info.tags);
+                    }
+                    else
+                    {
+                        out = Cineon::Read::readImage(info, io);
+                    }
                     out->setPluginName(pluginName);
                     return out;
                 }
 
-                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io)
+                Info Read::_open(const std::string & fileName, FileSystem::FileIO & io, Header & header)
                 {
                     DJV_PRIVATE_PTR();
                     io.open(fileName, FileSystem::FileIO::Mode::Read);
                     Info info;
                     info.video.resize(1);
-                    DPX::read(io, info, p.colorProfile);
+                    header = DPX::read(io, info, p.colorProfile);
                     info.video[0].sequence = _sequence;
                     return info;
                 }
@@ -74,6 +74,8 @@ namespace djv
                     AVFrame * avFrame = nullptr;
                     AVFrame * avFrameRgb = nullptr;
                     SwsContext * swsContext = nullptr;
+                    std::vector<float> downmixMatrix;
+                    std::vector<uint8_t> audioBuffer;
                 };
 
                 void Read::_init(
@@ -320,6 +322,10 @@ namespace djv
                                 case 8: break;
                                 default: channelCount = 2; break;
                                 }
+                                p.downmixMatrix = Audio::Data::getDownmixMatrix(
+                                    p.avCodecParameters[p.avAudioStream]->channels,
+                                    channelCount,
+                                    p.avCodecParameters[p.avAudioStream]->channel_layout);
                                 p.audioInfo = AudioInfo(
                                     Audio::Info(
                                         channelCount,
@@ -755,141 +761,43 @@ namespace djv
                             auto info = p.audioInfo.info;
                             info.sampleCount = p.avFrame->nb_samples;
                             auto audioData = Audio::Data::create(info);
-                            switch (p.avCodecParameters[p.avAudioStream]->format)
+                            // Planar data is interleaved and extra channels are mixed
+                            // down, without any intermediate conversions.
+                            const uint8_t channelCount = p.avCodecParameters[p.avAudioStream]->channels;
+                            const size_t sampleCount = audioData->getSampleCount();
+                            const bool planar = av_sample_fmt_is_planar(
+                                static_cast<AVSampleFormat>(p.avCodecParameters[p.avAudioStream]->format));
+                            const uint8_t* data = p.avFrame->data[0];
+                            if (planar)
                             {
-                            case AV_SAMPLE_FMT_S16:
-                            {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
-                                {
-                                    memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
-                                }
-                                else
-                                {
-                                    Audio::Data::extract(
-                                        reinterpret_cast<int16_t*>(p.avFrame->data[0]),
-                                        reinterpret_cast<int16_t*>(audioData->getData()),
-                                        audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
-                                        info.channelCount);
-                                }
-                                break;
-                            }
-                            case AV_SAMPLE_FMT_S32:
-                            {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
-                                {
-                                    memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
-                                }
-                                else
+                                uint8_t* interleaved = audioData->getData();
+                                if (channelCount != info.channelCount)
                                 {
-                                    Audio::Data::extract(
-                                        reinterpret_cast<int32_t*>(p.avFrame->data[0]),
-                                        reinterpret_cast<int32_t*>(audioData->getData()),
-                                        audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
-                                        info.channelCount);
-                                }
-                                break;
-                            }
-                            case AV_SAMPLE_FMT_FLT:
-                            {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
-                                {
-                                    memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
-                                }
-                                else
-                                {
-                                    Audio::Data::extract(
-                                        reinterpret_cast<float*>(p.avFrame->data[0]),
-                                        reinterpret_cast<float*>(audioData->getData()),
-                                        audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
-                                        info.channelCount);
-                                }
-                                break;
-                            }
-                            case AV_SAMPLE_FMT_DBL:
-                            {
-                                if (p.avCodecParameters[p.avAudioStream]->channels == info.channelCount)
-                                {
-                                    memcpy(audioData->getData(), p.avFrame->data[0], audioData->getByteCount());
-                                }
-                                else
-                                {
-                                    Audio::Data::extract(
-                                        reinterpret_cast<double*>(p.avFrame->data[0]),
-                                        reinterpret_cast<double*>(audioData->getData()),
-                                        audioData->getSampleCount(),
-                                        p.avCodecParameters[p.avAudioStream]->channels,
-                                        info.channelCount);
-                                }
-                                break;
-                            }
-                            case AV_SAMPLE_FMT_S16P:
-                            {
-                                const size_t channelCount = info.channelCount;
-                                const int16_t** c = new const int16_t * [channelCount];
-                                for (size_t i = 0; i < channelCount; ++i)
-                                {
-                                    c[i] = reinterpret_cast<int16_t*>(p.avFrame->data[i]);
-                                }
-                                Audio::Data::planarInterleave(
-                                    c,
-                                    reinterpret_cast<int16_t*>(audioData->getData()),
-                                    audioData->getSampleCount(),
-                                    channelCount);
-                                delete [] c;
-                                break;
-                            }
-                            case AV_SAMPLE_FMT_S32P:
-                            {
-                                const size_t channelCount = info.channelCount;
-                                const int32_t** c = new const int32_t * [channelCount];
-                                for (size_t i = 0; i < channelCount; ++i)
-                                {
-                                    c[i] = reinterpret_cast<int32_t*>(p.avFrame->data[i]);
+                                    p.audioBuffer.resize(sampleCount * channelCount * Audio::getByteCount(info.type));
+                                    interleaved = p.audioBuffer.data();
                                 }
                                 Audio::Data::planarInterleave(
-                                    c,
-                                    reinterpret_cast<int32_t*>(audioData->getData()),
-                                    audioData->getSampleCount(),
-                                    channelCount);
-                                delete [] c;
-                                break;
+                                    p.avFrame->extended_data,
+                                    interleaved,
+                                    sampleCount,
+                                    channelCount,
+                                    info.type);
+                                data = interleaved;
                             }
-                            case AV_SAMPLE_FMT_FLTP:
+                            if (channelCount != info.channelCount)
                             {
-                                const size_t channelCount = info.channelCount;
-                                const float** c = new const float* [channelCount];
-                                for (size_t i = 0; i < channelCount; ++i)
-                                {
-                                    c[i] = reinterpret_cast<float*>(p.avFrame->data[i]);
-                                }
-                                Audio::Data::planarInterleave(
-                                    c,
-                                    reinterpret_cast<float*>(audioData->getData()),
-                                    audioData->getSampleCount(),
-                                    channelCount);
-                                delete [] c;
-                                break;
+                                Audio::Data::downmix(
+                                    data,
+                                    audioData->getData(),
+                                    sampleCount,
+                                    channelCount,
+                                    info.channelCount,
+                                    info.type,
+                                    p.downmixMatrix.data());
                             }
-                            case AV_SAMPLE_FMT_DBLP:
+                            else if (!planar)
                             {
-                                const size_t channelCount = info.channelCount;
-                                const double** c = new const double* [channelCount];
-                                for (size_t i = 0; i < channelCount; ++i)
-                                {
-                                    c[i] = reinterpret_cast<double*>(p.avFrame->data[i]);
-                                }
-                                Audio::Data::planarInterleave(
-                                    c,
-                                    reinterpret_cast<double*>(audioData->getData()),
-                                    audioData->getSampleCount(),
-                                    channelCount);
-                                delete [] c;
-                                break;
-                            }
-                            default: break;
+                                memcpy(audioData->getData(), data, audioData->getByteCount());
                             }
                             {
                                 std::lock_guard<std::mutex> lock(_mutex);
@@ -29,10 +29,11 @@
 
 #include <djvAV/FontSystem.h>
 
-#include <djvCore/Cache.h>
 #include <djvCore/Context.h>
 #include <djvCore/CoreSystem.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/LRUCache.h>
+#include <djvCore/Math.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/Timer.h>
 #include <djvCore/Vector.h>
@@ -41,6 +42,7 @@
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 
+#include <algorithm>
 #include <atomic>
 #include <codecvt>
 #include <condition_variable>
@@ -61,6 +63,9 @@ namespace djv
             {
                 //! \todo Should this be configurable?
                 const size_t glyphCacheMax = 10000;
+                const size_t glyphCacheShardCount = 8;
+                const size_t textCacheMax = 1000;
+                const size_t threadCountMax = 4;
                 const bool lcdHinting = true;
 
                 class MetricsRequest
@@ -110,6 +115,7 @@ namespace djv
                     std::string text;
                     Info info;
                     bool cacheOnly = false;
+                    UID uid = 0;
                     std::promise<std::vector<std::shared_ptr<Glyph> > > promise;
                 };
 
@@ -123,9 +129,73 @@ namespace djv
                     std::string text;
                     Info info;
                     uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max();
+                    UID uid = 0;
                     std::promise<std::vector<TextLine> > promise;
                 };
 
+                //! This struct provides a key for the memoized text layout results.
+                struct TextCacheKey
+                {
+                    TextCacheKey(const std::string& text, const Info& info, uint16_t maxLineWidth) :
+                        text(text),
+                        info(info),
+                        maxLineWidth(maxLineWidth)
+                    {}
+
+                    std::string text;
+                    Info info;
+                    uint16_t maxLineWidth = std::numeric_limits<uint16_t>::max();
+
+                    bool operator == (const TextCacheKey& other) const
+                    {
+                        return text == other.text && info == other.info && maxLineWidth == other.maxLineWidth;
+                    }
+
+                    bool operator < (const TextCacheKey& other) const
+                    {
+                        return std::tie(text, info, maxLineWidth) < std::tie(other.text, other.info, other.maxLineWidth);
+                    }
+                };
+
+                struct TextCacheKeyHash
+                {
+                    size_t operator() (const TextCacheKey& value) const
+                    {
+                        size_t out = 0;
+                        Memory::hashCombine(out, value.text);
+                        Memory::hashCombine(out, value.info.getHash());
+                        Memory::hashCombine(out, value.maxLineWidth);
+                        return out;
+                    }
+                };
+
+                //! Move a share of the queued requests to a thread, leaving the
+                //! remainder for the other threads.
+                template<typename T>
+                bool takeRequests(std::list<T>& queue, std::list<T>& requests, size_t threadCount)
+                {
+                    const size_t size = queue.size();
+                    if (size)
+                    {
+                        const size_t count = std::max(size / threadCount, static_cast<size_t>(1));
+                        auto end = queue.begin();
+                        std::advance(end, count);
+                        requests.splice(requests.end(), queue, queue.begin(), end);
+                    }
+                    return queue.size() > 0;
+                }
+
+                //! Remove the queued requests with the given ID.
+                template<typename T>
+                void cancelRequests(std::list<T>& queue, UID uid)
+                {
+                    queue.remove_if(
+                        [uid](const T& value)
+                        {
+                            return value.uid == uid;
+                        });
+                }
+
                 constexpr bool isSpace(djv_char_t c)
                 {
                     return ' ' == c || '\t' == c;
@@ -171,7 +241,22 @@ namespace djv
 
             struct System::Private
             {
-                FT_Library ftLibrary = nullptr;
+                //! This struct provides the state for a worker thread. FreeType
+                //! faces cannot be shared between threads so each thread has
+                //! its own.
+                struct Worker
+                {
+                    FT_Library ftLibrary = nullptr;
+                    std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
+                    std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
+                    std::list<MetricsRequest> metricsRequests;
+                    std::list<MeasureRequest> measureRequests;
+                    std::list<MeasureGlyphsRequest> measureGlyphsRequests;
+                    std::list<GlyphsRequest> glyphsRequests;
+                    std::list<TextLinesRequest> textLinesRequests;
+                    std::thread thread;
+                };
+
                 FileSystem::Path fontPath;
                 std::map<FamilyID, std::string> fontFileNames;
                 std::map<FamilyID, std::string> fontNames;
@@ -179,7 +264,6 @@ namespace djv
                 std::mutex fontNamesMutex;
                 std::shared_ptr<Time::Timer> fontNamesTimer;
                 std::map<FamilyID, std::map<FaceID, std::string> > fontFaceNames;
-                std::map<FamilyID, std::map<FaceID, FT_Face> > fontFaces;
 
                 std::list<MetricsRequest> metricsQueue;
                 std::list<MeasureRequest> measureQueue;
@@ -188,24 +272,20 @@ namespace djv
                 std::list<TextLinesRequest> textLinesQueue;
                 std::condition_variable requestCV;
                 std::mutex requestMutex;
-                std::list<MetricsRequest> metricsRequests;
-                std::list<MeasureRequest> measureRequests;
-                std::list<MeasureGlyphsRequest> measureGlyphsRequests;
-                std::list<GlyphsRequest> glyphsRequests;
-                std::list<TextLinesRequest> textLinesRequests;
 
-                std::wstring_convert<std::codecvt_utf8<djv_char_t>, djv_char_t> utf32Convert;
-                Memory::Cache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache;
-                std::atomic<size_t> glyphCacheSize;
-                std::atomic<float> glyphCachePercentageUsed;
+                Memory::ShardedLRUCache<GlyphInfo, std::shared_ptr<Glyph> > glyphCache{ glyphCacheShardCount };
+                Memory::ShardedLRUCache<TextCacheKey, glm::vec2, TextCacheKeyHash> measureCache;
+                Memory::ShardedLRUCache<TextCacheKey, std::vector<BBox2f>, TextCacheKeyHash> measureGlyphsCache;
+                Memory::ShardedLRUCache<TextCacheKey, std::vector<TextLine>, TextCacheKeyHash> textLinesCache;
 
                 std::shared_ptr<Time::Timer> statsTimer;
-                std::thread thread;
+                std::vector<std::unique_ptr<Worker> > workers;
                 std::atomic<bool> running;
 
-                bool getText(const std::string&, const Info&, std::basic_string<djv_char_t>&, FT_Face&, std::string& error);
-                std::shared_ptr<Glyph> getGlyph(const GlyphInfo &);
+                bool getText(Worker&, const std::string&, const Info&, std::basic_string<djv_char_t>&, FT_Face&, std::string& error);
+                std::shared_ptr<Glyph> getGlyph(Worker&, const GlyphInfo &);
                 void measure(
+                    Worker&,
                     const std::basic_string<djv_char_t>& utf32,
                     const Info&,
                     FT_Face,
@@ -225,8 +305,9 @@ namespace djv
                 p.fontPath = _getResourceSystem()->getPath(FileSystem::ResourcePath::Fonts);
                 p.fontNamesSubject = MapSubject<FamilyID, std::string>::create();
                 p.glyphCache.setMax(glyphCacheMax);
-                p.glyphCacheSize = 0;
-                p.glyphCachePercentageUsed = 0.F;
+                p.measureCache.setMax(textCacheMax);
+                p.measureGlyphsCache.setMax(textCacheMax);
+                p.textLinesCache.setMax(textCacheMax);
 
                 p.fontNamesTimer = Time::Timer::create(context);
                 p.fontNamesTimer->setRepeating(true);
@@ -251,62 +332,85 @@ namespace djv
                 {
                     DJV_PRIVATE_PTR();
                     std::stringstream ss;
-                    ss << "Glyph cache: " << p.glyphCacheSize << ", " << p.glyphCachePercentageUsed << "%";
+                    ss << "Glyph cache: " << p.glyphCache.getSize() << ", " << p.glyphCache.getPercentageUsed() << "%";
                     _log(ss.str());
                 });
 
+                const size_t threadCount = Math::clamp(
+                    static_cast<size_t>(std::thread::hardware_concurrency()),
+                    static_cast<size_t>(1),
+                    threadCountMax);
+                {
+                    std::stringstream ss;
+                    ss << "Thread count: " << threadCount;
+                    _log(ss.str());
+                }
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.workers.push_back(std::unique_ptr<Private::Worker>(new Private::Worker));
+                }
                 p.running = true;
-                p.thread = std::thread(
-                    [this]
+                for (size_t i = 0; i < threadCount; ++i)
                 {
-                    DJV_PRIVATE_PTR();
-                    _initFreeType();
-                    const auto timeout = Time::getValue(Time::TimerValue::Fast);
-                    while (p.running)
+                    p.workers[i]->thread = std::thread(
+                        [this, i, threadCount]
                     {
+                        DJV_PRIVATE_PTR();
+                        _initFreeType(i);
+                        auto& worker = *p.workers[i];
+                        const auto timeout = Time::getValue(Time::TimerValue::Fast);
+                        while (p.running)
                         {
-                            std::unique_lock<std::mutex> lock(p.requestMutex);
-                            p.requestCV.wait_for(
-                                lock,
-                                std::chrono::milliseconds(timeout),
-                                [this]
                             {
-                                DJV_PRIVATE_PTR();
-                                return
-                                    p.metricsQueue.size() ||
-                                    p.measureQueue.size() ||
-                                    p.glyphsQueue.size() ||
-                                    p.textLinesQueue.size();
-                            });
-                            p.metricsRequests = std::move(p.metricsQueue);
-                            p.measureRequests = std::move(p.measureQueue);
-                            p.measureGlyphsRequests = std::move(p.measureGlyphsQueue);
-                            p.glyphsRequests = std::move(p.glyphsQueue);
-                            p.textLinesRequests = std::move(p.textLinesQueue);
-                        }
-                        if (p.metricsRequests.size())
-                        {
-                            _handleMetricsRequests();
-                        }
-                        if (p.measureRequests.size())
-                        {
-                            _handleMeasureRequests();
-                        }
-                        if (p.measureGlyphsRequests.size())
-                        {
-                            _handleMeasureGlyphsRequests();
-                        }
-                        if (p.glyphsRequests.size())
-                        {
-                            _handleGlyphsRequests();
-                        }
-                        if (p.textLinesRequests.size())
-                        {
-                            _handleTextLinesRequests();
+                                std::unique_lock<std::mutex> lock(p.requestMutex);
+                                p.requestCV.wait_for(
+                                    lock,
+                                    std::chrono::milliseconds(timeout),
+                                    [this]
+                                {
+                                    DJV_PRIVATE_PTR();
+                                    return
+                                        p.metricsQueue.size() ||
+                                        p.measureQueue.size() ||
+                                        p.measureGlyphsQueue.size() ||
+                                        p.glyphsQueue.size() ||
+                                        p.textLinesQueue.size();
+                                });
+                                bool remaining = false;
+                                remaining |= takeRequests(p.metricsQueue, worker.metricsRequests, threadCount);
+                                remaining |= takeRequests(p.measureQueue, worker.measureRequests, threadCount);
+                                remaining |= takeRequests(p.measureGlyphsQueue, worker.measureGlyphsRequests, threadCount);
+                                remaining |= takeRequests(p.glyphsQueue, worker.glyphsRequests, threadCount);
+                                remaining |= takeRequests(p.textLinesQueue, worker.textLinesRequests, threadCount);
+                                if (remaining)
+                                {
+                                    p.requestCV.notify_one();
+                                }
+                            }
+                            if (worker.metricsRequests.size())
+                            {
+                                _handleMetricsRequests(i);
+                            }
+                            if (worker.measureRequests.size())
+                            {
+                                _handleMeasureRequests(i);
+                            }
+                            if (worker.measureGlyphsRequests.size())
+                            {
+                                _handleMeasureGlyphsRequests(i);
+                            }
+                            if (worker.glyphsRequests.size())
+                            {
+                                _handleGlyphsRequests(i);
+                            }
+                            if (worker.textLinesRequests.size())
+                            {
+                                _handleTextLinesRequests(i);
+                            }
                         }
-                    }
-                    _delFreeType();
-                });
+                        _delFreeType(i);
+                    });
+                }
             }
 
             System::System() :
@@ -317,9 +421,12 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
-                if (p.thread.joinable())
+                for (const auto& i : p.workers)
                 {
-                    p.thread.join();
+                    if (i->thread.joinable())
+                    {
+                        i->thread.join();
+                    }
                 }
             }
 
@@ -356,6 +463,14 @@ namespace djv
                 request.text = text;
                 request.info = info;
                 auto future = request.promise.get_future();
+                {
+                    glm::vec2 size;
+                    if (p.measureCache.get(TextCacheKey(text, info, request.maxLineWidth), size))
+                    {
+                        request.promise.set_value(size);
+                        return future;
+                    }
+                }
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.measureQueue.push_back(std::move(request));
@@ -371,6 +486,14 @@ namespace djv
                 request.text = text;
                 request.info = info;
                 auto future = request.promise.get_future();
+                {
+                    std::vector<BBox2f> glyphGeom;
+                    if (p.measureGlyphsCache.get(TextCacheKey(text, info, request.maxLineWidth), glyphGeom))
+                    {
+                        request.promise.set_value(std::move(glyphGeom));
+                        return future;
+                    }
+                }
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.measureGlyphsQueue.push_back(std::move(request));
@@ -379,12 +502,13 @@ namespace djv
                 return future;
             }
 
-            std::future<std::vector<std::shared_ptr<Glyph> > > System::getGlyphs(const std::string& text, const Info& info)
+            std::future<std::vector<std::shared_ptr<Glyph> > > System::getGlyphs(const std::string& text, const Info& info, UID uid)
             {
                 DJV_PRIVATE_PTR();
                 GlyphsRequest request;
                 request.text = text;
                 request.info = info;
+                request.uid = uid;
                 auto future = request.promise.get_future();
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
@@ -394,14 +518,23 @@ namespace djv
                 return future;
             }
 
-            std::future<std::vector<TextLine> > System::textLines(const std::string& text, uint16_t maxLineWidth, const Info& info)
+            std::future<std::vector<TextLine> > System::textLines(const std::string& text, uint16_t maxLineWidth, const Info& info, UID uid)
             {
                 DJV_PRIVATE_PTR();
                 TextLinesRequest request;
                 request.text = text;
                 request.info = info;
                 request.maxLineWidth = maxLineWidth;
+                request.uid = uid;
                 auto future = request.promise.get_future();
+                {
+                    std::vector<TextLine> lines;
+                    if (p.textLinesCache.get(TextCacheKey(text, info, maxLineWidth), lines))
+                    {
+                        request.promise.set_value(std::move(lines));
+                        return future;
+                    }
+                }
                 {
                     std::unique_lock<std::mutex> lock(p.requestMutex);
                     p.textLinesQueue.push_back(std::move(request));
@@ -410,6 +543,16 @@ namespace djv
                 return future;
             }
 
+            void System::cancel(UID uid)
+            {
+                DJV_PRIVATE_PTR();
+                if (!uid)
+                    return;
+                std::unique_lock<std::mutex> lock(p.requestMutex);
+                cancelRequests(p.glyphsQueue, uid);
+                cancelRequests(p.textLinesQueue, uid);
+            }
+
             void System::cacheGlyphs(const std::string& text, const Info& info)
             {
                 DJV_PRIVATE_PTR();
@@ -426,36 +569,53 @@ namespace djv
 
             size_t System::getGlyphCacheSize() const
             {
-                return _p->glyphCacheSize;
+                return _p->glyphCache.getSize();
             }
 
             float System::getGlyphCachePercentage() const
             {
-                return _p->glyphCachePercentageUsed;
+                return _p->glyphCache.getPercentageUsed();
+            }
+
+            size_t System::getThreadCount() const
+            {
+                return _p->workers.size();
             }
 
-            void System::_initFreeType()
+            void System::_initFreeType(size_t thread)
             {
                 DJV_PRIVATE_PTR();
+                auto& worker = *p.workers[thread];
                 try
                 {
-                    FT_Error ftError = FT_Init_FreeType(&p.ftLibrary);
+                    FT_Error ftError = FT_Init_FreeType(&worker.ftLibrary);
                     if (ftError)
                     {
                         throw Error("FreeType cannot be initialized.");
                     }
-                    int versionMajor = 0;
-                    int versionMinor = 0;
-                    int versionPatch = 0;
-                    FT_Library_Version(p.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
+                    if (0 == thread)
                     {
+                        int versionMajor = 0;
+                        int versionMinor = 0;
+                        int versionPatch = 0;
+                        FT_Library_Version(worker.ftLibrary, &versionMajor, &versionMinor, &versionPatch);
                         std::stringstream ss;
                         ss << "FreeType version: " << versionMajor << "." << versionMinor << "." << versionPatch;
                         _log(ss.str());
                     }
+
+                    // Sort the file names so that each thread assigns the same IDs.
+                    std::vector<std::string> fileNames;
                     for (const auto & i : FileSystem::FileInfo::directoryList(p.fontPath))
                     {
-                        const std::string & fileName = i.getFileName();
+                        fileNames.push_back(i.getFileName());
+                    }
+                    std::sort(fileNames.begin(), fileNames.end());
+                    FamilyID familyID = 0;
+                    const FaceID faceID = 1;
+                    for (const auto & fileName : fileNames)
+                    {
+                        if (0 == thread)
                         {
                             std::stringstream ss;
                             ss << "Loading font: " << fileName;
@@ -463,32 +623,37 @@ namespace djv
                         }
 
                         FT_Face ftFace;
-                        ftError = FT_New_Face(p.ftLibrary, fileName.c_str(), 0, &ftFace);
+                        ftError = FT_New_Face(worker.ftLibrary, fileName.c_str(), 0, &ftFace);
                         if (ftError)
                         {
-                            std::stringstream ss;
-                            ss << "Cannot load font: " << fileName;
-                            _log(ss.str(), LogLevel::Error);
+                            if (0 == thread)
+                            {
+                                std::stringstream ss;
+                                ss << "Cannot load font: " << fileName;
+                                _log(ss.str(), LogLevel::Error);
+                            }
                         }
                         else
                         {
-                            std::stringstream ss;
-                            ss << "    Family: " << ftFace->family_name << '\n';
-                            ss << "    Style: " << ftFace->style_name << '\n';
-                            ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
-                            ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
-                            ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
-                            _log(ss.str());
-                            static FamilyID familyID = 0;
-                            static FaceID faceID = 1;
                             ++familyID;
-                            p.fontFileNames[familyID] = fileName;
-                            p.fontNames[familyID] = ftFace->family_name;
-                            p.fontFaceNames[familyID][faceID] = ftFace->style_name;
-                            p.fontFaces[familyID][faceID] = ftFace;
+                            worker.fontFaces[familyID][faceID] = ftFace;
+                            if (0 == thread)
+                            {
+                                std::stringstream ss;
+                                ss << "    Family: " << ftFace->family_name << '\n';
+                                ss << "    Style: " << ftFace->style_name << '\n';
+                                ss << "    Number of glyphs: " << static_cast<int>(ftFace->num_glyphs) << '\n';
+                                ss << "    Scalable: " << (FT_IS_SCALABLE(ftFace) ? "true" : "false") << '\n';
+                                ss << "    Kerning: " << (FT_HAS_KERNING(ftFace) ? "true" : "false");
+                                _log(ss.str());
+                                std::unique_lock<std::mutex> lock(p.fontNamesMutex);
+                                p.fontFileNames[familyID] = fileName;
+                                p.fontNames[familyID] = ftFace->family_name;
+                                p.fontFaceNames[familyID][faceID] = ftFace->style_name;
+                            }
                         }
                     }
-                    if (!p.fontFaces.size())
+                    if (!worker.fontFaces.size())
                     {
                         throw Error("No fonts were found.");
                     }
@@ -499,30 +664,32 @@ namespace djv
                 }
             }
 
-            void System::_delFreeType()
+            void System::_delFreeType(size_t thread)
             {
                 DJV_PRIVATE_PTR();
-                if (p.ftLibrary)
+                auto& worker = *p.workers[thread];
+                if (worker.ftLibrary)
                 {
-                    for (const auto & i : p.fontFaces)
+                    for (const auto & i : worker.fontFaces)
                     {
                         for (const auto & j : i.second)
                         {
                             FT_Done_Face(j.second);
                         }
                     }
-                    FT_Done_FreeType(p.ftLibrary);
+                    FT_Done_FreeType(worker.ftLibrary);
                 }
             }
 
-            void System::_handleMetricsRequests()
+            void System::_handleMetricsRequests(size_t thread)
             {
                 DJV_PRIVATE_PTR();
-                for (auto & request : p.metricsRequests)
+                auto& worker = *p.workers[thread];
+                for (auto & request : worker.metricsRequests)
                 {
                     Metrics metrics;
-                    const auto family = p.fontFaces.find(request.info.getFamily());
-                    if (family != p.fontFaces.end())
+                    const auto family = worker.fontFaces.find(request.info.getFamily());
+                    if (family != worker.fontFaces.end())
                     {
                         const auto font = family->second.find(request.info.getFace());
                         if (font != family->second.end())
@@ -547,21 +714,23 @@ namespace djv
                     }
                     request.promise.set_value(std::move(metrics));
                 }
-                p.metricsRequests.clear();
+                worker.metricsRequests.clear();
             }
 
-            void System::_handleMeasureRequests()
+            void System::_handleMeasureRequests(size_t thread)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.measureRequests)
+                auto& worker = *p.workers[thread];
+                for (auto& request : worker.measureRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
                     FT_Face font;
                     std::string error;
                     glm::vec2 size = glm::vec2(0.F, 0.F);
-                    if (p.getText(request.text, request.info, utf32, font, error))
+                    if (p.getText(worker, request.text, request.info, utf32, font, error))
                     {
-                        p.measure(utf32, request.info, font, request.maxLineWidth, size);
+                        p.measure(worker, utf32, request.info, font, request.maxLineWidth, size);
+                        p.measureCache.add(TextCacheKey(request.text, request.info, request.maxLineWidth), size);
                     }
                     else
                     {
@@ -571,22 +740,24 @@ namespace djv
                     }
                     request.promise.set_value(size);
                 }
-                p.measureRequests.clear();
+                worker.measureRequests.clear();
             }
 
-            void System::_handleMeasureGlyphsRequests()
+            void System::_handleMeasureGlyphsRequests(size_t thread)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.measureGlyphsRequests)
+                auto& worker = *p.workers[thread];
+                for (auto& request : worker.measureGlyphsRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
                     FT_Face font;
                     std::string error;
                     glm::vec2 size = glm::vec2(0.F, 0.F);
                     std::vector<BBox2f> glyphGeom;
-                    if (p.getText(request.text, request.info, utf32, font, error))
+                    if (p.getText(worker, request.text, request.info, utf32, font, error))
                     {
-                        p.measure(utf32, request.info, font, request.maxLineWidth, size, &glyphGeom);
+                        p.measure(worker, utf32, request.info, font, request.maxLineWidth, size, &glyphGeom);
+                        p.measureGlyphsCache.add(TextCacheKey(request.text, request.info, request.maxLineWidth), glyphGeom);
                     }
                     else
                     {
@@ -596,18 +767,19 @@ namespace djv
                     }
                     request.promise.set_value(glyphGeom);
                 }
-                p.measureGlyphsRequests.clear();
+                worker.measureGlyphsRequests.clear();
             }
 
-            void System::_handleGlyphsRequests()
+            void System::_handleGlyphsRequests(size_t thread)
             {
                 DJV_PRIVATE_PTR();
-                for (auto & request : p.glyphsRequests)
+                auto& worker = *p.workers[thread];
+                for (auto & request : worker.glyphsRequests)
                 {
                     std::basic_string<djv_char_t> utf32;
                     try
                     {
-                        utf32 = p.utf32Convert.from_bytes(request.text);
+                        utf32 = worker.utf32Convert.from_bytes(request.text);
                     }
                     catch (const std::exception & e)
                     {
@@ -620,7 +792,7 @@ namespace djv
                     {
                         for (size_t i = 0; i < size; ++i)
                         {
-                            p.getGlyph(GlyphInfo(utf32[i], request.info));
+                            p.getGlyph(worker, GlyphInfo(utf32[i], request.info));
                         }
                     }
                     else
@@ -628,18 +800,19 @@ namespace djv
                         std::vector<std::shared_ptr<Glyph> > glyphs(size);
                         for (size_t i = 0; i < size; ++i)
                         {
-                            glyphs[i] = p.getGlyph(GlyphInfo(utf32[i], request.info));
+                            glyphs[i] = p.getGlyph(worker, GlyphInfo(utf32[i], request.info));
                         }
                         request.promise.set_value(std::move(glyphs));
                     }
                 }
-                p.glyphsRequests.clear();
+                worker.glyphsRequests.clear();
             }
 
-            void System::_handleTextLinesRequests()
+            void System::_handleTextLinesRequests(size_t thread)
             {
                 DJV_PRIVATE_PTR();
-                for (auto& request : p.textLinesRequests)
+                auto& worker = *p.workers[thread];
+                for (auto& request : worker.textLinesRequests)
                 {
                     // Input:
                     //   Speckled Dace are capable of |living in an array of habitats
@@ -660,7 +833,7 @@ namespace djv
                     FT_Face font;
                     std::string error;
                     std::vector<TextLine> lines;
-                    if (p.getText(request.text, request.info, utf32, font, error))
+                    if (p.getText(worker, request.text, request.info, utf32, font, error))
                     {
                         // Get the glyphs.
                         std::vector<std::shared_ptr<Glyph> > glyphs(utf32.size());
@@ -669,7 +842,7 @@ namespace djv
                         for (; i != utf32.end(); ++i)
                         {
                             const auto info = GlyphInfo(*i, request.info);
-                            auto glyph = p.getGlyph(info);
+                            auto glyph = p.getGlyph(worker, info);
                             glyphs[i - utf32Begin] = glyph;
                         }
 
@@ -709,7 +882,7 @@ namespace djv
                                     const size_t offset = lineBegin - utf32.begin();
                                     const size_t size = i - lineBegin;
                                     TextLine line;
-                                    line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                    line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                     line.size = glm::vec2(pos.x, font->size->metrics.height / 64.F);
                                     line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                     lines.push_back(line);
@@ -738,7 +911,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(lineBreakPos, font->size->metrics.height / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -761,7 +934,7 @@ namespace djv
                                         const size_t offset = lineBegin - utf32.begin();
                                         const size_t size = i - lineBegin;
                                         TextLine line;
-                                        line.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                        line.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                         line.size = glm::vec2(pos.x, font->size->metrics.height / 64.F);
                                         line.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                         lines.push_back(line);
@@ -798,7 +971,7 @@ namespace djv
                                 const size_t offset = lineBegin - utf32.begin();
                                 const size_t size = i - lineBegin;
                                 TextLine textLine;
-                                textLine.text = p.utf32Convert.to_bytes(utf32.substr(offset, size));
+                                textLine.text = worker.utf32Convert.to_bytes(utf32.substr(offset, size));
                                 textLine.size = glm::vec2(pos.x, font->size->metrics.height / 64.F);
                                 textLine.glyphs = std::vector<std::shared_ptr<Glyph> >(glyphs.begin() + offset, glyphs.begin() + offset + size);
                                 lines.push_back(textLine);
@@ -810,6 +983,8 @@ namespace djv
                                 _log(ss.str(), LogLevel::Error);
                             }
                         }
+
+                        p.textLinesCache.add(TextCacheKey(request.text, request.info, request.maxLineWidth), lines);
                     }
                     else
                     {
@@ -819,10 +994,11 @@ namespace djv
                     }
                     request.promise.set_value(lines);
                 }
-                p.textLinesRequests.clear();
+                worker.textLinesRequests.clear();
             }
 
             bool System::Private::getText(
+                Worker& worker,
                 const std::string& value,
                 const Info& info,
                 std::basic_string<djv_char_t>& utf32,
@@ -830,8 +1006,8 @@ namespace djv
                 std::string& error)
             {
                 bool out = false;
-                const auto family = fontFaces.find(info.getFamily());
-                if (family != fontFaces.end())
+                const auto family = worker.fontFaces.find(info.getFamily());
+                if (family != worker.fontFaces.end())
                 {
                     auto i = family->second.find(info.getFace());
                     if (i != family->second.end())
@@ -850,7 +1026,7 @@ namespace djv
                         {
                             try
                             {
-                                utf32 = utf32Convert.from_bytes(value);
+                                utf32 = worker.utf32Convert.from_bytes(value);
                                 font = i->second;
                                 out = true;
                             }
@@ -864,7 +1040,7 @@ namespace djv
                 return out;
             }
 
-            std::shared_ptr<Glyph> System::Private::getGlyph(const GlyphInfo & info)
+            std::shared_ptr<Glyph> System::Private::getGlyph(Worker& worker, const GlyphInfo & info)
             {
                 std::shared_ptr<Glyph> out;
                 FT_Face ftFace = nullptr;
@@ -874,8 +1050,8 @@ namespace djv
                     out->info = info;
                     if (info.info.getFamily() != 0 || info.info.getFace() != 0)
                     {
-                        const auto i = fontFaces.find(info.info.getFamily());
-                        if (i != fontFaces.end())
+                        const auto i = worker.fontFaces.find(info.info.getFamily());
+                        if (i != worker.fontFaces.end())
                         {
                             const auto j = i->second.find(info.info.getFace());
                             if (j != i->second.end())
@@ -946,7 +1122,7 @@ namespace djv
                                 bitmap->bitmap.rows,
                                 Image::getIntType(renderModeChannels, 8));
                             auto imageData = Image::Data::create(imageInfo);
-                            for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                            for (uint32_t y = 0; y < imageInfo.size.h; ++y)
                             {
                                 memcpy(
                                     imageData->getData(y),
@@ -961,14 +1137,13 @@ namespace djv
                             FT_Done_Glyph(ftGlyph);
                         }
                         glyphCache.add(info, out);
-                        glyphCacheSize = glyphCache.getSize();
-                        glyphCachePercentageUsed = glyphCache.getPercentageUsed();
                     }
                 }
                 return out;
             }
 
             void System::Private::measure(
+                Worker& worker,
                 const std::basic_string<djv_char_t>& utf32,
                 const Info& info,
                 FT_Face font,
@@ -983,7 +1158,7 @@ namespace djv
                 for (auto i = utf32.begin(); i != utf32.end(); ++i)
                 {
                     const auto glyphInfo = GlyphInfo(*i, info);
-                    const auto glyph = getGlyph(glyphInfo);
+                    const auto glyph = getGlyph(worker, glyphInfo);
 
                     if (glyphGeom)
                     {
@@ -35,6 +35,7 @@
 #include <djvCore/ISystem.h>
 #include <djvCore/MapObserver.h>
 #include <djvCore/Range.h>
+#include <djvCore/UID.h>
 
 #include <future>
 
@@ -63,6 +64,7 @@ namespace djv
                 FaceID   getFace() const;
                 uint16_t getSize() const;
                 uint16_t getDPI() const;
+                size_t   getHash() const;
 
                 bool operator == (const Info &) const;
                 bool operator < (const Info&) const;
@@ -140,6 +142,11 @@ namespace djv
 
             //! This class provides a font system.
             //!
+            //! Requests are serviced by a pool of threads, each with its own set of
+            //! FreeType faces. Glyphs are stored in a cache that is shared between
+            //! the threads, and the results of measuring and breaking text into
+            //! lines are memoized so that repeated layouts are returned immediately.
+            //!
             //! \todo Add support for LCD pixel sub-sampling and gamma correction:
             //! - https://www.freetype.org/freetype2/docs/text-rendering-general.html
             class System : public Core::ISystem
@@ -176,15 +183,23 @@ namespace djv
                     const Info&        info);
 
                 //! Get font glyphs.
+                //! \param uid An optional request ID for cancelling the request.
                 std::future<std::vector<std::shared_ptr<Glyph> > > getGlyphs(
                     const std::string& text,
-                    const Info&        info);
+                    const Info&        info,
+                    Core::UID          uid = 0);
 
                 //! Break text into lines for wrapping.
+                //! \param uid An optional request ID for cancelling the request.
                 std::future<std::vector<TextLine> > textLines(
                     const std::string& text,
                     uint16_t           maxLineWidth,
-                    const Info&        info);
+                    const Info&        info,
+                    Core::UID          uid = 0);
+
+                //! Cancel the glyph and text line requests with the given ID that
+                //! have not been started.
+                void cancel(Core::UID);
 
                 //! Request font glyphs to be cached.
                 void cacheGlyphs(const std::string& text, const Info&);
@@ -195,14 +210,17 @@ namespace djv
                 //! Get the glyph cache percentage used.
                 float getGlyphCachePercentage() const;
             
+                //! Get the number of worker threads.
+                size_t getThreadCount() const;
+
             private:
-                void _initFreeType();
-                void _delFreeType();
-                void _handleMetricsRequests();
-                void _handleMeasureRequests();
-                void _handleTextLinesRequests();
-                void _handleMeasureGlyphsRequests();
-                void _handleGlyphsRequests();
+                void _initFreeType(size_t thread);
+                void _delFreeType(size_t thread);
+                void _handleMetricsRequests(size_t thread);
+                void _handleMeasureRequests(size_t thread);
+                void _handleTextLinesRequests(size_t thread);
+                void _handleMeasureGlyphsRequests(size_t thread);
+                void _handleGlyphsRequests(size_t thread);
 
                 DJV_PRIVATE();
             };
@@ -211,4 +229,20 @@ namespace djv
     } // namespace AV
 } // namespace djv
 
+namespace std
+{
+    template<>
+    struct hash<djv::AV::Font::Info>
+    {
+        std::size_t operator() (const djv::AV::Font::Info&) const noexcept;
+    };
+
+    template<>
+    struct hash<djv::AV::Font::GlyphInfo>
+    {
+        std::size_t operator() (const djv::AV::Font::GlyphInfo&) const noexcept;
+    };
+
+} // namespace std
+
 #include <djvAV/FontSystemInline.h>
@@ -70,6 +70,11 @@ namespace djv
                 return _dpi;
             }
 
+            inline size_t Info::getHash() const
+            {
+                return _hash;
+            }
+
             inline bool Info::operator == (const Info & other) const
             {
                 return _hash == other._hash;
@@ -118,3 +123,19 @@ namespace djv
         } // namespace Font
     } // namespace AV
 } // namespace djv
+
+namespace std
+{
+    inline std::size_t hash<djv::AV::Font::Info>::operator() (const djv::AV::Font::Info& value) const noexcept
+    {
+        return value.getHash();
+    }
+
+    inline std::size_t hash<djv::AV::Font::GlyphInfo>::operator() (const djv::AV::Font::GlyphInfo& value) const noexcept
+    {
+        size_t hash = value.info.getHash();
+        djv::Core::Memory::hashCombine(hash, value.code);
+        return hash;
+    }
+
+} // namespace std
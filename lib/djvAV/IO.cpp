@@ -73,11 +73,14 @@ namespace djv
             void VideoQueue::setMax(size_t value)
             {
                 _max = value;
+                _changed(false);
             }
 
             void VideoQueue::addFrame(const VideoFrame& value)
             {
                 _queue.push(value);
+                _queue.back().times.enqueue = std::chrono::high_resolution_clock::now();
+                _changed(true);
             }
 
             VideoFrame VideoQueue::popFrame()
@@ -87,6 +90,7 @@ namespace djv
                 {
                     out = _queue.front();
                     _queue.pop();
+                    _changed(false);
                 }
                 return out;
             }
@@ -97,21 +101,39 @@ namespace djv
                 {
                     _queue.pop();
                 }
+                _changed(false);
             }
 
             void VideoQueue::setFinished(bool value)
             {
                 _finished = value;
+                _changed(value);
+            }
+
+            void VideoQueue::setCallback(const std::function<void(void)>& value)
+            {
+                _callback = value;
+            }
+
+            void VideoQueue::_changed(bool callback)
+            {
+                _cv.notify_all();
+                if (callback && _callback)
+                {
+                    _callback();
+                }
             }
 
             void AudioQueue::setMax(size_t value)
             {
                 _max = value;
+                _changed(false);
             }
 
             void AudioQueue::addFrame(const AudioFrame& value)
             {
                 _queue.push(value);
+                _changed(true);
             }
 
             AudioFrame AudioQueue::popFrame()
@@ -121,6 +143,7 @@ namespace djv
                 {
                     out = _queue.front();
                     _queue.pop();
+                    _changed(false);
                 }
                 return out;
             }
@@ -131,11 +154,27 @@ namespace djv
                 {
                     _queue.pop();
                 }
+                _changed(false);
             }
 
             void AudioQueue::setFinished(bool value)
             {
                 _finished = value;
+                _changed(value);
+            }
+
+            void AudioQueue::setCallback(const std::function<void(void)>& value)
+            {
+                _callback = value;
+            }
+
+            void AudioQueue::_changed(bool callback)
+            {
+                _cv.notify_all();
+                if (callback && _callback)
+                {
+                    _callback();
+                }
             }
 
             void IIO::_init(
@@ -162,37 +201,13 @@ namespace djv
 
             Frame::Sequence Cache::getFrames() const
             {
-                Frame::Sequence out;
                 std::vector<Frame::Index> frames;
+                frames.reserve(_cache.size());
                 for (const auto& i : _cache)
                 {
                     frames.push_back(i.first);
                 }
-                const size_t size = frames.size();
-                if (size)
-                {
-                    std::sort(frames.begin(), frames.end());
-                    Frame::Number rangeStart = frames[0];
-                    Frame::Number prevFrame = frames[0];
-                    size_t i = 1;
-                    for (; i < size; prevFrame = frames[i], ++i)
-                    {
-                        if (frames[i] != prevFrame + 1)
-                        {
-                            out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                            rangeStart = frames[i];
-                        }
-                    }
-                    if (size > 1)
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart, prevFrame));
-                    }
-                    else
-                    {
-                        out.ranges.push_back(Frame::Range(rangeStart));
-                    }
-                }
-                return out;
+                return Frame::fromFrames(frames);
             }
 
             void Cache::setMax(size_t value)
@@ -203,6 +218,14 @@ namespace djv
                 _cacheUpdate();
             }
 
+            void Cache::setReadBehind(size_t value)
+            {
+                if (value == _readBehind)
+                    return;
+                _readBehind = value;
+                _cacheUpdate();
+            }
+
             void Cache::setSequenceSize(size_t value)
             {
                 if (value == _sequenceSize)
@@ -266,7 +289,7 @@ namespace djv
             {
                 const auto range = _inOutPoints.getRange(_sequenceSize);
                 Frame::Index frame = _currentFrame;
-                _sequence = Frame::Sequence();
+                std::vector<Frame::Range> ranges;
                 switch (_direction)
                 {
                 case Direction::Forward:
@@ -279,7 +302,7 @@ namespace djv
                             frame = range.max;
                         }
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
+                    ranges.push_back(Frame::Range(frame));
                     const Frame::Index first = frame;
                     for (size_t i = 0; i < _max; ++i)
                     {
@@ -291,14 +314,14 @@ namespace djv
                         if (frame > range.max)
                         {
                             frame = range.min;
-                            if (frame != _sequence.ranges.back().max)
+                            if (frame != ranges.back().max)
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                ranges.push_back(Frame::Range(frame));
                             }
                         }
                         else
                         {
-                            _sequence.ranges.back().max = frame;
+                            ranges.back().max = frame;
                         }
                     }
                     break;
@@ -313,7 +336,7 @@ namespace djv
                             frame = range.min;
                         }
                     }
-                    _sequence.ranges.push_back(Frame::Range(frame));
+                    ranges.push_back(Frame::Range(frame));
                     const Frame::Index first = frame;
                     for (size_t i = 0; i < _max; ++i)
                     {
@@ -325,20 +348,21 @@ namespace djv
                         if (frame < range.min)
                         {
                             frame = range.max;
-                            if (frame != _sequence.ranges.back().max)
+                            if (frame != ranges.back().max)
                             {
-                                _sequence.ranges.push_back(Frame::Range(frame));
+                                ranges.push_back(Frame::Range(frame));
                             }
                         }
                         else
                         {
-                            _sequence.ranges.back().min = frame;
+                            ranges.back().min = frame;
                         }
                     }
                     break;
                 }
                 default: break;
                 }
+                _sequence.setRanges(ranges);
                 auto i = _cache.begin();
                 while (i != _cache.end())
                 {
@@ -366,14 +390,20 @@ namespace djv
 
             void IRead::setPlayback(bool value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _playback = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _playback = value;
+                }
+                _videoQueue.notify();
             }
             
             void IRead::setInOutPoints(const InOutPoints& value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _inOutPoints = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _inOutPoints = value;
+                }
+                _videoQueue.notify();
             }
             
             bool IRead::isCacheEnabled() const
@@ -406,14 +436,65 @@ namespace djv
 
             void IRead::setCacheEnabled(bool value)
             {
-                std::lock_guard<std::mutex> lock(_mutex);
-                _cacheEnabled = value;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _cacheEnabled = value;
+                }
+                _videoQueue.notify();
             }
 
             void IRead::setCacheMaxByteCount(size_t value)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _cacheMaxByteCount = value;
+                }
+                _videoQueue.notify();
+            }
+
+            ReadStats IRead::getStats()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _stats;
+            }
+
+            void IRead::resetStats()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stats = ReadStats();
+            }
+
+            void IRead::setStatsEnabled(bool value)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _statsEnabled = value;
+            }
+
+            bool IRead::isStatsEnabled()
             {
                 std::lock_guard<std::mutex> lock(_mutex);
-                _cacheMaxByteCount = value;
+                return _statsEnabled;
+            }
+
+            void IRead::setPrefetchAdaptive(bool value)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _prefetchAdaptive = value;
+                }
+                _videoQueue.notify();
+            }
+
+            bool IRead::isPrefetchAdaptive()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _prefetchAdaptive;
+            }
+
+            PrefetchDecision IRead::getPrefetchDecision()
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                return _prefetch.getDecision();
             }
 
             void IWrite::_init(
@@ -498,6 +579,7 @@ namespace djv
                 std::shared_ptr<ValueSubject<bool> > optionsChanged;
                 std::map<std::string, std::shared_ptr<IPlugin> > plugins;
                 std::set<std::string> sequenceExtensions;
+                std::shared_ptr<GLFW::System> glfwSystem;
             };
 
             void System::_init(const std::shared_ptr<Context>& context)
@@ -506,7 +588,6 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
-                addDependency(context->getSystemT<GLFW::System>());
                 addDependency(context->getSystemT<OCIO::System>());
 
                 p.optionsChanged = ValueSubject<bool>::create();
@@ -678,6 +759,18 @@ namespace djv
             std::shared_ptr<IWrite> System::write(const FileSystem::FileInfo& fileInfo, const Info & info, const WriteOptions& options)
             {
                 DJV_PRIVATE_PTR();
+
+                // The writers convert images with OpenGL, so GLFW is created
+                // the first time a file is written.
+                if (!p.glfwSystem)
+                {
+                    if (auto context = getContext().lock())
+                    {
+                        p.glfwSystem = context->getSystemT<GLFW::System>();
+                        addDependency(p.glfwSystem);
+                    }
+                }
+
                 std::shared_ptr<IWrite> out;
                 for (const auto & i : p.plugins)
                 {
@@ -31,6 +31,8 @@
 
 #include <djvAV/AudioData.h>
 #include <djvAV/Image.h>
+#include <djvAV/ImageResample.h>
+#include <djvAV/PrefetchController.h>
 #include <djvAV/Tags.h>
 
 #include <djvCore/Error.h>
@@ -41,6 +43,9 @@
 #include <djvCore/Time.h>
 #include <djvCore/ValueObserver.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <future>
 #include <queue>
 #include <mutex>
@@ -116,20 +121,44 @@ namespace djv
                 bool operator == (const Info &) const;
             };
 
+            //! This class provides the timestamps of a video frame as it moves
+            //! through the read pipeline. Timestamps that were not recorded are
+            //! left at the clock epoch.
+            class VideoFrameTimes
+            {
+            public:
+                VideoFrameTimes();
+
+                std::chrono::high_resolution_clock::time_point request;
+                std::chrono::high_resolution_clock::time_point decodeStart;
+                std::chrono::high_resolution_clock::time_point decodeEnd;
+                std::chrono::high_resolution_clock::time_point enqueue;
+
+                //! Whether the frame was taken from the cache instead of being
+                //! decoded.
+                bool cached = false;
+            };
+
             //! This class provides a video frame.
             class VideoFrame
             {
             public:
                 VideoFrame();
                 VideoFrame(Core::Frame::Number, const std::shared_ptr<Image::Image>&);
+                VideoFrame(Core::Frame::Number, const std::shared_ptr<Image::Image>&, const VideoFrameTimes&);
 
                 Core::Frame::Number           frame = 0;
                 std::shared_ptr<Image::Image> image;
+                VideoFrameTimes               times;
 
                 bool operator == (const VideoFrame&) const;
             };
 
             //! This class provides a queue of video frames.
+            //!
+            //! The queue is protected by the I/O mutex (IIO::getMutex()). Threads
+            //! waiting on the queue are woken whenever it changes, so consumers do
+            //! not need to poll.
             class VideoQueue
             {
                 DJV_NON_COPYABLE(VideoQueue);
@@ -143,6 +172,12 @@ namespace djv
                 bool isEmpty() const;
                 size_t getCount() const;
                 VideoFrame getFrame() const;
+
+                //! Get the most recently added frame.
+                VideoFrame getLastFrame() const;
+
+                //! Add a frame to the queue. The enqueue timestamp of the frame
+                //! is set to the current time.
                 void addFrame(const VideoFrame&);
                 VideoFrame popFrame();
                 void clearFrames();
@@ -150,10 +185,32 @@ namespace djv
                 bool isFinished() const;
                 void setFinished(bool);
 
+                //! \name Notifications
+                ///@{
+
+                //! Wait until the predicate is true or the timeout expires. The lock
+                //! must be held on the I/O mutex.
+                template<typename T>
+                bool wait(std::unique_lock<std::mutex>&, const std::chrono::milliseconds&, T predicate);
+
+                //! Wake the threads waiting on the queue.
+                void notify();
+
+                //! Set a function that is called when frames are added or the queue
+                //! is finished. The function is called with the I/O mutex locked so
+                //! it should only signal another thread.
+                void setCallback(const std::function<void(void)>&);
+
+                ///@}
+
             private:
+                void _changed(bool callback);
+
                 size_t _max = 0;
                 std::queue<VideoFrame> _queue;
                 bool _finished = false;
+                std::condition_variable _cv;
+                std::function<void(void)> _callback;
             };
 
             //! This class provides an audio frame.
@@ -169,6 +226,10 @@ namespace djv
             };
 
             //! This class provides a queue of audio frames.
+            //!
+            //! The queue is protected by the I/O mutex (IIO::getMutex()). Threads
+            //! waiting on the queue are woken whenever it changes, so consumers do
+            //! not need to poll.
             class AudioQueue
             {
                 DJV_NON_COPYABLE(AudioQueue);
@@ -189,11 +250,33 @@ namespace djv
                 bool isFinished() const;
                 void setFinished(bool);
 
+                //! \name Notifications
+                ///@{
+
+                //! Wait until the predicate is true or the timeout expires. The lock
+                //! must be held on the I/O mutex.
+                template<typename T>
+                bool wait(std::unique_lock<std::mutex>&, const std::chrono::milliseconds&, T predicate);
+
+                //! Wake the threads waiting on the queue.
+                void notify();
+
+                //! Set a function that is called when frames are added or the queue
+                //! is finished. The function is called with the I/O mutex locked so
+                //! it should only signal another thread.
+                void setCallback(const std::function<void(void)>&);
+
+                ///@}
+
             private:
+                void _changed(bool callback);
+
                 std::mutex _mutex;
                 size_t _max = 0;
                 std::queue<AudioFrame> _queue;
                 bool _finished = false;
+                std::condition_variable _cv;
+                std::function<void(void)> _callback;
             };
 
             //! This class provides I/O options.
@@ -241,7 +324,13 @@ namespace djv
             struct ReadOptions : IOOptions
             {
                 size_t layer = 0;
+
+                //! The color space of the files.
                 std::string colorSpace;
+
+                //! If this is set along with the file color space, sequence
+                //! readers convert the images to this color space on the CPU.
+                std::string outputColorSpace;
             };
 
             //! This class provides playback in/out points.
@@ -285,6 +374,7 @@ namespace djv
                 size_t getReadBehind() const;
                 const Core::Frame::Sequence& getSequence() const;
                 void setMax(size_t);
+                void setReadBehind(size_t);
                 void setSequenceSize(size_t);
                 void setInOutPoints(const InOutPoints&);
                 void setDirection(Direction);
@@ -303,12 +393,20 @@ namespace djv
                 InOutPoints _inOutPoints;
                 Direction _direction = Direction::Forward;
                 Core::Frame::Index _currentFrame = 0;
-                //! \todo Should this be configurable?
                 size_t _readBehind = 10;
                 Core::Frame::Sequence _sequence;
                 std::map<Core::Frame::Index, std::shared_ptr<AV::Image::Image> > _cache;
             };
 
+            //! This struct provides read statistics.
+            struct ReadStats
+            {
+                size_t   readCount      = 0; //!< The number of frames read from disk.
+                uint64_t readByteCount  = 0; //!< The number of file bytes read from disk, when enabled.
+                size_t   cacheHitCount  = 0; //!< The number of queued frames found in the cache.
+                size_t   cacheMissCount = 0; //!< The number of queued frames not found in the cache.
+            };
+
             //! This class provides an interface for reading.
             class IRead : public IIO
             {
@@ -340,6 +438,35 @@ namespace djv
                 void setCacheEnabled(bool);
                 void setCacheMaxByteCount(size_t);
 
+                //! \name Statistics
+                ///@{
+
+                ReadStats getStats();
+                void resetStats();
+
+                //! Set whether the number of bytes read is collected. This is
+                //! off by default since it queries the file system for each
+                //! frame.
+                void setStatsEnabled(bool);
+                bool isStatsEnabled();
+
+                ///@}
+
+                //! \name Prefetch
+                ///@{
+
+                //! Set whether the number of concurrent reads, the video queue
+                //! size, and the cache read behind are adjusted at runtime by
+                //! an adaptive prefetch controller. The thread count and video
+                //! queue size options become the upper limits.
+                void setPrefetchAdaptive(bool);
+                bool isPrefetchAdaptive();
+
+                //! Get the current decision of the prefetch controller.
+                PrefetchDecision getPrefetchDecision();
+
+                ///@}
+
             protected:
                 ReadOptions _options;
                 InOutPoints _inOutPoints;
@@ -351,12 +478,25 @@ namespace djv
                 Core::Frame::Sequence _cacheSequence;
                 Core::Frame::Sequence _cachedFrames;
                 Cache _cache;
+                ReadStats _stats;
+                bool _statsEnabled = false;
+                bool _prefetchAdaptive = false;
+                PrefetchController _prefetch;
             };
 
             //! This class provides options for writing.
             struct WriteOptions : IOOptions
             {
+                //! The color space of the files.
                 std::string colorSpace;
+
+                //! If this is set along with the file color space, sequence
+                //! writers convert the images from this color space on the CPU.
+                std::string inputColorSpace;
+
+                //! The filter used by sequence writers when the size of the
+                //! images does not match the size of the file.
+                Image::ResampleFilter resampleFilter = Image::ResampleFilter::Mitchell;
             };
 
             //! This class provides an interface for writing.
@@ -97,6 +97,9 @@ namespace djv
                     tags == other.tags;
             }
 
+            inline VideoFrameTimes::VideoFrameTimes()
+            {}
+
             inline VideoFrame::VideoFrame()
             {}
 
@@ -104,6 +107,12 @@ namespace djv
                 frame(frame),
                 image(image)
             {}
+
+            inline VideoFrame::VideoFrame(Core::Frame::Number frame, const std::shared_ptr<Image::Image>& image, const VideoFrameTimes& times) :
+                frame(frame),
+                image(image),
+                times(times)
+            {}
             
             inline bool VideoFrame::operator == (const VideoFrame& other) const
             {
@@ -133,11 +142,27 @@ namespace djv
                 return _queue.size() ? _queue.front() : VideoFrame();
             }
 
+            inline VideoFrame VideoQueue::getLastFrame() const
+            {
+                return _queue.size() ? _queue.back() : VideoFrame();
+            }
+
             inline bool VideoQueue::isFinished() const
             {
                 return _finished;
             }
 
+            template<typename T>
+            inline bool VideoQueue::wait(std::unique_lock<std::mutex>& lock, const std::chrono::milliseconds& timeout, T predicate)
+            {
+                return _cv.wait_for(lock, timeout, predicate);
+            }
+
+            inline void VideoQueue::notify()
+            {
+                _cv.notify_all();
+            }
+
             inline AudioFrame::AudioFrame()
             {}
 
@@ -178,6 +203,17 @@ namespace djv
                 return _queue.size() ? _queue.front() : AudioFrame();
             }
 
+            template<typename T>
+            inline bool AudioQueue::wait(std::unique_lock<std::mutex>& lock, const std::chrono::milliseconds& timeout, T predicate)
+            {
+                return _cv.wait_for(lock, timeout, predicate);
+            }
+
+            inline void AudioQueue::notify()
+            {
+                _cv.notify_all();
+            }
+
             inline size_t IIO::getThreadCount() const
             {
                 return _threadCount;
@@ -52,6 +52,9 @@ namespace djv
         {
             struct Convert::Private
             {
+                bool resampleEnabled = false;
+                ResampleFilter resampleFilter = ResampleFilter::Mitchell;
+                size_t resampleThreadCount = 1;
                 Size size;
                 Mirror mirror;
                 std::shared_ptr<OpenGL::OffscreenBuffer> offscreenBuffer;
@@ -85,9 +88,32 @@ namespace djv
                 return out;
             }
 
+            void Convert::setResampleEnabled(bool value)
+            {
+                _p->resampleEnabled = value;
+            }
+
+            void Convert::setResampleFilter(ResampleFilter value)
+            {
+                _p->resampleFilter = value;
+            }
+
+            void Convert::setResampleThreadCount(size_t value)
+            {
+                _p->resampleThreadCount = value;
+            }
+
             void Convert::process(const Data& data, const Info& info, Data& out)
             {
                 DJV_PRIVATE_PTR();
+                if (p.resampleEnabled && data.getSize() != info.size)
+                {
+                    // The resampling also converts the type and layout, so the
+                    // OpenGL path is not needed.
+                    resample(data, out, p.resampleFilter, p.resampleThreadCount);
+                    return;
+                }
+
                 if (!p.offscreenBuffer || (p.offscreenBuffer && info != p.offscreenBuffer->getInfo()))
                 {
                     p.offscreenBuffer = OpenGL::OffscreenBuffer::create(info);
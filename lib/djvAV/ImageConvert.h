@@ -30,6 +30,7 @@
 #pragma once
 
 #include <djvAV/ImageData.h>
+#include <djvAV/ImageResample.h>
 
 namespace djv
 {
@@ -61,6 +62,12 @@ namespace djv
                 //! - Render::ShaderError
                 static std::shared_ptr<Convert> create(const std::shared_ptr<Core::ResourceSystem>&);
 
+                //! Set whether images are resampled on the CPU when the size
+                //! changes, rather than with the OpenGL linear filter.
+                void setResampleEnabled(bool);
+                void setResampleFilter(ResampleFilter);
+                void setResampleThreadCount(size_t);
+
                 //! Note that this function requires an OpenGL context.
                 //! Throws:
                 //! - OpenGL::OffscreenBufferError
@@ -124,11 +124,11 @@ namespace djv
 #else
                     if (GL_UNSIGNED_INT_10_10_10_2 == _info.getGLType())
                     {
-                        for (uint16_t y = 0; y < _info.size.h; ++y)
+                        for (uint32_t y = 0; y < _info.size.h; ++y)
                         {
                             const U10_S * p = reinterpret_cast<const U10_S*>(getData(y));
                             const U10_S * otherP = reinterpret_cast<const U10_S*>(other.getData(y));
-                            for (uint16_t x = 0; x < _info.size.w; ++x, ++p, ++otherP)
+                            for (uint32_t x = 0; x < _info.size.w; ++x, ++p, ++otherP)
                             {
                                 if (*p != *otherP)
                                 {
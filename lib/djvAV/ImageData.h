@@ -85,10 +85,10 @@ namespace djv
             class Size
             {
             public:
-                Size(uint16_t w = 0, uint16_t h = 0);
+                Size(uint32_t w = 0, uint32_t h = 0);
 
-                uint16_t w = 0;
-                uint16_t h = 0;
+                uint32_t w = 0;
+                uint32_t h = 0;
                 
                 float getAspectRatio() const;
 
@@ -105,7 +105,7 @@ namespace djv
             public:
                 Info();
                 Info(const Size&, Type, const Layout& = Layout());
-                Info(uint16_t width, uint16_t height, Type, const Layout& = Layout());
+                Info(uint32_t width, uint32_t height, Type, const Layout& = Layout());
 
                 std::string name;
                 Size size;
@@ -147,8 +147,8 @@ namespace djv
 
                 const Info& getInfo() const;
                 const Size& getSize() const;
-                uint16_t getWidth() const;
-                uint16_t getHeight() const;
+                uint32_t getWidth() const;
+                uint32_t getHeight() const;
                 float getAspectRatio() const;
 
                 Type getType() const;
@@ -162,11 +162,11 @@ namespace djv
                 size_t getDataByteCount() const;
 
                 const uint8_t* getData() const;
-                const uint8_t* getData(uint16_t y) const;
-                const uint8_t* getData(uint16_t x, uint16_t y) const;
+                const uint8_t* getData(uint32_t y) const;
+                const uint8_t* getData(uint32_t x, uint32_t y) const;
                 uint8_t* getData();
-                uint8_t* getData(uint16_t y);
-                uint8_t* getData(uint16_t x, uint16_t y);
+                uint8_t* getData(uint32_t y);
+                uint8_t* getData(uint32_t x, uint32_t y);
 
                 void zero();
 
@@ -70,7 +70,7 @@ namespace djv
                 return !(other == *this);
             }
 
-            inline Size::Size(uint16_t w, uint16_t h) :
+            inline Size::Size(uint32_t w, uint32_t h) :
                 w(w),
                 h(h)
             {}
@@ -101,7 +101,7 @@ namespace djv
                 layout(layout)
             {}
 
-            inline Info::Info(uint16_t width, uint16_t height, Type type, const Layout& layout) :
+            inline Info::Info(uint32_t width, uint32_t height, Type type, const Layout& layout) :
                 name(DJV_TEXT(nameDefault)),
                 size(width, height),
                 type(type),
@@ -183,12 +183,12 @@ namespace djv
                 return _info.size;
             }
 
-            inline uint16_t Data::getWidth() const
+            inline uint32_t Data::getWidth() const
             {
                 return _info.size.w;
             }
 
-            inline uint16_t Data::getHeight() const
+            inline uint32_t Data::getHeight() const
             {
                 return _info.size.h;
             }
@@ -233,12 +233,12 @@ namespace djv
                 return _p;
             }
 
-            inline const uint8_t* Data::getData(uint16_t y) const
+            inline const uint8_t* Data::getData(uint32_t y) const
             {
                 return _p + y * _scanlineByteCount;
             }
 
-            inline const uint8_t* Data::getData(uint16_t x, uint16_t y) const
+            inline const uint8_t* Data::getData(uint32_t x, uint32_t y) const
             {
                 return _p + y * _scanlineByteCount + x * static_cast<size_t>(_pixelByteCount);
             }
@@ -251,7 +251,7 @@ namespace djv
                 return _data;
             }
 
-            inline uint8_t* Data::getData(uint16_t y)
+            inline uint8_t* Data::getData(uint32_t y)
             {
 #if defined(DJV_MMAP)
                 detach();
@@ -259,7 +259,7 @@ namespace djv
                 return _data + y * _scanlineByteCount;
             }
 
-            inline uint8_t* Data::getData(uint16_t x, uint16_t y)
+            inline uint8_t* Data::getData(uint32_t x, uint32_t y)
             {
 #if defined(DJV_MMAP)
                 detach();
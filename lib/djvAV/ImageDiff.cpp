@@ -0,0 +1,355 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImageDiff.h>
+
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_IMAGE_DIFF_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t blockScanlines = 64;
+
+                size_t getWordSize(Type type)
+                {
+                    return Type::RGB_U10 == type ? 4 : getByteCount(getDataType(type));
+                }
+
+                //! Convert a scanline in its displayed orientation to RGBA 32-bit
+                //! floating point.
+                void readRow(const Data& data, uint32_t y, std::vector<uint8_t>& tmp, float* out)
+                {
+                    const Info& info = data.getInfo();
+                    const uint8_t* p = data.getData(info.layout.mirror.y ? (info.size.h - 1 - y) : y);
+                    const size_t wordSize = getWordSize(info.type);
+                    if (info.layout.endian != Memory::getEndian() && wordSize > 1)
+                    {
+                        const size_t byteCount = info.size.w * info.getPixelByteCount();
+                        tmp.resize(byteCount);
+                        Memory::endian(p, tmp.data(), byteCount / wordSize, wordSize);
+                        p = tmp.data();
+                    }
+                    convert(p, info.type, out, Type::RGBA_F32, info.size.w);
+                    if (info.layout.mirror.x)
+                    {
+                        for (size_t i = 0; i < info.size.w / 2; ++i)
+                        {
+                            std::swap_ranges(out + i * 4, out + (i + 1) * 4, out + (info.size.w - 1 - i) * 4);
+                        }
+                    }
+                }
+
+                double mseToPSNR(double mse)
+                {
+                    return mse > 0.0 ? (-10.0 * std::log10(mse)) : std::numeric_limits<double>::infinity();
+                }
+
+                //! The statistics of a scanline are accumulated in single
+                //! precision and then added to the double precision totals.
+                struct RowStats
+                {
+                    float maxError[4] = { 0.F, 0.F, 0.F, 0.F };
+                    float squaredError[4] = { 0.F, 0.F, 0.F, 0.F };
+                };
+
+#if defined(DJV_IMAGE_DIFF_SSE2)
+                //! The RGBA pixels map directly to the SSE2 registers, and each
+                //! lane accumulates the statistics in the same order as the
+                //! scalar code.
+                void differenceRow(
+                    const float* a,
+                    const float* b,
+                    float* out,
+                    size_t size,
+                    DifferenceMode mode,
+                    RowStats& stats)
+                {
+                    const __m128 signMask = _mm_set1_ps(-0.F);
+                    const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+                    const __m128 alpha = _mm_set_ps(1.F, 0.F, 0.F, 0.F);
+                    const __m128 zero = _mm_setzero_ps();
+                    __m128 maxError = _mm_loadu_ps(stats.maxError);
+                    __m128 squaredError = _mm_loadu_ps(stats.squaredError);
+                    for (size_t i = 0; i < size; ++i, a += 4, b += 4)
+                    {
+                        const __m128 aV = _mm_loadu_ps(a);
+                        const __m128 bV = _mm_loadu_ps(b);
+                        const __m128 d = _mm_andnot_ps(signMask, _mm_sub_ps(aV, bV));
+                        maxError = _mm_max_ps(d, maxError);
+                        squaredError = _mm_add_ps(squaredError, _mm_mul_ps(d, d));
+                        if (out)
+                        {
+                            __m128 v = d;
+                            if (DifferenceMode::Relative == mode)
+                            {
+                                const __m128 den = _mm_max_ps(
+                                    _mm_andnot_ps(signMask, aV),
+                                    _mm_andnot_ps(signMask, bV));
+                                v = _mm_and_ps(_mm_cmpgt_ps(den, zero), _mm_div_ps(d, den));
+                            }
+                            _mm_storeu_ps(out, _mm_or_ps(_mm_and_ps(v, rgbMask), alpha));
+                            out += 4;
+                        }
+                    }
+                    _mm_storeu_ps(stats.maxError, maxError);
+                    _mm_storeu_ps(stats.squaredError, squaredError);
+                }
+#else // DJV_IMAGE_DIFF_SSE2
+                void differenceRow(
+                    const float* a,
+                    const float* b,
+                    float* out,
+                    size_t size,
+                    DifferenceMode mode,
+                    RowStats& stats)
+                {
+                    for (size_t i = 0; i < size; ++i, a += 4, b += 4)
+                    {
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            const float d = std::abs(a[c] - b[c]);
+                            stats.maxError[c] = std::max(stats.maxError[c], d);
+                            stats.squaredError[c] += d * d;
+                            if (out && c < 3)
+                            {
+                                switch (mode)
+                                {
+                                case DifferenceMode::Relative:
+                                {
+                                    const float den = std::max(std::abs(a[c]), std::abs(b[c]));
+                                    out[c] = den > 0.F ? (d / den) : 0.F;
+                                    break;
+                                }
+                                default:
+                                    out[c] = d;
+                                    break;
+                                }
+                            }
+                        }
+                        if (out)
+                        {
+                            out[3] = 1.F;
+                            out += 4;
+                        }
+                    }
+                }
+#endif // DJV_IMAGE_DIFF_SSE2
+
+                void _difference(
+                    const Data& a,
+                    const Data& b,
+                    Data* out,
+                    const Size& size,
+                    DifferenceMode mode,
+                    DifferenceStats* stats,
+                    size_t threadCount)
+                {
+                    const Info& aInfo = a.getInfo();
+                    const Info& bInfo = b.getInfo();
+                    const size_t w = size.w;
+                    const size_t h = size.h;
+                    if (!w || !h || Type::None == aInfo.type || Type::None == bInfo.type)
+                        return;
+                    const Type outType = out ? out->getType() : Type::None;
+                    if (out && Type::None == outType)
+                        return;
+#if defined(DJV_MMAP)
+                    if (out)
+                    {
+                        out->detach();
+                    }
+#endif // DJV_MMAP
+
+                    const size_t aW = std::min(static_cast<size_t>(aInfo.size.w), w);
+                    const size_t aH = std::min(static_cast<size_t>(aInfo.size.h), h);
+                    const size_t bW = std::min(static_cast<size_t>(bInfo.size.w), w);
+                    const size_t bH = std::min(static_cast<size_t>(bInfo.size.h), h);
+                    auto processBlock = [&](size_t y0, size_t y1, DifferenceStats& blockStats)
+                    {
+                        std::vector<float> aRow(std::max(static_cast<size_t>(aInfo.size.w), w) * 4);
+                        std::vector<float> bRow(std::max(static_cast<size_t>(bInfo.size.w), w) * 4);
+                        std::vector<float> outRow(out ? w * 4 : 0);
+                        std::vector<uint8_t> tmp;
+                        for (size_t y = y0; y < y1; ++y)
+                        {
+                            // Pixels outside of an image are treated as zero.
+                            std::fill(aRow.begin() + (y < aH ? aW * 4 : 0), aRow.end(), 0.F);
+                            std::fill(bRow.begin() + (y < bH ? bW * 4 : 0), bRow.end(), 0.F);
+                            if (y < aH)
+                            {
+                                readRow(a, static_cast<uint32_t>(y), tmp, aRow.data());
+                            }
+                            if (y < bH)
+                            {
+                                readRow(b, static_cast<uint32_t>(y), tmp, bRow.data());
+                            }
+                            RowStats rowStats;
+                            differenceRow(aRow.data(), bRow.data(), out ? outRow.data() : nullptr, w, mode, rowStats);
+                            for (size_t c = 0; c < 4; ++c)
+                            {
+                                blockStats.maxError[c] = std::max(blockStats.maxError[c], rowStats.maxError[c]);
+                                blockStats.squaredError[c] += rowStats.squaredError[c];
+                            }
+                            blockStats.pixelCount += w;
+                            if (out)
+                            {
+                                convert(outRow.data(), Type::RGBA_F32, out->getData(static_cast<uint32_t>(y)), outType, w);
+                            }
+                        }
+                    };
+
+                    // Interleave the blocks across the threads. Each thread
+                    // accumulates its own statistics which are combined in
+                    // order at the end.
+                    const size_t blockCount = (h + blockScanlines - 1) / blockScanlines;
+                    const size_t count = std::max(std::min(threadCount, blockCount), static_cast<size_t>(1));
+                    std::vector<DifferenceStats> threadStats(count);
+                    auto processBlocks = [count, blockCount, h, &processBlock, &threadStats](size_t index)
+                    {
+                        for (size_t i = index; i < blockCount; i += count)
+                        {
+                            const size_t y0 = i * blockScanlines;
+                            processBlock(y0, std::min(y0 + blockScanlines, h), threadStats[index]);
+                        }
+                    };
+                    std::vector<std::future<void> > futures;
+                    for (size_t i = 1; i < count; ++i)
+                    {
+                        futures.push_back(std::async(std::launch::async, processBlocks, i));
+                    }
+                    processBlocks(0);
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                    if (stats)
+                    {
+                        for (const auto& i : threadStats)
+                        {
+                            stats->add(i);
+                        }
+                    }
+                }
+
+            } // namespace
+
+            DifferenceStats::DifferenceStats()
+            {}
+
+            float DifferenceStats::getMaxError() const
+            {
+                return std::max(std::max(maxError[0], maxError[1]), std::max(maxError[2], maxError[3]));
+            }
+
+            double DifferenceStats::getMSE(size_t channel) const
+            {
+                return pixelCount > 0 ? (squaredError[channel] / pixelCount) : 0.0;
+            }
+
+            double DifferenceStats::getMSE() const
+            {
+                return pixelCount > 0 ? ((squaredError[0] + squaredError[1] + squaredError[2]) / (pixelCount * 3)) : 0.0;
+            }
+
+            double DifferenceStats::getPSNR(size_t channel) const
+            {
+                return mseToPSNR(getMSE(channel));
+            }
+
+            double DifferenceStats::getPSNR() const
+            {
+                return mseToPSNR(getMSE());
+            }
+
+            void DifferenceStats::add(const DifferenceStats& value)
+            {
+                pixelCount += value.pixelCount;
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    maxError[c] = std::max(maxError[c], value.maxError[c]);
+                    squaredError[c] += value.squaredError[c];
+                }
+            }
+
+            Type getDifferenceType()
+            {
+                return Type::RGBA_F16;
+            }
+
+            void difference(const Data& a, const Data& b, Data& out, size_t threadCount)
+            {
+                _difference(a, b, &out, out.getSize(), DifferenceMode::Absolute, nullptr, threadCount);
+            }
+
+            void difference(
+                const Data& a,
+                const Data& b,
+                Data& out,
+                DifferenceMode mode,
+                DifferenceStats* stats,
+                size_t threadCount)
+            {
+                _difference(a, b, &out, out.getSize(), mode, stats, threadCount);
+            }
+
+            DifferenceStats getDifferenceStats(const Data& a, const Data& b, size_t threadCount)
+            {
+                DifferenceStats out;
+                _difference(a, b, nullptr, a.getSize(), DifferenceMode::Absolute, &out, threadCount);
+                return out;
+            }
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        DifferenceMode,
+        DJV_TEXT("Absolute"),
+        DJV_TEXT("Relative"));
+
+} // namespace djv
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This enumeration provides the difference modes.
+            enum class DifferenceMode
+            {
+                Absolute, //!< |a - b|
+                Relative, //!< |a - b| / max(|a|, |b|)
+
+                Count,
+                First = Absolute
+            };
+            DJV_ENUM_HELPERS(DifferenceMode);
+
+            //! This class provides the statistics of the difference between two
+            //! images. The channels are red, green, blue, and alpha, and the
+            //! errors are always absolute.
+            class DifferenceStats
+            {
+            public:
+                DifferenceStats();
+
+                size_t pixelCount = 0;
+                float  maxError[4] = { 0.F, 0.F, 0.F, 0.F };
+                double squaredError[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+                //! Get the maximum error of the red, green, blue, and alpha channels.
+                float getMaxError() const;
+
+                //! Get the mean squared error of a channel.
+                double getMSE(size_t channel) const;
+
+                //! Get the mean squared error of the red, green, and blue channels.
+                double getMSE() const;
+
+                //! Get the peak signal-to-noise ratio in decibels of a channel,
+                //! with a peak value of one. Identical images return infinity.
+                double getPSNR(size_t channel) const;
+
+                //! Get the peak signal-to-noise ratio in decibels of the red,
+                //! green, and blue channels.
+                double getPSNR() const;
+
+                //! Accumulate the statistics of another comparison.
+                void add(const DifferenceStats&);
+            };
+
+            //! Get the image type of the difference between two images.
+            Type getDifferenceType();
+
+            //! Compute the per-channel absolute difference between two images.
+            //! The images are compared as 32-bit floating point in their
+            //! displayed orientation, so they may have different types and
+            //! layouts. Where the images do not overlap the difference is
+            //! taken with zero.
+            //!
+            //! The output should have the size of the first image and the type
+            //! returned by getDifferenceType(). The alpha channel of the
+            //! output is set to one so the result can be displayed directly.
+            //!
+            //! The scanlines are distributed across the given number of threads.
+            void difference(
+                const Data& a,
+                const Data& b,
+                Data& out,
+                size_t threadCount = 1);
+
+            //! Compute the per-channel difference between two images and
+            //! optionally the statistics. The area that is compared is the
+            //! size of the output.
+            void difference(
+                const Data& a,
+                const Data& b,
+                Data& out,
+                DifferenceMode,
+                DifferenceStats*,
+                size_t threadCount = 1);
+
+            //! Compute the statistics of the difference between two images,
+            //! without an output image. The area that is compared is the size
+            //! of the first image.
+            DifferenceStats getDifferenceStats(
+                const Data& a,
+                const Data& b,
+                size_t threadCount = 1);
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::DifferenceMode);
+
+} // namespace djv
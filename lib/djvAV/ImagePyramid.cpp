@@ -0,0 +1,429 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImagePyramid.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <tuple>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t   threadCountMax            = 4;
+                const size_t   requestsMax               = 64;
+                const uint32_t sampleMax                 = 4;
+                const size_t   cacheMaxByteCountDefault  = 256 * Memory::megabyte;
+
+                typedef std::tuple<size_t, uint32_t, uint32_t> TileKey;
+
+            } // namespace
+
+            struct Pyramid::Private
+            {
+                std::shared_ptr<Image> image;
+                uint16_t tileSize = 0;
+                std::vector<Size> levelSizes;
+
+                mutable std::mutex mutex;
+                std::condition_variable requestCV;
+                std::list<TileKey> requests;
+                std::set<TileKey> pending;
+                typedef std::list<std::pair<TileKey, std::shared_ptr<Image> > > Cache;
+                Cache cache;
+                std::map<TileKey, Cache::iterator> cacheIndex;
+                size_t cacheByteCount = 0;
+                size_t cacheMaxByteCount = cacheMaxByteCountDefault;
+
+                std::vector<std::thread> threads;
+                std::atomic<bool> running;
+
+                void cacheUpdate();
+            };
+
+            void Pyramid::_init(const std::shared_ptr<Image>& image, uint16_t tileSize)
+            {
+                DJV_PRIVATE_PTR();
+                p.image = image;
+                p.tileSize = std::max(tileSize, static_cast<uint16_t>(1));
+
+                Size size = image->getSize();
+                p.levelSizes.push_back(size);
+                while (size.w > p.tileSize || size.h > p.tileSize)
+                {
+                    size.w = (size.w + 1) / 2;
+                    size.h = (size.h + 1) / 2;
+                    p.levelSizes.push_back(size);
+                }
+
+                const size_t threadCount = Math::clamp(
+                    static_cast<size_t>(std::thread::hardware_concurrency()),
+                    static_cast<size_t>(1),
+                    threadCountMax);
+                p.running = true;
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.threads.push_back(std::thread(
+                        [this]
+                        {
+                            DJV_PRIVATE_PTR();
+                            while (p.running)
+                            {
+                                TileKey key;
+                                {
+                                    std::unique_lock<std::mutex> lock(p.mutex);
+                                    p.requestCV.wait(
+                                        lock,
+                                        [this]
+                                        {
+                                            DJV_PRIVATE_PTR();
+                                            return p.requests.size() || !p.running;
+                                        });
+                                    if (!p.running)
+                                    {
+                                        break;
+                                    }
+                                    key = p.requests.front();
+                                    p.requests.pop_front();
+                                }
+
+                                std::shared_ptr<Image> tile;
+                                try
+                                {
+                                    tile = _build(std::get<0>(key), std::get<1>(key), std::get<2>(key));
+                                }
+                                catch (const std::exception&)
+                                {}
+
+                                std::unique_lock<std::mutex> lock(p.mutex);
+                                p.pending.erase(key);
+                                if (tile)
+                                {
+                                    p.cache.push_front(std::make_pair(key, tile));
+                                    p.cacheIndex[key] = p.cache.begin();
+                                    p.cacheByteCount += tile->getDataByteCount();
+                                    p.cacheUpdate();
+                                }
+                            }
+                        }));
+                }
+            }
+
+            Pyramid::Pyramid() :
+                _p(new Private)
+            {}
+
+            Pyramid::~Pyramid()
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    p.running = false;
+                }
+                p.requestCV.notify_all();
+                for (auto& i : p.threads)
+                {
+                    if (i.joinable())
+                    {
+                        i.join();
+                    }
+                }
+            }
+
+            std::shared_ptr<Pyramid> Pyramid::create(const std::shared_ptr<Image>& image, uint16_t tileSize)
+            {
+                auto out = std::shared_ptr<Pyramid>(new Pyramid);
+                out->_init(image, tileSize);
+                return out;
+            }
+
+            const std::shared_ptr<Image>& Pyramid::getImage() const
+            {
+                return _p->image;
+            }
+
+            uint16_t Pyramid::getTileSize() const
+            {
+                return _p->tileSize;
+            }
+
+            size_t Pyramid::getLevelCount() const
+            {
+                return _p->levelSizes.size();
+            }
+
+            Size Pyramid::getLevelSize(size_t level) const
+            {
+                DJV_PRIVATE_PTR();
+                return level < p.levelSizes.size() ? p.levelSizes[level] : Size();
+            }
+
+            Size Pyramid::getTileCount(size_t level) const
+            {
+                DJV_PRIVATE_PTR();
+                Size out;
+                if (level < p.levelSizes.size())
+                {
+                    const Size& size = p.levelSizes[level];
+                    out.w = size.w / p.tileSize + (size.w % p.tileSize ? 1 : 0);
+                    out.h = size.h / p.tileSize + (size.h % p.tileSize ? 1 : 0);
+                }
+                return out;
+            }
+
+            size_t Pyramid::getLevel(float scale) const
+            {
+                DJV_PRIVATE_PTR();
+                const size_t levelMax = p.levelSizes.size() - 1;
+                size_t out = levelMax;
+                if (scale > 0.F)
+                {
+                    const float level = std::floor(std::log2(1.F / scale));
+                    out = level > 0.F ? std::min(static_cast<size_t>(level), levelMax) : 0;
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image> Pyramid::getTile(size_t level, uint32_t x, uint32_t y, bool request)
+            {
+                DJV_PRIVATE_PTR();
+                std::shared_ptr<Image> out;
+                const Size tileCount = getTileCount(level);
+                if (x < tileCount.w && y < tileCount.h)
+                {
+                    const TileKey key(level, x, y);
+                    std::unique_lock<std::mutex> lock(p.mutex);
+                    const auto i = p.cacheIndex.find(key);
+                    if (i != p.cacheIndex.end())
+                    {
+                        p.cache.splice(p.cache.begin(), p.cache, i->second);
+                        out = i->second->second;
+                    }
+                    else if (request)
+                    {
+                        if (p.pending.find(key) == p.pending.end())
+                        {
+                            // The most recent requests are built first, and the
+                            // oldest requests are dropped.
+                            p.pending.insert(key);
+                            p.requests.push_front(key);
+                            while (p.requests.size() > requestsMax)
+                            {
+                                p.pending.erase(p.requests.back());
+                                p.requests.pop_back();
+                            }
+                            p.requestCV.notify_one();
+                        }
+                        else
+                        {
+                            const auto j = std::find(p.requests.begin(), p.requests.end(), key);
+                            if (j != p.requests.end())
+                            {
+                                p.requests.splice(p.requests.begin(), p.requests, j);
+                            }
+                        }
+                    }
+                }
+                return out;
+            }
+
+            size_t Pyramid::getPendingCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                return p.pending.size();
+            }
+
+            size_t Pyramid::getCacheMaxByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                return p.cacheMaxByteCount;
+            }
+
+            size_t Pyramid::getCacheByteCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                return p.cacheByteCount;
+            }
+
+            size_t Pyramid::getCacheCount() const
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                return p.cache.size();
+            }
+
+            void Pyramid::setCacheMaxByteCount(size_t value)
+            {
+                DJV_PRIVATE_PTR();
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.cacheMaxByteCount = value;
+                p.cacheUpdate();
+            }
+
+            std::shared_ptr<Image> Pyramid::_build(size_t level, uint32_t x, uint32_t y) const
+            {
+                DJV_PRIVATE_PTR();
+                const Image& in = *p.image;
+                const Info& inInfo = in.getInfo();
+                const size_t pixelByteCount = in.getPixelByteCount();
+                const Size& levelSize = p.levelSizes[level];
+                const uint32_t x0 = x * static_cast<uint32_t>(p.tileSize);
+                const uint32_t y0 = y * static_cast<uint32_t>(p.tileSize);
+                const Size size(
+                    std::min(static_cast<uint32_t>(p.tileSize), levelSize.w - x0),
+                    std::min(static_cast<uint32_t>(p.tileSize), levelSize.h - y0));
+                std::shared_ptr<Image> out;
+                if (0 == level)
+                {
+                    out = Image::create(Info(size, inInfo.type, Layout(Mirror(), inInfo.layout.alignment, inInfo.layout.endian)));
+                    const size_t byteCount = size.w * pixelByteCount;
+                    for (uint32_t j = 0; j < size.h; ++j)
+                    {
+                        memcpy(out->getData(j), in.getData(x0, y0 + j), byteCount);
+                    }
+                }
+                else
+                {
+                    // Each pixel is the average of a box of source pixels. The
+                    // number of samples in the box is limited so that the time to
+                    // build a tile does not depend on the level.
+                    out = Image::create(Info(size, inInfo.type));
+                    const uint8_t channelCount = getChannelCount(inInfo.type);
+                    const Type floatType = getFloatType(channelCount, 32);
+                    const DataType dataType = getDataType(inInfo.type);
+                    const size_t wordSize = DataType::U10 == dataType ? 4 : getByteCount(dataType);
+                    const bool swap = inInfo.layout.endian != Memory::getEndian() && wordSize > 1;
+                    const uint64_t block = static_cast<uint64_t>(1) << level;
+                    const uint64_t step = std::max(block / sampleMax, static_cast<uint64_t>(1));
+                    const uint64_t samples = block / step;
+                    const float weight = 1.F / static_cast<float>(samples * samples);
+                    const uint64_t inW = inInfo.size.w;
+                    const uint64_t inH = inInfo.size.h;
+                    const uint64_t spanX0 = x0 * block;
+                    const uint64_t spanX1 = std::min(spanX0 + size.w * block, inW);
+                    std::vector<float> row(size.w * channelCount);
+                    std::vector<float> span(1 == step ? (spanX1 - spanX0) * channelCount : channelCount);
+                    std::vector<uint8_t> tmp(1 == step ? (spanX1 - spanX0) * pixelByteCount : pixelByteCount);
+                    for (uint32_t j = 0; j < size.h; ++j)
+                    {
+                        std::fill(row.begin(), row.end(), 0.F);
+                        for (uint64_t sy = 0; sy < samples; ++sy)
+                        {
+                            const uint64_t inY = std::min((y0 + j) * block + sy * step, inH - 1);
+                            const uint8_t* inP = in.getData(static_cast<uint32_t>(inY));
+                            if (1 == step)
+                            {
+                                const uint8_t* spanP = inP + spanX0 * pixelByteCount;
+                                if (swap)
+                                {
+                                    Memory::endian(spanP, tmp.data(), tmp.size() / wordSize, wordSize);
+                                    spanP = tmp.data();
+                                }
+                                convert(spanP, inInfo.type, span.data(), floatType, spanX1 - spanX0);
+                                float* rowP = row.data();
+                                for (uint32_t i = 0; i < size.w; ++i, rowP += channelCount)
+                                {
+                                    for (uint64_t sx = 0; sx < samples; ++sx)
+                                    {
+                                        const uint64_t spanX = std::min(i * block + sx, spanX1 - spanX0 - 1);
+                                        const float* sampleP = span.data() + spanX * channelCount;
+                                        for (uint8_t c = 0; c < channelCount; ++c)
+                                        {
+                                            rowP[c] += sampleP[c];
+                                        }
+                                    }
+                                }
+                            }
+                            else
+                            {
+                                float* rowP = row.data();
+                                for (uint32_t i = 0; i < size.w; ++i, rowP += channelCount)
+                                {
+                                    for (uint64_t sx = 0; sx < samples; ++sx)
+                                    {
+                                        const uint64_t inX = std::min((x0 + i) * block + sx * step, inW - 1);
+                                        const uint8_t* pixelP = inP + inX * pixelByteCount;
+                                        if (swap)
+                                        {
+                                            Memory::endian(pixelP, tmp.data(), pixelByteCount / wordSize, wordSize);
+                                            pixelP = tmp.data();
+                                        }
+                                        convert(pixelP, inInfo.type, span.data(), floatType, 1);
+                                        for (uint8_t c = 0; c < channelCount; ++c)
+                                        {
+                                            rowP[c] += span[c];
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                        for (auto& i : row)
+                        {
+                            i *= weight;
+                        }
+                        convert(row.data(), floatType, out->getData(j), inInfo.type, size.w);
+                    }
+                }
+                return out;
+            }
+
+            void Pyramid::Private::cacheUpdate()
+            {
+                while (cacheByteCount > cacheMaxByteCount && cache.size() > 1)
+                {
+                    cacheByteCount -= cache.back().second->getDataByteCount();
+                    cacheIndex.erase(cache.back().first);
+                    cache.pop_back();
+                }
+            }
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/Image.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This constant provides the default pyramid tile size.
+            const uint16_t pyramidTileSizeDefault = 512;
+
+            //! This class provides a tiled image pyramid, which is used to draw
+            //! images that are too large for a single texture. Each level of the
+            //! pyramid is half the size of the previous level, and is divided into
+            //! tiles that are built lazily on worker threads. The built tiles are
+            //! kept in a least recently used cache.
+            //!
+            //! The tiles keep the type of the source image and are stored without
+            //! mirroring.
+            class Pyramid
+            {
+                DJV_NON_COPYABLE(Pyramid);
+
+            protected:
+                void _init(const std::shared_ptr<Image>&, uint16_t tileSize);
+                Pyramid();
+
+            public:
+                ~Pyramid();
+
+                static std::shared_ptr<Pyramid> create(
+                    const std::shared_ptr<Image>&,
+                    uint16_t tileSize = pyramidTileSizeDefault);
+
+                const std::shared_ptr<Image>& getImage() const;
+                uint16_t getTileSize() const;
+
+                //! \name Levels
+                ///@{
+
+                size_t getLevelCount() const;
+                Size getLevelSize(size_t level) const;
+
+                //! Get the number of tiles in the given level.
+                Size getTileCount(size_t level) const;
+
+                //! Get the level to use for drawing the image at the given scale.
+                size_t getLevel(float scale) const;
+
+                ///@}
+
+                //! \name Tiles
+                ///@{
+
+                //! Get a tile. If the tile has not been built yet a null pointer is
+                //! returned, and if the request flag is set the tile is queued to
+                //! be built.
+                std::shared_ptr<Image> getTile(size_t level, uint32_t x, uint32_t y, bool request = true);
+
+                //! Get the number of tiles that are queued or being built.
+                size_t getPendingCount() const;
+
+                ///@}
+
+                //! \name Cache
+                ///@{
+
+                size_t getCacheMaxByteCount() const;
+                size_t getCacheByteCount() const;
+                size_t getCacheCount() const;
+
+                void setCacheMaxByteCount(size_t);
+
+                ///@}
+
+            private:
+                std::shared_ptr<Image> _build(size_t level, uint32_t x, uint32_t y) const;
+
+                DJV_PRIVATE();
+            };
+
+        } // namespace Image
+    } // namespace AV
+} // namespace djv
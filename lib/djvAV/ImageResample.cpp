@@ -0,0 +1,416 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/ImageResample.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_RESAMPLE_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            namespace
+            {
+                //! \todo Should this be configurable?
+                const size_t blockScanlines = 64;
+
+                size_t getWordSize(Type type)
+                {
+                    return Type::RGB_U10 == type ? 4 : getByteCount(getDataType(type));
+                }
+
+                //! Get the offset that makes the conversion of floating point values
+                //! to the given integer data type round rather than truncate.
+                float getRoundingOffset(DataType value)
+                {
+                    float out = 0.F;
+                    switch (value)
+                    {
+                    case DataType::U8:  out = .5F / static_cast<float>(U8Range.max); break;
+                    case DataType::U10: out = .5F / static_cast<float>(U10Range.max); break;
+                    case DataType::U16: out = .5F / static_cast<float>(U16Range.max); break;
+                    case DataType::U32: out = .5F / static_cast<float>(U32Range.max); break;
+                    default: break;
+                    }
+                    return out;
+                }
+
+                float sinc(float value)
+                {
+                    float out = 1.F;
+                    if (value != 0.F)
+                    {
+                        const float x = value * Math::pi;
+                        out = sinf(x) / x;
+                    }
+                    return out;
+                }
+
+                //! This struct provides the filter weights for one axis of the
+                //! image. Every output pixel has the same number of taps, which
+                //! start at the given input pixel.
+                struct Contributions
+                {
+                    size_t              taps = 0;
+                    std::vector<size_t> start;
+                    std::vector<float>  weights;
+                };
+
+                Contributions getContributions(size_t inSize, size_t outSize, ResampleFilter filter)
+                {
+                    Contributions out;
+                    const float scale = outSize / static_cast<float>(inSize);
+                    const float filterScale = std::max(1.F / scale, 1.F);
+                    const float radius = getResampleFilterRadius(filter) * filterScale;
+                    const size_t taps = static_cast<size_t>(ceilf(radius * 2.F)) + 1;
+                    out.taps = std::min(taps, inSize);
+                    out.start.resize(outSize);
+                    out.weights.resize(outSize * out.taps, 0.F);
+                    const int64_t inMax = static_cast<int64_t>(inSize) - 1;
+                    for (size_t i = 0; i < outSize; ++i)
+                    {
+                        // The taps that fall outside of the image are folded into
+                        // the edge pixels.
+                        const float center = (i + .5F) / scale;
+                        const int64_t left = static_cast<int64_t>(ceilf(center - radius - .5F));
+                        const int64_t start = Math::clamp(left, static_cast<int64_t>(0), static_cast<int64_t>(inSize - out.taps));
+                        out.start[i] = static_cast<size_t>(start);
+                        float* weightsP = out.weights.data() + i * out.taps;
+                        float sum = 0.F;
+                        for (size_t k = 0; k < taps; ++k)
+                        {
+                            const int64_t j = left + static_cast<int64_t>(k);
+                            const float weight = getResampleFilterWeight(filter, (j + .5F - center) / filterScale);
+                            weightsP[Math::clamp(j, static_cast<int64_t>(0), inMax) - start] += weight;
+                            sum += weight;
+                        }
+                        if (sum != 0.F)
+                        {
+                            for (size_t k = 0; k < out.taps; ++k)
+                            {
+                                weightsP[k] /= sum;
+                            }
+                        }
+                        else
+                        {
+                            const int64_t j = Math::clamp(static_cast<int64_t>(center), static_cast<int64_t>(0), inMax);
+                            weightsP[j - start] = 1.F;
+                        }
+                    }
+                    return out;
+                }
+
+                template<uint8_t channelCount>
+                void filterRowT(
+                    const float*         in,
+                    const Contributions& contributions,
+                    size_t               size,
+                    float*               out)
+                {
+                    const size_t taps = contributions.taps;
+                    const float* weightsP = contributions.weights.data();
+                    for (size_t i = 0; i < size; ++i, weightsP += taps, out += channelCount)
+                    {
+                        const float* inP = in + contributions.start[i] * channelCount;
+                        float sum[channelCount];
+                        for (uint8_t c = 0; c < channelCount; ++c)
+                        {
+                            sum[c] = 0.F;
+                        }
+                        for (size_t k = 0; k < taps; ++k, inP += channelCount)
+                        {
+                            const float weight = weightsP[k];
+                            for (uint8_t c = 0; c < channelCount; ++c)
+                            {
+                                sum[c] += inP[c] * weight;
+                            }
+                        }
+                        for (uint8_t c = 0; c < channelCount; ++c)
+                        {
+                            out[c] = sum[c];
+                        }
+                    }
+                }
+
+#if defined(DJV_RESAMPLE_SSE2)
+                template<>
+                void filterRowT<4>(
+                    const float*         in,
+                    const Contributions& contributions,
+                    size_t               size,
+                    float*               out)
+                {
+                    const size_t taps = contributions.taps;
+                    const float* weightsP = contributions.weights.data();
+                    for (size_t i = 0; i < size; ++i, weightsP += taps, out += 4)
+                    {
+                        const float* inP = in + contributions.start[i] * 4;
+                        __m128 sum = _mm_setzero_ps();
+                        for (size_t k = 0; k < taps; ++k, inP += 4)
+                        {
+                            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(inP), _mm_set1_ps(weightsP[k])));
+                        }
+                        _mm_storeu_ps(out, sum);
+                    }
+                }
+#endif // DJV_RESAMPLE_SSE2
+
+                void filterRow(
+                    const float*         in,
+                    const Contributions& contributions,
+                    uint8_t              channelCount,
+                    size_t               size,
+                    float*               out)
+                {
+                    switch (channelCount)
+                    {
+                    case 1: filterRowT<1>(in, contributions, size, out); break;
+                    case 2: filterRowT<2>(in, contributions, size, out); break;
+                    case 3: filterRowT<3>(in, contributions, size, out); break;
+                    case 4: filterRowT<4>(in, contributions, size, out); break;
+                    default: break;
+                    }
+                }
+
+                void accumulateRow(const float* in, float weight, size_t size, float* out)
+                {
+                    size_t i = 0;
+#if defined(DJV_RESAMPLE_SSE2)
+                    const __m128 weight4 = _mm_set1_ps(weight);
+                    for (; i + 4 <= size; i += 4)
+                    {
+                        _mm_storeu_ps(
+                            out + i,
+                            _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(in + i), weight4)));
+                    }
+#endif // DJV_RESAMPLE_SSE2
+                    for (; i < size; ++i)
+                    {
+                        out[i] += in[i] * weight;
+                    }
+                }
+
+            } // namespace
+
+            float getResampleFilterRadius(ResampleFilter value)
+            {
+                float out = 0.F;
+                switch (value)
+                {
+                case ResampleFilter::Box:      out = .5F; break;
+                case ResampleFilter::Triangle: out = 1.F; break;
+                case ResampleFilter::Mitchell: out = 2.F; break;
+                case ResampleFilter::Lanczos3: out = 3.F; break;
+                default: break;
+                }
+                return out;
+            }
+
+            float getResampleFilterWeight(ResampleFilter filter, float value)
+            {
+                float out = 0.F;
+                const float x = fabsf(value);
+                switch (filter)
+                {
+                case ResampleFilter::Box:
+                    out = value > -.5F && value <= .5F ? 1.F : 0.F;
+                    break;
+                case ResampleFilter::Triangle:
+                    out = x < 1.F ? (1.F - x) : 0.F;
+                    break;
+                case ResampleFilter::Mitchell:
+                {
+                    // Mitchell-Netravali with B = C = 1/3.
+                    const float b = 1.F / 3.F;
+                    const float c = 1.F / 3.F;
+                    const float x2 = x * x;
+                    const float x3 = x2 * x;
+                    if (x < 1.F)
+                    {
+                        out = ((12.F - 9.F * b - 6.F * c) * x3 + (-18.F + 12.F * b + 6.F * c) * x2 + (6.F - 2.F * b)) / 6.F;
+                    }
+                    else if (x < 2.F)
+                    {
+                        out = ((-b - 6.F * c) * x3 + (6.F * b + 30.F * c) * x2 + (-12.F * b - 48.F * c) * x + (8.F * b + 24.F * c)) / 6.F;
+                    }
+                    break;
+                }
+                case ResampleFilter::Lanczos3:
+                    out = x < 3.F ? (sinc(x) * sinc(x / 3.F)) : 0.F;
+                    break;
+                default: break;
+                }
+                return out;
+            }
+
+            void resample(const Data& in, Data& out, ResampleFilter filter, size_t threadCount)
+            {
+                const Info& inInfo = in.getInfo();
+                const Info& outInfo = out.getInfo();
+                const size_t inW = inInfo.size.w;
+                const size_t inH = inInfo.size.h;
+                const size_t outW = outInfo.size.w;
+                const size_t outH = outInfo.size.h;
+                if (!inW || !inH || !outW || !outH || Type::None == inInfo.type || Type::None == outInfo.type)
+                    return;
+#if defined(DJV_MMAP)
+                out.detach();
+#endif // DJV_MMAP
+
+                const uint8_t channelCount = getChannelCount(inInfo.type);
+                const Type floatType = getFloatType(channelCount, 32);
+                const size_t inWordSize = getWordSize(inInfo.type);
+                const size_t outWordSize = getWordSize(outInfo.type);
+                const bool inSwap = inInfo.layout.endian != Memory::getEndian() && inWordSize > 1;
+                const bool outSwap = outInfo.layout.endian != Memory::getEndian() && outWordSize > 1;
+                const size_t inRowByteCount = inW * inInfo.getPixelByteCount();
+                const size_t outRowByteCount = outW * outInfo.getPixelByteCount();
+                const float roundingOffset = getRoundingOffset(getDataType(outInfo.type));
+                const bool mirrorX = inInfo.layout.mirror.x != outInfo.layout.mirror.x;
+                const bool mirrorY = inInfo.layout.mirror.y != outInfo.layout.mirror.y;
+                const Contributions contributionsX = getContributions(inW, outW, filter);
+                const Contributions contributionsY = getContributions(inH, outH, filter);
+                const size_t rowSize = outW * channelCount;
+
+                auto processBlock = [&](size_t y0, size_t y1)
+                {
+                    // Filter the input scanlines that the block uses horizontally.
+                    const size_t inY0 = contributionsY.start[y0];
+                    const size_t inY1 = contributionsY.start[y1 - 1] + contributionsY.taps;
+                    std::vector<float> rows((inY1 - inY0) * rowSize);
+                    std::vector<float> inRow(inW * channelCount);
+                    std::vector<uint8_t> inTmp(inSwap ? inRowByteCount : 0);
+                    for (size_t j = inY0; j < inY1; ++j)
+                    {
+                        const uint8_t* inP = in.getData(static_cast<uint32_t>(j));
+                        if (inSwap)
+                        {
+                            Memory::endian(inP, inTmp.data(), inRowByteCount / inWordSize, inWordSize);
+                            inP = inTmp.data();
+                        }
+                        convert(inP, inInfo.type, inRow.data(), floatType, inW);
+                        filterRow(inRow.data(), contributionsX, channelCount, outW, rows.data() + (j - inY0) * rowSize);
+                    }
+
+                    // Filter the block vertically and convert it to the output type.
+                    std::vector<float> outRow(rowSize);
+                    std::vector<uint8_t> outTmp(outSwap ? outRowByteCount : 0);
+                    for (size_t j = y0; j < y1; ++j)
+                    {
+                        std::fill(outRow.begin(), outRow.end(), 0.F);
+                        const float* weightsP = contributionsY.weights.data() + j * contributionsY.taps;
+                        const float* rowP = rows.data() + (contributionsY.start[j] - inY0) * rowSize;
+                        for (size_t k = 0; k < contributionsY.taps; ++k, rowP += rowSize)
+                        {
+                            if (weightsP[k] != 0.F)
+                            {
+                                accumulateRow(rowP, weightsP[k], rowSize, outRow.data());
+                            }
+                        }
+                        if (roundingOffset > 0.F)
+                        {
+                            // The filters can overshoot, so the values are clamped
+                            // before they are converted to an integer type.
+                            for (auto& i : outRow)
+                            {
+                                i = Math::clamp(i, 0.F, 1.F) + roundingOffset;
+                            }
+                        }
+                        if (mirrorX)
+                        {
+                            for (size_t i = 0; i < outW / 2; ++i)
+                            {
+                                std::swap_ranges(
+                                    outRow.data() + i * channelCount,
+                                    outRow.data() + (i + 1) * channelCount,
+                                    outRow.data() + (outW - 1 - i) * channelCount);
+                            }
+                        }
+                        uint8_t* outP = out.getData(static_cast<uint32_t>(mirrorY ? (outH - 1 - j) : j));
+                        if (outSwap)
+                        {
+                            convert(outRow.data(), floatType, outTmp.data(), outInfo.type, outW);
+                            Memory::endian(outTmp.data(), outP, outRowByteCount / outWordSize, outWordSize);
+                        }
+                        else
+                        {
+                            convert(outRow.data(), floatType, outP, outInfo.type, outW);
+                        }
+                    }
+                };
+
+                // Interleave the blocks across the threads.
+                const size_t blockCount = (outH + blockScanlines - 1) / blockScanlines;
+                const size_t count = std::max(std::min(threadCount, blockCount), static_cast<size_t>(1));
+                auto processBlocks = [count, blockCount, outH, &processBlock](size_t index)
+                {
+                    for (size_t i = index; i < blockCount; i += count)
+                    {
+                        const size_t y0 = i * blockScanlines;
+                        processBlock(y0, std::min(y0 + blockScanlines, outH));
+                    }
+                };
+                std::vector<std::future<void> > futures;
+                for (size_t i = 1; i < count; ++i)
+                {
+                    futures.push_back(std::async(std::launch::async, processBlocks, i));
+                }
+                processBlocks(0);
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Image,
+        ResampleFilter,
+        DJV_TEXT("Box"),
+        DJV_TEXT("Triangle"),
+        DJV_TEXT("Mitchell"),
+        DJV_TEXT("Lanczos3"));
+
+} // namespace djv
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            //! This enumeration provides the resampling filters.
+            enum class ResampleFilter
+            {
+                Box,
+                Triangle,
+                Mitchell,
+                Lanczos3,
+
+                Count,
+                First = Box
+            };
+            DJV_ENUM_HELPERS(ResampleFilter);
+
+            //! Get the radius of a resampling filter in pixels.
+            float getResampleFilterRadius(ResampleFilter);
+
+            //! Evaluate a resampling filter.
+            float getResampleFilterWeight(ResampleFilter, float);
+
+            //! Resample image data to the size of the output image data with a
+            //! separable filter. The filter is widened when the image is reduced
+            //! so that every input pixel contributes to the result.
+            //!
+            //! The pixels are filtered as 32-bit floating point, so the F16 and
+            //! F32 types are not clamped or quantized until the result is
+            //! converted to the output type. The output may have a different
+            //! type and layout than the input.
+            //!
+            //! The output is divided into blocks of scanlines which are
+            //! distributed across the given number of threads.
+            void resample(
+                const Data& in,
+                Data& out,
+                ResampleFilter = ResampleFilter::Mitchell,
+                size_t threadCount = 1);
+
+        } // namespace Image
+    } // namespace AV
+
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Image::ResampleFilter);
+
+} // namespace djv
@@ -43,13 +43,13 @@ namespace djv
             namespace
             {
                 template<typename T, typename T2>
-                void getAverageColor(const uint8_t* data, uint16_t width, uint16_t height, uint8_t channels, uint8_t* out)
+                void getAverageColor(const uint8_t* data, uint32_t width, uint32_t height, uint8_t channels, uint8_t* out)
                 {
                     std::vector<T2> average(channels, T2(0));
                     const T* p = reinterpret_cast<const T*>(data);
-                    for (uint16_t y = 0; y < height; ++y)
+                    for (uint32_t y = 0; y < height; ++y)
                     {
-                        for (uint16_t x = 0; x < width; ++x)
+                        for (uint32_t x = 0; x < width; ++x)
                         {
                             for (uint8_t c = 0; c < channels; ++c)
                             {
@@ -60,17 +60,17 @@ namespace djv
                     T* outP = reinterpret_cast<T*>(out);
                     for (uint8_t c = 0; c < channels; ++c)
                     {
-                        outP[c] = average[c] / static_cast<float>(width * height);
+                        outP[c] = average[c] / (static_cast<float>(width) * height);
                     }
                 }
 
-                void getAverageColorU10(const uint8_t* data, uint16_t width, uint16_t height, uint8_t* out)
+                void getAverageColorU10(const uint8_t* data, uint32_t width, uint32_t height, uint8_t* out)
                 {
                     uint64_t average[3] = { 0, 0, 0 };
                     const U10_S_LSB* p = reinterpret_cast<const U10_S_LSB*>(data);
-                    for (uint16_t y = 0; y < height; ++y)
+                    for (uint32_t y = 0; y < height; ++y)
                     {
-                        for (uint16_t x = 0; x < width; ++x)
+                        for (uint32_t x = 0; x < width; ++x)
                         {
                             average[0] += p->r;
                             average[1] += p->g;
@@ -79,9 +79,9 @@ namespace djv
                         }
                     }
                     U10_S_LSB* outP = reinterpret_cast<U10_S_LSB*>(out);
-                    outP->r = average[0] / static_cast<float>(width * height);
-                    outP->g = average[1] / static_cast<float>(width * height);
-                    outP->b = average[2] / static_cast<float>(width * height);
+                    outP->r = average[0] / (static_cast<float>(width) * height);
+                    outP->g = average[1] / (static_cast<float>(width) * height);
+                    outP->b = average[2] / (static_cast<float>(width) * height);
                 }
 
             } // namespace
@@ -91,8 +91,8 @@ namespace djv
                 Color out;
                 if (data && data->isValid())
                 {
-                    const uint16_t w = data->getWidth();
-                    const uint16_t h = data->getHeight();
+                    const uint32_t w = data->getWidth();
+                    const uint32_t h = data->getHeight();
                     const AV::Image::Type type = data->getType();
                     const uint8_t c = getChannelCount(type);
                     const uint8_t* p = data->getData();
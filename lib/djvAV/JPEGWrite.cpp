@@ -234,8 +234,8 @@ namespace djv
                         throw FileSystem::Error(f.jpegError.msg);
                     }
 
-                    const uint16_t h = image->getHeight();
-                    for (uint16_t y = 0; y < h; ++y)
+                    const uint32_t h = image->getHeight();
+                    for (uint32_t y = 0; y < h; ++y)
                     {
                         if (!jpegScanline(&f.jpeg, image->getData(y), &f.jpegError))
                         {
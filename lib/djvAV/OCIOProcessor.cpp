@@ -0,0 +1,199 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/OCIOProcessor.h>
+
+#include <djvAV/ImageData.h>
+
+#include <djvCore/LRUCache.h>
+#include <djvCore/Memory.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include <future>
+#include <mutex>
+
+using namespace djv::Core;
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OCIO
+        {
+            namespace
+            {
+                //! \todo Should these be configurable?
+                const size_t cacheMax        = 16;
+                const size_t blockScanlines  = 64;
+
+                std::mutex cacheMutex;
+
+                Memory::LRUCache<std::string, std::shared_ptr<Processor> >& getCache()
+                {
+                    static Memory::LRUCache<std::string, std::shared_ptr<Processor> > cache;
+                    if (!cache.getMax())
+                    {
+                        cache.setMax(cacheMax);
+                    }
+                    return cache;
+                }
+
+                size_t getWordSize(Image::Type type)
+                {
+                    return Image::Type::RGB_U10 == type ? 4 : Image::getByteCount(Image::getDataType(type));
+                }
+
+            } // namespace
+
+            struct Processor::Private
+            {
+                Convert convert;
+                _OCIO::ConstProcessorRcPtr processor;
+            };
+
+            void Processor::_init(const Convert& convert)
+            {
+                DJV_PRIVATE_PTR();
+                p.convert = convert;
+                auto config = _OCIO::GetCurrentConfig();
+                p.processor = config->getProcessor(convert.input.c_str(), convert.output.c_str());
+            }
+
+            Processor::Processor() :
+                _p(new Private)
+            {}
+
+            Processor::~Processor()
+            {}
+
+            std::shared_ptr<Processor> Processor::create(const Convert& convert)
+            {
+                std::stringstream ss;
+                ss << _OCIO::GetCurrentConfig()->getCacheID() << '\n' << convert.input << '\n' << convert.output;
+                const std::string key = ss.str();
+                std::lock_guard<std::mutex> lock(cacheMutex);
+                auto& cache = getCache();
+                std::shared_ptr<Processor> out;
+                if (!cache.get(key, out))
+                {
+                    out = std::shared_ptr<Processor>(new Processor);
+                    out->_init(convert);
+                    cache.add(key, out);
+                }
+                return out;
+            }
+
+            const Convert& Processor::getConvert() const
+            {
+                return _p->convert;
+            }
+
+            bool Processor::isNoOp() const
+            {
+                return _p->processor->isNoOp();
+            }
+
+            void Processor::process(Image::Data& data, size_t threadCount) const
+            {
+                DJV_PRIVATE_PTR();
+                const Image::Info& info = data.getInfo();
+                const Image::Type type = info.type;
+                const size_t w = info.size.w;
+                const size_t h = info.size.h;
+                if (!w || !h || Image::Type::None == type || p.processor->isNoOp())
+                    return;
+#if defined(DJV_MMAP)
+                data.detach();
+#endif // DJV_MMAP
+
+                // Each block of scanlines is converted to RGBA floating point,
+                // processed, and converted back to the image type.
+                const bool swap = info.layout.endian != Memory::getEndian();
+                const size_t wordSize = getWordSize(type);
+                const size_t wordCount = w * data.getPixelByteCount() / wordSize;
+                const auto processor = p.processor;
+                auto processBlock = [&data, type, w, swap, wordSize, wordCount, processor](size_t y0, size_t y1)
+                {
+                    std::vector<float> buf(w * (y1 - y0) * 4);
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        uint8_t* row = data.getData(static_cast<uint32_t>(y));
+                        if (swap)
+                        {
+                            Memory::endian(row, wordCount, wordSize);
+                        }
+                        Image::convert(row, type, buf.data() + (y - y0) * w * 4, Image::Type::RGBA_F32, w);
+                    }
+                    _OCIO::PackedImageDesc imageDesc(buf.data(), static_cast<long>(w), static_cast<long>(y1 - y0), 4);
+                    processor->apply(imageDesc);
+                    for (size_t y = y0; y < y1; ++y)
+                    {
+                        uint8_t* row = data.getData(static_cast<uint32_t>(y));
+                        Image::convert(buf.data() + (y - y0) * w * 4, Image::Type::RGBA_F32, row, type, w);
+                        if (swap)
+                        {
+                            Memory::endian(row, wordCount, wordSize);
+                        }
+                    }
+                };
+
+                // Interleave the blocks across the threads.
+                const size_t blockCount = (h + blockScanlines - 1) / blockScanlines;
+                const size_t count = std::max(std::min(threadCount, blockCount), static_cast<size_t>(1));
+                auto processBlocks = [count, blockCount, h, processBlock](size_t index)
+                {
+                    for (size_t i = index; i < blockCount; i += count)
+                    {
+                        const size_t y0 = i * blockScanlines;
+                        processBlock(y0, std::min(y0 + blockScanlines, h));
+                    }
+                };
+                std::vector<std::future<void> > futures;
+                for (size_t i = 1; i < count; ++i)
+                {
+                    futures.push_back(std::async(std::launch::async, processBlocks, i));
+                }
+                processBlocks(0);
+                for (auto& i : futures)
+                {
+                    i.get();
+                }
+            }
+
+            void Processor::clearCache()
+            {
+                std::lock_guard<std::mutex> lock(cacheMutex);
+                getCache().clear();
+            }
+
+        } // namespace OCIO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,86 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/OCIO.h>
+
+#include <djvCore/Core.h>
+
+#include <memory>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Image
+        {
+            class Data;
+
+        } // namespace Image
+
+        namespace OCIO
+        {
+            //! This class provides color space conversion of images on the CPU.
+            //!
+            //! Images are converted in place with the OpenColorIO CPU processor,
+            //! in blocks of scanlines across multiple threads. Processors are
+            //! cached for each configuration and pair of color spaces.
+            class Processor
+            {
+                DJV_NON_COPYABLE(Processor);
+                void _init(const Convert&);
+                Processor();
+
+            public:
+                ~Processor();
+
+                //! Get a processor for the current configuration.
+                //! Throws:
+                //! - std::exception
+                static std::shared_ptr<Processor> create(const Convert&);
+
+                const Convert& getConvert() const;
+
+                //! Get whether the processor does not change the images.
+                bool isNoOp() const;
+
+                //! Convert an image in place.
+                void process(Image::Data&, size_t threadCount = 1) const;
+
+                //! Clear the processor cache.
+                static void clearCache();
+
+            private:
+                DJV_PRIVATE();
+            };
+
+        } // namespace OCIO
+    } // namespace AV
+} // namespace djv
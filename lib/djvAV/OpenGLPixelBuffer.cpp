@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/OpenGLPixelBuffer.h>
+
+#include <djvAV/OpenGLTexture.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OpenGL
+        {
+            void PixelBufferRing::_init(size_t count)
+            {
+#if !defined(DJV_OPENGL_ES2)
+                _buffers.resize(count);
+                for (auto& i : _buffers)
+                {
+                    glGenBuffers(1, &i.id);
+                }
+#endif // DJV_OPENGL_ES2
+            }
+
+            PixelBufferRing::~PixelBufferRing()
+            {
+#if !defined(DJV_OPENGL_ES2)
+                for (auto& i : _buffers)
+                {
+                    if (i.fence)
+                    {
+                        glDeleteSync(i.fence);
+                    }
+                    glDeleteBuffers(1, &i.id);
+                }
+#endif // DJV_OPENGL_ES2
+            }
+
+            std::shared_ptr<PixelBufferRing> PixelBufferRing::create(size_t count)
+            {
+                auto out = std::shared_ptr<PixelBufferRing>(new PixelBufferRing);
+                out->_init(count);
+                return out;
+            }
+
+            void PixelBufferRing::copy(const Image::Data& data, Texture& texture)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                const auto& info = data.getInfo();
+                const size_t byteCount = info.getDataByteCount();
+                bool uploaded = false;
+#if !defined(DJV_OPENGL_ES2)
+                if (_buffers.size())
+                {
+                    auto& buffer = _buffers[_index];
+                    _index = (_index + 1) % _buffers.size();
+
+                    // Check whether the previous transfer from this buffer has
+                    // finished, otherwise orphan the storage so the driver can
+                    // provide new memory without waiting.
+                    bool orphan = buffer.size < byteCount;
+                    if (buffer.fence)
+                    {
+                        if (GL_TIMEOUT_EXPIRED == glClientWaitSync(buffer.fence, 0, 0))
+                        {
+                            orphan = true;
+                            ++_orphanCount;
+                        }
+                        glDeleteSync(buffer.fence);
+                        buffer.fence = 0;
+                    }
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+                    if (orphan)
+                    {
+                        buffer.size = std::max(buffer.size, byteCount);
+                        glBufferData(GL_PIXEL_UNPACK_BUFFER, buffer.size, 0, GL_STREAM_DRAW);
+                    }
+                    if (void* p = glMapBufferRange(
+                        GL_PIXEL_UNPACK_BUFFER,
+                        0,
+                        byteCount,
+                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT))
+                    {
+                        memcpy(p, data.getData(), byteCount);
+                        if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+                        {
+                            texture.copyPixelBuffer(info);
+                            buffer.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                            uploaded = true;
+                            ++_uploadCount;
+                        }
+                    }
+                    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                }
+#endif // DJV_OPENGL_ES2
+                if (!uploaded)
+                {
+                    texture.copy(data);
+                    ++_fallbackCount;
+                }
+                _byteCount += byteCount;
+                const std::chrono::duration<float> delta = std::chrono::steady_clock::now() - start;
+                _uploadTime += delta.count();
+            }
+
+            void PixelBufferRing::resetStats()
+            {
+                _uploadCount = 0;
+                _orphanCount = 0;
+                _fallbackCount = 0;
+                _byteCount = 0;
+                _uploadTime = 0.F;
+            }
+
+        } // namespace OpenGL
+    } // namespace AV
+} // namespace djv
+
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/ImageData.h>
+#include <djvAV/OpenGL.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace OpenGL
+        {
+            class Texture;
+
+            //! This class provides a ring of OpenGL pixel buffer objects for
+            //! streaming image data to textures.
+            //!
+            //! Each upload is copied into the next pixel buffer in the ring and
+            //! transferred to the texture asynchronously, with a fence marking when
+            //! the pixel buffer can be written again. If the pixel buffer is still
+            //! in use its storage is orphaned instead of waiting, and if pixel
+            //! buffers are not available the data is copied directly from memory.
+            class PixelBufferRing
+            {
+                DJV_NON_COPYABLE(PixelBufferRing);
+                void _init(size_t count);
+                PixelBufferRing();
+
+            public:
+                ~PixelBufferRing();
+
+                static std::shared_ptr<PixelBufferRing> create(size_t count = 3);
+
+                size_t getCount() const;
+
+                //! Copy image data to a texture.
+                void copy(const Image::Data&, Texture&);
+
+                //! \name Statistics
+                ///@{
+
+                //! Get the number of uploads through the pixel buffers.
+                size_t getUploadCount() const;
+
+                //! Get the number of uploads that orphaned a pixel buffer because
+                //! it was still in use.
+                size_t getOrphanCount() const;
+
+                //! Get the number of uploads copied directly from memory.
+                size_t getFallbackCount() const;
+
+                //! Get the number of bytes uploaded.
+                uint64_t getByteCount() const;
+
+                //! Get the time spent uploading in seconds.
+                float getUploadTime() const;
+
+                void resetStats();
+
+                ///@}
+
+            private:
+                struct Buffer
+                {
+                    GLuint id = 0;
+                    size_t size = 0;
+#if !defined(DJV_OPENGL_ES2)
+                    GLsync fence = 0;
+#endif // DJV_OPENGL_ES2
+                };
+                std::vector<Buffer> _buffers;
+                size_t _index = 0;
+                size_t _uploadCount = 0;
+                size_t _orphanCount = 0;
+                size_t _fallbackCount = 0;
+                uint64_t _byteCount = 0;
+                float _uploadTime = 0.F;
+            };
+
+        } // namespace OpenGL
+    } // namespace AV
+} // namespace djv
+
+#include <djvAV/OpenGLPixelBufferInline.h>
@@ -27,52 +27,45 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 
-#pragma once
-
-#include <djvCore/Core.h>
-
-#include <map>
-#include <vector>
-
 namespace djv
 {
-    namespace Core
+    namespace AV
     {
-        namespace Memory
+        namespace OpenGL
         {
-            //! This class provides a cache.
-            //!
-            //! \todo Return an iterator from get() instead of a value.
-            template<typename T, typename U>
-            class Cache
-            {
-            public:
-                size_t getMax() const;
-                void setMax(size_t);
+            inline PixelBufferRing::PixelBufferRing()
+            {}
 
-                size_t getSize() const;
-                bool contains(const T & key) const;
-                bool get(const T & key, U &) const;
-                void add(const T & key, const U & value);
-                void remove(const T& key);
-                void clear();
+            inline size_t PixelBufferRing::getCount() const
+            {
+                return _buffers.size();
+            }
 
-                float getPercentageUsed() const;
+            inline size_t PixelBufferRing::getUploadCount() const
+            {
+                return _uploadCount;
+            }
 
-                std::vector<T> getKeys() const;
-                std::vector<U> getValues() const;
+            inline size_t PixelBufferRing::getOrphanCount() const
+            {
+                return _orphanCount;
+            }
 
-            private:
-                void _updateMax();
+            inline size_t PixelBufferRing::getFallbackCount() const
+            {
+                return _fallbackCount;
+            }
 
-                size_t _max = 10000;
-                std::map<T, U> _map;
-                mutable std::map<T, int64_t> _counts;
-                mutable int64_t _counter = 0;
-            };
+            inline uint64_t PixelBufferRing::getByteCount() const
+            {
+                return _byteCount;
+            }
 
-        } // namespace Memory
-    } // namespace Core
-} // namesapce djv
+            inline float PixelBufferRing::getUploadTime() const
+            {
+                return _uploadTime;
+            }
 
-#include <djvCore/CacheInline.h>
+        } // namespace OpenGL
+    } // namespace AV
+} // namespace djv
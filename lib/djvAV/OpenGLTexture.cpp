@@ -245,6 +245,27 @@ namespace djv
 #endif // DJV_OPENGL_ES2
             }
 
+#if !defined(DJV_OPENGL_ES2)
+            void Texture::copyPixelBuffer(const Image::Info& info)
+            {
+                glBindTexture(GL_TEXTURE_2D, _id);
+                glPixelStorei(GL_UNPACK_ALIGNMENT, info.layout.alignment);
+                glPixelStorei(GL_UNPACK_SWAP_BYTES, info.layout.endian != Memory::getEndian());
+                glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+                glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+                glTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    0,
+                    0,
+                    0,
+                    info.size.w,
+                    info.size.h,
+                    info.getGLFormat(),
+                    info.getGLType(),
+                    0);
+            }
+#endif // DJV_OPENGL_ES2
+
             void Texture::bind()
             {
                 glBindTexture(GL_TEXTURE_2D, _id);
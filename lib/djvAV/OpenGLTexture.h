@@ -62,6 +62,10 @@ namespace djv
                 void set(const Image::Info&);
                 void copy(const Image::Data&);
                 void copy(const Image::Data&, uint16_t x, uint16_t y);
+#if !defined(DJV_OPENGL_ES2)
+                //! Copy from the pixel unpack buffer that is currently bound.
+                void copyPixelBuffer(const Image::Info&);
+#endif // DJV_OPENGL_ES2
 
                 void bind();
 
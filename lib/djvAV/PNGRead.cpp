@@ -212,7 +212,7 @@ namespace djv
                     out = Image::Image::create(info.video[0].info);
 
                     out->setPluginName(pluginName);
-                    for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
+                    for (uint32_t y = 0; y < info.video[0].info.size.h; ++y)
                     {
                         if (!pngScanline(f.png, out->getData(y)))
                         {
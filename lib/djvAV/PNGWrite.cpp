@@ -246,7 +246,7 @@ namespace djv
                         png_set_swap(f.png);
                     }
 
-                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    for (uint32_t y = 0; y < info.size.h; ++y)
                     {
                         if (!pngScanline(f.png, image->getData(y)))
                         {
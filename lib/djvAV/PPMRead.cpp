@@ -83,7 +83,7 @@ namespace djv
                         out->setPluginName(pluginName);
                         const size_t channelCount = Image::getChannelCount(imageInfo.type);
                         const size_t bitDepth = Image::getBitDepth(imageInfo.type);
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        for (uint32_t y = 0; y < imageInfo.size.h; ++y)
                         {
                             readASCII(*io, out->getData(y), imageInfo.size.w * channelCount, bitDepth);
                         }
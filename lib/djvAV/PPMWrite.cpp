@@ -140,7 +140,7 @@ namespace djv
                     case Data::ASCII:
                     {
                         std::vector<uint8_t> scanline(info.getScanlineByteCount());
-                        for (uint16_t y = 0; y < info.size.h; ++y)
+                        for (uint32_t y = 0; y < info.size.h; ++y)
                         {
                             const size_t size = writeASCII(
                                 image->getData(y),
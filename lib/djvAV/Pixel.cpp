@@ -33,6 +33,11 @@
 #include <functional>
 #include <map>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_PIXEL_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
 #define CONVERT_L_L(A, B) \
     void convert_L_##A##_L_##B(const void * in, void * out, size_t size) \
     { \
@@ -325,7 +330,7 @@
     { \
         const U10_S * inP = reinterpret_cast<const U10_S *>(in); \
         B##_T * outP = reinterpret_cast<B##_T *>(out); \
-        for (size_t i = 0; i < size; ++i, ++inP, outP += 3) \
+        for (size_t i = 0; i < size; ++i, ++inP, outP += 4) \
         { \
             convert_U10_##B(inP->r, outP[0]); \
             convert_U10_##B(inP->g, outP[1]); \
@@ -519,35 +524,151 @@ namespace djv
                 CONVERT_RGBA(F16);
                 CONVERT_RGBA(F32);
 
+#if defined(DJV_PIXEL_SSE2)
+                // The 10-bit kernels below work on the native 32-bit word, which
+                // holds the components as (r << 22) | (g << 12) | (b << 2) for
+                // both U10_S_MSB and U10_S_LSB. The results match the scalar
+                // conversions exactly.
+                inline void unpackU10(const void * in, __m128 & r, __m128 & g, __m128 & b)
+                {
+                    const __m128i mask = _mm_set1_epi32(0x3ff);
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(U10Range.max));
+                    const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in));
+                    r = _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(w, 22)), scale);
+                    g = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(w, 12), mask)), scale);
+                    b = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(w, 2), mask)), scale);
+                }
+
+                inline void packU10(__m128 r, __m128 g, __m128 b, void * out)
+                {
+                    const __m128 zero = _mm_setzero_ps();
+                    const __m128 scale = _mm_set1_ps(static_cast<float>(U10Range.max));
+                    const __m128i ri = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(r, scale), zero), scale));
+                    const __m128i gi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(g, scale), zero), scale));
+                    const __m128i bi = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(b, scale), zero), scale));
+                    const __m128i w = _mm_or_si128(
+                        _mm_or_si128(_mm_slli_epi32(ri, 22), _mm_slli_epi32(gi, 12)),
+                        _mm_slli_epi32(bi, 2));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), w);
+                }
+
+                void convert_RGB_U10_RGB_F32_SSE2(const void * in, void * out, size_t size)
+                {
+                    const U10_S * inP = reinterpret_cast<const U10_S *>(in);
+                    F32_T * outP = reinterpret_cast<F32_T *>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4, inP += 4, outP += 12)
+                    {
+                        __m128 r, g, b;
+                        unpackU10(inP, r, g, b);
+                        __m128 a = _mm_setzero_ps();
+                        _MM_TRANSPOSE4_PS(r, g, b, a);
+                        __m128 tmp = _mm_shuffle_ps(g, r, _MM_SHUFFLE(2, 2, 0, 0));
+                        _mm_storeu_ps(outP, _mm_shuffle_ps(r, tmp, _MM_SHUFFLE(0, 2, 1, 0)));
+                        _mm_storeu_ps(outP + 4, _mm_shuffle_ps(g, b, _MM_SHUFFLE(1, 0, 2, 1)));
+                        tmp = _mm_shuffle_ps(b, a, _MM_SHUFFLE(0, 0, 2, 2));
+                        _mm_storeu_ps(outP + 8, _mm_shuffle_ps(tmp, a, _MM_SHUFFLE(2, 1, 2, 0)));
+                    }
+                    convert_RGB_U10_RGB_F32(inP, outP, size - i);
+                }
+
+                void convert_RGB_U10_RGBA_F32_SSE2(const void * in, void * out, size_t size)
+                {
+                    const U10_S * inP = reinterpret_cast<const U10_S *>(in);
+                    F32_T * outP = reinterpret_cast<F32_T *>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4, inP += 4, outP += 16)
+                    {
+                        __m128 r, g, b;
+                        unpackU10(inP, r, g, b);
+                        __m128 a = _mm_set1_ps(F32Range.max);
+                        _MM_TRANSPOSE4_PS(r, g, b, a);
+                        _mm_storeu_ps(outP, r);
+                        _mm_storeu_ps(outP + 4, g);
+                        _mm_storeu_ps(outP + 8, b);
+                        _mm_storeu_ps(outP + 12, a);
+                    }
+                    convert_RGB_U10_RGBA_F32(inP, outP, size - i);
+                }
+
+                void convert_RGB_F32_RGB_U10_SSE2(const void * in, void * out, size_t size)
+                {
+                    const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                    U10_S * outP = reinterpret_cast<U10_S *>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4, inP += 12, outP += 4)
+                    {
+                        const __m128 x = _mm_loadu_ps(inP);
+                        const __m128 y = _mm_loadu_ps(inP + 4);
+                        const __m128 z = _mm_loadu_ps(inP + 8);
+                        __m128 p0 = x;
+                        __m128 p1 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 0, 3, 3));
+                        p1 = _mm_shuffle_ps(p1, p1, _MM_SHUFFLE(3, 3, 2, 0));
+                        __m128 p2 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(0, 0, 3, 2));
+                        __m128 p3 = _mm_shuffle_ps(z, z, _MM_SHUFFLE(3, 3, 2, 1));
+                        _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+                        packU10(p0, p1, p2, outP);
+                    }
+                    convert_RGB_F32_RGB_U10(inP, outP, size - i);
+                }
+
+                void convert_RGBA_F32_RGB_U10_SSE2(const void * in, void * out, size_t size)
+                {
+                    const F32_T * inP = reinterpret_cast<const F32_T *>(in);
+                    U10_S * outP = reinterpret_cast<U10_S *>(out);
+                    size_t i = 0;
+                    for (; i + 4 <= size; i += 4, inP += 16, outP += 4)
+                    {
+                        __m128 p0 = _mm_loadu_ps(inP);
+                        __m128 p1 = _mm_loadu_ps(inP + 4);
+                        __m128 p2 = _mm_loadu_ps(inP + 8);
+                        __m128 p3 = _mm_loadu_ps(inP + 12);
+                        _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+                        packU10(p0, p1, p2, outP);
+                    }
+                    convert_RGBA_F32_RGB_U10(inP, outP, size - i);
+                }
+#endif // DJV_PIXEL_SSE2
+
             } // namespace
 
             void convert(const void * in, Type inType, void * out, Type outType, size_t size)
             {
                 typedef std::function<void(const void *, void *, size_t)> Function;
-                static const std::map<Type, std::map<Type, Function> > functions =
+                static const std::map<Type, std::map<Type, Function> > functions = []
                 {
-                    CONVERT_MAP(L_U8),
-                    CONVERT_MAP(L_U16),
-                    CONVERT_MAP(L_U32),
-                    CONVERT_MAP(L_F16),
-                    CONVERT_MAP(L_F32),
-                    CONVERT_MAP(LA_U8),
-                    CONVERT_MAP(LA_U16),
-                    CONVERT_MAP(LA_U32),
-                    CONVERT_MAP(LA_F16),
-                    CONVERT_MAP(LA_F32),
-                    CONVERT_MAP(RGB_U8),
-                    CONVERT_MAP(RGB_U10),
-                    CONVERT_MAP(RGB_U16),
-                    CONVERT_MAP(RGB_U32),
-                    CONVERT_MAP(RGB_F16),
-                    CONVERT_MAP(RGB_F32),
-                    CONVERT_MAP(RGBA_U8),
-                    CONVERT_MAP(RGBA_U16),
-                    CONVERT_MAP(RGBA_U32),
-                    CONVERT_MAP(RGBA_F16),
-                    CONVERT_MAP(RGBA_F32)
-                };
+                    std::map<Type, std::map<Type, Function> > out =
+                    {
+                        CONVERT_MAP(L_U8),
+                        CONVERT_MAP(L_U16),
+                        CONVERT_MAP(L_U32),
+                        CONVERT_MAP(L_F16),
+                        CONVERT_MAP(L_F32),
+                        CONVERT_MAP(LA_U8),
+                        CONVERT_MAP(LA_U16),
+                        CONVERT_MAP(LA_U32),
+                        CONVERT_MAP(LA_F16),
+                        CONVERT_MAP(LA_F32),
+                        CONVERT_MAP(RGB_U8),
+                        CONVERT_MAP(RGB_U10),
+                        CONVERT_MAP(RGB_U16),
+                        CONVERT_MAP(RGB_U32),
+                        CONVERT_MAP(RGB_F16),
+                        CONVERT_MAP(RGB_F32),
+                        CONVERT_MAP(RGBA_U8),
+                        CONVERT_MAP(RGBA_U16),
+                        CONVERT_MAP(RGBA_U32),
+                        CONVERT_MAP(RGBA_F16),
+                        CONVERT_MAP(RGBA_F32)
+                    };
+#if defined(DJV_PIXEL_SSE2)
+                    out[Type::RGB_U10][Type::RGB_F32]  = convert_RGB_U10_RGB_F32_SSE2;
+                    out[Type::RGB_U10][Type::RGBA_F32] = convert_RGB_U10_RGBA_F32_SSE2;
+                    out[Type::RGB_F32][Type::RGB_U10]  = convert_RGB_F32_RGB_U10_SSE2;
+                    out[Type::RGBA_F32][Type::RGB_U10] = convert_RGBA_F32_RGB_U10_SSE2;
+#endif // DJV_PIXEL_SSE2
+                    return out;
+                }();
                 Function function;
                 const auto i = functions.find(inType);
                 if (i != functions.end())
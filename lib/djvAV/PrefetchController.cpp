@@ -0,0 +1,221 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/PrefetchController.h>
+
+#include <djvCore/Math.h>
+
+#include <cmath>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            namespace
+            {
+                //! \todo Should these be configurable?
+                const float  updateInterval  = .5F;
+                const float  smoothing       = .2F;
+                const float  threadHeadroom  = 1.25F;
+                const float  jitterScale     = 2.F;
+                const float  readBehindTime  = .25F;
+                const size_t readBehindMin   = 2;
+                const size_t readBehindMax   = 30;
+                const size_t readBehindIdle  = 10;
+
+                size_t ceilSize(float value)
+                {
+                    return static_cast<size_t>(std::max(std::ceil(value), 0.F));
+                }
+
+            } // namespace
+
+            PrefetchDecision::PrefetchDecision()
+            {}
+
+            bool PrefetchDecision::operator == (const PrefetchDecision& other) const
+            {
+                return
+                    threadCount == other.threadCount &&
+                    queueSize == other.queueSize &&
+                    readBehind == other.readBehind &&
+                    readTime == other.readTime &&
+                    readJitter == other.readJitter &&
+                    waitTime == other.waitTime &&
+                    consumeRate == other.consumeRate &&
+                    underruns == other.underruns;
+            }
+
+            bool PrefetchDecision::operator != (const PrefetchDecision& other) const
+            {
+                return !(*this == other);
+            }
+
+            PrefetchController::PrefetchController()
+            {
+                reset();
+            }
+
+            void PrefetchController::setLimits(size_t threadMax, size_t queueMax)
+            {
+                _threadMax = std::max(threadMax, static_cast<size_t>(1));
+                _queueMax = std::max(queueMax, static_cast<size_t>(1));
+                _decision.threadCount = Core::Math::clamp(_decision.threadCount, static_cast<size_t>(1), _threadMax);
+                _decision.queueSize = Core::Math::clamp(_decision.queueSize, static_cast<size_t>(1), _queueMax);
+                if (!_readCount)
+                {
+                    _decision.threadCount = _threadMax;
+                    _decision.queueSize = _queueMax;
+                }
+            }
+
+            void PrefetchController::setSpeed(float value)
+            {
+                if (value == _speed)
+                    return;
+                _speed = value;
+
+                // Update the decision right away so that starting playback does
+                // not wait for the next interval with the stopped settings.
+                if (_readCount)
+                {
+                    _decisionUpdate();
+                }
+            }
+
+            void PrefetchController::addRead(float wait, float read)
+            {
+                if (!_readCount)
+                {
+                    _waitTime = wait;
+                    _readTime = read;
+                    _readJitter = 0.F;
+                }
+                else
+                {
+                    _waitTime += (wait - _waitTime) * smoothing;
+                    _readJitter += (std::abs(read - _readTime) - _readJitter) * smoothing;
+                    _readTime += (read - _readTime) * smoothing;
+                }
+                ++_readCount;
+            }
+
+            void PrefetchController::addConsumed(size_t value)
+            {
+                _consumed += value;
+            }
+
+            void PrefetchController::addUnderrun()
+            {
+                ++_underruns;
+            }
+
+            bool PrefetchController::tick(float dt)
+            {
+                bool out = false;
+                _elapsed += dt;
+                if (_elapsed >= updateInterval)
+                {
+                    const PrefetchDecision prev = _decision;
+                    const float rate = _consumed / _elapsed;
+                    _decision.consumeRate = _decision.consumeRate > 0.F && rate > 0.F ?
+                        (_decision.consumeRate + (rate - _decision.consumeRate) * smoothing) :
+                        rate;
+                    _decision.readTime = _readTime;
+                    _decision.readJitter = _readJitter;
+                    _decision.waitTime = _waitTime;
+                    _decision.underruns = _underruns;
+                    if (_underruns > 0)
+                    {
+                        _boost = std::min(_boost + 1, _threadMax);
+                    }
+                    else if (_boost > 0)
+                    {
+                        --_boost;
+                    }
+                    _consumed = 0;
+                    _underruns = 0;
+                    _elapsed = 0.F;
+                    if (_readCount)
+                    {
+                        _decisionUpdate();
+                    }
+                    out = _decision != prev;
+                }
+                return out;
+            }
+
+            const PrefetchDecision& PrefetchController::getDecision() const
+            {
+                return _decision;
+            }
+
+            void PrefetchController::reset()
+            {
+                _readTime = 0.F;
+                _readJitter = 0.F;
+                _waitTime = 0.F;
+                _readCount = 0;
+                _consumed = 0;
+                _underruns = 0;
+                _boost = 0;
+                _elapsed = 0.F;
+                _decision = PrefetchDecision();
+                _decision.threadCount = _threadMax;
+                _decision.queueSize = _queueMax;
+            }
+
+            void PrefetchController::_decisionUpdate()
+            {
+                const bool consuming = _decision.consumeRate > 0.F;
+                const float rate = std::max(_decision.consumeRate, _speed);
+
+                // The number of reads that need to be in flight to sustain the
+                // frame rate (Little's law), with some headroom.
+                const size_t threadCount = ceilSize(rate * _decision.readTime * threadHeadroom) + _boost;
+                _decision.threadCount = Core::Math::clamp(threadCount, static_cast<size_t>(1), _threadMax);
+
+                // The queue needs to hold enough frames to cover the latency of a
+                // read plus the jitter.
+                const float latency = _decision.waitTime + _decision.readTime + _decision.readJitter * jitterScale;
+                const size_t queueSize = ceilSize(rate * latency) + 1;
+                _decision.queueSize = Core::Math::clamp(queueSize, static_cast<size_t>(1), _queueMax);
+
+                // Only keep a short history behind the current frame during
+                // playback to save memory.
+                _decision.readBehind = consuming ?
+                    Core::Math::clamp(ceilSize(rate * readBehindTime), readBehindMin, readBehindMax) :
+                    readBehindIdle;
+            }
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,122 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <cstddef>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace IO
+        {
+            //! This class provides the prefetch settings chosen by the adaptive
+            //! prefetch controller and the measurements they are based on.
+            class PrefetchDecision
+            {
+            public:
+                PrefetchDecision();
+
+                size_t threadCount = 1;     //!< The number of concurrent reads for the queue.
+                size_t queueSize   = 1;     //!< The video queue size.
+                size_t readBehind  = 10;    //!< The number of cached frames behind the current frame.
+
+                float  readTime    = 0.F;   //!< The average time to read a frame in seconds.
+                float  readJitter  = 0.F;   //!< The average deviation of the read time in seconds.
+                float  waitTime    = 0.F;   //!< The average time a read waits to start in seconds.
+                float  consumeRate = 0.F;   //!< The rate frames are taken from the queue.
+                size_t underruns   = 0;     //!< The number of times the queue was found empty.
+
+                bool operator == (const PrefetchDecision&) const;
+                bool operator != (const PrefetchDecision&) const;
+            };
+
+            //! This class provides an adaptive prefetch controller.
+            //!
+            //! The controller measures how long frames take to read and how
+            //! quickly they are consumed. From these it chooses the number of
+            //! concurrent reads needed to hold the frame rate, and the smallest
+            //! queue that covers the read latency and jitter. Queue underruns
+            //! temporarily add extra reads.
+            class PrefetchController
+            {
+            public:
+                PrefetchController();
+
+                //! Set the maximum number of concurrent reads and the maximum
+                //! queue size.
+                void setLimits(size_t threadMax, size_t queueMax);
+
+                //! Set the frame rate to hold when frames are not being consumed.
+                //! The decision is updated immediately when the speed changes.
+                void setSpeed(float);
+
+                //! Add the timings of a frame that was read.
+                //! \param wait The time the read waited to start in seconds.
+                //! \param read The time taken to read the frame in seconds.
+                void addRead(float wait, float read);
+
+                //! Add frames that were taken from the queue.
+                void addConsumed(size_t);
+
+                //! Record that the queue was found empty while frames were being
+                //! consumed.
+                void addUnderrun();
+
+                //! Update the decision with the elapsed time in seconds. Returns
+                //! true if the decision changed.
+                bool tick(float dt);
+
+                const PrefetchDecision& getDecision() const;
+
+                void reset();
+
+            private:
+                void _decisionUpdate();
+
+                size_t _threadMax = 1;
+                size_t _queueMax = 1;
+                float _speed = 0.F;
+                float _readTime = 0.F;
+                float _readJitter = 0.F;
+                float _waitTime = 0.F;
+                size_t _readCount = 0;
+                size_t _consumed = 0;
+                size_t _underruns = 0;
+                size_t _boost = 0;
+                float _elapsed = 0.F;
+                PrefetchDecision _decision;
+            };
+
+        } // namespace IO
+    } // namespace AV
+} // namespace djv
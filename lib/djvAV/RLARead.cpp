@@ -162,7 +162,7 @@ namespace djv
                     const size_t bytes = Image::getByteCount(Image::getDataType(info.video[0].info.type));
                     const Image::DataType dataType = Image::getDataType(info.video[0].info.type);
                     uint8_t* dataP = out->getData();
-                    for (uint16_t y = 0; y < h; ++y, dataP += w * channels * bytes)
+                    for (uint32_t y = 0; y < h; ++y, dataP += w * channels * bytes)
                     {
                         io.setPos(_rleOffset[y]);
                         for (int c = 0; c < channels; ++c)
@@ -31,18 +31,21 @@
 
 #include <djvAV/Color.h>
 #include <djvAV/GLFWSystem.h>
+#include <djvAV/ImagePyramid.h>
 #include <djvAV/OpenGLMesh.h>
+#include <djvAV/OpenGLPixelBuffer.h>
 #include <djvAV/OpenGLShader.h>
 #include <djvAV/OpenGLTexture.h>
 #include <djvAV/Shader.h>
 #include <djvAV/Shape.h>
+#include <djvAV/SoftwareRaster.h>
 #include <djvAV/TextureAtlas.h>
 #include <djvAV/TriangleMesh.h>
 
-#include <djvCore/Cache.h>
 #include <djvCore/Context.h>
 #include <djvCore/FileIO.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/Range.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/Timer.h>
@@ -53,6 +56,14 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/perpendicular.hpp>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <set>
+#include <tuple>
+#include <typeinfo>
+
 using namespace djv::Core;
 namespace _OCIO = OCIO_NAMESPACE;
 
@@ -73,6 +84,13 @@ namespace djv
                 const size_t   lut3DSize              = 32;
                 const size_t   colorSpaceCacheMax     = 32;
 #endif // DJV_OPENGL_ES2
+                const size_t   primitiveArenaBlockSize = 65536;
+                const size_t   softwareTextureCacheMax = 1024;
+                const size_t   softwareTextureCacheByteCountMax = Memory::gigabyte;
+                const uint32_t tiledImageSizeMax      = 8192;
+                const size_t   tiledImageCacheMax     = 4;
+                const size_t   tileTextureCacheMax    = 256;
+                const size_t   tileUploadMax          = 16;
 
                 // This enumeration provides how the color is used to draw the render primitive.
                 enum class ColorMode
@@ -135,18 +153,56 @@ namespace djv
                     AlphaBlend  alphaBlend  = AlphaBlend::Straight;
                     bool        lcdText     = false;
 
+                    //! Get whether the primitive uses the same shader state as another
+                    //! primitive, in which case it does not need to be bound again.
+                    virtual bool isSameState(const Primitive& other) const
+                    {
+                        return
+                            typeid(*this) == typeid(other) &&
+                            alphaBlend == other.alphaBlend &&
+                            lcdText == other.lcdText &&
+                            0 == memcmp(color, other.color, sizeof(color));
+                    }
+
+                    //! Get whether the primitive can be drawn together with another
+                    //! primitive.
+                    bool canMerge(const Primitive& other) const
+                    {
+                        return
+                            GL_TRIANGLES == type &&
+                            GL_TRIANGLES == other.type &&
+                            clipRect == other.clipRect &&
+                            isSameState(other);
+                    }
+
                     virtual void bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader)
                     {
                         shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::SolidColor));
                         shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
                     }
+
+                    virtual void bind(Software::State& state) const
+                    {
+                        state.shade = Software::Shade::SolidColor;
+                        memcpy(state.color, color, sizeof(color));
+                        state.alphaBlend = alphaBlend;
+                    }
                 };
 
                 //! This class provides a text render primitive.
                 class TextPrimitive : public Primitive
                 {
                 public:
-                    uint8_t atlasIndex = 0;
+                    uint8_t                     atlasIndex      = 0;
+                    const Software::Texture*    softwareTexture = nullptr;
+
+                    bool isSameState(const Primitive& other) const override
+                    {
+                        return
+                            Primitive::isSameState(other) &&
+                            atlasIndex == static_cast<const TextPrimitive&>(other).atlasIndex &&
+                            softwareTexture == static_cast<const TextPrimitive&>(other).softwareTexture;
+                    }
 
                     void bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader) override
                     {
@@ -157,6 +213,14 @@ namespace djv
                         shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
                         shader->setUniform(data.textureSamplerLoc, static_cast<int>(atlasIndex));
                     }
+
+                    void bind(Software::State& state) const override
+                    {
+                        Primitive::bind(state);
+                        state.shade = lcdText ? Software::Shade::TextureAlphaLCD : Software::Shade::TextureAlpha;
+                        state.texture = softwareTexture;
+                        state.filter = ImageFilter::Nearest;
+                    }
                 };
 
                 //! This class provides an image render primitive.
@@ -184,6 +248,13 @@ namespace djv
                     ImageCache      imageCache          = ImageCache::Atlas;
                     uint8_t         atlasIndex          = 0;
                     GLuint          textureID           = 0;
+                    const Software::Texture* softwareTexture = nullptr;
+                    ImageFilter     softwareFilter      = ImageFilter::Nearest;
+
+                    bool isSameState(const Primitive&) const override
+                    {
+                        return false;
+                    }
 
                     void bind(const PrimitiveData& data, const std::shared_ptr<OpenGL::Shader>& shader) override
                     {
@@ -237,6 +308,28 @@ namespace djv
                         default: break;
                         }
                     }
+
+                    void bind(Software::State& state) const override
+                    {
+                        Primitive::bind(state);
+                        state.shade = ColorMode::ColorWithTextureAlpha == colorMode ?
+                            Software::Shade::TextureAlpha :
+                            Software::Shade::Texture;
+                        state.texture = softwareTexture;
+                        state.filter = softwareFilter;
+                        state.colorMatrix = colorMatrix;
+                        state.colorMatrixEnabled = colorMatrixEnabled;
+                        state.colorInvert = colorInvert;
+                        state.levels = levels;
+                        state.levelsEnabled = levelsEnabled;
+                        state.exposureV = exposureV;
+                        state.exposureD = exposureD;
+                        state.exposureK = exposureK;
+                        state.exposureF = exposureF;
+                        state.exposureEnabled = exposureEnabled;
+                        state.softClip = softClip;
+                        state.imageChannel = imageChannel;
+                    }
                 };
 
                 //! This class provides a shadow render primitive.
@@ -248,6 +341,89 @@ namespace djv
                         shader->setUniform(data.colorModeLoc, static_cast<int>(ColorMode::Shadow));
                         shader->setUniform(data.colorLoc, reinterpret_cast<const GLfloat*>(color));
                     }
+
+                    void bind(Software::State& state) const override
+                    {
+                        Primitive::bind(state);
+                        state.shade = Software::Shade::Shadow;
+                    }
+                };
+
+                //! This class provides a frame-scoped arena for render primitives.
+                //! The memory is kept between frames so that drawing does not
+                //! allocate once the arena has grown to the size of a frame.
+                class PrimitiveArena
+                {
+                    DJV_NON_COPYABLE(PrimitiveArena);
+
+                public:
+                    PrimitiveArena()
+                    {}
+
+                    ~PrimitiveArena()
+                    {
+                        clear();
+                    }
+
+                    template<typename T>
+                    T* create()
+                    {
+                        static_assert(sizeof(T) <= primitiveArenaBlockSize, "Primitive is too large");
+                        static_assert(alignof(T) <= alignof(std::max_align_t), "Primitive alignment is not supported");
+                        const size_t size = (sizeof(T) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+                        if (_blockIndex < _blocks.size() && _blockOffset + size > primitiveArenaBlockSize)
+                        {
+                            ++_blockIndex;
+                            _blockOffset = 0;
+                        }
+                        if (_blockIndex == _blocks.size())
+                        {
+                            _blocks.push_back(std::unique_ptr<Block>(new Block));
+                        }
+                        T* out = new (_blocks[_blockIndex]->data + _blockOffset) T;
+                        _blockOffset += size;
+                        _primitives.push_back(out);
+                        return out;
+                    }
+
+                    const std::vector<Primitive*>& getPrimitives() const
+                    {
+                        return _primitives;
+                    }
+
+                    size_t getByteCount() const
+                    {
+                        return _blocks.size() * primitiveArenaBlockSize;
+                    }
+
+                    void clear()
+                    {
+                        for (auto i : _primitives)
+                        {
+                            i->~Primitive();
+                        }
+                        _primitives.clear();
+                        _blockIndex = 0;
+                        _blockOffset = 0;
+                    }
+
+                private:
+                    struct Block
+                    {
+                        alignas(std::max_align_t) uint8_t data[primitiveArenaBlockSize];
+                    };
+                    std::vector<std::unique_ptr<Block> > _blocks;
+                    size_t _blockIndex = 0;
+                    size_t _blockOffset = 0;
+                    std::vector<Primitive*> _primitives;
+                };
+
+                //! This struct provides a batch of primitives that are drawn together.
+                struct Batch
+                {
+                    Primitive* primitive = nullptr;
+                    size_t     vaoOffset = 0;
+                    size_t     vaoSize   = 0;
                 };
 
                 //! This struct provides the layout for a VBO vertex.
@@ -465,19 +641,27 @@ namespace djv
             struct Render2D::Private
             {
                 Render2D* system = nullptr;
+                Backend   backend = Backend::OpenGL;
 
                 Font::Info                              currentFont;
                 ImageFilterOptions                      imageFilterOptions  = ImageFilterOptions(ImageFilter::Linear, ImageFilter::Nearest);
                 bool                                    lcdText             = true;
 
                 BBox2f                                              viewport;
-                std::vector<Primitive*>                             primitives;
+                PrimitiveArena                                      primitives;
+                std::vector<Batch>                                  batches;
+                bool                                                batchingEnabled     = true;
+                size_t                                              primitiveCount      = 0;
+                size_t                                              drawCount           = 0;
+                size_t                                              stateChangeCount    = 0;
+                size_t                                              vertexCount         = 0;
                 PrimitiveData                                       primitiveData;
                 std::shared_ptr<TextureAtlas>                       textureAtlas;
                 std::map<UID, uint64_t>                             textureIDs;
                 std::map<UID, uint64_t>                             glyphTextureIDs;
                 std::vector<std::shared_ptr<OpenGL::Texture> >      dynamicTextures;
                 std::map<UID, std::shared_ptr<OpenGL::Texture> >    dynamicTextureCache;
+                std::shared_ptr<OpenGL::PixelBufferRing>            pixelBuffers;
 #if !defined(DJV_OPENGL_ES2)
                 std::map<OCIO::Convert, ColorSpaceData>             colorSpaceCache;
 #endif // DJV_OPENGL_ES2
@@ -492,13 +676,57 @@ namespace djv
                 std::shared_ptr<OpenGL::Shader>                     shader;
                 GLint                                               mvpLoc              = 0;
 
+                struct SoftwareTexture
+                {
+                    std::shared_ptr<Software::Texture> texture;
+                    size_t frame = 0;
+                };
+                std::shared_ptr<Software::Raster>                   raster;
+                std::vector<Software::Vertex>                       softwareVertices;
+                std::map<std::pair<UID, OCIO::Convert>, SoftwareTexture> softwareTextureCache;
+                size_t                                              softwareTextureCacheByteCount = 0;
+                size_t                                              frameCount          = 0;
+                std::shared_ptr<Image::Image>                       image;
+
+                struct TiledImage
+                {
+                    std::shared_ptr<Image::Pyramid> pyramid;
+                    size_t frame = 0;
+                };
+                struct TileTexture
+                {
+                    std::shared_ptr<OpenGL::Texture> texture;
+                    size_t frame = 0;
+                };
+                uint32_t                                            tiledImageSize      = tiledImageSizeMax;
+                std::map<UID, TiledImage>                           tiledImages;
+                std::map<UID, TileTexture>                          tileTextureCache;
+                std::vector<std::shared_ptr<OpenGL::Texture> >      tileTextures;
+                size_t                                              tileUploadCount     = 0;
+                size_t                                              pendingTileCount    = 0;
+
                 std::shared_ptr<Time::Timer>                        statsTimer;
                 std::vector<float>                                  fpsSamples;
                 std::chrono::time_point<std::chrono::system_clock>  fpsTime             = std::chrono::system_clock::now();
 
                 void updateVBODataSize(size_t);
 
+                void drawOpenGL(const Image::Size&);
+                void drawSoftware(const Image::Size&);
+
+                const Software::Texture* getSoftwareTexture(const Image::Data&, const OCIO::Convert&);
+                GLuint getTileTexture(const std::shared_ptr<Image::Image>&);
+
                 void drawImage(
+                    const std::shared_ptr<Image::Image>&,
+                    const glm::vec2& pos,
+                    const ImageOptions&,
+                    ColorMode,
+                    const glm::mat3x3& currentTransform,
+                    const BBox2f& currentClipRect,
+                    const float finalColor[4],
+                    bool tile = false);
+                void drawTiledImage(
                     const std::shared_ptr<Image::Image>&,
                     const glm::vec2& pos,
                     const ImageOptions&,
@@ -510,42 +738,61 @@ namespace djv
                 std::string getFragmentSource() const;
             };
 
-            void Render2D::_init(const std::shared_ptr<Core::Context>& context)
+            void Render2D::_init(const std::shared_ptr<Core::Context>& context, Backend backend)
             {
                 ISystem::_init("djv::AV::Render::Render2D", context);
 
                 DJV_PRIVATE_PTR();
                 p.system = this;
-
-                addDependency(context->getSystemT<AV::GLFW::System>());
-
-                GLint maxTextureUnits = 0;
-                GLint maxTextureSize = 0;
-                glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
-                glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+                p.backend = backend;
                 {
-                    auto logSystem = context->getSystemT<LogSystem>();
                     std::stringstream ss;
-                    ss << "Maximum OpenGL texture units: " << maxTextureUnits << "\n";
-                    ss << "Maximum OpenGL texture size: " << maxTextureSize;
-                    logSystem->log("djv::AV::Render::Render2D", ss.str());
+                    ss << "Backend: " << (Backend::Software == backend ? "Software" : "OpenGL");
+                    _log(ss.str());
                 }
-                const uint8_t _textureAtlasCount = std::min(maxTextureUnits, static_cast<GLint>(textureAtlasCount));
-                const uint16_t _textureAtlasSize = std::min(maxTextureSize, static_cast<GLint>(textureAtlasSize));
+
+                switch (backend)
                 {
-                    auto logSystem = context->getSystemT<LogSystem>();
-                    std::stringstream ss;
-                    ss << "Texture atlas count: " << _textureAtlasCount << "\n";
-                    ss << "Texture atlas size: " << _textureAtlasSize;
-                    logSystem->log("djv::AV::Render::Render2D", ss.str());
+                case Backend::OpenGL:
+                {
+                    addDependency(context->getSystemT<AV::GLFW::System>());
+
+                    GLint maxTextureUnits = 0;
+                    GLint maxTextureSize = 0;
+                    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
+                    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+                    {
+                        auto logSystem = context->getSystemT<LogSystem>();
+                        std::stringstream ss;
+                        ss << "Maximum OpenGL texture units: " << maxTextureUnits << "\n";
+                        ss << "Maximum OpenGL texture size: " << maxTextureSize;
+                        logSystem->log("djv::AV::Render::Render2D", ss.str());
+                    }
+                    const uint8_t _textureAtlasCount = std::min(maxTextureUnits, static_cast<GLint>(textureAtlasCount));
+                    const uint16_t _textureAtlasSize = std::min(maxTextureSize, static_cast<GLint>(textureAtlasSize));
+                    {
+                        auto logSystem = context->getSystemT<LogSystem>();
+                        std::stringstream ss;
+                        ss << "Texture atlas count: " << _textureAtlasCount << "\n";
+                        ss << "Texture atlas size: " << _textureAtlasSize;
+                        logSystem->log("djv::AV::Render::Render2D", ss.str());
+                    }
+                    p.textureAtlas.reset(new TextureAtlas(
+                        _textureAtlasCount,
+                        _textureAtlasSize,
+                        Image::Type::RGBA_U8,
+                        GL_NEAREST,
+                        0));
+                    p.primitiveData.textureAtlasCount = _textureAtlasCount;
+                    p.pixelBuffers = OpenGL::PixelBufferRing::create();
+                    p.tiledImageSize = std::min(static_cast<uint32_t>(maxTextureSize), tiledImageSizeMax);
+                    break;
+                }
+                case Backend::Software:
+                    p.raster = Software::Raster::create();
+                    break;
+                default: break;
                 }
-                p.textureAtlas.reset(new TextureAtlas(
-                    _textureAtlasCount,
-                    _textureAtlasSize,
-                    Image::Type::RGBA_U8,
-                    GL_NEAREST,
-                    0));
-                p.primitiveData.textureAtlasCount = _textureAtlasCount;
 
                 _updateImageFilter();
 
@@ -575,15 +822,40 @@ namespace djv
                     {
                         DJV_PRIVATE_PTR();
                         std::stringstream ss;
-                        ss << "Texture atlas: " << p.textureAtlas->getPercentageUsed() << "%\n";
-                        ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
-                        ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
-                        ss << "Dynamic textures: " << p.dynamicTextures.size() << "\n";
-                        ss << "Dynamic texture cache: " << p.dynamicTextureCache.size() << "\n";
+                        switch (p.backend)
+                        {
+                        case Backend::OpenGL:
+                            ss << "Texture atlas: " << p.textureAtlas->getPercentageUsed() << "%\n";
+                            ss << "Texture IDs: " << p.textureIDs.size() << "%\n";
+                            ss << "Glyph texture IDs: " << p.glyphTextureIDs.size() << "\n";
+                            ss << "Dynamic textures: " << p.dynamicTextures.size() << "\n";
+                            ss << "Dynamic texture cache: " << p.dynamicTextureCache.size() << "\n";
+                            ss << "Texture uploads: " << p.pixelBuffers->getUploadCount() << "\n";
+                            ss << "Texture upload orphans: " << p.pixelBuffers->getOrphanCount() << "\n";
+                            ss << "Texture upload fallbacks: " << p.pixelBuffers->getFallbackCount() << "\n";
+                            ss << "Texture upload bytes: " << p.pixelBuffers->getByteCount() << "\n";
+                            ss << "Texture upload time: " << p.pixelBuffers->getUploadTime() << "\n";
+                            ss << "Tile texture cache: " << p.tileTextureCache.size() << "\n";
 #if !defined(DJV_OPENGL_ES2)
-                        ss << "Color space cache: " << p.colorSpaceCache.size() << "\n";
+                            ss << "Color space cache: " << p.colorSpaceCache.size() << "\n";
 #endif // DJV_OPENGL_ES2
-                        ss << "VBO size: " << (p.vbo ? p.vbo->getSize() : 0);
+                            ss << "VBO size: " << (p.vbo ? p.vbo->getSize() : 0) << "\n";
+                            break;
+                        case Backend::Software:
+                            ss << "Software texture cache: " << p.softwareTextureCache.size() << ", " <<
+                                p.softwareTextureCacheByteCount << "\n";
+                            ss << "Software threads: " << p.raster->getThreadCount() << "\n";
+                            ss << "Triangles: " << p.raster->getTriangleCount() << "\n";
+                            break;
+                        default: break;
+                        }
+                        ss << "Tiled images: " << p.tiledImages.size() << "\n";
+                        ss << "Pending tiles: " << p.pendingTileCount << "\n";
+                        ss << "Primitives: " << p.primitiveCount << "\n";
+                        ss << "Primitive arena: " << p.primitives.getByteCount() << "\n";
+                        ss << "Draw calls: " << p.drawCount << "\n";
+                        ss << "State changes: " << p.stateChangeCount << "\n";
+                        ss << "Vertices: " << p.vertexCount;
                         _log(ss.str());
                     });
 
@@ -614,157 +886,68 @@ namespace djv
             {}
 
             std::shared_ptr<Render2D> Render2D::create(const std::shared_ptr<Core::Context>& context)
+            {
+                return create(context, Backend::OpenGL);
+            }
+
+            std::shared_ptr<Render2D> Render2D::create(const std::shared_ptr<Core::Context>& context, Backend backend)
             {
                 auto out = std::shared_ptr<Render2D>(new Render2D);
-                out->_init(context);
+                out->_init(context, backend);
                 return out;
             }
 
+            Backend Render2D::getBackend() const
+            {
+                return _p->backend;
+            }
+
             void Render2D::beginFrame(const Image::Size& size)
             {
                 DJV_PRIVATE_PTR();
                 _size = size;
                 _currentClipRect = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
                 p.viewport = BBox2f(0.F, 0.F, static_cast<float>(size.w), static_cast<float>(size.h));
+                p.tileUploadCount = 0;
+                p.pendingTileCount = 0;
             }
 
             void Render2D::endFrame()
             {
                 DJV_PRIVATE_PTR();
 
-                if (!p.shader)
-                {
-                    auto shader = Shader::create(p.vertexSource, p.getFragmentSource());
-                    shader->setVertexName(p.vertexFileName);
-                    shader->setFragmentName(p.fragmentFileName);
-                    p.shader = OpenGL::Shader::create(shader);
-                    const auto program = p.shader->getProgram();
-                    p.mvpLoc = glGetUniformLocation(program, "transform.mvp");
-                    p.primitiveData.imageChannelsLoc = glGetUniformLocation(program, "imageChannels");
-#if !defined(DJV_OPENGL_ES2)
-                    p.primitiveData.colorSpaceLoc = glGetUniformLocation(program, "colorSpace");
-                    p.primitiveData.colorSpaceSamplerLoc = glGetUniformLocation(program, "colorSpaceSampler");
-#endif // DJV_OPENGL_ES2
-                    p.primitiveData.imageChannelLoc = glGetUniformLocation(program, "imageChannel");
-                    p.primitiveData.colorMatrixLoc = glGetUniformLocation(program, "colorMatrix");
-                    p.primitiveData.colorMatrixEnabledLoc = glGetUniformLocation(program, "colorMatrixEnabled");
-                    p.primitiveData.colorInvertLoc = glGetUniformLocation(program, "colorInvert");
-                    p.primitiveData.levelsInLowLoc = glGetUniformLocation(program, "levels.inLow");
-                    p.primitiveData.levelsInHighLoc = glGetUniformLocation(program, "levels.inHigh");
-                    p.primitiveData.levelsGammaLoc = glGetUniformLocation(program, "levels.gamma");
-                    p.primitiveData.levelsOutLowLoc = glGetUniformLocation(program, "levels.outLow");
-                    p.primitiveData.levelsOutHighLoc = glGetUniformLocation(program, "levels.outHigh");
-                    p.primitiveData.levelsEnabledLoc = glGetUniformLocation(program, "levelsEnabled");
-                    p.primitiveData.exposureVLoc = glGetUniformLocation(program, "exposure.v");
-                    p.primitiveData.exposureDLoc = glGetUniformLocation(program, "exposure.d");
-                    p.primitiveData.exposureKLoc = glGetUniformLocation(program, "exposure.k");
-                    p.primitiveData.exposureFLoc = glGetUniformLocation(program, "exposure.f");
-                    p.primitiveData.exposureEnabledLoc = glGetUniformLocation(program, "exposureEnabled");
-                    p.primitiveData.softClipLoc = glGetUniformLocation(program, "softClip");
-                    p.primitiveData.colorModeLoc = glGetUniformLocation(program, "colorMode");
-                    p.primitiveData.colorLoc = glGetUniformLocation(program, "color");
-                    p.primitiveData.textureSamplerLoc = glGetUniformLocation(program, "textureSampler");
-                }
-                p.shader->bind();
-
-#if !defined(DJV_OPENGL_ES2)
-                glEnable(GL_MULTISAMPLE);
-#endif // DJV_OPENGL_ES2
-                glEnable(GL_SCISSOR_TEST);
-                glEnable(GL_BLEND);
-
-                glViewport(
-                    static_cast<GLint>(p.viewport.min.x),
-                    static_cast<GLint>(p.viewport.min.y),
-                    static_cast<GLsizei>(p.viewport.w()),
-                    static_cast<GLsizei>(p.viewport.h()));
-                glScissor(
-                    static_cast<GLint>(p.viewport.min.x),
-                    static_cast<GLint>(p.viewport.min.y),
-                    static_cast<GLsizei>(p.viewport.w()),
-                    static_cast<GLsizei>(p.viewport.h()));
-                glClearColor(0.F, 0.F, 0.F, 0.F);
-                glClear(GL_COLOR_BUFFER_BIT);
-
-                const auto viewMatrix = glm::ortho(
-                    p.viewport.min.x,
-                    p.viewport.max.x,
-                    p.viewport.max.y,
-                    p.viewport.min.y,
-                    -1.F, 1.F);
-                p.shader->setUniform(p.mvpLoc, viewMatrix);
-
-                const auto& atlasTextures = p.textureAtlas->getTextures();
-                for (GLuint i = 0; i < static_cast<GLuint>(atlasTextures.size()); ++i)
-                {
-                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i));
-                    glBindTexture(GL_TEXTURE_2D, atlasTextures[i]);
-                }
-
-                const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
-                if (!p.vbo || p.vboDataSize / vertexByteCount > p.vbo->getSize())
+                // Merge consecutive primitives that share the same state and
+                // clipping rectangle into batches.
+                const auto& primitives = p.primitives.getPrimitives();
+                p.batches.clear();
+                for (const auto& primitive : primitives)
                 {
-                    p.vbo = OpenGL::VBO::create(p.vboDataSize / vertexByteCount, OpenGL::VBOType::Pos2_F32_UV_U16);
-                    p.vao = OpenGL::VAO::create(p.vbo->getType(), p.vbo->getID());
-                }
-                p.vbo->copy(p.vboData, 0, p.vboDataSize);
-                p.vao->bind();
-
-                AlphaBlend currentAlphaBlend = AlphaBlend::Straight;
-                bool currentLCDText = false;
-                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-                for (size_t i = 0; i < p.primitives.size(); ++i)
-                {
-                    const auto& primitive = p.primitives[i];
-                    const BBox2f clipRect = flip(primitive->clipRect, _size);
-                    glScissor(
-                        static_cast<GLint>(clipRect.min.x),
-                        static_cast<GLint>(clipRect.min.y),
-                        static_cast<GLsizei>(clipRect.w()),
-                        static_cast<GLsizei>(clipRect.h()));
-                    if (primitive->alphaBlend != currentAlphaBlend)
+                    if (p.batchingEnabled && p.batches.size())
                     {
-                        currentAlphaBlend = primitive->alphaBlend;
-                        switch (currentAlphaBlend)
+                        auto& batch = p.batches.back();
+                        if (batch.vaoOffset + batch.vaoSize == primitive->vaoOffset &&
+                            batch.primitive->canMerge(*primitive))
                         {
-                        case AlphaBlend::None:
-                            glBlendFunc(GL_ONE, GL_ZERO);
-                            break;
-                        case AlphaBlend::Straight:
-                            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                            break;
-                        case AlphaBlend::Premultiplied:
-                            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-                            break;
-                        default: break;
+                            batch.vaoSize += primitive->vaoSize;
+                            continue;
                         }
                     }
-                    if (primitive->lcdText != currentLCDText)
-                    {
-                        currentLCDText = primitive->lcdText;
-                        if (!currentLCDText)
-                        {
-                            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-                        }
-                    }
-                    primitive->bind(p.primitiveData, p.shader);
-                    if (currentLCDText)
-                    {
-                        p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaR));
-                        glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
-                        p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaG));
-                        glColorMask(GL_FALSE, GL_TRUE, GL_FALSE, GL_FALSE);
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
-                        p.shader->setUniform(p.primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaB));
-                        glColorMask(GL_FALSE, GL_FALSE, GL_TRUE, GL_FALSE);
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
-                    }
-                    else
-                    {
-                        p.vao->draw(primitive->type, primitive->vaoOffset, primitive->vaoSize);
-                    }
+                    Batch batch;
+                    batch.primitive = primitive;
+                    batch.vaoOffset = primitive->vaoOffset;
+                    batch.vaoSize = primitive->vaoSize;
+                    p.batches.push_back(batch);
+                }
+                p.primitiveCount = primitives.size();
+                p.drawCount = 0;
+                p.stateChangeCount = 0;
+                p.vertexCount = p.vboDataSize / AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+
+                switch (p.backend)
+                {
+                case Backend::OpenGL:   p.drawOpenGL(_size);   break;
+                case Backend::Software: p.drawSoftware(_size); break;
+                default: break;
                 }
 
                 const auto now = std::chrono::system_clock::now();
@@ -777,12 +960,27 @@ namespace djv
                 }
 
                 _clipRects.clear();
-                for (size_t i = 0; i < p.primitives.size(); ++i)
-                {
-                    delete p.primitives[i];
-                }
                 p.primitives.clear();
+                p.batches.clear();
                 p.vboDataSize = 0;
+                ++p.frameCount;
+                if (p.softwareTextureCache.size() > softwareTextureCacheMax ||
+                    p.softwareTextureCacheByteCount > softwareTextureCacheByteCountMax)
+                {
+                    auto i = p.softwareTextureCache.begin();
+                    while (i != p.softwareTextureCache.end())
+                    {
+                        if (i->second.frame + 1 < p.frameCount)
+                        {
+                            p.softwareTextureCacheByteCount -= i->second.texture->getDataByteCount();
+                            i = p.softwareTextureCache.erase(i);
+                        }
+                        else
+                        {
+                            ++i;
+                        }
+                    }
+                }
                 while (p.dynamicTextureCache.size() > dynamicTextureCacheMax)
                 {
                     auto texture = p.dynamicTextureCache.begin();
@@ -793,6 +991,41 @@ namespace djv
                 {
                     p.dynamicTextures.pop_back();
                 }
+                while (p.tiledImages.size() > tiledImageCacheMax)
+                {
+                    auto oldest = p.tiledImages.begin();
+                    for (auto i = p.tiledImages.begin(); i != p.tiledImages.end(); ++i)
+                    {
+                        if (i->second.frame < oldest->second.frame)
+                        {
+                            oldest = i;
+                        }
+                    }
+                    p.tiledImages.erase(oldest);
+                }
+                while (p.tileTextureCache.size() > tileTextureCacheMax)
+                {
+                    // Remove the least recently used tile texture, but keep the
+                    // tile textures that were used by this frame.
+                    auto oldest = p.tileTextureCache.begin();
+                    for (auto i = p.tileTextureCache.begin(); i != p.tileTextureCache.end(); ++i)
+                    {
+                        if (i->second.frame < oldest->second.frame)
+                        {
+                            oldest = i;
+                        }
+                    }
+                    if (oldest->second.frame + 1 >= p.frameCount)
+                    {
+                        break;
+                    }
+                    p.tileTextures.push_back(oldest->second.texture);
+                    p.tileTextureCache.erase(oldest);
+                }
+                while (p.tileTextures.size() > dynamicTextureCount)
+                {
+                    p.tileTextures.pop_back();
+                }
 #if !defined(DJV_OPENGL_ES2)
                 while (p.colorSpaceCache.size() > colorSpaceCacheMax)
                 {
@@ -834,8 +1067,7 @@ namespace djv
                     }
                     if (bbox.intersects(_currentClipRect))
                     {
-                        auto primitive = new Primitive;
-                        p.primitives.push_back(primitive);
+                        auto primitive = p.primitives.create<Primitive>();
                         primitive->clipRect = _currentClipRect;
                         primitive->color[0] = _finalColor[0];
                         primitive->color[1] = _finalColor[1];
@@ -849,7 +1081,7 @@ namespace djv
                         p.updateVBODataSize(ptsSize);
                         const glm::vec2* pPts = pts.data();
                         VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataSize]);
-                        for (size_t i = 0; i < size; ++i, pPts += 2)
+                        for (size_t i = 1; i < size; ++i, pPts += 2)
                         {
                             pData->vx = pPts[0].x;
                             pData->vy = pPts[0].y;
@@ -864,58 +1096,12 @@ namespace djv
             
             void Render2D::drawRect(const BBox2f & value)
             {
-                drawRects({ value });
+                _drawRects(&value, 1);
             }
 
             void Render2D::drawRects(const std::vector<BBox2f>& value)
             {
-                DJV_PRIVATE_PTR();
-                std::vector<const BBox2f*> clipped;
-                for (const auto& i : value)
-                {
-                    if (i.intersects(_currentClipRect))
-                    {
-                        clipped.push_back(&i);
-                    }
-                }
-                const size_t clippedSize = clipped.size();
-                if (clippedSize > 0)
-                {
-                    auto primitive = new Primitive;
-                    p.primitives.push_back(primitive);
-                    primitive->clipRect = _currentClipRect;
-                    primitive->color[0] = _finalColor[0];
-                    primitive->color[1] = _finalColor[1];
-                    primitive->color[2] = _finalColor[2];
-                    primitive->color[3] = _finalColor[3];
-                    primitive->vaoOffset = p.vboDataSize / AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
-                    primitive->vaoSize = clippedSize * 6;
-
-                    const size_t vboDataSize = p.vboDataSize;
-                    p.updateVBODataSize(clippedSize * 6);
-                    VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataSize]);
-                    for (const auto& i : clipped)
-                    {
-                        pData->vx = i->min.x;
-                        pData->vy = i->min.y;
-                        ++pData;
-                        pData->vx = i->max.x;
-                        pData->vy = i->min.y;
-                        ++pData;
-                        pData->vx = i->max.x;
-                        pData->vy = i->max.y;
-                        ++pData;
-                        pData->vx = i->max.x;
-                        pData->vy = i->max.y;
-                        ++pData;
-                        pData->vx = i->min.x;
-                        pData->vy = i->max.y;
-                        ++pData;
-                        pData->vx = i->min.x;
-                        pData->vy = i->min.y;
-                        ++pData;
-                    }
-                }
+                _drawRects(value.data(), value.size());
             }
 
             void Render2D::drawPill(const Core::BBox2f& rect, size_t facets)
@@ -923,8 +1109,7 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 if (rect.intersects(_currentClipRect))
                 {
-                    auto primitive = new Primitive;
-                    p.primitives.push_back(primitive);
+                    auto primitive = p.primitives.create<Primitive>();
                     primitive->clipRect = _currentClipRect;
                     primitive->color[0] = _finalColor[0];
                     primitive->color[1] = _finalColor[1];
@@ -999,8 +1184,7 @@ namespace djv
                 const BBox2f rect(pos.x - radius, pos.y - radius, radius * 2.F, radius * 2.F);
                 if (rect.intersects(_currentClipRect))
                 {
-                    auto primitive = new Primitive;
-                    p.primitives.push_back(primitive);
+                    auto primitive = p.primitives.create<Primitive>();
                     primitive->clipRect = _currentClipRect;
                     primitive->color[0] = _finalColor[0];
                     primitive->color[1] = _finalColor[1];
@@ -1079,6 +1263,7 @@ namespace djv
                     std::shared_ptr<Font::Glyph> glyph;
                     BBox2f bbox;
                     TextureAtlasItem item;
+                    const Software::Texture* texture = nullptr;
                 };
                 std::vector<std::vector<GlyphData> > clipped;
                 uint8_t textureIndex = 0;
@@ -1096,8 +1281,8 @@ namespace djv
 
                     if (glyph->imageData && glyph->imageData->isValid())
                     {
-                        const uint16_t width = glyph->imageData->getWidth();
-                        const uint16_t height = glyph->imageData->getHeight();
+                        const uint32_t width = glyph->imageData->getWidth();
+                        const uint32_t height = glyph->imageData->getHeight();
                         const glm::vec2& offset = glyph->offset;
                         const BBox2f bbox(pos.x + x + offset.x, pos.y - offset.y, width, height);
                         if (bbox.intersects(_currentClipRect))
@@ -1105,23 +1290,38 @@ namespace djv
                             GlyphData data;
                             data.glyph = glyph;
                             data.bbox = bbox;
-                            const auto uid = glyph->imageData->getUID();
-                            uint64_t id = 0;
-                            const auto i = p.glyphTextureIDs.find(uid);
-                            if (i != p.glyphTextureIDs.end())
+                            switch (p.backend)
                             {
-                                id = i->second;
-                            }
-                            if (!p.textureAtlas->getItem(id, data.item))
+                            case Backend::OpenGL:
                             {
-                                id = p.textureAtlas->addItem(glyph->imageData, data.item);
-                                p.glyphTextureIDs[uid] = id;
+                                const auto uid = glyph->imageData->getUID();
+                                uint64_t id = 0;
+                                const auto i = p.glyphTextureIDs.find(uid);
+                                if (i != p.glyphTextureIDs.end())
+                                {
+                                    id = i->second;
+                                }
+                                if (!p.textureAtlas->getItem(id, data.item))
+                                {
+                                    id = p.textureAtlas->addItem(glyph->imageData, data.item);
+                                    p.glyphTextureIDs[uid] = id;
+                                }
+
+                                if (data.item.textureIndex != textureIndex || 0 == clipped.size())
+                                {
+                                    textureIndex = data.item.textureIndex;
+                                    clipped.push_back({});
+                                }
+                                break;
                             }
-                            
-                            if (data.item.textureIndex != textureIndex || 0 == clipped.size())
-                            {
-                                textureIndex = data.item.textureIndex;
+                            case Backend::Software:
+                                // Each glyph uses its own texture.
+                                data.item.textureU = FloatRange(0.F, 1.F);
+                                data.item.textureV = FloatRange(0.F, 1.F);
+                                data.texture = p.getSoftwareTexture(*glyph->imageData, OCIO::Convert());
                                 clipped.push_back({});
+                                break;
+                            default: break;
                             }
                             
                             clipped.back().push_back(data);
@@ -1133,14 +1333,14 @@ namespace djv
                 
                 for (const auto& i : clipped)
                 {
-                    auto primitive = new TextPrimitive;
-                    p.primitives.push_back(primitive);
+                    auto primitive = p.primitives.create<TextPrimitive>();
                     primitive->clipRect = _currentClipRect;
                     primitive->color[0] = _finalColor[0];
                     primitive->color[1] = _finalColor[1];
                     primitive->color[2] = _finalColor[2];
                     primitive->color[3] = _finalColor[3];
                     primitive->atlasIndex = i.front().item.textureIndex;
+                    primitive->softwareTexture = i.front().texture;
                     primitive->vaoOffset = p.vboDataSize / AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
                     primitive->vaoSize = i.size() * 6;
                     primitive->lcdText = p.lcdText;
@@ -1189,8 +1389,7 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 if (value.intersects(_currentClipRect))
                 {
-                    auto primitive = new ShadowPrimitive;
-                    p.primitives.push_back(primitive);
+                    auto primitive = p.primitives.create<ShadowPrimitive>();
                     primitive->clipRect = _currentClipRect;
                     primitive->color[0] = _finalColor[0];
                     primitive->color[1] = _finalColor[1];
@@ -1235,8 +1434,7 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 if (value.intersects(_currentClipRect))
                 {
-                    auto primitive = new ShadowPrimitive;
-                    p.primitives.push_back(primitive);
+                    auto primitive = p.primitives.create<ShadowPrimitive>();
                     primitive->clipRect = _currentClipRect;
                     primitive->color[0] = _finalColor[0];
                     primitive->color[1] = _finalColor[1];
@@ -1465,9 +1663,19 @@ namespace djv
                 }
             }
 
+            void Render2D::setBatchingEnabled(bool value)
+            {
+                _p->batchingEnabled = value;
+            }
+
+            bool Render2D::isBatchingEnabled() const
+            {
+                return _p->batchingEnabled;
+            }
+
             float Render2D::getTextureAtlasPercentage() const
             {
-                return _p->textureAtlas->getPercentageUsed();
+                return _p->textureAtlas ? _p->textureAtlas->getPercentageUsed() : 0.F;
             }
 
             size_t Render2D::getDynamicTextureCount() const
@@ -1480,11 +1688,111 @@ namespace djv
                 return _p->vbo ? _p->vbo->getSize() : 0;
             }
 
+            size_t Render2D::getPrimitiveCount() const
+            {
+                return _p->primitiveCount;
+            }
+
+            size_t Render2D::getDrawCount() const
+            {
+                return _p->drawCount;
+            }
+
+            size_t Render2D::getStateChangeCount() const
+            {
+                return _p->stateChangeCount;
+            }
+
+            size_t Render2D::getVertexCount() const
+            {
+                return _p->vertexCount;
+            }
+
+            size_t Render2D::getTextureUploadCount() const
+            {
+                DJV_PRIVATE_PTR();
+                return p.pixelBuffers ? (p.pixelBuffers->getUploadCount() + p.pixelBuffers->getFallbackCount()) : 0;
+            }
+
+            float Render2D::getTextureUploadTime() const
+            {
+                return _p->pixelBuffers ? _p->pixelBuffers->getUploadTime() : 0.F;
+            }
+
+            size_t Render2D::getPendingTileCount() const
+            {
+                return _p->pendingTileCount;
+            }
+
+            std::shared_ptr<Image::Image> Render2D::getImage() const
+            {
+                return _p->image;
+            }
+
+            void Render2D::_drawRects(const BBox2f* value, size_t size)
+            {
+                DJV_PRIVATE_PTR();
+                size_t clippedSize = 0;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (value[i].intersects(_currentClipRect))
+                    {
+                        ++clippedSize;
+                    }
+                }
+                if (clippedSize > 0)
+                {
+                    auto primitive = p.primitives.create<Primitive>();
+                    primitive->clipRect = _currentClipRect;
+                    primitive->color[0] = _finalColor[0];
+                    primitive->color[1] = _finalColor[1];
+                    primitive->color[2] = _finalColor[2];
+                    primitive->color[3] = _finalColor[3];
+                    primitive->vaoOffset = p.vboDataSize / AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+                    primitive->vaoSize = clippedSize * 6;
+
+                    const size_t vboDataSize = p.vboDataSize;
+                    p.updateVBODataSize(clippedSize * 6);
+                    VBOVertex* pData = reinterpret_cast<VBOVertex*>(&p.vboData[vboDataSize]);
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        const BBox2f& rect = value[i];
+                        if (rect.intersects(_currentClipRect))
+                        {
+                            pData->vx = rect.min.x;
+                            pData->vy = rect.min.y;
+                            ++pData;
+                            pData->vx = rect.max.x;
+                            pData->vy = rect.min.y;
+                            ++pData;
+                            pData->vx = rect.max.x;
+                            pData->vy = rect.max.y;
+                            ++pData;
+                            pData->vx = rect.max.x;
+                            pData->vy = rect.max.y;
+                            ++pData;
+                            pData->vx = rect.min.x;
+                            pData->vy = rect.max.y;
+                            ++pData;
+                            pData->vx = rect.min.x;
+                            pData->vy = rect.min.y;
+                            ++pData;
+                        }
+                    }
+                }
+            }
+
             void Render2D::_updateImageFilter()
             {
                 DJV_PRIVATE_PTR();
                 p.dynamicTextures.clear();
                 p.dynamicTextureCache.clear();
+                p.tileTextures.clear();
+                p.tileTextureCache.clear();
+                p.softwareTextureCache.clear();
+                p.softwareTextureCacheByteCount = 0;
+                if (p.backend != Backend::OpenGL)
+                    return;
                 for (size_t i = 0; i < dynamicTextureCount; ++i)
                 {
                     p.dynamicTextures.push_back(
@@ -1505,6 +1813,262 @@ namespace djv
                 }
             }
 
+            void Render2D::Private::drawOpenGL(const Image::Size& size)
+            {
+                if (!shader)
+                {
+                    auto shader = Shader::create(vertexSource, getFragmentSource());
+                    shader->setVertexName(vertexFileName);
+                    shader->setFragmentName(fragmentFileName);
+                    this->shader = OpenGL::Shader::create(shader);
+                    const auto program = this->shader->getProgram();
+                    mvpLoc = glGetUniformLocation(program, "transform.mvp");
+                    primitiveData.imageChannelsLoc = glGetUniformLocation(program, "imageChannels");
+#if !defined(DJV_OPENGL_ES2)
+                    primitiveData.colorSpaceLoc = glGetUniformLocation(program, "colorSpace");
+                    primitiveData.colorSpaceSamplerLoc = glGetUniformLocation(program, "colorSpaceSampler");
+#endif // DJV_OPENGL_ES2
+                    primitiveData.imageChannelLoc = glGetUniformLocation(program, "imageChannel");
+                    primitiveData.colorMatrixLoc = glGetUniformLocation(program, "colorMatrix");
+                    primitiveData.colorMatrixEnabledLoc = glGetUniformLocation(program, "colorMatrixEnabled");
+                    primitiveData.colorInvertLoc = glGetUniformLocation(program, "colorInvert");
+                    primitiveData.levelsInLowLoc = glGetUniformLocation(program, "levels.inLow");
+                    primitiveData.levelsInHighLoc = glGetUniformLocation(program, "levels.inHigh");
+                    primitiveData.levelsGammaLoc = glGetUniformLocation(program, "levels.gamma");
+                    primitiveData.levelsOutLowLoc = glGetUniformLocation(program, "levels.outLow");
+                    primitiveData.levelsOutHighLoc = glGetUniformLocation(program, "levels.outHigh");
+                    primitiveData.levelsEnabledLoc = glGetUniformLocation(program, "levelsEnabled");
+                    primitiveData.exposureVLoc = glGetUniformLocation(program, "exposure.v");
+                    primitiveData.exposureDLoc = glGetUniformLocation(program, "exposure.d");
+                    primitiveData.exposureKLoc = glGetUniformLocation(program, "exposure.k");
+                    primitiveData.exposureFLoc = glGetUniformLocation(program, "exposure.f");
+                    primitiveData.exposureEnabledLoc = glGetUniformLocation(program, "exposureEnabled");
+                    primitiveData.softClipLoc = glGetUniformLocation(program, "softClip");
+                    primitiveData.colorModeLoc = glGetUniformLocation(program, "colorMode");
+                    primitiveData.colorLoc = glGetUniformLocation(program, "color");
+                    primitiveData.textureSamplerLoc = glGetUniformLocation(program, "textureSampler");
+                }
+                shader->bind();
+
+#if !defined(DJV_OPENGL_ES2)
+                glEnable(GL_MULTISAMPLE);
+#endif // DJV_OPENGL_ES2
+                glEnable(GL_SCISSOR_TEST);
+                glEnable(GL_BLEND);
+
+                glViewport(
+                    static_cast<GLint>(viewport.min.x),
+                    static_cast<GLint>(viewport.min.y),
+                    static_cast<GLsizei>(viewport.w()),
+                    static_cast<GLsizei>(viewport.h()));
+                glScissor(
+                    static_cast<GLint>(viewport.min.x),
+                    static_cast<GLint>(viewport.min.y),
+                    static_cast<GLsizei>(viewport.w()),
+                    static_cast<GLsizei>(viewport.h()));
+                glClearColor(0.F, 0.F, 0.F, 0.F);
+                glClear(GL_COLOR_BUFFER_BIT);
+
+                const auto viewMatrix = glm::ortho(
+                    viewport.min.x,
+                    viewport.max.x,
+                    viewport.max.y,
+                    viewport.min.y,
+                    -1.F, 1.F);
+                shader->setUniform(mvpLoc, viewMatrix);
+
+                const auto& atlasTextures = textureAtlas->getTextures();
+                for (GLuint i = 0; i < static_cast<GLuint>(atlasTextures.size()); ++i)
+                {
+                    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + i));
+                    glBindTexture(GL_TEXTURE_2D, atlasTextures[i]);
+                }
+
+                const size_t vertexByteCount = AV::OpenGL::getVertexByteCount(OpenGL::VBOType::Pos2_F32_UV_U16);
+                if (!vbo || vboDataSize / vertexByteCount > vbo->getSize())
+                {
+                    vbo = OpenGL::VBO::create(vboDataSize / vertexByteCount, OpenGL::VBOType::Pos2_F32_UV_U16);
+                    vao = OpenGL::VAO::create(vbo->getType(), vbo->getID());
+                }
+                vbo->copy(vboData, 0, vboDataSize);
+                vao->bind();
+
+                AlphaBlend currentAlphaBlend = AlphaBlend::Straight;
+                bool currentLCDText = false;
+                BBox2f currentClipRect = viewport;
+                const Primitive* currentPrimitive = nullptr;
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                for (const auto& batch : batches)
+                {
+                    const auto& primitive = batch.primitive;
+                    if (primitive->clipRect != currentClipRect)
+                    {
+                        currentClipRect = primitive->clipRect;
+                        const BBox2f clipRect = flip(currentClipRect, size);
+                        glScissor(
+                            static_cast<GLint>(clipRect.min.x),
+                            static_cast<GLint>(clipRect.min.y),
+                            static_cast<GLsizei>(clipRect.w()),
+                            static_cast<GLsizei>(clipRect.h()));
+                        ++stateChangeCount;
+                    }
+                    if (primitive->alphaBlend != currentAlphaBlend)
+                    {
+                        currentAlphaBlend = primitive->alphaBlend;
+                        switch (currentAlphaBlend)
+                        {
+                        case AlphaBlend::None:
+                            glBlendFunc(GL_ONE, GL_ZERO);
+                            break;
+                        case AlphaBlend::Straight:
+                            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                            break;
+                        case AlphaBlend::Premultiplied:
+                            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+                            break;
+                        default: break;
+                        }
+                        ++stateChangeCount;
+                    }
+                    if (primitive->lcdText != currentLCDText)
+                    {
+                        currentLCDText = primitive->lcdText;
+                        if (!currentLCDText)
+                        {
+                            glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+                        }
+                    }
+                    if (!currentPrimitive || !currentPrimitive->isSameState(*primitive))
+                    {
+                        currentPrimitive = primitive;
+                        primitive->bind(primitiveData, shader);
+                        ++stateChangeCount;
+                    }
+                    if (currentLCDText)
+                    {
+                        shader->setUniform(primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaR));
+                        glColorMask(GL_TRUE, GL_FALSE, GL_FALSE, GL_TRUE);
+                        vao->draw(primitive->type, batch.vaoOffset, batch.vaoSize);
+                        shader->setUniform(primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaG));
+                        glColorMask(GL_FALSE, GL_TRUE, GL_FALSE, GL_FALSE);
+                        vao->draw(primitive->type, batch.vaoOffset, batch.vaoSize);
+                        shader->setUniform(primitiveData.colorModeLoc, static_cast<int>(ColorMode::ColorWithTextureAlphaB));
+                        glColorMask(GL_FALSE, GL_FALSE, GL_TRUE, GL_FALSE);
+                        vao->draw(primitive->type, batch.vaoOffset, batch.vaoSize);
+                        drawCount += 3;
+                    }
+                    else
+                    {
+                        vao->draw(primitive->type, batch.vaoOffset, batch.vaoSize);
+                        ++drawCount;
+                    }
+                }
+            }
+
+            void Render2D::Private::drawSoftware(const Image::Size& size)
+            {
+                raster->begin(size);
+                for (const auto& batch : batches)
+                {
+                    const auto& primitive = batch.primitive;
+                    Software::State state;
+                    state.clipX0 = static_cast<int>(primitive->clipRect.min.x);
+                    state.clipY0 = static_cast<int>(primitive->clipRect.min.y);
+                    state.clipX1 = state.clipX0 + static_cast<int>(primitive->clipRect.w());
+                    state.clipY1 = state.clipY0 + static_cast<int>(primitive->clipRect.h());
+                    primitive->bind(state);
+
+                    softwareVertices.resize(batch.vaoSize);
+                    const VBOVertex* pData = reinterpret_cast<const VBOVertex*>(vboData.data()) + batch.vaoOffset;
+                    for (auto& i : softwareVertices)
+                    {
+                        i.x = pData->vx;
+                        i.y = pData->vy;
+                        i.u = pData->tx / 65535.F;
+                        i.v = pData->ty / 65535.F;
+                        ++pData;
+                    }
+                    switch (primitive->type)
+                    {
+                    case GL_TRIANGLES:
+                        raster->addTriangles(softwareVertices.data(), softwareVertices.size(), state);
+                        break;
+                    case GL_TRIANGLE_STRIP:
+                        raster->addTriangleStrip(softwareVertices.data(), softwareVertices.size(), state);
+                        break;
+                    default: break;
+                    }
+                    ++drawCount;
+                }
+                raster->end();
+
+                image = Image::Image::create(Image::Info(size, Image::Type::RGBA_U8));
+                raster->copy(*image);
+            }
+
+            const Software::Texture* Render2D::Private::getSoftwareTexture(const Image::Data& data, const OCIO::Convert& colorSpace)
+            {
+                const auto key = std::make_pair(data.getUID(), colorSpace);
+                const auto i = softwareTextureCache.find(key);
+                if (i != softwareTextureCache.end())
+                {
+                    i->second.frame = frameCount;
+                    return i->second.texture.get();
+                }
+                SoftwareTexture softwareTexture;
+                softwareTexture.texture = Software::Texture::create(data);
+                softwareTexture.frame = frameCount;
+                if (colorSpace.isValid())
+                {
+                    try
+                    {
+                        auto config = _OCIO::GetCurrentConfig();
+                        auto processor = config->getProcessor(colorSpace.input.c_str(), colorSpace.output.c_str());
+                        _OCIO::PackedImageDesc imageDesc(
+                            softwareTexture.texture->getData(),
+                            softwareTexture.texture->getWidth(),
+                            softwareTexture.texture->getHeight(),
+                            4);
+                        processor->apply(imageDesc);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        system->_log(e.what());
+                    }
+                }
+                softwareTextureCache[key] = softwareTexture;
+                softwareTextureCacheByteCount += softwareTexture.texture->getDataByteCount();
+                return softwareTexture.texture.get();
+            }
+
+            GLuint Render2D::Private::getTileTexture(const std::shared_ptr<Image::Image>& image)
+            {
+                const UID uid = image->getUID();
+                auto i = tileTextureCache.find(uid);
+                if (i == tileTextureCache.end())
+                {
+                    TileTexture tileTexture;
+                    if (tileTextures.size())
+                    {
+                        tileTexture.texture = tileTextures.back();
+                        tileTextures.pop_back();
+                        tileTexture.texture->set(image->getInfo());
+                    }
+                    else
+                    {
+                        tileTexture.texture = OpenGL::Texture::create(
+                            image->getInfo(),
+                            toGL(imageFilterOptions.min),
+                            toGL(imageFilterOptions.mag));
+                    }
+                    pixelBuffers->copy(*image, *tileTexture.texture);
+                    i = tileTextureCache.insert(std::make_pair(uid, tileTexture)).first;
+                }
+                i->second.frame = frameCount;
+                return i->second.texture->getID();
+            }
+
             void Render2D::Private::drawImage(
                 const std::shared_ptr<Image::Image>& image,
                 const glm::vec2& pos,
@@ -1512,9 +2076,15 @@ namespace djv
                 ColorMode colorMode,
                 const glm::mat3x3& currentTransform,
                 const BBox2f& currentClipRect,
-                const float finalColor[4])
+                const float finalColor[4],
+                bool tile)
             {
                 const auto& info = image->getInfo();
+                if (info.size.w > tiledImageSize || info.size.h > tiledImageSize)
+                {
+                    drawTiledImage(image, pos, options, colorMode, currentTransform, currentClipRect, finalColor);
+                    return;
+                }
 
                 static glm::vec3 pts[4];
                 pts[0].x = pos.x;
@@ -1547,8 +2117,7 @@ namespace djv
 
                 if (bbox.intersects(currentClipRect))
                 {
-                    auto primitive = new ImagePrimitive;
-                    primitives.push_back(primitive);
+                    auto primitive = primitives.create<ImagePrimitive>();
                     primitive->clipRect = currentClipRect;
                     primitive->imageChannels = Image::getChannels(info.type);
                     primitive->colorMode = colorMode;
@@ -1586,7 +2155,7 @@ namespace djv
                     FloatRange textureU;
                     FloatRange textureV;
                     const UID uid = image->getUID();
-                    switch (options.cache)
+                    switch (Backend::Software == backend ? ImageCache::Dynamic : options.cache)
                     {
                     case ImageCache::Atlas:
                     {
@@ -1624,27 +2193,51 @@ namespace djv
                     }
                     case ImageCache::Dynamic:
                     {
-                        const auto i = dynamicTextureCache.find(uid);
-                        if (i != dynamicTextureCache.end())
+                        switch (backend)
                         {
-                            primitive->textureID = i->second->getID();
-                        }
-                        else
+                        case Backend::OpenGL:
                         {
-                            std::shared_ptr<OpenGL::Texture> texture;
-                            if (dynamicTextures.size())
+                            if (tile)
+                            {
+                                primitive->textureID = getTileTexture(image);
+                                break;
+                            }
+                            const auto i = dynamicTextureCache.find(uid);
+                            if (i != dynamicTextureCache.end())
                             {
-                                texture = dynamicTextures.back();
-                                dynamicTextures.pop_back();
-                                texture->set(image->getInfo());
+                                primitive->textureID = i->second->getID();
                             }
                             else
                             {
-                                texture = OpenGL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
+                                std::shared_ptr<OpenGL::Texture> texture;
+                                if (dynamicTextures.size())
+                                {
+                                    texture = dynamicTextures.back();
+                                    dynamicTextures.pop_back();
+                                    texture->set(image->getInfo());
+                                }
+                                else
+                                {
+                                    texture = OpenGL::Texture::create(image->getInfo(), GL_LINEAR, GL_NEAREST);
+                                }
+                                pixelBuffers->copy(*image, *texture);
+                                dynamicTextureCache[uid] = texture;
+                                primitive->textureID = texture->getID();
                             }
-                            texture->copy(*image);
-                            dynamicTextureCache[uid] = texture;
-                            primitive->textureID = texture->getID();
+                            break;
+                        }
+                        case Backend::Software:
+                            // The color space conversion is applied to the
+                            // texture when it is created.
+                            primitive->softwareTexture = getSoftwareTexture(*image, options.colorSpace);
+                            if (ImageCache::Dynamic == options.cache)
+                            {
+                                primitive->softwareFilter = bbox.w() < info.size.w || bbox.h() < info.size.h ?
+                                    imageFilterOptions.min :
+                                    imageFilterOptions.mag;
+                            }
+                            break;
+                        default: break;
                         }
                         if (info.layout.mirror.x)
                         {
@@ -1681,7 +2274,7 @@ namespace djv
                         textureV.max = 1.F - textureV.max;
                     }
 #if !defined(DJV_OPENGL_ES2)
-                    if (options.colorSpace.isValid())
+                    if (Backend::OpenGL == backend && options.colorSpace.isValid())
                     {
                         ColorSpaceData colorSpaceData;
                         const auto i = colorSpaceCache.find(options.colorSpace);
@@ -1753,6 +2346,171 @@ namespace djv
                 }
             }
 
+            void Render2D::Private::drawTiledImage(
+                const std::shared_ptr<Image::Image>& image,
+                const glm::vec2& pos,
+                const ImageOptions& options,
+                ColorMode colorMode,
+                const glm::mat3x3& currentTransform,
+                const BBox2f& currentClipRect,
+                const float finalColor[4])
+            {
+                const auto& info = image->getInfo();
+                auto& tiledImage = tiledImages[image->getUID()];
+                if (!tiledImage.pyramid)
+                {
+                    tiledImage.pyramid = Image::Pyramid::create(image);
+                }
+                tiledImage.frame = frameCount;
+                const auto& pyramid = tiledImage.pyramid;
+
+                // Find the pyramid level from the scale of the transform.
+                const float scale = std::max(
+                    glm::length(glm::vec2(currentTransform[0])),
+                    glm::length(glm::vec2(currentTransform[1])));
+                const size_t level = pyramid->getLevel(scale);
+
+                // Find the area of the image that is visible.
+                const glm::mat3x3 inverse = glm::inverse(currentTransform);
+                const glm::vec3 clipPts[] =
+                {
+                    glm::vec3(currentClipRect.min.x, currentClipRect.min.y, 1.F),
+                    glm::vec3(currentClipRect.max.x, currentClipRect.min.y, 1.F),
+                    glm::vec3(currentClipRect.max.x, currentClipRect.max.y, 1.F),
+                    glm::vec3(currentClipRect.min.x, currentClipRect.max.y, 1.F)
+                };
+                BBox2f visible;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    const glm::vec3 pt = inverse * clipPts[i];
+                    const glm::vec2 imagePt(pt.x - pos.x, pt.y - pos.y);
+                    if (0 == i)
+                    {
+                        visible.min = visible.max = imagePt;
+                    }
+                    else
+                    {
+                        visible.expand(imagePt);
+                    }
+                }
+                const float w = static_cast<float>(info.size.w);
+                const float h = static_cast<float>(info.size.h);
+                const bool mirrorX = info.layout.mirror.x != options.mirror.x;
+                const bool mirrorY = info.layout.mirror.y != options.mirror.y;
+                if (mirrorX)
+                {
+                    visible = BBox2f(glm::vec2(w - visible.max.x, visible.min.y), glm::vec2(w - visible.min.x, visible.max.y));
+                }
+                if (mirrorY)
+                {
+                    visible = BBox2f(glm::vec2(visible.min.x, h - visible.max.y), glm::vec2(visible.max.x, h - visible.min.y));
+                }
+                if (visible.max.x <= 0.F || visible.max.y <= 0.F || visible.min.x >= w || visible.min.y >= h)
+                {
+                    return;
+                }
+
+                // Find the tiles that are available. Tiles that are not available
+                // are requested and replaced with a tile from a lower resolution
+                // level until they have been built.
+                struct Tile
+                {
+                    std::shared_ptr<Image::Image> image;
+                    size_t level;
+                    uint32_t x;
+                    uint32_t y;
+                };
+                auto isAvailable = [this](const std::shared_ptr<Image::Image>& tile)
+                {
+                    bool out = tile.get();
+                    if (out && Backend::OpenGL == backend && tileTextureCache.find(tile->getUID()) == tileTextureCache.end())
+                    {
+                        out = tileUploadCount < tileUploadMax;
+                        if (out)
+                        {
+                            ++tileUploadCount;
+                        }
+                    }
+                    return out;
+                };
+                const float tileSize = pyramid->getTileSize() * static_cast<float>(1 << level);
+                const Image::Size tileCount = pyramid->getTileCount(level);
+                const uint32_t x0 = static_cast<uint32_t>(std::max(visible.min.x, 0.F) / tileSize);
+                const uint32_t y0 = static_cast<uint32_t>(std::max(visible.min.y, 0.F) / tileSize);
+                const uint32_t x1 = std::min(static_cast<uint32_t>(std::min(visible.max.x, w - 1.F) / tileSize), tileCount.w - 1);
+                const uint32_t y1 = std::min(static_cast<uint32_t>(std::min(visible.max.y, h - 1.F) / tileSize), tileCount.h - 1);
+                std::vector<Tile> tiles;
+                std::vector<Tile> fallbackTiles;
+                std::set<std::tuple<size_t, uint32_t, uint32_t> > fallbackKeys;
+                for (uint32_t y = y0; y <= y1; ++y)
+                {
+                    for (uint32_t x = x0; x <= x1; ++x)
+                    {
+                        const auto tile = pyramid->getTile(level, x, y);
+                        if (isAvailable(tile))
+                        {
+                            tiles.push_back({ tile, level, x, y });
+                        }
+                        else
+                        {
+                            ++pendingTileCount;
+                            for (size_t l = level + 1; l < pyramid->getLevelCount(); ++l)
+                            {
+                                const uint32_t fallbackX = x >> (l - level);
+                                const uint32_t fallbackY = y >> (l - level);
+                                if (!fallbackKeys.insert(std::make_tuple(l, fallbackX, fallbackY)).second)
+                                {
+                                    break;
+                                }
+                                const auto fallbackTile = pyramid->getTile(l, fallbackX, fallbackY, false);
+                                if (isAvailable(fallbackTile))
+                                {
+                                    fallbackTiles.push_back({ fallbackTile, l, fallbackX, fallbackY });
+                                    break;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                // Draw the lower resolution tiles first.
+                std::sort(
+                    fallbackTiles.begin(),
+                    fallbackTiles.end(),
+                    [](const Tile& a, const Tile& b)
+                    {
+                        return a.level > b.level;
+                    });
+                tiles.insert(tiles.begin(), fallbackTiles.begin(), fallbackTiles.end());
+                ImageOptions tileOptions = options;
+                tileOptions.mirror.x = mirrorX;
+                tileOptions.mirror.y = mirrorY;
+                tileOptions.cache = ImageCache::Dynamic;
+                for (const auto& tile : tiles)
+                {
+                    const float levelScale = static_cast<float>(1 << tile.level);
+                    const float tileX = tile.x * pyramid->getTileSize() * levelScale;
+                    const float tileY = tile.y * pyramid->getTileSize() * levelScale;
+                    const Image::Size& size = tile.image->getSize();
+                    const float tileW = std::min(size.w * levelScale, w - tileX);
+                    const float tileH = std::min(size.h * levelScale, h - tileY);
+                    glm::mat3x3 m(1.F);
+                    m[0][0] = tileW / static_cast<float>(size.w);
+                    m[1][1] = tileH / static_cast<float>(size.h);
+                    m[2][0] = pos.x + (mirrorX ? (w - tileX - tileW) : tileX);
+                    m[2][1] = pos.y + (mirrorY ? (h - tileY - tileH) : tileY);
+                    drawImage(
+                        tile.image,
+                        glm::vec2(0.F, 0.F),
+                        tileOptions,
+                        colorMode,
+                        currentTransform * m,
+                        currentClipRect,
+                        finalColor,
+                        true);
+                }
+            }
+
             std::string Render2D::Private::getFragmentSource() const
             {
                 std::string out = fragmentSource;
@@ -1823,6 +2581,12 @@ namespace djv
         DJV_TEXT("Nearest"),
         DJV_TEXT("Linear"));
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        AV::Render,
+        Backend,
+        DJV_TEXT("OpenGL"),
+        DJV_TEXT("Software"));
+
     picojson::value toJSON(AV::Render::ImageFilter value)
     {
         std::stringstream ss;
@@ -185,20 +185,43 @@ namespace djv
                 bool operator != (const ImageFilterOptions&) const;
             };
 
+            //! This enumeration provides the renderer backends.
+            enum class Backend
+            {
+                OpenGL,
+                Software,
+
+                Count,
+                First = OpenGL
+            };
+            DJV_ENUM_HELPERS(Backend);
+
             //! This class provides a 2D renderer.
+            //!
+            //! The OpenGL backend draws into the current OpenGL frame buffer. The
+            //! software backend rasterizes the frame on the CPU and does not make
+            //! any OpenGL calls, the result is available from getImage().
             class Render2D : public Core::ISystem
             {
                 DJV_NON_COPYABLE(Render2D);
 
             protected:
-                void _init(const std::shared_ptr<Core::Context>&);
+                void _init(const std::shared_ptr<Core::Context>&, Backend);
                 Render2D();
 
             public:
                 ~Render2D();
 
+                //! Create a new renderer with the OpenGL backend.
                 static std::shared_ptr<Render2D> create(const std::shared_ptr<Core::Context>&);
 
+                //! Create a new renderer with the given backend. Applications
+                //! that run without a display should create the renderer with
+                //! the software backend before it is requested from the context.
+                static std::shared_ptr<Render2D> create(const std::shared_ptr<Core::Context>&, Backend);
+
+                Backend getBackend() const;
+
                 //! \name Begin and End
                 ///@{
 
@@ -256,6 +279,11 @@ namespace djv
                 //! This function should only be called outside of beginFrame()/endFrame().
                 void setImageFilterOptions(const ImageFilterOptions&);
 
+                //! Images that are larger than the maximum texture size are drawn
+                //! from a tiled image pyramid. Only the tiles that are visible are
+                //! drawn, using the pyramid level that matches the current
+                //! transform. Tiles that are still being built are replaced with
+                //! tiles from a lower resolution level.
                 void drawImage(
                     const std::shared_ptr<Image::Image> &,
                     const glm::vec2& pos,
@@ -286,6 +314,25 @@ namespace djv
 
                 ///@}
 
+                //! \name Batching
+                ///@{
+
+                //! Set whether consecutive primitives that share the same state
+                //! are merged into a single draw call.
+                void setBatchingEnabled(bool);
+                bool isBatchingEnabled() const;
+
+                ///@}
+
+                //! \name Software Rendering
+                ///@{
+
+                //! Get the image rendered by the last frame with the software
+                //! backend. A new image is created for each frame.
+                std::shared_ptr<Image::Image> getImage() const;
+
+                ///@}
+
                 //! \name Diagnostics
                 ///@{
 
@@ -293,9 +340,24 @@ namespace djv
                 size_t getDynamicTextureCount() const;
                 size_t getVBOSize() const;
 
+                //! These functions return the statistics for the last frame.
+                size_t getPrimitiveCount() const;
+                size_t getDrawCount() const;
+                size_t getStateChangeCount() const;
+                size_t getVertexCount() const;
+
+                //! These functions return the dynamic texture upload statistics.
+                size_t getTextureUploadCount() const;
+                float getTextureUploadTime() const;
+
+                //! Get the number of image tiles that were not available for the
+                //! last frame. The frame should be redrawn while this is non-zero.
+                size_t getPendingTileCount() const;
+
                 ///@}
 
             private:
+                void _drawRects(const Core::BBox2f*, size_t);
                 void _updateCurrentTransform();
                 void _updateCurrentClipRect();
                 void _updateImageFilter();
@@ -320,6 +382,7 @@ namespace djv
     DJV_ENUM_SERIALIZE_HELPERS(AV::Render::ImageChannel);
     DJV_ENUM_SERIALIZE_HELPERS(AV::Render::ImageCache);
     DJV_ENUM_SERIALIZE_HELPERS(AV::Render::ImageFilter);
+    DJV_ENUM_SERIALIZE_HELPERS(AV::Render::Backend);
 
     picojson::value toJSON(AV::Render::ImageFilter);
     picojson::value toJSON(const AV::Render::ImageFilterOptions&);
@@ -30,6 +30,7 @@
 #include <djvAV/SequenceIO.h>
 
 #include <djvAV/ImageConvert.h>
+#include <djvAV/OCIOProcessor.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/FileSystem.h>
@@ -43,6 +44,7 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <deque>
 #include <future>
 
 using namespace djv::Core;
@@ -58,12 +60,57 @@ namespace djv
                 //! \todo Should this be configurable?
                 const double infoTimeout = 0.5;
 
+                std::shared_ptr<OCIO::Processor> createColorProcessor(
+                    const OCIO::Convert& convert,
+                    const std::string& fileName,
+                    const std::shared_ptr<LogSystem>& logSystem)
+                {
+                    std::shared_ptr<OCIO::Processor> out;
+                    if (convert.isValid() && convert.input != convert.output)
+                    {
+                        try
+                        {
+                            out = OCIO::Processor::create(convert);
+                            if (out->isNoOp())
+                            {
+                                out.reset();
+                            }
+                        }
+                        catch (const std::exception& e)
+                        {
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << fileName << "' " <<
+                                DJV_TEXT("cannot be converted from") << " '" << convert.input << "' " <<
+                                DJV_TEXT("to") << " '" << convert.output << "'. " << e.what();
+                            logSystem->log("djv::AV::ISequenceIO", ss.str(), LogLevel::Error);
+                        }
+                    }
+                    return out;
+                }
+
+                size_t getColorThreadCount(size_t threadCount)
+                {
+                    return std::max(
+                        static_cast<size_t>(std::thread::hardware_concurrency()) / std::max(threadCount, static_cast<size_t>(1)),
+                        static_cast<size_t>(1));
+                }
+
+                struct WriteTask
+                {
+                    std::string fileName;
+                    bool error = false;
+                    std::string errorString;
+                    std::atomic<bool> done;
+                    std::future<void> future;
+                };
+
             } // namespace
 
             struct ISequenceRead::Future
             {
                 Frame::Number frame = Frame::invalid;
                 std::shared_ptr<Image::Image> image;
+                VideoFrameTimes times;
             };
 
             struct ISequenceRead::Private
@@ -71,12 +118,16 @@ namespace djv
                 Frame::Number frame = Frame::invalid;
                 std::promise<Info> infoPromise;
                 std::vector<std::future<Future> > cacheFutures;
-                std::condition_variable queueCV;
                 Direction direction = Direction::Forward;
                 Frame::Number seek = Frame::invalid;
                 std::thread thread;
                 std::atomic<bool> running;
                 std::chrono::system_clock::time_point infoTimer;
+                size_t queueCount = 0;
+                std::shared_ptr<OCIO::Processor> colorProcessor;
+                std::chrono::high_resolution_clock::time_point prefetchTimer;
+                FileSystem::FileNameTemplate fileNameTemplate;
+                size_t colorThreadCount = 1;
             };
 
             void ISequenceRead::_init(
@@ -87,6 +138,10 @@ namespace djv
             {
                 IRead::_init(fileInfo, options, resourceSystem, logSystem);
                 _speed = Time::Speed();
+                _p->colorProcessor = createColorProcessor(
+                    OCIO::Convert(options.colorSpace, options.outputColorSpace),
+                    fileInfo.getFileName(),
+                    logSystem);
                 _p->running = true;
                 _p->thread = std::thread(
                     [this]
@@ -100,6 +155,7 @@ namespace djv
                     {
                         _sequence = _fileInfo.getSequence();
                         sequenceSize = _sequence.getSize();
+                        p.fileNameTemplate = FileSystem::FileNameTemplate(_fileInfo);
                         if (sequenceSize)
                         {
                             p.frame = 0;
@@ -140,7 +196,7 @@ namespace djv
 
                     // Start looping...
                     p.infoTimer = std::chrono::system_clock::now();
-                    const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                    p.prefetchTimer = std::chrono::high_resolution_clock::now();
                     while (p.running)
                     {
                         // Update the options.
@@ -149,14 +205,53 @@ namespace djv
                         InOutPoints inOutPoints;
                         bool cacheEnabled = false;
                         size_t cacheMaxByteCount = 0;
+                        bool prefetchAdaptive = false;
+                        PrefetchDecision prefetchDecision;
                         {
                             std::lock_guard<std::mutex> lock(_mutex);
                             threadCount = _threadCount;
+                            p.colorThreadCount = getColorThreadCount(threadCount);
                             playback = _playback;
                             inOutPoints = _inOutPoints;
                             cacheEnabled = _cacheEnabled;
                             cacheMaxByteCount = _cacheMaxByteCount;
+                            prefetchAdaptive = _prefetchAdaptive;
+
+                            // Update the prefetch controller with the frames that
+                            // have been consumed since the last update.
+                            const size_t count = _videoQueue.getCount();
+                            if (playback)
+                            {
+                                if (p.queueCount > count)
+                                {
+                                    _prefetch.addConsumed(p.queueCount - count);
+                                }
+                                if (p.queueCount > 0 && 0 == count && !_videoQueue.isFinished())
+                                {
+                                    _prefetch.addUnderrun();
+                                }
+                            }
+                            p.queueCount = count;
+                            _prefetch.setLimits(threadCount, _options.videoQueueSize);
+                            if (info.video.size() && _options.layer < info.video.size())
+                            {
+                                _prefetch.setSpeed(playback ? info.video[_options.layer].speed.toFloat() : 0.F);
+                            }
+                            const auto now = std::chrono::high_resolution_clock::now();
+                            const std::chrono::duration<float> delta = now - p.prefetchTimer;
+                            p.prefetchTimer = now;
+                            _prefetch.tick(delta.count());
+                            prefetchDecision = _prefetch.getDecision();
+
+                            const size_t videoQueueSize = prefetchAdaptive ?
+                                prefetchDecision.queueSize :
+                                _options.videoQueueSize;
+                            if (videoQueueSize != _videoQueue.getMax())
+                            {
+                                _videoQueue.setMax(videoQueueSize);
+                            }
                         }
+                        _cache.setReadBehind(prefetchAdaptive ? prefetchDecision.readBehind : PrefetchDecision().readBehind);
                         if (!cacheEnabled)
                         {
                             _cache.clear();
@@ -173,25 +268,33 @@ namespace djv
                             _cache.setMax(0);
                         }
 
-                        // Check to see if there is work to be done.
+                        // Check to see if there is work to be done. The video queue
+                        // wakes us when frames are consumed or the options change, so
+                        // the timeout only needs to be short when filling the cache.
+                        const auto timeout = Time::getMilliseconds(cacheEnabled ?
+                            Time::TimerValue::VeryFast :
+                            Time::TimerValue::Medium);
                         size_t queueCount = 0;
                         Frame::Number seek = Frame::invalid;
                         {
                             std::unique_lock<std::mutex> lock(_mutex);
-                            if (p.queueCV.wait_for(
+                            if (_videoQueue.wait(
                                 lock,
-                                std::chrono::milliseconds(timeout),
+                                timeout,
                                 [this]
                                 {
-                                    return _hasWork();
+                                    return _hasWork() || !_p->running;
                                 }))
                             {
-                                queueCount = _getQueueCount(playback ? (threadCount / 2) : 1);
+                                queueCount = _getQueueCount(
+                                    prefetchAdaptive ? prefetchDecision.threadCount :
+                                    (playback ? (threadCount / 2) : 1));
                                 if (p.direction != _direction)
                                 {
                                     p.direction = _direction;
                                     _videoQueue.setFinished(false);
                                     _videoQueue.clearFrames();
+                                    p.queueCount = 0;
                                 }
                                 if (p.seek != Frame::invalid)
                                 {
@@ -199,6 +302,7 @@ namespace djv
                                     p.seek = Frame::invalid;
                                     _videoQueue.setFinished(false);
                                     _videoQueue.clearFrames();
+                                    p.queueCount = 0;
                                 }
                             }
                         }
@@ -222,7 +326,15 @@ namespace djv
                         // Fill the cache.
                         if (cacheEnabled)
                         {
-                            _readCache(playback ? (threadCount / 2) : threadCount, inOutPoints);
+                            size_t cacheThreadCount = playback ? (threadCount / 2) : threadCount;
+                            if (prefetchAdaptive && playback)
+                            {
+                                // Give the cache the threads the queue does not need.
+                                cacheThreadCount = std::max(
+                                    threadCount > prefetchDecision.threadCount ? (threadCount - prefetchDecision.threadCount) : 0,
+                                    static_cast<size_t>(1));
+                            }
+                            _readCache(cacheThreadCount, inOutPoints);
                         }
 
                         // Update information.
@@ -272,13 +384,17 @@ namespace djv
                     p.seek = value;
                     _direction = direction;
                 }
-                p.queueCV.notify_one();
+                _videoQueue.notify();
             }
 
             void ISequenceRead::_finish()
             {
                 DJV_PRIVATE_PTR();
-                p.running = false;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    p.running = false;
+                }
+                _videoQueue.notify();
                 if (p.thread.joinable())
                 {
                     //! \todo How do we safely detach the thread here so we don't block?
@@ -300,26 +416,50 @@ namespace djv
                 return std::min(queueMax, threadCount);
             }
 
-            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, std::string fileName)
+            std::future<ISequenceRead::Future> ISequenceRead::_getFuture(Frame::Number i, const std::string& fileName)
             {
+                const auto request = std::chrono::high_resolution_clock::now();
+                const size_t colorThreadCount = _p->colorThreadCount;
+
+                // The file name refers to the template buffer which is reused for
+                // the next frame, so it is passed as an argument to give the task
+                // a single copy of its own.
                 return std::async(
                     std::launch::async,
-                    [this, i, fileName]
+                    [this, i, request, colorThreadCount](const std::string& fileName)
                     {
                         Future out;
                         out.frame = i;
+                        out.times.request = request;
                         try
                         {
+                            out.times.decodeStart = std::chrono::high_resolution_clock::now();
                             out.image = _readImage(fileName);
+                            if (out.image && _p->colorProcessor)
+                            {
+                                _p->colorProcessor->process(*out.image, colorThreadCount);
+                            }
+                            out.times.decodeEnd = std::chrono::high_resolution_clock::now();
+                            const uint64_t byteCount = isStatsEnabled() ? FileSystem::FileInfo(fileName).getSize() : 0;
+                            const std::chrono::duration<float> wait = out.times.decodeStart - out.times.request;
+                            const std::chrono::duration<float> read = out.times.decodeEnd - out.times.decodeStart;
+                            std::lock_guard<std::mutex> lock(_mutex);
+                            ++_stats.readCount;
+                            _stats.readByteCount += byteCount;
+                            _prefetch.addRead(wait.count(), read.count());
                         }
                         catch (const std::exception& e)
                         {
-                            std::stringstream ss;
-                            ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
-                            _logSystem->log("djv::AV::ISequenceRead", ss.str(), LogLevel::Error);
+                            if (_logSystem->isEnabled(LogLevel::Error))
+                            {
+                                std::stringstream ss;
+                                ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
+                                _logSystem->log("djv::AV::ISequenceRead", ss.str(), LogLevel::Error);
+                            }
                         }
                         return out;
-                    });
+                    },
+                    fileName);
             }
 
             size_t ISequenceRead::_readQueue(size_t count, bool cacheEnabled)
@@ -328,14 +468,19 @@ namespace djv
 
                 // Get frames to be added to the queue.
                 const size_t sequenceSize = _sequence.getSize();
-                std::vector<std::pair<Frame::Number, std::shared_ptr<Image::Image> > > images;
+                std::vector<VideoFrame> frames;
                 std::vector<std::future<Future> > futures;
+                size_t cacheHitCount = 0;
                 for (size_t i = 0; i < count; ++i)
                 {
                     std::shared_ptr<Image::Image> cachedImage;
                     if (cacheEnabled && _cache.get(p.frame, cachedImage))
                     {
-                        images.push_back(std::make_pair(p.frame, cachedImage));
+                        VideoFrameTimes times;
+                        times.request = std::chrono::high_resolution_clock::now();
+                        times.cached = true;
+                        frames.push_back(VideoFrame(p.frame, cachedImage, times));
+                        ++cacheHitCount;
                     }
                     else
                     {
@@ -344,14 +489,12 @@ namespace djv
                             if (p.frame >= 0 && p.frame < sequenceSize)
                             {
                                 const Frame::Number frameNumber = _sequence.getFrame(p.frame);
-                                const std::string fileName = _fileInfo.getFileName(frameNumber);
-                                futures.push_back(_getFuture(p.frame, fileName));
+                                futures.push_back(_getFuture(p.frame, p.fileNameTemplate.get(frameNumber)));
                             }
                         }
                         else
                         {
-                            const std::string fileName = _fileInfo.getFileName();
-                            futures.push_back(_getFuture(p.frame, fileName));
+                            futures.push_back(_getFuture(p.frame, _fileInfo.getFileName()));
                         }
                     }
 
@@ -384,7 +527,7 @@ namespace djv
                     const auto result = future.get();
                     if (result.image)
                     {
-                        images.push_back(std::make_pair(result.frame, result.image));
+                        frames.push_back(VideoFrame(result.frame, result.image, result.times));
                         if (cacheEnabled)
                         {
 #if defined(DJV_MMAP)
@@ -398,14 +541,17 @@ namespace djv
                 // Add the frames to the queue.
                 {
                     std::lock_guard<std::mutex> lock(_mutex);
-                    for (const auto& i : images)
+                    _stats.cacheHitCount += cacheHitCount;
+                    _stats.cacheMissCount += futures.size();
+                    for (const auto& i : frames)
                     {
                         if (_videoQueue.getCount() >= _videoQueue.getMax())
                         {
                             break;
                         }
-                        _videoQueue.addFrame(VideoFrame(i.first, i.second));
+                        _videoQueue.addFrame(i);
                     }
+                    p.queueCount = _videoQueue.getCount();
                 }
 
                 if (Frame::invalid == p.frame || p.frame < 0 || p.frame >= static_cast<Frame::Number>(sequenceSize))
@@ -454,8 +600,7 @@ namespace djv
                         {
                             if (!_cache.contains(frame))
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, p.fileNameTemplate.get(_sequence.getFrame(frame))));
                             }
                             ++frame;
                             if (frame > range.max)
@@ -480,8 +625,7 @@ namespace djv
                         {
                             if (!_cache.contains(frame))
                             {
-                                const std::string fileName = _fileInfo.getFileName(_sequence.getFrame(frame));
-                                p.cacheFutures.push_back(_getFuture(frame, fileName));
+                                p.cacheFutures.push_back(_getFuture(frame, p.fileNameTemplate.get(_sequence.getFrame(frame))));
                             }
                             --frame;
                             if (frame < range.min)
@@ -522,9 +666,12 @@ namespace djv
             struct ISequenceWrite::Private
             {
                 FileSystem::FileInfo fileInfo;
+                FileSystem::FileNameTemplate fileNameTemplate;
                 Frame::Number frameNumber = Frame::invalid;
                 GLFWwindow * glfwWindow = nullptr;
                 std::shared_ptr<Image::Convert> convert;
+                std::shared_ptr<OCIO::Processor> colorProcessor;
+                Image::ResampleFilter resampleFilter = Image::ResampleFilter::Mitchell;
                 std::thread thread;
                 std::atomic<bool> running;
             };
@@ -540,6 +687,12 @@ namespace djv
 
                 DJV_PRIVATE_PTR();
 
+                p.colorProcessor = createColorProcessor(
+                    OCIO::Convert(options.inputColorSpace, options.colorSpace),
+                    fileInfo.getFileName(),
+                    logSystem);
+                p.resampleFilter = options.resampleFilter;
+
                 _info = info;
                 if (_info.video.size())
                 {
@@ -547,13 +700,14 @@ namespace djv
                 }
 
                 p.fileInfo = fileInfo;
+                p.fileNameTemplate = FileSystem::FileNameTemplate(fileInfo);
                 if (p.fileInfo.isSequenceValid())
                 {
                     auto sequence = p.fileInfo.getSequence();
-                    if (sequence.ranges.size())
+                    if (sequence.getRanges().size())
                     {
                         sequence.sort();
-                        p.frameNumber = sequence.ranges[0].min;
+                        p.frameNumber = sequence.getRanges()[0].min;
                     }
                 }
 
@@ -600,99 +754,158 @@ namespace djv
                         }
 
                         p.convert = Image::Convert::create(_resourceSystem);
+                        p.convert->setResampleEnabled(true);
+                        p.convert->setResampleFilter(p.resampleFilter);
+                        size_t resampleThreadCount = 0;
+
+                        // Each frame is converted as soon as it arrives and then
+                        // written by a task. The number of writes in flight is
+                        // limited by the thread count, and the results are
+                        // reported in the order the frames were received.
+                        std::deque<std::shared_ptr<WriteTask> > tasks;
+                        auto getResult = [this, &tasks]
+                        {
+                            const auto task = tasks.front();
+                            tasks.pop_front();
+                            task->future.get();
+                            if (task->error)
+                            {
+                                std::stringstream ss;
+                                ss << DJV_TEXT("The file") << " '" << task->fileName << "' " <<
+                                    DJV_TEXT("cannot be written") << ". " << task->errorString;
+                                _logSystem->log("djv::AV::ISequenceWrite", ss.str(), LogLevel::Error);
+                                _p->running = false;
+                            }
+                        };
+                        auto isResultReady = [&tasks]
+                        {
+                            return tasks.size() && tasks.front()->done;
+                        };
 
-                        const auto timeout = Time::getValue(Time::TimerValue::VeryFast);
+                        const auto timeout = Time::getMilliseconds(Time::TimerValue::Medium);
                         while (p.running)
                         {
-                            std::vector<std::shared_ptr<Image::Image> > images;
+                            size_t threadCount = 1;
+                            {
+                                std::lock_guard<std::mutex> lock(_mutex);
+                                threadCount = _threadCount;
+                            }
+                            const size_t window = std::max(threadCount, static_cast<size_t>(1));
+
+                            // The conversions share the processors with the writes
+                            // in flight.
+                            const size_t convertThreadCount = getColorThreadCount(window);
+                            if (convertThreadCount != resampleThreadCount)
+                            {
+                                resampleThreadCount = convertThreadCount;
+                                p.convert->setResampleThreadCount(resampleThreadCount);
+                            }
+                            while (tasks.size() >= window || isResultReady())
+                            {
+                                getResult();
+                            }
+                            if (!p.running)
+                            {
+                                break;
+                            }
+
+                            std::shared_ptr<Image::Image> image;
+                            bool finished = false;
                             {
-                                std::unique_lock<std::mutex> lock(_mutex, std::try_to_lock);
-                                if (lock.owns_lock())
+                                std::unique_lock<std::mutex> lock(_mutex);
+                                if (_videoQueue.wait(
+                                    lock,
+                                    timeout,
+                                    [this, &isResultReady]
+                                    {
+                                        return !_videoQueue.isEmpty() || _videoQueue.isFinished() || !_p->running || isResultReady();
+                                    }))
                                 {
-                                    while (!_videoQueue.isEmpty() && images.size() < _threadCount)
+                                    if (!_videoQueue.isEmpty())
                                     {
-                                        auto frame = _videoQueue.popFrame();
-                                        images.push_back(frame.image);
+                                        image = _videoQueue.popFrame().image;
                                     }
-                                    if (_videoQueue.isEmpty() && _videoQueue.isFinished())
+                                    else if (_videoQueue.isFinished())
                                     {
-                                        p.running = false;
+                                        finished = true;
                                     }
                                 }
                             }
-                            if (images.size())
+                            if (finished)
                             {
-                                struct Future
-                                {
-                                    std::string fileName;
-                                    bool error = false;
-                                    std::string errorString;
-                                };
-                                std::vector<std::future<Future> > futures;
-                                for (size_t i = 0; i < images.size(); ++i)
+                                break;
+                            }
+                            if (!image)
+                            {
+                                continue;
+                            }
+
+                            const std::string& fileName = p.fileNameTemplate.get(p.frameNumber);
+                            if (p.frameNumber != Frame::invalid)
+                            {
+                                ++p.frameNumber;
+                            }
+                            if (p.colorProcessor)
+                            {
+                                // Convert a copy since the image may be shared.
+                                auto tmp = Image::Image::create(image->getInfo());
+                                tmp->setTags(image->getTags());
+                                memcpy(tmp->getData(), image->getData(), std::min(tmp->getDataByteCount(), image->getDataByteCount()));
+                                p.colorProcessor->process(*tmp, convertThreadCount);
+                                image = tmp;
+                            }
+                            const Image::Type imageType = _getImageType(image->getType());
+                            if (Image::Type::None == imageType)
+                            {
+                                std::stringstream ss;
+                                ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be written") << ".";
+                                throw FileSystem::Error(ss.str());
+                            }
+                            // Images that do not match the size of the file are
+                            // resampled.
+                            const Image::Size imageSize = _imageInfo.isValid() ? _imageInfo.size : image->getSize();
+                            const Image::Layout imageLayout = _getImageLayout();
+                            if (imageType != image->getType() || imageLayout != image->getLayout() || imageSize != image->getSize())
+                            {
+                                const Image::Info info(imageSize, imageType, imageLayout);
+                                auto tmp = Image::Image::create(info);
+                                tmp->setTags(image->getTags());
+                                p.convert->process(*image, info, *tmp);
+                                image = tmp;
+                            }
+                            auto task = std::make_shared<WriteTask>();
+                            task->fileName = fileName;
+                            task->done = false;
+                            // The task owns the future, so it is captured by pointer.
+                            WriteTask* taskP = task.get();
+                            task->future = std::async(
+                                std::launch::async,
+                                [this, taskP, image]
                                 {
-                                    const auto fileName = p.fileInfo.getFileName(p.frameNumber);
-                                    /*{
-                                        std::stringstream ss;
-                                        ss << "Writing: " << fileName;
-                                        _logSystem->log("djv::AV::IO::ISequenceWrite", ss.str());
-                                    }*/
-                                    if (p.frameNumber != Frame::invalid)
-                                    {
-                                        ++p.frameNumber;
-                                    }
-                                    auto image = images[i];
-                                    const Image::Type imageType = _getImageType(image->getType());
-                                    if (Image::Type::None == imageType)
+                                    try
                                     {
-                                        std::stringstream ss;
-                                        ss << DJV_TEXT("The file") << " '" << fileName << "' " << DJV_TEXT("cannot be written") << ".";
-                                        throw FileSystem::Error(ss.str());
+                                        _write(taskP->fileName, image);
                                     }
-                                    const Image::Layout imageLayout = _getImageLayout();
-                                    if (imageType != image->getType() || imageLayout != image->getLayout())
+                                    catch (const std::exception& e)
                                     {
-                                        const Image::Info info(image->getSize(), imageType, imageLayout);
-                                        auto tmp = Image::Image::create(info);
-                                        tmp->setTags(image->getTags());
-                                        p.convert->process(*image, info, *tmp);
-                                        image = tmp;
+                                        taskP->error = true;
+                                        taskP->errorString = e.what();
                                     }
-                                    futures.push_back(std::async(
-                                        std::launch::async,
-                                        [this, fileName, image]
-                                        {
-                                            Future out;
-                                            out.fileName = fileName;
-                                            try
-                                            {
-                                                _write(fileName, image);
-                                            }
-                                            catch (const std::exception& e)
-                                            {
-                                                out.error = true;
-                                                out.errorString = e.what();
-                                            }
-                                            return out;
-                                        }));
-                                }
-                                for (auto& future : futures)
-                                {
-                                    const auto result = future.get();
-                                    if (result.error)
+
+                                    // Wake the thread so the result is reported.
                                     {
-                                        std::stringstream ss;
-                                        ss << DJV_TEXT("The file") << " '" << result.fileName << "' " <<
-                                            DJV_TEXT("cannot be written") << ". " << result.errorString;
-                                        _logSystem->log("djv::AV::ISequenceWrite", ss.str(), LogLevel::Error);
-                                        p.running = false;
+                                        std::lock_guard<std::mutex> lock(_mutex);
+                                        taskP->done = true;
                                     }
-                                }
-                            }
-                            else
-                            {
-                                std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
-                            }
+                                    _videoQueue.notify();
+                                });
+                            tasks.push_back(task);
+                        }
+
+                        // Wait for the writes that are still in flight.
+                        while (tasks.size())
+                        {
+                            getResult();
                         }
 
                         p.convert.reset();
@@ -702,7 +915,12 @@ namespace djv
                         _logSystem->log("djv::AV::ISequenceWrite", e.what(), LogLevel::Error);
                     }
 
-                    p.running = false;
+                    // Signal the producers that are waiting on the queue.
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        p.running = false;
+                    }
+                    _videoQueue.notify();
                 });
             }
 
@@ -731,7 +949,11 @@ namespace djv
             void ISequenceWrite::_finish()
             {
                 DJV_PRIVATE_PTR();
-                p.running = false;
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    p.running = false;
+                }
+                _videoQueue.notify();
                 if (p.thread.joinable())
                 {
                     //! \todo How do we safely detach the thread here so we don't block?
@@ -72,7 +72,7 @@ namespace djv
                 bool _hasWork() const;
                 size_t _getQueueCount(size_t threadCount) const;
                 struct Future;
-                std::future<Future> _getFuture(Core::Frame::Number, std::string fileName);
+                std::future<Future> _getFuture(Core::Frame::Number, const std::string& fileName);
                 size_t _readQueue(size_t count, bool cacheEnabled);
                 void _readCache(size_t count, const AV::IO::InOutPoints&);
 
@@ -80,6 +80,11 @@ namespace djv
             };
 
             //! This class provides an interface for writing sequences.
+            //!
+            //! Frames are written as soon as they are added to the video queue.
+            //! Up to the thread count of files are written at the same time, and
+            //! errors are reported in frame order. The video queue is notified
+            //! when the writer stops running.
             class ISequenceWrite : public IWrite
             {
                 DJV_NON_COPYABLE(ISequenceWrite);
@@ -0,0 +1,715 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAV/SoftwareRaster.h>
+
+#include <djvAV/Pixel.h>
+
+#include <djvCore/Math.h>
+#include <djvCore/Memory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <thread>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define DJV_SOFTWARE_RASTER_SSE
+#include <xmmintrin.h>
+#endif // __SSE__
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Render
+        {
+            namespace Software
+            {
+                namespace
+                {
+                    //! \todo Should this be configurable?
+                    const int tileHeight = 32;
+
+                    //! This struct provides a triangle that has been set up for
+                    //! rasterization.
+                    struct Triangle
+                    {
+                        // Edge equations, a * x + b * y + c, which are positive
+                        // inside of the triangle.
+                        float  a[3];
+                        float  b[3];
+                        float  c[3];
+
+                        // Texture coordinate plane equations.
+                        float  u[3];
+                        float  v[3];
+
+                        // Bounding box in pixels, intersected with the clipping
+                        // rectangle.
+                        int    x0;
+                        int    y0;
+                        int    x1;
+                        int    y1;
+
+                        size_t state;
+                    };
+
+                    // Blend a pixel, dst = src * factor + dst * (1 - factor).
+                    inline void blendFactor(float* dst, const float* src, const float* factor)
+                    {
+#if defined(DJV_SOFTWARE_RASTER_SSE)
+                        const __m128 s = _mm_loadu_ps(src);
+                        const __m128 f = _mm_loadu_ps(factor);
+                        const __m128 d = _mm_loadu_ps(dst);
+                        _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(s, f), _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(1.F), f))));
+#else // DJV_SOFTWARE_RASTER_SSE
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            dst[i] = src[i] * factor[i] + dst[i] * (1.F - factor[i]);
+                        }
+#endif // DJV_SOFTWARE_RASTER_SSE
+                    }
+
+                    // Blend a pixel, dst = src + dst * (1 - src alpha).
+                    inline void blendPremultiplied(float* dst, const float* src)
+                    {
+#if defined(DJV_SOFTWARE_RASTER_SSE)
+                        const __m128 s = _mm_loadu_ps(src);
+                        const __m128 d = _mm_loadu_ps(dst);
+                        const __m128 a = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3));
+                        _mm_storeu_ps(dst, _mm_add_ps(s, _mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(1.F), a))));
+#else // DJV_SOFTWARE_RASTER_SSE
+                        const float a = 1.F - src[3];
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            dst[i] = src[i] + dst[i] * a;
+                        }
+#endif // DJV_SOFTWARE_RASTER_SSE
+                    }
+
+                    inline void blend(float* dst, const float* src, AlphaBlend alphaBlend)
+                    {
+                        switch (alphaBlend)
+                        {
+                        case AlphaBlend::None:
+                            dst[0] = src[0];
+                            dst[1] = src[1];
+                            dst[2] = src[2];
+                            dst[3] = src[3];
+                            break;
+                        case AlphaBlend::Straight:
+                        {
+                            const float factor[4] = { src[3], src[3], src[3], src[3] };
+                            blendFactor(dst, src, factor);
+                            break;
+                        }
+                        case AlphaBlend::Premultiplied:
+                            blendPremultiplied(dst, src);
+                            break;
+                        default: break;
+                        }
+                    }
+
+                    // Blend a span of pixels with a constant color.
+                    void blendSpan(float* dst, size_t size, const float* src, AlphaBlend alphaBlend)
+                    {
+                        switch (alphaBlend)
+                        {
+                        case AlphaBlend::None:
+                            for (size_t i = 0; i < size; ++i, dst += 4)
+                            {
+                                dst[0] = src[0];
+                                dst[1] = src[1];
+                                dst[2] = src[2];
+                                dst[3] = src[3];
+                            }
+                            break;
+                        case AlphaBlend::Straight:
+                        {
+                            const float factor[4] = { src[3], src[3], src[3], src[3] };
+                            for (size_t i = 0; i < size; ++i, dst += 4)
+                            {
+                                blendFactor(dst, src, factor);
+                            }
+                            break;
+                        }
+                        case AlphaBlend::Premultiplied:
+                            for (size_t i = 0; i < size; ++i, dst += 4)
+                            {
+                                blendPremultiplied(dst, src);
+                            }
+                            break;
+                        default: break;
+                        }
+                    }
+
+                    // The following functions match the fragment shader used by
+                    // the OpenGL renderer.
+
+                    void colorMatrixFunc(float* value, const glm::mat4x4& m)
+                    {
+                        const float tmp[4] = { value[0], value[1], value[2], 1.F };
+                        for (int i = 0; i < 3; ++i)
+                        {
+                            value[i] = tmp[0] * m[i][0] + tmp[1] * m[i][1] + tmp[2] * m[i][2] + tmp[3] * m[i][3];
+                        }
+                    }
+
+                    void levelsFunc(float* value, const ImageLevels& levels)
+                    {
+                        const float gamma = 1.F / levels.gamma;
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            float tmp = (value[i] - levels.inLow) / levels.inHigh;
+                            if (tmp >= 0.F)
+                            {
+                                tmp = powf(tmp, gamma);
+                            }
+                            value[i] = tmp * levels.outHigh + levels.outLow;
+                        }
+                    }
+
+                    void exposureFunc(float* value, const State& state)
+                    {
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            value[i] = std::max(0.F, value[i] - state.exposureD) * state.exposureV;
+                            if (value[i] > state.exposureK)
+                            {
+                                const float tmp = value[i] - state.exposureK;
+                                value[i] = state.exposureK + logf(tmp * state.exposureF + 1.F) / state.exposureF;
+                            }
+                            value[i] *= .332F;
+                        }
+                    }
+
+                    void softClipFunc(float* value, float softClip)
+                    {
+                        const float tmp = 1.F - softClip;
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            if (value[i] > tmp)
+                            {
+                                value[i] = tmp + (1.F - expf(-(value[i] - tmp) / softClip)) * softClip;
+                            }
+                        }
+                    }
+
+                    void shadeTexture(const State& state, float u, float v, float* out)
+                    {
+                        float t[4];
+                        state.texture->sample(u, v, state.filter, t);
+                        if (state.colorMatrixEnabled)
+                        {
+                            colorMatrixFunc(t, state.colorMatrix);
+                        }
+                        if (state.colorInvert)
+                        {
+                            t[0] = 1.F - t[0];
+                            t[1] = 1.F - t[1];
+                            t[2] = 1.F - t[2];
+                        }
+                        if (state.levelsEnabled)
+                        {
+                            levelsFunc(t, state.levels);
+                        }
+                        if (state.exposureEnabled)
+                        {
+                            exposureFunc(t, state);
+                        }
+                        if (state.softClip > 0.F)
+                        {
+                            softClipFunc(t, state.softClip);
+                        }
+                        switch (state.imageChannel)
+                        {
+                        case ImageChannel::Red:   t[1] = t[2] = t[0]; break;
+                        case ImageChannel::Green: t[0] = t[2] = t[1]; break;
+                        case ImageChannel::Blue:  t[0] = t[1] = t[2]; break;
+                        case ImageChannel::Alpha: t[0] = t[1] = t[2] = t[3]; break;
+                        default: break;
+                        }
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            out[i] = state.color[i] * t[i];
+                        }
+                    }
+
+                } // namespace
+
+                void Texture::_init(const Image::Data& data)
+                {
+                    const auto& info = data.getInfo();
+                    _w = info.size.w;
+                    _h = info.size.h;
+                    _data.resize(static_cast<size_t>(_w) * static_cast<size_t>(_h) * 4);
+                    const Image::DataType dataType = Image::getDataType(info.type);
+                    const size_t wordSize = Image::DataType::U10 == dataType ? 4 : Image::getByteCount(dataType);
+                    const bool swap = info.layout.endian != Memory::getEndian() && wordSize > 1;
+                    std::vector<uint8_t> tmp(swap ? info.getScanlineByteCount() : 0);
+                    for (uint32_t y = 0; y < _h; ++y)
+                    {
+                        const uint8_t* p = data.getData(y);
+                        if (swap)
+                        {
+                            Memory::endian(p, tmp.data(), tmp.size() / wordSize, wordSize);
+                            p = tmp.data();
+                        }
+                        Image::convert(
+                            p,
+                            info.type,
+                            _data.data() + static_cast<size_t>(y) * _w * 4,
+                            Image::Type::RGBA_F32,
+                            _w);
+                    }
+                }
+
+                Texture::Texture()
+                {}
+
+                std::shared_ptr<Texture> Texture::create(const Image::Data& data)
+                {
+                    auto out = std::shared_ptr<Texture>(new Texture);
+                    out->_init(data);
+                    return out;
+                }
+
+                uint32_t Texture::getWidth() const
+                {
+                    return _w;
+                }
+
+                uint32_t Texture::getHeight() const
+                {
+                    return _h;
+                }
+
+                float* Texture::getData()
+                {
+                    return _data.data();
+                }
+
+                const float* Texture::getData() const
+                {
+                    return _data.data();
+                }
+
+                size_t Texture::getDataByteCount() const
+                {
+                    return _data.size() * sizeof(float);
+                }
+
+                void Texture::sample(float u, float v, ImageFilter filter, float out[4]) const
+                {
+                    if (!_w || !_h)
+                    {
+                        out[0] = out[1] = out[2] = out[3] = 0.F;
+                        return;
+                    }
+                    const int w = static_cast<int>(_w);
+                    const int h = static_cast<int>(_h);
+                    switch (filter)
+                    {
+                    case ImageFilter::Nearest:
+                    {
+                        const int x = Math::clamp(static_cast<int>(floorf(u * w)), 0, w - 1);
+                        const int y = Math::clamp(static_cast<int>(floorf(v * h)), 0, h - 1);
+                        const float* p = _data.data() + (static_cast<size_t>(y) * w + x) * 4;
+                        out[0] = p[0];
+                        out[1] = p[1];
+                        out[2] = p[2];
+                        out[3] = p[3];
+                        break;
+                    }
+                    case ImageFilter::Linear:
+                    {
+                        const float fx = u * w - .5F;
+                        const float fy = v * h - .5F;
+                        const float x0f = floorf(fx);
+                        const float y0f = floorf(fy);
+                        const float tx = fx - x0f;
+                        const float ty = fy - y0f;
+                        const int x0 = Math::clamp(static_cast<int>(x0f), 0, w - 1);
+                        const int y0 = Math::clamp(static_cast<int>(y0f), 0, h - 1);
+                        const int x1 = Math::clamp(static_cast<int>(x0f) + 1, 0, w - 1);
+                        const int y1 = Math::clamp(static_cast<int>(y0f) + 1, 0, h - 1);
+                        const float* p00 = _data.data() + (static_cast<size_t>(y0) * w + x0) * 4;
+                        const float* p10 = _data.data() + (static_cast<size_t>(y0) * w + x1) * 4;
+                        const float* p01 = _data.data() + (static_cast<size_t>(y1) * w + x0) * 4;
+                        const float* p11 = _data.data() + (static_cast<size_t>(y1) * w + x1) * 4;
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            const float a = p00[i] + (p10[i] - p00[i]) * tx;
+                            const float b = p01[i] + (p11[i] - p01[i]) * tx;
+                            out[i] = a + (b - a) * ty;
+                        }
+                        break;
+                    }
+                    default: break;
+                    }
+                }
+
+                struct Raster::Private
+                {
+                    size_t                  threadCount     = 0;
+                    Image::Size             size;
+                    std::vector<float>      data;
+                    std::vector<State>      states;
+                    std::vector<Triangle>   triangles;
+                    size_t                  triangleCount   = 0;
+                };
+
+                void Raster::_init()
+                {
+                    setThreadCount(0);
+                }
+
+                Raster::Raster() :
+                    _p(new Private)
+                {}
+
+                Raster::~Raster()
+                {}
+
+                std::shared_ptr<Raster> Raster::create()
+                {
+                    auto out = std::shared_ptr<Raster>(new Raster);
+                    out->_init();
+                    return out;
+                }
+
+                void Raster::setThreadCount(size_t value)
+                {
+                    _p->threadCount = value > 0 ?
+                        value :
+                        std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+                }
+
+                size_t Raster::getThreadCount() const
+                {
+                    return _p->threadCount;
+                }
+
+                void Raster::begin(const Image::Size& size)
+                {
+                    DJV_PRIVATE_PTR();
+                    p.size = size;
+                    p.data.resize(static_cast<size_t>(size.w) * static_cast<size_t>(size.h) * 4);
+                    std::fill(p.data.begin(), p.data.end(), 0.F);
+                    p.states.clear();
+                    p.triangles.clear();
+                }
+
+                void Raster::addTriangles(const Vertex* vertices, size_t count, const State& state)
+                {
+                    _add(vertices, count, false, state);
+                }
+
+                void Raster::addTriangleStrip(const Vertex* vertices, size_t count, const State& state)
+                {
+                    _add(vertices, count, true, state);
+                }
+
+                void Raster::end()
+                {
+                    DJV_PRIVATE_PTR();
+                    p.triangleCount = p.triangles.size();
+                    const size_t tileCount = (static_cast<size_t>(p.size.h) + tileHeight - 1) / tileHeight;
+                    const size_t threadCount = std::min(p.threadCount, tileCount);
+                    if (p.triangles.size() && threadCount > 1)
+                    {
+                        std::vector<std::future<void> > futures;
+                        for (size_t i = 1; i < threadCount; ++i)
+                        {
+                            futures.push_back(std::async(
+                                std::launch::async,
+                                [this, i, threadCount]
+                                {
+                                    _rasterize(i, threadCount);
+                                }));
+                        }
+                        _rasterize(0, threadCount);
+                        for (auto& future : futures)
+                        {
+                            future.get();
+                        }
+                    }
+                    else if (p.triangles.size())
+                    {
+                        _rasterize(0, 1);
+                    }
+                    p.states.clear();
+                    p.triangles.clear();
+                }
+
+                const Image::Size& Raster::getSize() const
+                {
+                    return _p->size;
+                }
+
+                const float* Raster::getData() const
+                {
+                    return _p->data.data();
+                }
+
+                void Raster::copy(Image::Data& out) const
+                {
+                    DJV_PRIVATE_PTR();
+                    const auto& info = out.getInfo();
+                    const uint32_t w = std::min(info.size.w, p.size.w);
+                    const uint32_t h = std::min(info.size.h, p.size.h);
+                    for (uint32_t y = 0; y < h; ++y)
+                    {
+                        Image::convert(
+                            p.data.data() + static_cast<size_t>(y) * p.size.w * 4,
+                            Image::Type::RGBA_F32,
+                            out.getData(y),
+                            info.type,
+                            w);
+                    }
+                }
+
+                size_t Raster::getTriangleCount() const
+                {
+                    return _p->triangleCount;
+                }
+
+                void Raster::_add(const Vertex* vertices, size_t count, bool strip, const State& value)
+                {
+                    DJV_PRIVATE_PTR();
+                    if (count < 3)
+                        return;
+
+                    State state = value;
+                    state.clipX0 = std::max(state.clipX0, 0);
+                    state.clipY0 = std::max(state.clipY0, 0);
+                    state.clipX1 = std::min(state.clipX1, static_cast<int>(p.size.w));
+                    state.clipY1 = std::min(state.clipY1, static_cast<int>(p.size.h));
+                    if (state.clipX0 >= state.clipX1 || state.clipY0 >= state.clipY1)
+                        return;
+                    switch (state.shade)
+                    {
+                    case Shade::TextureAlpha:
+                    case Shade::TextureAlphaLCD:
+                    case Shade::Texture:
+                        if (!state.texture)
+                            return;
+                        break;
+                    default: break;
+                    }
+                    const size_t stateIndex = p.states.size();
+                    p.states.push_back(state);
+
+                    const size_t triangleCount = strip ? count - 2 : count / 3;
+                    for (size_t i = 0; i < triangleCount; ++i)
+                    {
+                        const Vertex* v[3] = { nullptr, nullptr, nullptr };
+                        if (strip)
+                        {
+                            v[0] = &vertices[i];
+                            v[1] = &vertices[i + 1];
+                            v[2] = &vertices[i + 2];
+                        }
+                        else
+                        {
+                            v[0] = &vertices[i * 3];
+                            v[1] = &vertices[i * 3 + 1];
+                            v[2] = &vertices[i * 3 + 2];
+                        }
+
+                        // Orient the triangle so that the edge equations are
+                        // positive inside.
+                        float area =
+                            (v[1]->x - v[0]->x) * (v[2]->y - v[0]->y) -
+                            (v[1]->y - v[0]->y) * (v[2]->x - v[0]->x);
+                        if (area < 0.F)
+                        {
+                            std::swap(v[1], v[2]);
+                            area = -area;
+                        }
+                        if (!(area > 0.F) || !std::isfinite(area))
+                            continue;
+
+                        Triangle triangle;
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            // The edge opposite of vertex j.
+                            const Vertex* va = v[(j + 1) % 3];
+                            const Vertex* vb = v[(j + 2) % 3];
+                            triangle.a[j] = va->y - vb->y;
+                            triangle.b[j] = vb->x - va->x;
+                            triangle.c[j] = -triangle.a[j] * va->x - triangle.b[j] * va->y;
+                        }
+                        for (size_t j = 0; j < 3; ++j)
+                        {
+                            const float* k = 0 == j ? triangle.a : (1 == j ? triangle.b : triangle.c);
+                            triangle.u[j] = (k[0] * v[0]->u + k[1] * v[1]->u + k[2] * v[2]->u) / area;
+                            triangle.v[j] = (k[0] * v[0]->v + k[1] * v[1]->v + k[2] * v[2]->v) / area;
+                        }
+
+                        const float minX = std::min(std::min(v[0]->x, v[1]->x), v[2]->x);
+                        const float maxX = std::max(std::max(v[0]->x, v[1]->x), v[2]->x);
+                        const float minY = std::min(std::min(v[0]->y, v[1]->y), v[2]->y);
+                        const float maxY = std::max(std::max(v[0]->y, v[1]->y), v[2]->y);
+                        triangle.x0 = std::max(state.clipX0, static_cast<int>(floorf(Math::clamp(minX, -1.F, static_cast<float>(p.size.w)))));
+                        triangle.x1 = std::min(state.clipX1, static_cast<int>(ceilf(Math::clamp(maxX, -1.F, static_cast<float>(p.size.w)))));
+                        triangle.y0 = std::max(state.clipY0, static_cast<int>(floorf(Math::clamp(minY, -1.F, static_cast<float>(p.size.h)))));
+                        triangle.y1 = std::min(state.clipY1, static_cast<int>(ceilf(Math::clamp(maxY, -1.F, static_cast<float>(p.size.h)))));
+                        if (triangle.x0 >= triangle.x1 || triangle.y0 >= triangle.y1)
+                            continue;
+                        triangle.state = stateIndex;
+                        p.triangles.push_back(triangle);
+                    }
+                }
+
+                void Raster::_rasterize(size_t thread, size_t threadCount)
+                {
+                    DJV_PRIVATE_PTR();
+                    const int h = static_cast<int>(p.size.h);
+                    const size_t w = static_cast<size_t>(p.size.w);
+                    for (int tileY0 = static_cast<int>(thread) * tileHeight; tileY0 < h; tileY0 += static_cast<int>(threadCount) * tileHeight)
+                    {
+                        const int tileY1 = std::min(tileY0 + tileHeight, h);
+                        for (const auto& triangle : p.triangles)
+                        {
+                            const int y0 = std::max(triangle.y0, tileY0);
+                            const int y1 = std::min(triangle.y1, tileY1);
+                            if (y0 >= y1)
+                                continue;
+                            const State& state = p.states[triangle.state];
+                            for (int y = y0; y < y1; ++y)
+                            {
+                                // Find the span of pixel centers inside of the
+                                // triangle. Left and top edges are inclusive, and
+                                // right and bottom edges are exclusive.
+                                const float py = y + .5F;
+                                float xs = static_cast<float>(triangle.x0);
+                                float xe = static_cast<float>(triangle.x1);
+                                bool inside = true;
+                                for (size_t i = 0; i < 3 && inside; ++i)
+                                {
+                                    const float a = triangle.a[i];
+                                    const float e = triangle.b[i] * py + triangle.c[i];
+                                    if (a > 0.F)
+                                    {
+                                        xs = std::max(xs, ceilf(-e / a - .5F));
+                                    }
+                                    else if (a < 0.F)
+                                    {
+                                        xe = std::min(xe, ceilf(-e / a - .5F));
+                                    }
+                                    else
+                                    {
+                                        inside = triangle.b[i] > 0.F ? e >= 0.F : e > 0.F;
+                                    }
+                                }
+                                if (!inside || xs >= xe)
+                                    continue;
+
+                                const int x0 = static_cast<int>(xs);
+                                const int x1 = static_cast<int>(xe);
+                                float* dst = p.data.data() + (static_cast<size_t>(y) * w + x0) * 4;
+                                switch (state.shade)
+                                {
+                                case Shade::SolidColor:
+                                    blendSpan(dst, x1 - x0, state.color, state.alphaBlend);
+                                    break;
+                                case Shade::TextureAlpha:
+                                case Shade::TextureAlphaLCD:
+                                case Shade::Texture:
+                                case Shade::Shadow:
+                                {
+                                    const float du = triangle.u[0];
+                                    const float dv = triangle.v[0];
+                                    float u = triangle.u[0] * (x0 + .5F) + triangle.u[1] * py + triangle.u[2];
+                                    float v = triangle.v[0] * (x0 + .5F) + triangle.v[1] * py + triangle.v[2];
+                                    float src[4];
+                                    for (int x = x0; x < x1; ++x, dst += 4, u += du, v += dv)
+                                    {
+                                        switch (state.shade)
+                                        {
+                                        case Shade::TextureAlpha:
+                                        {
+                                            float t[4];
+                                            state.texture->sample(u, v, state.filter, t);
+                                            src[0] = state.color[0];
+                                            src[1] = state.color[1];
+                                            src[2] = state.color[2];
+                                            src[3] = state.color[3] * t[0];
+                                            blend(dst, src, state.alphaBlend);
+                                            break;
+                                        }
+                                        case Shade::TextureAlphaLCD:
+                                        {
+                                            float t[4];
+                                            state.texture->sample(u, v, state.filter, t);
+                                            const float factor[4] =
+                                            {
+                                                state.color[3] * t[0],
+                                                state.color[3] * t[1],
+                                                state.color[3] * t[2],
+                                                state.color[3] * t[0]
+                                            };
+                                            src[0] = state.color[0];
+                                            src[1] = state.color[1];
+                                            src[2] = state.color[2];
+                                            src[3] = factor[3];
+                                            blendFactor(dst, src, factor);
+                                            break;
+                                        }
+                                        case Shade::Texture:
+                                            shadeTexture(state, u, v, src);
+                                            blend(dst, src, state.alphaBlend);
+                                            break;
+                                        case Shade::Shadow:
+                                            src[0] = state.color[0] * u;
+                                            src[1] = state.color[1] * u;
+                                            src[2] = state.color[2] * u;
+                                            src[3] = state.color[3] * u;
+                                            blend(dst, src, state.alphaBlend);
+                                            break;
+                                        default: break;
+                                        }
+                                    }
+                                    break;
+                                }
+                                default: break;
+                                }
+                            }
+                        }
+                    }
+                }
+
+            } // namespace Software
+        } // namespace Render
+    } // namespace AV
+} // namespace djv
@@ -0,0 +1,182 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvAV/Render2D.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace AV
+    {
+        namespace Render
+        {
+            //! This namespace provides software rendering functionality.
+            namespace Software
+            {
+                //! This struct provides a vertex.
+                struct Vertex
+                {
+                    float x = 0.F;
+                    float y = 0.F;
+                    float u = 0.F;
+                    float v = 0.F;
+                };
+
+                //! This enumeration provides how fragments are shaded.
+                enum class Shade
+                {
+                    SolidColor,         // Use the color
+                    TextureAlpha,       // Use the color with the alpha multiplied by the red
+                                        // channel from the texture
+                    TextureAlphaLCD,    // Use the color with the alpha of each channel multiplied
+                                        // by the same channel from the texture
+                    Texture,            // Use the color multiplied by the texture
+                    Shadow              // Use the color multiplied by the "U" texture coordinate
+                };
+
+                //! This class provides a texture. The image data is converted to
+                //! floating point RGBA when the texture is created.
+                class Texture
+                {
+                    DJV_NON_COPYABLE(Texture);
+                    void _init(const Image::Data&);
+                    Texture();
+
+                public:
+                    static std::shared_ptr<Texture> create(const Image::Data&);
+
+                    uint32_t getWidth() const;
+                    uint32_t getHeight() const;
+                    float* getData();
+                    const float* getData() const;
+                    size_t getDataByteCount() const;
+
+                    //! Sample the texture, where the coordinates range from zero
+                    //! to one and are clamped to the edges.
+                    void sample(float u, float v, ImageFilter, float out[4]) const;
+
+                private:
+                    uint32_t _w = 0;
+                    uint32_t _h = 0;
+                    std::vector<float> _data;
+                };
+
+                //! This struct provides the state used to shade fragments.
+                struct State
+                {
+                    int             clipX0              = 0;
+                    int             clipY0              = 0;
+                    int             clipX1              = 0;
+                    int             clipY1              = 0;
+                    Shade           shade               = Shade::SolidColor;
+                    float           color[4]            = { 0.F, 0.F, 0.F, 0.F };
+                    AlphaBlend      alphaBlend          = AlphaBlend::Straight;
+                    const Texture*  texture             = nullptr;
+                    ImageFilter     filter              = ImageFilter::Nearest;
+                    glm::mat4x4     colorMatrix         = glm::mat4x4(1.F);
+                    bool            colorMatrixEnabled  = false;
+                    bool            colorInvert         = false;
+                    ImageLevels     levels;
+                    bool            levelsEnabled       = false;
+                    float           exposureV           = 0.F;
+                    float           exposureD           = 0.F;
+                    float           exposureK           = 0.F;
+                    float           exposureF           = 0.F;
+                    bool            exposureEnabled     = false;
+                    float           softClip            = 0.F;
+                    ImageChannel    imageChannel        = ImageChannel::None;
+                };
+
+                //! This class provides a software rasterizer.
+                //!
+                //! Triangles are recorded between begin() and end(), and then
+                //! rasterized by end() into a floating point RGBA frame buffer. The
+                //! frame buffer is split into tiles of scanlines which are rendered
+                //! in parallel, each thread rasterizing all of the triangles that
+                //! overlap its tiles in the order they were recorded.
+                //!
+                //! Fragments are sampled at the pixel centers with the same fill
+                //! convention as OpenGL, so that geometry with integer coordinates
+                //! covers the same pixels with either renderer.
+                class Raster
+                {
+                    DJV_NON_COPYABLE(Raster);
+                    void _init();
+                    Raster();
+
+                public:
+                    ~Raster();
+
+                    static std::shared_ptr<Raster> create();
+
+                    //! Set the number of threads. A value of zero uses the hardware
+                    //! concurrency.
+                    void setThreadCount(size_t);
+
+                    size_t getThreadCount() const;
+
+                    //! Start a new frame and clear the frame buffer to zero.
+                    void begin(const Image::Size&);
+
+                    //! Add triangles. The vertices are copied.
+                    void addTriangles(const Vertex*, size_t count, const State&);
+
+                    //! Add a triangle strip. The vertices are copied.
+                    void addTriangleStrip(const Vertex*, size_t count, const State&);
+
+                    //! Rasterize the triangles.
+                    void end();
+
+                    //! Get the frame buffer size.
+                    const Image::Size& getSize() const;
+
+                    //! Get the frame buffer.
+                    const float* getData() const;
+
+                    //! Copy the frame buffer to an image.
+                    void copy(Image::Data&) const;
+
+                    //! Get the number of triangles rasterized by the last frame.
+                    size_t getTriangleCount() const;
+
+                private:
+                    void _add(const Vertex*, size_t count, bool strip, const State&);
+                    void _rasterize(size_t tile, size_t tileCount);
+
+                    DJV_PRIVATE();
+                };
+
+            } // namespace Software
+        } // namespace Render
+    } // namespace AV
+} // namespace djv
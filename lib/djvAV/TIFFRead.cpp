@@ -91,7 +91,7 @@ namespace djv
                     const auto info = _open(fileName, f);
                     out = Image::Image::create(info.video[0].info);
                     out->setPluginName(pluginName);
-                    for (uint16_t y = 0; y < info.video[0].info.size.h; ++y)
+                    for (uint32_t y = 0; y < info.video[0].info.size.h; ++y)
                     {
                         if (TIFFReadScanline(f.f, (tdata_t *)out->getData(y), y) == -1)
                         {
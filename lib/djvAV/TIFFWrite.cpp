@@ -232,7 +232,7 @@ namespace djv
                         TIFFSetField(f.f, TIFFTAG_IMAGEDESCRIPTION, tag.data());
                     }
 
-                    for (uint16_t y = 0; y < info.size.h; ++y)
+                    for (uint32_t y = 0; y < info.size.h; ++y)
                     {
                         if (TIFFWriteScanline(f.f, (tdata_t *)image->getData(y), y) == -1)
                         {
@@ -178,7 +178,7 @@ namespace djv
                         io.read(tmp.data(), tmpSize);
                         const uint8_t* p = tmp.data();
                         const uint8_t* const end = p + tmpSize;
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        for (uint32_t y = 0; y < imageInfo.size.h; ++y)
                         {
                             p = readRle(
                                 p,
@@ -195,10 +195,10 @@ namespace djv
 
                     if (_bgr)
                     {
-                        for (uint16_t y = 0; y < imageInfo.size.h; ++y)
+                        for (uint32_t y = 0; y < imageInfo.size.h; ++y)
                         {
                             uint8_t* p = out->getData(0, y);
-                            for (uint16_t x = 0; x < imageInfo.size.w; ++x, p += channels)
+                            for (uint32_t x = 0; x < imageInfo.size.w; ++x, p += channels)
                             {
                                 const uint8_t tmp = p[0];
                                 p[0] = p[2];
@@ -29,13 +29,15 @@
 
 #include <djvAV/ThumbnailSystem.h>
 
+#include <djvAV/GLFWSystem.h>
 #include <djvAV/Image.h>
 #include <djvAV/ImageConvert.h>
 #include <djvAV/IO.h>
 
-#include <djvCore/Cache.h>
 #include <djvCore/Context.h>
+#include <djvCore/LRUCache.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/Memory.h>
 #include <djvCore/OS.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/Timer.h>
@@ -59,7 +61,7 @@ namespace djv
             const size_t infoProcessMax  = 4;
             const size_t imageProcessMax = 4;
             const size_t infoCacheMax    = 1000;
-            const size_t imageCacheMax   = 1000;
+            const size_t imageCacheMax   = 128 * Memory::megabyte;
 
             struct InfoRequest
             {
@@ -185,12 +187,13 @@ namespace djv
             std::list<ImageRequest> imageRequests;
             std::condition_variable requestCV;
             std::mutex requestMutex;
+            bool queueChanged = false;
             std::list<InfoRequest> pendingInfoRequests;
             std::list<ImageRequest> pendingImageRequests;
 
-            Memory::Cache<size_t, IO::Info> infoCache;
+            Memory::LRUCache<size_t, IO::Info> infoCache;
             std::atomic<float> infoCachePercentage;
-            Memory::Cache<size_t, std::shared_ptr<Image::Image> > imageCache;
+            Memory::LRUCache<size_t, std::shared_ptr<Image::Image> > imageCache;
             std::atomic<float> imageCachePercentage;
             std::atomic<bool> clearCache;
             std::shared_ptr<ValueObserver<bool> > ioOptionsObserver;
@@ -199,8 +202,26 @@ namespace djv
             std::shared_ptr<Time::Timer> statsTimer;
             std::thread thread;
             std::atomic<bool> running;
+
+            void setQueueCallback(const std::shared_ptr<IO::IRead>&);
         };
 
+        void ThumbnailSystem::Private::setQueueCallback(const std::shared_ptr<IO::IRead>& read)
+        {
+            // Wake the thread when the pending request has frames instead of
+            // waiting for the timeout.
+            std::lock_guard<std::mutex> lock(read->getMutex());
+            read->getVideoQueue().setCallback(
+                [this]
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(requestMutex);
+                        queueChanged = true;
+                    }
+                    requestCV.notify_one();
+                });
+        }
+
         void ThumbnailSystem::_init(const std::shared_ptr<Core::Context>& context)
         {
             ISystem::_init("djv::AV::ThumbnailSystem", context);
@@ -209,11 +230,17 @@ namespace djv
 
             auto io = context->getSystemT<IO::System>();
             addDependency(io);
+            addDependency(context->getSystemT<GLFW::System>());
 
             p.io = io;
             p.infoCache.setMax(infoCacheMax);
             p.infoCachePercentage = 0.F;
             p.imageCache.setMax(imageCacheMax);
+            p.imageCache.setCostFunction(
+                [](const std::shared_ptr<Image::Image>& value)
+                {
+                    return value ? value->getDataByteCount() : 0;
+                });
             p.imageCachePercentage = 0.F;
             p.clearCache = false;
 
@@ -300,12 +327,13 @@ namespace djv
                                 [this]
                             {
                                 DJV_PRIVATE_PTR();
-                                return p.infoRequests.size() || p.imageRequests.size();
+                                return p.infoRequests.size() || p.imageRequests.size() || p.queueChanged;
                             }))
                             {
                                 infoRequests  |= p.infoRequests.size () > 0;
                                 imageRequests |= p.imageRequests.size() > 0;
                             }
+                            p.queueChanged = false;
                         }
                         if (infoRequests)
                         {
@@ -478,6 +506,7 @@ namespace djv
                     try
                     {
                         i.read = p.io->read(i.fileInfo);
+                        p.setQueueCallback(i.read);
                         i.infoFuture = i.read->getInfo();
                         p.pendingInfoRequests.push_back(std::move(i));
                     }
@@ -561,6 +590,7 @@ namespace djv
                     try
                     {
                         i.read = p.io->read(i.fileInfo);
+                        p.setQueueCallback(i.read);
                         const auto info = i.read->getInfo().get();
                         if (info.video.size() > 0)
                         {
@@ -616,7 +646,7 @@ namespace djv
                             const float imageAspect = imageSize.h != 0 ? (imageSize.w / static_cast<float>(imageSize.h)) : 1.F;
                             if (imageAspect < aspect)
                             {
-                                size.w = static_cast<uint16_t>(size.h * imageAspect);
+                                size.w = static_cast<uint32_t>(size.h * imageAspect);
                             }
                             else
                             {
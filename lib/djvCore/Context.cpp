@@ -39,6 +39,9 @@
 #include <djvCore/Time.h>
 #include <djvCore/Timer.h>
 
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
 #include <thread>
 
 #if defined(DJV_PLATFORM_WINDOWS)
@@ -57,7 +60,14 @@ namespace djv
     {
         void Context::_init(const std::vector<std::string>& args)
         {
+            _startupTime = std::chrono::steady_clock::now();
             _args = args;
+            auto i = std::find(_args.begin(), _args.end(), "--startup-profile");
+            if (i != _args.end())
+            {
+                _startupProfile = true;
+                _args.erase(i);
+            }
             const std::string argv0 = _args.size() > 0 ? _args[0] : std::string();
             _name = FileSystem::Path(argv0).getBaseName();
 
@@ -103,7 +113,9 @@ namespace djv
         }
 
         Context::~Context()
-        {}
+        {
+            _systemFactories.clear();
+        }
 
         std::shared_ptr<Context> Context::create(const std::vector<std::string>& args)
         {
@@ -128,8 +140,17 @@ namespace djv
             }
         }
         
+        void Context::addSystemFactory(
+            const std::type_index& type,
+            const std::function<std::shared_ptr<ISystemBase>(const std::shared_ptr<Context>&)>& value)
+        {
+            _systemFactories[type] = value;
+        }
+
         void Context::tick(float dt)
         {
+            _startupFinished();
+
             auto now = std::chrono::steady_clock::now();
             std::chrono::duration<float> delta = now - _fpsTime;
             _fpsTime = now;
@@ -203,6 +224,100 @@ namespace djv
         void Context::_addSystem(const std::shared_ptr<ISystemBase> & system)
         {
             _systems.push_back(system);
+            if (_startup)
+            {
+                _systemInitStart.push_back(std::make_pair(system->getSystemName(), std::chrono::steady_clock::now()));
+            }
+        }
+
+        void Context::_startupFinished()
+        {
+            if (!_startup)
+                return;
+            _startup = false;
+
+            // A system may have more than one entry if its initialization was
+            // interrupted by the creation of another system, so the times are
+            // accumulated.
+            const auto end = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < _systemInitStart.size(); ++i)
+            {
+                const auto next = i + 1 < _systemInitStart.size() ? _systemInitStart[i + 1].second : end;
+                const std::chrono::duration<float, std::milli> diff = next - _systemInitStart[i].second;
+                const auto& name = _systemInitStart[i].first;
+                auto j = std::find_if(
+                    _systemInitTimes.begin(),
+                    _systemInitTimes.end(),
+                    [&name](const std::pair<std::string, float>& value)
+                    {
+                        return name == value.first;
+                    });
+                if (j != _systemInitTimes.end())
+                {
+                    j->second += diff.count();
+                }
+                else
+                {
+                    _systemInitTimes.push_back(std::make_pair(name, diff.count()));
+                }
+            }
+            _systemInitStart.clear();
+            const std::chrono::duration<float, std::milli> total = end - _startupTime;
+
+            std::stringstream ss;
+            ss << "Startup time: " << std::fixed << std::setprecision(2) << total.count() << "ms";
+            _logSystem->log("djv::Core::Context", ss.str());
+
+            if (_startupProfile)
+            {
+                auto systemInitTimes = _systemInitTimes;
+                std::sort(
+                    systemInitTimes.begin(),
+                    systemInitTimes.end(),
+                    [](const std::pair<std::string, float>& a, const std::pair<std::string, float>& b)
+                    {
+                        return a.second > b.second;
+                    });
+                size_t width = 0;
+                for (const auto& i : systemInitTimes)
+                {
+                    width = std::max(width, i.first.size());
+                }
+                std::cout << "Startup profile:" << std::endl;
+                for (const auto& i : systemInitTimes)
+                {
+                    std::cout << "    " << std::left << std::setw(width) << i.first << "  ";
+                    std::cout << std::right << std::fixed << std::setprecision(2) << std::setw(10) << i.second << "ms" << std::endl;
+                }
+                std::cout << "    " << std::left << std::setw(width) << "Total" << "  ";
+                std::cout << std::right << std::fixed << std::setprecision(2) << std::setw(10) << total.count() << "ms" << std::endl;
+            }
+        }
+
+        std::shared_ptr<ISystemBase> Context::_createSystem(const std::type_index& type) const
+        {
+            std::shared_ptr<ISystemBase> out;
+            const auto i = _systemFactories.find(type);
+            if (i != _systemFactories.end())
+            {
+                // Remove the factory before creating the system so that it is
+                // not created again if it requests itself during initialization.
+                const auto factory = i->second;
+                _systemFactories.erase(i);
+                auto context = std::const_pointer_cast<Context>(shared_from_this());
+                const std::string parent = _startup && !_systemInitStart.empty() ? _systemInitStart.back().first : std::string();
+                out = factory(context);
+                if (!parent.empty())
+                {
+                    // The system was created during the initialization of another
+                    // system, the rest of the time belongs to the other system.
+                    _systemInitStart.push_back(std::make_pair(parent, std::chrono::steady_clock::now()));
+                }
+                std::stringstream ss;
+                ss << "Created system on demand: " << out->getSystemName();
+                _logSystem->log("djv::Core::Context", ss.str());
+            }
+            return out;
         }
 
     } // namespace ViewExperiment
@@ -32,9 +32,12 @@
 #include <djvCore/Path.h>
 
 #include <chrono>
+#include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
+#include <typeindex>
 #include <vector>
 
 namespace djv
@@ -55,6 +58,13 @@ namespace djv
         } // namespace Time
 
         //! This class provides core functionality.
+        //!
+        //! Systems that are not needed by every application can be registered
+        //! with a factory instead of being created up front. They are created
+        //! the first time they are requested with getSystemT().
+        //!
+        //! If the command line contains the flag "--startup-profile" the time
+        //! spent initializing each system is printed when startup finishes.
         class Context : public std::enable_shared_from_this<Context>
         {
             DJV_NON_COPYABLE(Context);
@@ -86,14 +96,44 @@ namespace djv
             template<typename T>
             std::vector<std::shared_ptr<T> > getSystemsT() const;
 
-            //! Get a system of the given type. If the system is not found a
-            //! null pointer is returned.
+            //! Get a system of the given type. If the system has not been
+            //! created but a factory was added for the type, the system is
+            //! created. If the system is not found a null pointer is returned.
             template<typename T>
             std::shared_ptr<T> getSystemT() const;
             
             //! Remove a system.
             void removeSystem(const std::shared_ptr<ISystemBase>&);
 
+            //! Add a factory for a system that is created the first time it is
+            //! requested with getSystemT(). Systems that have not been created
+            //! are not returned by getSystems() or getSystemsT().
+            void addSystemFactory(
+                const std::type_index&,
+                const std::function<std::shared_ptr<ISystemBase>(const std::shared_ptr<Context>&)>&);
+
+            //! Add a factory for a system that is created with T::create().
+            template<typename T>
+            void addSystemFactoryT();
+
+            ///@}
+
+            //! \name Startup
+            ///@{
+
+            //! Get whether the startup profile was requested.
+            bool hasStartupProfile() const;
+
+            //! Get the time spent initializing each system during startup, in
+            //! milliseconds. The time for a system is measured from the start of
+            //! its initialization to the start of the next system, or the end of
+            //! startup. The time spent creating systems on demand during the
+            //! initialization of another system is not included in its time. The
+            //! list is empty until startup has finished.
+            const std::vector<std::pair<std::string, float> >& getSystemInitTimes() const;
+
+            ///@}
+
             //! This function is called by the application event loop.
             virtual void tick(float dt);
 
@@ -106,7 +146,13 @@ namespace djv
         protected:
             void _addSystem(const std::shared_ptr<ISystemBase> &);
 
+            //! Mark the end of startup. This is called by the first tick, and
+            //! may be called earlier by applications that do not tick.
+            void _startupFinished();
+
         private:
+            std::shared_ptr<ISystemBase> _createSystem(const std::type_index&) const;
+
             std::vector<std::string> _args;
             std::string _name;
             std::shared_ptr<Time::TimerSystem> _timerSystem;
@@ -114,7 +160,13 @@ namespace djv
             std::shared_ptr<LogSystem> _logSystem;
             std::shared_ptr<TextSystem> _textSystem;
             std::vector<std::shared_ptr<ISystemBase> > _systems;
+            mutable std::map<std::type_index, std::function<std::shared_ptr<ISystemBase>(const std::shared_ptr<Context>&)> > _systemFactories;
             std::vector<std::pair<std::string, float> > _systemTickTimes;
+            bool _startupProfile = false;
+            bool _startup = true;
+            std::chrono::time_point<std::chrono::steady_clock> _startupTime;
+            mutable std::vector<std::pair<std::string, std::chrono::time_point<std::chrono::steady_clock> > > _systemInitStart;
+            std::vector<std::pair<std::string, float> > _systemInitTimes;
             std::chrono::time_point<std::chrono::steady_clock> _fpsTime = std::chrono::steady_clock::now();
             std::list<float> _fpsSamples;
             float _fpsAverage = 0.F;
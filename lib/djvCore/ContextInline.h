@@ -75,9 +75,34 @@ namespace djv
                     break;
                 }
             }
+            if (!out && !_systemFactories.empty())
+            {
+                out = std::dynamic_pointer_cast<T>(_createSystem(typeid(T)));
+            }
             return out;
         }
 
+        template<typename T>
+        inline void Context::addSystemFactoryT()
+        {
+            addSystemFactory(
+                typeid(T),
+                [](const std::shared_ptr<Context>& context) -> std::shared_ptr<ISystemBase>
+                {
+                    return T::create(context);
+                });
+        }
+
+        inline bool Context::hasStartupProfile() const
+        {
+            return _startupProfile;
+        }
+
+        inline const std::vector<std::pair<std::string, float> >& Context::getSystemInitTimes() const
+        {
+            return _systemInitTimes;
+        }
+
         inline float Context::getFPSAverage() const
         {
             return _fpsAverage;
@@ -61,6 +61,8 @@ namespace djv
                 std::shared_ptr<ValueSubject<bool> > reverseSort;
                 std::shared_ptr<ValueSubject<bool> > sortDirectoriesFirst;
                 std::shared_ptr<ValueSubject<std::string> > filter;
+                Path listPath;
+                DirectoryListOptions listOptions;
                 std::future<std::pair<std::vector<FileInfo>, std::vector<std::string> > > future;
                 std::shared_ptr<Time::Timer> futureTimer;
                 std::shared_ptr<DirectoryWatcher> directoryWatcher;
@@ -90,12 +92,12 @@ namespace djv
                 p.directoryWatcher = DirectoryWatcher::create(context);
 
                 auto weak = std::weak_ptr<DirectoryModel>(shared_from_this());
-                p.directoryWatcher->setCallback(
-                    [weak]
+                p.directoryWatcher->setChangesCallback(
+                    [weak](const std::vector<DirectoryChange>& value)
                 {
                     if (auto model = weak.lock())
                     {
-                        model->reload();
+                        model->_changesUpdate(value);
                     }
                 });
             }
@@ -367,6 +369,7 @@ namespace djv
                 options.reverseSort = p.reverseSort->get();
                 options.sortDirectoriesFirst = p.sortDirectoriesFirst->get();
                 options.filter = p.filter->get();
+                p.listOptions = options;
                 p.future = std::async(
                     std::launch::async,
                     [path, options]
@@ -375,14 +378,14 @@ namespace djv
                     out.first = FileInfo::directoryList(path, options);
                     for (const auto & fileInfo : out.first)
                     {
-                        out.second.push_back(fileInfo.getFileName(-1, false));
+                        out.second.push_back(fileInfo.getFileName(Frame::invalid, false));
                     }
                     return out;
                 });
 
                 p.futureTimer->start(
                     Time::getMilliseconds(Time::TimerValue::Medium),
-                    [this](float)
+                    [this, path](float)
                 {
                     DJV_PRIVATE_PTR();
                     if (p.future.valid() &&
@@ -390,15 +393,72 @@ namespace djv
                     {
                         p.futureTimer->stop();
 
-                        const auto & out = p.future.get();
-                        p.fileInfo->setIfChanged(out.first);
-                        p.fileNames->setIfChanged(out.second);
+                        // Listing a new directory resets the observers, while
+                        // re-listing the same directory (for example when it
+                        // changes on disk) only sends the items that changed.
+                        auto out = p.future.get();
+                        if (path != p.listPath)
+                        {
+                            p.listPath = path;
+                            p.fileInfo->setAlways(std::move(out.first));
+                            p.fileNames->setAlways(std::move(out.second));
+                        }
+                        else
+                        {
+                            p.fileInfo->setIfChanged(std::move(out.first));
+                            p.fileNames->setIfChanged(std::move(out.second));
+                        }
                     }
                 });
 
                 p.directoryWatcher->setPath(p.path->get());
             }
 
+            void DirectoryModel::_changesUpdate(const std::vector<DirectoryChange>& changes)
+            {
+                DJV_PRIVATE_PTR();
+
+                // List the directory again if a listing is in progress or the
+                // changes are unknown.
+                if (p.future.valid() || p.path->get() != p.listPath)
+                {
+                    _updatePath();
+                    return;
+                }
+                std::vector<Path> created;
+                std::vector<Path> removed;
+                std::vector<Path> modified;
+                for (const auto& i : changes)
+                {
+                    switch (i.type)
+                    {
+                    case DirectoryChangeType::Created:  created.push_back(i.path);  break;
+                    case DirectoryChangeType::Removed:  removed.push_back(i.path);  break;
+                    case DirectoryChangeType::Modified: modified.push_back(i.path); break;
+                    default:
+                        _updatePath();
+                        return;
+                    }
+                }
+
+                // Apply the changes to the current listing.
+                auto fileInfo = p.fileInfo->get();
+                if (FileInfo::directoryListUpdate(fileInfo, created, removed, modified, p.listOptions))
+                {
+                    std::vector<std::string> fileNames;
+                    for (const auto& i : fileInfo)
+                    {
+                        fileNames.push_back(i.getFileName(Frame::invalid, false));
+                    }
+                    p.fileInfo->setIfChanged(std::move(fileInfo));
+                    p.fileNames->setIfChanged(std::move(fileNames));
+                }
+                else
+                {
+                    _updatePath();
+                }
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
@@ -41,7 +41,12 @@ namespace djv
 
         namespace FileSystem
         {
+            class DirectoryChange;
+
             //! This class provides a directory model.
+            //!
+            //! Changes to the directory on disk are applied to the current listing
+            //! without listing the directory again when possible.
             class DirectoryModel : public std::enable_shared_from_this<DirectoryModel>
             {
                 DJV_NON_COPYABLE(DirectoryModel);
@@ -98,6 +103,7 @@ namespace djv
 
             private:
                 void _updatePath();
+                void _changesUpdate(const std::vector<DirectoryChange>&);
 
                 DJV_PRIVATE();
             };
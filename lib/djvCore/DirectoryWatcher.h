@@ -30,9 +30,13 @@
 #pragma once
 
 #include <djvCore/Core.h>
+#include <djvCore/Path.h>
 
 #include <functional>
+#include <list>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace djv
 {
@@ -42,10 +46,67 @@ namespace djv
 
         namespace FileSystem
         {
-            class Path;
+            //! This enumeration provides the directory change types.
+            enum class DirectoryChangeType
+            {
+                Created,
+                Removed,
+                Modified,
+                Reset,  //!< The changes are unknown and the directory should be listed again.
+
+                Count,
+                First = Created
+            };
+
+            //! This class provides a directory change.
+            class DirectoryChange
+            {
+            public:
+                DirectoryChange();
+                DirectoryChange(DirectoryChangeType, const Path&);
+
+                DirectoryChangeType type = DirectoryChangeType::Reset;
+                Path                path;
+
+                bool operator == (const DirectoryChange&) const;
+                bool operator != (const DirectoryChange&) const;
+            };
+
+            //! This class provides a list of directory changes. A change is coalesced
+            //! with an existing change to the same path:
+            //! - Created then removed cancels out
+            //! - Removed then created becomes modified
+            //! - Created then modified stays created
+            //! - A reset replaces all of the other changes
+            class DirectoryChanges
+            {
+            public:
+                //! Add a change.
+                void add(const DirectoryChange&);
+
+                //! Get the changes in the order they were added.
+                std::vector<DirectoryChange> get() const;
+
+                size_t getSize() const;
+                bool isEmpty() const;
+
+                void clear();
+
+            private:
+                std::list<DirectoryChange> _changes;
+                std::unordered_map<Path, std::list<DirectoryChange>::iterator> _index;
+            };
 
             //! This class provides functionality for watching directory changes.
             //!
+            //! The directory is watched by a thread that blocks until the operating
+            //! system reports changes. Changes are coalesced and delivered on the
+            //! main thread once the directory has been quiet for a short time, or
+            //! periodically while changes keep arriving.
+            //!
+            //! Per-file changes are only available on Linux, the other platforms
+            //! deliver a reset.
+            //!
             //! \bug What do we do about changes to the directory path (like deletion or moving)?
             class DirectoryWatcher : public std::enable_shared_from_this<DirectoryWatcher>
             {
@@ -61,8 +122,16 @@ namespace djv
                 const Path & getPath() const;
                 void setPath(const Path &);
 
+                //! Set whether sub-directories are also watched.
+                void setRecursive(bool);
+                bool isRecursive() const;
+
+                //! Set the callback that is called when the directory changes.
                 void setCallback(const std::function<void(void)> &);
 
+                //! Set the callback that is called with the coalesced changes.
+                void setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>&);
+
             private:
                 DJV_PRIVATE();
             };
@@ -71,3 +140,5 @@ namespace djv
     } // namespace Core
 } // namespace djv
 
+#include <djvCore/DirectoryWatcherInline.h>
+
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace FileSystem
+        {
+            inline DirectoryChange::DirectoryChange()
+            {}
+
+            inline DirectoryChange::DirectoryChange(DirectoryChangeType type, const Path& path) :
+                type(type),
+                path(path)
+            {}
+
+            inline bool DirectoryChange::operator == (const DirectoryChange& other) const
+            {
+                return type == other.type && path == other.path;
+            }
+
+            inline bool DirectoryChange::operator != (const DirectoryChange& other) const
+            {
+                return !(*this == other);
+            }
+
+            inline void DirectoryChanges::add(const DirectoryChange& change)
+            {
+                if (DirectoryChangeType::Reset == change.type)
+                {
+                    clear();
+                    _changes.push_back(change);
+                    return;
+                }
+                if (1 == _changes.size() && DirectoryChangeType::Reset == _changes.front().type)
+                    return;
+                const auto i = _index.find(change.path);
+                if (i == _index.end())
+                {
+                    _index[change.path] = _changes.insert(_changes.end(), change);
+                    return;
+                }
+                auto& existing = *i->second;
+                switch (existing.type)
+                {
+                case DirectoryChangeType::Created:
+                    if (DirectoryChangeType::Removed == change.type)
+                    {
+                        _changes.erase(i->second);
+                        _index.erase(i);
+                    }
+                    break;
+                case DirectoryChangeType::Removed:
+                    if (DirectoryChangeType::Removed != change.type)
+                    {
+                        existing.type = DirectoryChangeType::Modified;
+                    }
+                    break;
+                case DirectoryChangeType::Modified:
+                    if (DirectoryChangeType::Removed == change.type)
+                    {
+                        existing.type = DirectoryChangeType::Removed;
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            inline std::vector<DirectoryChange> DirectoryChanges::get() const
+            {
+                return std::vector<DirectoryChange>(_changes.begin(), _changes.end());
+            }
+
+            inline size_t DirectoryChanges::getSize() const
+            {
+                return _changes.size();
+            }
+
+            inline bool DirectoryChanges::isEmpty() const
+            {
+                return _changes.empty();
+            }
+
+            inline void DirectoryChanges::clear()
+            {
+                _changes.clear();
+                _index.clear();
+            }
+
+        } // namespace FileSystem
+    } // namespace Core
+} // namespace djv
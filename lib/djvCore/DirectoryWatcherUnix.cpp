@@ -1,5 +1,5 @@
 //------------------------------------------------------------------------------
-// Copyright (c) 2018 Darby Johnston
+// Copyright (c) 2004-2019 Darby Johnston
 // All rights reserved.
 //
 // Redistribution and use in source and binary forms, with or without
@@ -32,7 +32,8 @@
 #include <djvCore/Context.h>
 #include <djvCore/Timer.h>
 
-#include <ctime>
+#include <atomic>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -45,8 +46,12 @@
 #else
 #include <sys/types.h>
 #include <sys/inotify.h>
-#include <unistd.h>
+#include <sys/stat.h>
+#include <dirent.h>
 #endif
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 
 namespace djv
 {
@@ -56,255 +61,428 @@ namespace djv
         {
             namespace
             {
+                //! \todo Should these be configurable?
+                const std::chrono::milliseconds debounceTimeout(250);
+                const std::chrono::milliseconds debounceTimeoutMax(1000);
+
 #if defined(DJV_PLATFORM_OSX)
+                //! \todo Per-file changes and recursive watches are not supported
+                //! on this platform, any change to the directory is reported as a
+                //! reset.
                 class Notify
                 {
                 public:
-                    Notify(const FileSystem::Path& path) :
-                        _path(path)
+                    Notify(const Path& path, bool)
                     {
                         _kq = ::kqueue();
-                        if  (_kq)
+                        if (_kq != -1)
                         {
-                            _fd = ::open(_path.get().c_str(), O_EVTONLY);
-                            
-                            const int vnodeEvents =
-                                NOTE_DELETE |
-                                NOTE_WRITE  |
-                                NOTE_EXTEND |
-                                NOTE_ATTRIB |
-                                NOTE_LINK   |
-                                NOTE_RENAME |
-                                NOTE_REVOKE;
-                            EV_SET(&_eventsToMonitor[0], _fd, EVFILT_VNODE, EV_ADD | EV_CLEAR, vnodeEvents, 0, 0);
+                            _fd = ::open(path.get().c_str(), O_EVTONLY);
+                            if (_fd != -1)
+                            {
+                                const int vnodeEvents =
+                                    NOTE_DELETE |
+                                    NOTE_WRITE  |
+                                    NOTE_EXTEND |
+                                    NOTE_ATTRIB |
+                                    NOTE_LINK   |
+                                    NOTE_RENAME |
+                                    NOTE_REVOKE;
+                                struct kevent event;
+                                EV_SET(&event, _fd, EVFILT_VNODE, EV_ADD | EV_CLEAR, vnodeEvents, 0, 0);
+                                ::kevent(_kq, &event, 1, nullptr, 0, nullptr);
+                            }
                         }
                     }
-                    
+
                     ~Notify()
                     {
-                        if (_fd)
+                        if (_fd != -1)
                         {
                             ::close(_fd);
                         }
+                        if (_kq != -1)
+                        {
+                            ::close(_kq);
+                        }
                     }
-                    
-                    const FileSystem::Path& getPath() const { return _path; }
-                    
-                    ::time_t poll()
+
+                    int getFD() const { return _kq; }
+
+                    void read(DirectoryChanges& changes)
                     {
-                        struct kevent eventData[1];
-                        timespec _timeout;
-                        _timeout.tv_sec = 0;
-                        _timeout.tv_nsec = Time::getValue(Time::TimerValue::Medium) * 1000000;
-                        int eventCount = ::kevent(_kq, _eventsToMonitor, 1, eventData, 1, &_timeout);
-                        if (eventCount)
+                        struct kevent events[16];
+                        const timespec timeout = { 0, 0 };
+                        if (::kevent(_kq, nullptr, 0, events, 16, &timeout) > 0)
                         {
-                            _lastModified = time(nullptr);
+                            changes.add(DirectoryChange());
                         }
-                        return _lastModified;
                     }
-                    
+
                 private:
-                    FileSystem::Path _path;
-                    int _kq = 0;
-                    int _fd = 0;
-                    struct kevent _eventsToMonitor[1];
-                    ::time_t _lastModified = 0;
+                    int _kq = -1;
+                    int _fd = -1;
                 };
 
 #else // DJV_PLATFORM_OSX
 
+                //! Modifications are reported when a file is closed after writing
+                //! so that large writes only generate a single change.
+                const uint32_t notifyMask =
+                    IN_CREATE      |
+                    IN_DELETE      |
+                    IN_CLOSE_WRITE |
+                    IN_ATTRIB      |
+                    IN_MOVED_FROM  |
+                    IN_MOVED_TO    |
+                    IN_DELETE_SELF |
+                    IN_MOVE_SELF;
+
                 class Notify
                 {
                 public:
-                    explicit Notify(const Path& path) :
-                        _path(path)
+                    Notify(const Path& path, bool recursive) :
+                        _recursive(recursive)
                     {
-                        _fd = ::inotify_init1(IN_NONBLOCK);
-                        if (_fd)
+                        _fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+                        if (_fd != -1)
                         {
-                            _wd = ::inotify_add_watch(_fd, _path.get().c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_ATTRIB);
+                            _rootWD = _addWatch(path, nullptr);
                         }
                     }
 
-                    Notify(Notify&& other) noexcept :
-                        _path(other._path),
-                        _fd(other._fd),
-                        _wd(other._wd),
-                        _lastModified(other._lastModified)
-                    {}
-                    
                     ~Notify()
                     {
-                        if (_fd && _wd)
-                        {
-                            ::inotify_rm_watch(_fd, _wd);
-                            _wd = 0;
-                        }
-                        if (_fd)
+                        // Closing the file descriptor also removes the watches.
+                        if (_fd != -1)
                         {
                             ::close(_fd);
-                            _fd = 0;
                         }
                     }
 
-                    Notify& operator = (Notify&& other) noexcept
+                    int getFD() const { return _fd; }
+
+                    void read(DirectoryChanges& changes)
                     {
-                        if (this != &other)
+                        static const size_t bufferSize = 1024 * (sizeof(::inotify_event) + 16);
+                        alignas(::inotify_event) char buffer[bufferSize];
+                        ssize_t length = 0;
+                        while ((length = ::read(_fd, buffer, bufferSize)) > 0)
                         {
-                            _path = other._path;
-                            _fd = other._fd;
-                            _wd = other._wd;
-                            _lastModified = other._lastModified;
+                            ssize_t i = 0;
+                            while (i < length)
+                            {
+                                const auto event = reinterpret_cast<const ::inotify_event*>(&buffer[i]);
+                                _event(*event, changes);
+                                i += sizeof(::inotify_event) + event->len;
+                            }
                         }
-                        return *this;
                     }
-                    
-                    const Path& getPath() const { return _path; }
-                    
-                    ::time_t poll()
+
+                private:
+                    int _addWatch(const Path& path, DirectoryChanges* changes)
                     {
-                        if (_fd && _wd)
+                        const int wd = ::inotify_add_watch(_fd, path.get().c_str(), notifyMask);
+                        if (wd != -1)
                         {
-                            static const size_t bufferSize = 1024 * (sizeof(::inotify_event) + 16);
-                            char buffer[bufferSize];
-                            const int length = ::read(_fd, buffer, bufferSize);
-                            int i = 0;
-                            while (i < length)
+                            _watches[wd] = path;
+                            if (_recursive)
                             {
-                                ::inotify_event* event = (::inotify_event*)&buffer[i];
-                                if (event->len)
+                                if (auto dir = ::opendir(path.get().c_str()))
                                 {
-                                    if (event->mask & IN_CREATE ||
-                                        event->mask & IN_DELETE ||
-                                        event->mask & IN_MODIFY)
+                                    dirent* de = nullptr;
+                                    while ((de = ::readdir(dir)))
                                     {
-                                        _lastModified = time(nullptr);
-                                        break;
+                                        const std::string fileName(de->d_name);
+                                        if ("." == fileName || ".." == fileName)
+                                            continue;
+                                        const Path childPath(path, fileName);
+                                        if (changes)
+                                        {
+                                            // Files may have been created in a new directory
+                                            // before it was watched.
+                                            changes->add(DirectoryChange(DirectoryChangeType::Created, childPath));
+                                        }
+                                        if (_isDir(*de, childPath))
+                                        {
+                                            _addWatch(childPath, changes);
+                                        }
                                     }
+                                    ::closedir(dir);
                                 }
-                                i += sizeof(::inotify_event) + event->len;
                             }
                         }
-                        return _lastModified;
+                        return wd;
                     }
-                    
-                private:
-                    Path _path;
-                    int _fd = 0;
-                    int _wd = 0;
-                    ::time_t _lastModified = 0;
+
+                    static bool _isDir(const dirent& de, const Path& path)
+                    {
+                        // Some file systems do not provide the type, so it is
+                        // checked with stat() instead.
+                        if (DT_UNKNOWN == de.d_type)
+                        {
+                            struct stat info;
+                            return 0 == ::stat(path.get().c_str(), &info) && S_ISDIR(info.st_mode);
+                        }
+                        return DT_DIR == de.d_type;
+                    }
+
+                    //! Remove the watches for a directory and its sub-directories.
+                    void _removeWatches(const Path& path)
+                    {
+                        const std::string s = path.get();
+                        auto i = _watches.begin();
+                        while (i != _watches.end())
+                        {
+                            const std::string w = i->second.get();
+                            if (i->first != _rootWD &&
+                                (w == s || (w.size() > s.size() && 0 == w.compare(0, s.size(), s) && '/' == w[s.size()])))
+                            {
+                                ::inotify_rm_watch(_fd, i->first);
+                                i = _watches.erase(i);
+                            }
+                            else
+                            {
+                                ++i;
+                            }
+                        }
+                    }
+
+                    void _event(const ::inotify_event& event, DirectoryChanges& changes)
+                    {
+                        if (event.mask & IN_Q_OVERFLOW)
+                        {
+                            changes.add(DirectoryChange());
+                            return;
+                        }
+                        const auto i = _watches.find(event.wd);
+                        if (i == _watches.end())
+                            return;
+                        if (event.mask & IN_IGNORED)
+                        {
+                            _watches.erase(i);
+                            return;
+                        }
+                        if (!event.len)
+                        {
+                            // The watched directory has been removed or moved. Changes
+                            // to sub-directories are reported by their parent, and
+                            // their watches are removed since the paths are no
+                            // longer valid.
+                            if (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+                            {
+                                if (event.wd == _rootWD)
+                                {
+                                    changes.add(DirectoryChange());
+                                }
+                                else
+                                {
+                                    _removeWatches(i->second);
+                                }
+                            }
+                            return;
+                        }
+                        const Path path(i->second, event.name);
+                        if (event.mask & (IN_CREATE | IN_MOVED_TO))
+                        {
+                            changes.add(DirectoryChange(DirectoryChangeType::Created, path));
+                            if (_recursive && event.mask & IN_ISDIR)
+                            {
+                                _addWatch(path, &changes);
+                            }
+                        }
+                        else if (event.mask & (IN_DELETE | IN_MOVED_FROM))
+                        {
+                            changes.add(DirectoryChange(DirectoryChangeType::Removed, path));
+                            if (_recursive && event.mask & IN_ISDIR)
+                            {
+                                // A directory that is moved within the tree is
+                                // watched again with the new path by IN_MOVED_TO.
+                                _removeWatches(path);
+                            }
+                        }
+                        else if (event.mask & (IN_CLOSE_WRITE | IN_ATTRIB))
+                        {
+                            changes.add(DirectoryChange(DirectoryChangeType::Modified, path));
+                        }
+                    }
+
+                    bool _recursive = false;
+                    int _fd = -1;
+                    int _rootWD = -1;
+                    std::map<int, Path> _watches;
                 };
 #endif // DJV_PLATFORM_OSX
 
             } // namespace
-                    
+
             struct DirectoryWatcher::Private
             {
                 Path path;
-                bool running = false;
+                bool recursive = false;
+                bool pathChanged = false;
+                DirectoryChanges changes;
+                std::chrono::steady_clock::time_point changesStart;
+                std::chrono::steady_clock::time_point changesLast;
+                std::mutex mutex;
+                int wakeFD[2] = { -1, -1 };
+                std::atomic<bool> running;
                 std::thread thread;
-                std::timed_mutex mutex;
-                ::time_t lastModified = 0;
-                ::time_t threadModified = 0;
                 std::shared_ptr<Time::Timer> timer;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<DirectoryChange>&)> changesCallback;
+
+                void wake();
             };
 
             void DirectoryWatcher::_init(const std::shared_ptr<Context>& context)
             {
-                _p->running = true;
-                
-                std::weak_ptr<DirectoryWatcher> weak(shared_from_this());
-                const auto timeout = Time::getMilliseconds(Time::TimerValue::Medium);
-                _p->thread = std::thread(
-                    [weak, timeout]
+                DJV_PRIVATE_PTR();
+
+                // The thread blocks until there are changes, or until it is woken
+                // up by the main thread through a pipe.
+                if (0 == ::pipe(p.wakeFD))
                 {
-                    Path path;
-                    bool pathInit = false;
+                    for (size_t i = 0; i < 2; ++i)
+                    {
+                        ::fcntl(p.wakeFD[i], F_SETFL, ::fcntl(p.wakeFD[i], F_GETFL) | O_NONBLOCK);
+                        ::fcntl(p.wakeFD[i], F_SETFD, FD_CLOEXEC);
+                    }
+                }
+                else
+                {
+                    p.wakeFD[0] = p.wakeFD[1] = -1;
+                }
+
+                p.running = true;
+                p.thread = std::thread(
+                    [this]
+                {
+                    DJV_PRIVATE_PTR();
                     std::unique_ptr<Notify> notify;
-                    ::time_t lastModified = 0;                    
-                    bool running = true;
-                    while (running)
+                    DirectoryChanges changes;
+                    while (p.running)
                     {
-                        if (auto watcher = weak.lock())
                         {
-                            auto & p = *watcher->_p;
-                            if (p.mutex.try_lock_for(timeout))
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            if (p.pathChanged)
                             {
-                                // Synchronize with the main thread.
-                                running = p.running;
-                                if (path != p.path)
+                                // Start the notifier with a new path.
+                                p.pathChanged = false;
+                                notify.reset();
+                                if (!p.path.isEmpty())
                                 {
-                                    path = p.path;
-                                    pathInit = true;
+                                    notify.reset(new Notify(p.path, p.recursive));
                                 }
-                                p.threadModified = lastModified;                                                        
-                                p.mutex.unlock();
                             }
                         }
-                        else
-                        {
-                            running = false;
-                            break;
-                        }
 
-                        if (pathInit)
+                        ::pollfd fds[2];
+                        fds[0].fd = p.wakeFD[0];
+                        fds[0].events = POLLIN;
+                        fds[0].revents = 0;
+                        ::nfds_t fdsCount = 1;
+                        if (notify && notify->getFD() != -1)
                         {
-                            // Start the notifier with a new path.
-                            notify.reset(new Notify(path));
-                            pathInit = false;
+                            fds[1].fd = notify->getFD();
+                            fds[1].events = POLLIN;
+                            fds[1].revents = 0;
+                            fdsCount = 2;
                         }
-                        
-                        if (notify)
+                        const int timeout = p.wakeFD[0] != -1 ? -1 : static_cast<int>(Time::getValue(Time::TimerValue::Medium));
+                        if (::poll(fds, fdsCount, timeout) > 0)
                         {
-                            // Poll for events.
-                            lastModified = notify->poll();
+                            if (fds[0].revents & POLLIN)
+                            {
+                                char buffer[16];
+                                while (::read(p.wakeFD[0], buffer, 16) > 0)
+                                    ;
+                            }
+                            if (fdsCount > 1 && fds[1].revents & POLLIN)
+                            {
+                                changes.clear();
+                                notify->read(changes);
+                                if (!changes.isEmpty())
+                                {
+                                    std::lock_guard<std::mutex> lock(p.mutex);
+                                    if (!p.pathChanged)
+                                    {
+                                        const auto now = std::chrono::steady_clock::now();
+                                        if (p.changes.isEmpty())
+                                        {
+                                            p.changesStart = now;
+                                        }
+                                        p.changesLast = now;
+                                        for (const auto& i : changes.get())
+                                        {
+                                            p.changes.add(i);
+                                        }
+                                    }
+                                }
+                            }
                         }
-                        
-                        std::this_thread::sleep_for(timeout);
                     }
                 });
 
-                _p->timer = Time::Timer::create(context);
-                _p->timer->setRepeating(true);
-                _p->timer->start(
-                    timeout,
-                    [weak, timeout](float)
+                p.timer = Time::Timer::create(context);
+                p.timer->setRepeating(true);
+                p.timer->start(
+                    Time::getMilliseconds(Time::TimerValue::Medium),
+                    [this](float)
                 {
-                    if (auto watcher = weak.lock())
+                    DJV_PRIVATE_PTR();
+                    std::vector<DirectoryChange> changes;
                     {
-                        auto & p = *watcher->_p;
-                        if (p.mutex.try_lock_for(timeout))
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        if (!p.changes.isEmpty())
                         {
-                            if (p.threadModified != p.lastModified)
-                            {                            
-                                p.lastModified = p.threadModified;
-                                
-                                if (p.callback)
-                                {
-                                    p.callback();
-                                }
+                            // Wait for the directory to be quiet before delivering the
+                            // changes, unless they have been pending for too long.
+                            const auto now = std::chrono::steady_clock::now();
+                            if (now - p.changesLast >= debounceTimeout ||
+                                now - p.changesStart >= debounceTimeoutMax)
+                            {
+                                changes = p.changes.get();
+                                p.changes.clear();
                             }
-                            p.mutex.unlock();
+                        }
+                    }
+                    if (changes.size())
+                    {
+                        if (p.changesCallback)
+                        {
+                            p.changesCallback(changes);
+                        }
+                        if (p.callback)
+                        {
+                            p.callback();
                         }
                     }
                 });
             }
-            
+
             DirectoryWatcher::DirectoryWatcher() :
                 _p(new Private)
             {}
 
             DirectoryWatcher::~DirectoryWatcher()
             {
-                if (_p->running)
+                DJV_PRIVATE_PTR();
+                p.running = false;
+                p.wake();
+                if (p.thread.joinable())
                 {
-                    _p->running = false;
-                    _p->thread.join();
+                    p.thread.join();
+                }
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    if (p.wakeFD[i] != -1)
+                    {
+                        ::close(p.wakeFD[i]);
+                    }
                 }
             }
-            
+
             std::shared_ptr<DirectoryWatcher> DirectoryWatcher::create(const std::shared_ptr<Context>& context)
             {
                 auto out = std::shared_ptr<DirectoryWatcher>(new DirectoryWatcher);
@@ -319,7 +497,35 @@ namespace djv
 
             void DirectoryWatcher::setPath(const Path& value)
             {
-                _p->path = value;
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (value == p.path)
+                        return;
+                    p.path = value;
+                    p.pathChanged = true;
+                    p.changes.clear();
+                }
+                p.wake();
+            }
+
+            void DirectoryWatcher::setRecursive(bool value)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (value == p.recursive)
+                        return;
+                    p.recursive = value;
+                    p.pathChanged = true;
+                    p.changes.clear();
+                }
+                p.wake();
+            }
+
+            bool DirectoryWatcher::isRecursive() const
+            {
+                return _p->recursive;
             }
 
             void DirectoryWatcher::setCallback(const std::function<void(void)>& value)
@@ -327,8 +533,21 @@ namespace djv
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
+            void DirectoryWatcher::Private::wake()
+            {
+                if (wakeFD[1] != -1)
+                {
+                    const char c = 0;
+                    const ssize_t r = ::write(wakeFD[1], &c, 1);
+                    (void)r;
+                }
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
-
-
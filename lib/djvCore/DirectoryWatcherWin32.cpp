@@ -36,7 +36,6 @@
 
 #include <atomic>
 #include <codecvt>
-#include <condition_variable>
 #include <locale>
 #include <mutex>
 #include <thread>
@@ -55,100 +54,151 @@ namespace djv
     {
         namespace FileSystem
         {
+            namespace
+            {
+                //! \todo Should these be configurable?
+                const std::chrono::milliseconds debounceTimeout(250);
+                const std::chrono::milliseconds debounceTimeoutMax(1000);
+
+            } // namespace
+
+            //! \todo Per-file changes are not supported on this platform, any change
+            //! to the directory is reported as a reset. ReadDirectoryChangesW() could
+            //! be used to provide the individual changes.
             struct DirectoryWatcher::Private
             {
                 Path path;
-                bool changed = false;
-                std::condition_variable changedCV;
+                bool recursive = false;
+                bool pathChanged = false;
+                DirectoryChanges changes;
+                std::chrono::steady_clock::time_point changesStart;
+                std::chrono::steady_clock::time_point changesLast;
                 std::mutex mutex;
+                HANDLE wakeEvent = NULL;
                 std::thread thread;
                 std::atomic<bool> running = true;
                 std::function<void(void)> callback;
+                std::function<void(const std::vector<DirectoryChange>&)> changesCallback;
                 std::shared_ptr<Time::Timer> timer;
             };
 
             void DirectoryWatcher::_init(const std::shared_ptr<Context>& context)
             {
                 DJV_PRIVATE_PTR();
-                const auto timeout = Time::getValue(Time::TimerValue::Medium);
+
+                // The thread blocks until there are changes, or until it is woken
+                // up by the main thread with an event.
+                p.wakeEvent = CreateEventW(NULL, FALSE, FALSE, NULL);
+
                 auto contextWeak = std::weak_ptr<Context>(context);
-                _p->thread = std::thread(
-                    [this, timeout, contextWeak]
+                p.thread = std::thread(
+                    [this, contextWeak]
                 {
                     DJV_PRIVATE_PTR();
                     Path path;
-                    HANDLE changeHandle = 0;
+                    HANDLE changeHandle = INVALID_HANDLE_VALUE;
                     while (p.running)
                     {
                         bool pathChanged = false;
+                        bool recursive = false;
                         {
                             std::lock_guard<std::mutex> lock(p.mutex);
-                            if (p.path != path)
+                            if (p.pathChanged)
                             {
                                 path = p.path;
+                                recursive = p.recursive;
+                                p.pathChanged = false;
                                 pathChanged = true;
                             }
                         }
                         if (pathChanged)
                         {
-                            if (changeHandle)
+                            if (changeHandle != INVALID_HANDLE_VALUE)
                             {
                                 FindCloseChangeNotification(changeHandle);
+                                changeHandle = INVALID_HANDLE_VALUE;
                             }
-                            try
+                            if (!path.isEmpty())
                             {
-                                std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
-                                changeHandle = FindFirstChangeNotificationW(
-                                    utf16.from_bytes(path.get()).c_str(),
-                                    FALSE,
-                                    FILE_NOTIFY_CHANGE_FILE_NAME |
-                                    FILE_NOTIFY_CHANGE_DIR_NAME |
-                                    FILE_NOTIFY_CHANGE_SIZE |
-                                    FILE_NOTIFY_CHANGE_LAST_WRITE);
-                                if (INVALID_HANDLE_VALUE == changeHandle)
+                                try
+                                {
+                                    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16;
+                                    changeHandle = FindFirstChangeNotificationW(
+                                        utf16.from_bytes(path.get()).c_str(),
+                                        recursive ? TRUE : FALSE,
+                                        FILE_NOTIFY_CHANGE_FILE_NAME |
+                                        FILE_NOTIFY_CHANGE_DIR_NAME |
+                                        FILE_NOTIFY_CHANGE_SIZE |
+                                        FILE_NOTIFY_CHANGE_LAST_WRITE);
+                                    if (INVALID_HANDLE_VALUE == changeHandle)
+                                    {
+                                        if (auto context = contextWeak.lock())
+                                        {
+                                            auto logSystem = context->getSystemT<LogSystem>();
+                                            std::stringstream ss;
+                                            ss << DJV_TEXT("Error finding the change notification for") <<
+                                                " '" << path << "'. " << Error::getLastError();
+                                            logSystem->log("djv::Core::FileSystem::DirectoryWatcher", ss.str(), LogLevel::Error);
+                                        }
+                                    }
+                                }
+                                catch (const std::exception & e)
                                 {
                                     if (auto context = contextWeak.lock())
                                     {
                                         auto logSystem = context->getSystemT<LogSystem>();
                                         std::stringstream ss;
-                                        ss << DJV_TEXT("Error finding the change notification for") <<
-                                            " '" << path << "'. " << Error::getLastError();
+                                        ss << DJV_TEXT("Error watching the directory") <<
+                                            " '" << path << "'. " << e.what();
                                         logSystem->log("djv::Core::FileSystem::DirectoryWatcher", ss.str(), LogLevel::Error);
                                     }
                                 }
                             }
-                            catch (const std::exception & e)
-                            {
-                                if (auto context = contextWeak.lock())
-                                {
-                                    auto logSystem = context->getSystemT<LogSystem>();
-                                    std::stringstream ss;
-                                    ss << DJV_TEXT("Error watching the directory") <<
-                                        " '" << path << "'. " << e.what();
-                                    logSystem->log("djv::Core::FileSystem::DirectoryWatcher", ss.str(), LogLevel::Error);
-                                }
-                            }
                         }
 
-                        if (changeHandle && changeHandle != INVALID_HANDLE_VALUE)
+                        HANDLE handles[2];
+                        DWORD handlesCount = 0;
+                        DWORD changeIndex = MAXDWORD;
+                        if (p.wakeEvent)
                         {
-                            const DWORD status = WaitForSingleObject(changeHandle, 0);
-                            switch (status)
+                            handles[handlesCount++] = p.wakeEvent;
+                        }
+                        if (changeHandle != INVALID_HANDLE_VALUE)
+                        {
+                            changeIndex = handlesCount;
+                            handles[handlesCount++] = changeHandle;
+                        }
+                        DWORD status = WAIT_TIMEOUT;
+                        if (handlesCount)
+                        {
+                            status = WaitForMultipleObjects(
+                                handlesCount,
+                                handles,
+                                FALSE,
+                                p.wakeEvent ? INFINITE : static_cast<DWORD>(Time::getValue(Time::TimerValue::Medium)));
+                        }
+                        else
+                        {
+                            std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Medium));
+                        }
+                        if (changeIndex != MAXDWORD && WAIT_OBJECT_0 + changeIndex == status)
+                        {
+                            FindNextChangeNotification(changeHandle);
+                            std::lock_guard<std::mutex> lock(p.mutex);
+                            if (!p.pathChanged)
                             {
-                            case WAIT_OBJECT_0:
-                                FindNextChangeNotification(changeHandle);
+                                const auto now = std::chrono::steady_clock::now();
+                                if (p.changes.isEmpty())
                                 {
-                                    std::lock_guard<std::mutex> lock(p.mutex);
-                                    p.changed = true;
+                                    p.changesStart = now;
                                 }
-                                break;
+                                p.changesLast = now;
+                                p.changes.add(DirectoryChange());
                             }
                         }
-
-                        std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
                     }
 
-                    if (changeHandle)
+                    if (changeHandle != INVALID_HANDLE_VALUE)
                     {
                         FindCloseChangeNotification(changeHandle);
                     }
@@ -157,28 +207,36 @@ namespace djv
                 p.timer = Time::Timer::create(context);
                 p.timer->setRepeating(true);
                 p.timer->start(
-                    std::chrono::milliseconds(timeout),
+                    Time::getMilliseconds(Time::TimerValue::Medium),
                     [this](float)
                 {
                     DJV_PRIVATE_PTR();
-                    bool changed = false;
+                    std::vector<DirectoryChange> changes;
                     {
-                        std::unique_lock<std::mutex> lock(p.mutex);
-                        if (p.changedCV.wait_for(
-                            lock,
-                            std::chrono::milliseconds(0),
-                            [this]
-                        {
-                            return _p->changed;
-                        }))
+                        std::lock_guard<std::mutex> lock(p.mutex);
+                        if (!p.changes.isEmpty())
                         {
-                            changed = true;
-                            p.changed = false;
+                            // Wait for the directory to be quiet before delivering the
+                            // changes, unless they have been pending for too long.
+                            const auto now = std::chrono::steady_clock::now();
+                            if (now - p.changesLast >= debounceTimeout ||
+                                now - p.changesStart >= debounceTimeoutMax)
+                            {
+                                changes = p.changes.get();
+                                p.changes.clear();
+                            }
                         }
                     }
-                    if (changed && p.callback)
+                    if (changes.size())
                     {
-                        p.callback();
+                        if (p.changesCallback)
+                        {
+                            p.changesCallback(changes);
+                        }
+                        if (p.callback)
+                        {
+                            p.callback();
+                        }
                     }
                 });
             }
@@ -191,10 +249,18 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 p.running = false;
+                if (p.wakeEvent)
+                {
+                    SetEvent(p.wakeEvent);
+                }
                 if (p.thread.joinable())
                 {
                     p.thread.join();
                 }
+                if (p.wakeEvent)
+                {
+                    CloseHandle(p.wakeEvent);
+                }
             }
 
             std::shared_ptr<DirectoryWatcher> DirectoryWatcher::create(const std::shared_ptr<Context>& context)
@@ -212,24 +278,52 @@ namespace djv
             void DirectoryWatcher::setPath(const Path & value)
             {
                 DJV_PRIVATE_PTR();
-                if (value == p.path)
-                    return;
                 {
                     std::lock_guard<std::mutex> lock(p.mutex);
+                    if (value == p.path)
+                        return;
                     p.path = value;
-                    p.changed = true;
+                    p.pathChanged = true;
+                    p.changes.clear();
+                }
+                if (p.wakeEvent)
+                {
+                    SetEvent(p.wakeEvent);
+                }
+            }
+
+            void DirectoryWatcher::setRecursive(bool value)
+            {
+                DJV_PRIVATE_PTR();
+                {
+                    std::lock_guard<std::mutex> lock(p.mutex);
+                    if (value == p.recursive)
+                        return;
+                    p.recursive = value;
+                    p.pathChanged = true;
+                    p.changes.clear();
                 }
-                if (p.callback)
+                if (p.wakeEvent)
                 {
-                    p.callback();
+                    SetEvent(p.wakeEvent);
                 }
             }
 
+            bool DirectoryWatcher::isRecursive() const
+            {
+                return _p->recursive;
+            }
+
             void DirectoryWatcher::setCallback(const std::function<void(void)> & value)
             {
                 _p->callback = value;
             }
 
+            void DirectoryWatcher::setChangesCallback(const std::function<void(const std::vector<DirectoryChange>&)>& value)
+            {
+                _p->changesCallback = value;
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
@@ -29,6 +29,8 @@
 
 #include <djvCore/FileInfo.h>
 
+#include <djvCore/String.h>
+
 //#pragma optimize("", off)
 
 namespace djv
@@ -68,11 +70,11 @@ namespace djv
                         ss << _path.getDirectoryName();
                     }
                     ss << _path.getBaseName();
-                    if (FileType::Sequence == _type && _sequence.ranges.size() && frame != Frame::invalid)
+                    if (FileType::Sequence == _type && _sequence.getRanges().size() && frame != Frame::invalid)
                     {
                         ss << Frame::toString(frame, _sequence.pad);
                     }
-                    else if (FileType::Sequence == _type && _sequence.ranges.size())
+                    else if (FileType::Sequence == _type && _sequence.getRanges().size())
                     {
                         ss << _sequence;
                     }
@@ -85,6 +87,20 @@ namespace djv
                 return ss.str();
             }
 
+            std::vector<std::string> FileInfo::getFileNames(bool path) const
+            {
+                std::vector<std::string> out;
+                if (FileType::Sequence == _type && _sequence.getRanges().size())
+                {
+                    out = FileNameTemplate(*this, path).toFileNames(_sequence);
+                }
+                else
+                {
+                    out.push_back(getFileName(Frame::invalid, path));
+                }
+                return out;
+            }
+
             void FileInfo::setPath(const Path& value, bool stat)
             {
                 _path           = value;
@@ -152,7 +168,7 @@ namespace djv
                         std::stringstream ss(_path.getNumber());
                         ss.exceptions(std::istream::failbit | std::istream::badbit);
                         ss >> _sequence;
-                        if (_sequence.ranges.size())
+                        if (_sequence.getRanges().size())
                         {
                             _type = FileType::Sequence;
                         }
@@ -188,6 +204,132 @@ namespace djv
                 return FileInfo(path);
             }
 
+            bool FileInfo::directoryListUpdate(
+                std::vector<FileInfo>& out,
+                const std::vector<Path>& created,
+                const std::vector<Path>& removed,
+                const std::vector<Path>& modified,
+                const DirectoryListOptions& options)
+            {
+                // Remove files.
+                for (const auto& path : removed)
+                {
+                    const auto i = std::find_if(
+                        out.begin(),
+                        out.end(),
+                        [&path](const FileInfo& value)
+                        {
+                            return value.getType() != FileType::Sequence && value.getPath() == path;
+                        });
+                    if (i != out.end())
+                    {
+                        out.erase(i);
+                    }
+                    else if (options.fileSequences)
+                    {
+                        // Removing frames from a file sequence requires listing
+                        // the directory again.
+                        FileInfo fileInfo(path, FileType::File, false);
+                        fileInfo.evalSequence();
+                        if (fileInfo.isSequenceValid())
+                        {
+                            const Frame::Number frame = fileInfo.getSequence().getFrame(0);
+                            for (const auto& j : out)
+                            {
+                                if (j.isCompatible(fileInfo) && j.getSequence().contains(frame))
+                                {
+                                    return false;
+                                }
+                            }
+                        }
+                    }
+                }
+
+                // Update modified files.
+                for (const auto& path : modified)
+                {
+                    for (auto& i : out)
+                    {
+                        if (i.getType() != FileType::Sequence && i.getPath() == path)
+                        {
+                            i.stat();
+                            break;
+                        }
+                    }
+                }
+
+                // Add new files.
+                for (const auto& path : created)
+                {
+                    FileInfo fileInfo(path);
+                    if (!fileInfo.doesExist())
+                        continue;
+                    const std::string fileName = fileInfo.getFileName(Frame::invalid, false);
+                    if (_filter(
+                        fileName,
+                        fileName.size() > 0 && '.' == fileName[0],
+                        FileType::Directory == fileInfo.getType(),
+                        options))
+                        continue;
+                    const auto i = std::find_if(
+                        out.begin(),
+                        out.end(),
+                        [&path](const FileInfo& value)
+                        {
+                            return value.getType() != FileType::Sequence && value.getPath() == path;
+                        });
+                    if (i != out.end())
+                    {
+                        *i = fileInfo;
+                    }
+                    else
+                    {
+                        _fileSequence(fileInfo, options, out);
+                    }
+                }
+
+                _sort(options, out);
+                return true;
+            }
+
+            bool FileInfo::_filter(const std::string& fileName, bool hidden, bool directory, const DirectoryListOptions& options)
+            {
+                bool out = false;
+                if (hidden)
+                {
+                    out = !options.showHidden;
+                }
+                if (fileName.size() == 1 && '.' == fileName[0])
+                {
+                    out = true;
+                }
+                if (fileName.size() == 2 && '.' == fileName[0] && '.' == fileName[1])
+                {
+                    out = true;
+                }
+                if (options.filter.size() && !String::match(fileName, options.filter))
+                {
+                    out = true;
+                }
+                if (!out && !directory && options.fileExtensions.size())
+                {
+                    bool match = false;
+                    for (const auto& i : options.fileExtensions)
+                    {
+                        if (String::match(fileName, '\\' + i + '$'))
+                        {
+                            match = true;
+                            break;
+                        }
+                    }
+                    if (!match)
+                    {
+                        out = true;
+                    }
+                }
+                return out;
+            }
+
             void FileInfo::_fileSequence(FileInfo& fileInfo, const DirectoryListOptions& options, std::vector<FileInfo>& out)
             {
                 std::string extension = fileInfo.getPath().getExtension();
@@ -277,6 +419,57 @@ namespace djv
                 }
             }
 
+            FileNameTemplate::FileNameTemplate()
+            {}
+
+            FileNameTemplate::FileNameTemplate(const FileInfo& fileInfo, bool path)
+            {
+                const Path& filePath = fileInfo.getPath();
+                _fileName = fileInfo.getFileName(Frame::invalid, path);
+                const bool isRoot = std::string(1, Path::getCurrentSeparator()) == filePath.get();
+                if (!isRoot && FileType::Sequence == fileInfo.getType() && fileInfo.getSequence().getRanges().size())
+                {
+                    _isSequence = true;
+                    if (path)
+                    {
+                        _prefix = filePath.getDirectoryName();
+                    }
+                    _prefix += filePath.getBaseName();
+                    _suffix = filePath.getExtension();
+                    _pad = fileInfo.getSequence().pad;
+                }
+            }
+
+            std::vector<std::string> FileNameTemplate::toFileNames(const Frame::Range& value) const
+            {
+                std::vector<std::string> out;
+                if (value.max >= value.min)
+                {
+                    out.resize(value.max - value.min + 1);
+                    auto i = out.begin();
+                    for (auto frame = value.min; frame <= value.max; ++frame, ++i)
+                    {
+                        get(frame, *i);
+                    }
+                }
+                return out;
+            }
+
+            std::vector<std::string> FileNameTemplate::toFileNames(const Frame::Sequence& value) const
+            {
+                std::vector<std::string> out;
+                out.reserve(value.getSize());
+                for (const auto& range : value.getRanges())
+                {
+                    for (auto frame = range.min; frame <= range.max; ++frame)
+                    {
+                        out.emplace_back();
+                        get(frame, out.back());
+                    }
+                }
+                return out;
+            }
+
         } // namespace FileSystem
     } // namespace Core
 
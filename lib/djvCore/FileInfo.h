@@ -134,6 +134,11 @@ namespace djv
                 //! \param path Include the path in the file name.
                 std::string getFileName(Frame::Number frame = Frame::invalid, bool path = true) const;
 
+                //! Get the file names for every frame of the sequence, or the
+                //! file name if this is not a sequence.
+                //! \param path Include the path in the file names.
+                std::vector<std::string> getFileNames(bool path = true) const;
+
                 //! Get whether this file exists.
                 bool doesExist() const;
 
@@ -173,6 +178,17 @@ namespace djv
                 //! Get the contents of the given directory.
                 static std::vector<FileInfo> directoryList(const Path& path, const DirectoryListOptions& options = DirectoryListOptions());
 
+                //! Update the contents of a directory listing with the files that
+                //! have been created, removed, or modified. Returns false if the
+                //! listing cannot be updated (for example when a frame is removed
+                //! from a file sequence) and the directory should be listed again.
+                static bool directoryListUpdate(
+                    std::vector<FileInfo>&,
+                    const std::vector<Path>& created,
+                    const std::vector<Path>& removed,
+                    const std::vector<Path>& modified,
+                    const DirectoryListOptions& options = DirectoryListOptions());
+
                 //! Get the file sequence for the given file.
                 static FileInfo getFileSequence(const Path &, const std::set<std::string>& extensions);
 
@@ -185,6 +201,7 @@ namespace djv
                 explicit operator std::string() const;
 
             private:
+                static bool _filter(const std::string& fileName, bool hidden, bool directory, const DirectoryListOptions&);
                 static void _fileSequence(FileInfo&, const DirectoryListOptions&, std::vector<FileInfo>&);
                 static void _sort(const DirectoryListOptions&, std::vector<FileInfo>&);
                 
@@ -197,6 +214,48 @@ namespace djv
                 time_t          _time        = 0;
                 Frame::Sequence _sequence;
             };
+
+            //! This class provides a template for generating the file names of a
+            //! file sequence.
+            //!
+            //! The parts of the file name that are the same for every frame are
+            //! computed once, so generating the file name for a frame only needs to
+            //! format the frame number. The file names are the same as the ones
+            //! returned by FileInfo::getFileName().
+            class FileNameTemplate
+            {
+            public:
+                FileNameTemplate();
+                explicit FileNameTemplate(const FileInfo&, bool path = true);
+
+                //! Get the file name for the given frame. The returned string is
+                //! reused by the next call, so no memory is allocated once it is
+                //! large enough.
+                const std::string& get(Frame::Number);
+
+                //! Get the file name for the given frame. The string is
+                //! overwritten, so its memory can be reused between calls.
+                void get(Frame::Number, std::string&) const;
+
+                //! \name Conversion
+                ///@{
+
+                std::vector<std::string> toFileNames(const Frame::Range&) const;
+                std::vector<std::string> toFileNames(const Frame::Sequence&) const;
+
+                ///@}
+
+            private:
+                void _appendFrame(Frame::Number, std::string&) const;
+
+                bool        _isSequence = false;
+                std::string _fileName;
+                std::string _prefix;
+                std::string _suffix;
+                size_t      _pad        = 0;
+                std::string _buffer;
+            };
+
         } // namespace Core
 
     } // namespace FileSystem
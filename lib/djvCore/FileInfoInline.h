@@ -101,7 +101,7 @@ namespace djv
                 return
                     _type != FileType::Directory &&
                     !_path.getNumber().empty() &&
-                    _sequence.ranges.size();
+                    _sequence.getRanges().size();
             }
 
             inline bool FileInfo::isSequenceWildcard() const
@@ -126,12 +126,9 @@ namespace djv
             {
                 if (isCompatible(value))
                 {
-                    for (const auto& range : value._sequence.ranges)
+                    for (const auto& range : value._sequence.getRanges())
                     {
-                        if (!_sequence.merge(range))
-                        {
-                            _sequence.ranges.push_back(range);
-                        }
+                        _sequence.add(range);
                     }
                     if (value._sequence.pad > _sequence.pad)
                     {
@@ -177,6 +174,52 @@ namespace djv
                 return std::string(_path);
             }
 
+            inline const std::string& FileNameTemplate::get(Frame::Number frame)
+            {
+                get(frame, _buffer);
+                return _buffer;
+            }
+
+            inline void FileNameTemplate::get(Frame::Number frame, std::string& out) const
+            {
+                if (_isSequence && frame != Frame::invalid)
+                {
+                    out.assign(_prefix);
+                    _appendFrame(frame, out);
+                    out.append(_suffix);
+                }
+                else
+                {
+                    out.assign(_fileName);
+                }
+            }
+
+            inline void FileNameTemplate::_appendFrame(Frame::Number frame, std::string& out) const
+            {
+                // This matches the formatting of Frame::toString(), the padding
+                // does not include the sign.
+                const bool negative = frame < 0;
+                uint64_t abs = negative ? (0 - static_cast<uint64_t>(frame)) : static_cast<uint64_t>(frame);
+                char c[20];
+                char* p = c + 20;
+                size_t length = 0;
+                do
+                {
+                    *--p = '0' + static_cast<char>(abs % 10);
+                    abs /= 10;
+                    ++length;
+                } while (abs);
+                if (negative)
+                {
+                    out.push_back('-');
+                }
+                if (_pad > length)
+                {
+                    out.append(_pad - length, '0');
+                }
+                out.append(p, length);
+            }
+
         } // namespace FileSystem
     } // namespace Core
 } // namespace djv
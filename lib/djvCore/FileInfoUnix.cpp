@@ -140,40 +140,11 @@ namespace djv
                         
                         const std::string fileName = fileInfo.getFileName(-1, false);
                         
-                        bool filter = false;
-                        if (fileName.size() > 0 && '.' == fileName[0])
-                        {
-                            filter = !options.showHidden;
-                        }
-                        if (fileName.size() == 1 && '.' == fileName[0])
-                        {
-                            filter = true;
-                        }
-                        if (fileName.size() == 2 && '.' == fileName[0] && '.' == fileName[1])
-                        {
-                            filter = true;
-                        }
-                        if (options.filter.size() && !String::match(fileName, options.filter))
-                        {
-                            filter = true;
-                        }
-                        if (!filter && !(de->d_type & DT_DIR) && options.fileExtensions.size())
-                        {
-                            bool match = false;
-                            for (const auto& i : options.fileExtensions)
-                            {
-                                if (String::match(fileName, '\\' + i + '$'))
-                                {
-                                    match = true;
-                                    break;
-                                }
-                            }
-                            if (!match)
-                            {
-                                filter = true;
-                            }
-                        }
-
+                        const bool filter = _filter(
+                            fileName,
+                            fileName.size() > 0 && '.' == fileName[0],
+                            de->d_type & DT_DIR,
+                            options);
                         if (!filter)
                         {
                             _fileSequence(fileInfo, options, out);
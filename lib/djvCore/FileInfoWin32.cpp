@@ -138,40 +138,11 @@ namespace djv
                         {
                             const std::string fileName = utf16.to_bytes(ffd.cFileName);
 
-                            bool filter = false;
-                            if (ffd.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN)
-                            {
-                                filter = !options.showHidden;
-                            }
-                            if (fileName.size() == 1 && '.' == fileName[0])
-                            {
-                                filter = true;
-                            }
-                            if (fileName.size() == 2 && '.' == fileName[0] && '.' == fileName[1])
-                            {
-                                filter = true;
-                            }
-                            if (options.filter.size() && !String::match(fileName, options.filter))
-                            {
-                                filter = true;
-                            }
-                            if (!filter &&!(ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) && options.fileExtensions.size())
-                            {
-                                bool match = false;
-                                for (const auto& i : options.fileExtensions)
-                                {
-                                    if (String::match(fileName, '\\' + i + '$'))
-                                    {
-                                        match = true;
-                                        break;
-                                    }
-                                }
-                                if (!match)
-                                {
-                                    filter = true;
-                                }
-                            }
-
+                            const bool filter = _filter(
+                                fileName,
+                                ffd.dwFileAttributes & FILE_ATTRIBUTE_HIDDEN,
+                                ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY,
+                                options);
                             if (!filter)
                             {
                                 FileInfo fileInfo(Path(value, fileName));
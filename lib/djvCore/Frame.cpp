@@ -40,73 +40,161 @@ namespace djv
     {
         namespace Frame
         {
+            namespace
+            {
+                inline Index getRangeSize(const Range& value)
+                {
+                    return value.min < value.max ?
+                        (value.max - value.min + 1) :
+                        (value.min - value.max + 1);
+                }
+
+            } // namespace
+
             void Sequence::sort()
             {
-                for (auto & range : ranges)
+                for (auto & range : _ranges)
                 {
                     Frame::sort(range);
                 }
 
-                std::sort(ranges.begin(), ranges.end());
+                std::sort(_ranges.begin(), _ranges.end());
 
-                if (ranges.size())
+                // Combine the ranges that intersect or are adjacent. Since the
+                // ranges are sorted only the last combined range needs to be
+                // checked.
+                if (_ranges.size())
                 {
                     std::vector<Range> tmp;
-                    tmp.push_back(ranges[0]);
-                    for (size_t i = 1; i < ranges.size(); ++i)
+                    tmp.reserve(_ranges.size());
+                    tmp.push_back(_ranges[0]);
+                    for (size_t i = 1; i < _ranges.size(); ++i)
                     {
-                        const size_t tmpSize = tmp.size();
-                        size_t j = 0;
-                        for (; j < tmpSize; ++j)
+                        auto& back = tmp.back();
+                        if (_ranges[i].min <= back.max + 1)
                         {
-                            if (ranges[i].min == tmp[j].max + 1)
-                            {
-                                tmp[j].max = ranges[i].max;
-                                break;
-                            }
-                            else if (ranges[i].intersects(tmp[j]))
-                            {
-                                tmp[j].expand(ranges[i]);
-                                break;
-                            }
+                            back.max = std::max(back.max, _ranges[i].max);
                         }
-                        if (tmpSize == j)
+                        else
                         {
-                            tmp.push_back(ranges[i]);
+                            tmp.push_back(_ranges[i]);
                         }
                     }
-                    ranges = tmp;
+                    _ranges = std::move(tmp);
                 }
+                _sorted = true;
+                _indexUpdate();
             }
             
             bool Sequence::merge(const Range& value)
             {
                 bool out = false;
-                for (auto& i : ranges)
+                if (_sorted && value.min <= value.max)
                 {
-                    if (i.intersects(value))
+                    // Find the first range that ends at or after the frame
+                    // before the value.
+                    auto i = std::lower_bound(
+                        _ranges.begin(),
+                        _ranges.end(),
+                        value.min,
+                        [](const Range& range, Number value)
+                        {
+                            return range.max + 1 < value;
+                        });
+                    if (i != _ranges.end() && i->min <= value.max + 1)
                     {
-                        i.min = std::min(i.min, value.min);
-                        i.max = std::max(i.max, value.max);
+                        i->min = std::min(i->min, value.min);
+                        i->max = std::max(i->max, value.max);
+
+                        // Combine the following ranges that now intersect or
+                        // are adjacent.
+                        auto j = i + 1;
+                        for (; j != _ranges.end() && j->min <= i->max + 1; ++j)
+                        {
+                            i->max = std::max(i->max, j->max);
+                        }
+                        _ranges.erase(i + 1, j);
                         out = true;
-                        break;
                     }
-                    if (value.max == i.min - 1)
+                }
+                else
+                {
+                    for (auto& i : _ranges)
                     {
-                        i.min = value.min;
-                        out = true;
-                        break;
+                        if (i.intersects(value))
+                        {
+                            i.min = std::min(i.min, value.min);
+                            i.max = std::max(i.max, value.max);
+                            out = true;
+                            break;
+                        }
+                        if (value.max == i.min - 1)
+                        {
+                            i.min = value.min;
+                            out = true;
+                            break;
+                        }
+                        if (value.min == i.max + 1)
+                        {
+                            i.max = value.max;
+                            out = true;
+                            break;
+                        }
                     }
-                    if (value.min == i.max + 1)
+                    if (out)
                     {
-                        i.max = value.max;
-                        out = true;
-                        break;
+                        _sortedUpdate();
                     }
                 }
+                if (out)
+                {
+                    _indexUpdate();
+                }
                 return out;
             }
 
+            void Sequence::add(const Range& value)
+            {
+                if (!merge(value))
+                {
+                    if (_sorted && value.min <= value.max)
+                    {
+                        // The range does not intersect any of the existing ranges
+                        // so inserting it in order keeps the sequence sorted.
+                        _ranges.insert(std::upper_bound(_ranges.begin(), _ranges.end(), value), value);
+                        _indexUpdate();
+                    }
+                    else
+                    {
+                        addRange(value);
+                    }
+                }
+            }
+
+            void Sequence::_sortedUpdate()
+            {
+                _sorted = true;
+                const size_t size = _ranges.size();
+                for (size_t i = 0; i < size && _sorted; ++i)
+                {
+                    const auto& range = _ranges[i];
+                    _sorted = range.min <= range.max && (0 == i || range.min > _ranges[i - 1].max);
+                }
+            }
+
+            void Sequence::_indexUpdate()
+            {
+                const size_t size = _ranges.size();
+                _offsets.resize(size);
+                Index offset = 0;
+                for (size_t i = 0; i < size; ++i)
+                {
+                    _offsets[i] = offset;
+                    offset += getRangeSize(_ranges[i]);
+                }
+                _size = static_cast<size_t>(offset);
+            }
+
             void sort(Range & out)
             {
                 const auto _min = std::min(out.min, out.max);
@@ -117,7 +205,7 @@ namespace djv
             
             Sequence fromFrames(const std::vector<Number> & frames)
             {
-                Sequence out;
+                std::vector<Range> ranges;
                 const size_t size = frames.size();
                 if (size)
                 {
@@ -128,20 +216,20 @@ namespace djv
                     {
                         if (frames[i] != prevFrame + 1)
                         {
-                            out.ranges.push_back(Range(rangeStart, prevFrame));
+                            ranges.push_back(Range(rangeStart, prevFrame));
                             rangeStart = frames[i];
                         }
                     }
                     if (size > 1)
                     {
-                        out.ranges.push_back(Range(rangeStart, prevFrame));
+                        ranges.push_back(Range(rangeStart, prevFrame));
                     }
                     else
                     {
-                        out.ranges.push_back(Range(rangeStart));
+                        ranges.push_back(Range(rangeStart));
                     }
                 }
-                return out;
+                return Sequence(ranges);
             }
 
         } // namespace Frame
@@ -150,7 +238,7 @@ namespace djv
     std::ostream & operator << (std::ostream & s, const Core::Frame::Sequence & value)
     {
         std::vector<std::string> pieces;
-        for (const auto & range : value.ranges)
+        for (const auto & range : value.getRanges())
         {
             pieces.push_back(Core::Frame::toString(range, value.pad));
         }
@@ -174,7 +262,7 @@ namespace djv
         {
             Core::Frame::Range range;
             Core::Frame::fromString(piece, range, pad);
-            out.ranges.push_back(range);
+            out.addRange(range);
             out.pad = std::max(pad, out.pad);
         }
         return s;
@@ -58,6 +58,12 @@ namespace djv
             
             //! This class provides a sequence of frame numbers. A sequence is
             //! composed of multiple frame number ranges (e.g., 1-10,20-30).
+            //!
+            //! The sequence keeps an index of where each range starts so that
+            //! converting between frame numbers and indices does not need to
+            //! walk the ranges. The ranges can only be modified through the
+            //! member functions, which rebuild the index, so the const
+            //! functions are safe to call from multiple threads.
             class Sequence
             {
             public:
@@ -67,9 +73,17 @@ namespace djv
                 explicit Sequence(const Range& range, size_t pad = 0);
                 explicit Sequence(const std::vector<Range>& ranges, size_t pad = 0);
 
-                std::vector<Range> ranges;
                 size_t pad = 0;
 
+                //! \name Ranges
+                ///@{
+
+                const std::vector<Range>& getRanges() const;
+                void setRanges(const std::vector<Range>&);
+                void addRange(const Range&);
+
+                ///@}
+
                 bool isValid() const;
                 bool contains(Index) const;
                 size_t getSize() const;
@@ -82,12 +96,28 @@ namespace djv
                 //! Sort the sequence so that the frame numbers are in ascending order.
                 void sort();
                 
+                //! Merge the range with an existing range that it intersects or
+                //! is adjacent to. Returns false if there is no such range.
                 bool merge(const Range&);
+
+                //! Merge the range with the existing ranges, or add it if it
+                //! cannot be merged. A sorted sequence stays sorted.
+                void add(const Range&);
                 
                 ///@}
 
                 bool operator == (const Sequence&) const;
                 bool operator != (const Sequence&) const;
+
+            private:
+                std::vector<Range>::const_iterator _findRange(Number) const;
+                void _sortedUpdate();
+                void _indexUpdate();
+
+                std::vector<Range> _ranges;
+                bool _sorted = true;
+                std::vector<Index> _offsets;
+                size_t _size = 0;
             };
 
             //! \name Utilities
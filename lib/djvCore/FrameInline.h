@@ -29,6 +29,8 @@
 
 #include <djvCore/Math.h>
 
+#include <algorithm>
+
 namespace djv
 {
     namespace Core
@@ -50,40 +52,71 @@ namespace djv
        
             inline Sequence::Sequence(Number number)
             {
-                ranges.push_back(Range(number));
+                addRange(Range(number));
             }
        
             inline Sequence::Sequence(Number min, Number max, size_t pad) :
                 pad(pad)
             {
-                ranges.push_back(Range(min, max));
+                addRange(Range(min, max));
             }
 
             inline Sequence::Sequence(const Range & range, size_t pad) :
                 pad(pad)
             {
-                ranges.push_back(range);
+                addRange(range);
             }
 
             inline Sequence::Sequence(const std::vector<Range> & ranges, size_t pad) :
-                ranges(ranges),
                 pad(pad)
-            {}
+            {
+                setRanges(ranges);
+            }
+
+            inline const std::vector<Range>& Sequence::getRanges() const
+            {
+                return _ranges;
+            }
+
+            inline void Sequence::setRanges(const std::vector<Range>& value)
+            {
+                _ranges = value;
+                _sortedUpdate();
+                _indexUpdate();
+            }
+
+            inline void Sequence::addRange(const Range& value)
+            {
+                if (_sorted)
+                {
+                    _sorted = value.min <= value.max && (_ranges.empty() || value.min > _ranges.back().max);
+                }
+                _offsets.push_back(_size);
+                _size += value.min < value.max ? (value.max - value.min + 1) : (value.min - value.max + 1);
+                _ranges.push_back(value);
+            }
 
             inline bool Sequence::isValid() const
             {
-                return ranges.size() > 0;
+                return _ranges.size() > 0;
             }
 
             inline bool Sequence::contains(Index value) const
             {
                 bool out = false;
-                for (const auto& i : ranges)
+                if (_sorted)
                 {
-                    if (i.contains(value))
+                    out = _findRange(value) != _ranges.end();
+                }
+                else
+                {
+                    for (const auto& i : _ranges)
                     {
-                        out = true;
-                        break;
+                        if (i.contains(value))
+                        {
+                            out = true;
+                            break;
+                        }
                     }
                 }
                 return out;
@@ -91,33 +124,16 @@ namespace djv
 
             inline size_t Sequence::getSize() const
             {
-                size_t out = 0;
-                for (const auto& i : ranges)
-                {
-                    if (i.min < i.max)
-                    {
-                        out += i.max - i.min + 1;
-                    }
-                    else
-                    {
-                        out += i.min - i.max + 1;
-                    }
-                }
-                return out;
+                return _size;
             }
 
             inline Number Sequence::getFrame(Index value) const
             {
                 Number out = invalid;
-                for (const auto& j : ranges)
+                if (value >= 0 && value < static_cast<Index>(_size))
                 {
-                    const size_t size = j.max - j.min + 1;
-                    if (value < size)
-                    {
-                        out = j.min + value;
-                        break;
-                    }
-                    value -= size;
+                    const auto i = std::upper_bound(_offsets.begin(), _offsets.end(), value) - 1;
+                    out = _ranges[i - _offsets.begin()].min + value - *i;
                 }
                 return out;
             }
@@ -125,22 +141,32 @@ namespace djv
             inline Index Sequence::getIndex(Number value) const
             {
                 Index out = invalidIndex;
-                Index tmp = 0;
-                for (const auto& j : ranges)
+                if (_sorted)
                 {
-                    if (j.contains(value))
+                    const auto i = _findRange(value);
+                    if (i != _ranges.end())
                     {
-                        out = tmp + value - j.min;
-                        break;
+                        out = _offsets[i - _ranges.begin()] + value - i->min;
+                    }
+                }
+                else
+                {
+                    const size_t size = _ranges.size();
+                    for (size_t i = 0; i < size; ++i)
+                    {
+                        if (_ranges[i].contains(value))
+                        {
+                            out = _offsets[i] + value - _ranges[i].min;
+                            break;
+                        }
                     }
-                    tmp += j.max - j.min + 1;
                 }
                 return out;
             }
 
             inline bool Sequence::operator == (const Sequence & value) const
             {
-                return ranges == value.ranges && pad == value.pad;
+                return _ranges == value._ranges && pad == value.pad;
             }
 
             inline bool Sequence::operator != (const Sequence & value) const
@@ -148,6 +174,29 @@ namespace djv
                 return !(*this == value);
             }
 
+            inline std::vector<Range>::const_iterator Sequence::_findRange(Number value) const
+            {
+                // The ranges are sorted and do not overlap, so the range that
+                // may contain the value is the last one that starts before it.
+                auto out = std::upper_bound(
+                    _ranges.begin(),
+                    _ranges.end(),
+                    value,
+                    [](Number value, const Range& range)
+                    {
+                        return value < range.min;
+                    });
+                if (out != _ranges.begin() && (out - 1)->contains(value))
+                {
+                    --out;
+                }
+                else
+                {
+                    out = _ranges.end();
+                }
+                return out;
+            }
+
             inline bool isValid(const Range & value)
             {
                 return value != invalidRange;
@@ -156,6 +205,10 @@ namespace djv
             inline std::vector<Number> toFrames(const Range & value)
             {
                 std::vector<Number> out;
+                if (value.max >= value.min)
+                {
+                    out.reserve(value.max - value.min + 1);
+                }
                 for (auto i = value.min; i <= value.max; ++i)
                 {
                     out.push_back(i);
@@ -166,9 +219,10 @@ namespace djv
             inline std::vector<Number> toFrames(const Sequence & value)
             {
                 std::vector<Number> out;
-                for (const auto & range : value.ranges)
+                out.reserve(value.getSize());
+                for (const auto & range : value.getRanges())
                 {
-                    for (const auto & i : toFrames(range))
+                    for (auto i = range.min; i <= range.max; ++i)
                     {
                         out.push_back(i);
                     }
@@ -256,7 +310,7 @@ namespace djv
             inline std::string toString(const Sequence & value)
             {
                 std::vector<std::string> list;
-                for (const auto & range : value.ranges)
+                for (const auto & range : value.getRanges())
                 {
                     list.push_back(toString(range, value.pad));
                 }
@@ -271,7 +325,7 @@ namespace djv
                     Range range;
                     size_t pad = 0;
                     fromString(piece, range, pad);
-                    out.ranges.push_back(range);
+                    out.addRange(range);
                     out.pad = std::max(out.pad, pad);
                 }
             }
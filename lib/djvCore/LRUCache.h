@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            //! This class provides a least recently used (LRU) cache.
+            //!
+            //! Values are found with a hash table that points directly into the
+            //! recency list, so get(), add(), and eviction are constant time.
+            //!
+            //! By default each value has a cost of one and the maximum is an entry
+            //! count. A cost function can be set to limit the cache by another
+            //! measure, for example the number of bytes used by images.
+            template<typename T, typename U, typename H = std::hash<T> >
+            class LRUCache
+            {
+            public:
+                size_t getMax() const;
+                void setMax(size_t);
+
+                //! Set the function used to calculate the cost of a value.
+                void setCostFunction(const std::function<size_t(const U&)>&);
+
+                size_t getSize() const;
+                size_t getCost() const;
+                bool contains(const T & key) const;
+                bool get(const T & key, U &);
+                void add(const T & key, const U & value);
+                void remove(const T& key);
+                void clear();
+
+                float getPercentageUsed() const;
+
+                //! Get the keys ordered from the most to the least recently used.
+                std::vector<T> getKeys() const;
+
+                //! Get the values ordered from the most to the least recently used.
+                std::vector<U> getValues() const;
+
+                size_t getHitCount() const;
+                size_t getMissCount() const;
+                void resetCounters();
+
+            private:
+                struct Item
+                {
+                    T key;
+                    U value;
+                    size_t cost;
+                };
+
+                void _updateMax();
+
+                size_t _max = 10000;
+                std::function<size_t(const U&)> _costFunction;
+                size_t _cost = 0;
+                std::list<Item> _list;
+                std::unordered_map<T, typename std::list<Item>::iterator, H> _map;
+                size_t _hitCount = 0;
+                size_t _missCount = 0;
+            };
+
+            //! This class provides a thread-safe least recently used (LRU) cache.
+            //!
+            //! The entries are split between shards by their hash, and each shard
+            //! has its own lock so that threads rarely contend with each other. The
+            //! maximum is divided evenly between the shards.
+            template<typename T, typename U, typename H = std::hash<T> >
+            class ShardedLRUCache
+            {
+                DJV_NON_COPYABLE(ShardedLRUCache);
+
+            public:
+                explicit ShardedLRUCache(size_t shardCount = 8);
+
+                size_t getMax() const;
+                void setMax(size_t);
+
+                //! Set the function used to calculate the cost of a value.
+                void setCostFunction(const std::function<size_t(const U&)>&);
+
+                size_t getShardCount() const;
+                size_t getSize() const;
+                size_t getCost() const;
+                bool contains(const T & key) const;
+                bool get(const T & key, U &);
+                void add(const T & key, const U & value);
+                void remove(const T& key);
+                void clear();
+
+                float getPercentageUsed() const;
+
+                size_t getHitCount() const;
+                size_t getMissCount() const;
+                void resetCounters();
+
+            private:
+                struct Shard
+                {
+                    mutable std::mutex mutex;
+                    LRUCache<T, U, H> cache;
+                };
+
+                Shard& _getShard(const T&) const;
+
+                H _hash;
+                size_t _max = 10000;
+                std::vector<std::unique_ptr<Shard> > _shards;
+            };
+
+        } // namespace Memory
+    } // namespace Core
+} // namesapce djv
+
+#include <djvCore/LRUCacheInline.h>
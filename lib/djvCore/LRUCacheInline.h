@@ -0,0 +1,360 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <algorithm>
+
+namespace djv
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            template<typename T, typename U, typename H>
+            inline size_t LRUCache<T, U, H>::getMax() const
+            {
+                return _max;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::setMax(size_t value)
+            {
+                _max = value;
+                _updateMax();
+            }
+
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::setCostFunction(const std::function<size_t(const U&)>& value)
+            {
+                _costFunction = value;
+                _cost = 0;
+                for (auto& i : _list)
+                {
+                    i.cost = _costFunction ? _costFunction(i.value) : 1;
+                    _cost += i.cost;
+                }
+                _updateMax();
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t LRUCache<T, U, H>::getSize() const
+            {
+                return _map.size();
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t LRUCache<T, U, H>::getCost() const
+            {
+                return _cost;
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool LRUCache<T, U, H>::contains(const T & key) const
+            {
+                return _map.find(key) != _map.end();
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool LRUCache<T, U, H>::get(const T & key, U & value)
+            {
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _list.splice(_list.begin(), _list, i->second);
+                    value = i->second->value;
+                    ++_hitCount;
+                    return true;
+                }
+                ++_missCount;
+                return false;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::add(const T & key, const U & value)
+            {
+                const size_t cost = _costFunction ? _costFunction(value) : 1;
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _list.splice(_list.begin(), _list, i->second);
+                    _cost -= i->second->cost;
+                    i->second->value = value;
+                    i->second->cost = cost;
+                }
+                else
+                {
+                    _list.push_front(Item({ key, value, cost }));
+                    _map[key] = _list.begin();
+                }
+                _cost += cost;
+                _updateMax();
+            }
+
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::remove(const T& key)
+            {
+                const auto i = _map.find(key);
+                if (i != _map.end())
+                {
+                    _cost -= i->second->cost;
+                    _list.erase(i->second);
+                    _map.erase(i);
+                }
+            }
+            
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::clear()
+            {
+                _map.clear();
+                _list.clear();
+                _cost = 0;
+            }
+
+            template<typename T, typename U, typename H>
+            inline float LRUCache<T, U, H>::getPercentageUsed() const
+            {
+                return _max > 0 ? (_cost / static_cast<float>(_max) * 100.F) : 0.F;
+            }
+
+            template<typename T, typename U, typename H>
+            inline std::vector<T> LRUCache<T, U, H>::getKeys() const
+            {
+                std::vector<T> out;
+                out.reserve(_list.size());
+                for (const auto & i : _list)
+                {
+                    out.push_back(i.key);
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline std::vector<U> LRUCache<T, U, H>::getValues() const
+            {
+                std::vector<U> out;
+                out.reserve(_list.size());
+                for (const auto & i : _list)
+                {
+                    out.push_back(i.value);
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t LRUCache<T, U, H>::getHitCount() const
+            {
+                return _hitCount;
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t LRUCache<T, U, H>::getMissCount() const
+            {
+                return _missCount;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::resetCounters()
+            {
+                _hitCount = 0;
+                _missCount = 0;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void LRUCache<T, U, H>::_updateMax()
+            {
+                while (_cost > _max && _list.size())
+                {
+                    const auto& item = _list.back();
+                    _cost -= item.cost;
+                    _map.erase(item.key);
+                    _list.pop_back();
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline ShardedLRUCache<T, U, H>::ShardedLRUCache(size_t shardCount)
+            {
+                for (size_t i = 0; i < std::max(shardCount, static_cast<size_t>(1)); ++i)
+                {
+                    _shards.push_back(std::unique_ptr<Shard>(new Shard));
+                }
+                setMax(_max);
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedLRUCache<T, U, H>::getMax() const
+            {
+                return _max;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedLRUCache<T, U, H>::setMax(size_t value)
+            {
+                _max = value;
+                const size_t shardMax = _max / _shards.size() + (_max % _shards.size() ? 1 : 0);
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    i->cache.setMax(shardMax);
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedLRUCache<T, U, H>::setCostFunction(const std::function<size_t(const U&)>& value)
+            {
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    i->cache.setCostFunction(value);
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedLRUCache<T, U, H>::getShardCount() const
+            {
+                return _shards.size();
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedLRUCache<T, U, H>::getSize() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    out += i->cache.getSize();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedLRUCache<T, U, H>::getCost() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    out += i->cache.getCost();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool ShardedLRUCache<T, U, H>::contains(const T & key) const
+            {
+                auto& shard = _getShard(key);
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                return shard.cache.contains(key);
+            }
+
+            template<typename T, typename U, typename H>
+            inline bool ShardedLRUCache<T, U, H>::get(const T & key, U & value)
+            {
+                auto& shard = _getShard(key);
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                return shard.cache.get(key, value);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedLRUCache<T, U, H>::add(const T & key, const U & value)
+            {
+                auto& shard = _getShard(key);
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                shard.cache.add(key, value);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedLRUCache<T, U, H>::remove(const T& key)
+            {
+                auto& shard = _getShard(key);
+                std::unique_lock<std::mutex> lock(shard.mutex);
+                shard.cache.remove(key);
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedLRUCache<T, U, H>::clear()
+            {
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    i->cache.clear();
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline float ShardedLRUCache<T, U, H>::getPercentageUsed() const
+            {
+                return _max > 0 ? (getCost() / static_cast<float>(_max) * 100.F) : 0.F;
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedLRUCache<T, U, H>::getHitCount() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    out += i->cache.getHitCount();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline size_t ShardedLRUCache<T, U, H>::getMissCount() const
+            {
+                size_t out = 0;
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    out += i->cache.getMissCount();
+                }
+                return out;
+            }
+
+            template<typename T, typename U, typename H>
+            inline void ShardedLRUCache<T, U, H>::resetCounters()
+            {
+                for (const auto& i : _shards)
+                {
+                    std::unique_lock<std::mutex> lock(i->mutex);
+                    i->cache.resetCounters();
+                }
+            }
+
+            template<typename T, typename U, typename H>
+            inline typename ShardedLRUCache<T, U, H>::Shard& ShardedLRUCache<T, U, H>::_getShard(const T& key) const
+            {
+                // Mix the high bits in so that the shards are not selected by the
+                // same low bits used for the hash table buckets.
+                const size_t hash = _hash(key);
+                return *_shards[(hash ^ (hash >> 16)) % _shards.size()];
+            }
+
+        } // namespace Memory
+    } // namespace Core
+} // namespace djv
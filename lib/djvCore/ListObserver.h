@@ -45,6 +45,38 @@ namespace djv
         //! This value represents an invalid index.
         static const size_t invalidListIndex = static_cast<size_t>(-1);
 
+        //! This enumeration provides the types of list changes.
+        enum class ListChangeType
+        {
+            Reset,  //!< The entire list has changed
+            Insert, //!< Items were inserted
+            Remove, //!< Items were removed
+            Update  //!< Items were replaced
+        };
+
+        //! This struct provides a change to a range of list items.
+        //!
+        //! A change set is ordered so that the changes can be applied in sequence
+        //! to the previous list. The indices of inserted and updated items are
+        //! also valid in the new list.
+        struct ListChange
+        {
+            ListChange();
+            ListChange(ListChangeType, size_t index, size_t count);
+
+            ListChangeType type  = ListChangeType::Reset;
+            size_t         index = 0;
+            size_t         count = 0;
+
+            bool operator == (const ListChange &) const;
+        };
+
+        //! Get the changes between two lists. Matching items at the beginning
+        //! and end of the lists are skipped, and the items in between are
+        //! described as updates followed by an insertion or removal.
+        template<typename T>
+        std::vector<ListChange> getListChanges(const std::vector<T> & previous, const std::vector<T> & value);
+
         //! This class provides a list observer.
         template<typename T>
         class ListObserver : public std::enable_shared_from_this<ListObserver<T> >
@@ -54,7 +86,8 @@ namespace djv
         protected:
             void _init(
                 const std::weak_ptr<IListSubject<T> > &,
-                const std::function<void(const std::vector<T> &)> &);
+                const std::function<void(const std::vector<T> &)> &,
+                const std::function<void(const std::vector<T> &, const std::vector<ListChange> &)> &);
 
             ListObserver();
 
@@ -66,11 +99,21 @@ namespace djv
                 const std::weak_ptr<IListSubject<T> > &,
                 const std::function<void(const std::vector<T> &)> &);
 
+            //! Create a new list observer that also receives the changes. The
+            //! callback is first called with a reset of the entire list.
+            static std::shared_ptr<ListObserver<T> > createChanges(
+                const std::weak_ptr<IListSubject<T> > &,
+                const std::function<void(const std::vector<T> &, const std::vector<ListChange> &)> &);
+
             //! Execute the callback.
             void doCallback(const std::vector<T> &);
 
+            //! Execute the callback with the given changes.
+            void doCallback(const std::vector<T> &, const std::vector<ListChange> &);
+
         private:
             std::function<void(const std::vector<T> &)> _callback;
+            std::function<void(const std::vector<T> &, const std::vector<ListChange> &)> _changesCallback;
             std::weak_ptr<IListSubject<T> > _subject;
         };
 
@@ -130,9 +173,12 @@ namespace djv
             
             //! Set the list.
             void setAlways(const std::vector<T> &);
+            void setAlways(std::vector<T> &&);
 
-            //! Set the list only if it has changed.
+            //! Set the list only if it has changed. Observers are only given the
+            //! range of items that changed.
             bool setIfChanged(const std::vector<T> &);
+            bool setIfChanged(std::vector<T> &&);
 
             //! Clear the list.
             void clear();
@@ -145,10 +191,17 @@ namespace djv
 
             //! Append a list item.
             void pushBack(const T &);
+            void pushBack(T &&);
+
+            //! Insert list items.
+            void insertItems(size_t, const std::vector<T> &);
 
             //! Remove an item.
             void removeItem(size_t);
 
+            //! Remove a range of items.
+            void removeItems(size_t, size_t count);
+
             const std::vector<T> & get() const override;
             size_t getSize() const override;
             bool isEmpty() const override;
@@ -157,6 +210,8 @@ namespace djv
             size_t indexOf(const T &) const override;
 
         private:
+            void _notify(const std::vector<ListChange> &);
+
             std::vector<T> _value;
         };
 
@@ -33,17 +33,68 @@ namespace djv
 {
     namespace Core
     {
+        inline ListChange::ListChange()
+        {}
+
+        inline ListChange::ListChange(ListChangeType type, size_t index, size_t count) :
+            type(type),
+            index(index),
+            count(count)
+        {}
+
+        inline bool ListChange::operator == (const ListChange & other) const
+        {
+            return type == other.type && index == other.index && count == other.count;
+        }
+
+        template<typename T>
+        inline std::vector<ListChange> getListChanges(const std::vector<T> & previous, const std::vector<T> & value)
+        {
+            std::vector<ListChange> out;
+            const size_t previousSize = previous.size();
+            const size_t size = value.size();
+            const size_t minSize = std::min(previousSize, size);
+            size_t prefix = 0;
+            while (prefix < minSize && previous[prefix] == value[prefix])
+            {
+                ++prefix;
+            }
+            size_t suffix = 0;
+            while (suffix < minSize - prefix && previous[previousSize - 1 - suffix] == value[size - 1 - suffix])
+            {
+                ++suffix;
+            }
+            const size_t previousCount = previousSize - prefix - suffix;
+            const size_t count = size - prefix - suffix;
+            const size_t updateCount = std::min(previousCount, count);
+            if (updateCount)
+            {
+                out.push_back(ListChange(ListChangeType::Update, prefix, updateCount));
+            }
+            if (count > previousCount)
+            {
+                out.push_back(ListChange(ListChangeType::Insert, prefix + updateCount, count - previousCount));
+            }
+            else if (previousCount > count)
+            {
+                out.push_back(ListChange(ListChangeType::Remove, prefix + updateCount, previousCount - count));
+            }
+            return out;
+        }
+
         template<typename T>
         inline void ListObserver<T>::_init(
             const std::weak_ptr<IListSubject<T> > & value,
-            const std::function<void(const std::vector<T> &)> & callback)
+            const std::function<void(const std::vector<T> &)> & callback,
+            const std::function<void(const std::vector<T> &, const std::vector<ListChange> &)> & changesCallback)
         {
             _subject = value;
             _callback = callback;
+            _changesCallback = changesCallback;
             if (auto subject = value.lock())
             {
                 subject->_add(ListObserver<T>::shared_from_this());
-                _callback(subject->get());
+                doCallback(subject->get());
             }
         }
 
@@ -66,14 +117,37 @@ namespace djv
             const std::function<void(const std::vector<T> &)> & callback)
         {
             std::shared_ptr<ListObserver<T> > out(new ListObserver<T>);
-            out->_init(value, callback);
+            out->_init(value, callback, nullptr);
+            return out;
+        }
+
+        template<typename T>
+        inline std::shared_ptr<ListObserver<T> > ListObserver<T>::createChanges(
+            const std::weak_ptr<IListSubject<T> > & value,
+            const std::function<void(const std::vector<T> &, const std::vector<ListChange> &)> & callback)
+        {
+            std::shared_ptr<ListObserver<T> > out(new ListObserver<T>);
+            out->_init(value, nullptr, callback);
             return out;
         }
 
         template<typename T>
         inline void ListObserver<T>::doCallback(const std::vector<T> & value)
         {
-            _callback(value);
+            doCallback(value, { ListChange(ListChangeType::Reset, 0, value.size()) });
+        }
+
+        template<typename T>
+        inline void ListObserver<T>::doCallback(const std::vector<T> & value, const std::vector<ListChange> & changes)
+        {
+            if (_changesCallback)
+            {
+                _changesCallback(value, changes);
+            }
+            else if (_callback)
+            {
+                _callback(value);
+            }
         }
 
         template<typename T>
@@ -146,28 +220,35 @@ namespace djv
         inline void ListSubject<T>::setAlways(const std::vector<T> & value)
         {
             _value = value;
-            for (const auto & s : IListSubject<T>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _notify({ ListChange(ListChangeType::Reset, 0, _value.size()) });
+        }
+
+        template<typename T>
+        inline void ListSubject<T>::setAlways(std::vector<T> && value)
+        {
+            _value = std::move(value);
+            _notify({ ListChange(ListChangeType::Reset, 0, _value.size()) });
         }
 
         template<typename T>
         inline bool ListSubject<T>::setIfChanged(const std::vector<T> & value)
         {
-            if (value == _value)
+            const auto changes = getListChanges(_value, value);
+            if (changes.empty())
                 return false;
             _value = value;
-            for (const auto & s : IListSubject<T>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _notify(changes);
+            return true;
+        }
+
+        template<typename T>
+        inline bool ListSubject<T>::setIfChanged(std::vector<T> && value)
+        {
+            const auto changes = getListChanges(_value, value);
+            if (changes.empty())
+                return false;
+            _value = std::move(value);
+            _notify(changes);
             return true;
         }
 
@@ -176,14 +257,9 @@ namespace djv
         {
             if (_value.size())
             {
+                const size_t size = _value.size();
                 _value.clear();
-                for (const auto & s : IListSubject<T>::_observers)
-                {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
-                }
+                _notify({ ListChange(ListChangeType::Remove, 0, size) });
             }
         }
         
@@ -191,13 +267,7 @@ namespace djv
         void ListSubject<T>::setItem(size_t index, const T & value)
         {
             _value[index] = value;
-            for (const auto & s : IListSubject<T>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _notify({ ListChange(ListChangeType::Update, index, 1) });
         }
 
         template<typename T>
@@ -206,25 +276,30 @@ namespace djv
             if (value == _value[index])
                 return;
             _value[index] = value;
-            for (const auto & s : IListSubject<T>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _notify({ ListChange(ListChangeType::Update, index, 1) });
         }
 
         template<typename T>
         void ListSubject<T>::pushBack(const T & value)
         {
             _value.push_back(value);
-            for (const auto & s : IListSubject<T>::_observers)
+            _notify({ ListChange(ListChangeType::Insert, _value.size() - 1, 1) });
+        }
+
+        template<typename T>
+        void ListSubject<T>::pushBack(T && value)
+        {
+            _value.push_back(std::move(value));
+            _notify({ ListChange(ListChangeType::Insert, _value.size() - 1, 1) });
+        }
+
+        template<typename T>
+        void ListSubject<T>::insertItems(size_t index, const std::vector<T> & value)
+        {
+            if (value.size())
             {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
+                _value.insert(_value.begin() + index, value.begin(), value.end());
+                _notify({ ListChange(ListChangeType::Insert, index, value.size()) });
             }
         }
 
@@ -232,12 +307,16 @@ namespace djv
         void ListSubject<T>::removeItem(size_t index)
         {
             _value.erase(_value.begin() + index);
-            for (const auto & s : IListSubject<T>::_observers)
+            _notify({ ListChange(ListChangeType::Remove, index, 1) });
+        }
+
+        template<typename T>
+        void ListSubject<T>::removeItems(size_t index, size_t count)
+        {
+            if (count)
             {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
+                _value.erase(_value.begin() + index, _value.begin() + index + count);
+                _notify({ ListChange(ListChangeType::Remove, index, count) });
             }
         }
 
@@ -291,5 +370,17 @@ namespace djv
             return i != _value.end() ? i - _value.begin() : invalidListIndex;
         }
 
+        template<typename T>
+        inline void ListSubject<T>::_notify(const std::vector<ListChange> & changes)
+        {
+            for (const auto & s : IListSubject<T>::_observers)
+            {
+                if (auto observer = s.lock())
+                {
+                    observer->doCallback(_value, changes);
+                }
+            }
+        }
+
     } // namespace Core
 } // namespace djv
@@ -38,8 +38,11 @@
 #include <djvCore/Time.h>
 #include <djvCore/Timer.h>
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <ctime>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <list>
@@ -54,21 +57,103 @@ namespace djv
         {
             const std::string name = "djv::Core::LogSystem";
 
-            struct Message
+            //! \todo Should this be configurable?
+            const size_t queueSize = 4096;
+            const size_t prefixWidth = 32;
+            const size_t historySize = 10000;
+
+            //! This struct provides a preallocated message slot. The strings keep
+            //! their capacity between uses so that logging does not normally
+            //! allocate memory.
+            struct Slot
             {
-                Message()
-                {}
-                Message(
-                    const std::string & prefix,
-                    const std::string & text,
-                    LogLevel level) :
-                    prefix(prefix),
-                    text(text),
-                    level(level)
-                {}
+                std::atomic<size_t> sequence;
                 std::string prefix;
                 std::string text;
                 LogLevel level = LogLevel::Information;
+                std::time_t time = 0;
+            };
+
+            //! This class provides a bounded lock-free queue with multiple producers
+            //! and a single consumer.
+            class MessageQueue
+            {
+                DJV_NON_COPYABLE(MessageQueue);
+
+            public:
+                MessageQueue() :
+                    _slots(new Slot[queueSize])
+                {
+                    for (size_t i = 0; i < queueSize; ++i)
+                    {
+                        _slots[i].sequence.store(i, std::memory_order_relaxed);
+                    }
+                    _pushPos.store(0, std::memory_order_relaxed);
+                    _popPos.store(0, std::memory_order_relaxed);
+                }
+
+                //! Returns the number of messages in the queue after the push, or
+                //! zero if the queue is full.
+                size_t push(const std::string& prefix, const std::string& text, LogLevel level)
+                {
+                    Slot* slot = nullptr;
+                    size_t pos = _pushPos.load(std::memory_order_relaxed);
+                    while (true)
+                    {
+                        slot = &_slots[pos % queueSize];
+                        const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+                        if (sequence == pos)
+                        {
+                            if (_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                            {
+                                break;
+                            }
+                        }
+                        else if (sequence < pos)
+                        {
+                            return 0;
+                        }
+                        else
+                        {
+                            pos = _pushPos.load(std::memory_order_relaxed);
+                        }
+                    }
+                    slot->prefix.assign(prefix);
+                    slot->text.assign(text);
+                    slot->level = level;
+                    slot->time = std::time(nullptr);
+                    const size_t size = pos + 1 - _popPos.load(std::memory_order_relaxed);
+                    slot->sequence.store(pos + 1, std::memory_order_release);
+                    return size;
+                }
+
+                //! Pass the next message to the given function. This may only be
+                //! called from the consumer thread.
+                template<typename T>
+                bool pop(const T& callback)
+                {
+                    const size_t pos = _popPos.load(std::memory_order_relaxed);
+                    Slot& slot = _slots[pos % queueSize];
+                    if (slot.sequence.load(std::memory_order_acquire) != pos + 1)
+                    {
+                        return false;
+                    }
+                    callback(slot);
+                    slot.sequence.store(pos + queueSize, std::memory_order_release);
+                    _popPos.store(pos + 1, std::memory_order_relaxed);
+                    return true;
+                }
+
+                bool isEmpty() const
+                {
+                    const size_t pos = _popPos.load(std::memory_order_relaxed);
+                    return _slots[pos % queueSize].sequence.load(std::memory_order_acquire) != pos + 1;
+                }
+
+            private:
+                std::unique_ptr<Slot[]> _slots;
+                std::atomic<size_t> _pushPos;
+                std::atomic<size_t> _popPos;
             };
 
         } // namespace
@@ -77,17 +162,29 @@ namespace djv
         {
             FileSystem::Path path;
             std::atomic<bool> consoleOutput;
+            std::atomic<LogLevel> verbosity;
             std::vector<std::string> warnings;
             std::shared_ptr<ListSubject<std::string> > warningsSubject;
             std::vector<std::string> errors;
             std::shared_ptr<ListSubject<std::string> > errorsSubject;
-            std::list<Message> queue;
-            std::condition_variable queueCV;
-            std::list<Message> messages;
             std::mutex mutex;
+            MessageQueue queue;
+            std::condition_variable queueCV;
+            std::mutex queueMutex;
+            std::atomic<size_t> writtenCount;
+            std::atomic<size_t> droppedCount;
+            size_t droppedReported = 0;
+            std::string buffer;
+            std::time_t bufferTime = 0;
+            std::string bufferTimeString;
             std::thread thread;
             std::atomic<bool> running;
             std::shared_ptr<Time::Timer> warningsAndErrorsTimer;
+            std::deque<LogMessage> history;
+            size_t historyEnd = 0;
+            mutable std::mutex historyMutex;
+
+            void appendLines(const std::string& prefix, const std::string& text, LogLevel, std::time_t);
         };
 
         void LogSystem::_init(const std::shared_ptr<Context>& context)
@@ -99,6 +196,10 @@ namespace djv
             addDependency(resourceSystem);
             
             p.path = resourceSystem->getPath(FileSystem::ResourcePath::LogFile);
+            p.consoleOutput = OS::getIntEnv("DJV_LOG_CONSOLE") != 0;
+            p.verbosity = LogLevel::Information;
+            p.writtenCount = 0;
+            p.droppedCount = 0;
 
             p.warningsSubject = ListSubject<std::string>::create();
             p.errorsSubject = ListSubject<std::string>::create();
@@ -108,7 +209,6 @@ namespace djv
                 [this]
             {
                 DJV_PRIVATE_PTR();
-                p.consoleOutput = OS::getIntEnv("DJV_LOG_CONSOLE") != 0;
 
                 try
                 {
@@ -128,22 +228,17 @@ namespace djv
                 while (p.running)
                 {
                     {
-                        std::unique_lock<std::mutex> lock(p.mutex);
+                        std::unique_lock<std::mutex> lock(p.queueMutex);
                         p.queueCV.wait_for(
                             lock,
                             std::chrono::milliseconds(timeout),
                             [this]
                         {
-                            return _p->queue.size();
+                            return !_p->queue.isEmpty() || !_p->running;
                         });
-                        p.messages = std::move(p.queue);
                     }
                     _writeMessages();
                 }
-                {
-                    std::unique_lock<std::mutex> lock(p.mutex);
-                    p.messages = std::move(p.queue);
-                }
                 _writeMessages();
             });
 
@@ -182,7 +277,11 @@ namespace djv
         LogSystem::~LogSystem()
         {
             DJV_PRIVATE_PTR();
-            p.running = false;
+            {
+                std::unique_lock<std::mutex> lock(p.queueMutex);
+                p.running = false;
+            }
+            p.queueCV.notify_one();
             if (p.thread.joinable())
             {
                 p.thread.join();
@@ -199,11 +298,26 @@ namespace djv
         void LogSystem::log(const std::string & prefix, const std::string & message, LogLevel level)
         {
             DJV_PRIVATE_PTR();
+            if (level < p.verbosity)
             {
-                std::unique_lock<std::mutex> lock(p.mutex);
-                p.queue.push_back(Message(prefix, message, level));
+                return;
             }
-            p.queueCV.notify_one();
+            const size_t size = p.queue.push(prefix, message, level);
+            if (0 == size)
+            {
+                ++p.droppedCount;
+            }
+            else if (1 == size || queueSize / 2 == size)
+            {
+                // Only wake the writer when the queue was empty or is filling up,
+                // otherwise the messages are picked up with the next batch.
+                p.queueCV.notify_one();
+            }
+        }
+
+        bool LogSystem::isEnabled(LogLevel value) const
+        {
+            return value >= _p->verbosity;
         }
 
         bool LogSystem::hasConsoleOutput() const
@@ -216,88 +330,174 @@ namespace djv
             _p->consoleOutput = value;
         }
 
-        std::shared_ptr<Core::IListSubject<std::string> > LogSystem::observeWarnings() const
+        LogLevel LogSystem::getVerbosity() const
         {
-            return _p->warningsSubject;
+            return _p->verbosity;
         }
 
-        std::shared_ptr<Core::IListSubject<std::string> > LogSystem::observeErrors() const
+        void LogSystem::setVerbosity(LogLevel value)
         {
-            return _p->errorsSubject;
+            _p->verbosity = value;
         }
 
-        void LogSystem::_writeMessages()
+        size_t LogSystem::getWrittenCount() const
+        {
+            return _p->writtenCount;
+        }
+
+        size_t LogSystem::getDroppedCount() const
+        {
+            return _p->droppedCount;
+        }
+
+        std::vector<LogMessage> LogSystem::getHistory(size_t& pos) const
         {
             DJV_PRIVATE_PTR();
-            try
+            std::vector<LogMessage> out;
+            std::unique_lock<std::mutex> lock(p.historyMutex);
+            const size_t begin = p.historyEnd - p.history.size();
+            for (size_t i = std::max(pos, begin); i < p.historyEnd; ++i)
             {
-                std::vector<std::string> warnings;
-                std::vector<std::string> errors;
+                out.push_back(p.history[i - begin]);
+            }
+            pos = p.historyEnd;
+            return out;
+        }
 
-                FileSystem::FileIO io;
-                io.open(std::string(p.path), FileSystem::FileIO::Mode::Append);
-                io.seek(io.getSize());
+        std::shared_ptr<Core::IListSubject<std::string> > LogSystem::observeWarnings() const
+        {
+            return _p->warningsSubject;
+        }
 
-                std::map<LogLevel, std::string> labels =
-                {
-                    { LogLevel::Information, std::string() },
-                    { LogLevel::Warning, "[Warning]" },
-                    { LogLevel::Error, "[ERROR]" }
-                };
+        std::shared_ptr<Core::IListSubject<std::string> > LogSystem::observeErrors() const
+        {
+            return _p->errorsSubject;
+        }
 
-                for (const auto & message : p.messages)
+        size_t LogSystem::_writeMessages()
+        {
+            DJV_PRIVATE_PTR();
+            size_t out = 0;
+            std::vector<std::string> warnings;
+            std::vector<std::string> errors;
+            std::vector<LogMessage> messages;
+            p.buffer.clear();
+            while (p.queue.pop(
+                [&p, &warnings, &errors, &messages](const Slot& slot)
                 {
-                    switch (message.level)
+                    switch (slot.level)
                     {
-                    case LogLevel::Warning: warnings.push_back(message.text); break;
-                    case LogLevel::Error:   errors.push_back(message.text);   break;
+                    case LogLevel::Warning: warnings.push_back(slot.text); break;
+                    case LogLevel::Error:   errors.push_back(slot.text);   break;
                     default: break;
                     }
-
-                    std::string line;
-                    std::stringstream s(message.text);
-                    while (std::getline(s, line))
-                    {
-                        std::stringstream s2;
-                        const std::time_t t = std::time(nullptr);
-                        std::tm tm;
-                        Time::localtime(&t, &tm);
-                        s2 << std::put_time(&tm, "%c") << " ";
-                        s2 << std::setfill(' ');
-                        s2 << std::right;
-                        s2 << std::setw(32);
-                        s2 << message.prefix << " | ";
-
-                        const auto & label = labels[message.level];
-                        if (!label.empty())
-                        {
-                            s2 << label << " ";
-                        }
-                        s2 << line << std::endl;
-                        io.write(s2.str());
-                        if (p.consoleOutput)
-                        {
-                            std::cerr << s2.str();
-                        }
-                    }
+                    p.appendLines(slot.prefix, slot.text, slot.level, slot.time);
+                    LogMessage message;
+                    message.prefix = slot.prefix;
+                    message.text = slot.text;
+                    message.level = slot.level;
+                    message.time = slot.time;
+                    messages.push_back(std::move(message));
+                }))
+            {
+                ++out;
+            }
+            const size_t dropped = p.droppedCount;
+            if (dropped != p.droppedReported)
+            {
+                std::stringstream ss;
+                ss << dropped - p.droppedReported << " messages dropped";
+                LogMessage message;
+                message.prefix = name;
+                message.text = ss.str();
+                message.level = LogLevel::Warning;
+                message.time = std::time(nullptr);
+                p.appendLines(message.prefix, message.text, message.level, message.time);
+                messages.push_back(std::move(message));
+                p.droppedReported = dropped;
+            }
+            if (messages.size())
+            {
+                std::unique_lock<std::mutex> lock(p.historyMutex);
+                for (auto& i : messages)
+                {
+                    p.history.push_back(std::move(i));
                 }
-                p.messages.clear();
-                if (warnings.size() || errors.size())
+                p.historyEnd += messages.size();
+                while (p.history.size() > historySize)
                 {
-                    std::unique_lock<std::mutex> lock(p.mutex);
-                    for (const auto& i : warnings)
-                    {
-                        p.warnings.push_back(i);
-                    }
-                    for (const auto& i : errors)
-                    {
-                        p.errors.push_back(i);
-                    }
+                    p.history.pop_front();
+                }
+            }
+            if (!p.buffer.empty())
+            {
+                try
+                {
+                    FileSystem::FileIO io;
+                    io.open(std::string(p.path), FileSystem::FileIO::Mode::Append);
+                    io.seek(io.getSize());
+                    io.write(p.buffer);
+                }
+                catch (const std::exception & e)
+                {
+                    std::cerr << name << ": " << e.what() << std::endl;
+                }
+                if (p.consoleOutput)
+                {
+                    std::cerr << p.buffer;
+                }
+            }
+            p.writtenCount += out;
+            if (warnings.size() || errors.size())
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                for (auto& i : warnings)
+                {
+                    p.warnings.push_back(std::move(i));
+                }
+                for (auto& i : errors)
+                {
+                    p.errors.push_back(std::move(i));
                 }
             }
-            catch (const std::exception & e)
+            return out;
+        }
+
+        void LogSystem::Private::appendLines(const std::string& prefix, const std::string& text, LogLevel level, std::time_t time)
+        {
+            if (time != bufferTime || bufferTimeString.empty())
             {
-                std::cerr << name << ": " << e.what() << std::endl;
+                std::tm tm;
+                Time::localtime(&time, &tm);
+                std::stringstream ss;
+                ss << std::put_time(&tm, "%c") << " ";
+                bufferTime = time;
+                bufferTimeString = ss.str();
+            }
+            size_t pos = 0;
+            while (pos < text.size())
+            {
+                size_t end = text.find('\n', pos);
+                if (std::string::npos == end)
+                {
+                    end = text.size();
+                }
+                buffer.append(bufferTimeString);
+                if (prefix.size() < prefixWidth)
+                {
+                    buffer.append(prefixWidth - prefix.size(), ' ');
+                }
+                buffer.append(prefix);
+                buffer.append(" | ");
+                switch (level)
+                {
+                case LogLevel::Warning: buffer.append("[Warning] "); break;
+                case LogLevel::Error:   buffer.append("[ERROR] ");   break;
+                default: break;
+                }
+                buffer.append(text, pos, end - pos);
+                buffer.push_back('\n');
+                pos = end + 1;
             }
         }
 
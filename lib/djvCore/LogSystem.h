@@ -32,15 +32,33 @@
 #include <djvCore/ISystem.h>
 #include <djvCore/ListObserver.h>
 
+#include <ctime>
+
 namespace djv
 {
     namespace Core
     {
+        //! This struct provides a log message.
+        struct LogMessage
+        {
+            std::string prefix;
+            std::string text;
+            LogLevel    level = LogLevel::Information;
+            std::time_t time  = 0;
+        };
+
         //! This class provides logging functionality.
         //!
         //! Logging output is written to the given file, and can also be written to
         //! std::cout if the environment variable DJV_LOG_CONSOLE is set to a non-zero
         //! value.
+        //!
+        //! Messages are placed in a fixed size lock-free queue and written to the
+        //! file in batches by a background thread. If the queue is full the message
+        //! is dropped and counted instead of blocking the calling thread.
+        //!
+        //! The most recently written messages are also kept in memory so that
+        //! they can be displayed without reading the log file.
         class LogSystem : public ISystemBase
         {
             DJV_NON_COPYABLE(LogSystem);
@@ -56,6 +74,10 @@ namespace djv
             //! Log a message.
             void log(const std::string & prefix, const std::string & message, LogLevel = LogLevel::Information);
 
+            //! Get whether messages of the given level are logged. Use this to avoid
+            //! formatting messages that would be discarded.
+            bool isEnabled(LogLevel) const;
+
             //! \name Warning and Errors
             ///@{
 
@@ -64,16 +86,44 @@ namespace djv
 
             ///@}
 
+            //! \name History
+            ///@{
+
+            //! Get the messages that were written after the given position, and
+            //! update the position. Only the most recent messages are kept, older
+            //! messages are skipped. Start with a position of zero to get all of
+            //! the messages that are available.
+            std::vector<LogMessage> getHistory(size_t& pos) const;
+
+            ///@}
+
             //! \name Logging Options
             ///@{
             
             bool hasConsoleOutput() const;
             void setConsoleOutput(bool);
+
+            //! Get the minimum level of messages that are logged.
+            LogLevel getVerbosity() const;
+
+            //! Set the minimum level of messages that are logged.
+            void setVerbosity(LogLevel);
             
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Get the number of messages that have been written.
+            size_t getWrittenCount() const;
+
+            //! Get the number of messages that were dropped because the queue was full.
+            size_t getDroppedCount() const;
+
+            ///@}
+
         private:
-            void _writeMessages();
+            size_t _writeMessages();
 
             DJV_PRIVATE();
         };
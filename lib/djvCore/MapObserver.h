@@ -43,6 +43,22 @@ namespace djv
         template<typename T, typename U>
         class IMapSubject;
 
+        //! This struct provides the keys that changed in a map.
+        template<typename T>
+        struct MapChanges
+        {
+            bool           reset = false; //!< The entire map has changed
+            std::vector<T> inserted;
+            std::vector<T> removed;
+            std::vector<T> updated;
+
+            bool isEmpty() const;
+        };
+
+        //! Get the keys that changed between two maps.
+        template<typename T, typename U>
+        MapChanges<T> getMapChanges(const std::map<T, U> & previous, const std::map<T, U> & value);
+
         //! This class provides a map observer.
         template<typename T, typename U>
         class MapObserver : public std::enable_shared_from_this<MapObserver<T, U> >
@@ -51,7 +67,8 @@ namespace djv
 
             void _init(
                 const std::weak_ptr<IMapSubject<T, U> > &,
-                const std::function<void(const std::map<T, U> &)> &);
+                const std::function<void(const std::map<T, U> &)> &,
+                const std::function<void(const std::map<T, U> &, const MapChanges<T> &)> &);
 
             MapObserver();
 
@@ -63,11 +80,21 @@ namespace djv
                 const std::weak_ptr<IMapSubject<T, U> > &,
                 const std::function<void(const std::map<T, U> &)> &);
 
+            //! Create a new map observer that also receives the changes. The
+            //! callback is first called with a reset of the entire map.
+            static std::shared_ptr<MapObserver<T, U> > createChanges(
+                const std::weak_ptr<IMapSubject<T, U> > &,
+                const std::function<void(const std::map<T, U> &, const MapChanges<T> &)> &);
+
             //! Execute the callback.
             void doCallback(const std::map<T, U> &);
 
+            //! Execute the callback with the given changes.
+            void doCallback(const std::map<T, U> &, const MapChanges<T> &);
+
         private:
             std::function<void(const std::map<T, U> &)> _callback;
+            std::function<void(const std::map<T, U> &, const MapChanges<T> &)> _changesCallback;
             std::weak_ptr<IMapSubject<T, U> > _subject;
         };
 
@@ -123,9 +150,12 @@ namespace djv
 
             //! Set the map.
             void setAlways(const std::map<T, U> &);
+            void setAlways(std::map<T, U> &&);
 
-            //! Set the map only if it has changed.
+            //! Set the map only if it has changed. Observers are only given the
+            //! keys that changed.
             bool setIfChanged(const std::map<T, U> &);
+            bool setIfChanged(std::map<T, U> &&);
 
             //! Clear the map.
             void clear();
@@ -136,6 +166,9 @@ namespace djv
             //! Set a map item only if it has changed.
             void setItemOnlyIfChanged(const T &, const U &);
 
+            //! Remove a map item.
+            void removeItem(const T &);
+
             const std::map<T, U> & get() const override;
             size_t getSize() const override;
             bool isEmpty() const override;
@@ -143,6 +176,8 @@ namespace djv
             const U & getItem(const T &) const override;
 
         private:
+            void _notify(const MapChanges<T> &);
+
             std::map<T, U> _value;
         };
 
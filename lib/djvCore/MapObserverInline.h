@@ -33,17 +33,64 @@ namespace djv
 {
     namespace Core
     {
+        template<typename T>
+        inline bool MapChanges<T>::isEmpty() const
+        {
+            return !reset && inserted.empty() && removed.empty() && updated.empty();
+        }
+
+        template<typename T, typename U>
+        inline MapChanges<T> getMapChanges(const std::map<T, U> & previous, const std::map<T, U> & value)
+        {
+            MapChanges<T> out;
+            auto i = previous.begin();
+            auto j = value.begin();
+            while (i != previous.end() && j != value.end())
+            {
+                if (i->first < j->first)
+                {
+                    out.removed.push_back(i->first);
+                    ++i;
+                }
+                else if (j->first < i->first)
+                {
+                    out.inserted.push_back(j->first);
+                    ++j;
+                }
+                else
+                {
+                    if (!(i->second == j->second))
+                    {
+                        out.updated.push_back(i->first);
+                    }
+                    ++i;
+                    ++j;
+                }
+            }
+            for (; i != previous.end(); ++i)
+            {
+                out.removed.push_back(i->first);
+            }
+            for (; j != value.end(); ++j)
+            {
+                out.inserted.push_back(j->first);
+            }
+            return out;
+        }
+
         template<typename T, typename U>
         inline void MapObserver<T, U>::_init(
             const std::weak_ptr<IMapSubject<T, U> > & value,
-            const std::function<void(const std::map<T, U> &)> & callback)
+            const std::function<void(const std::map<T, U> &)> & callback,
+            const std::function<void(const std::map<T, U> &, const MapChanges<T> &)> & changesCallback)
         {
             _subject = value;
             _callback = callback;
+            _changesCallback = changesCallback;
             if (auto subject = value.lock())
             {
                 subject->_add(MapObserver<T, U>::shared_from_this());
-                _callback(subject->get());
+                doCallback(subject->get());
             }
         }
 
@@ -66,14 +113,39 @@ namespace djv
             const std::function<void(const std::map<T, U> &)> & callback)
         {
             std::shared_ptr<MapObserver<T, U> > out(new MapObserver<T, U>);
-            out->_init(value, callback);
+            out->_init(value, callback, nullptr);
+            return out;
+        }
+
+        template<typename T, typename U>
+        inline std::shared_ptr<MapObserver<T, U> > MapObserver<T, U>::createChanges(
+            const std::weak_ptr<IMapSubject<T, U> > & value,
+            const std::function<void(const std::map<T, U> &, const MapChanges<T> &)> & callback)
+        {
+            std::shared_ptr<MapObserver<T, U> > out(new MapObserver<T, U>);
+            out->_init(value, nullptr, callback);
             return out;
         }
 
         template<typename T, typename U>
         inline void MapObserver<T, U>::doCallback(const std::map<T, U> & value)
         {
-            _callback(value);
+            MapChanges<T> changes;
+            changes.reset = true;
+            doCallback(value, changes);
+        }
+
+        template<typename T, typename U>
+        inline void MapObserver<T, U>::doCallback(const std::map<T, U> & value, const MapChanges<T> & changes)
+        {
+            if (_changesCallback)
+            {
+                _changesCallback(value, changes);
+            }
+            else if (_callback)
+            {
+                _callback(value);
+            }
         }
 
         template<typename T, typename U>
@@ -146,28 +218,39 @@ namespace djv
         inline void MapSubject<T, U>::setAlways(const std::map<T, U> & value)
         {
             _value = value;
-            for (const auto & s : IMapSubject<T, U>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            MapChanges<T> changes;
+            changes.reset = true;
+            _notify(changes);
+        }
+
+        template<typename T, typename U>
+        inline void MapSubject<T, U>::setAlways(std::map<T, U> && value)
+        {
+            _value = std::move(value);
+            MapChanges<T> changes;
+            changes.reset = true;
+            _notify(changes);
         }
 
         template<typename T, typename U>
         inline bool MapSubject<T, U>::setIfChanged(const std::map<T, U> & value)
         {
-            if (value == _value)
+            const auto changes = getMapChanges(_value, value);
+            if (changes.isEmpty())
                 return false;
             _value = value;
-            for (const auto & s : IMapSubject<T, U>::_observers)
-            {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
-            }
+            _notify(changes);
+            return true;
+        }
+
+        template<typename T, typename U>
+        inline bool MapSubject<T, U>::setIfChanged(std::map<T, U> && value)
+        {
+            const auto changes = getMapChanges(_value, value);
+            if (changes.isEmpty())
+                return false;
+            _value = std::move(value);
+            _notify(changes);
             return true;
         }
 
@@ -176,29 +259,32 @@ namespace djv
         {
             if (_value.size())
             {
-                _value.clear();
-                for (const auto & s : IMapSubject<T, U>::_observers)
+                MapChanges<T> changes;
+                for (const auto & i : _value)
                 {
-                    if (auto observer = s.lock())
-                    {
-                        observer->doCallback(_value);
-                    }
+                    changes.removed.push_back(i.first);
                 }
+                _value.clear();
+                _notify(changes);
             }
         }
 
         template<typename T, typename U>
         void MapSubject<T, U>::setItem(const T & key, const U & value)
         {
-            _value[key] = value;
-
-            for (const auto & s : IMapSubject<T, U>::_observers)
+            MapChanges<T> changes;
+            const auto i = _value.find(key);
+            if (i != _value.end())
             {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
+                i->second = value;
+                changes.updated.push_back(key);
+            }
+            else
+            {
+                _value[key] = value;
+                changes.inserted.push_back(key);
             }
+            _notify(changes);
         }
 
         template<typename T, typename U>
@@ -207,13 +293,19 @@ namespace djv
             const auto i = _value.find(key);
             if (i != _value.end() && i->second == value)
                 return;
-            _value[key] = value;
-            for (const auto & s : IMapSubject<T, U>::_observers)
+            setItem(key, value);
+        }
+
+        template<typename T, typename U>
+        void MapSubject<T, U>::removeItem(const T & key)
+        {
+            const auto i = _value.find(key);
+            if (i != _value.end())
             {
-                if (auto observer = s.lock())
-                {
-                    observer->doCallback(_value);
-                }
+                _value.erase(i);
+                MapChanges<T> changes;
+                changes.removed.push_back(key);
+                _notify(changes);
             }
         }
 
@@ -247,5 +339,17 @@ namespace djv
             return _value.find(key)->second;
         }
 
+        template<typename T, typename U>
+        inline void MapSubject<T, U>::_notify(const MapChanges<T> & changes)
+        {
+            for (const auto & s : IMapSubject<T, U>::_observers)
+            {
+                if (auto observer = s.lock())
+                {
+                    observer->doCallback(_value, changes);
+                }
+            }
+        }
+
     } // namespace Core
 } // namespace djv
@@ -30,6 +30,21 @@
 #include <djvCore/Memory.h>
 
 #include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#define DJV_MEMORY_AVX2
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#define DJV_MEMORY_SSSE3
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DJV_MEMORY_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define DJV_MEMORY_NEON
+#include <arm_neon.h>
+#endif
 
 namespace djv
 {
@@ -37,6 +52,224 @@ namespace djv
     {
         namespace Memory
         {
+            namespace
+            {
+#if defined(DJV_MEMORY_SSE2)
+                inline __m128i swap16(__m128i value)
+                {
+                    return _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+                }
+#endif // DJV_MEMORY_SSE2
+
+                //! Convert the endianness of as many whole vectors as possible,
+                //! and return the number of words that were converted. The input
+                //! and output may be the same.
+                size_t endianSIMD(const uint8_t* in, uint8_t* out, size_t size, size_t wordSize)
+                {
+                    size_t count = 0;
+#if defined(DJV_MEMORY_AVX2) || defined(DJV_MEMORY_SSSE3)
+                    __m128i mask;
+                    switch (wordSize)
+                    {
+                    case 2: mask = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14); break;
+                    case 4: mask = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12); break;
+                    case 8: mask = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8); break;
+                    default: return 0;
+                    }
+                    const size_t byteCount = size * wordSize;
+                    size_t i = 0;
+#if defined(DJV_MEMORY_AVX2)
+                    const __m256i mask256 = _mm256_broadcastsi128_si256(mask);
+                    for (; i + 32 <= byteCount; i += 32)
+                    {
+                        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_shuffle_epi8(value, mask256));
+                    }
+#endif // DJV_MEMORY_AVX2
+                    for (; i + 16 <= byteCount; i += 16)
+                    {
+                        const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_shuffle_epi8(value, mask));
+                    }
+                    count = i / wordSize;
+#elif defined(DJV_MEMORY_SSE2)
+                    const size_t byteCount = size * wordSize;
+                    size_t i = 0;
+                    switch (wordSize)
+                    {
+                    case 2:
+                        for (; i + 16 <= byteCount; i += 16)
+                        {
+                            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), swap16(value));
+                        }
+                        break;
+                    case 4:
+                        for (; i + 16 <= byteCount; i += 16)
+                        {
+                            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                            value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+                            value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), swap16(value));
+                        }
+                        break;
+                    case 8:
+                        for (; i + 16 <= byteCount; i += 16)
+                        {
+                            __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+                            value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+                            value = _mm_shufflehi_epi16(value, _MM_SHUFFLE(0, 1, 2, 3));
+                            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), swap16(value));
+                        }
+                        break;
+                    default: break;
+                    }
+                    count = i / wordSize;
+#elif defined(DJV_MEMORY_NEON)
+                    const size_t byteCount = size * wordSize;
+                    size_t i = 0;
+                    switch (wordSize)
+                    {
+                    case 2:
+                        for (; i + 16 <= byteCount; i += 16)
+                        {
+                            vst1q_u8(out + i, vrev16q_u8(vld1q_u8(in + i)));
+                        }
+                        break;
+                    case 4:
+                        for (; i + 16 <= byteCount; i += 16)
+                        {
+                            vst1q_u8(out + i, vrev32q_u8(vld1q_u8(in + i)));
+                        }
+                        break;
+                    case 8:
+                        for (; i + 16 <= byteCount; i += 16)
+                        {
+                            vst1q_u8(out + i, vrev64q_u8(vld1q_u8(in + i)));
+                        }
+                        break;
+                    default: break;
+                    }
+                    count = i / wordSize;
+#endif // DJV_MEMORY_AVX2
+                    return count;
+                }
+
+            } // namespace
+
+            void endian(
+                void*  in,
+                size_t size,
+                size_t wordSize)
+            {
+                uint8_t* p = reinterpret_cast<uint8_t*>(in);
+                const size_t count = endianSIMD(p, p, size, wordSize);
+                p += count * wordSize;
+                size -= count;
+                uint8_t tmp;
+                switch (wordSize)
+                {
+                case 2:
+                    while (size--)
+                    {
+                        tmp  = p[0];
+                        p[0] = p[1];
+                        p[1] = tmp;
+                        p += 2;
+                    }
+                    break;
+                case 4:
+                    while (size--)
+                    {
+                        tmp  = p[0];
+                        p[0] = p[3];
+                        p[3] = tmp;
+                        tmp  = p[1];
+                        p[1] = p[2];
+                        p[2] = tmp;
+                        p += 4;
+                    }
+                    break;
+                case 8:
+                    while (size--)
+                    {
+                        tmp  = p[0];
+                        p[0] = p[7];
+                        p[7] = tmp;
+                        tmp  = p[1];
+                        p[1] = p[6];
+                        p[6] = tmp;
+                        tmp  = p[2];
+                        p[2] = p[5];
+                        p[5] = tmp;
+                        tmp  = p[3];
+                        p[3] = p[4];
+                        p[4] = tmp;
+                        p += 8;
+                    }
+                    break;
+                default: break;
+                }
+            }
+
+            void endian(
+                const void* in,
+                void*       out,
+                size_t      size,
+                size_t      wordSize)
+            {
+                const uint8_t* inP = reinterpret_cast<const uint8_t*>(in);
+                uint8_t* outP = reinterpret_cast<uint8_t*>(out);
+                const size_t count = endianSIMD(inP, outP, size, wordSize);
+                inP  += count * wordSize;
+                outP += count * wordSize;
+                size -= count;
+                switch (wordSize)
+                {
+                case 2:
+                    while (size--)
+                    {
+                        outP[0] = inP[1];
+                        outP[1] = inP[0];
+
+                        inP  += 2;
+                        outP += 2;
+                    }
+                    break;
+                case 4:
+                    while (size--)
+                    {
+                        outP[0] = inP[3];
+                        outP[1] = inP[2];
+                        outP[2] = inP[1];
+                        outP[3] = inP[0];
+
+                        inP  += 4;
+                        outP += 4;
+                    }
+                    break;
+                case 8:
+                    while (size--)
+                    {
+                        outP[0] = inP[7];
+                        outP[1] = inP[6];
+                        outP[2] = inP[5];
+                        outP[3] = inP[4];
+                        outP[4] = inP[3];
+                        outP[5] = inP[2];
+                        outP[6] = inP[1];
+                        outP[7] = inP[0];
+
+                        inP  += 8;
+                        outP += 8;
+                    }
+                    break;
+                default:
+                    memcpy(outP, inP, size * wordSize);
+                    break;
+                }
+            }
+
             std::string getSizeLabel(uint64_t value)
             {
                 const std::vector<std::string> data = { "TB", "GB", "MB", "KB" };
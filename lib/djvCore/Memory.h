@@ -65,7 +65,9 @@ namespace djv
             //! Get the opposite of the given endian.
             Endian opposite(Endian);
 
-            //! Convert the endianness of a block of memory in place.
+            //! Convert the endianness of a block of memory in place. Blocks of
+            //! 2, 4, and 8 byte words are converted with SIMD instructions when
+            //! they are available (AVX2, SSSE3, SSE2, or NEON).
             void endian(
                 void*  in,
                 size_t size,
@@ -74,6 +74,7 @@ void wrapFileInfo(pybind11::module& m)
         .def("setPath", (void(FileSystem::FileInfo::*)(const FileSystem::Path&, bool))&FileSystem::FileInfo::setPath, py::arg("path"), py::arg("stat") = true)
         .def("setPath", (void(FileSystem::FileInfo::*)(const FileSystem::Path&, FileSystem::FileType, bool))&FileSystem::FileInfo::setPath, py::arg("path"), py::arg("fileType"), py::arg("stat") = true)
         .def("getFileName", &FileSystem::FileInfo::getFileName, py::arg("frame") = Frame::invalid, py::arg("path") = true)
+        .def("getFileNames", &FileSystem::FileInfo::getFileNames, py::arg("path") = true)
         .def("doesExist", &FileSystem::FileInfo::doesExist)
         .def("getType", &FileSystem::FileInfo::getType)
         .def("getSize", &FileSystem::FileInfo::getSize)
@@ -68,7 +68,7 @@ void wrapFrame(pybind11::module& m)
         .def(py::init<>())
         .def(py::init<const Frame::Range&, size_t>(), py::arg("range"), py::arg("pad") = 0)
         .def(py::init<const std::vector<Frame::Range>&, size_t>(), py::arg("ranges"), py::arg("pad") = 0)
-        .def_readwrite("ranges", &Frame::Sequence::ranges)
+        .def_property("ranges", &Frame::Sequence::getRanges, &Frame::Sequence::setRanges)
         .def_readwrite("pad", &Frame::Sequence::pad)
         .def("isValid", &Frame::Sequence::isValid)
         .def("getSize", &Frame::Sequence::getSize)
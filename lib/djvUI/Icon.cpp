@@ -169,8 +169,8 @@ namespace djv
             // Draw the icon.
             if (p.image && p.image->isValid())
             {
-                const uint16_t w = p.image->getWidth();
-                const uint16_t h = p.image->getHeight();
+                const uint32_t w = p.image->getWidth();
+                const uint32_t h = p.image->getHeight();
                 glm::vec2 pos = glm::vec2(0.F, 0.F);
                 switch (getHAlign())
                 {
@@ -33,10 +33,10 @@
 #include <djvAV/IO.h>
 #include <djvAV/Image.h>
 
-#include <djvCore/Cache.h>
 #include <djvCore/Context.h>
 #include <djvCore/FileInfo.h>
 #include <djvCore/FileSystem.h>
+#include <djvCore/LRUCache.h>
 #include <djvCore/LogSystem.h>
 #include <djvCore/ResourceSystem.h>
 #include <djvCore/Timer.h>
@@ -105,7 +105,7 @@ namespace djv
             std::list<ImageRequest> newImageRequests;
             std::list<ImageRequest> pendingImageRequests;
 
-            Memory::Cache<size_t, std::shared_ptr<AV::Image::Image> > imageCache;
+            Memory::LRUCache<size_t, std::shared_ptr<AV::Image::Image> > imageCache;
             std::atomic<float> imageCachePercentage;
 
             std::shared_ptr<Time::Timer> statsTimer;
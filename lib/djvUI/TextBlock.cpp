@@ -34,8 +34,8 @@
 #include <djvAV/FontSystem.h>
 #include <djvAV/Render2D.h>
 
-#include <djvCore/Cache.h>
 #include <djvCore/Context.h>
+#include <djvCore/LRUCache.h>
 #include <djvCore/Math.h>
 #include <djvCore/Memory.h>
 
@@ -62,7 +62,17 @@ namespace djv
             std::future<AV::Font::Metrics> fontMetricsFuture;
             typedef std::pair<AV::Font::Info, float> TextCacheKey;
             typedef std::pair<std::vector<AV::Font::TextLine>, glm::vec2> TextCacheValue;
-            Memory::Cache<TextCacheKey, TextCacheValue> textCache;
+            struct TextCacheKeyHash
+            {
+                size_t operator() (const TextCacheKey& value) const
+                {
+                    size_t out = 0;
+                    Memory::hashCombine(out, value.first.getHash());
+                    Memory::hashCombine(out, value.second);
+                    return out;
+                }
+            };
+            Memory::LRUCache<TextCacheKey, TextCacheValue, TextCacheKeyHash> textCache;
             BBox2f clipRect;
 
             TextCacheValue textLines(float);
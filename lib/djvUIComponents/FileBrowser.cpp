@@ -464,13 +464,13 @@ namespace djv
                     pathWidget->setPath(value);
                 });
 
-                p.fileInfoObserver = ListObserver<FileSystem::FileInfo>::create(
+                p.fileInfoObserver = ListObserver<FileSystem::FileInfo>::createChanges(
                     p.directoryModel->observeFileInfo(),
-                    [weak](const std::vector<FileSystem::FileInfo> & value)
+                    [weak](const std::vector<FileSystem::FileInfo> & value, const std::vector<ListChange> & changes)
                 {
                     if (auto widget = weak.lock())
                     {
-                        widget->_p->itemView->setItems(value);
+                        widget->_p->itemView->updateItems(value, changes);
                         widget->_p->itemCount = value.size();
                         widget->_p->itemCountLabel->setText(widget->_getItemCountLabel(value.size()));
                     }
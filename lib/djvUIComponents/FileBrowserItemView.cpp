@@ -40,6 +40,7 @@
 
 #include <djvCore/Context.h>
 #include <djvCore/FileInfo.h>
+#include <djvCore/ListObserver.h>
 
 using namespace djv::Core;
 
@@ -54,35 +55,88 @@ namespace djv
                 //! \todo Should this be configurable?
                 const float thumbnailFadeTime = .2F;
 
+                //! The number of pages of items that are kept materialized on
+                //! either side of the visible items.
+                const size_t itemWindowPages = 1;
+
                 const size_t invalid = static_cast<size_t>(-1);
 
+                //! This struct provides the state for a materialized item.
+                struct Item
+                {
+                    std::string name;
+                    bool nameLinesInit = false;
+                    std::vector<AV::Font::TextLine> nameLines;
+                    std::future<std::vector<AV::Font::TextLine> > nameLinesFuture;
+                    bool ioInfoInit = false;
+                    AV::IO::Info ioInfo;
+                    AV::ThumbnailSystem::InfoFuture ioInfoFuture;
+                    bool canReadInit = false;
+                    bool canRead = false;
+                    bool thumbnailInit = false;
+                    std::shared_ptr<AV::Image::Image> thumbnail;
+                    AV::ThumbnailSystem::ImageFuture thumbnailFuture;
+                    float thumbnailTimer = -1.F;
+                    bool nameGlyphsInit = false;
+                    std::vector<std::shared_ptr<AV::Font::Glyph> > nameGlyphs;
+                    std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > nameGlyphsFuture;
+                    bool sizeGlyphsInit = false;
+                    std::vector<std::shared_ptr<AV::Font::Glyph> > sizeGlyphs;
+                    std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > sizeGlyphsFuture;
+                    bool timeGlyphsInit = false;
+                    std::vector<std::shared_ptr<AV::Font::Glyph> > timeGlyphs;
+                    std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > timeGlyphsFuture;
+                    Core::UID fontUID = 0;
+
+                    //! Reset the item so that it can be recycled.
+                    void reset()
+                    {
+                        name.clear();
+                        nameLinesInit = false;
+                        nameLines.clear();
+                        nameLinesFuture = std::future<std::vector<AV::Font::TextLine> >();
+                        ioInfoInit = false;
+                        ioInfo = AV::IO::Info();
+                        ioInfoFuture = AV::ThumbnailSystem::InfoFuture();
+                        canReadInit = false;
+                        canRead = false;
+                        thumbnailInit = false;
+                        thumbnail.reset();
+                        thumbnailFuture = AV::ThumbnailSystem::ImageFuture();
+                        thumbnailTimer = -1.F;
+                        nameGlyphsInit = false;
+                        nameGlyphs.clear();
+                        nameGlyphsFuture = std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > >();
+                        sizeGlyphsInit = false;
+                        sizeGlyphs.clear();
+                        sizeGlyphsFuture = std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > >();
+                        timeGlyphsInit = false;
+                        timeGlyphs.clear();
+                        timeGlyphsFuture = std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > >();
+                    }
+                };
+
             } // namespace
 
             struct ItemView::Private
             {
                 std::shared_ptr<AV::Font::System> fontSystem;
+                std::shared_ptr<AV::ThumbnailSystem> thumbnailSystem;
+                std::shared_ptr<AV::IO::System> ioSystem;
                 ViewType viewType = ViewType::First;
                 std::vector<FileSystem::FileInfo> items;
                 AV::Font::Metrics nameFontMetrics;
                 std::future<AV::Font::Metrics> nameFontMetricsFuture;
-                std::map<size_t, BBox2f> itemGeometry;
-                std::map<size_t, std::string> names;
-                std::map<size_t, std::vector<AV::Font::TextLine> > nameLines;
-                std::map<size_t, std::future<std::vector<AV::Font::TextLine> > > nameLinesFutures;
-                std::map<size_t, AV::IO::Info> ioInfo;
-                std::map<size_t, AV::ThumbnailSystem::InfoFuture> ioInfoFutures;
+                glm::vec2 itemSize = glm::vec2(0.F, 0.F);
+                float itemSpacing = 0.F;
+                size_t columns = 1;
+                size_t visibleBegin = 0;
+                size_t visibleEnd = 0;
+                std::map<size_t, std::shared_ptr<Item> > itemState;
+                std::vector<std::shared_ptr<Item> > itemPool;
                 AV::Image::Size thumbnailSize = AV::Image::Size(100, 50);
-                std::map<size_t, std::shared_ptr<AV::Image::Image> > thumbnails;
-                std::map<size_t, AV::ThumbnailSystem::ImageFuture> thumbnailFutures;
-                std::map<size_t, float> thumbnailTimers;
                 std::map<FileSystem::FileType, std::shared_ptr<AV::Image::Image> > icons;
                 std::map<FileSystem::FileType, std::future<std::shared_ptr<AV::Image::Image> > > iconsFutures;
-                std::map<size_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > nameGlyphs;
-                std::map<size_t, std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > > nameGlyphsFutures;
-                std::map<size_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > sizeGlyphs;
-                std::map<size_t, std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > > sizeGlyphsFutures;
-                std::map<size_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > timeGlyphs;
-                std::map<size_t, std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > > timeGlyphsFutures;
                 std::vector<float> split = { .7F, .8F, 1.F };
                 AV::AlphaBlend alphaBlend = AV::AlphaBlend::First;
                 AV::OCIO::Config ocioConfig;
@@ -96,6 +150,17 @@ namespace djv
                 Event::PointerID pressedId = Event::InvalidID;
                 glm::vec2 pressedPos = glm::vec2(0.F, 0.F);
                 std::function<void(const FileSystem::FileInfo &)> callback;
+
+                BBox2f getItemGeometry(size_t, const BBox2f&) const;
+                void getItemRange(const BBox2f&, const BBox2f&, size_t& begin, size_t& end) const;
+                size_t getItemAt(const glm::vec2&, const BBox2f&) const;
+
+                std::shared_ptr<Item> getItem(size_t);
+                void cancelItem(Item&);
+                void releaseItems();
+                void releaseItems(size_t index, size_t count);
+                void insertItems(size_t index, size_t count);
+                void removeItems(size_t index, size_t count);
             };
 
             void ItemView::_init(const std::shared_ptr<Context>& context)
@@ -105,6 +170,8 @@ namespace djv
                 setClassName("djv::UI::FileBrowser::ItemView");
 
                 p.fontSystem = context->getSystemT<AV::Font::System>();
+                p.thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
+                p.ioSystem = context->getSystemT<AV::IO::System>();
 
                 auto avSystem = context->getSystemT<AV::AVSystem>();
                 auto weak = std::weak_ptr<ItemView>(std::dynamic_pointer_cast<ItemView>(shared_from_this()));
@@ -188,6 +255,60 @@ namespace djv
                 _itemsUpdate();
             }
 
+            void ItemView::updateItems(
+                const std::vector<FileSystem::FileInfo> & value,
+                const std::vector<ListChange> & changes)
+            {
+                DJV_PRIVATE_PTR();
+                for (const auto& i : changes)
+                {
+                    if (ListChangeType::Reset == i.type)
+                    {
+                        setItems(value);
+                        return;
+                    }
+                }
+
+                // Apply the changes to the items, keeping the state of the items
+                // that have not changed.
+                const size_t size = p.items.size();
+                for (const auto& i : changes)
+                {
+                    switch (i.type)
+                    {
+                    case ListChangeType::Insert:
+                        p.items.insert(
+                            p.items.begin() + i.index,
+                            value.begin() + i.index,
+                            value.begin() + i.index + i.count);
+                        p.insertItems(i.index, i.count);
+                        break;
+                    case ListChangeType::Remove:
+                        p.items.erase(
+                            p.items.begin() + i.index,
+                            p.items.begin() + i.index + i.count);
+                        p.removeItems(i.index, i.count);
+                        break;
+                    case ListChangeType::Update:
+                        for (size_t j = i.index; j < i.index + i.count; ++j)
+                        {
+                            p.items[j] = value[j];
+                        }
+                        p.releaseItems(i.index, i.count);
+                        break;
+                    default: break;
+                    }
+                }
+                p.hover = invalid;
+                p.grab = invalid;
+                if (p.items.size() != size)
+                {
+                    _resize();
+                }
+                _itemWindowUpdate();
+                _redraw();
+            }
+
             void ItemView::setCallback(const std::function<void(const FileSystem::FileInfo &)> & value)
             {
                 _p->callback = value;
@@ -237,38 +358,28 @@ namespace djv
                 const float m = style->getMetric(MetricsRole::MarginSmall);
                 const float s = style->getMetric(MetricsRole::Spacing);
                 const float sh = style->getMetric(MetricsRole::Shadow);
-                p.itemGeometry.clear();
-                glm::vec2 pos = g.min;
-                auto item = p.items.begin();
-                size_t i = 0;
                 switch (p.viewType)
                 {
                 case ViewType::Tiles:
-                    pos += s;
-                    for (; item != p.items.end(); ++item, ++i)
+                {
+                    p.itemSize.x = p.thumbnailSize.w + sh * 2.F;
+                    p.itemSize.y = p.thumbnailSize.h + p.nameFontMetrics.lineHeight * 2.F + m * 2.F + sh * 2.F;
+                    p.itemSpacing = s;
+                    p.columns = 1;
+                    if (p.itemSize.x + s > 0.F)
                     {
-                        const float itemHeight = p.thumbnailSize.h + p.nameFontMetrics.lineHeight * 2.F + m * 2.F + sh * 2.F;
-                        const float itemWidth = p.thumbnailSize.w + sh * 2.F;
-                        p.itemGeometry[i] = BBox2f(pos.x, pos.y, itemWidth, itemHeight);
-                        pos.x += itemWidth;
-                        if (pos.x > g.max.x - itemWidth)
-                        {
-                            pos.x = g.min.x + s;
-                            pos.y += itemHeight + s;
-                        }
-                        else
+                        while (g.min.x + s + (p.columns - 1) * (p.itemSize.x + s) + p.itemSize.x <= g.max.x - p.itemSize.x)
                         {
-                            pos.x += s;
+                            ++p.columns;
                         }
                     }
                     break;
+                }
                 case ViewType::List:
-                    for (; item != p.items.end(); ++item, ++i)
-                    {
-                        const float itemHeight = std::max(static_cast<float>(p.thumbnailSize.h), p.nameFontMetrics.lineHeight + m * 2.F);
-                        p.itemGeometry[i] = BBox2f(pos.x, pos.y, g.w(), itemHeight);
-                        pos.y += itemHeight;
-                    }
+                    p.itemSize.x = g.w();
+                    p.itemSize.y = std::max(static_cast<float>(p.thumbnailSize.h), p.nameFontMetrics.lineHeight + m * 2.F);
+                    p.itemSpacing = 0.F;
+                    p.columns = 1;
                     break;
                 default: break;
                 }
@@ -279,113 +390,14 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 if (isClipped())
                     return;
-                if (auto context = getContext().lock())
-                {
-                    const auto& style = _getStyle();
-                    const auto& clipRect = event.getClipRect();
-                    for (const auto& i : p.itemGeometry)
-                    {
-                        if (i.first < p.items.size() && i.second.intersects(clipRect))
-                        {
-                            const auto& fileInfo = p.items[i.first];
-                            {
-                                const auto j = p.nameLines.find(i.first);
-                                if (j == p.nameLines.end())
-                                {
-                                    const auto k = p.nameLinesFutures.find(i.first);
-                                    if (k == p.nameLinesFutures.end())
-                                    {
-                                        const float m = style->getMetric(MetricsRole::MarginSmall);
-                                        const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                        p.names[i.first] = fileInfo.getFileName(Frame::invalid, false);
-                                        p.nameLinesFutures[i.first] = p.fontSystem->textLines(
-                                            p.names[i.first],
-                                            p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
-                                            fontInfo);
-                                    }
-                                }
-                            }
-                            if (p.ioInfo.find(i.first) == p.ioInfo.end())
-                            {
-                                if (p.ioInfoFutures.find(i.first) == p.ioInfoFutures.end())
-                                {
-                                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                                    auto ioSystem = context->getSystemT<AV::IO::System>();
-                                    if (thumbnailSystem && ioSystem)
-                                    {
-                                        if (ioSystem->canRead(fileInfo))
-                                        {
-                                            p.ioInfoFutures[i.first] = thumbnailSystem->getInfo(fileInfo);
-                                        }
-                                    }
-                                }
-                            }
-                            if (p.thumbnails.find(i.first) == p.thumbnails.end())
-                            {
-                                if (p.thumbnailFutures.find(i.first) == p.thumbnailFutures.end())
-                                {
-                                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                                    auto ioSystem = context->getSystemT<AV::IO::System>();
-                                    if (thumbnailSystem && ioSystem && ioSystem->canRead(fileInfo))
-                                    {
-                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
-                                    }
-                                }
-                            }
-                            if (p.nameGlyphs.find(i.first) == p.nameGlyphs.end())
-                            {
-                                if (p.nameGlyphsFutures.find(i.first) == p.nameGlyphsFutures.end())
-                                {
-                                    const std::string& label = fileInfo.getFileName(Frame::invalid, false);
-                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                    p.nameGlyphsFutures[i.first] = p.fontSystem->getGlyphs(label, fontInfo);
-                                }
-                            }
-                            if (p.sizeGlyphs.find(i.first) == p.sizeGlyphs.end())
-                            {
-                                if (p.sizeGlyphsFutures.find(i.first) == p.sizeGlyphsFutures.end())
-                                {
-                                    const std::string& label = Memory::getSizeLabel(fileInfo.getSize());
-                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                    p.sizeGlyphsFutures[i.first] = p.fontSystem->getGlyphs(label, fontInfo);
-                                }
-                            }
-                            if (p.timeGlyphs.find(i.first) == p.timeGlyphs.end())
-                            {
-                                if (p.timeGlyphsFutures.find(i.first) == p.timeGlyphsFutures.end())
-                                {
-                                    const std::string& label = Time::getLabel(fileInfo.getTime());
-                                    const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                    p.timeGlyphsFutures[i.first] = p.fontSystem->getGlyphs(label, fontInfo);
-                                }
-                            }
-                        }
-                        else if (auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>())
-                        {
-                            {
-                                const auto j = p.ioInfoFutures.find(i.first);
-                                if (j != p.ioInfoFutures.end())
-                                {
-                                    thumbnailSystem->cancelInfo(j->second.uid);
-                                    p.ioInfoFutures.erase(j);
-                                }
-                            }
-                            {
-                                const auto j = p.thumbnailFutures.find(i.first);
-                                if (j != p.thumbnailFutures.end())
-                                {
-                                    thumbnailSystem->cancelImage(j->second.uid);
-                                    p.thumbnailFutures.erase(j);
-                                }
-                            }
-                        }
-                    }
-                }
+                p.getItemRange(event.getClipRect(), getGeometry(), p.visibleBegin, p.visibleEnd);
+                _itemWindowUpdate();
             }
 
             void ItemView::_paintEvent(Event::Paint & event)
             {
                 DJV_PRIVATE_PTR();
+                const BBox2f & g = getGeometry();
                 const auto& style = _getStyle();
                 const float m = style->getMetric(MetricsRole::MarginSmall);
                 const float s = style->getMetric(MetricsRole::Spacing);
@@ -393,14 +405,15 @@ namespace djv
 
                 auto render = _getRender();
                 const float ut = _getUpdateTime();
-                auto item = p.items.begin();
-                size_t index = 0;
-                for (; item != p.items.end(); ++item, ++index)
+                for (size_t index = p.visibleBegin; index < p.visibleEnd && index < p.items.size(); ++index)
                 {
-                    const auto i = p.itemGeometry.find(index);
-                    if (i != p.itemGeometry.end())
+                    const auto i = p.itemState.find(index);
+                    if (i != p.itemState.end())
                     {
-                        BBox2f itemGeometry = i->second;
+                        const auto& fileInfo = p.items[index];
+                        const auto& item = i->second;
+                        const BBox2f geometry = p.getItemGeometry(index, g);
+                        BBox2f itemGeometry = geometry;
 
                         if (ViewType::Tiles == p.viewType)
                         {
@@ -420,71 +433,64 @@ namespace djv
                                 itemGeometry.h()));
                         }
                         float opacity = 0.F;
+                        if (item->thumbnail)
                         {
-                            const auto j = p.thumbnails.find(index);
-                            if (j != p.thumbnails.end())
+                            opacity = 1.F;
+                            if (item->thumbnailTimer >= 0.F)
                             {
-                                if (j->second)
+                                opacity = std::min((ut - item->thumbnailTimer) / thumbnailFadeTime, 1.F);
+                            }
+                            const uint32_t w = item->thumbnail->getWidth();
+                            const uint32_t h = item->thumbnail->getHeight();
+                            glm::vec2 pos(0.F, 0.F);
+                            switch (p.viewType)
+                            {
+                            case ViewType::Tiles:
+                                pos.x = floor(geometry.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
+                                pos.y = floor(geometry.min.y + sh + p.thumbnailSize.h - h);
+                                break;
+                            case ViewType::List:
+                                pos.x = floor(geometry.min.x);
+                                pos.y = floor(geometry.min.y + geometry.h() / 2.F - h / 2.F);
+                                break;
+                            default: break;
+                            }
+                            render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F, opacity));
+                            AV::Render::ImageOptions options;
+                            options.alphaBlend = p.alphaBlend;
+                            auto l = p.ocioConfig.fileColorSpaces.find(item->thumbnail->getPluginName());
+                            if (l != p.ocioConfig.fileColorSpaces.end())
+                            {
+                                options.colorSpace.input = l->second;
+                            }
+                            else
+                            {
+                                l = p.ocioConfig.fileColorSpaces.find(std::string());
+                                if (l != p.ocioConfig.fileColorSpaces.end())
                                 {
-                                    opacity = 1.F;
-                                    const auto k = p.thumbnailTimers.find(index);
-                                    if (k != p.thumbnailTimers.end())
-                                    {
-                                        opacity = std::min((ut - k->second) / thumbnailFadeTime, 1.F);
-                                    }
-                                    const uint16_t w = j->second->getWidth();
-                                    const uint16_t h = j->second->getHeight();
-                                    glm::vec2 pos(0.F, 0.F);
-                                    switch (p.viewType)
-                                    {
-                                    case ViewType::Tiles:
-                                        pos.x = floor(i->second.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
-                                        pos.y = floor(i->second.min.y + sh + p.thumbnailSize.h - h);
-                                        break;
-                                    case ViewType::List:
-                                        pos.x = floor(i->second.min.x);
-                                        pos.y = floor(i->second.min.y + i->second.h() / 2.F - h / 2.F);
-                                        break;
-                                    default: break;
-                                    }
-                                    render->setFillColor(AV::Image::Color(1.F, 1.F, 1.F, opacity));
-                                    AV::Render::ImageOptions options;
-                                    options.alphaBlend = p.alphaBlend;
-                                    auto l = p.ocioConfig.fileColorSpaces.find(j->second->getPluginName());
-                                    if (l != p.ocioConfig.fileColorSpaces.end())
-                                    {
-                                        options.colorSpace.input = l->second;
-                                    }
-                                    else
-                                    {
-                                        l = p.ocioConfig.fileColorSpaces.find(std::string());
-                                        if (l != p.ocioConfig.fileColorSpaces.end())
-                                        {
-                                            options.colorSpace.input = l->second;
-                                        }
-                                    }
-                                    options.colorSpace.output = p.outputColorSpace;
-                                    render->drawImage(j->second, pos, options);
+                                    options.colorSpace.input = l->second;
                                 }
                             }
+                            options.colorSpace.output = p.outputColorSpace;
+                            render->drawImage(item->thumbnail, pos, options);
                         }
                         if (opacity < 1.F)
                         {
-                            const auto j = p.icons.find(item->getType());
+                            const auto j = p.icons.find(fileInfo.getType());
                             if (j != p.icons.end())
                             {
-                                const uint16_t w = j->second->getWidth();
-                                const uint16_t h = j->second->getHeight();
+                                const uint32_t w = j->second->getWidth();
+                                const uint32_t h = j->second->getHeight();
                                 glm::vec2 pos(0.F, 0.F);
                                 switch (p.viewType)
                                 {
                                 case ViewType::Tiles:
-                                    pos.x = floor(i->second.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
-                                    pos.y = floor(i->second.min.y + sh + p.thumbnailSize.h - h);
+                                    pos.x = floor(geometry.min.x + sh + p.thumbnailSize.w / 2.F - w / 2.F);
+                                    pos.y = floor(geometry.min.y + sh + p.thumbnailSize.h - h);
                                     break;
                                 case ViewType::List:
-                                    pos.x = floor(i->second.min.x);
-                                    pos.y = floor(i->second.min.y + i->second.h() / 2.F - h / 2.F);
+                                    pos.x = floor(geometry.min.x);
+                                    pos.y = floor(geometry.min.y + geometry.h() / 2.F - h / 2.F);
                                     break;
                                 default: break;
                                 }
@@ -501,14 +507,12 @@ namespace djv
                             {
                             case ViewType::Tiles:
                             {
-                                const auto j = p.names.find(index);
-                                const auto k = p.nameLines.find(index);
-                                if (j != p.names.end() && k != p.nameLines.end())
+                                if (item->nameLinesInit)
                                 {
-                                    float x = i->second.min.x + m + sh;
-                                    float y = i->second.max.y - p.nameFontMetrics.lineHeight * std::min(k->second.size(), static_cast<size_t>(2)) - m - sh;
+                                    float x = geometry.min.x + m + sh;
+                                    float y = geometry.max.y - p.nameFontMetrics.lineHeight * std::min(item->nameLines.size(), static_cast<size_t>(2)) - m - sh;
                                     size_t line = 0;
-                                    for (auto l = k->second.begin(); l != k->second.end() && line < 2; ++l, ++line)
+                                    for (auto l = item->nameLines.begin(); l != item->nameLines.end() && line < 2; ++l, ++line)
                                     {
                                         //! \bug Why the extra subtract by one here?
                                         render->drawText(
@@ -524,14 +528,13 @@ namespace djv
                             }
                             case ViewType::List:
                             {
-                                float x = i->second.min.x + p.thumbnailSize.w + s;
-                                float y = i->second.min.y + i->second.h() / 2.F - p.nameFontMetrics.lineHeight / 2.F;
-                                auto j = p.nameGlyphs.find(index);
-                                if (j != p.nameGlyphs.end())
+                                float x = geometry.min.x + p.thumbnailSize.w + s;
+                                float y = geometry.min.y + geometry.h() / 2.F - p.nameFontMetrics.lineHeight / 2.F;
+                                if (item->nameGlyphsInit)
                                 {
                                     //! \bug Why the extra subtract by one here?
                                     render->drawText(
-                                        j->second,
+                                        item->nameGlyphs,
                                         glm::vec2(
                                             floorf(x),
                                             floorf(y + p.nameFontMetrics.ascender - 1.F)));
@@ -539,9 +542,8 @@ namespace djv
 
                                 render->popClipRect();
 
-                                x = i->second.min.x + i->second.w() * p.split[0] + m;
-                                j = p.sizeGlyphs.find(index);
-                                if (j != p.sizeGlyphs.end())
+                                x = geometry.min.x + geometry.w() * p.split[0] + m;
+                                if (item->sizeGlyphsInit)
                                 {
                                     render->pushClipRect(BBox2f(
                                         itemGeometry.min.x + itemGeometry.w() * p.split[0],
@@ -551,7 +553,7 @@ namespace djv
 
                                     //! \bug Why the extra subtract by one here?
                                     render->drawText(
-                                        j->second,
+                                        item->sizeGlyphs,
                                         glm::vec2(
                                             floorf(x),
                                             floorf(y + p.nameFontMetrics.ascender - 1.F)));
@@ -559,9 +561,8 @@ namespace djv
                                     render->popClipRect();
                                 }
 
-                                x = i->second.min.x + i->second.w() * p.split[1] + m;
-                                j = p.timeGlyphs.find(index);
-                                if (j != p.timeGlyphs.end())
+                                x = geometry.min.x + geometry.w() * p.split[1] + m;
+                                if (item->timeGlyphsInit)
                                 {
                                     render->pushClipRect(BBox2f(
                                         itemGeometry.min.x + itemGeometry.w() * p.split[1],
@@ -571,7 +572,7 @@ namespace djv
 
                                     //! \bug Why the extra subtract by one here?
                                     render->drawText(
-                                        j->second,
+                                        item->timeGlyphs,
                                         glm::vec2(
                                             floorf(x),
                                             floorf(y + p.nameFontMetrics.ascender - 1.F)));
@@ -603,14 +604,11 @@ namespace djv
                 DJV_PRIVATE_PTR();
                 event.accept();
                 const auto & pointerInfo = event.getPointerInfo();
-                for (const auto & i : p.itemGeometry)
+                const size_t index = p.getItemAt(pointerInfo.pos, getGeometry());
+                if (index != invalid)
                 {
-                    if (i.second.contains(pointerInfo.pos))
-                    {
-                        p.hover = i.first;
-                        _redraw();
-                        break;
-                    }
+                    p.hover = index;
+                    _redraw();
                 }
             }
 
@@ -645,14 +643,11 @@ namespace djv
                 }
                 else
                 {
-                    for (const auto & i : p.itemGeometry)
+                    const size_t index = p.getItemAt(pointerInfo.pos, getGeometry());
+                    if (index != invalid)
                     {
-                        if (i.second.contains(pointerInfo.pos))
-                        {
-                            p.hover = i.first;
-                            _redraw();
-                            break;
-                        }
+                        p.hover = index;
+                        _redraw();
                     }
                 }
             }
@@ -663,17 +658,14 @@ namespace djv
                 if (p.pressedId)
                     return;
                 const auto & pointerInfo = event.getPointerInfo();
-                for (const auto & i : p.itemGeometry)
+                const size_t index = p.getItemAt(pointerInfo.pos, getGeometry());
+                if (index != invalid)
                 {
-                    if (i.second.contains(pointerInfo.pos))
-                    {
-                        event.accept();
-                        p.grab = i.first;
-                        p.pressedId = pointerInfo.id;
-                        p.pressedPos = pointerInfo.pos;
-                        _redraw();
-                        break;
-                    }
+                    event.accept();
+                    p.grab = index;
+                    p.pressedId = pointerInfo.id;
+                    p.pressedPos = pointerInfo.pos;
+                    _redraw();
                 }
             }
 
@@ -690,15 +682,10 @@ namespace djv
                     const auto i = hover.find(pointerInfo.id);
                     if (p.callback && i != hover.end())
                     {
-                        for (const auto & j : p.itemGeometry)
+                        const size_t index = p.getItemAt(i->second, getGeometry());
+                        if (index != invalid)
                         {
-                            if (j.second.contains(i->second))
-                            {
-                                if (j.first < p.items.size())
-                                {
-                                    p.callback(p.items[j.first]);
-                                }
-                            }
+                            p.callback(p.items[index]);
                         }
                     }
                     _redraw();
@@ -709,24 +696,18 @@ namespace djv
             {
                 DJV_PRIVATE_PTR();
                 std::string text;
-                for (const auto & i : p.itemGeometry)
+                const size_t index = p.getItemAt(pos, getGeometry());
+                if (index != invalid)
                 {
-                    if (i.second.contains(pos))
+                    const auto & fileInfo = p.items[index];
+                    const auto i = p.itemState.find(index);
+                    if (i != p.itemState.end() && i->second->ioInfoInit)
                     {
-                        if (i.first < p.items.size())
-                        {
-                            const auto & fileInfo = p.items[i.first];
-                            const auto j = p.ioInfo.find(i.first);
-                            if (j != p.ioInfo.end())
-                            {
-                                text = _getTooltip(fileInfo, j->second);
-                            }
-                            else
-                            {
-                                text = _getTooltip(fileInfo);
-                            }
-                        }
-                        break;
+                        text = _getTooltip(fileInfo, i->second->ioInfo);
+                    }
+                    else
+                    {
+                        text = _getTooltip(fileInfo);
                     }
                 }
                 return !text.empty() ? _createTooltipDefault(text) : nullptr;
@@ -754,193 +735,134 @@ namespace djv
                         _log(e.what(), LogLevel::Error);
                     }
                 }
+                const float ut = _getUpdateTime();
+                bool thumbnailTimers = false;
+                for (const auto& i : p.itemState)
                 {
-                    auto i = p.nameLinesFutures.begin();
-                    while (i != p.nameLinesFutures.end())
+                    auto& item = *i.second;
+                    if (item.nameLinesFuture.valid() &&
+                        item.nameLinesFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        if (i->second.valid() &&
-                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        try
                         {
-                            try
-                            {
-                                p.nameLines[i->first] = i->second.get();
-                                _redraw();
-                            }
-                            catch (const std::exception & e)
-                            {
-                                _log(e.what(), LogLevel::Error);
-                            }
-                            i = p.nameLinesFutures.erase(i);
+                            item.nameLines = item.nameLinesFuture.get();
+                            item.nameLinesInit = true;
+                            _redraw();
                         }
-                        else
+                        catch (const std::exception & e)
                         {
-                            ++i;
+                            _log(e.what(), LogLevel::Error);
                         }
                     }
-                }
-                {
-                    auto i = p.ioInfoFutures.begin();
-                    while (i != p.ioInfoFutures.end())
+                    if (item.ioInfoFuture.future.valid() &&
+                        item.ioInfoFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        if (i->second.future.valid() &&
-                            i->second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        item.ioInfoInit = true;
+                        try
                         {
-                            try
-                            {
-                                p.ioInfo[i->first] = i->second.future.get();
-                            }
-                            catch (const std::exception & e)
-                            {
-                                p.ioInfo[i->first] = AV::IO::Info();
-                                std::stringstream ss;
-                                ss << DJV_TEXT("The file") << " '" << p.names[i->first] << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
-                                _log(ss.str(), LogLevel::Error);
-                            }
-                            i = p.ioInfoFutures.erase(i);
+                            item.ioInfo = item.ioInfoFuture.future.get();
                         }
-                        else
+                        catch (const std::exception & e)
                         {
-                            ++i;
+                            item.ioInfo = AV::IO::Info();
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << item.name << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
+                            _log(ss.str(), LogLevel::Error);
                         }
                     }
-                }
-                {
-                    auto i = p.thumbnailFutures.begin();
-                    while (i != p.thumbnailFutures.end())
+                    if (item.thumbnailFuture.future.valid() &&
+                        item.thumbnailFuture.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        if (i->second.future.valid() &&
-                            i->second.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        item.thumbnailInit = true;
+                        item.thumbnail = nullptr;
+                        try
                         {
-                            p.thumbnails[i->first] = nullptr;
-                            try
-                            {
-                                if (const auto image = i->second.future.get())
-                                {
-                                    p.thumbnails[i->first] = image;
-                                    p.thumbnailTimers[i->first] = _getUpdateTime();
-                                    _redraw();
-                                }
-                            }
-                            catch (const std::exception & e)
+                            if (const auto image = item.thumbnailFuture.future.get())
                             {
-                                std::stringstream ss;
-                                ss << DJV_TEXT("The file") << " '" << p.names[i->first] << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
-                                _log(ss.str(), LogLevel::Error);
+                                item.thumbnail = image;
+                                item.thumbnailTimer = ut;
+                                _redraw();
                             }
-                            i = p.thumbnailFutures.erase(i);
                         }
-                        else
+                        catch (const std::exception & e)
                         {
-                            ++i;
+                            std::stringstream ss;
+                            ss << DJV_TEXT("The file") << " '" << item.name << "' " << DJV_TEXT("cannot be read") << ". " << e.what();
+                            _log(ss.str(), LogLevel::Error);
                         }
                     }
-                }
-                if (p.thumbnailTimers.size())
-                {
-                    const float ut = _getUpdateTime();
-                    auto i = p.thumbnailTimers.begin();
-                    while (i != p.thumbnailTimers.end())
+                    if (item.thumbnailTimer >= 0.F)
                     {
-                        if ((ut - i->second) > thumbnailFadeTime)
+                        if ((ut - item.thumbnailTimer) > thumbnailFadeTime)
                         {
-                            i = p.thumbnailTimers.erase(i);
-                        }
-                        else
-                        {
-                            ++i;
+                            item.thumbnailTimer = -1.F;
                         }
+                        thumbnailTimers = true;
                     }
-                    _redraw();
-                }
-                {
-                    auto i = p.iconsFutures.begin();
-                    while (i != p.iconsFutures.end())
+                    if (item.nameGlyphsFuture.valid() &&
+                        item.nameGlyphsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        if (i->second.valid() &&
-                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        try
                         {
-                            try
-                            {
-                                p.icons[i->first] = i->second.get();
-                                _redraw();
-                            }
-                            catch (const std::exception & e)
-                            {
-                                _log(e.what(), LogLevel::Error);
-                            }
-                            i = p.iconsFutures.erase(i);
+                            item.nameGlyphs = item.nameGlyphsFuture.get();
+                            item.nameGlyphsInit = true;
+                            _redraw();
                         }
-                        else
+                        catch (const std::exception & e)
                         {
-                            ++i;
+                            _log(e.what(), LogLevel::Error);
                         }
                     }
-                }
-                {
-                    auto i = p.nameGlyphsFutures.begin();
-                    while (i != p.nameGlyphsFutures.end())
+                    if (item.sizeGlyphsFuture.valid() &&
+                        item.sizeGlyphsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        if (i->second.valid() &&
-                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        try
                         {
-                            try
-                            {
-                                p.nameGlyphs[i->first] = i->second.get();
-                                _redraw();
-                            }
-                            catch (const std::exception & e)
-                            {
-                                _log(e.what(), LogLevel::Error);
-                            }
-                            i = p.nameGlyphsFutures.erase(i);
+                            item.sizeGlyphs = item.sizeGlyphsFuture.get();
+                            item.sizeGlyphsInit = true;
+                            _redraw();
                         }
-                        else
+                        catch (const std::exception & e)
                         {
-                            ++i;
+                            _log(e.what(), LogLevel::Error);
                         }
                     }
-                }
-                {
-                    auto i = p.sizeGlyphsFutures.begin();
-                    while (i != p.sizeGlyphsFutures.end())
+                    if (item.timeGlyphsFuture.valid() &&
+                        item.timeGlyphsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                     {
-                        if (i->second.valid() &&
-                            i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                        try
                         {
-                            try
-                            {
-                                p.sizeGlyphs[i->first] = i->second.get();
-                                _redraw();
-                            }
-                            catch (const std::exception & e)
-                            {
-                                _log(e.what(), LogLevel::Error);
-                            }
-                            i = p.sizeGlyphsFutures.erase(i);
+                            item.timeGlyphs = item.timeGlyphsFuture.get();
+                            item.timeGlyphsInit = true;
+                            _redraw();
                         }
-                        else
+                        catch (const std::exception & e)
                         {
-                            ++i;
+                            _log(e.what(), LogLevel::Error);
                         }
                     }
                 }
+                if (thumbnailTimers)
                 {
-                    auto i = p.timeGlyphsFutures.begin();
-                    while (i != p.timeGlyphsFutures.end())
+                    _redraw();
+                }
+                {
+                    auto i = p.iconsFutures.begin();
+                    while (i != p.iconsFutures.end())
                     {
                         if (i->second.valid() &&
                             i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                         {
                             try
                             {
-                                p.timeGlyphs[i->first] = i->second.get();
+                                p.icons[i->first] = i->second.get();
                                 _redraw();
                             }
                             catch (const std::exception & e)
                             {
                                 _log(e.what(), LogLevel::Error);
                             }
-                            i = p.timeGlyphsFutures.erase(i);
+                            i = p.iconsFutures.erase(i);
                         }
                         else
                         {
@@ -1035,97 +957,282 @@ namespace djv
             void ItemView::_thumbnailsSizeUpdate()
             {
                 DJV_PRIVATE_PTR();
-                if (auto context = getContext().lock())
+                for (const auto& i : p.itemState)
                 {
-                    p.thumbnails.clear();
-                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                    const auto& style = _getStyle();
-                    p.names.clear();
-                    p.nameLines.clear();
-                    p.nameLinesFutures.clear();
-                    for (const auto& i : p.itemGeometry)
+                    auto& item = *i.second;
+                    if (item.thumbnailFuture.future.valid() && p.thumbnailSystem)
+                    {
+                        p.thumbnailSystem->cancelImage(item.thumbnailFuture.uid);
+                    }
+                    item.thumbnailInit = false;
+                    item.thumbnail.reset();
+                    item.thumbnailFuture = AV::ThumbnailSystem::ImageFuture();
+                    item.thumbnailTimer = -1.F;
+                    item.nameLinesInit = false;
+                    item.nameLines.clear();
+                    item.nameLinesFuture = std::future<std::vector<AV::Font::TextLine> >();
+                }
+                _itemWindowUpdate();
+            }
+
+            void ItemView::_itemsUpdate()
+            {
+                DJV_PRIVATE_PTR();
+                const auto& style = _getStyle();
+                p.nameFontMetricsFuture = p.fontSystem->getMetrics(
+                    style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium));
+                p.releaseItems();
+                p.visibleBegin = 0;
+                p.visibleEnd = 0;
+                p.hover = invalid;
+                p.grab = invalid;
+                _resize();
+            }
+
+            void ItemView::_itemWindowUpdate()
+            {
+                DJV_PRIVATE_PTR();
+
+                // Release the items that have moved outside of the window around
+                // the visible items, and cancel pending requests for items that
+                // are no longer visible.
+                const size_t windowSize = (p.visibleEnd - p.visibleBegin) * itemWindowPages;
+                const size_t windowBegin = p.visibleBegin > windowSize ? p.visibleBegin - windowSize : 0;
+                const size_t windowEnd = p.visibleEnd + windowSize;
+                auto i = p.itemState.begin();
+                while (i != p.itemState.end())
+                {
+                    if (i->first < windowBegin || i->first >= windowEnd)
+                    {
+                        p.cancelItem(*i->second);
+                        i->second->reset();
+                        p.itemPool.push_back(i->second);
+                        i = p.itemState.erase(i);
+                    }
+                    else
                     {
-                        const auto j = p.thumbnailFutures.find(i.first);
-                        if (j != p.thumbnailFutures.end())
+                        if (i->first < p.visibleBegin || i->first >= p.visibleEnd)
                         {
-                            thumbnailSystem->cancelImage(j->second.uid);
-                            p.thumbnailFutures.erase(j);
+                            p.cancelItem(*i->second);
                         }
+                        ++i;
                     }
-                    p.thumbnailFutures.clear();
+                }
 
-                    const auto& clipRect = getClipRect();
-                    for (const auto& i : p.itemGeometry)
+                // Request data for the visible items.
+                const auto& style = _getStyle();
+                const float m = style->getMetric(MetricsRole::MarginSmall);
+                const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
+                for (size_t index = p.visibleBegin; index < p.visibleEnd && index < p.items.size(); ++index)
+                {
+                    const auto& fileInfo = p.items[index];
+                    auto item = p.getItem(index);
+                    if (item->name.empty())
+                    {
+                        item->name = fileInfo.getFileName(Frame::invalid, false);
+                    }
+                    if (!item->fontUID)
+                    {
+                        item->fontUID = createUID();
+                    }
+                    if (!item->nameLinesInit && !item->nameLinesFuture.valid())
                     {
-                        if (i.first < p.items.size() && i.second.intersects(clipRect))
+                        item->nameLinesFuture = p.fontSystem->textLines(
+                            item->name,
+                            p.thumbnailSize.w - static_cast<uint32_t>(m * 2.F),
+                            fontInfo,
+                            item->fontUID);
+                    }
+                    if ((!item->ioInfoInit && !item->ioInfoFuture.future.valid()) ||
+                        (!item->thumbnailInit && !item->thumbnailFuture.future.valid()))
+                    {
+                        if (!item->canReadInit)
                         {
-                            if (p.thumbnails.find(i.first) == p.thumbnails.end())
+                            item->canReadInit = true;
+                            item->canRead = p.thumbnailSystem && p.ioSystem && p.ioSystem->canRead(fileInfo);
+                        }
+                        if (item->canRead)
+                        {
+                            if (!item->ioInfoInit && !item->ioInfoFuture.future.valid())
                             {
-                                const auto& fileInfo = p.items[i.first];
-                                {
-                                    const auto j = p.nameLines.find(i.first);
-                                    if (j == p.nameLines.end())
-                                    {
-                                        const auto k = p.nameLinesFutures.find(i.first);
-                                        if (k == p.nameLinesFutures.end())
-                                        {
-                                            const float m = style->getMetric(MetricsRole::MarginSmall);
-                                            const auto fontInfo = style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium);
-                                            p.names[i.first] = fileInfo.getFileName(Frame::invalid, false);
-                                            p.nameLinesFutures[i.first] = p.fontSystem->textLines(
-                                                p.names[i.first],
-                                                p.thumbnailSize.w - static_cast<uint16_t>(m * 2.F),
-                                                fontInfo);
-                                        }
-                                    }
-                                }
-                                if (p.thumbnailFutures.find(i.first) == p.thumbnailFutures.end())
-                                {
-                                    auto ioSystem = context->getSystemT<AV::IO::System>();
-                                    if (ioSystem && ioSystem->canRead(fileInfo))
-                                    {
-                                        p.thumbnailFutures[i.first] = thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
-                                    }
-                                }
+                                item->ioInfoFuture = p.thumbnailSystem->getInfo(fileInfo);
+                            }
+                            if (!item->thumbnailInit && !item->thumbnailFuture.future.valid())
+                            {
+                                item->thumbnailFuture = p.thumbnailSystem->getImage(fileInfo, p.thumbnailSize);
                             }
                         }
                     }
+                    if (!item->nameGlyphsInit && !item->nameGlyphsFuture.valid())
+                    {
+                        item->nameGlyphsFuture = p.fontSystem->getGlyphs(item->name, fontInfo, item->fontUID);
+                    }
+                    if (!item->sizeGlyphsInit && !item->sizeGlyphsFuture.valid())
+                    {
+                        item->sizeGlyphsFuture = p.fontSystem->getGlyphs(Memory::getSizeLabel(fileInfo.getSize()), fontInfo, item->fontUID);
+                    }
+                    if (!item->timeGlyphsInit && !item->timeGlyphsFuture.valid())
+                    {
+                        item->timeGlyphsFuture = p.fontSystem->getGlyphs(Time::getLabel(fileInfo.getTime()), fontInfo, item->fontUID);
+                    }
                 }
             }
 
-            void ItemView::_itemsUpdate()
+            BBox2f ItemView::Private::getItemGeometry(size_t index, const BBox2f& g) const
             {
-                DJV_PRIVATE_PTR();
-                if (auto context = getContext().lock())
+                BBox2f out(0.F, 0.F, 0.F, 0.F);
+                switch (viewType)
                 {
-                    const auto& style = _getStyle();
-                    p.nameFontMetricsFuture = p.fontSystem->getMetrics(
-                        style->getFontInfo(AV::Font::faceDefault, MetricsRole::FontMedium));
-                    p.names.clear();
-                    p.nameLines.clear();
-                    p.nameLinesFutures.clear();
-                    p.ioInfo.clear();
-                    p.ioInfoFutures.clear();
-                    p.thumbnails.clear();
-                    auto thumbnailSystem = context->getSystemT<AV::ThumbnailSystem>();
-                    for (const auto& i : p.itemGeometry)
+                case ViewType::Tiles:
+                {
+                    const size_t row = index / columns;
+                    const size_t column = index % columns;
+                    out = BBox2f(
+                        g.min.x + itemSpacing + column * (itemSize.x + itemSpacing),
+                        g.min.y + itemSpacing + row * (itemSize.y + itemSpacing),
+                        itemSize.x,
+                        itemSize.y);
+                    break;
+                }
+                case ViewType::List:
+                    out = BBox2f(g.min.x, g.min.y + index * itemSize.y, itemSize.x, itemSize.y);
+                    break;
+                default: break;
+                }
+                return out;
+            }
+
+            void ItemView::Private::getItemRange(const BBox2f& rect, const BBox2f& g, size_t& begin, size_t& end) const
+            {
+                begin = 0;
+                end = 0;
+                const float rowHeight = itemSize.y + itemSpacing;
+                if (items.size() && rowHeight > 0.F && rect.intersects(g))
+                {
+                    const size_t rowBegin = static_cast<size_t>(std::max(rect.min.y - g.min.y - itemSpacing, 0.F) / rowHeight);
+                    const size_t rowEnd = static_cast<size_t>(std::max(rect.max.y - g.min.y - itemSpacing, 0.F) / rowHeight) + 1;
+                    begin = std::min(rowBegin * columns, items.size());
+                    end = std::min(rowEnd * columns, items.size());
+                }
+            }
+
+            size_t ItemView::Private::getItemAt(const glm::vec2& pos, const BBox2f& g) const
+            {
+                size_t out = invalid;
+                size_t begin = 0;
+                size_t end = 0;
+                getItemRange(BBox2f(pos.x, pos.y, 0.F, 0.F), g, begin, end);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    if (getItemGeometry(i, g).contains(pos))
                     {
-                        const auto j = p.thumbnailFutures.find(i.first);
-                        if (j != p.thumbnailFutures.end())
-                        {
-                            thumbnailSystem->cancelImage(j->second.uid);
-                            p.thumbnailFutures.erase(j);
-                        }
+                        out = i;
+                        break;
                     }
-                    p.thumbnailFutures.clear();
-                    p.thumbnailTimers.clear();
-                    p.nameGlyphs.clear();
-                    p.nameGlyphsFutures.clear();
-                    p.sizeGlyphs.clear();
-                    p.sizeGlyphsFutures.clear();
-                    p.timeGlyphs.clear();
-                    p.timeGlyphsFutures.clear();
                 }
+                return out;
+            }
+
+            std::shared_ptr<Item> ItemView::Private::getItem(size_t index)
+            {
+                std::shared_ptr<Item> out;
+                const auto i = itemState.find(index);
+                if (i != itemState.end())
+                {
+                    out = i->second;
+                }
+                else
+                {
+                    if (itemPool.size())
+                    {
+                        out = itemPool.back();
+                        itemPool.pop_back();
+                    }
+                    else
+                    {
+                        out = std::shared_ptr<Item>(new Item);
+                    }
+                    itemState[index] = out;
+                }
+                return out;
+            }
+
+            void ItemView::Private::cancelItem(Item& item)
+            {
+                if (item.ioInfoFuture.future.valid())
+                {
+                    if (thumbnailSystem)
+                    {
+                        thumbnailSystem->cancelInfo(item.ioInfoFuture.uid);
+                    }
+                    item.ioInfoFuture = AV::ThumbnailSystem::InfoFuture();
+                }
+                if (item.thumbnailFuture.future.valid())
+                {
+                    if (thumbnailSystem)
+                    {
+                        thumbnailSystem->cancelImage(item.thumbnailFuture.uid);
+                    }
+                    item.thumbnailFuture = AV::ThumbnailSystem::ImageFuture();
+                }
+                if (item.nameLinesFuture.valid() ||
+                    item.nameGlyphsFuture.valid() ||
+                    item.sizeGlyphsFuture.valid() ||
+                    item.timeGlyphsFuture.valid())
+                {
+                    if (fontSystem)
+                    {
+                        fontSystem->cancel(item.fontUID);
+                    }
+                    item.nameLinesFuture = std::future<std::vector<AV::Font::TextLine> >();
+                    item.nameGlyphsFuture = std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > >();
+                    item.sizeGlyphsFuture = std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > >();
+                    item.timeGlyphsFuture = std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > >();
+                }
+            }
+
+            void ItemView::Private::releaseItems()
+            {
+                for (const auto& i : itemState)
+                {
+                    cancelItem(*i.second);
+                    i.second->reset();
+                    itemPool.push_back(i.second);
+                }
+                itemState.clear();
+            }
+
+            void ItemView::Private::releaseItems(size_t index, size_t count)
+            {
+                auto i = itemState.lower_bound(index);
+                while (i != itemState.end() && i->first < index + count)
+                {
+                    cancelItem(*i->second);
+                    i->second->reset();
+                    itemPool.push_back(i->second);
+                    i = itemState.erase(i);
+                }
+            }
+
+            void ItemView::Private::insertItems(size_t index, size_t count)
+            {
+                std::map<size_t, std::shared_ptr<Item> > tmp;
+                for (const auto& i : itemState)
+                {
+                    tmp[i.first >= index ? (i.first + count) : i.first] = i.second;
+                }
+                itemState = std::move(tmp);
+            }
+
+            void ItemView::Private::removeItems(size_t index, size_t count)
+            {
+                releaseItems(index, count);
+                std::map<size_t, std::shared_ptr<Item> > tmp;
+                for (const auto& i : itemState)
+                {
+                    tmp[i.first >= index ? (i.first - count) : i.first] = i.second;
+                }
+                itemState = std::move(tmp);
             }
 
         } // namespace FileBrowser
@@ -35,6 +35,8 @@ namespace djv
 {
     namespace Core
     {
+        struct ListChange;
+
         namespace FileSystem
         {
             class FileInfo;
@@ -63,6 +65,10 @@ namespace djv
         {
             //! This class provides a file browser item view.
             //!
+            //! Per-item state (text layout, glyphs, information, and thumbnails)
+            //! is only created for the visible items and a window around them,
+            //! and is recycled as the view is scrolled.
+            //!
             //! \todo Elide names which are too long.
             //! \todo Show an animated spinner for thumbnails that are loading.
             //! \todo Show an error icon for thumbnails that failed to load.
@@ -83,6 +89,13 @@ namespace djv
                 void setThumbnailSize(const AV::Image::Size&);
                 void setSplit(const std::vector<float> &);
                 void setItems(const std::vector<Core::FileSystem::FileInfo> &);
+
+                //! Update the items from a list of changes. Only the state of the
+                //! items that have changed is released.
+                void updateItems(
+                    const std::vector<Core::FileSystem::FileInfo> &,
+                    const std::vector<Core::ListChange> &);
+
                 void setCallback(const std::function<void(const Core::FileSystem::FileInfo &)> &);
 
                 float getHeightForWidth(float) const override;
@@ -109,6 +122,7 @@ namespace djv
                 void _iconsUpdate();
                 void _thumbnailsSizeUpdate();
                 void _itemsUpdate();
+                void _itemWindowUpdate();
 
                 DJV_PRIVATE();
             };
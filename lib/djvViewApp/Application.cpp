@@ -32,6 +32,7 @@
 #include <djvViewApp/AnnotateSystem.h>
 #include <djvViewApp/AudioSystem.h>
 #include <djvViewApp/ColorPickerSystem.h>
+#include <djvViewApp/CompareSystem.h>
 #include <djvViewApp/FileSettings.h>
 #include <djvViewApp/FileSystem.h>
 #include <djvViewApp/HelpSystem.h>
@@ -104,6 +105,7 @@ namespace djv
             p.systems.push_back(ViewSystem::create(shared_from_this()));
             p.systems.push_back(ImageSystem::create(shared_from_this()));
             p.systems.push_back(PlaybackSystem::create(shared_from_this()));
+            p.systems.push_back(CompareSystem::create(shared_from_this()));
             p.systems.push_back(AudioSystem::create(shared_from_this()));
             p.systems.push_back(ColorPickerSystem::create(shared_from_this()));
             p.systems.push_back(MagnifySystem::create(shared_from_this()));
@@ -0,0 +1,255 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewApp/CompareSystem.h>
+
+#include <djvViewApp/FileSystem.h>
+#include <djvViewApp/ImageView.h>
+#include <djvViewApp/Media.h>
+#include <djvViewApp/MediaSync.h>
+
+#include <djvUI/Action.h>
+#include <djvUI/ActionGroup.h>
+#include <djvUI/Menu.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Math.h>
+#include <djvCore/TextSystem.h>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        struct CompareSystem::Private
+        {
+            std::shared_ptr<ValueSubject<CompareOptions> > compareOptions;
+            std::shared_ptr<ListSubject<std::shared_ptr<Media> > > media;
+            std::vector<std::shared_ptr<Media> > openMedia;
+            std::shared_ptr<Media> currentMedia;
+            std::shared_ptr<MediaSync> sync;
+
+            std::map<std::string, std::shared_ptr<UI::Action> > actions;
+            std::shared_ptr<UI::ActionGroup> modeActionGroup;
+            std::shared_ptr<UI::Menu> menu;
+
+            std::shared_ptr<ListObserver<std::shared_ptr<Media> > > openMediaObserver;
+            std::shared_ptr<ValueObserver<std::shared_ptr<Media> > > currentMediaObserver;
+        };
+
+        void CompareSystem::_init(const std::shared_ptr<Core::Context>& context)
+        {
+            IViewSystem::_init("djv::ViewApp::CompareSystem", context);
+
+            DJV_PRIVATE_PTR();
+
+            p.compareOptions = ValueSubject<CompareOptions>::create();
+            p.media = ListSubject<std::shared_ptr<Media> >::create();
+            p.sync = MediaSync::create(context);
+
+            p.actions["CompareNone"] = UI::Action::create();
+            p.actions["CompareSideBySide"] = UI::Action::create();
+            p.actions["CompareWipe"] = UI::Action::create();
+            p.actions["CompareDifference"] = UI::Action::create();
+            p.modeActionGroup = UI::ActionGroup::create(UI::ButtonType::Radio);
+            p.modeActionGroup->addAction(p.actions["CompareNone"]);
+            p.modeActionGroup->addAction(p.actions["CompareSideBySide"]);
+            p.modeActionGroup->addAction(p.actions["CompareWipe"]);
+            p.modeActionGroup->addAction(p.actions["CompareDifference"]);
+
+            p.menu = UI::Menu::create(context);
+            p.menu->addAction(p.actions["CompareNone"]);
+            p.menu->addAction(p.actions["CompareSideBySide"]);
+            p.menu->addAction(p.actions["CompareWipe"]);
+            p.menu->addAction(p.actions["CompareDifference"]);
+
+            _actionsUpdate();
+
+            auto weak = std::weak_ptr<CompareSystem>(std::dynamic_pointer_cast<CompareSystem>(shared_from_this()));
+            p.modeActionGroup->setRadioCallback(
+                [weak](int value)
+                {
+                    if (auto system = weak.lock())
+                    {
+                        system->setCompareMode(static_cast<CompareMode>(value));
+                    }
+                });
+
+            if (auto fileSystem = context->getSystemT<FileSystem>())
+            {
+                p.openMediaObserver = ListObserver<std::shared_ptr<Media> >::create(
+                    fileSystem->observeMedia(),
+                    [weak](const std::vector<std::shared_ptr<Media> >& value)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            system->_p->openMedia = value;
+                            system->_mediaUpdate();
+                            system->_actionsUpdate();
+                        }
+                    });
+
+                p.currentMediaObserver = ValueObserver<std::shared_ptr<Media> >::create(
+                    fileSystem->observeCurrentMedia(),
+                    [weak](const std::shared_ptr<Media>& value)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            system->_p->currentMedia = value;
+                            system->_mediaUpdate();
+                        }
+                    });
+            }
+        }
+
+        CompareSystem::CompareSystem() :
+            _p(new Private)
+        {}
+
+        CompareSystem::~CompareSystem()
+        {}
+
+        std::shared_ptr<CompareSystem> CompareSystem::create(const std::shared_ptr<Core::Context>& context)
+        {
+            auto out = std::shared_ptr<CompareSystem>(new CompareSystem);
+            out->_init(context);
+            return out;
+        }
+
+        std::shared_ptr<IValueSubject<CompareOptions> > CompareSystem::observeCompareOptions() const
+        {
+            return _p->compareOptions;
+        }
+
+        void CompareSystem::setCompareOptions(const CompareOptions& value)
+        {
+            DJV_PRIVATE_PTR();
+            const CompareMode mode = p.compareOptions->get().mode;
+            if (p.compareOptions->setIfChanged(value))
+            {
+                if (value.mode != mode)
+                {
+                    _mediaUpdate();
+                    _actionsUpdate();
+                }
+            }
+        }
+
+        void CompareSystem::setCompareMode(CompareMode value)
+        {
+            auto options = _p->compareOptions->get();
+            options.mode = value;
+            setCompareOptions(options);
+        }
+
+        void CompareSystem::setWipe(float value)
+        {
+            auto options = _p->compareOptions->get();
+            options.wipe = Math::clamp(value, 0.F, 1.F);
+            setCompareOptions(options);
+        }
+
+        std::shared_ptr<IListSubject<std::shared_ptr<Media> > > CompareSystem::observeMedia() const
+        {
+            return _p->media;
+        }
+
+        std::map<std::string, std::shared_ptr<UI::Action> > CompareSystem::getActions() const
+        {
+            return _p->actions;
+        }
+
+        MenuData CompareSystem::getMenu() const
+        {
+            return
+            {
+                _p->menu,
+                "EA"
+            };
+        }
+
+        void CompareSystem::_mediaUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            std::vector<std::shared_ptr<Media> > media;
+            if (p.compareOptions->get().mode != CompareMode::None &&
+                p.currentMedia &&
+                p.openMedia.size() > 1)
+            {
+                media.push_back(p.currentMedia);
+                for (const auto& i : p.openMedia)
+                {
+                    if (i != p.currentMedia)
+                    {
+                        media.push_back(i);
+                    }
+                }
+            }
+            p.sync->setMedia(media);
+            p.media->setIfChanged(media);
+            if (auto context = getContext().lock())
+            {
+                if (auto fileSystem = context->getSystemT<FileSystem>())
+                {
+                    fileSystem->setCacheGroup(media);
+                }
+            }
+        }
+
+        void CompareSystem::_actionsUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            const bool enabled = p.openMedia.size() > 1;
+            p.actions["CompareSideBySide"]->setEnabled(enabled);
+            p.actions["CompareWipe"]->setEnabled(enabled);
+            p.actions["CompareDifference"]->setEnabled(enabled);
+            p.modeActionGroup->setChecked(static_cast<int>(p.compareOptions->get().mode));
+        }
+
+        void CompareSystem::_textUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.actions.size())
+            {
+                p.actions["CompareNone"]->setText(_getText(DJV_TEXT("Compare Off")));
+                p.actions["CompareNone"]->setTooltip(_getText(DJV_TEXT("Compare off tooltip")));
+                p.actions["CompareSideBySide"]->setText(_getText(DJV_TEXT("Side By Side")));
+                p.actions["CompareSideBySide"]->setTooltip(_getText(DJV_TEXT("Compare side by side tooltip")));
+                p.actions["CompareWipe"]->setText(_getText(DJV_TEXT("Wipe")));
+                p.actions["CompareWipe"]->setTooltip(_getText(DJV_TEXT("Compare wipe tooltip")));
+                p.actions["CompareDifference"]->setText(_getText(DJV_TEXT("Difference")));
+                p.actions["CompareDifference"]->setTooltip(_getText(DJV_TEXT("Compare difference tooltip")));
+
+                p.menu->setText(_getText(DJV_TEXT("Compare")));
+            }
+        }
+
+    } // namespace ViewApp
+} // namespace djv
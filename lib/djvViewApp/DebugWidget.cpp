@@ -36,9 +36,11 @@
 #include <djvUIComponents/ThermometerWidget.h>
 
 #include <djvUI/Bellows.h>
+#include <djvUI/CheckBox.h>
 #include <djvUI/EventSystem.h>
 #include <djvUI/IconSystem.h>
 #include <djvUI/Label.h>
+#include <djvUI/PushButton.h>
 #include <djvUI/RowLayout.h>
 #include <djvUI/ScrollWidget.h>
 
@@ -48,8 +50,13 @@
 #include <djvAV/ThumbnailSystem.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileInfo.h>
+#include <djvCore/LogSystem.h>
+#include <djvCore/Path.h>
 #include <djvCore/Timer.h>
 
+#include <iomanip>
+
 using namespace djv::Core;
 
 namespace djv
@@ -463,6 +470,12 @@ namespace djv
                 _lineGraphs["VBOSize"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["VBOSize"]->setPrecision(0);
 
+                _labels["DrawCount"] = UI::Label::create(context);
+                _labels["DrawCountValue"] = UI::Label::create(context);
+                _labels["DrawCountValue"]->setFont(AV::Font::familyMono);
+                _lineGraphs["DrawCount"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["DrawCount"]->setPrecision(0);
+
                 for (auto& i : _labels)
                 {
                     i.second->setTextHAlign(UI::TextHAlign::Left);
@@ -485,6 +498,11 @@ namespace djv
                 hLayout->addChild(_labels["VBOSizeValue"]);
                 _layout->addChild(hLayout);
                 _layout->addChild(_lineGraphs["VBOSize"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["DrawCount"]);
+                hLayout->addChild(_labels["DrawCountValue"]);
+                _layout->addChild(hLayout);
+                _layout->addChild(_lineGraphs["DrawCount"]);
                 addChild(_layout);
 
                 _timer = Time::Timer::create(context);
@@ -517,10 +535,12 @@ namespace djv
                 const float textureAtlasPercentage = render->getTextureAtlasPercentage();
                 const size_t dynamicTextureCount = render->getDynamicTextureCount();
                 const size_t vboSize = render->getVBOSize();
+                const size_t drawCount = render->getDrawCount();
 
                 _thermometerWidgets["TextureAtlas"]->setPercentage(textureAtlasPercentage);
                 _lineGraphs["DynamicTextureCount"]->addSample(dynamicTextureCount);
                 _lineGraphs["VBOSize"]->addSample(vboSize);
+                _lineGraphs["DrawCount"]->addSample(drawCount);
 
                 {
                     std::stringstream ss;
@@ -553,6 +573,16 @@ namespace djv
                     ss << vboSize;
                     _labels["VBOSizeValue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("Draw calls")) << ":";
+                    _labels["DrawCount"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << drawCount;
+                    _labels["DrawCountValue"]->setText(ss.str());
+                }
             }
 
             class MediaDebugWidget : public UI::Widget
@@ -574,15 +604,22 @@ namespace djv
 
             private:
                 void _widgetUpdate();
+                void _writeTrace();
 
+                std::weak_ptr<Media> _media;
                 Frame::Sequence _sequence;
                 Frame::Index _currentFrame = 0;
                 size_t _videoQueueMax = 0;
                 size_t _videoQueueCount = 0;
                 size_t _audioQueueMax = 0;
                 size_t _audioQueueCount = 0;
+                PlaybackStats _playbackStats;
+                AV::IO::PrefetchDecision _prefetchDecision;
+                std::string _traceFileName;
                 std::map<std::string, std::shared_ptr<UI::Label> > _labels;
                 std::map<std::string, std::shared_ptr<UI::LineGraphWidget> > _lineGraphs;
+                std::shared_ptr<UI::CheckBox> _traceCheckBox;
+                std::shared_ptr<UI::PushButton> _traceButton;
                 std::shared_ptr<UI::VerticalLayout> _layout;
                 std::shared_ptr<ValueObserver<std::shared_ptr<Media> > > _currentMediaObserver;
                 std::shared_ptr<ValueObserver<Frame::Sequence> > _sequenceObserver;
@@ -591,6 +628,9 @@ namespace djv
                 std::shared_ptr<ValueObserver<size_t> > _videoQueueCountObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueMaxObserver;
                 std::shared_ptr<ValueObserver<size_t> > _audioQueueCountObserver;
+                std::shared_ptr<ValueObserver<PlaybackStats> > _playbackStatsObserver;
+                std::shared_ptr<ValueObserver<AV::IO::PrefetchDecision> > _prefetchDecisionObserver;
+                std::shared_ptr<ValueObserver<bool> > _traceEnabledObserver;
             };
 
             void MediaDebugWidget::_init(const std::shared_ptr<Context>& context)
@@ -611,11 +651,35 @@ namespace djv
                 _lineGraphs["AudioQueue"] = UI::LineGraphWidget::create(context);
                 _lineGraphs["AudioQueue"]->setPrecision(0);
 
+                _labels["Prefetch"] = UI::Label::create(context);
+                _labels["PrefetchValue"] = UI::Label::create(context);
+                _labels["PrefetchValue"]->setFont(AV::Font::familyMono);
+
+                _labels["Frames"] = UI::Label::create(context);
+                _labels["FramesValue"] = UI::Label::create(context);
+                _labels["FramesValue"]->setFont(AV::Font::familyMono);
+                for (auto stage : getPlaybackStageEnums())
+                {
+                    std::stringstream ss;
+                    ss << stage;
+                    _labels[ss.str()] = UI::Label::create(context);
+                    _labels[ss.str() + "Value"] = UI::Label::create(context);
+                    _labels[ss.str() + "Value"]->setFont(AV::Font::familyMono);
+                }
+                _labels["LatencyGraph"] = UI::Label::create(context);
+                _lineGraphs["Latency"] = UI::LineGraphWidget::create(context);
+                _lineGraphs["Latency"]->setPrecision(1);
+
                 for (auto& i : _labels)
                 {
                     i.second->setTextHAlign(UI::TextHAlign::Left);
                 }
 
+                _traceCheckBox = UI::CheckBox::create(context);
+                _traceButton = UI::PushButton::create(context);
+                _labels["TraceFileName"] = UI::Label::create(context);
+                _labels["TraceFileName"]->setTextHAlign(UI::TextHAlign::Left);
+
                 _layout = UI::VerticalLayout::create(context);
                 _layout->setMargin(UI::Layout::Margin(UI::MetricsRole::Margin));
                 auto hLayout = UI::HorizontalLayout::create(context);
@@ -626,9 +690,53 @@ namespace djv
                 _layout->addChild(_lineGraphs["VideoQueue"]);
                 _layout->addChild(_labels["AudioQueue"]);
                 _layout->addChild(_lineGraphs["AudioQueue"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["Prefetch"]);
+                hLayout->addChild(_labels["PrefetchValue"]);
+                _layout->addChild(hLayout);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_labels["Frames"]);
+                hLayout->addChild(_labels["FramesValue"]);
+                _layout->addChild(hLayout);
+                for (auto stage : getPlaybackStageEnums())
+                {
+                    std::stringstream ss;
+                    ss << stage;
+                    hLayout = UI::HorizontalLayout::create(context);
+                    hLayout->addChild(_labels[ss.str()]);
+                    hLayout->addChild(_labels[ss.str() + "Value"]);
+                    _layout->addChild(hLayout);
+                }
+                _layout->addChild(_labels["LatencyGraph"]);
+                _layout->addChild(_lineGraphs["Latency"]);
+                hLayout = UI::HorizontalLayout::create(context);
+                hLayout->addChild(_traceCheckBox);
+                hLayout->addChild(_traceButton);
+                _layout->addChild(hLayout);
+                _layout->addChild(_labels["TraceFileName"]);
                 addChild(_layout);
 
                 auto weak = std::weak_ptr<MediaDebugWidget>(std::dynamic_pointer_cast<MediaDebugWidget>(shared_from_this()));
+                _traceCheckBox->setCheckedCallback(
+                    [weak](bool value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            if (auto media = widget->_media.lock())
+                            {
+                                media->setTraceEnabled(value);
+                            }
+                        }
+                    });
+                _traceButton->setClickedCallback(
+                    [weak]
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_writeTrace();
+                        }
+                    });
+
                 if (auto fileSystem = context->getSystemT<FileSystem>())
                 {
                     _currentMediaObserver = ValueObserver<std::shared_ptr<Media>>::create(
@@ -642,6 +750,7 @@ namespace djv
                                 i.second->resetSamples();
                             }
 
+                            widget->_media = value;
                             if (value)
                             {
                                 widget->_sequenceObserver = ValueObserver<Frame::Sequence>::create(
@@ -706,6 +815,40 @@ namespace djv
                                         widget->_widgetUpdate();
                                     }
                                 });
+                                widget->_playbackStatsObserver = ValueObserver<PlaybackStats>::create(
+                                    value->observePlaybackStats(),
+                                    [weak](const PlaybackStats& value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_playbackStats = value;
+                                        const auto& latency = value.getHistogram(PlaybackStage::Latency);
+                                        if (latency.getCount())
+                                        {
+                                            widget->_lineGraphs["Latency"]->addSample(latency.getPercentile(90.F) * 1000.F);
+                                        }
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_prefetchDecisionObserver = ValueObserver<AV::IO::PrefetchDecision>::create(
+                                    value->observePrefetchDecision(),
+                                    [weak](const AV::IO::PrefetchDecision& value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_prefetchDecision = value;
+                                        widget->_widgetUpdate();
+                                    }
+                                });
+                                widget->_traceEnabledObserver = ValueObserver<bool>::create(
+                                    value->observeTraceEnabled(),
+                                    [weak](bool value)
+                                {
+                                    if (auto widget = weak.lock())
+                                    {
+                                        widget->_traceCheckBox->setChecked(value);
+                                    }
+                                });
                             }
                             else
                             {
@@ -715,12 +858,18 @@ namespace djv
                                 widget->_videoQueueCount = 0;
                                 widget->_audioQueueMax = 0;
                                 widget->_audioQueueCount = 0;
+                                widget->_playbackStats = PlaybackStats();
+                                widget->_prefetchDecision = AV::IO::PrefetchDecision();
+                                widget->_traceCheckBox->setChecked(false);
                                 widget->_sequenceObserver.reset();
                                 widget->_currentFrameObserver.reset();
                                 widget->_videoQueueMaxObserver.reset();
                                 widget->_videoQueueCountObserver.reset();
                                 widget->_audioQueueMaxObserver.reset();
                                 widget->_audioQueueCountObserver.reset();
+                                widget->_playbackStatsObserver.reset();
+                                widget->_prefetchDecisionObserver.reset();
+                                widget->_traceEnabledObserver.reset();
                                 widget->_widgetUpdate();
                             }
                         }
@@ -761,6 +910,29 @@ namespace djv
                     ss << _getText(DJV_TEXT("Audio queue")) << ":";
                     _labels["AudioQueue"]->setText(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("Prefetch threads / queue / read behind")) << ":";
+                    _labels["Prefetch"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("Frames shown / dropped / cached")) << ":";
+                    _labels["Frames"]->setText(ss.str());
+                }
+                for (auto stage : getPlaybackStageEnums())
+                {
+                    std::stringstream ss;
+                    ss << stage;
+                    _labels[ss.str()]->setText(_getText(ss.str()) + " (ms):");
+                }
+                {
+                    std::stringstream ss;
+                    ss << _getText(DJV_TEXT("Latency p90 (ms)")) << ":";
+                    _labels["LatencyGraph"]->setText(ss.str());
+                }
+                _traceCheckBox->setText(_getText(DJV_TEXT("Record trace")));
+                _traceButton->setText(_getText(DJV_TEXT("Write trace")));
                 _widgetUpdate();
             }
 
@@ -776,6 +948,66 @@ namespace djv
                     ss << _currentFrame << " / " << _sequence.getSize();
                     _labels["CurrentFrameValue"]->setText(ss.str());
                 }
+                {
+                    // Show the decision followed by the average read time and the
+                    // consumption rate it is based on.
+                    std::stringstream ss;
+                    ss << _prefetchDecision.threadCount << " / ";
+                    ss << _prefetchDecision.queueSize << " / ";
+                    ss << _prefetchDecision.readBehind << " (";
+                    ss << std::fixed << std::setprecision(1);
+                    ss << _prefetchDecision.readTime * 1000.F << "ms, ";
+                    ss << _prefetchDecision.consumeRate << "fps)";
+                    _labels["PrefetchValue"]->setText(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << _playbackStats.shownFrames << " / " << _playbackStats.droppedFrames << " / " << _playbackStats.cachedFrames;
+                    _labels["FramesValue"]->setText(ss.str());
+                }
+                for (auto stage : getPlaybackStageEnums())
+                {
+                    // Show the 50th, 90th, and 99th percentiles and the maximum.
+                    const auto& histogram = _playbackStats.getHistogram(stage);
+                    std::stringstream ss;
+                    ss << stage;
+                    const std::string key = ss.str() + "Value";
+                    ss.str(std::string());
+                    ss << std::fixed << std::setprecision(1);
+                    ss << histogram.getPercentile(50.F) * 1000.F << " / ";
+                    ss << histogram.getPercentile(90.F) * 1000.F << " / ";
+                    ss << histogram.getPercentile(99.F) * 1000.F << " / ";
+                    ss << histogram.getMax() * 1000.F;
+                    _labels[key]->setText(ss.str());
+                }
+                _labels["TraceFileName"]->setText(_traceFileName);
+            }
+
+            void MediaDebugWidget::_writeTrace()
+            {
+                if (auto context = getContext().lock())
+                {
+                    if (auto media = _media.lock())
+                    {
+                        const Core::FileSystem::Path path(Core::FileSystem::Path::getTemp(), "djv-trace.json");
+                        try
+                        {
+                            media->writeTrace(path.get());
+                            _traceFileName = path.get();
+                            std::stringstream ss;
+                            ss << "Trace: " << path;
+                            auto logSystem = context->getSystemT<LogSystem>();
+                            logSystem->log("djv::ViewApp::MediaDebugWidget", ss.str());
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _traceFileName = std::string();
+                            auto logSystem = context->getSystemT<LogSystem>();
+                            logSystem->log("djv::ViewApp::MediaDebugWidget", e.what(), LogLevel::Error);
+                        }
+                        _widgetUpdate();
+                    }
+                }
             }
 
         } // namespace
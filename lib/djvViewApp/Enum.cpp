@@ -77,6 +77,24 @@ namespace djv
         DJV_TEXT("Loop"),
         DJV_TEXT("PingPong"));
 
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        ViewApp,
+        PlaybackStage,
+        DJV_TEXT("Wait"),
+        DJV_TEXT("Decode"),
+        DJV_TEXT("Queue"),
+        DJV_TEXT("Display"),
+        DJV_TEXT("Latency"),
+        DJV_TEXT("Tick"));
+
+    DJV_ENUM_SERIALIZE_HELPERS_IMPLEMENTATION(
+        ViewApp,
+        CompareMode,
+        DJV_TEXT("None"),
+        DJV_TEXT("SideBySide"),
+        DJV_TEXT("Wipe"),
+        DJV_TEXT("Difference"));
+
     picojson::value toJSON(ViewApp::ImageViewLock value)
     {
         std::stringstream ss;
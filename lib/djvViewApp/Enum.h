@@ -83,12 +83,42 @@ namespace djv
         };
         DJV_ENUM_HELPERS(PlaybackMode);
 
+        //! This enumeration provides the timed stages of the playback pipeline.
+        enum class PlaybackStage
+        {
+            Wait,       //!< From the read request to the start of decoding.
+            Decode,     //!< Decoding the frame.
+            Queue,      //!< From the end of decoding to being taken from the queue.
+            Display,    //!< From being taken from the queue to the first paint.
+            Latency,    //!< From the read request to the first paint.
+            Tick,       //!< The interval between queue updates.
+
+            Count,
+            First = Wait
+        };
+        DJV_ENUM_HELPERS(PlaybackStage);
+
+        //! This enumeration provides how media are compared.
+        enum class CompareMode
+        {
+            None,
+            SideBySide, //!< Show the media next to each other.
+            Wipe,       //!< Show the second media on one side of a wipe.
+            Difference, //!< Show the absolute difference of the first two media.
+
+            Count,
+            First = None
+        };
+        DJV_ENUM_HELPERS(CompareMode);
+
     } // namespace ViewApp
 
     DJV_ENUM_SERIALIZE_HELPERS(ViewApp::ImageViewLock);
     DJV_ENUM_SERIALIZE_HELPERS(ViewApp::ImageRotate);
     DJV_ENUM_SERIALIZE_HELPERS(ViewApp::Playback);
     DJV_ENUM_SERIALIZE_HELPERS(ViewApp::PlaybackMode);
+    DJV_ENUM_SERIALIZE_HELPERS(ViewApp::PlaybackStage);
+    DJV_ENUM_SERIALIZE_HELPERS(ViewApp::CompareMode);
 
     picojson::value toJSON(ViewApp::ImageViewLock);
     picojson::value toJSON(ViewApp::ImageRotate);
@@ -33,6 +33,7 @@
 #include <djvViewApp/FileSettings.h>
 #include <djvViewApp/LayersWidget.h>
 #include <djvViewApp/Media.h>
+#include <djvViewApp/MediaSync.h>
 #include <djvViewApp/PlaybackSettings.h>
 #include <djvViewApp/RecentFilesDialog.h>
 
@@ -70,6 +71,8 @@ namespace djv
             std::shared_ptr<ListSubject<std::shared_ptr<Media> > > media;
             std::shared_ptr<ValueSubject<std::shared_ptr<Media> > > currentMedia;
             std::shared_ptr<ValueSubject<float> > cachePercentage;
+            std::vector<std::weak_ptr<Media> > cacheGroup;
+            std::vector<std::shared_ptr<ValueObserver<AV::IO::Info> > > cacheGroupInfoObservers;
             std::map<std::string, std::shared_ptr<UI::Action> > actions;
             std::shared_ptr<UI::Menu> menu;
             std::shared_ptr<UI::FileBrowser::Dialog> fileBrowserDialog;
@@ -80,6 +83,7 @@ namespace djv
             std::shared_ptr<ListObserver<Core::FileSystem::FileInfo> > recentFilesObserver;
             std::shared_ptr<ListObserver<Core::FileSystem::FileInfo> > recentFilesObserver2;
             std::shared_ptr<ValueObserver<size_t> > threadCountObserver;
+            std::shared_ptr<ValueObserver<bool> > prefetchAdaptiveObserver;
             std::shared_ptr<ValueObserver<bool> > cacheEnabledObserver;
             std::shared_ptr<ValueObserver<int> > cacheMaxGBObserver;
             std::map<std::string, std::shared_ptr<ValueObserver<bool> > > actionObservers;
@@ -416,6 +420,23 @@ namespace djv
                     }
                 });
 
+            if (auto playbackSettings = settingsSystem->getSettingsT<PlaybackSettings>())
+            {
+                p.prefetchAdaptiveObserver = ValueObserver<bool>::create(
+                    playbackSettings->observePrefetchAdaptive(),
+                    [weak](bool value)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            const auto& media = system->_p->media->get();
+                            for (const auto& i : media)
+                            {
+                                i->setPrefetchAdaptive(value);
+                            }
+                        }
+                    });
+            }
+
             p.cacheTimer = Time::Timer::create(context);
             p.cacheTimer->setRepeating(true);
             p.cacheTimer->start(
@@ -606,6 +627,30 @@ namespace djv
             }
         }
 
+        void FileSystem::setCacheGroup(const std::vector<std::shared_ptr<Media> >& value)
+        {
+            DJV_PRIVATE_PTR();
+            p.cacheGroup.clear();
+            p.cacheGroupInfoObservers.clear();
+            auto weak = std::weak_ptr<FileSystem>(std::dynamic_pointer_cast<FileSystem>(shared_from_this()));
+            for (const auto& i : value)
+            {
+                p.cacheGroup.push_back(i);
+
+                // The frame sizes are not known until the media is opened.
+                p.cacheGroupInfoObservers.push_back(ValueObserver<AV::IO::Info>::create(
+                    i->observeInfo(),
+                    [weak](const AV::IO::Info&)
+                    {
+                        if (auto system = weak.lock())
+                        {
+                            system->_cacheUpdate();
+                        }
+                    }));
+            }
+            _cacheUpdate();
+        }
+
         std::map<std::string, std::shared_ptr<UI::Action> > FileSystem::getActions() const
         {
             return _p->actions;
@@ -653,6 +698,34 @@ namespace djv
                 i->setCacheEnabled(cacheEnabled);
                 i->setCacheMaxByteCount(mediaCacheSizeByteCount);
             }
+
+            // Redistribute the shares of the media in the cache group.
+            std::vector<std::shared_ptr<Media> > group;
+            for (const auto& i : p.cacheGroup)
+            {
+                if (auto media = i.lock())
+                {
+                    if (media->hasCache())
+                    {
+                        group.push_back(media);
+                    }
+                }
+            }
+            if (group.size() > 1)
+            {
+                std::vector<size_t> frameByteCounts;
+                for (const auto& i : group)
+                {
+                    frameByteCounts.push_back(i->getFrameByteCount());
+                }
+                const auto byteCounts = MediaSync::getCacheByteCounts(
+                    mediaCacheSizeByteCount * group.size(),
+                    frameByteCounts);
+                for (size_t i = 0; i < group.size(); ++i)
+                {
+                    group[i]->setCacheMaxByteCount(byteCounts[i]);
+                }
+            }
         }
 
         void FileSystem::_mediaInit(const std::shared_ptr<Media>& value)
@@ -666,6 +739,7 @@ namespace djv
                 {
                     value->setPlayEveryFrame(playbackSettings->observePlayEveryFrame()->get());
                     value->setPlaybackMode(playbackSettings->observePlaybackMode()->get());
+                    value->setPrefetchAdaptive(playbackSettings->observePrefetchAdaptive()->get());
                     if (playbackSettings->observeStartPlayback()->get())
                     {
                         value->setPlayback(Playback::Forward);
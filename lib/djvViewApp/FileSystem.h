@@ -81,6 +81,11 @@ namespace djv
             void closeAll();
             void setCurrentMedia(const std::shared_ptr<Media> &);
 
+            //! Set the media that are played back together. Their combined
+            //! share of the memory cache is divided so that each of them can
+            //! cache the same number of frames.
+            void setCacheGroup(const std::vector<std::shared_ptr<Media> >&);
+
             std::map<std::string, std::shared_ptr<UI::Action> > getActions() const override;
             MenuData getMenu() const override;
 
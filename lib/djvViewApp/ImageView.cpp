@@ -39,6 +39,7 @@
 
 #include <djvAV/AVSystem.h>
 #include <djvAV/Image.h>
+#include <djvAV/ImageDiff.h>
 #include <djvAV/OCIOSystem.h>
 #include <djvAV/Render2D.h>
 
@@ -72,10 +73,20 @@ namespace djv
                 labels == other.labels;
         }
 
+        CompareOptions::CompareOptions()
+        {}
+
+        bool CompareOptions::operator == (const CompareOptions& other) const
+        {
+            return mode == other.mode &&
+                wipe == other.wipe;
+        }
+
         struct ImageView::Private
         {
             std::shared_ptr<AV::Font::System> fontSystem;
             std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > image;
+            std::shared_ptr<ValueSubject<std::shared_ptr<AV::Image::Image> > > paintedImage;
             std::shared_ptr<ValueSubject<AV::Render::ImageOptions> > imageOptions;
             AV::OCIO::Config ocioConfig;
             std::string outputColorSpace;
@@ -88,6 +99,12 @@ namespace djv
             std::shared_ptr<ValueSubject<GridOptions> > gridOptions;
             std::shared_ptr<ValueSubject<AV::Image::Color> > backgroundColor;
             std::vector<std::shared_ptr<AnnotatePrimitive> > annotations;
+            std::shared_ptr<ValueSubject<CompareOptions> > compareOptions;
+            std::vector<std::shared_ptr<AV::Image::Image> > compareImages;
+            std::pair<std::shared_ptr<AV::Image::Image>, std::shared_ptr<AV::Image::Image> > differenceInput;
+            std::shared_ptr<AV::Image::Image> differenceImage;
+            std::future<std::shared_ptr<AV::Image::Image> > differenceFuture;
+            bool differencePending = false;
             glm::vec2 pressedImagePos = glm::vec2(0.F, 0.F);
             bool viewInit = true;
             AV::Font::Metrics fontMetrics;
@@ -121,6 +138,7 @@ namespace djv
             auto imageSettings = settingsSystem->getSettingsT<ImageSettings>();
             auto viewSettings = settingsSystem->getSettingsT<ViewSettings>();
             p.image = ValueSubject<std::shared_ptr<AV::Image::Image> >::create();
+            p.paintedImage = ValueSubject<std::shared_ptr<AV::Image::Image> >::create();
             AV::Render::ImageOptions imageOptions;
             imageOptions.alphaBlend = avSystem->observeAlphaBlend()->get();
             p.imageOptions = ValueSubject<AV::Render::ImageOptions>::create(imageOptions);
@@ -130,6 +148,7 @@ namespace djv
             p.imageAspectRatio = ValueSubject<UI::ImageAspectRatio>::create(imageSettings->observeAspectRatio()->get());
             p.gridOptions = ValueSubject<GridOptions>::create(viewSettings->observeGridOptions()->get());
             p.backgroundColor = ValueSubject<AV::Image::Color>::create(viewSettings->observeBackgroundColor()->get());
+            p.compareOptions = ValueSubject<CompareOptions>::create();
 
             _textUpdate();
 
@@ -189,11 +208,17 @@ namespace djv
             return _p->image;
         }
 
+        std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > ImageView::observePaintedImage() const
+        {
+            return _p->paintedImage;
+        }
+
         void ImageView::setImage(const std::shared_ptr<AV::Image::Image>& value)
         {
             DJV_PRIVATE_PTR();
             if (p.image->setIfChanged(value))
             {
+                _differenceUpdate();
                 _textUpdate();
             }
         }
@@ -399,6 +424,51 @@ namespace djv
             _redraw();
         }
 
+        std::shared_ptr<IValueSubject<CompareOptions> > ImageView::observeCompareOptions() const
+        {
+            return _p->compareOptions;
+        }
+
+        void ImageView::setCompareOptions(const CompareOptions& value)
+        {
+            DJV_PRIVATE_PTR();
+            const CompareMode mode = p.compareOptions->get().mode;
+            if (p.compareOptions->setIfChanged(value))
+            {
+                _differenceUpdate();
+                if (value.mode != mode)
+                {
+                    _resize();
+                }
+                else
+                {
+                    _redraw();
+                }
+            }
+        }
+
+        void ImageView::setCompareImages(const std::vector<std::shared_ptr<AV::Image::Image> >& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value == p.compareImages)
+                return;
+            bool sizeChanged = value.size() != p.compareImages.size();
+            for (size_t i = 0; i < value.size() && !sizeChanged; ++i)
+            {
+                sizeChanged = !value[i] || !p.compareImages[i] || value[i]->getSize() != p.compareImages[i]->getSize();
+            }
+            p.compareImages = value;
+            _differenceUpdate();
+            if (sizeChanged && CompareMode::SideBySide == p.compareOptions->get().mode)
+            {
+                _resize();
+            }
+            else
+            {
+                _redraw();
+            }
+        }
+
         void ImageView::_preLayoutEvent(Event::PreLayout & event)
         {
             DJV_PRIVATE_PTR();
@@ -451,24 +521,85 @@ namespace djv
                     zoom * UI::getPixelAspectRatio(p.imageAspectRatio->get(), image->getInfo().pixelAspectRatio),
                     zoom * UI::getAspectRatioScale(p.imageAspectRatio->get(), image->getAspectRatio())));
                 render->pushTransform(m);
-                AV::Render::ImageOptions options(p.imageOptions->get());
-                auto i = p.ocioConfig.fileColorSpaces.find(image->getPluginName());
-                if (i != p.ocioConfig.fileColorSpaces.end())
+                auto getOptions = [&p](const std::shared_ptr<AV::Image::Image>& image)
                 {
-                    options.colorSpace.input = i->second;
-                }
-                else
-                {
-                    i = p.ocioConfig.fileColorSpaces.find(std::string());
+                    AV::Render::ImageOptions options(p.imageOptions->get());
+                    auto i = p.ocioConfig.fileColorSpaces.find(image->getPluginName());
                     if (i != p.ocioConfig.fileColorSpaces.end())
                     {
                         options.colorSpace.input = i->second;
                     }
+                    else
+                    {
+                        i = p.ocioConfig.fileColorSpaces.find(std::string());
+                        if (i != p.ocioConfig.fileColorSpaces.end())
+                        {
+                            options.colorSpace.input = i->second;
+                        }
+                    }
+                    options.colorSpace.output = p.outputColorSpace;
+                    options.cache = AV::Render::ImageCache::Dynamic;
+                    return options;
+                };
+                const auto& compareOptions = p.compareOptions->get();
+                std::shared_ptr<AV::Image::Image> compareImage = p.compareImages.size() ? p.compareImages[0] : nullptr;
+                switch (compareImage ? compareOptions.mode : CompareMode::None)
+                {
+                case CompareMode::SideBySide:
+                {
+                    render->drawImage(image, glm::vec2(0.F, 0.F), getOptions(image));
+                    float x = image->getWidth();
+                    for (const auto& i : p.compareImages)
+                    {
+                        if (i)
+                        {
+                            render->drawImage(i, glm::vec2(x, 0.F), getOptions(i));
+                            x += i->getWidth();
+                        }
+                    }
+                    break;
+                }
+                case CompareMode::Wipe:
+                {
+                    render->drawImage(image, glm::vec2(0.F, 0.F), getOptions(image));
+                    const BBox2f bbox = getImageBBox();
+                    const float wipeX = floorf(g.min.x + pos.x + (bbox.min.x + bbox.w() * compareOptions.wipe) * zoom);
+                    render->pushClipRect(BBox2f(wipeX, g.min.y, g.max.x - wipeX, g.h()));
+                    render->drawImage(compareImage, glm::vec2(0.F, 0.F), getOptions(compareImage));
+                    render->popClipRect();
+                    break;
+                }
+                case CompareMode::Difference:
+                    if (p.differenceImage)
+                    {
+                        // The difference is displayed without color space
+                        // conversion. The last finished difference is kept on
+                        // screen while the next one is computed so that the
+                        // view does not flicker during playback.
+                        AV::Render::ImageOptions options(p.imageOptions->get());
+                        options.cache = AV::Render::ImageCache::Dynamic;
+                        render->drawImage(p.differenceImage, glm::vec2(0.F, 0.F), options);
+                    }
+                    else
+                    {
+                        render->drawImage(image, glm::vec2(0.F, 0.F), getOptions(image));
+                    }
+                    break;
+                default:
+                    render->drawImage(image, glm::vec2(0.F, 0.F), getOptions(image));
+                    break;
                 }
-                options.colorSpace.output = p.outputColorSpace;
-                options.cache = AV::Render::ImageCache::Dynamic;
-                render->drawImage(image, glm::vec2(0.F, 0.F), options);
                 render->popTransform();
+                p.paintedImage->setIfChanged(image);
+
+                if (compareImage && CompareMode::Wipe == compareOptions.mode)
+                {
+                    const BBox2f bbox = getImageBBox();
+                    const float b = style->getMetric(UI::MetricsRole::Border);
+                    const float wipeX = floorf(g.min.x + pos.x + (bbox.min.x + bbox.w() * compareOptions.wipe) * zoom);
+                    render->setFillColor(style->getColor(UI::ColorRole::Foreground));
+                    render->drawRect(BBox2f(wipeX - b, g.min.y, b * 2.F, g.h()));
+                }
             }
             
             const auto& gridOptions = p.gridOptions->get();
@@ -501,6 +632,29 @@ namespace djv
         {
             Widget::_updateEvent(event);
             DJV_PRIVATE_PTR();
+            const auto& render = _getRender();
+            if (render && p.image->get() && render->getPendingTileCount())
+            {
+                _redraw();
+            }
+            if (p.differenceFuture.valid() &&
+                p.differenceFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                try
+                {
+                    p.differenceImage = p.differenceFuture.get();
+                    _redraw();
+                }
+                catch (const std::exception& e)
+                {
+                    _log(e.what(), LogLevel::Error);
+                }
+                if (p.differencePending)
+                {
+                    p.differencePending = false;
+                    _differenceUpdate();
+                }
+            }
             if (p.fontMetricsFuture.valid() &&
                 p.fontMetricsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
             {
@@ -574,7 +728,18 @@ namespace djv
             std::vector<glm::vec3> out;
             if (auto image = p.image->get())
             {
-                const AV::Image::Size& imageSize = image->getSize();
+                AV::Image::Size imageSize = image->getSize();
+                if (CompareMode::SideBySide == p.compareOptions->get().mode)
+                {
+                    for (const auto& i : p.compareImages)
+                    {
+                        if (i)
+                        {
+                            imageSize.w += i->getWidth();
+                            imageSize.h = std::max(imageSize.h, i->getHeight());
+                        }
+                    }
+                }
                 glm::mat3x3 m(1.F);
                 m = glm::rotate(m, Math::deg2rad(getImageRotate(p.imageRotate->get())));
                 m = glm::scale(m, glm::vec2(
@@ -677,6 +842,48 @@ namespace djv
             }
         }
 
+        void ImageView::_differenceUpdate()
+        {
+            DJV_PRIVATE_PTR();
+            const auto image = p.image->get();
+            if (CompareMode::Difference == p.compareOptions->get().mode &&
+                image &&
+                p.compareImages.size() &&
+                p.compareImages[0])
+            {
+                const auto input = std::make_pair(image, p.compareImages[0]);
+                if (input != p.differenceInput)
+                {
+                    if (p.differenceFuture.valid())
+                    {
+                        // Start again when the current difference is finished.
+                        p.differencePending = true;
+                    }
+                    else
+                    {
+                        p.differenceInput = input;
+                        p.differenceFuture = std::async(
+                            std::launch::async,
+                            [input]
+                            {
+                                AV::Image::Info info(input.first->getSize(), AV::Image::getDifferenceType());
+                                info.pixelAspectRatio = input.first->getInfo().pixelAspectRatio;
+                                auto out = AV::Image::Image::create(info);
+                                const size_t threadCount = std::max(std::thread::hardware_concurrency(), 1U);
+                                AV::Image::difference(*input.first, *input.second, *out, threadCount);
+                                return out;
+                            });
+                    }
+                }
+            }
+            else
+            {
+                p.differenceInput = std::make_pair(nullptr, nullptr);
+                p.differenceImage.reset();
+                p.differencePending = false;
+            }
+        }
+
         void ImageView::_drawGrid(float gridSize)
         {
             DJV_PRIVATE_PTR();
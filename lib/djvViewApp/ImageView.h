@@ -74,6 +74,18 @@ namespace djv
             bool operator == (const GridOptions&) const;
         };
 
+        //! This class provides compare options.
+        class CompareOptions
+        {
+        public:
+            CompareOptions();
+
+            CompareMode mode = CompareMode::None;
+            float       wipe = .5F; //!< The wipe position from zero to one.
+
+            bool operator == (const CompareOptions&) const;
+        };
+
         //! This class provides an image view widget.
         class ImageView : public UI::Widget
         {
@@ -91,6 +103,9 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observeImage() const;
             void setImage(const std::shared_ptr<AV::Image::Image>&);
 
+            //! Observe the last image that was painted.
+            std::shared_ptr<Core::IValueSubject<std::shared_ptr<AV::Image::Image> > > observePaintedImage() const;
+
             std::shared_ptr<Core::IValueSubject<AV::Render::ImageOptions> > observeImageOptions() const;
             void setImageOptions(const AV::Render::ImageOptions&);
 
@@ -120,6 +135,17 @@ namespace djv
 
             void setAnnotations(const std::vector<std::shared_ptr<AnnotatePrimitive> >&);
 
+            //! \name Compare
+            ///@{
+
+            std::shared_ptr<Core::IValueSubject<CompareOptions> > observeCompareOptions() const;
+            void setCompareOptions(const CompareOptions&);
+
+            //! Set the images that are compared with the current image.
+            void setCompareImages(const std::vector<std::shared_ptr<AV::Image::Image> >&);
+
+            ///@}
+
         protected:
             void _preLayoutEvent(Core::Event::PreLayout &) override;
             void _layoutEvent(Core::Event::Layout &) override;
@@ -135,6 +161,7 @@ namespace djv
             void _animate(const glm::vec2&, float);
             void _posAndZoom(const glm::vec2&, float);
             void _drawGrid(float gridSize);
+            void _differenceUpdate();
             void _textUpdate();
 
             DJV_PRIVATE();
@@ -32,13 +32,20 @@
 #include <djvViewApp/Annotate.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/AudioSystem.h>
 
 #include <djvCore/Context.h>
+#include <djvCore/FileIO.h>
+#include <djvCore/FileSystem.h>
 #include <djvCore/LogSystem.h>
+#include <djvCore/PicoJSON.h>
 #include <djvCore/Timer.h>
 
 #include <RtAudio.h>
 
+#include <atomic>
+#include <deque>
+
 using namespace djv::Core;
 
 namespace djv
@@ -50,6 +57,28 @@ namespace djv
             //! \todo Should this be configurable?
             const size_t bufferFrameCount = 256;
             const size_t videoQueueSize = 10;
+            const size_t traceEventsMax = 100000;
+
+            //! This struct provides a playback trace event.
+            struct TraceEvent
+            {
+                std::string   name;
+                char          phase    = 'X';
+                int64_t       time     = 0;
+                int64_t       duration = 0;
+                Frame::Index  frame    = Frame::invalid;
+                size_t        count    = 0;
+                int           thread   = 0;
+            };
+
+            //! The trace event threads.
+            const int traceThreadUI     = 1;
+            const int traceThreadFrames = 2;
+
+            bool isValid(const std::chrono::high_resolution_clock::time_point& value)
+            {
+                return value.time_since_epoch().count() != 0;
+            }
             
         } // namespace
 
@@ -77,6 +106,8 @@ namespace djv
             std::shared_ptr<ValueSubject<float> > volume;
             std::shared_ptr<ValueSubject<bool> > mute;
             std::shared_ptr<ValueSubject<size_t> > threadCount;
+            std::shared_ptr<ValueSubject<bool> > prefetchAdaptive;
+            std::shared_ptr<ValueSubject<AV::IO::PrefetchDecision> > prefetchDecision;
             std::shared_ptr<ValueSubject<Frame::Sequence> > cacheSequence;
             std::shared_ptr<ValueSubject<Frame::Sequence> > cachedFrames;
             std::shared_ptr<ListSubject<std::shared_ptr<AnnotatePrimitive> > > annotations;
@@ -85,14 +116,34 @@ namespace djv
             std::shared_ptr<ValueSubject<size_t> > videoQueueCount;
             std::shared_ptr<ValueSubject<size_t> > audioQueueMax;
             std::shared_ptr<ValueSubject<size_t> > audioQueueCount;
+
+            std::shared_ptr<ValueSubject<PlaybackStats> > playbackStats;
+            PlaybackStats stats;
+            bool statsChanged = false;
+            std::shared_ptr<ValueSubject<bool> > traceEnabled;
+            std::deque<TraceEvent> traceEvents;
+            std::chrono::high_resolution_clock::time_point traceStartTime;
+            std::chrono::high_resolution_clock::time_point tickTime;
+            Frame::Index shownFrame = Frame::invalid;
+            std::shared_ptr<AV::Image::Image> shownImage;
+            AV::IO::VideoFrame paintFrame;
+            std::chrono::high_resolution_clock::time_point paintDequeueTime;
+
+            void addTraceEvent(const TraceEvent&);
+            int64_t getTraceTime(const std::chrono::high_resolution_clock::time_point&) const;
+
+            std::atomic<bool> queueChanged;
+            Frame::Index queueFrame = Frame::invalid;
             std::shared_ptr<AV::IO::IRead> read;
 
             AV::IO::Direction ioDirection = AV::IO::Direction::Forward;
+            bool externalClock = false;
             std::unique_ptr<RtAudio> rtAudio;
             std::shared_ptr<AV::Audio::Data> audioData;
             size_t audioDataSamplesOffset = 0;
             size_t audioDataSamplesCount = 0;
             std::chrono::high_resolution_clock::time_point audioDataSamplesTime;
+            float audioVolume = 0.F;
             Frame::Index frameOffset = 0;
             std::chrono::high_resolution_clock::time_point startTime;
             std::chrono::high_resolution_clock::time_point realSpeedTime;
@@ -105,6 +156,20 @@ namespace djv
             std::shared_ptr<Time::Timer> debugTimer;
         };
 
+        void Media::Private::addTraceEvent(const TraceEvent& value)
+        {
+            traceEvents.push_back(value);
+            while (traceEvents.size() > traceEventsMax)
+            {
+                traceEvents.pop_front();
+            }
+        }
+
+        int64_t Media::Private::getTraceTime(const std::chrono::high_resolution_clock::time_point& value) const
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(value - traceStartTime).count();
+        }
+
         void Media::_init(
             const Core::FileSystem::FileInfo& fileInfo,
             const std::shared_ptr<Core::Context>& context)
@@ -130,15 +195,22 @@ namespace djv
             p.audioEnabled = ValueSubject<bool>::create(false);
             p.mute = ValueSubject<bool>::create(false);
             p.threadCount = ValueSubject<size_t>::create(4);
+            p.prefetchAdaptive = ValueSubject<bool>::create(true);
+            p.prefetchDecision = ValueSubject<AV::IO::PrefetchDecision>::create();
             p.cacheSequence = ValueSubject<Frame::Sequence>::create();
             p.cachedFrames = ValueSubject<Frame::Sequence>::create();
             p.annotations = ListSubject<std::shared_ptr<AnnotatePrimitive> >::create();
+            p.queueChanged = false;
             
             p.videoQueueMax = ValueSubject<size_t>::create();
             p.audioQueueMax = ValueSubject<size_t>::create();
             p.videoQueueCount = ValueSubject<size_t>::create();
             p.audioQueueCount = ValueSubject<size_t>::create();
 
+            p.playbackStats = ValueSubject<PlaybackStats>::create();
+            p.traceEnabled = ValueSubject<bool>::create(false);
+            p.traceStartTime = std::chrono::high_resolution_clock::now();
+
             p.queueTimer = Time::Timer::create(context);
             p.queueTimer->setRepeating(true);
             p.playbackTimer = Time::Timer::create(context);
@@ -150,6 +222,9 @@ namespace djv
             p.debugTimer = Time::Timer::create(context);
             p.debugTimer->setRepeating(true);
 
+            // The audio system is created on demand, the first time media is
+            // opened for playback.
+            context->getSystemT<AV::Audio::System>();
             try
             {
                 p.rtAudio.reset(new RtAudio);
@@ -504,6 +579,81 @@ namespace djv
             setInOutPoints(AV::IO::InOutPoints(enabled, value.getIn(), size > 0 ? (static_cast<Frame::Index>(size) - 1) : 0));
         }
 
+        void Media::setExternalClock(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value == p.externalClock)
+                return;
+            p.externalClock = value;
+            p.audioEnabled->setIfChanged(_isAudioEnabled());
+            if (p.playback->get() != Playback::Stop)
+            {
+                _playbackUpdate();
+            }
+        }
+
+        bool Media::hasExternalClock() const
+        {
+            return _p->externalClock;
+        }
+
+        bool Media::isFrameReady(Frame::Index value) const
+        {
+            DJV_PRIVATE_PTR();
+            bool out = true;
+            if (p.read)
+            {
+                std::lock_guard<std::mutex> lock(p.read->getMutex());
+                const auto& queue = p.read->getVideoQueue();
+                if (!queue.isFinished())
+                {
+                    if (queue.isEmpty())
+                    {
+                        out = false;
+                    }
+                    else
+                    {
+                        // The frames are queued in the playback direction and the
+                        // reader wraps around at the end of the sequence, so the
+                        // frame is ready once the distance of the last queued
+                        // frame from the current frame has reached it.
+                        const bool forward = AV::IO::Direction::Forward == p.ioDirection;
+                        const Frame::Index current = p.currentFrame->get();
+                        const Frame::Index size = static_cast<Frame::Index>(p.sequence->get().getSize());
+                        auto distance = [forward, current, size](Frame::Index value)
+                        {
+                            Frame::Index out = forward ? (value - current) : (current - value);
+                            if (size > 0)
+                            {
+                                out %= size;
+                                if (out < 0)
+                                {
+                                    out += size;
+                                }
+                            }
+                            return out;
+                        };
+                        out = distance(value) <= distance(queue.getLastFrame().frame);
+                    }
+                }
+            }
+            return out;
+        }
+
+        void Media::setSyncFrame(Frame::Index value)
+        {
+            _setCurrentFrame(value);
+            _queueUpdate();
+        }
+
+        size_t Media::getFrameByteCount() const
+        {
+            // The information is read from the subject since it is set before
+            // the video information when the media is opened.
+            const auto& video = _p->info->get().video;
+            return video.size() ? video[0].info.getDataByteCount() : 0;
+        }
+
         std::shared_ptr<IValueSubject<bool> > Media::observeAudioEnabled() const
         {
             return _p->audioEnabled;
@@ -546,6 +696,28 @@ namespace djv
             }
         }
 
+        std::shared_ptr<IValueSubject<bool> > Media::observePrefetchAdaptive() const
+        {
+            return _p->prefetchAdaptive;
+        }
+
+        std::shared_ptr<IValueSubject<AV::IO::PrefetchDecision> > Media::observePrefetchDecision() const
+        {
+            return _p->prefetchDecision;
+        }
+
+        void Media::setPrefetchAdaptive(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.prefetchAdaptive->setIfChanged(value))
+            {
+                if (p.read)
+                {
+                    p.read->setPrefetchAdaptive(value);
+                }
+            }
+        }
+
         bool Media::hasCache() const
         {
             DJV_PRIVATE_PTR();
@@ -627,6 +799,136 @@ namespace djv
             return _p->audioQueueCount;
         }
 
+        std::shared_ptr<IValueSubject<PlaybackStats> > Media::observePlaybackStats() const
+        {
+            return _p->playbackStats;
+        }
+
+        std::shared_ptr<IValueSubject<bool> > Media::observeTraceEnabled() const
+        {
+            return _p->traceEnabled;
+        }
+
+        void Media::resetPlaybackStats()
+        {
+            DJV_PRIVATE_PTR();
+            p.stats.clear();
+            p.statsChanged = false;
+            p.playbackStats->setAlways(p.stats);
+        }
+
+        void Media::setPaintedImage(const std::shared_ptr<AV::Image::Image>& value)
+        {
+            DJV_PRIVATE_PTR();
+            if (value && value == p.paintFrame.image)
+            {
+                const auto now = std::chrono::high_resolution_clock::now();
+                const auto& times = p.paintFrame.times;
+                const Frame::Index frame = p.paintFrame.frame;
+                const bool trace = p.traceEnabled->get();
+                auto addStage = [&p, frame, trace](
+                    PlaybackStage stage,
+                    const std::chrono::high_resolution_clock::time_point& start,
+                    const std::chrono::high_resolution_clock::time_point& end)
+                {
+                    if (isValid(start) && isValid(end))
+                    {
+                        const std::chrono::duration<float> delta = end - start;
+                        p.stats.getHistogram(stage).add(delta.count());
+                        if (trace && stage != PlaybackStage::Latency)
+                        {
+                            // The stages of different frames overlap, so they are
+                            // written as async events.
+                            std::stringstream ss;
+                            ss << stage;
+                            TraceEvent event;
+                            event.name = ss.str();
+                            event.frame = frame;
+                            event.thread = traceThreadFrames;
+                            event.phase = 'b';
+                            event.time = p.getTraceTime(start);
+                            p.addTraceEvent(event);
+                            event.phase = 'e';
+                            event.time = p.getTraceTime(end);
+                            p.addTraceEvent(event);
+                        }
+                    }
+                };
+
+                // Frames that are read from the cache or by readers that do not
+                // record the decode times start queueing when they are requested
+                // or enqueued.
+                const auto& start = isValid(times.request) ? times.request : times.enqueue;
+                addStage(PlaybackStage::Wait, times.request, times.decodeStart);
+                addStage(PlaybackStage::Decode, times.decodeStart, times.decodeEnd);
+                addStage(PlaybackStage::Queue, isValid(times.decodeEnd) ? times.decodeEnd : start, p.paintDequeueTime);
+                addStage(PlaybackStage::Display, p.paintDequeueTime, now);
+                addStage(PlaybackStage::Latency, start, now);
+
+                p.paintFrame = AV::IO::VideoFrame();
+                p.statsChanged = true;
+            }
+        }
+
+        void Media::setTraceEnabled(bool value)
+        {
+            DJV_PRIVATE_PTR();
+            if (p.traceEnabled->setIfChanged(value) && value)
+            {
+                p.traceEvents.clear();
+                p.traceStartTime = std::chrono::high_resolution_clock::now();
+            }
+        }
+
+        void Media::writeTrace(const std::string& fileName) const
+        {
+            DJV_PRIVATE_PTR();
+            picojson::value events(picojson::array_type, true);
+            for (const auto& i : p.traceEvents)
+            {
+                picojson::value event(picojson::object_type, true);
+                auto& object = event.get<picojson::object>();
+                object["name"] = picojson::value(i.name);
+                object["cat"] = picojson::value(std::string("playback"));
+                object["ph"] = picojson::value(std::string(1, i.phase));
+                object["ts"] = picojson::value(static_cast<double>(i.time));
+                object["pid"] = picojson::value(1.0);
+                object["tid"] = picojson::value(static_cast<double>(i.thread));
+                switch (i.phase)
+                {
+                case 'X':
+                    object["dur"] = picojson::value(static_cast<double>(i.duration));
+                    break;
+                case 'b':
+                case 'e':
+                    object["id"] = picojson::value(static_cast<double>(i.frame));
+                    break;
+                case 'i':
+                    object["s"] = picojson::value(std::string("t"));
+                    break;
+                default: break;
+                }
+                if (i.frame != Frame::invalid)
+                {
+                    picojson::value args(picojson::object_type, true);
+                    args.get<picojson::object>()["frame"] = picojson::value(static_cast<double>(i.frame));
+                    if (i.count)
+                    {
+                        args.get<picojson::object>()["count"] = picojson::value(static_cast<double>(i.count));
+                    }
+                    object["args"] = args;
+                }
+                events.get<picojson::array>().push_back(event);
+            }
+            picojson::value out(picojson::object_type, true);
+            out.get<picojson::object>()["traceEvents"] = events;
+            out.get<picojson::object>()["displayTimeUnit"] = picojson::value(std::string("ms"));
+
+            FileSystem::FileIO fileIO;
+            fileIO.open(fileName, FileSystem::FileIO::Mode::Write);
+            PicoJSON::write(out, fileIO);
+        }
+
         bool Media::_hasAudio() const
         {
             DJV_PRIVATE_PTR();
@@ -637,6 +939,7 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             return _hasAudio() &&
+                !p.externalClock &&
                 p.speed->get() == p.defaultSpeed->get() &&
                 !p.playEveryFrame->get();
         }
@@ -661,6 +964,19 @@ namespace djv
                     auto io = context->getSystemT<AV::IO::System>();
                     p.read = io->read(p.fileInfo, options);
                     p.read->setThreadCount(p.threadCount->get());
+                    p.read->setPrefetchAdaptive(p.prefetchAdaptive->get());
+                    {
+                        // Flag the queues so that the next update knows there is
+                        // something new to display.
+                        std::lock_guard<std::mutex> lock(p.read->getMutex());
+                        auto callback = [this]
+                        {
+                            _p->queueChanged = true;
+                        };
+                        p.read->getVideoQueue().setCallback(callback);
+                        p.read->getAudioQueue().setCallback(callback);
+                    }
+                    p.queueChanged = true;
                     
                     const auto info = p.read->getInfo().get();
                     p.info->setIfChanged(info);
@@ -776,6 +1092,12 @@ namespace djv
                                     media->_p->videoQueueCount->setAlways(videoQueueCount);
                                     media->_p->audioQueueMax->setAlways(audioQueueMax);
                                     media->_p->audioQueueCount->setAlways(audioQueueCount);
+                                    media->_p->prefetchDecision->setIfChanged(media->_p->read->getPrefetchDecision());
+                                }
+                                if (media->_p->statsChanged)
+                                {
+                                    media->_p->statsChanged = false;
+                                    media->_p->playbackStats->setAlways(media->_p->stats);
                                 }
                             }
                         });
@@ -893,6 +1215,8 @@ namespace djv
                 p.realSpeedTime = p.startTime;
                 p.realSpeedFrameCount = 0;
                 p.playEveryFrameTime = now;
+                p.shownFrame = Frame::invalid;
+                p.tickTime = std::chrono::high_resolution_clock::time_point();
                 _stopAudioStream();
             }
         }
@@ -940,15 +1264,22 @@ namespace djv
                         _startAudioStream();
                     }
                     auto weak = std::weak_ptr<Media>(std::dynamic_pointer_cast<Media>(shared_from_this()));
-                    p.playbackTimer->start(
-                        Time::getMilliseconds(Time::TimerValue::VeryFast),
-                        [weak](float)
+                    if (p.externalClock)
                     {
-                        if (auto media = weak.lock())
+                        p.playbackTimer->stop();
+                    }
+                    else
+                    {
+                        p.playbackTimer->start(
+                            Time::getMilliseconds(Time::TimerValue::VeryFast),
+                            [weak](float)
                         {
-                            media->_playbackTick();
-                        }
-                    });
+                            if (auto media = weak.lock())
+                            {
+                                media->_playbackTick();
+                            }
+                        });
+                    }
                     p.realSpeedTimer->start(
                         Time::getMilliseconds(Time::TimerValue::Slow),
                         [weak](float)
@@ -1063,13 +1394,46 @@ namespace djv
             DJV_PRIVATE_PTR();
             if (p.read)
             {
-                // Update the video queue.
+                // Nothing needs to be done while stopped unless new frames have
+                // arrived or the current frame has changed.
                 const Playback playback = p.playback->get();
+                const Frame::Index currentFrame = p.currentFrame->get();
+                const bool queueChanged = p.queueChanged.exchange(false);
                 const auto now = std::chrono::high_resolution_clock::now();
+                if (Playback::Stop == playback)
+                {
+                    p.tickTime = std::chrono::high_resolution_clock::time_point();
+                }
+                else
+                {
+                    // Record the interval between updates during playback.
+                    if (isValid(p.tickTime))
+                    {
+                        const std::chrono::duration<float> delta = now - p.tickTime;
+                        p.stats.getHistogram(PlaybackStage::Tick).add(delta.count());
+                        p.statsChanged = true;
+                        if (p.traceEnabled->get())
+                        {
+                            TraceEvent event;
+                            event.name = "Tick";
+                            event.time = p.getTraceTime(p.tickTime);
+                            event.duration = p.getTraceTime(now) - event.time;
+                            event.thread = traceThreadUI;
+                            p.addTraceEvent(event);
+                        }
+                    }
+                    p.tickTime = now;
+                }
+                if (Playback::Stop == playback && !queueChanged && currentFrame == p.queueFrame)
+                {
+                    return;
+                }
+                p.queueFrame = currentFrame;
+
+                // Update the video queue.
                 const std::chrono::duration<double> playEveryFrameDelta = now - p.playEveryFrameTime;
                 const float frameTime = 1.F / p.speed->get().toFloat();
                 const bool playEveryFrameAdvance = playEveryFrameDelta.count() > frameTime;
-                const Frame::Index currentFrame = p.currentFrame->get();
                 AV::IO::VideoFrame frame;
                 bool gotFrame = false;
                 {
@@ -1097,13 +1461,20 @@ namespace djv
                             p.realSpeedFrameCount = p.realSpeedFrameCount + 1;
                         }
                     }
-                    if (!gotFrame && !queue.isEmpty())
+                    if (!queue.isEmpty() &&
+                        (!gotFrame || (p.externalClock && queue.getFrame().frame == currentFrame)))
                     {
+                        // With an external clock the current frame is shown as soon
+                        // as it is available so that the group stays in step.
                         frame = queue.getFrame();
                     }
                 }
                 if (frame.image)
                 {
+                    if (frame.image != p.shownImage)
+                    {
+                        _frameShown(frame, playback, now);
+                    }
                     p.currentImage->setIfChanged(frame.image);
                     if (p.playEveryFrame->get())
                     {
@@ -1124,6 +1495,63 @@ namespace djv
             }
         }
         
+        void Media::_frameShown(
+            const AV::IO::VideoFrame& frame,
+            Playback playback,
+            const std::chrono::high_resolution_clock::time_point& now)
+        {
+            DJV_PRIVATE_PTR();
+
+            // Count the frames that were skipped since the last frame was shown.
+            if (p.shownFrame != Frame::invalid)
+            {
+                Frame::Index skipped = 0;
+                switch (playback)
+                {
+                case Playback::Forward:
+                    if (frame.frame > p.shownFrame)
+                    {
+                        skipped = frame.frame - p.shownFrame - 1;
+                    }
+                    break;
+                case Playback::Reverse:
+                    if (frame.frame < p.shownFrame)
+                    {
+                        skipped = p.shownFrame - frame.frame - 1;
+                    }
+                    break;
+                default: break;
+                }
+                if (skipped > 0)
+                {
+                    p.stats.droppedFrames += static_cast<size_t>(skipped);
+                    if (p.traceEnabled->get())
+                    {
+                        TraceEvent event;
+                        event.name = "Drop";
+                        event.phase = 'i';
+                        event.time = p.getTraceTime(now);
+                        event.frame = frame.frame;
+                        event.count = static_cast<size_t>(skipped);
+                        event.thread = traceThreadUI;
+                        p.addTraceEvent(event);
+                    }
+                }
+            }
+            p.shownFrame = frame.frame;
+            p.shownImage = frame.image;
+            ++p.stats.shownFrames;
+            if (frame.times.cached)
+            {
+                ++p.stats.cachedFrames;
+            }
+            p.statsChanged = true;
+
+            // The remaining timings are recorded when the frame is painted.
+            p.paintFrame = frame;
+            p.paintDequeueTime = now;
+        }
+
         int Media::_rtAudioCallback(
             void* outputBuffer,
             void* inputBuffer,
@@ -1140,6 +1568,14 @@ namespace djv
             const size_t sampleByteCount = info.info.channelCount * AV::Audio::getByteCount(info.info.type);
             const float volume = !media->_p->mute->get() ? media->_p->volume->get() : 0.F;
 
+            // Ramp the volume across the buffer so that changes don't click.
+            const float volumePrev = media->_p->audioVolume;
+            auto getVolume = [nFrames, volume, volumePrev](size_t value)
+            {
+                return volumePrev + (volume - volumePrev) * value / static_cast<float>(nFrames);
+            };
+            media->_p->audioVolume = volume;
+
             if (media->_p->audioData)
             {
                 sampleCount += media->_p->audioData->getSampleCount() - media->_p->audioDataSamplesOffset;
@@ -1173,7 +1609,8 @@ namespace djv
                 AV::Audio::Data::volume(
                     media->_p->audioData->getData() + media->_p->audioDataSamplesOffset * sampleByteCount,
                     p,
-                    volume,
+                    getVolume(nFrames - outputSampleCount),
+                    getVolume(nFrames - outputSampleCount + size),
                     size,
                     info.info.channelCount,
                     info.info.type);
@@ -1201,7 +1638,8 @@ namespace djv
                 AV::Audio::Data::volume(
                     i.audio->getData(),
                     p,
-                    volume,
+                    getVolume(nFrames - outputSampleCount),
+                    getVolume(nFrames - outputSampleCount + size),
                     size,
                     info.info.channelCount,
                     info.info.type);
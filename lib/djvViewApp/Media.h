@@ -30,6 +30,7 @@
 #pragma once
 
 #include <djvViewApp/Enum.h>
+#include <djvViewApp/PlaybackStats.h>
 
 #include <djvAV/IO.h>
 
@@ -136,6 +137,33 @@ namespace djv
 
             ///@}
 
+            //! \name Synchronization
+            ///@{
+
+            //! Set whether playback is driven by an external clock instead of
+            //! the media's own timer. This is used by MediaSync to play several
+            //! media in lock step. Audio is disabled while the external clock
+            //! is used.
+            void setExternalClock(bool);
+
+            bool hasExternalClock() const;
+
+            //! Get whether the given frame can be shown during playback. This
+            //! is true when the frame is in the video queue, or when the reader
+            //! has already moved past it or reached the end of the sequence.
+            bool isFrameReady(Core::Frame::Index) const;
+
+            //! Set the current frame from the external clock. Unlike
+            //! setCurrentFrame() this does not stop playback, and the video
+            //! queue is updated immediately so that every media in a group
+            //! changes images at the same time.
+            void setSyncFrame(Core::Frame::Index);
+
+            //! Get the number of bytes used by a decoded frame.
+            size_t getFrameByteCount() const;
+
+            ///@}
+
             //! \name Audio
             ///@{
 
@@ -152,8 +180,11 @@ namespace djv
             ///@{
 
             std::shared_ptr<Core::IValueSubject<size_t> > observeThreadCount() const;
+            std::shared_ptr<Core::IValueSubject<bool> > observePrefetchAdaptive() const;
+            std::shared_ptr<Core::IValueSubject<AV::IO::PrefetchDecision> > observePrefetchDecision() const;
 
             void setThreadCount(size_t);
+            void setPrefetchAdaptive(bool);
 
             ///@}
 
@@ -191,6 +222,29 @@ namespace djv
 
             ///@}
 
+            //! \name Telemetry
+            ///@{
+
+            std::shared_ptr<Core::IValueSubject<PlaybackStats> > observePlaybackStats() const;
+            std::shared_ptr<Core::IValueSubject<bool> > observeTraceEnabled() const;
+
+            void resetPlaybackStats();
+
+            //! Record when an image from this media is painted. The timings
+            //! of a frame are finished when it is first painted.
+            void setPaintedImage(const std::shared_ptr<AV::Image::Image>&);
+
+            //! Set whether the playback pipeline events are recorded. Only the
+            //! most recent events are kept.
+            void setTraceEnabled(bool);
+
+            //! Write the recorded events as Chrome trace event JSON.
+            //! Throws:
+            //! - Core::FileSystem::Error
+            void writeTrace(const std::string& fileName) const;
+
+            ///@}
+
         private:
             bool _hasAudio() const;
             bool _isAudioEnabled() const;
@@ -203,6 +257,7 @@ namespace djv
             void _startAudioStream();
             void _stopAudioStream();
             void _queueUpdate();
+            void _frameShown(const AV::IO::VideoFrame&, Playback, const std::chrono::high_resolution_clock::time_point&);
 
             static int _rtAudioCallback(
                 void* outputBuffer,
@@ -0,0 +1,298 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewApp/MediaSync.h>
+
+#include <djvViewApp/Media.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Math.h>
+#include <djvCore/Timer.h>
+#include <djvCore/ValueObserver.h>
+
+#include <algorithm>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        namespace
+        {
+            //! Clamp a frame to the in/out points of the given media.
+            Frame::Index clampFrame(const Media& media, Frame::Index value)
+            {
+                const size_t size = media.observeSequence()->get().getSize();
+                const auto range = media.observeInOutPoints()->get().getRange(size);
+                return Math::clamp(value, range.min, range.max);
+            }
+
+        } // namespace
+
+        struct MediaSync::Private
+        {
+            std::vector<std::shared_ptr<Media> > media;
+            Playback playback = Playback::Stop;
+            Frame::Index frameOffset = 0;
+            Frame::Index frame = Frame::invalid;
+            std::chrono::high_resolution_clock::time_point startTime;
+            size_t clockResets = 0;
+            size_t stallCount = 0;
+            bool stalled = false;
+            std::shared_ptr<Time::Timer> timer;
+            std::shared_ptr<ValueObserver<Playback> > playbackObserver;
+            std::shared_ptr<ValueObserver<Frame::Index> > currentFrameObserver;
+            std::shared_ptr<ValueObserver<Time::Speed> > speedObserver;
+        };
+
+        void MediaSync::_init(const std::shared_ptr<Context>& context)
+        {
+            DJV_PRIVATE_PTR();
+            p.timer = Time::Timer::create(context);
+            p.timer->setRepeating(true);
+        }
+
+        MediaSync::MediaSync() :
+            _p(new Private)
+        {}
+
+        MediaSync::~MediaSync()
+        {
+            DJV_PRIVATE_PTR();
+            for (const auto& i : p.media)
+            {
+                i->setExternalClock(false);
+            }
+        }
+
+        std::shared_ptr<MediaSync> MediaSync::create(const std::shared_ptr<Context>& context)
+        {
+            auto out = std::shared_ptr<MediaSync>(new MediaSync);
+            out->_init(context);
+            return out;
+        }
+
+        const std::vector<std::shared_ptr<Media> >& MediaSync::getMedia() const
+        {
+            return _p->media;
+        }
+
+        void MediaSync::setMedia(const std::vector<std::shared_ptr<Media> >& value)
+        {
+            DJV_PRIVATE_PTR();
+            const auto media = value.size() > 1 ? value : std::vector<std::shared_ptr<Media> >();
+            if (media == p.media)
+                return;
+            for (const auto& i : p.media)
+            {
+                if (std::find(media.begin(), media.end(), i) == media.end())
+                {
+                    i->setExternalClock(false);
+                }
+            }
+            p.media = media;
+            p.playbackObserver.reset();
+            p.currentFrameObserver.reset();
+            p.speedObserver.reset();
+            p.timer->stop();
+            if (p.media.size())
+            {
+                for (const auto& i : p.media)
+                {
+                    i->setExternalClock(true);
+                }
+                const auto& leader = p.media[0];
+                auto weak = std::weak_ptr<MediaSync>(std::dynamic_pointer_cast<MediaSync>(shared_from_this()));
+                p.playbackObserver = ValueObserver<Playback>::create(
+                    leader->observePlayback(),
+                    [weak](Playback value)
+                    {
+                        if (auto sync = weak.lock())
+                        {
+                            sync->_p->playback = value;
+                            sync->_mirror();
+                        }
+                    });
+                p.currentFrameObserver = ValueObserver<Frame::Index>::create(
+                    leader->observeCurrentFrame(),
+                    [weak](Frame::Index)
+                    {
+                        if (auto sync = weak.lock())
+                        {
+                            // During playback the frames are set by the clock.
+                            if (Playback::Stop == sync->_p->playback)
+                            {
+                                sync->_mirror();
+                            }
+                        }
+                    });
+                p.speedObserver = ValueObserver<Time::Speed>::create(
+                    leader->observeSpeed(),
+                    [weak](const Time::Speed&)
+                    {
+                        if (auto sync = weak.lock())
+                        {
+                            sync->_clockReset();
+                        }
+                    });
+            }
+        }
+
+        size_t MediaSync::getStallCount() const
+        {
+            return _p->stallCount;
+        }
+
+        std::vector<size_t> MediaSync::getCacheByteCounts(size_t byteCount, const std::vector<size_t>& frameByteCounts)
+        {
+            const size_t size = frameByteCounts.size();
+            std::vector<size_t> out(size, 0);
+
+            // Media that has not been opened yet is given the average frame
+            // size of the others, an equal share.
+            size_t knownSum = 0;
+            size_t knownCount = 0;
+            for (const auto& i : frameByteCounts)
+            {
+                if (i > 0)
+                {
+                    knownSum += i;
+                    ++knownCount;
+                }
+            }
+            const double unknown = knownCount > 0 ? (knownSum / static_cast<double>(knownCount)) : 1.0;
+            const double sum = knownSum + unknown * (size - knownCount);
+            for (size_t i = 0; i < size; ++i)
+            {
+                const double frameByteCount = frameByteCounts[i] > 0 ? frameByteCounts[i] : unknown;
+                out[i] = static_cast<size_t>(byteCount * (frameByteCount / sum));
+            }
+            return out;
+        }
+
+        void MediaSync::_mirror()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.media.empty())
+                return;
+            const Frame::Index frame = p.media[0]->observeCurrentFrame()->get();
+            for (size_t i = 1; i < p.media.size(); ++i)
+            {
+                const auto& media = p.media[i];
+                const Frame::Index mediaFrame = clampFrame(*media, frame);
+                if (media->observePlayback()->get() != p.playback ||
+                    media->observeCurrentFrame()->get() != mediaFrame)
+                {
+                    // Restarting the playback seeks the reader to the new frame.
+                    media->setPlayback(Playback::Stop);
+                    media->setCurrentFrame(mediaFrame);
+                    media->setPlayback(p.playback);
+                }
+            }
+            _clockReset();
+            if (Playback::Stop == p.playback)
+            {
+                p.timer->stop();
+            }
+            else if (!p.timer->isActive())
+            {
+                auto weak = std::weak_ptr<MediaSync>(std::dynamic_pointer_cast<MediaSync>(shared_from_this()));
+                p.timer->start(
+                    Time::getMilliseconds(Time::TimerValue::VeryFast),
+                    [weak](float)
+                    {
+                        if (auto sync = weak.lock())
+                        {
+                            sync->_tick();
+                        }
+                    });
+            }
+        }
+
+        void MediaSync::_clockReset()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.media.size())
+            {
+                p.frameOffset = p.media[0]->observeCurrentFrame()->get();
+                p.frame = p.frameOffset;
+                p.startTime = std::chrono::high_resolution_clock::now();
+                ++p.clockResets;
+            }
+        }
+
+        void MediaSync::_tick()
+        {
+            DJV_PRIVATE_PTR();
+            if (p.media.empty() || Playback::Stop == p.playback)
+                return;
+
+            const auto& leader = p.media[0];
+            const auto now = std::chrono::high_resolution_clock::now();
+            const std::chrono::duration<double> delta = now - p.startTime;
+            const Frame::Index elapsed = static_cast<Frame::Index>(delta.count() * leader->observeSpeed()->get().toFloat());
+            const Frame::Index frame = Playback::Forward == p.playback ? (p.frameOffset + elapsed) : (p.frameOffset - elapsed);
+            if (frame == p.frame)
+                return;
+
+            // Wait until every media has decoded the frame.
+            for (const auto& i : p.media)
+            {
+                if (!i->isFrameReady(clampFrame(*i, frame)))
+                {
+                    if (!p.stalled)
+                    {
+                        p.stalled = true;
+                        ++p.stallCount;
+                    }
+                    p.frameOffset = p.frame;
+                    p.startTime = now;
+                    return;
+                }
+            }
+
+            // The leader handles reaching the end of the in/out points, which
+            // restarts the clock through the playback observer.
+            p.stalled = false;
+            p.frame = frame;
+            const size_t clockResets = p.clockResets;
+            leader->setSyncFrame(frame);
+            if (clockResets == p.clockResets)
+            {
+                const Frame::Index leaderFrame = leader->observeCurrentFrame()->get();
+                for (size_t i = 1; i < p.media.size(); ++i)
+                {
+                    p.media[i]->setSyncFrame(clampFrame(*p.media[i], leaderFrame));
+                }
+            }
+        }
+
+    } // namespace ViewApp
+} // namespace djv
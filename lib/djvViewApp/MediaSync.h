@@ -0,0 +1,94 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvCore/Core.h>
+
+#include <memory>
+#include <vector>
+
+namespace djv
+{
+    namespace Core
+    {
+        class Context;
+
+    } // namespace Core
+
+    namespace ViewApp
+    {
+        class Media;
+
+        //! This class provides synchronized playback for a group of media.
+        //!
+        //! The first media is the leader, its playback state and current frame
+        //! are mirrored by the other media. During playback all of the media are
+        //! driven by a shared clock instead of their own timers. The clock only
+        //! advances to a frame once every media has decoded it; otherwise the
+        //! current frame is held and the clock is restarted from it, so under
+        //! load the group slows down together instead of drifting apart.
+        class MediaSync : public std::enable_shared_from_this<MediaSync>
+        {
+            DJV_NON_COPYABLE(MediaSync);
+
+        protected:
+            void _init(const std::shared_ptr<Core::Context>&);
+            MediaSync();
+
+        public:
+            ~MediaSync();
+
+            static std::shared_ptr<MediaSync> create(const std::shared_ptr<Core::Context>&);
+
+            const std::vector<std::shared_ptr<Media> >& getMedia() const;
+
+            //! Set the media to synchronize. Synchronization is disabled when
+            //! there are less than two media.
+            void setMedia(const std::vector<std::shared_ptr<Media> >&);
+
+            //! Get the number of times the clock has stalled waiting for a frame
+            //! to be decoded.
+            size_t getStallCount() const;
+
+            //! Divide a memory cache budget between media so that each of them
+            //! can cache the same number of frames. Unknown frame sizes (zero)
+            //! are given an equal share.
+            static std::vector<size_t> getCacheByteCounts(size_t byteCount, const std::vector<size_t>& frameByteCounts);
+
+        private:
+            void _mirror();
+            void _clockReset();
+            void _tick();
+
+            DJV_PRIVATE();
+        };
+
+    } // namespace ViewApp
+} // namespace djv
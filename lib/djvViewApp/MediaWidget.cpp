@@ -29,6 +29,7 @@
 
 #include <djvViewApp/MediaWidget.h>
 
+#include <djvViewApp/CompareSystem.h>
 #include <djvViewApp/FileSettings.h>
 #include <djvViewApp/FileSystem.h>
 #include <djvViewApp/ImageSystem.h>
@@ -115,6 +116,9 @@ namespace djv
             ImageViewLock viewLock = ImageViewLock::First;
             bool frameStoreEnabled = false;
             std::shared_ptr<AV::Image::Image> frameStore;
+            CompareOptions compareOptions;
+            std::vector<std::shared_ptr<AV::Image::Image> > compareImages;
+            std::weak_ptr<CompareSystem> compareSystem;
             bool audioEnabled = false;
             float audioVolume = 0.F;
             bool audioMute = false;
@@ -162,6 +166,7 @@ namespace djv
             std::shared_ptr<ValueObserver<bool> > currentFrameChangeObserver;
             std::shared_ptr<ValueObserver<AV::TimeUnits> > timeUnitsObserver;
             std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > imageObserver;
+            std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > paintedImageObserver;
             std::shared_ptr<ValueObserver<Time::Speed> > speedObserver;
             std::shared_ptr<ValueObserver<Time::Speed> > defaultSpeedObserver;
             std::shared_ptr<ValueObserver<float> > realSpeedObserver;
@@ -185,6 +190,9 @@ namespace djv
             std::shared_ptr<ValueObserver<ImageViewLock> > viewLockObserver;
             std::shared_ptr<ValueObserver<bool> > frameStoreEnabledObserver;
             std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > frameStoreObserver;
+            std::shared_ptr<ValueObserver<CompareOptions> > compareOptionsObserver;
+            std::shared_ptr<ListObserver<std::shared_ptr<Media> > > compareMediaObserver;
+            std::vector<std::shared_ptr<ValueObserver<std::shared_ptr<AV::Image::Image> > > > compareImageObservers;
             std::shared_ptr<ValueObserver<UI::ImageAspectRatio> > imageAspectRatioObserver;
         };
 
@@ -434,6 +442,23 @@ namespace djv
                     {
                         const BBox2f& g = widget->_p->imageView->getGeometry();
                         widget->_p->hover->setIfChanged(PointerData(data.state, data.pos - g.min, data.buttons));
+
+                        // The compare wipe follows the pointer.
+                        if (widget->_p->compareImages.size() && CompareMode::Wipe == widget->_p->compareOptions.mode)
+                        {
+                            if (auto compareSystem = widget->_p->compareSystem.lock())
+                            {
+                                const auto& imageView = widget->_p->imageView;
+                                const BBox2f bbox = imageView->getImageBBox();
+                                const float zoom = imageView->observeImageZoom()->get();
+                                const glm::vec2& imagePos = imageView->observeImagePos()->get();
+                                if (bbox.w() > 0.F && zoom > 0.F)
+                                {
+                                    const float x = (data.pos.x - g.min.x - imagePos.x) / zoom;
+                                    compareSystem->setWipe((x - bbox.min.x) / bbox.w());
+                                }
+                            }
+                        }
                     }
                 });
             p.pointerWidget->setDragCallback(
@@ -804,6 +829,16 @@ namespace djv
                     }
                 });
 
+            p.paintedImageObserver = ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                p.imageView->observePaintedImage(),
+                [weak](const std::shared_ptr<AV::Image::Image>& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->media->setPaintedImage(value);
+                    }
+                });
+
             p.speedObserver = ValueObserver<Time::Speed>::create(
                 p.media->observeSpeed(),
                 [weak](const Time::Speed& value)
@@ -1068,6 +1103,51 @@ namespace djv
                     });
             }
 
+            if (auto compareSystem = context->getSystemT<CompareSystem>())
+            {
+                p.compareSystem = compareSystem;
+                p.compareOptionsObserver = ValueObserver<CompareOptions>::create(
+                    compareSystem->observeCompareOptions(),
+                    [weak](const CompareOptions& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->compareOptions = value;
+                            widget->_imageUpdate();
+                        }
+                    });
+                p.compareMediaObserver = ListObserver<std::shared_ptr<Media> >::create(
+                    compareSystem->observeMedia(),
+                    [weak](const std::vector<std::shared_ptr<Media> >& value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            // Only the widget for the first media shows the comparison.
+                            widget->_p->compareImageObservers.clear();
+                            widget->_p->compareImages.clear();
+                            if (value.size() > 1 && value[0] == widget->_p->media)
+                            {
+                                widget->_p->compareImages.resize(value.size() - 1);
+                                for (size_t i = 1; i < value.size(); ++i)
+                                {
+                                    widget->_p->compareImageObservers.push_back(
+                                        ValueObserver<std::shared_ptr<AV::Image::Image> >::create(
+                                            value[i]->observeCurrentImage(),
+                                            [weak, i](const std::shared_ptr<AV::Image::Image>& value)
+                                            {
+                                                if (auto widget = weak.lock())
+                                                {
+                                                    widget->_p->compareImages[i - 1] = value;
+                                                    widget->_imageUpdate();
+                                                }
+                                            }));
+                                }
+                            }
+                            widget->_imageUpdate();
+                        }
+                    });
+            }
+
             p.imageAspectRatioObserver = ValueObserver<UI::ImageAspectRatio>::create(
                 p.imageView->observeImageAspectRatio(),
                 [weak](UI::ImageAspectRatio value)
@@ -1331,6 +1411,8 @@ namespace djv
         {
             DJV_PRIVATE_PTR();
             p.imageView->setImage(p.active && p.frameStoreEnabled && p.frameStore ? p.frameStore : p.image);
+            p.imageView->setCompareOptions(p.compareImages.size() ? p.compareOptions : CompareOptions());
+            p.imageView->setCompareImages(p.compareImages);
         }
 
         void MediaWidget::_speedUpdate()
@@ -47,6 +47,7 @@ namespace djv
             std::shared_ptr<ValueSubject<bool> > playEveryFrame;
             std::shared_ptr<ValueSubject<PlaybackMode> > playbackMode;
             std::shared_ptr<ValueSubject<bool> > pip;
+            std::shared_ptr<ValueSubject<bool> > prefetchAdaptive;
         };
 
         void PlaybackSettings::_init(const std::shared_ptr<Core::Context>& context)
@@ -58,6 +59,7 @@ namespace djv
             p.playEveryFrame = ValueSubject<bool>::create(false);
             p.playbackMode = ValueSubject<PlaybackMode>::create(PlaybackMode::Loop);
             p.pip = ValueSubject<bool>::create(true);
+            p.prefetchAdaptive = ValueSubject<bool>::create(true);
             _load();
         }
 
@@ -112,6 +114,16 @@ namespace djv
             _p->pip->setIfChanged(value);
         }
 
+        std::shared_ptr<IValueSubject<bool> > PlaybackSettings::observePrefetchAdaptive() const
+        {
+            return _p->prefetchAdaptive;
+        }
+
+        void PlaybackSettings::setPrefetchAdaptive(bool value)
+        {
+            _p->prefetchAdaptive->setIfChanged(value);
+        }
+
         void PlaybackSettings::load(const picojson::value & value)
         {
             if (value.is<picojson::object>())
@@ -122,6 +134,7 @@ namespace djv
                 UI::Settings::read("PlayEveryFrame", object, p.playEveryFrame);
                 UI::Settings::read("PlaybackMode", object, p.playbackMode);
                 UI::Settings::read("PIP", object, p.pip);
+                UI::Settings::read("PrefetchAdaptive", object, p.prefetchAdaptive);
             }
         }
 
@@ -134,6 +147,7 @@ namespace djv
             UI::Settings::write("PlayEveryFrame", p.playEveryFrame->get(), object);
             UI::Settings::write("PlaybackMode", p.playbackMode->get(), object);
             UI::Settings::write("PIP", p.pip->get(), object);
+            UI::Settings::write("PrefetchAdaptive", p.prefetchAdaptive->get(), object);
             return out;
         }
 
@@ -64,6 +64,11 @@ namespace djv
             std::shared_ptr<Core::IValueSubject<bool> > observePIP() const;
             void setPIP(bool);
 
+            //! Set whether the prefetch of frames is tuned at runtime. When
+            //! disabled the thread count and queue size are fixed.
+            std::shared_ptr<Core::IValueSubject<bool> > observePrefetchAdaptive() const;
+            void setPrefetchAdaptive(bool);
+
             void load(const picojson::value &) override;
             picojson::value save() override;
 
@@ -51,8 +51,10 @@ namespace djv
         struct PlaybackSettingsWidget::Private
         {
             std::shared_ptr<UI::CheckBox> startPlaybackButton;
+            std::shared_ptr<UI::CheckBox> prefetchAdaptiveButton;
             std::shared_ptr<UI::VerticalLayout> layout;
             std::shared_ptr<ValueObserver<bool> > startPlaybackObserver;
+            std::shared_ptr<ValueObserver<bool> > prefetchAdaptiveObserver;
         };
 
         void PlaybackSettingsWidget::_init(const std::shared_ptr<Context>& context)
@@ -63,9 +65,11 @@ namespace djv
             setClassName("djv::ViewApp::PlaybackSettingsWidget");
 
             p.startPlaybackButton = UI::CheckBox::create(context);
+            p.prefetchAdaptiveButton = UI::CheckBox::create(context);
 
             p.layout = UI::VerticalLayout::create(context);
             p.layout->addChild(p.startPlaybackButton);
+            p.layout->addChild(p.prefetchAdaptiveButton);
             addChild(p.layout);
 
             auto weak = std::weak_ptr<PlaybackSettingsWidget>(std::dynamic_pointer_cast<PlaybackSettingsWidget>(shared_from_this()));
@@ -86,6 +90,22 @@ namespace djv
                     }
                 });
 
+            p.prefetchAdaptiveButton->setCheckedCallback(
+                [weak, contextWeak](bool value)
+                {
+                    if (auto context = contextWeak.lock())
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            auto settingsSystem = context->getSystemT<UI::Settings::System>();
+                            if (auto playbackSettings = settingsSystem->getSettingsT<PlaybackSettings>())
+                            {
+                                playbackSettings->setPrefetchAdaptive(value);
+                            }
+                        }
+                    }
+                });
+
             auto settingsSystem = context->getSystemT<UI::Settings::System>();
             if (auto playbackSettings = settingsSystem->getSettingsT<PlaybackSettings>())
             {
@@ -98,6 +118,16 @@ namespace djv
                             widget->_p->startPlaybackButton->setChecked(value);
                         }
                     });
+
+                p.prefetchAdaptiveObserver = ValueObserver<bool>::create(
+                    playbackSettings->observePrefetchAdaptive(),
+                    [weak](bool value)
+                    {
+                        if (auto widget = weak.lock())
+                        {
+                            widget->_p->prefetchAdaptiveButton->setChecked(value);
+                        }
+                    });
             }
         }
 
@@ -132,6 +162,7 @@ namespace djv
             ISettingsWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             p.startPlaybackButton->setText(_getText(DJV_TEXT("Automatically start playback")));
+            p.prefetchAdaptiveButton->setText(_getText(DJV_TEXT("Adaptive prefetch")));
         }
 
         struct TimelineSettingsWidget::Private
@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvViewApp/PlaybackStats.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        namespace
+        {
+            //! \todo Should this be configurable?
+            const size_t sampleMaxDefault = 240;
+
+        } // namespace
+
+        LatencyHistogram::LatencyHistogram() :
+            LatencyHistogram(sampleMaxDefault)
+        {}
+
+        LatencyHistogram::LatencyHistogram(size_t sampleMax) :
+            _sampleMax(sampleMax),
+            _bins(getBinBounds().size() + 1, 0)
+        {}
+
+        const std::vector<float>& LatencyHistogram::getBinBounds()
+        {
+            static const std::vector<float> data =
+            {
+                .001F,
+                .002F,
+                .004F,
+                .008F,
+                .016F,
+                .033F,
+                .066F,
+                .133F,
+                .266F
+            };
+            return data;
+        }
+
+        size_t LatencyHistogram::getCount() const
+        {
+            return _samples.size();
+        }
+
+        const std::vector<size_t>& LatencyHistogram::getBins() const
+        {
+            return _bins;
+        }
+
+        float LatencyHistogram::getMean() const
+        {
+            return _samples.size() ?
+                (std::accumulate(_samples.begin(), _samples.end(), 0.F) / _samples.size()) :
+                0.F;
+        }
+
+        float LatencyHistogram::getMax() const
+        {
+            return _samples.size() ? *std::max_element(_samples.begin(), _samples.end()) : 0.F;
+        }
+
+        float LatencyHistogram::getPercentile(float value) const
+        {
+            float out = 0.F;
+            if (_samples.size())
+            {
+                std::vector<float> sorted(_samples.begin(), _samples.end());
+                const size_t i = std::min(
+                    static_cast<size_t>(value / 100.F * sorted.size()),
+                    sorted.size() - 1);
+                std::nth_element(sorted.begin(), sorted.begin() + i, sorted.end());
+                out = sorted[i];
+            }
+            return out;
+        }
+
+        namespace
+        {
+            size_t getBin(float value)
+            {
+                const auto& bounds = LatencyHistogram::getBinBounds();
+                return std::lower_bound(bounds.begin(), bounds.end(), value) - bounds.begin();
+            }
+
+        } // namespace
+
+        void LatencyHistogram::add(float value)
+        {
+            if (_samples.size() >= _sampleMax && _samples.size())
+            {
+                --_bins[getBin(_samples.front())];
+                _samples.pop_front();
+            }
+            if (_sampleMax > 0)
+            {
+                _samples.push_back(value);
+                ++_bins[getBin(value)];
+            }
+        }
+
+        void LatencyHistogram::clear()
+        {
+            _samples.clear();
+            std::fill(_bins.begin(), _bins.end(), 0);
+        }
+
+        bool LatencyHistogram::operator == (const LatencyHistogram& other) const
+        {
+            return _sampleMax == other._sampleMax && _samples == other._samples;
+        }
+
+        PlaybackStats::PlaybackStats() :
+            histograms(static_cast<size_t>(PlaybackStage::Count))
+        {}
+
+        const LatencyHistogram& PlaybackStats::getHistogram(PlaybackStage value) const
+        {
+            return histograms[static_cast<size_t>(value)];
+        }
+
+        LatencyHistogram& PlaybackStats::getHistogram(PlaybackStage value)
+        {
+            return histograms[static_cast<size_t>(value)];
+        }
+
+        void PlaybackStats::clear()
+        {
+            for (auto& i : histograms)
+            {
+                i.clear();
+            }
+            shownFrames = 0;
+            droppedFrames = 0;
+            cachedFrames = 0;
+        }
+
+        bool PlaybackStats::operator == (const PlaybackStats& other) const
+        {
+            return
+                histograms == other.histograms &&
+                shownFrames == other.shownFrames &&
+                droppedFrames == other.droppedFrames &&
+                cachedFrames == other.cachedFrames;
+        }
+
+    } // namespace ViewApp
+} // namespace djv
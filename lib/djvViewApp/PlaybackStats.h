@@ -0,0 +1,102 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+#include <djvViewApp/Enum.h>
+
+#include <deque>
+#include <vector>
+
+namespace djv
+{
+    namespace ViewApp
+    {
+        //! This class provides a rolling histogram of durations. Only the most
+        //! recent samples are kept.
+        class LatencyHistogram
+        {
+        public:
+            LatencyHistogram();
+            explicit LatencyHistogram(size_t sampleMax);
+
+            //! Get the upper bounds of the histogram bins in seconds. There is
+            //! one more bin than there are bounds for the durations that are
+            //! larger than the last bound.
+            static const std::vector<float>& getBinBounds();
+
+            size_t getCount() const;
+            const std::vector<size_t>& getBins() const;
+            float getMean() const;
+            float getMax() const;
+
+            //! Get a percentile of the samples.
+            //! \param value The percentile in the range [0, 100].
+            float getPercentile(float value) const;
+
+            void add(float);
+            void clear();
+
+            bool operator == (const LatencyHistogram&) const;
+
+        private:
+            size_t _sampleMax = 0;
+            std::deque<float> _samples;
+            std::vector<size_t> _bins;
+        };
+
+        //! This class provides playback statistics.
+        class PlaybackStats
+        {
+        public:
+            PlaybackStats();
+
+            std::vector<LatencyHistogram> histograms;
+
+            //! The number of frames that were displayed.
+            size_t shownFrames = 0;
+
+            //! The number of frames that were skipped during playback, either
+            //! because they were not decoded in time or because they were
+            //! taken from the queue late.
+            size_t droppedFrames = 0;
+
+            //! The number of displayed frames that were taken from the cache.
+            size_t cachedFrames = 0;
+
+            const LatencyHistogram& getHistogram(PlaybackStage) const;
+            LatencyHistogram& getHistogram(PlaybackStage);
+
+            void clear();
+
+            bool operator == (const PlaybackStats&) const;
+        };
+
+    } // namespace ViewApp
+} // namespace djv
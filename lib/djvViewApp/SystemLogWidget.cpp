@@ -31,23 +31,33 @@
 
 #include <djvDesktopApp/GLFWSystem.h>
 
+#include <djvUIComponents/SearchBox.h>
+
+#include <djvUI/ComboBox.h>
 #include <djvUI/EventSystem.h>
 #include <djvUI/PushButton.h>
 #include <djvUI/RowLayout.h>
 #include <djvUI/ScrollWidget.h>
-#include <djvUI/TextBlock.h>
 #include <djvUI/StackLayout.h>
+#include <djvUI/Style.h>
 #include <djvUI/Window.h>
 
+#include <djvAV/FontSystem.h>
+#include <djvAV/Render2D.h>
+
 #include <djvCore/Context.h>
-#include <djvCore/FileIO.h>
-#include <djvCore/Path.h>
-#include <djvCore/ResourceSystem.h>
+#include <djvCore/LogSystem.h>
 #include <djvCore/String.h>
+#include <djvCore/Time.h>
+#include <djvCore/Timer.h>
 
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 
+#include <deque>
+#include <iomanip>
+#include <map>
+
 using namespace djv::Core;
 
 namespace djv
@@ -56,6 +66,10 @@ namespace djv
     {
         namespace
         {
+            //! \todo Should this be configurable?
+            const size_t linesMax = 100000;
+            const size_t prefixWidth = 32;
+
             class SizeWidget : public UI::Widget
             {
                 DJV_NON_COPYABLE(SizeWidget);
@@ -86,17 +100,361 @@ namespace djv
                 const float s = style->getMetric(UI::MetricsRole::Dialog);
                 _setMinimumSize(glm::vec2(s * 2.F, s));
             }
-        
+
+            //! This class provides a view of the log lines. The lines are kept
+            //! in a bounded buffer, and only the visible lines have glyphs
+            //! requested and drawn.
+            class LogView : public UI::Widget
+            {
+                DJV_NON_COPYABLE(LogView);
+
+            protected:
+                void _init(const std::shared_ptr<Context>&);
+                LogView();
+
+            public:
+                static std::shared_ptr<LogView> create(const std::shared_ptr<Context>&);
+
+                void appendMessages(const std::vector<LogMessage>&);
+                void clearMessages();
+
+                void setLevelFilter(LogLevel);
+                void setPrefixFilter(const std::string&);
+
+                //! Get the text of the lines that pass the filters.
+                std::string getText() const;
+
+                float getHeightForWidth(float) const override;
+
+            protected:
+                void _preLayoutEvent(Event::PreLayout&) override;
+                void _clipEvent(Event::Clip&) override;
+                void _paintEvent(Event::Paint&) override;
+
+                void _initEvent(Event::Init&) override;
+                void _updateEvent(Event::Update&) override;
+
+            private:
+                struct Line
+                {
+                    LogLevel    level = LogLevel::Information;
+                    std::string prefix;
+                    std::string text;
+                };
+
+                bool _isFiltered(const Line&) const;
+                void _filterUpdate();
+                void _visibleUpdate();
+                void _textUpdate();
+
+                std::shared_ptr<AV::Font::System> _fontSystem;
+                std::deque<Line> _lines;
+                size_t _linesBegin = 0;
+                std::deque<size_t> _filtered;
+                LogLevel _levelFilter = LogLevel::Information;
+                std::string _prefixFilter;
+                AV::Font::Info _fontInfo;
+                AV::Font::Metrics _fontMetrics;
+                std::future<AV::Font::Metrics> _fontMetricsFuture;
+                BBox2f _clipRect = BBox2f(0.F, 0.F, 0.F, 0.F);
+                size_t _visibleBegin = 0;
+                size_t _visibleEnd = 0;
+                std::map<size_t, std::vector<std::shared_ptr<AV::Font::Glyph> > > _glyphs;
+                std::map<size_t, std::future<std::vector<std::shared_ptr<AV::Font::Glyph> > > > _glyphsFutures;
+                std::time_t _time = 0;
+                std::string _timeString;
+            };
+
+            void LogView::_init(const std::shared_ptr<Context>& context)
+            {
+                Widget::_init(context);
+                setClassName("djv::ViewApp::LogView");
+                _fontSystem = context->getSystemT<AV::Font::System>();
+            }
+
+            LogView::LogView()
+            {}
+
+            std::shared_ptr<LogView> LogView::create(const std::shared_ptr<Context>& context)
+            {
+                auto out = std::shared_ptr<LogView>(new LogView);
+                out->_init(context);
+                return out;
+            }
+
+            void LogView::appendMessages(const std::vector<LogMessage>& value)
+            {
+                for (const auto& message : value)
+                {
+                    if (message.time != _time || _timeString.empty())
+                    {
+                        std::tm tm;
+                        Time::localtime(&message.time, &tm);
+                        std::stringstream ss;
+                        ss << std::put_time(&tm, "%c") << " ";
+                        _time = message.time;
+                        _timeString = ss.str();
+                    }
+                    size_t pos = 0;
+                    do
+                    {
+                        size_t end = message.text.find('\n', pos);
+                        if (std::string::npos == end)
+                        {
+                            end = message.text.size();
+                        }
+                        Line line;
+                        line.level = message.level;
+                        line.prefix = message.prefix;
+                        line.text = _timeString;
+                        if (message.prefix.size() < prefixWidth)
+                        {
+                            line.text.append(prefixWidth - message.prefix.size(), ' ');
+                        }
+                        line.text.append(message.prefix);
+                        line.text.append(" | ");
+                        switch (message.level)
+                        {
+                        case LogLevel::Warning: line.text.append("[Warning] "); break;
+                        case LogLevel::Error:   line.text.append("[ERROR] ");   break;
+                        default: break;
+                        }
+                        line.text.append(message.text, pos, end - pos);
+                        if (_isFiltered(line))
+                        {
+                            _filtered.push_back(_linesBegin + _lines.size());
+                        }
+                        _lines.push_back(std::move(line));
+                        pos = end + 1;
+                    } while (pos < message.text.size());
+                }
+                while (_lines.size() > linesMax)
+                {
+                    _lines.pop_front();
+                    ++_linesBegin;
+                }
+                while (_filtered.size() && _filtered.front() < _linesBegin)
+                {
+                    _filtered.pop_front();
+                }
+                if (value.size())
+                {
+                    _visibleUpdate();
+                    _resize();
+                }
+            }
+
+            void LogView::clearMessages()
+            {
+                _linesBegin += _lines.size();
+                _lines.clear();
+                _filtered.clear();
+                _visibleUpdate();
+                _resize();
+            }
+
+            void LogView::setLevelFilter(LogLevel value)
+            {
+                if (value == _levelFilter)
+                    return;
+                _levelFilter = value;
+                _filterUpdate();
+            }
+
+            void LogView::setPrefixFilter(const std::string& value)
+            {
+                if (value == _prefixFilter)
+                    return;
+                _prefixFilter = value;
+                _filterUpdate();
+            }
+
+            std::string LogView::getText() const
+            {
+                std::vector<std::string> lines;
+                for (const auto i : _filtered)
+                {
+                    lines.push_back(_lines[i - _linesBegin].text);
+                }
+                return String::join(lines, '\n');
+            }
+
+            float LogView::getHeightForWidth(float) const
+            {
+                const auto& style = _getStyle();
+                return static_cast<float>(_filtered.size() * _fontMetrics.lineHeight) + getMargin().getHeight(style);
+            }
+
+            void LogView::_preLayoutEvent(Event::PreLayout&)
+            {
+                const auto& style = _getStyle();
+                _setMinimumSize(glm::vec2(
+                    style->getMetric(UI::MetricsRole::TextColumn),
+                    static_cast<float>(_filtered.size() * _fontMetrics.lineHeight)) + getMargin().getSize(style));
+            }
+
+            void LogView::_clipEvent(Event::Clip& event)
+            {
+                _clipRect = event.getClipRect();
+                _visibleUpdate();
+            }
+
+            void LogView::_paintEvent(Event::Paint& event)
+            {
+                Widget::_paintEvent(event);
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                auto render = _getRender();
+                render->setCurrentFont(_fontInfo);
+                render->setFillColor(style->getColor(UI::ColorRole::Foreground));
+                for (size_t i = _visibleBegin; i < _visibleEnd; ++i)
+                {
+                    const auto j = _glyphs.find(_filtered[i]);
+                    if (j != _glyphs.end())
+                    {
+                        const float y = g.min.y + i * _fontMetrics.lineHeight;
+                        render->drawText(
+                            j->second,
+                            glm::vec2(floorf(g.min.x), floorf(y + _fontMetrics.ascender - 1.F)));
+                    }
+                }
+            }
+
+            void LogView::_initEvent(Event::Init& event)
+            {
+                Widget::_initEvent(event);
+                _textUpdate();
+            }
+
+            void LogView::_updateEvent(Event::Update& event)
+            {
+                Widget::_updateEvent(event);
+                if (_fontMetricsFuture.valid() &&
+                    _fontMetricsFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    try
+                    {
+                        _fontMetrics = _fontMetricsFuture.get();
+                        _resize();
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _log(e.what(), LogLevel::Error);
+                    }
+                }
+                bool redraw = false;
+                auto i = _glyphsFutures.begin();
+                while (i != _glyphsFutures.end())
+                {
+                    if (i->second.valid() &&
+                        i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        try
+                        {
+                            _glyphs[i->first] = i->second.get();
+                            redraw = true;
+                        }
+                        catch (const std::exception& e)
+                        {
+                            _log(e.what(), LogLevel::Error);
+                        }
+                        i = _glyphsFutures.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+                if (redraw)
+                {
+                    _redraw();
+                }
+            }
+
+            bool LogView::_isFiltered(const Line& value) const
+            {
+                return value.level >= _levelFilter &&
+                    (_prefixFilter.empty() || value.prefix.find(_prefixFilter) != std::string::npos);
+            }
+
+            void LogView::_filterUpdate()
+            {
+                _filtered.clear();
+                for (size_t i = 0; i < _lines.size(); ++i)
+                {
+                    if (_isFiltered(_lines[i]))
+                    {
+                        _filtered.push_back(_linesBegin + i);
+                    }
+                }
+                _visibleUpdate();
+                _resize();
+            }
+
+            void LogView::_visibleUpdate()
+            {
+                // Find the range of lines that intersect the clipping rectangle.
+                const auto& style = _getStyle();
+                const BBox2f& g = getMargin().bbox(getGeometry(), style);
+                const float lineHeight = _fontMetrics.lineHeight;
+                _visibleBegin = 0;
+                _visibleEnd = 0;
+                if (lineHeight > 0.F && _clipRect.isValid() && _clipRect.h() > 0.F)
+                {
+                    const float begin = std::max(0.F, floorf((_clipRect.min.y - g.min.y) / lineHeight));
+                    const float end = std::max(0.F, ceilf((_clipRect.max.y - g.min.y) / lineHeight));
+                    _visibleBegin = std::min(static_cast<size_t>(begin), _filtered.size());
+                    _visibleEnd = std::min(static_cast<size_t>(end), _filtered.size());
+                }
+
+                // Release the glyphs for lines that are no longer visible, and
+                // request the glyphs for lines that have become visible.
+                const size_t seqBegin = _visibleBegin < _visibleEnd ? _filtered[_visibleBegin] : 0;
+                const size_t seqEnd = _visibleBegin < _visibleEnd ? _filtered[_visibleEnd - 1] + 1 : 0;
+                for (auto i = _glyphs.begin(); i != _glyphs.end();)
+                {
+                    i = i->first < seqBegin || i->first >= seqEnd ? _glyphs.erase(i) : ++i;
+                }
+                for (auto i = _glyphsFutures.begin(); i != _glyphsFutures.end();)
+                {
+                    i = i->first < seqBegin || i->first >= seqEnd ? _glyphsFutures.erase(i) : ++i;
+                }
+                for (size_t i = _visibleBegin; i < _visibleEnd; ++i)
+                {
+                    const size_t seq = _filtered[i];
+                    if (_glyphs.find(seq) == _glyphs.end() &&
+                        _glyphsFutures.find(seq) == _glyphsFutures.end())
+                    {
+                        _glyphsFutures[seq] = _fontSystem->getGlyphs(_lines[seq - _linesBegin].text, _fontInfo);
+                    }
+                }
+            }
+
+            void LogView::_textUpdate()
+            {
+                const auto& style = _getStyle();
+                _fontInfo = style->getFontInfo(AV::Font::familyMono, AV::Font::faceDefault, UI::MetricsRole::FontSmall);
+                _fontMetricsFuture = _fontSystem->getMetrics(_fontInfo);
+                _glyphs.clear();
+                _glyphsFutures.clear();
+                _resize();
+            }
+
         } // namespace
 
         struct SystemLogWidget::Private
         {
-            std::vector<std::string> log;
-            bool shown = false;
-            std::shared_ptr<UI::TextBlock> textBlock;
+            std::shared_ptr<LogSystem> logSystem;
+            size_t historyPos = 0;
+            std::shared_ptr<LogView> logView;
+            std::shared_ptr<UI::ComboBox> levelComboBox;
+            std::shared_ptr<UI::SearchBox> searchBox;
             std::shared_ptr<UI::PushButton> copyButton;
             std::shared_ptr<UI::PushButton> reloadButton;
             std::shared_ptr<UI::PushButton> clearButton;
+            std::shared_ptr<Time::Timer> timer;
+
+            void historyUpdate();
         };
 
         void SystemLogWidget::_init(const std::shared_ptr<Core::Context>& context)
@@ -106,15 +464,18 @@ namespace djv
             DJV_PRIVATE_PTR();
             setClassName("djv::ViewApp::SystemLogWidget");
 
-            p.textBlock = UI::TextBlock::create(context);
-            p.textBlock->setFontFamily(AV::Font::familyMono);
-            p.textBlock->setFontSizeRole(UI::MetricsRole::FontSmall);
-            p.textBlock->setMargin(UI::Layout::Margin(UI::MetricsRole::Margin));
+            p.logSystem = context->getSystemT<LogSystem>();
+
+            p.logView = LogView::create(context);
+            p.logView->setMargin(UI::Layout::Margin(UI::MetricsRole::Margin));
 
             auto scrollWidget = UI::ScrollWidget::create(UI::ScrollType::Vertical, context);
             scrollWidget->setBorder(false);
             scrollWidget->setShadowOverlay({ UI::Side::Top });
-            scrollWidget->addChild(p.textBlock);
+            scrollWidget->addChild(p.logView);
+
+            p.levelComboBox = UI::ComboBox::create(context);
+            p.searchBox = UI::SearchBox::create(context);
 
             p.copyButton = UI::PushButton::create(context);
             p.reloadButton = UI::PushButton::create(context);
@@ -128,6 +489,8 @@ namespace djv
             auto hLayout = UI::HorizontalLayout::create(context);
             hLayout->setMargin(UI::Layout::Margin(UI::MetricsRole::MarginSmall));
             hLayout->setSpacing(UI::Layout::Spacing(UI::MetricsRole::SpacingSmall));
+            hLayout->addChild(p.levelComboBox);
+            hLayout->addChild(p.searchBox);
             hLayout->addExpander();
             hLayout->addChild(p.copyButton);
             hLayout->addChild(p.reloadButton);
@@ -140,6 +503,24 @@ namespace djv
             addChild(stackLayout);
 
             auto weak = std::weak_ptr<SystemLogWidget>(std::dynamic_pointer_cast<SystemLogWidget>(shared_from_this()));
+            p.levelComboBox->setCallback(
+                [weak](int value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->logView->setLevelFilter(static_cast<LogLevel>(value));
+                    }
+                });
+
+            p.searchBox->setFilterCallback(
+                [weak](const std::string& value)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->logView->setPrefixFilter(value);
+                    }
+                });
+
             auto contextWeak = std::weak_ptr<Context>(context);
             p.copyButton->setClickedCallback(
                 [weak, contextWeak]
@@ -149,7 +530,7 @@ namespace djv
                         if (auto widget = weak.lock())
                         {
                             auto eventSystem = context->getSystemT<UI::EventSystem>();
-                            eventSystem->setClipboard(String::join(widget->_p->log, '\n'));
+                            eventSystem->setClipboard(widget->_p->logView->getText());
                         }
                     }
                 });
@@ -169,6 +550,18 @@ namespace djv
                     widget->clearLog();
                 }
             });
+
+            p.timer = Time::Timer::create(context);
+            p.timer->setRepeating(true);
+            p.timer->start(
+                Time::getMilliseconds(Time::TimerValue::Medium),
+                [weak](float)
+                {
+                    if (auto widget = weak.lock())
+                    {
+                        widget->_p->historyUpdate();
+                    }
+                });
         }
 
         SystemLogWidget::SystemLogWidget() :
@@ -188,23 +581,14 @@ namespace djv
         void SystemLogWidget::reloadLog()
         {
             DJV_PRIVATE_PTR();
-            try
-            {
-                p.log = FileSystem::FileIO::readLines(std::string(
-                    _getResourceSystem()->getPath(FileSystem::ResourcePath::LogFile)));
-                p.textBlock->setText(String::join(p.log, '\n'));
-            }
-            catch (const std::exception & e)
-            {
-                _log(e.what(), LogLevel::Error);
-            }
+            p.logView->clearMessages();
+            p.historyPos = 0;
+            p.historyUpdate();
         }
 
         void SystemLogWidget::clearLog()
         {
-            DJV_PRIVATE_PTR();
-            p.log.clear();
-            p.textBlock->setText(std::string());
+            _p->logView->clearMessages();
         }
 
         void SystemLogWidget::_initEvent(Event::Init & event)
@@ -212,6 +596,16 @@ namespace djv
             MDIWidget::_initEvent(event);
             DJV_PRIVATE_PTR();
             setTitle(_getText(DJV_TEXT("System Log")));
+            const int level = p.levelComboBox->getCurrentItem();
+            p.levelComboBox->setItems(
+                {
+                    _getText(DJV_TEXT("All messages")),
+                    _getText(DJV_TEXT("Warnings and errors")),
+                    _getText(DJV_TEXT("Errors"))
+                });
+            p.levelComboBox->setCurrentItem(std::max(level, 0));
+            p.levelComboBox->setTooltip(_getText(DJV_TEXT("System log level tooltip")));
+            p.searchBox->setTooltip(_getText(DJV_TEXT("System log search tooltip")));
             p.copyButton->setText(_getText(DJV_TEXT("Copy")));
             p.copyButton->setTooltip(_getText(DJV_TEXT("System log copy tooltip")));
             p.reloadButton->setText(_getText(DJV_TEXT("Reload")));
@@ -220,6 +614,10 @@ namespace djv
             p.clearButton->setTooltip(_getText(DJV_TEXT("System log clear tooltip")));
         }
 
+        void SystemLogWidget::Private::historyUpdate()
+        {
+            logView->appendMessages(logSystem->getHistory(historyPos));
+        }
+
     } // namespace ViewApp
 } // namespace djv
-
@@ -420,7 +420,7 @@ namespace djv
                     color = style->getColor(UI::ColorRole::Checked);
                     render->setFillColor(color);
                     boxes.clear();
-                    for (const auto& i : p.cacheSequence.ranges)
+                    for (const auto& i : p.cacheSequence.getRanges())
                     {
                         const float x0 = _frameToPos(i.min);
                         const float x1 = _frameToPos(i.max + 1);
@@ -434,7 +434,7 @@ namespace djv
                     color = style->getColor(UI::ColorRole::Cached);
                     render->setFillColor(color);
                     boxes.clear();
-                    for (const auto& i : p.cachedFrames.ranges)
+                    for (const auto& i : p.cachedFrames.getRanges())
                     {
                         const float x0 = _frameToPos(i.min);
                         const float x1 = _frameToPos(i.max + 1);
@@ -742,10 +742,10 @@ namespace djv
                     break;
                 case AV::TimeUnits::Frames:
                 {
-                    const size_t rangesSize = p.sequence.ranges.size();
+                    const size_t rangesSize = p.sequence.getRanges().size();
                     if (rangesSize > 0)
                     {
-                        maxFrameText = std::string(Math::getNumDigits(p.sequence.ranges[rangesSize - 1].max), '0');
+                        maxFrameText = std::string(Math::getNumDigits(p.sequence.getRanges()[rangesSize - 1].max), '0');
                     }
                     break;
                 }
@@ -47,6 +47,7 @@ using namespace djv;
 
 const size_t drawCount = 10000;
 const size_t randomCount = 1000;
+const float statsTime = 5.f;
 AV::Image::Size windowSize;
 
 struct RandomColor
@@ -203,18 +204,38 @@ std::shared_ptr<Application> Application::create(int argc, char ** argv)
 
 int Application::run()
 {
+    // Alternate between batched and unbatched rendering every few seconds
+    // to compare them.
     auto time = std::chrono::system_clock::now();
+    size_t frames = 0;
+    size_t draws = 0;
+    size_t stateChanges = 0;
     while (!glfwWindowShouldClose(_glfwWindow))
     {
         glfwPollEvents();
         _render();
         glfwSwapBuffers(_glfwWindow);
         //glFlush();
+        ++frames;
+        draws += _render2D->getDrawCount();
+        stateChanges += _render2D->getStateChangeCount();
         auto now = std::chrono::system_clock::now();
         std::chrono::duration<float> delta = now - time;
-        time = now;
         const float dt = delta.count();
-        std::cout << "FPS: " << (dt > 0.f ? 1.f / dt : 0.f) << std::endl;
+        if (dt >= statsTime)
+        {
+            std::cout << "Batching: " << (_render2D->isBatchingEnabled() ? "on" : "off") <<
+                ", FPS: " << frames / dt <<
+                ", primitives/frame: " << _render2D->getPrimitiveCount() <<
+                ", draws/frame: " << draws / frames <<
+                ", state changes/frame: " << stateChanges / frames <<
+                ", draws/sec: " << draws / dt << std::endl;
+            _render2D->setBatchingEnabled(!_render2D->isBatchingEnabled());
+            time = now;
+            frames = 0;
+            draws = 0;
+            stateChanges = 0;
+        }
     }
     return 0;
 }
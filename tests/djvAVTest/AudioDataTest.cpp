@@ -31,6 +31,9 @@
 
 #include <djvAV/AudioData.h>
 
+#include <chrono>
+#include <cmath>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -47,6 +50,10 @@ namespace djv
             _info();
             _data();
             _util();
+            _convert();
+            _planar();
+            _volume();
+            _downmix();
             _operators();
         }
 
@@ -140,6 +147,347 @@ namespace djv
             }
         }
         
+        void AudioDataTest::_convert()
+        {
+            {
+                // Compare the conversions with the scalar functions, the sample
+                // count is not a multiple of the vector size to test the
+                // remainder.
+                const Audio::Info info(1, Audio::Type::F32, 44100, 1001);
+                auto data = Audio::Data::create(info);
+                auto p = reinterpret_cast<Audio::F32_T*>(data->getData());
+                for (size_t i = 0; i < info.sampleCount; ++i)
+                {
+                    p[i] = -1.25F + 2.5F * i / static_cast<float>(info.sampleCount - 1);
+                }
+                auto s16 = Audio::Data::convert(data, Audio::Type::S16);
+                auto s32 = Audio::Data::convert(data, Audio::Type::S32);
+                auto f64 = Audio::Data::convert(data, Audio::Type::F64);
+                auto s16P = reinterpret_cast<const Audio::S16_T*>(s16->getData());
+                auto s32P = reinterpret_cast<const Audio::S32_T*>(s32->getData());
+                auto f64P = reinterpret_cast<const Audio::F64_T*>(f64->getData());
+                for (size_t i = 0; i < info.sampleCount; ++i)
+                {
+                    Audio::S16_T s16V = 0;
+                    Audio::F32ToS16(p[i], s16V);
+                    DJV_ASSERT(s16V == s16P[i]);
+                    Audio::S32_T s32V = 0;
+                    Audio::F32ToS32(p[i], s32V);
+                    DJV_ASSERT(s32V == s32P[i]);
+                    DJV_ASSERT(static_cast<Audio::F64_T>(p[i]) == f64P[i]);
+                }
+                DJV_ASSERT(Audio::S16Range.max == s16P[info.sampleCount - 1]);
+                DJV_ASSERT(Audio::S16Range.min == s16P[0]);
+                DJV_ASSERT(Audio::S32Range.max == s32P[info.sampleCount - 1]);
+                DJV_ASSERT(Audio::S32Range.min == s32P[0]);
+
+                auto f32 = Audio::Data::create(info);
+                Audio::Data::convert(*s16, *f32);
+                auto f32P = reinterpret_cast<const Audio::F32_T*>(f32->getData());
+                for (size_t i = 0; i < info.sampleCount; ++i)
+                {
+                    Audio::F32_T v = 0.F;
+                    Audio::S16ToF32(s16P[i], v);
+                    DJV_ASSERT(v == f32P[i]);
+                }
+                Audio::Data::convert(*s32, *f32);
+                for (size_t i = 0; i < info.sampleCount; ++i)
+                {
+                    Audio::F32_T v = 0.F;
+                    Audio::S32ToF32(s32P[i], v);
+                    DJV_ASSERT(v == f32P[i]);
+                }
+                Audio::Data::convert(*f64, *f32);
+                DJV_ASSERT(*data == *f32);
+            }
+
+            for (auto i : Audio::getTypeEnums())
+            {
+                for (auto j : Audio::getTypeEnums())
+                {
+                    // Convert to another type and back.
+                    const Audio::Info info(2, i, 44100, 101);
+                    auto data = Audio::Data::create(info);
+                    data->zero();
+                    auto data2 = Audio::Data::create(Audio::Info(2, j, 44100, 101));
+                    Audio::Data::convert(*data, *data2);
+                    auto data3 = Audio::Data::create(info);
+                    Audio::Data::convert(*data2, *data3);
+                    DJV_ASSERT(*data == *data3);
+                }
+            }
+
+            {
+                const Audio::Info info(2, Audio::Type::S16, 48000, 48000 * 10);
+                auto data = Audio::Data::create(info);
+                data->zero();
+                auto data2 = Audio::Data::create(Audio::Info(2, Audio::Type::F32, 48000, 48000 * 10));
+                auto t0 = std::chrono::steady_clock::now();
+                Audio::Data::convert(*data, *data2);
+                Audio::Data::convert(*data2, *data);
+                auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> dt = t1 - t0;
+                std::stringstream ss;
+                ss << "convert S16/F32 10 seconds: " << dt.count() * 1000.F << "ms";
+                _print(ss.str());
+            }
+        }
+
+        void AudioDataTest::_planar()
+        {
+            for (auto i : Audio::getTypeEnums())
+            {
+                for (uint8_t channelCount : { 1, 2, 3, 6 })
+                {
+                    const Audio::Info info(channelCount, i, 44100, 101);
+                    auto data = Audio::Data::create(info);
+                    for (size_t j = 0; j < data->getByteCount(); ++j)
+                    {
+                        data->getData()[j] = static_cast<uint8_t>(j * 7);
+                    }
+                    auto data2 = Audio::Data::planarInterleave(data);
+                    DJV_ASSERT(data->getInfo() == data2->getInfo());
+                    auto data3 = Audio::Data::create(info);
+                    Audio::Data::planarDeinterleave(*data2, *data3);
+                    DJV_ASSERT(*data == *data3);
+
+                    // The first channel of the interleaved data.
+                    const size_t byteCount = Audio::getByteCount(i);
+                    for (size_t k = 0; byteCount > 0 && k < info.sampleCount; ++k)
+                    {
+                        DJV_ASSERT(0 == memcmp(
+                            data->getData() + k * byteCount,
+                            data2->getData() + k * channelCount * byteCount,
+                            byteCount));
+                    }
+                }
+            }
+
+            {
+                const Audio::S16_T l[] = { 1, 2, 3 };
+                const Audio::S16_T r[] = { -1, -2, -3 };
+                const Audio::S16_T* in[] = { l, r };
+                Audio::S16_T out[6];
+                Audio::Data::planarInterleave(in, out, 3, 2);
+                DJV_ASSERT(1 == out[0] && -1 == out[1] && 3 == out[4] && -3 == out[5]);
+                Audio::S16_T l2[3];
+                Audio::S16_T r2[3];
+                Audio::S16_T* out2[] = { l2, r2 };
+                Audio::Data::planarDeinterleave(out, out2, 3, 2);
+                DJV_ASSERT(0 == memcmp(l, l2, sizeof(l)));
+                DJV_ASSERT(0 == memcmp(r, r2, sizeof(r)));
+            }
+
+            {
+                const Audio::Info info(2, Audio::Type::F32, 48000, 48000 * 10);
+                auto data = Audio::Data::create(info);
+                data->zero();
+                auto data2 = Audio::Data::create(info);
+                auto t0 = std::chrono::steady_clock::now();
+                Audio::Data::planarInterleave(*data, *data2);
+                Audio::Data::planarDeinterleave(*data2, *data);
+                auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> dt = t1 - t0;
+                std::stringstream ss;
+                ss << "planar F32 10 seconds: " << dt.count() * 1000.F << "ms";
+                _print(ss.str());
+            }
+        }
+
+        void AudioDataTest::_volume()
+        {
+            {
+                const Audio::Info info(2, Audio::Type::S16, 44100, 11);
+                auto data = Audio::Data::create(info);
+                auto p = reinterpret_cast<Audio::S16_T*>(data->getData());
+                for (size_t i = 0; i < info.sampleCount * info.channelCount; ++i)
+                {
+                    p[i] = i % 2 ? Audio::S16Range.max : Audio::S16Range.min;
+                }
+                Audio::Data::volume(data->getData(), data->getData(), .5F, info.sampleCount, info.channelCount, info.type);
+                DJV_ASSERT(-16384 == p[0]);
+                DJV_ASSERT(16383 == p[1]);
+                Audio::Data::volume(data->getData(), data->getData(), 4.F, info.sampleCount, info.channelCount, info.type);
+                DJV_ASSERT(Audio::S16Range.min == p[20]);
+                DJV_ASSERT(Audio::S16Range.max == p[21]);
+            }
+
+            {
+                const Audio::Info info(1, Audio::Type::S32, 44100, 9);
+                auto data = Audio::Data::create(info);
+                auto p = reinterpret_cast<Audio::S32_T*>(data->getData());
+                for (size_t i = 0; i < info.sampleCount; ++i)
+                {
+                    p[i] = i % 2 ? Audio::S32Range.max : Audio::S32Range.min;
+                }
+                Audio::Data::volume(data->getData(), data->getData(), 2.F, info.sampleCount, info.channelCount, info.type);
+                for (size_t i = 0; i < info.sampleCount; ++i)
+                {
+                    DJV_ASSERT((i % 2 ? Audio::S32Range.max : Audio::S32Range.min) == p[i]);
+                }
+            }
+
+            {
+                const Audio::Info info(2, Audio::Type::F32, 44100, 4);
+                auto data = Audio::Data::create(info);
+                auto p = reinterpret_cast<Audio::F32_T*>(data->getData());
+                for (size_t i = 0; i < info.sampleCount * info.channelCount; ++i)
+                {
+                    p[i] = 1.F;
+                }
+                Audio::Data::volume(data->getData(), data->getData(), 0.F, 1.F, info.sampleCount, info.channelCount, info.type);
+                const float values[] = { 0.F, 0.F, .25F, .25F, .5F, .5F, .75F, .75F };
+                for (size_t i = 0; i < info.sampleCount * info.channelCount; ++i)
+                {
+                    DJV_ASSERT(values[i] == p[i]);
+                }
+            }
+
+            for (auto i : Audio::getTypeEnums())
+            {
+                // The ramp and the constant volume should give the same
+                // results when the start and end values are the same.
+                const Audio::Info info(2, i, 44100, 101);
+                auto data = Audio::Data::create(info);
+                for (size_t j = 0; j < data->getByteCount(); ++j)
+                {
+                    data->getData()[j] = static_cast<uint8_t>(j * 13);
+                }
+                if (Audio::Type::F32 == i || Audio::Type::F64 == i)
+                {
+                    data = Audio::Data::convert(Audio::Data::convert(data, Audio::Type::S16), i);
+                }
+                auto data2 = Audio::Data::create(info);
+                auto data3 = Audio::Data::create(info);
+                Audio::Data::volume(data->getData(), data2->getData(), .5F, info.sampleCount, info.channelCount, info.type);
+                Audio::Data::volume(data->getData(), data3->getData(), .5F, .5F, info.sampleCount, info.channelCount, info.type);
+                DJV_ASSERT(*data2 == *data3);
+            }
+
+            {
+                const Audio::Info info(2, Audio::Type::F32, 48000, 48000 * 10);
+                auto data = Audio::Data::create(info);
+                data->zero();
+                auto t0 = std::chrono::steady_clock::now();
+                Audio::Data::volume(data->getData(), data->getData(), .5F, info.sampleCount, info.channelCount, info.type);
+                auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> dt = t1 - t0;
+                std::stringstream ss;
+                ss << "volume F32 10 seconds: " << dt.count() * 1000.F << "ms";
+                _print(ss.str());
+            }
+        }
+
+        void AudioDataTest::_downmix()
+        {
+            {
+                const auto matrix = Audio::Data::getDownmixMatrix(2, 2);
+                DJV_ASSERT(4 == matrix.size());
+                DJV_ASSERT(1.F == matrix[0] && 0.F == matrix[1] && 0.F == matrix[2] && 1.F == matrix[3]);
+            }
+
+            {
+                const auto matrix = Audio::Data::getDownmixMatrix(2, 1);
+                DJV_ASSERT(2 == matrix.size());
+                DJV_ASSERT(.5F == matrix[0] && .5F == matrix[1]);
+            }
+
+            for (uint8_t inChannelCount = 3; inChannelCount <= 8; ++inChannelCount)
+            {
+                for (uint8_t outChannelCount : { 1, 2 })
+                {
+                    const auto matrix = Audio::Data::getDownmixMatrix(inChannelCount, outChannelCount);
+                    DJV_ASSERT(inChannelCount * outChannelCount == matrix.size());
+                    for (uint8_t i = 0; i < outChannelCount; ++i)
+                    {
+                        float sum = 0.F;
+                        for (uint8_t j = 0; j < inChannelCount; ++j)
+                        {
+                            sum += matrix[i * inChannelCount + j];
+                        }
+                        DJV_ASSERT(sum <= 1.F + .0001F);
+                    }
+                    if (inChannelCount > 3)
+                    {
+                        // The LFE channel is dropped.
+                        for (uint8_t i = 0; i < outChannelCount; ++i)
+                        {
+                            DJV_ASSERT(0.F == matrix[i * inChannelCount + 3]);
+                        }
+                    }
+                }
+            }
+
+            {
+                // Quad, the back channels are folded into the left and right.
+                const auto matrix = Audio::Data::getDownmixMatrix(4, 2, 0x33);
+                DJV_ASSERT(matrix[0] > 0.F && matrix[2] > 0.F && 0.F == matrix[3]);
+                DJV_ASSERT(matrix[4 + 1] > 0.F && 0.F == matrix[4 + 2] && matrix[4 + 3] > 0.F);
+            }
+
+            {
+                // 5.0, the fourth channel is the side left and not the LFE.
+                const auto matrix = Audio::Data::getDownmixMatrix(5, 2, 0x607);
+                DJV_ASSERT(matrix[2] > 0.F && matrix[3] > 0.F && 0.F == matrix[4]);
+                DJV_ASSERT(matrix[5 + 2] > 0.F && 0.F == matrix[5 + 3] && matrix[5 + 4] > 0.F);
+            }
+
+            {
+                // Without a mask only the front left and right are kept.
+                const auto matrix = Audio::Data::getDownmixMatrix(4, 2);
+                DJV_ASSERT(1.F == matrix[0] && 0.F == matrix[2] && 0.F == matrix[3]);
+                DJV_ASSERT(1.F == matrix[4 + 1] && 0.F == matrix[4 + 2] && 0.F == matrix[4 + 3]);
+            }
+
+            {
+                // A mask that does not match the channel count is ignored.
+                const auto matrix = Audio::Data::getDownmixMatrix(6, 2, 0x3);
+                DJV_ASSERT(0.F == matrix[3] && matrix[2] > 0.F && matrix[6 + 2] > 0.F);
+            }
+
+            {
+                const auto matrix = Audio::Data::getDownmixMatrix(6, 2);
+                const Audio::S16_T in[] = { 1000, -1000, 0, 32767, 0, 0 };
+                Audio::S16_T out[2] = { 0, 0 };
+                Audio::Data::downmix(
+                    reinterpret_cast<const uint8_t*>(in),
+                    reinterpret_cast<uint8_t*>(out),
+                    1,
+                    6,
+                    2,
+                    Audio::Type::S16,
+                    matrix.data());
+                DJV_ASSERT(out[0] > 0 && out[0] < 1000);
+                DJV_ASSERT(out[1] < 0 && out[1] > -1000);
+            }
+
+            for (auto i : Audio::getTypeEnums())
+            {
+                // Keep the first channels.
+                const Audio::Info info(3, i, 44100, 11);
+                auto data = Audio::Data::create(info);
+                for (size_t j = 0; j < data->getByteCount(); ++j)
+                {
+                    data->getData()[j] = static_cast<uint8_t>(j * 5);
+                }
+                if (Audio::Type::F32 == i || Audio::Type::F64 == i)
+                {
+                    data = Audio::Data::convert(Audio::Data::convert(data, Audio::Type::S16), i);
+                }
+                auto data2 = Audio::Data::create(Audio::Info(4, i, 44100, 11));
+                const auto matrix = Audio::Data::getDownmixMatrix(3, 4);
+                Audio::Data::downmix(data->getData(), data2->getData(), info.sampleCount, 3, 4, i, matrix.data());
+                const size_t byteCount = Audio::getByteCount(i);
+                for (size_t j = 0; byteCount > 0 && j < info.sampleCount; ++j)
+                {
+                    DJV_ASSERT(0 == memcmp(
+                        data->getData() + j * 3 * byteCount,
+                        data2->getData() + j * 4 * byteCount,
+                        3 * byteCount));
+                }
+            }
+        }
+
         void AudioDataTest::_operators()
         {
             {
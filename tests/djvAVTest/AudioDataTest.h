@@ -45,6 +45,10 @@ namespace djv
             void _info();
             void _data();
             void _util();
+            void _convert();
+            void _planar();
+            void _volume();
+            void _downmix();
             void _operators();
         };
         
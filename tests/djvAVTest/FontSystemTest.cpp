@@ -53,6 +53,7 @@ namespace djv
             _glyphInfo();
             _glyph();
             _system();
+            _throughput();
             _operators();
         }        
 
@@ -248,6 +249,47 @@ namespace djv
             }
         }
 
+        void FontSystemTest::_throughput()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto system = context->getSystemT<Font::System>();
+                {
+                    std::stringstream ss;
+                    ss << "thread count: " << system->getThreadCount();
+                    _print(ss.str());
+                }
+
+                const size_t requestCount = 1000;
+                std::vector<std::string> text;
+                for (size_t i = 0; i < requestCount; ++i)
+                {
+                    text.push_back(String::getRandomText(10));
+                }
+                const Font::Info info(1, 1, 14, dpiDefault);
+                for (size_t pass = 0; pass < 2; ++pass)
+                {
+                    // The second pass measures the memoized layouts.
+                    const auto start = std::chrono::steady_clock::now();
+                    std::vector<std::future<std::vector<Font::TextLine> > > futures;
+                    for (const auto& i : text)
+                    {
+                        futures.push_back(system->textLines(i, 100, info));
+                    }
+                    for (auto& i : futures)
+                    {
+                        i.get();
+                    }
+                    const auto end = std::chrono::steady_clock::now();
+                    const std::chrono::duration<float> delta = end - start;
+                    std::stringstream ss;
+                    ss << "text lines pass " << pass << ": " <<
+                        (delta.count() > 0.F ? (requestCount / delta.count()) : 0.F) << " requests/sec";
+                    _print(ss.str());
+                }
+            }
+        }
+
         void FontSystemTest::_operators()
         {
             {
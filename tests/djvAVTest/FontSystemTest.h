@@ -47,6 +47,7 @@ namespace djv
             void _glyphInfo();
             void _glyph();
             void _system();
+            void _throughput();
             void _operators();
         };
         
@@ -35,6 +35,9 @@
 #include <djvCore/String.h>
 #include <djvCore/Timer.h>
 
+#include <cstring>
+#include <thread>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -57,6 +60,7 @@ namespace djv
             _audioQueue();
             _cache();
             _io();
+            _sequenceWrite();
             _system();
             _operators();
         }
@@ -161,6 +165,7 @@ namespace djv
                 DJV_ASSERT(queue.isEmpty());
                 DJV_ASSERT(0 == queue.getCount());
                 DJV_ASSERT(IO::VideoFrame() == queue.getFrame());
+                DJV_ASSERT(IO::VideoFrame() == queue.getLastFrame());
                 DJV_ASSERT(!queue.isFinished());
             }
             
@@ -175,12 +180,52 @@ namespace djv
                 DJV_ASSERT(!queue.isEmpty());
                 DJV_ASSERT(3 == queue.getCount());
                 DJV_ASSERT(frame == queue.getFrame());
+                DJV_ASSERT(3 == queue.getLastFrame().frame);
                 DJV_ASSERT(frame == queue.popFrame());
                 queue.clearFrames();
                 DJV_ASSERT(queue.isEmpty());
                 queue.setFinished(true);
                 DJV_ASSERT(queue.isFinished());
             }
+
+            {
+                std::mutex mutex;
+                IO::VideoQueue queue;
+                queue.setMax(1);
+                size_t callbackCount = 0;
+                queue.setCallback(
+                    [&callbackCount]
+                    {
+                        ++callbackCount;
+                    });
+                std::chrono::steady_clock::time_point addTime;
+                std::thread thread(
+                    [&mutex, &queue, &addTime]
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        std::lock_guard<std::mutex> lock(mutex);
+                        addTime = std::chrono::steady_clock::now();
+                        queue.addFrame(IO::VideoFrame(1, nullptr));
+                    });
+                std::chrono::steady_clock::duration latency;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    DJV_ASSERT(queue.wait(
+                        lock,
+                        std::chrono::milliseconds(1000),
+                        [&queue]
+                        {
+                            return !queue.isEmpty();
+                        }));
+                    latency = std::chrono::steady_clock::now() - addTime;
+                }
+                thread.join();
+                DJV_ASSERT(1 == callbackCount);
+                std::stringstream ss;
+                ss << "video queue wake latency: " <<
+                    std::chrono::duration_cast<std::chrono::microseconds>(latency).count() << "us";
+                _print(ss.str());
+            }
         }
         
         void IOTest::_audioFrame()
@@ -226,6 +271,35 @@ namespace djv
                 queue.setFinished(true);
                 DJV_ASSERT(queue.isFinished());
             }
+
+            {
+                std::mutex mutex;
+                IO::AudioQueue queue;
+                bool callback = false;
+                queue.setCallback(
+                    [&callback]
+                    {
+                        callback = true;
+                    });
+                std::thread thread(
+                    [&mutex, &queue]
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        queue.setFinished(true);
+                    });
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    DJV_ASSERT(queue.wait(
+                        lock,
+                        std::chrono::milliseconds(1000),
+                        [&queue]
+                        {
+                            return queue.isFinished();
+                        }));
+                }
+                thread.join();
+                DJV_ASSERT(callback);
+            }
         }
         
         void IOTest::_cache()
@@ -380,6 +454,73 @@ namespace djv
             }
         }
         
+        void IOTest::_sequenceWrite()
+        {
+            if (auto context = getContext().lock())
+            {
+                // Write a sequence with several files in flight and check that
+                // each frame is written to the file with its frame number.
+                auto io = context->getSystemT<AV::IO::System>();
+                const Image::Info imageInfo(4, 4, Image::Type::RGB_U8);
+                const size_t frameCount = 8;
+                FileSystem::FileInfo fileInfo("IOTestSequence.1-8.ppm");
+                fileInfo.evalSequence();
+                DJV_ASSERT(fileInfo.isSequenceValid());
+                {
+                    IO::Info info;
+                    info.video.push_back(imageInfo);
+                    auto write = io->write(fileInfo, info);
+                    write->setThreadCount(4);
+                    {
+                        std::lock_guard<std::mutex> lock(write->getMutex());
+                        auto& writeQueue = write->getVideoQueue();
+                        for (size_t i = 0; i < frameCount; ++i)
+                        {
+                            auto image = Image::Image::create(imageInfo);
+                            memset(image->getData(), static_cast<int>(i * 10), image->getDataByteCount());
+                            writeQueue.addFrame(IO::VideoFrame(static_cast<Frame::Index>(i), image));
+                        }
+                        writeQueue.setFinished(true);
+                    }
+                    while (write->isRunning())
+                    {}
+                }
+
+                for (size_t i = 0; i < frameCount; ++i)
+                {
+                    std::stringstream ss;
+                    ss << "IOTestSequence." << (i + 1) << ".ppm";
+                    _print(ss.str());
+                    auto read = io->read(FileSystem::FileInfo(ss.str()));
+                    std::shared_ptr<Image::Image> image;
+                    bool running = true;
+                    while (running)
+                    {
+                        {
+                            std::lock_guard<std::mutex> lock(read->getMutex());
+                            auto& readQueue = read->getVideoQueue();
+                            if (!readQueue.isEmpty())
+                            {
+                                image = readQueue.popFrame().image;
+                                running = false;
+                            }
+                            else if (readQueue.isFinished())
+                            {
+                                running = false;
+                            }
+                        }
+                        if (running)
+                        {
+                            std::this_thread::sleep_for(Time::getMilliseconds(Time::TimerValue::Fast));
+                        }
+                    }
+                    DJV_ASSERT(image);
+                    DJV_ASSERT(imageInfo.size == image->getSize());
+                    DJV_ASSERT(static_cast<uint8_t>(i * 10) == image->getData()[0]);
+                }
+            }
+        }
+
         void IOTest::_system()
         {
             if (auto context = getContext().lock())
@@ -50,6 +50,7 @@ namespace djv
             void _audioQueue();
             void _cache();
             void _io();
+            void _sequenceWrite();
             void _system();
             void _operators();
         };
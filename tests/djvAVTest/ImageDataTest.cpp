@@ -109,6 +109,15 @@ namespace djv
                 const Image::Size size(1, 2);
                 DJV_ASSERT(.5F == size.getAspectRatio());
             }
+
+            {
+                const Image::Size size(100000, 70000);
+                DJV_ASSERT(100000 == size.w);
+                DJV_ASSERT(70000 == size.h);
+                const Image::Info info(size, Image::Type::RGBA_U8);
+                DJV_ASSERT(static_cast<size_t>(100000) * 4 == info.getScanlineByteCount());
+                DJV_ASSERT(static_cast<size_t>(100000) * 70000 * 4 == info.getDataByteCount());
+            }
         }
         
         void ImageDataTest::_info()
@@ -0,0 +1,296 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImageDiffTest.h>
+
+#include <djvAV/ImageDiff.h>
+
+#include <djvCore/Memory.h>
+
+#include <chrono>
+#include <cmath>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            std::shared_ptr<Image::Data> createDifference(const Image::Data& a, const Image::Data& b, size_t threadCount = 1)
+            {
+                auto out = Image::Data::create(Image::Info(a.getSize(), Image::getDifferenceType()));
+                Image::difference(a, b, *out, threadCount);
+                return out;
+            }
+
+            float getValue(const Image::Data& data, uint16_t x, uint16_t y, uint8_t channel)
+            {
+                return reinterpret_cast<const half*>(data.getData(x, y))[channel];
+            }
+
+        } // namespace
+
+        ImageDiffTest::ImageDiffTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageDiffTest", context)
+        {}
+        
+        void ImageDiffTest::run(const std::vector<std::string>& args)
+        {
+            _difference();
+            _relative();
+            _stats();
+            _layout();
+            _size();
+            _serialize();
+        }
+
+        void ImageDiffTest::_difference()
+        {
+            {
+                // Identical images have no difference.
+                const Image::Info info(300, 200, Image::Type::RGB_U16);
+                auto a = Image::Data::create(info);
+                uint8_t* p = a->getData();
+                for (size_t i = 0; i < info.getDataByteCount(); ++i)
+                {
+                    p[i] = static_cast<uint8_t>(i * 7);
+                }
+                auto out = createDifference(*a, *a, 4);
+                DJV_ASSERT(out->getSize() == info.size);
+                for (uint16_t y = 0; y < info.size.h; ++y)
+                {
+                    for (uint16_t x = 0; x < info.size.w; ++x)
+                    {
+                        DJV_ASSERT(0.F == getValue(*out, x, y, 0));
+                        DJV_ASSERT(0.F == getValue(*out, x, y, 2));
+                        DJV_ASSERT(1.F == getValue(*out, x, y, 3));
+                    }
+                }
+            }
+
+            {
+                // Images of different types are compared as floating point.
+                auto a = Image::Data::create(Image::Info(2, 1, Image::Type::L_U8));
+                a->getData(0, 0)[0] = 255;
+                a->getData(1, 0)[0] = 0;
+                auto b = Image::Data::create(Image::Info(2, 1, Image::Type::RGBA_F32));
+                float* bP = reinterpret_cast<float*>(b->getData());
+                const float values[] = { .75F, 1.F, 1.F, 1.F, .5F, .25F, 0.F, 1.F };
+                memcpy(bP, values, sizeof(values));
+                auto out = createDifference(*a, *b);
+                DJV_ASSERT(.25F == getValue(*out, 0, 0, 0));
+                DJV_ASSERT(0.F == getValue(*out, 0, 0, 1));
+                DJV_ASSERT(.5F == getValue(*out, 1, 0, 0));
+                DJV_ASSERT(.25F == getValue(*out, 1, 0, 1));
+                DJV_ASSERT(0.F == getValue(*out, 1, 0, 2));
+            }
+        }
+
+        void ImageDiffTest::_relative()
+        {
+            auto a = Image::Data::create(Image::Info(3, 1, Image::Type::RGB_F32));
+            const float aValues[] = { 1.F, .5F, 0.F, .25F, 0.F, -1.F, 2.F, 2.F, 2.F };
+            memcpy(a->getData(), aValues, sizeof(aValues));
+            auto b = Image::Data::create(Image::Info(3, 1, Image::Type::RGB_F32));
+            const float bValues[] = { .5F, .5F, 0.F, .5F, 1.F, 1.F, 1.F, 4.F, 2.F };
+            memcpy(b->getData(), bValues, sizeof(bValues));
+            auto out = Image::Data::create(Image::Info(a->getSize(), Image::getDifferenceType()));
+            Image::difference(*a, *b, *out, Image::DifferenceMode::Relative, nullptr);
+            DJV_ASSERT(.5F == getValue(*out, 0, 0, 0));
+            DJV_ASSERT(0.F == getValue(*out, 0, 0, 1));
+            DJV_ASSERT(0.F == getValue(*out, 0, 0, 2));
+            DJV_ASSERT(.5F == getValue(*out, 1, 0, 0));
+            DJV_ASSERT(1.F == getValue(*out, 1, 0, 1));
+            DJV_ASSERT(2.F == getValue(*out, 1, 0, 2));
+            DJV_ASSERT(.5F == getValue(*out, 2, 0, 0));
+            DJV_ASSERT(.5F == getValue(*out, 2, 0, 1));
+            DJV_ASSERT(0.F == getValue(*out, 2, 0, 2));
+            DJV_ASSERT(1.F == getValue(*out, 2, 0, 3));
+        }
+
+        void ImageDiffTest::_stats()
+        {
+            {
+                const Image::DifferenceStats stats;
+                DJV_ASSERT(0 == stats.pixelCount);
+                DJV_ASSERT(0.F == stats.getMaxError());
+                DJV_ASSERT(0.0 == stats.getMSE());
+            }
+
+            {
+                // Identical images have no error.
+                auto a = Image::Data::create(Image::Info(64, 32, Image::Type::RGBA_U8));
+                uint8_t* p = a->getData();
+                for (size_t i = 0; i < a->getDataByteCount(); ++i)
+                {
+                    p[i] = static_cast<uint8_t>(i * 3);
+                }
+                const auto stats = Image::getDifferenceStats(*a, *a);
+                DJV_ASSERT(64 * 32 == stats.pixelCount);
+                DJV_ASSERT(0.F == stats.getMaxError());
+                DJV_ASSERT(std::isinf(stats.getPSNR()));
+            }
+
+            {
+                // A constant error gives a known PSNR.
+                const Image::Info info(300, 200, Image::Type::RGBA_F32);
+                auto a = Image::Data::create(info);
+                auto b = Image::Data::create(info);
+                float* aP = reinterpret_cast<float*>(a->getData());
+                float* bP = reinterpret_cast<float*>(b->getData());
+                for (size_t i = 0; i < info.size.w * info.size.h; ++i, aP += 4, bP += 4)
+                {
+                    aP[0] = .5F;
+                    aP[1] = .5F;
+                    aP[2] = .5F;
+                    aP[3] = 1.F;
+                    bP[0] = .5F + .1F;
+                    bP[1] = .5F;
+                    bP[2] = .5F - .1F;
+                    bP[3] = .75F;
+                }
+                for (size_t threadCount : { 1, 3, 8 })
+                {
+                    const auto stats = Image::getDifferenceStats(*a, *b, threadCount);
+                    DJV_ASSERT(300 * 200 == stats.pixelCount);
+                    DJV_ASSERT(fabsf(stats.maxError[0] - .1F) < .00001F);
+                    DJV_ASSERT(0.F == stats.maxError[1]);
+                    DJV_ASSERT(fabsf(stats.maxError[2] - .1F) < .00001F);
+                    DJV_ASSERT(.25F == stats.maxError[3]);
+                    DJV_ASSERT(.25F == stats.getMaxError());
+                    DJV_ASSERT(fabs(stats.getPSNR(0) - 20.0) < .001);
+                    DJV_ASSERT(std::isinf(stats.getPSNR(1)));
+                    DJV_ASSERT(fabs(stats.getMSE() - .02 / 3.0) < .000001);
+                    DJV_ASSERT(fabs(stats.getPSNR() - -10.0 * log10(.02 / 3.0)) < .001);
+                }
+
+                auto out = Image::Data::create(Image::Info(info.size, Image::getDifferenceType()));
+                Image::DifferenceStats stats;
+                Image::difference(*a, *b, *out, Image::DifferenceMode::Absolute, &stats, 4);
+                DJV_ASSERT(300 * 200 == stats.pixelCount);
+                DJV_ASSERT(.25F == stats.getMaxError());
+            }
+
+            {
+                Image::DifferenceStats a;
+                a.pixelCount = 1;
+                a.maxError[0] = .5F;
+                a.squaredError[0] = .25;
+                Image::DifferenceStats b;
+                b.pixelCount = 3;
+                b.maxError[0] = .25F;
+                b.maxError[1] = 1.F;
+                b.squaredError[0] = .75;
+                a.add(b);
+                DJV_ASSERT(4 == a.pixelCount);
+                DJV_ASSERT(.5F == a.maxError[0]);
+                DJV_ASSERT(1.F == a.maxError[1]);
+                DJV_ASSERT(.25 == a.getMSE(0));
+            }
+
+            {
+                // Time the statistics of a large image.
+                const Image::Info info(4096, 2160, Image::Type::RGB_U16);
+                auto a = Image::Data::create(info);
+                auto b = Image::Data::create(info);
+                a->zero();
+                b->zero();
+                auto t0 = std::chrono::steady_clock::now();
+                Image::getDifferenceStats(*a, *b, 4);
+                auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> dt = t1 - t0;
+                std::stringstream ss;
+                ss << "RGB_U16 4096x2160: difference statistics " << dt.count() * 1000.F << "ms";
+                _print(ss.str());
+            }
+        }
+
+        void ImageDiffTest::_layout()
+        {
+            // Images are compared in their displayed orientation.
+            auto a = Image::Data::create(Image::Info(3, 2, Image::Type::L_U8));
+            a->zero();
+            a->getData(0, 0)[0] = 255;
+            const Memory::Endian endian = Memory::opposite(Memory::getEndian());
+            auto b = Image::Data::create(Image::Info(
+                Image::Size(3, 2),
+                Image::Type::L_U16,
+                Image::Layout(Image::Mirror(true, true), 1, endian)));
+            b->zero();
+            b->getData(2, 1)[0] = 255;
+            b->getData(2, 1)[1] = 255;
+            auto out = createDifference(*a, *b);
+            for (uint16_t y = 0; y < 2; ++y)
+            {
+                for (uint16_t x = 0; x < 3; ++x)
+                {
+                    DJV_ASSERT(0.F == getValue(*out, x, y, 0));
+                }
+            }
+        }
+
+        void ImageDiffTest::_size()
+        {
+            // Pixels outside of the second image are compared with zero.
+            auto a = Image::Data::create(Image::Info(4, 3, Image::Type::L_F32));
+            float* aP = reinterpret_cast<float*>(a->getData());
+            for (size_t i = 0; i < 12; ++i)
+            {
+                aP[i] = .5F;
+            }
+            auto b = Image::Data::create(Image::Info(2, 5, Image::Type::L_F32));
+            float* bP = reinterpret_cast<float*>(b->getData());
+            for (size_t i = 0; i < 10; ++i)
+            {
+                bP[i] = .5F;
+            }
+            auto out = createDifference(*a, *b);
+            DJV_ASSERT(out->getSize() == a->getSize());
+            DJV_ASSERT(0.F == getValue(*out, 1, 2, 0));
+            DJV_ASSERT(.5F == getValue(*out, 2, 0, 0));
+            DJV_ASSERT(.5F == getValue(*out, 3, 2, 0));
+        }
+
+        void ImageDiffTest::_serialize()
+        {
+            for (auto i : Image::getDifferenceModeEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                Image::DifferenceMode j = Image::DifferenceMode::First;
+                ss >> j;
+                DJV_ASSERT(i == j);
+            }
+        }
+
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,170 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImagePyramidTest.h>
+
+#include <djvAV/ImagePyramid.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            std::shared_ptr<Image::Image> createImage()
+            {
+                auto out = Image::Image::create(Image::Info(3000, 1000, Image::Type::L_U8));
+                for (uint32_t y = 0; y < out->getHeight(); ++y)
+                {
+                    uint8_t* p = out->getData(y);
+                    for (uint32_t x = 0; x < out->getWidth(); ++x, ++p)
+                    {
+                        *p = (x / 100 + y / 100) % 2 ? 255 : 0;
+                    }
+                }
+                return out;
+            }
+
+            std::shared_ptr<Image::Image> waitTile(
+                const std::shared_ptr<Image::Pyramid>& pyramid,
+                size_t level,
+                uint32_t x,
+                uint32_t y)
+            {
+                std::shared_ptr<Image::Image> out;
+                const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                while (!(out = pyramid->getTile(level, x, y)) && std::chrono::steady_clock::now() < timeout)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                return out;
+            }
+
+        } // namespace
+
+        ImagePyramidTest::ImagePyramidTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImagePyramidTest", context)
+        {}
+        
+        void ImagePyramidTest::run(const std::vector<std::string>& args)
+        {
+            _levels();
+            _tiles();
+            _cache();
+        }
+        
+        void ImagePyramidTest::_levels()
+        {
+            auto image = createImage();
+            auto pyramid = Image::Pyramid::create(image, 256);
+            DJV_ASSERT(image == pyramid->getImage());
+            DJV_ASSERT(256 == pyramid->getTileSize());
+            DJV_ASSERT(5 == pyramid->getLevelCount());
+            DJV_ASSERT(Image::Size(3000, 1000) == pyramid->getLevelSize(0));
+            DJV_ASSERT(Image::Size(1500, 500) == pyramid->getLevelSize(1));
+            DJV_ASSERT(Image::Size(188, 63) == pyramid->getLevelSize(4));
+            DJV_ASSERT(Image::Size(12, 4) == pyramid->getTileCount(0));
+            DJV_ASSERT(Image::Size(1, 1) == pyramid->getTileCount(4));
+            DJV_ASSERT(Image::Size() == pyramid->getTileCount(5));
+            DJV_ASSERT(0 == pyramid->getLevel(2.F));
+            DJV_ASSERT(0 == pyramid->getLevel(1.F));
+            DJV_ASSERT(1 == pyramid->getLevel(.5F));
+            DJV_ASSERT(1 == pyramid->getLevel(.3F));
+            DJV_ASSERT(4 == pyramid->getLevel(.01F));
+            for (size_t i = 0; i < pyramid->getLevelCount(); ++i)
+            {
+                std::stringstream ss;
+                ss << "level " << i << ": " << pyramid->getLevelSize(i) << ", tiles: " << pyramid->getTileCount(i);
+                _print(ss.str());
+            }
+        }
+        
+        void ImagePyramidTest::_tiles()
+        {
+            auto image = createImage();
+            auto pyramid = Image::Pyramid::create(image, 256);
+            DJV_ASSERT(!pyramid->getTile(0, 12, 0));
+            DJV_ASSERT(!pyramid->getTile(5, 0, 0));
+            DJV_ASSERT(!pyramid->getTile(0, 0, 0, false));
+            DJV_ASSERT(0 == pyramid->getPendingCount());
+
+            {
+                auto tile = waitTile(pyramid, 0, 11, 3);
+                DJV_ASSERT(tile);
+                DJV_ASSERT(Image::Size(184, 232) == tile->getSize());
+                DJV_ASSERT(image->getType() == tile->getType());
+                bool match = true;
+                for (uint32_t y = 0; y < tile->getHeight(); ++y)
+                {
+                    match &= 0 == memcmp(tile->getData(y), image->getData(2816, 768 + y), tile->getWidth());
+                }
+                DJV_ASSERT(match);
+            }
+
+            {
+                auto tile = waitTile(pyramid, 1, 0, 0);
+                DJV_ASSERT(tile);
+                DJV_ASSERT(Image::Size(256, 256) == tile->getSize());
+                DJV_ASSERT(0 == tile->getData(0, 0)[0]);
+                DJV_ASSERT(255 == tile->getData(50, 0)[0]);
+            }
+
+            {
+                auto tile = waitTile(pyramid, 4, 0, 0);
+                DJV_ASSERT(tile);
+                DJV_ASSERT(Image::Size(188, 63) == tile->getSize());
+                DJV_ASSERT(0 == tile->getData(0, 0)[0]);
+                DJV_ASSERT(255 == tile->getData(7, 0)[0]);
+            }
+        }
+        
+        void ImagePyramidTest::_cache()
+        {
+            auto image = createImage();
+            auto pyramid = Image::Pyramid::create(image, 256);
+            DJV_ASSERT(waitTile(pyramid, 0, 0, 0));
+            DJV_ASSERT(waitTile(pyramid, 0, 1, 0));
+            DJV_ASSERT(2 == pyramid->getCacheCount());
+            DJV_ASSERT(256 * 256 * 2 == pyramid->getCacheByteCount());
+            pyramid->setCacheMaxByteCount(256 * 256);
+            DJV_ASSERT(256 * 256 == pyramid->getCacheMaxByteCount());
+            DJV_ASSERT(1 == pyramid->getCacheCount());
+            DJV_ASSERT(pyramid->getTile(0, 1, 0, false));
+            DJV_ASSERT(!pyramid->getTile(0, 0, 0, false));
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,233 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/ImageResampleTest.h>
+
+#include <djvAV/ImageResample.h>
+
+#include <djvCore/Memory.h>
+
+#include <cmath>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        namespace
+        {
+            void fill(Image::Data& data, float value)
+            {
+                const size_t count = data.getWidth() * static_cast<size_t>(data.getHeight()) * Image::getChannelCount(data.getType());
+                float* p = reinterpret_cast<float*>(data.getData());
+                for (size_t i = 0; i < count; ++i)
+                {
+                    p[i] = value;
+                }
+            }
+
+            void ramp(Image::Data& data)
+            {
+                const size_t byteCount = data.getDataByteCount();
+                uint8_t* p = data.getData();
+                for (size_t i = 0; i < byteCount; ++i)
+                {
+                    p[i] = static_cast<uint8_t>(i * 7);
+                }
+            }
+
+        } // namespace
+
+        ImageResampleTest::ImageResampleTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::ImageResampleTest", context)
+        {}
+        
+        void ImageResampleTest::run(const std::vector<std::string>& args)
+        {
+            _filter();
+            _resample();
+            _layout();
+            _threads();
+        }
+
+        void ImageResampleTest::_filter()
+        {
+            for (auto i : Image::getResampleFilterEnums())
+            {
+                std::stringstream ss;
+                ss << i;
+                _print("Filter: " + ss.str());
+                Image::ResampleFilter filter = Image::ResampleFilter::Count;
+                ss >> filter;
+                DJV_ASSERT(i == filter);
+                const float radius = Image::getResampleFilterRadius(i);
+                DJV_ASSERT(radius > 0.F);
+                DJV_ASSERT(Image::getResampleFilterWeight(i, 0.F) > 0.F);
+                DJV_ASSERT(0.F == Image::getResampleFilterWeight(i, radius + 1.F));
+                DJV_ASSERT(0.F == Image::getResampleFilterWeight(i, -radius - 1.F));
+            }
+
+            {
+                DJV_ASSERT(1.F == Image::getResampleFilterWeight(Image::ResampleFilter::Box, 0.F));
+                DJV_ASSERT(1.F == Image::getResampleFilterWeight(Image::ResampleFilter::Triangle, 0.F));
+                DJV_ASSERT(.5F == Image::getResampleFilterWeight(Image::ResampleFilter::Triangle, .5F));
+                DJV_ASSERT(1.F == Image::getResampleFilterWeight(Image::ResampleFilter::Lanczos3, 0.F));
+                DJV_ASSERT(fabsf(Image::getResampleFilterWeight(Image::ResampleFilter::Lanczos3, 1.F)) < .0001F);
+                DJV_ASSERT(Image::getResampleFilterWeight(Image::ResampleFilter::Lanczos3, 1.5F) < 0.F);
+            }
+        }
+
+        void ImageResampleTest::_resample()
+        {
+            // Constant images do not change, including values outside of the
+            // zero to one range.
+            for (auto filter : Image::getResampleFilterEnums())
+            {
+                for (const auto& size : { Image::Size(16, 9), Image::Size(50, 30), Image::Size(1, 1) })
+                {
+                    for (const float value : { .5F, 4.F, -1.F })
+                    {
+                        auto in = Image::Data::create(Image::Info(37, 23, Image::Type::RGBA_F32));
+                        fill(*in, value);
+                        auto out = Image::Data::create(Image::Info(size, Image::Type::RGBA_F32));
+                        Image::resample(*in, *out, filter);
+                        const float* p = reinterpret_cast<const float*>(out->getData());
+                        for (size_t i = 0; i < size.w * size.h * 4; ++i)
+                        {
+                            DJV_ASSERT(fabsf(p[i] - value) < .0001F);
+                        }
+                    }
+                }
+            }
+
+            {
+                // Reducing by half with the box filter averages the pixels.
+                auto in = Image::Data::create(Image::Info(4, 2, Image::Type::L_F32));
+                float* inP = reinterpret_cast<float*>(in->getData());
+                for (size_t i = 0; i < 8; ++i)
+                {
+                    inP[i] = static_cast<float>(i);
+                }
+                auto out = Image::Data::create(Image::Info(2, 1, Image::Type::L_F32));
+                Image::resample(*in, *out, Image::ResampleFilter::Box);
+                const float* outP = reinterpret_cast<const float*>(out->getData());
+                DJV_ASSERT(2.5F == outP[0]);
+                DJV_ASSERT(4.5F == outP[1]);
+            }
+
+            for (auto filter : { Image::ResampleFilter::Box, Image::ResampleFilter::Triangle, Image::ResampleFilter::Lanczos3 })
+            {
+                // These filters do not change images that are not resized.
+                const Image::Info info(13, 7, Image::Type::RGB_U16);
+                auto in = Image::Data::create(info);
+                ramp(*in);
+                auto out = Image::Data::create(info);
+                Image::resample(*in, *out, filter);
+                DJV_ASSERT(*in == *out);
+            }
+
+            {
+                // F16 values are not quantized by the filtering.
+                auto in = Image::Data::create(Image::Info(20, 10, Image::Type::L_F16));
+                half* inP = reinterpret_cast<half*>(in->getData());
+                for (size_t i = 0; i < 200; ++i)
+                {
+                    inP[i] = 1000.1F;
+                }
+                auto out = Image::Data::create(Image::Info(7, 3, Image::Type::L_F16));
+                Image::resample(*in, *out, Image::ResampleFilter::Lanczos3);
+                const half* outP = reinterpret_cast<const half*>(out->getData());
+                for (size_t i = 0; i < 21; ++i)
+                {
+                    DJV_ASSERT(inP[0] == outP[i]);
+                }
+            }
+        }
+
+        void ImageResampleTest::_layout()
+        {
+            {
+                // The output may have a different type and layout.
+                auto in = Image::Data::create(Image::Info(4, 4, Image::Type::RGB_U8));
+                in->zero();
+                in->getData(0, 0)[0] = 255;
+                const Memory::Endian endian = Memory::opposite(Memory::getEndian());
+                auto out = Image::Data::create(Image::Info(
+                    Image::Size(2, 2),
+                    Image::Type::RGBA_U16,
+                    Image::Layout(Image::Mirror(true, true), 1, endian)));
+                Image::resample(*in, *out, Image::ResampleFilter::Box);
+                uint16_t pixel[4] = { 0, 0, 0, 0 };
+                Memory::endian(out->getData(1, 1), pixel, 4, 2);
+                DJV_ASSERT(16384 == pixel[0] || 16383 == pixel[0]);
+                DJV_ASSERT(0 == pixel[1]);
+                DJV_ASSERT(65535 == pixel[3]);
+                Memory::endian(out->getData(0, 0), pixel, 4, 2);
+                DJV_ASSERT(0 == pixel[0]);
+            }
+
+            {
+                // Endian conversion round trips.
+                const Image::Info info(9, 5, Image::Type::RGB_U10);
+                auto in = Image::Data::create(info);
+                ramp(*in);
+                auto swapped = Image::Data::create(Image::Info(
+                    info.size,
+                    info.type,
+                    Image::Layout(Image::Mirror(), 1, Memory::opposite(Memory::getEndian()))));
+                Image::resample(*in, *swapped, Image::ResampleFilter::Box);
+                auto out = Image::Data::create(info);
+                Image::resample(*swapped, *out, Image::ResampleFilter::Box);
+                DJV_ASSERT(*in == *out);
+            }
+        }
+
+        void ImageResampleTest::_threads()
+        {
+            // The result does not depend on the number of threads.
+            auto in = Image::Data::create(Image::Info(300, 500, Image::Type::RGBA_U8));
+            ramp(*in);
+            for (auto filter : Image::getResampleFilterEnums())
+            {
+                for (const auto& size : { Image::Size(150, 250), Image::Size(320, 700) })
+                {
+                    auto out = Image::Data::create(Image::Info(size, Image::Type::RGBA_U8));
+                    Image::resample(*in, *out, filter, 1);
+                    auto out2 = Image::Data::create(Image::Info(size, Image::Type::RGBA_U8));
+                    Image::resample(*in, *out2, filter, 4);
+                    DJV_ASSERT(*out == *out2);
+                }
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/OCIOProcessorTest.h>
+
+#include <djvAV/ImageData.h>
+#include <djvAV/OCIOProcessor.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+namespace _OCIO = OCIO_NAMESPACE;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        OCIOProcessorTest::OCIOProcessorTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::OCIOProcessorTest", context)
+        {}
+        
+        namespace
+        {
+            //! Create a configuration with a linear and a gamma 2.2 color space.
+            _OCIO::ConstConfigRcPtr createConfig()
+            {
+                auto config = _OCIO::Config::Create();
+                auto linear = _OCIO::ColorSpace::Create();
+                linear->setName("linear");
+                config->addColorSpace(linear);
+                auto gamma = _OCIO::ColorSpace::Create();
+                gamma->setName("gamma");
+                auto transform = _OCIO::ExponentTransform::Create();
+                const float value[4] = { 1.F / 2.2F, 1.F / 2.2F, 1.F / 2.2F, 1.F };
+                transform->setValue(value);
+                gamma->setTransform(transform, _OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+                config->addColorSpace(gamma);
+                config->setRole(_OCIO::ROLE_SCENE_LINEAR, "linear");
+                return config;
+            }
+        
+        } // namespace
+        
+        void OCIOProcessorTest::run(const std::vector<std::string>& args)
+        {
+            auto config = _OCIO::GetCurrentConfig();
+            _OCIO::SetCurrentConfig(createConfig());
+            OCIO::Processor::clearCache();
+            _cache();
+            _process();
+            _OCIO::SetCurrentConfig(config);
+            OCIO::Processor::clearCache();
+        }
+
+        void OCIOProcessorTest::_cache()
+        {
+            {
+                auto processor = OCIO::Processor::create(OCIO::Convert("linear", "gamma"));
+                DJV_ASSERT(OCIO::Convert("linear", "gamma") == processor->getConvert());
+                DJV_ASSERT(!processor->isNoOp());
+                DJV_ASSERT(processor == OCIO::Processor::create(OCIO::Convert("linear", "gamma")));
+                DJV_ASSERT(processor != OCIO::Processor::create(OCIO::Convert("gamma", "linear")));
+                OCIO::Processor::clearCache();
+                DJV_ASSERT(processor != OCIO::Processor::create(OCIO::Convert("linear", "gamma")));
+            }
+
+            {
+                auto processor = OCIO::Processor::create(OCIO::Convert("linear", "linear"));
+                DJV_ASSERT(processor->isNoOp());
+            }
+
+            try
+            {
+                OCIO::Processor::create(OCIO::Convert("linear", "unknown"));
+                DJV_ASSERT(false);
+            }
+            catch (const std::exception& e)
+            {
+                _print(e.what());
+            }
+        }
+
+        void OCIOProcessorTest::_process()
+        {
+            auto processor = OCIO::Processor::create(OCIO::Convert("linear", "gamma"));
+
+            {
+                auto data = Image::Data::create(Image::Info(1, 1, Image::Type::RGBA_F32));
+                float* p = reinterpret_cast<float*>(data->getData());
+                p[0] = p[1] = p[2] = .5F;
+                p[3] = .25F;
+                processor->process(*data);
+                std::stringstream ss;
+                ss << "linear to gamma: " << p[0] << " " << p[1] << " " << p[2] << " " << p[3];
+                _print(ss.str());
+                DJV_ASSERT(std::abs(p[0] - std::pow(.5F, 1.F / 2.2F)) < .001F);
+                DJV_ASSERT(std::abs(p[3] - .25F) < .001F);
+            }
+
+            for (auto type : { Image::Type::L_U8, Image::Type::RGB_U8, Image::Type::RGB_U10, Image::Type::RGBA_U16, Image::Type::RGBA_F16 })
+            {
+                // The result should not depend on the number of threads or the
+                // image layout.
+                const Image::Size size(97, 211);
+                const Memory::Endian endian = Memory::opposite(Memory::getEndian());
+                auto a = Image::Data::create(Image::Info(size, type));
+                auto b = Image::Data::create(Image::Info(size, type, Image::Layout(Image::Mirror(), 4, endian)));
+                const size_t wordSize = Image::Type::RGB_U10 == type ? 4 : Image::getByteCount(Image::getDataType(type));
+                const size_t scanlineByteCount = size.w * a->getPixelByteCount();
+                std::vector<float> ramp(size.w * 4);
+                for (uint32_t y = 0; y < size.h; ++y)
+                {
+                    for (uint32_t x = 0; x < size.w; ++x)
+                    {
+                        for (size_t c = 0; c < 4; ++c)
+                        {
+                            ramp[x * 4 + c] = (x + y + c) / static_cast<float>(size.w + size.h);
+                        }
+                    }
+                    Image::convert(ramp.data(), Image::Type::RGBA_F32, a->getData(y), type, size.w);
+                    Image::convert(ramp.data(), Image::Type::RGBA_F32, b->getData(y), type, size.w);
+                    Memory::endian(b->getData(y), scanlineByteCount / wordSize, wordSize);
+                }
+                processor->process(*a, 1);
+                processor->process(*b, 8);
+                bool equal = true;
+                for (uint32_t y = 0; y < size.h; ++y)
+                {
+                    Memory::endian(b->getData(y), scanlineByteCount / wordSize, wordSize);
+                    equal &= 0 == memcmp(a->getData(y), b->getData(y), scanlineByteCount);
+                }
+                std::stringstream ss;
+                ss << "process " << type << ": " << equal;
+                _print(ss.str());
+                DJV_ASSERT(equal);
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/OpenGLPixelBufferTest.h>
+
+#include <djvAV/OpenGLOffscreenBuffer.h>
+#include <djvAV/OpenGLPixelBuffer.h>
+#include <djvAV/OpenGLTexture.h>
+
+#include <djvCore/Context.h>
+#include <djvCore/Memory.h>
+
+#include <cstring>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        OpenGLPixelBufferTest::OpenGLPixelBufferTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::OpenGLPixelBufferTest", context)
+        {}
+        
+        void OpenGLPixelBufferTest::run(const std::vector<std::string>& args)
+        {
+            if (auto context = getContext().lock())
+            {
+                const Image::Info info(1920, 1080, Image::Type::RGBA_U8);
+                auto offscreenBuffer = OpenGL::OffscreenBuffer::create(info);
+                offscreenBuffer->bind();
+                auto texture = OpenGL::Texture::create(info);
+                auto pixelBuffers = OpenGL::PixelBufferRing::create(3);
+                DJV_ASSERT(3 == pixelBuffers->getCount());
+
+                const size_t count = 10;
+                auto data = Image::Data::create(info);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    memset(data->getData(), static_cast<int>(i), data->getDataByteCount());
+                    pixelBuffers->copy(*data, *texture);
+                }
+                DJV_ASSERT(count == pixelBuffers->getUploadCount() + pixelBuffers->getFallbackCount());
+                DJV_ASSERT(count * info.getDataByteCount() == pixelBuffers->getByteCount());
+
+#if !defined(DJV_OPENGL_ES2)
+                auto result = Image::Data::create(info);
+                texture->bind();
+                glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                glGetTexImage(GL_TEXTURE_2D, 0, info.getGLFormat(), info.getGLType(), result->getData());
+                DJV_ASSERT(count - 1 == result->getData()[0]);
+                DJV_ASSERT(count - 1 == result->getData()[result->getDataByteCount() - 1]);
+#endif // DJV_OPENGL_ES2
+
+                {
+                    std::stringstream ss;
+                    ss << "uploads: " << pixelBuffers->getUploadCount();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "orphans: " << pixelBuffers->getOrphanCount();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "fallbacks: " << pixelBuffers->getFallbackCount();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    const float time = pixelBuffers->getUploadTime();
+                    ss << "upload time: " << (time / count * 1000.F) << "ms";
+                    if (time > 0.F)
+                    {
+                        ss << ", " << (pixelBuffers->getByteCount() / time / Memory::megabyte) << "MB/s";
+                    }
+                    _print(ss.str());
+                }
+                pixelBuffers->resetStats();
+                DJV_ASSERT(0 == pixelBuffers->getUploadCount());
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            }
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
@@ -33,16 +33,16 @@
 
 namespace djv
 {
-    namespace CoreTest
+    namespace AVTest
     {
-        class CacheTest : public Test::ITest
+        class OpenGLPixelBufferTest : public Test::ITest
         {
         public:
-            CacheTest(const std::shared_ptr<Core::Context>&);
+            OpenGLPixelBufferTest(const std::shared_ptr<Core::Context>&);
             
             void run(const std::vector<std::string>&) override;
         };
         
-    } // namespace CoreTest
+    } // namespace AVTest
 } // namespace djv
 
@@ -31,6 +31,9 @@
 
 #include <djvAV/Pixel.h>
 
+#include <chrono>
+#include <vector>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -58,6 +61,7 @@ namespace djv
             _enum();
             _constants();
             _convert();
+            _convertU10();
         }
                 
         void PixelTest::_enum()
@@ -207,6 +211,114 @@ namespace djv
             }
         }
         
+        void PixelTest::_convertU10()
+        {
+            // Use a size that is not a multiple of the SIMD width.
+            const size_t size = Image::U10Range.max + 4;
+            std::vector<Image::U10_S> u10(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                u10[i].r = i % 1024;
+                u10[i].g = (i * 7) % 1024;
+                u10[i].b = 1023 - i % 1024;
+            }
+
+            {
+                std::vector<Image::F32_T> rgba(size * 4, -1.F);
+                Image::convert(u10.data(), Image::Type::RGB_U10, rgba.data(), Image::Type::RGBA_F32, size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    Image::F32_T r = 0.F;
+                    Image::F32_T g = 0.F;
+                    Image::F32_T b = 0.F;
+                    Image::convert_U10_F32(u10[i].r, r);
+                    Image::convert_U10_F32(u10[i].g, g);
+                    Image::convert_U10_F32(u10[i].b, b);
+                    DJV_ASSERT(r == rgba[i * 4 + 0]);
+                    DJV_ASSERT(g == rgba[i * 4 + 1]);
+                    DJV_ASSERT(b == rgba[i * 4 + 2]);
+                    DJV_ASSERT(Image::F32Range.max == rgba[i * 4 + 3]);
+                }
+
+                std::vector<Image::U10_S> u10b(size);
+                Image::convert(rgba.data(), Image::Type::RGBA_F32, u10b.data(), Image::Type::RGB_U10, size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    DJV_ASSERT(u10[i].r == u10b[i].r);
+                    DJV_ASSERT(u10[i].g == u10b[i].g);
+                    DJV_ASSERT(u10[i].b == u10b[i].b);
+                }
+            }
+
+            {
+                std::vector<Image::F32_T> rgb(size * 3, -1.F);
+                Image::convert(u10.data(), Image::Type::RGB_U10, rgb.data(), Image::Type::RGB_F32, size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    Image::F32_T r = 0.F;
+                    Image::F32_T g = 0.F;
+                    Image::F32_T b = 0.F;
+                    Image::convert_U10_F32(u10[i].r, r);
+                    Image::convert_U10_F32(u10[i].g, g);
+                    Image::convert_U10_F32(u10[i].b, b);
+                    DJV_ASSERT(r == rgb[i * 3 + 0]);
+                    DJV_ASSERT(g == rgb[i * 3 + 1]);
+                    DJV_ASSERT(b == rgb[i * 3 + 2]);
+                }
+
+                rgb[0] = -1.F;
+                rgb[1] = 2.F;
+                std::vector<Image::U10_S> u10b(size);
+                Image::convert(rgb.data(), Image::Type::RGB_F32, u10b.data(), Image::Type::RGB_U10, size);
+                DJV_ASSERT(0 == u10b[0].r);
+                DJV_ASSERT(1023 == u10b[0].g);
+                for (size_t i = 1; i < size; ++i)
+                {
+                    DJV_ASSERT(u10[i].r == u10b[i].r);
+                    DJV_ASSERT(u10[i].g == u10b[i].g);
+                    DJV_ASSERT(u10[i].b == u10b[i].b);
+                }
+            }
+
+            {
+                std::vector<Image::U16_T> rgba(size * 4, 0);
+                Image::convert(u10.data(), Image::Type::RGB_U10, rgba.data(), Image::Type::RGBA_U16, size);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    Image::U16_T r = 0;
+                    Image::convert_U10_U16(u10[i].r, r);
+                    DJV_ASSERT(r == rgba[i * 4 + 0]);
+                    DJV_ASSERT(Image::U16Range.max == rgba[i * 4 + 3]);
+                }
+            }
+
+            {
+                const size_t benchSize = 4096 * 2160;
+                std::vector<Image::U10_S> in(benchSize);
+                std::vector<Image::F32_T> out(benchSize * 4);
+                auto t0 = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < benchSize; ++i)
+                {
+                    Image::convert_U10_F32(in[i].r, out[i * 4 + 0]);
+                    Image::convert_U10_F32(in[i].g, out[i * 4 + 1]);
+                    Image::convert_U10_F32(in[i].b, out[i * 4 + 2]);
+                    out[i * 4 + 3] = Image::F32Range.max;
+                }
+                auto t1 = std::chrono::steady_clock::now();
+                Image::convert(in.data(), Image::Type::RGB_U10, out.data(), Image::Type::RGBA_F32, benchSize);
+                auto t2 = std::chrono::steady_clock::now();
+                Image::convert(out.data(), Image::Type::RGBA_F32, in.data(), Image::Type::RGB_U10, benchSize);
+                auto t3 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> reference = t1 - t0;
+                const std::chrono::duration<float> unpack = t2 - t1;
+                const std::chrono::duration<float> pack = t3 - t2;
+                std::stringstream ss;
+                ss << "RGB_U10 4096x2160: unpack " << reference.count() * 1000.F << "ms (scalar), " <<
+                    unpack.count() * 1000.F << "ms, pack " << pack.count() * 1000.F << "ms";
+                _print(ss.str());
+            }
+        }
+        
     } // namespace AVTest
 } // namespace djv
 
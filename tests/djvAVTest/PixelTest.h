@@ -44,6 +44,7 @@ namespace djv
             void _enum();
             void _constants();
             void _convert();
+            void _convertU10();
         };
         
     } // namespace AVTest
@@ -0,0 +1,191 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvAVTest/PrefetchControllerTest.h>
+
+#include <djvAV/PrefetchController.h>
+
+using namespace djv::Core;
+using namespace djv::AV;
+
+namespace djv
+{
+    namespace AVTest
+    {
+        PrefetchControllerTest::PrefetchControllerTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::AVTest::PrefetchControllerTest", context)
+        {}
+        
+        void PrefetchControllerTest::run(const std::vector<std::string>& args)
+        {
+            _decision();
+            _limits();
+            _reads();
+            _consumed();
+            _underruns();
+        }
+
+        void PrefetchControllerTest::_decision()
+        {
+            {
+                const IO::PrefetchDecision decision;
+                DJV_ASSERT(1 == decision.threadCount);
+                DJV_ASSERT(1 == decision.queueSize);
+                DJV_ASSERT(10 == decision.readBehind);
+                DJV_ASSERT(0 == decision.underruns);
+            }
+
+            {
+                IO::PrefetchDecision decision;
+                IO::PrefetchDecision decision2;
+                DJV_ASSERT(decision == decision2);
+                decision2.queueSize = 2;
+                DJV_ASSERT(decision != decision2);
+            }
+        }
+
+        void PrefetchControllerTest::_limits()
+        {
+            {
+                IO::PrefetchController controller;
+                controller.setLimits(8, 10);
+                DJV_ASSERT(8 == controller.getDecision().threadCount);
+                DJV_ASSERT(10 == controller.getDecision().queueSize);
+                DJV_ASSERT(!controller.tick(1.F));
+                DJV_ASSERT(8 == controller.getDecision().threadCount);
+                DJV_ASSERT(10 == controller.getDecision().queueSize);
+            }
+
+            {
+                IO::PrefetchController controller;
+                controller.setLimits(0, 0);
+                DJV_ASSERT(1 == controller.getDecision().threadCount);
+                DJV_ASSERT(1 == controller.getDecision().queueSize);
+            }
+
+            {
+                IO::PrefetchController controller;
+                controller.setLimits(8, 10);
+                controller.setSpeed(24.F);
+                controller.addRead(0.F, 1.F);
+                DJV_ASSERT(controller.tick(1.F));
+                DJV_ASSERT(8 == controller.getDecision().threadCount);
+                DJV_ASSERT(10 == controller.getDecision().queueSize);
+            }
+        }
+
+        void PrefetchControllerTest::_reads()
+        {
+            {
+                IO::PrefetchController controller;
+                controller.setLimits(8, 10);
+                controller.setSpeed(24.F);
+                controller.addRead(0.F, .08F);
+                DJV_ASSERT(!controller.tick(.1F));
+                DJV_ASSERT(controller.tick(1.F));
+                const auto& decision = controller.getDecision();
+                DJV_ASSERT(.08F == decision.readTime);
+                DJV_ASSERT(3 == decision.threadCount);
+                DJV_ASSERT(3 == decision.queueSize);
+                DJV_ASSERT(10 == decision.readBehind);
+            }
+
+            {
+                IO::PrefetchController controller;
+                controller.setLimits(8, 10);
+                controller.setSpeed(24.F);
+                for (size_t i = 0; i < 100; ++i)
+                {
+                    controller.addRead(0.F, .001F);
+                }
+                controller.tick(1.F);
+                DJV_ASSERT(1 == controller.getDecision().threadCount);
+                DJV_ASSERT(2 == controller.getDecision().queueSize);
+            }
+
+            {
+                IO::PrefetchController controller;
+                controller.setLimits(8, 10);
+                controller.setSpeed(24.F);
+                controller.addRead(0.F, .001F);
+                controller.tick(1.F);
+                controller.reset();
+                DJV_ASSERT(8 == controller.getDecision().threadCount);
+                DJV_ASSERT(10 == controller.getDecision().queueSize);
+                DJV_ASSERT(0.F == controller.getDecision().readTime);
+            }
+
+            {
+                // Starting playback does not wait for the next update.
+                IO::PrefetchController controller;
+                controller.setLimits(8, 10);
+                controller.addRead(0.F, .08F);
+                controller.tick(1.F);
+                DJV_ASSERT(1 == controller.getDecision().threadCount);
+                DJV_ASSERT(1 == controller.getDecision().queueSize);
+                controller.setSpeed(24.F);
+                DJV_ASSERT(3 == controller.getDecision().threadCount);
+                DJV_ASSERT(3 == controller.getDecision().queueSize);
+            }
+        }
+
+        void PrefetchControllerTest::_consumed()
+        {
+            IO::PrefetchController controller;
+            controller.setLimits(8, 10);
+            controller.addRead(0.F, .001F);
+            controller.addConsumed(12);
+            controller.tick(.5F);
+            const auto& decision = controller.getDecision();
+            DJV_ASSERT(24.F == decision.consumeRate);
+            DJV_ASSERT(6 == decision.readBehind);
+            controller.tick(.5F);
+            DJV_ASSERT(decision.consumeRate < 24.F);
+        }
+
+        void PrefetchControllerTest::_underruns()
+        {
+            IO::PrefetchController controller;
+            controller.setLimits(8, 10);
+            controller.setSpeed(24.F);
+            controller.addRead(0.F, .001F);
+            controller.tick(1.F);
+            DJV_ASSERT(1 == controller.getDecision().threadCount);
+            controller.addUnderrun();
+            controller.tick(1.F);
+            DJV_ASSERT(1 == controller.getDecision().underruns);
+            DJV_ASSERT(2 == controller.getDecision().threadCount);
+            controller.tick(1.F);
+            DJV_ASSERT(0 == controller.getDecision().underruns);
+            DJV_ASSERT(1 == controller.getDecision().threadCount);
+        }
+        
+    } // namespace AVTest
+} // namespace djv
+
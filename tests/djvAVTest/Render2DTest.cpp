@@ -38,6 +38,10 @@
 #include <djvCore/Context.h>
 #include <djvCore/Timer.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
 using namespace djv::Core;
 using namespace djv::AV;
 
@@ -53,6 +57,9 @@ namespace djv
         {
             _operators();
             _system();
+            _batching();
+            _software();
+            _tiled();
         }
         
         void Render2DTest::_system()
@@ -135,6 +142,271 @@ namespace djv
                     ss << "vbo size: " << render->getVBOSize();
                     _print(ss.str());
                 }
+                {
+                    std::stringstream ss;
+                    ss << "primitives: " << render->getPrimitiveCount();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "draw calls: " << render->getDrawCount();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "state changes: " << render->getStateChangeCount();
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "vertices: " << render->getVertexCount();
+                    _print(ss.str());
+                }
+            }
+        }
+
+        void Render2DTest::_batching()
+        {
+            if (auto context = getContext().lock())
+            {
+                const Image::Info info(1280, 720, AV::Image::Type::RGBA_U8);
+                auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(info);
+                offscreenBuffer->bind();
+                auto render = context->getSystemT<AV::Render::Render2D>();
+                for (const auto batching : { true, false })
+                {
+                    render->setBatchingEnabled(batching);
+                    DJV_ASSERT(batching == render->isBatchingEnabled());
+                    render->beginFrame(info.size);
+                    render->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                    for (size_t i = 0; i < 100; ++i)
+                    {
+                        render->drawRect(BBox2f(i * 10.F, 10.F, 5.F, 5.F));
+                    }
+                    render->setFillColor(Image::Color(1.F, 0.F, 0.F));
+                    render->drawRect(BBox2f(10.F, 100.F, 5.F, 5.F));
+                    render->endFrame();
+                    DJV_ASSERT(101 == render->getPrimitiveCount());
+                    DJV_ASSERT((batching ? 2 : 101) == render->getDrawCount());
+                    DJV_ASSERT(101 * 6 == render->getVertexCount());
+                    std::stringstream ss;
+                    ss << "batching " << batching << " draw calls: " << render->getDrawCount() <<
+                        ", state changes: " << render->getStateChangeCount();
+                    _print(ss.str());
+                }
+                render->setBatchingEnabled(true);
+                glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            }
+        }
+
+        namespace
+        {
+            void drawScene(
+                const std::shared_ptr<Render::Render2D>& render,
+                const Image::Size& size,
+                const std::shared_ptr<Image::Image>& image,
+                const std::vector<std::shared_ptr<Font::Glyph> >& glyphs)
+            {
+                render->beginFrame(size);
+
+                render->setFillColor(Image::Color(.2F, .2F, .2F));
+                render->drawRect(BBox2f(0.F, 0.F, size.w, size.h));
+                render->setFillColor(Image::Color(1.F, .6F, .4F, .5F));
+                render->drawRects({ BBox2f(10.F, 10.F, 100.F, 50.F), BBox2f(60.F, 30.F, 100.F, 50.F) });
+                render->setFillColor(Image::Color(.4F, .6F, 1.F));
+                render->drawPill(BBox2f(170.F, 10.F, 100.F, 40.F));
+                render->drawCircle(glm::vec2(240.F, 120.F), 40.F);
+                render->setLineWidth(2.F);
+                render->drawPolyline({ glm::vec2(10.F, 200.F), glm::vec2(100.F, 150.F), glm::vec2(190.F, 200.F) });
+
+                render->pushClipRect(BBox2f(10.F, 90.F, 48.F, 48.F));
+                render->drawImage(image, glm::vec2(10.F, 90.F));
+                render->popClipRect();
+                {
+                    Render::ImageOptions options;
+                    options.colorEnabled = true;
+                    options.color.saturation = .5F;
+                    options.levelsEnabled = true;
+                    options.levels.gamma = 2.F;
+                    options.cache = Render::ImageCache::Dynamic;
+                    render->drawImage(image, glm::vec2(80.F, 90.F), options);
+                }
+                {
+                    Render::ImageOptions options;
+                    options.exposureEnabled = true;
+                    options.exposure.exposure = 1.F;
+                    options.channel = Render::ImageChannel::Green;
+                    options.mirror.x = true;
+                    render->drawImage(image, glm::vec2(150.F, 170.F), options);
+                }
+                render->setFillColor(Image::Color(.6F, 1.F, .4F));
+                render->drawFilledImage(image, glm::vec2(230.F, 170.F));
+
+                render->setFillColor(Image::Color(0.F, 0.F, 0.F, .5F));
+                render->drawShadow(BBox2f(10.F, 210.F, 100.F, 20.F), Side::Bottom);
+                render->drawShadow(BBox2f(120.F, 210.F, 100.F, 20.F), 8.F);
+
+                render->setFillColor(Image::Color(1.F, 1.F, 1.F));
+                render->drawText(glyphs, glm::vec2(120.F, 80.F));
+
+                render->endFrame();
+            }
+
+        } // namespace
+
+        void Render2DTest::_software()
+        {
+            if (auto context = getContext().lock())
+            {
+                const Image::Info info(320, 240, AV::Image::Type::RGBA_U8);
+                auto software = Render::Render2D::create(context, Render::Backend::Software);
+                DJV_ASSERT(Render::Backend::Software == software->getBackend());
+                DJV_ASSERT(!software->getImage());
+
+                {
+                    software->beginFrame(info.size);
+                    software->setFillColor(Image::Color(1.F, 0.F, 0.F));
+                    software->drawRect(BBox2f(10.F, 10.F, 20.F, 20.F));
+                    software->pushClipRect(BBox2f(40.F, 10.F, 10.F, 10.F));
+                    software->drawRect(BBox2f(35.F, 5.F, 20.F, 20.F));
+                    software->popClipRect();
+                    software->endFrame();
+                    auto image = software->getImage();
+                    DJV_ASSERT(image);
+                    DJV_ASSERT(info.size == image->getSize());
+                    DJV_ASSERT(2 == software->getDrawCount());
+                    const uint8_t* p = image->getData(10, 10);
+                    DJV_ASSERT(255 == p[0] && 0 == p[1] && 0 == p[2] && 255 == p[3]);
+                    p = image->getData(29, 29);
+                    DJV_ASSERT(255 == p[0] && 255 == p[3]);
+                    p = image->getData(30, 30);
+                    DJV_ASSERT(0 == p[3]);
+                    p = image->getData(9, 9);
+                    DJV_ASSERT(0 == p[3]);
+                    p = image->getData(40, 10);
+                    DJV_ASSERT(255 == p[3]);
+                    p = image->getData(39, 10);
+                    DJV_ASSERT(0 == p[3]);
+                    p = image->getData(50, 10);
+                    DJV_ASSERT(0 == p[3]);
+                }
+
+                auto image = Image::Image::create(Image::Info(48, 48, AV::Image::Type::RGBA_U8));
+                for (uint32_t y = 0; y < 48; ++y)
+                {
+                    for (uint32_t x = 0; x < 48; ++x)
+                    {
+                        uint8_t* p = image->getData(x, y);
+                        p[0] = static_cast<uint8_t>(x * 5);
+                        p[1] = static_cast<uint8_t>(y * 5);
+                        p[2] = static_cast<uint8_t>(255 - x * 5);
+                        p[3] = 255;
+                    }
+                }
+                auto fontSystem = context->getSystemT<Font::System>();
+                const Font::Info fontInfo(1, 1, 24, AV::dpiDefault);
+                const auto glyphs = fontSystem->getGlyphs("Render2D", fontInfo).get();
+
+                const auto t0 = std::chrono::steady_clock::now();
+                drawScene(software, info.size, image, glyphs);
+                const auto t1 = std::chrono::steady_clock::now();
+                const std::chrono::duration<float> softwareTime = t1 - t0;
+                auto softwareImage = software->getImage();
+                {
+                    std::stringstream ss;
+                    ss << "software frame time: " << softwareTime.count() << " primitives: " <<
+                        software->getPrimitiveCount() << " draw calls: " << software->getDrawCount();
+                    _print(ss.str());
+                }
+
+                // Compare the software and OpenGL renderers.
+                auto render = context->getSystemT<AV::Render::Render2D>();
+                if (Render::Backend::OpenGL == render->getBackend())
+                {
+                    auto offscreenBuffer = AV::OpenGL::OffscreenBuffer::create(info);
+                    offscreenBuffer->bind();
+                    drawScene(render, info.size, image, glyphs);
+                    auto glImage = Image::Image::create(info);
+                    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+                    glReadPixels(0, 0, info.size.w, info.size.h, GL_RGBA, GL_UNSIGNED_BYTE, glImage->getData());
+                    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+                    size_t diffCount = 0;
+                    int diffMax = 0;
+                    for (uint32_t y = 0; y < info.size.h; ++y)
+                    {
+                        for (uint32_t x = 0; x < info.size.w; ++x)
+                        {
+                            const uint8_t* a = softwareImage->getData(x, y);
+                            const uint8_t* b = glImage->getData(x, info.size.h - 1 - y);
+                            int diff = 0;
+                            for (size_t c = 0; c < 4; ++c)
+                            {
+                                diff = std::max(diff, std::abs(static_cast<int>(a[c]) - static_cast<int>(b[c])));
+                            }
+                            diffMax = std::max(diffMax, diff);
+                            if (diff > 3)
+                            {
+                                ++diffCount;
+                            }
+                        }
+                    }
+                    const float diffPercentage = diffCount / static_cast<float>(info.size.w * info.size.h) * 100.F;
+                    {
+                        std::stringstream ss;
+                        ss << "software vs. OpenGL different pixels: " << diffPercentage << "%, maximum difference: " << diffMax;
+                        _print(ss.str());
+                    }
+                    DJV_ASSERT(diffPercentage < 1.F);
+                }
+            }
+        }
+
+        void Render2DTest::_tiled()
+        {
+            if (auto context = getContext().lock())
+            {
+                auto render = Render::Render2D::create(context, Render::Backend::Software);
+                auto image = Image::Image::create(Image::Info(20000, 100, AV::Image::Type::RGBA_U8));
+                for (uint32_t y = 0; y < image->getHeight(); ++y)
+                {
+                    for (uint32_t x = 0; x < image->getWidth(); ++x)
+                    {
+                        uint8_t* p = image->getData(x, y);
+                        p[0] = x < 10000 ? 255 : 0;
+                        p[1] = 0;
+                        p[2] = x < 10000 ? 0 : 255;
+                        p[3] = 255;
+                    }
+                }
+
+                const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+                size_t frames = 0;
+                do
+                {
+                    render->beginFrame(Image::Size(1000, 100));
+                    render->pushTransform(glm::mat3x3(
+                        .05F, 0.F, 0.F,
+                        0.F, .05F, 0.F,
+                        0.F, 0.F, 1.F));
+                    render->drawImage(image, glm::vec2(0.F, 0.F));
+                    render->popTransform();
+                    render->endFrame();
+                    ++frames;
+                } while (render->getPendingTileCount() && std::chrono::steady_clock::now() < timeout);
+                {
+                    std::stringstream ss;
+                    ss << "tiled image frames: " << frames << ", primitives: " << render->getPrimitiveCount();
+                    _print(ss.str());
+                }
+                DJV_ASSERT(0 == render->getPendingTileCount());
+                auto out = render->getImage();
+                const uint8_t* p = out->getData(100, 2);
+                DJV_ASSERT(255 == p[0] && 0 == p[2] && 255 == p[3]);
+                p = out->getData(900, 2);
+                DJV_ASSERT(0 == p[0] && 255 == p[2] && 255 == p[3]);
+                p = out->getData(100, 10);
+                DJV_ASSERT(0 == p[3]);
             }
         }
 
@@ -42,6 +42,9 @@ namespace djv
             
         private:
             void _system();
+            void _batching();
+            void _software();
+            void _tiled();
             void _operators();
         };
         
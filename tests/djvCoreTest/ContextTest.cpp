@@ -46,6 +46,23 @@ namespace djv
         namespace
         {
             class System : public ISystem {};
+
+            class LazySystem : public ISystem
+            {
+            protected:
+                void _init(const std::shared_ptr<Context>& context)
+                {
+                    ISystem::_init("djv::CoreTest::LazySystem", context);
+                }
+
+            public:
+                static std::shared_ptr<LazySystem> create(const std::shared_ptr<Context>& context)
+                {
+                    auto out = std::shared_ptr<LazySystem>(new LazySystem);
+                    out->_init(context);
+                    return out;
+                }
+            };
         
         } // namespace
         
@@ -80,6 +97,16 @@ namespace djv
                 {
                     DJV_ASSERT(!context->getSystemT<System>());
                 }
+
+                {
+                    context->addSystemFactoryT<LazySystem>();
+                    DJV_ASSERT(context->getSystemsT<LazySystem>().empty());
+                    auto lazySystem = context->getSystemT<LazySystem>();
+                    DJV_ASSERT(lazySystem);
+                    DJV_ASSERT(lazySystem == context->getSystemT<LazySystem>());
+                    DJV_ASSERT(1 == context->getSystemsT<LazySystem>().size());
+                    context->removeSystem(lazySystem);
+                }
                 
                 for (size_t i = 0; i < 100; ++i)
                 {
@@ -91,6 +118,13 @@ namespace djv
                     ss << "fps averge: " << context->getFPSAverage();
                     _print(ss.str());
                 }
+
+                for (const auto& i : context->getSystemInitTimes())
+                {
+                    std::stringstream ss;
+                    ss << "system init time: " << i.first << ": " << i.second << "ms";
+                    _print(ss.str());
+                }
             }
         }
         
@@ -34,17 +34,109 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/Path.h>
 
+#include <cstdio>
+
 using namespace djv::Core;
 
 namespace djv
 {
     namespace CoreTest
     {
+        namespace
+        {
+            //! Get whether a change was delivered. A reset is also accepted since some
+            //! platforms report the directory as a whole.
+            bool hasChange(
+                const std::vector<FileSystem::DirectoryChange>& changes,
+                FileSystem::DirectoryChangeType type,
+                const FileSystem::Path& path)
+            {
+                for (const auto& i : changes)
+                {
+                    if (FileSystem::DirectoryChangeType::Reset == i.type ||
+                        (type == i.type && path.getFileName() == i.path.getFileName()))
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+        } // namespace
+
         DirectoryWatcherTest::DirectoryWatcherTest(const std::shared_ptr<Core::Context>& context) :
             ITickTest("djv::CoreTest::DirectoryWatcherTest", context)
         {}
         
         void DirectoryWatcherTest::run(const std::vector<std::string>& args)
+        {
+            _changes();
+            _watcher();
+        }
+
+        void DirectoryWatcherTest::_changes()
+        {
+            const FileSystem::Path a("a");
+            const FileSystem::Path b("b");
+
+            {
+                FileSystem::DirectoryChanges changes;
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a));
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, b));
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Modified, a));
+                DJV_ASSERT(2 == changes.getSize());
+                DJV_ASSERT(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a) == changes.get()[0]);
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Removed, a));
+                DJV_ASSERT(1 == changes.getSize());
+                DJV_ASSERT(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, b) == changes.get()[0]);
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a));
+                DJV_ASSERT(2 == changes.getSize());
+                DJV_ASSERT(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a) == changes.get()[1]);
+            }
+
+            {
+                FileSystem::DirectoryChanges changes;
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Removed, a));
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a));
+                DJV_ASSERT(1 == changes.getSize());
+                DJV_ASSERT(FileSystem::DirectoryChangeType::Modified == changes.get()[0].type);
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Removed, a));
+                DJV_ASSERT(1 == changes.getSize());
+                DJV_ASSERT(FileSystem::DirectoryChangeType::Removed == changes.get()[0].type);
+            }
+
+            {
+                FileSystem::DirectoryChanges changes;
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a));
+                changes.add(FileSystem::DirectoryChange());
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, b));
+                DJV_ASSERT(1 == changes.getSize());
+                DJV_ASSERT(FileSystem::DirectoryChangeType::Reset == changes.get()[0].type);
+                changes.clear();
+                DJV_ASSERT(changes.isEmpty());
+                changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, a));
+                DJV_ASSERT(1 == changes.getSize());
+            }
+
+            {
+                FileSystem::DirectoryChanges changes;
+                const size_t count = 1000;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Created, FileSystem::Path(std::to_string(i))));
+                }
+                for (size_t i = 0; i < count; i += 2)
+                {
+                    changes.add(FileSystem::DirectoryChange(FileSystem::DirectoryChangeType::Removed, FileSystem::Path(std::to_string(i))));
+                }
+                DJV_ASSERT(count / 2 == changes.getSize());
+                const auto list = changes.get();
+                DJV_ASSERT(FileSystem::Path("1") == list[0].path);
+                DJV_ASSERT(FileSystem::Path(std::to_string(count - 1)) == list[count / 2 - 1].path);
+            }
+        }
+
+        void DirectoryWatcherTest::_watcher()
         {
             if (auto context = getContext().lock())
             {
@@ -52,25 +144,92 @@ namespace djv
                 const FileSystem::Path path(".");
                 watcher->setPath(path);
                 DJV_ASSERT(path == watcher->getPath());
+                watcher->setRecursive(true);
+                DJV_ASSERT(watcher->isRecursive());
+                watcher->setRecursive(false);
                 bool changed = false;
                 watcher->setCallback(
                     [&changed]
                     {
                         changed = true;
                     });
+                std::vector<FileSystem::DirectoryChange> changes;
+                watcher->setChangesCallback(
+                    [&changes](const std::vector<FileSystem::DirectoryChange>& value)
+                    {
+                        changes.insert(changes.end(), value.begin(), value.end());
+                    });
                 
                 _tickFor(std::chrono::milliseconds(1000));
                 
-                FileSystem::FileIO io;
-                io.open(
-                    std::string(FileSystem::Path(path, "DirectoryWatcherTest")),
-                    FileSystem::FileIO::Mode::Write);
-                io.close();
+                const FileSystem::Path filePath(path, "DirectoryWatcherTest");
+                {
+                    FileSystem::FileIO io;
+                    io.open(std::string(filePath), FileSystem::FileIO::Mode::Write);
+                    io.close();
+                }
                 
                 _tickFor(std::chrono::milliseconds(1000));
                 
+                _printChanges(changes);
+                DJV_ASSERT(changed);
+                DJV_ASSERT(hasChange(changes, FileSystem::DirectoryChangeType::Created, filePath));
+
+                changed = false;
+                changes.clear();
+                std::remove(std::string(filePath).c_str());
+
+                _tickFor(std::chrono::milliseconds(1000));
+
+                _printChanges(changes);
+                DJV_ASSERT(changed);
+                DJV_ASSERT(hasChange(changes, FileSystem::DirectoryChangeType::Removed, filePath));
+
+#if defined(DJV_PLATFORM_LINUX)
+                // Changes inside a renamed sub-directory are reported with the new path.
+                const FileSystem::Path dirPath(path, "DirectoryWatcherTestDir");
+                const FileSystem::Path dirPath2(path, "DirectoryWatcherTestDir2");
+                FileSystem::Path::mkdir(dirPath);
+                watcher->setRecursive(true);
+
+                _tickFor(std::chrono::milliseconds(1000));
+
+                std::rename(std::string(dirPath).c_str(), std::string(dirPath2).c_str());
+
+                _tickFor(std::chrono::milliseconds(1000));
+
+                changes.clear();
+                const FileSystem::Path filePath2(dirPath2, "DirectoryWatcherTest");
+                {
+                    FileSystem::FileIO io;
+                    io.open(std::string(filePath2), FileSystem::FileIO::Mode::Write);
+                    io.close();
+                }
+
+                _tickFor(std::chrono::milliseconds(1000));
+
+                _printChanges(changes);
+                bool found = false;
+                for (const auto& i : changes)
+                {
+                    found |=
+                        FileSystem::DirectoryChangeType::Created == i.type &&
+                        filePath2 == i.path;
+                }
+                DJV_ASSERT(found);
+
+                std::remove(std::string(filePath2).c_str());
+                std::remove(std::string(dirPath2).c_str());
+#endif // DJV_PLATFORM_LINUX
+            }
+        }
+
+        void DirectoryWatcherTest::_printChanges(const std::vector<FileSystem::DirectoryChange>& changes)
+        {
+            for (const auto& i : changes)
+            {
                 std::stringstream ss;
-                ss << "changed: " << changed;
+                ss << "change: " << static_cast<int>(i.type) << " " << i.path;
                 _print(ss.str());
             }
         }
@@ -31,6 +31,8 @@
 
 #include <djvTestLib/TickTest.h>
 
+#include <djvCore/DirectoryWatcher.h>
+
 namespace djv
 {
     namespace CoreTest
@@ -41,6 +43,12 @@ namespace djv
             DirectoryWatcherTest(const std::shared_ptr<Core::Context>&);
             
             void run(const std::vector<std::string>&) override;
+
+        private:
+            void _changes();
+            void _watcher();
+
+            void _printChanges(const std::vector<Core::FileSystem::DirectoryChange>&);
         };
         
     } // namespace CoreTest
@@ -32,6 +32,8 @@
 #include <djvCore/FileIO.h>
 #include <djvCore/FileInfo.h>
 
+#include <chrono>
+
 using namespace djv::Core;
 
 namespace djv
@@ -50,6 +52,7 @@ namespace djv
             _ctor();
             _path();
             _sequences();
+            _fileNameTemplate();
             _util();
             _operators();
             _serialize();
@@ -234,6 +237,78 @@ namespace djv
             }
         }
 
+        void FileInfoTest::_fileNameTemplate()
+        {
+            for (const auto& path : { "/tmp/render.0001-0100.exr", "/tmp/render.1-100.exr", "render.1-100.dpx" })
+            {
+                const FileSystem::FileInfo fileInfo(FileSystem::Path(path), FileSystem::FileType::Sequence, false);
+                DJV_ASSERT(fileInfo.isSequenceValid());
+                for (bool fullPath : { true, false })
+                {
+                    FileSystem::FileNameTemplate fileNameTemplate(fileInfo, fullPath);
+                    for (auto frame : { Frame::invalid, Frame::Number(-12345), Frame::Number(-1), Frame::Number(0), Frame::Number(1), Frame::Number(99), Frame::Number(123456) })
+                    {
+                        DJV_ASSERT(fileInfo.getFileName(frame, fullPath) == fileNameTemplate.get(frame));
+                    }
+
+                    const auto fileNames = fileNameTemplate.toFileNames(Frame::Range(-10, 10));
+                    DJV_ASSERT(21 == fileNames.size());
+                    for (size_t i = 0; i < fileNames.size(); ++i)
+                    {
+                        DJV_ASSERT(fileInfo.getFileName(static_cast<Frame::Number>(i) - 10, fullPath) == fileNames[i]);
+                    }
+
+                    const auto fileNames2 = fileInfo.getFileNames(fullPath);
+                    DJV_ASSERT(100 == fileNames2.size());
+                    for (size_t i = 0; i < fileNames2.size(); ++i)
+                    {
+                        DJV_ASSERT(fileInfo.getFileName(static_cast<Frame::Number>(i) + 1, fullPath) == fileNames2[i]);
+                    }
+                }
+            }
+
+            {
+                const FileSystem::FileInfo fileInfo(FileSystem::Path("/tmp/render.exr"), false);
+                FileSystem::FileNameTemplate fileNameTemplate(fileInfo);
+                DJV_ASSERT(fileInfo.getFileName() == fileNameTemplate.get(1));
+                DJV_ASSERT(1 == fileInfo.getFileNames().size());
+            }
+
+            {
+                const FileSystem::FileInfo fileInfo(FileSystem::Path("/tmp/render.0001-1000.exr"), FileSystem::FileType::Sequence, false);
+                const size_t count = 100000;
+                size_t size = 0;
+                auto start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    size += fileInfo.getFileName(i % 1000 + 1).size();
+                }
+                auto end = std::chrono::steady_clock::now();
+                const std::chrono::duration<float, std::milli> fileInfoTime = end - start;
+                FileSystem::FileNameTemplate fileNameTemplate(fileInfo);
+                start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count; ++i)
+                {
+                    size -= fileNameTemplate.get(i % 1000 + 1).size();
+                }
+                end = std::chrono::steady_clock::now();
+                const std::chrono::duration<float, std::milli> templateTime = end - start;
+                DJV_ASSERT(0 == size);
+                start = std::chrono::steady_clock::now();
+                for (size_t i = 0; i < count / 1000; ++i)
+                {
+                    size += fileNameTemplate.toFileNames(Frame::Range(1, 1000)).size();
+                }
+                end = std::chrono::steady_clock::now();
+                const std::chrono::duration<float, std::milli> bulkTime = end - start;
+                DJV_ASSERT(count == size);
+                std::stringstream ss;
+                ss << count << " file names: FileInfo " << fileInfoTime.count() << "ms, template " <<
+                    templateTime.count() << "ms, bulk " << bulkTime.count() << "ms";
+                _print(ss.str());
+            }
+        }
+
         void FileInfoTest::_util()
         {
             {
@@ -271,6 +346,41 @@ namespace djv
                 _print(ss.str());
                 DJV_ASSERT(fileInfo.getFileName(Frame::invalid, false) == "render.1-3.exr");
             }
+
+            {
+                const FileSystem::Path path(".");
+                const FileSystem::Path framePath(path, "FileInfoTest.1.exr");
+                const FileSystem::Path framePath2(path, "FileInfoTest.2.exr");
+                const FileSystem::Path filePath(path, "FileInfoTest.txt");
+                for (const auto& i : { framePath, framePath2, filePath })
+                {
+                    FileSystem::FileIO io;
+                    io.open(i.get(), FileSystem::FileIO::Mode::Write);
+                }
+                FileSystem::DirectoryListOptions options;
+                options.fileSequences = true;
+                options.fileSequenceExtensions = { ".exr" };
+                auto list = FileSystem::FileInfo::directoryList(path, options);
+                const size_t size = list.size();
+
+                DJV_ASSERT(FileSystem::FileInfo::directoryListUpdate(list, {}, { filePath }, {}, options));
+                DJV_ASSERT(size - 1 == list.size());
+                DJV_ASSERT(FileSystem::FileInfo::directoryListUpdate(list, { filePath, framePath2 }, {}, {}, options));
+                DJV_ASSERT(size == list.size());
+                DJV_ASSERT(FileSystem::FileInfo::directoryListUpdate(list, {}, {}, { filePath }, options));
+                DJV_ASSERT(size == list.size());
+                bool found = false;
+                for (const auto& i : list)
+                {
+                    if ("FileInfoTest.1-2.exr" == i.getFileName(Frame::invalid, false))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                DJV_ASSERT(found);
+                DJV_ASSERT(!FileSystem::FileInfo::directoryListUpdate(list, {}, { framePath2 }, {}, options));
+            }
             
             {
                 FileSystem::Path path;
@@ -47,6 +47,7 @@ namespace djv
             void _ctor();
             void _path();
             void _sequences();
+            void _fileNameTemplate();
             void _util();
             void _operators();
             void _serialize();
@@ -31,6 +31,7 @@
 
 #include <djvCore/Frame.h>
 
+#include <chrono>
 #include <iostream>
 #include <sstream>
 
@@ -47,16 +48,18 @@ namespace djv
         void FrameTest::run(const std::vector<std::string>& args)
         {
             _sequence();
+            _index();
             _util();
             _conversion();
             _serialize();
+            _benchmark();
         }
 
         void FrameTest::_sequence()
         {
             {
                 const Frame::Sequence sequence;
-                DJV_ASSERT(0 == sequence.ranges.size());
+                DJV_ASSERT(0 == sequence.getRanges().size());
                 DJV_ASSERT(0 == sequence.pad);
                 DJV_ASSERT(!sequence.isValid());
                 DJV_ASSERT(!sequence.contains(0));
@@ -67,7 +70,7 @@ namespace djv
             
             {
                 const Frame::Sequence sequence(Frame::Range(0, 99), 4);
-                DJV_ASSERT(1 == sequence.ranges.size());
+                DJV_ASSERT(1 == sequence.getRanges().size());
                 DJV_ASSERT(4 == sequence.pad);
                 DJV_ASSERT(sequence.isValid());
                 DJV_ASSERT(sequence.contains(0));
@@ -78,7 +81,7 @@ namespace djv
             
             {
                 const Frame::Sequence sequence({ Frame::Range(0, 9), Frame::Range(10, 99) }, 4);
-                DJV_ASSERT(2 == sequence.ranges.size());
+                DJV_ASSERT(2 == sequence.getRanges().size());
                 DJV_ASSERT(4 == sequence.pad);
                 DJV_ASSERT(sequence.isValid());
                 DJV_ASSERT(sequence.contains(0));
@@ -90,16 +93,83 @@ namespace djv
             {
                 Frame::Sequence sequence({ Frame::Range(10, 9), Frame::Range(3, 1) });
                 sequence.sort();
-                DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 3));
-                DJV_ASSERT(sequence.ranges[1] == Frame::Range(9, 10));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 3));
+                DJV_ASSERT(sequence.getRanges()[1] == Frame::Range(9, 10));
             }
             
             {
                 Frame::Sequence sequence(Frame::Range(1, 3));
                 sequence.merge(Frame::Range(3, 10));
-                DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 10));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
                 sequence.merge(Frame::Range(12, 100));
-                DJV_ASSERT(sequence.ranges[0] == Frame::Range(1, 10));
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 10));
+            }
+
+            {
+                Frame::Sequence sequence({ Frame::Range(1, 3), Frame::Range(10, 12), Frame::Range(20) });
+                DJV_ASSERT(sequence.merge(Frame::Range(4, 9)));
+                DJV_ASSERT(2 == sequence.getRanges().size());
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 12));
+                DJV_ASSERT(13 == sequence.getSize());
+                DJV_ASSERT(12 == sequence.getIndex(20));
+            }
+
+            {
+                Frame::Sequence sequence;
+                sequence.add(Frame::Range(5));
+                sequence.add(Frame::Range(1));
+                sequence.add(Frame::Range(3));
+                sequence.add(Frame::Range(2));
+                sequence.add(Frame::Range(4));
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(sequence.getRanges()[0] == Frame::Range(1, 5));
+            }
+
+            {
+                Frame::Sequence sequence;
+                sequence.setRanges({ Frame::Range(1, 3), Frame::Range(5, 6) });
+                DJV_ASSERT(5 == sequence.getSize());
+                sequence.addRange(Frame::Range(8));
+                DJV_ASSERT(6 == sequence.getSize());
+                DJV_ASSERT(8 == sequence.getFrame(5));
+                DJV_ASSERT(5 == sequence.getIndex(8));
+            }
+        }
+
+        void FrameTest::_index()
+        {
+            {
+                std::vector<Frame::Range> ranges;
+                for (Frame::Number i = 0; i < 1000; ++i)
+                {
+                    ranges.push_back(Frame::Range(i * 10, i * 10 + 4));
+                }
+                const Frame::Sequence sequence(ranges);
+                DJV_ASSERT(5000 == sequence.getSize());
+                for (Frame::Index i = 0; i < 5000; ++i)
+                {
+                    const Frame::Number frame = sequence.getFrame(i);
+                    DJV_ASSERT(frame == (i / 5) * 10 + i % 5);
+                    DJV_ASSERT(i == sequence.getIndex(frame));
+                    DJV_ASSERT(sequence.contains(frame));
+                }
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(-1));
+                DJV_ASSERT(Frame::invalid == sequence.getFrame(5000));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(5));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(-1));
+                DJV_ASSERT(Frame::invalidIndex == sequence.getIndex(10000));
+                DJV_ASSERT(!sequence.contains(5));
+            }
+
+            {
+                // Ranges that are not in order use a linear search.
+                const Frame::Sequence sequence({ Frame::Range(10, 12), Frame::Range(1, 3) });
+                DJV_ASSERT(6 == sequence.getSize());
+                DJV_ASSERT(10 == sequence.getFrame(0));
+                DJV_ASSERT(1 == sequence.getFrame(3));
+                DJV_ASSERT(3 == sequence.getIndex(1));
+                DJV_ASSERT(sequence.contains(2));
+                DJV_ASSERT(!sequence.contains(5));
             }
         }
         
@@ -129,7 +199,7 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(0 == sequence.ranges.size());
+                DJV_ASSERT(0 == sequence.getRanges().size());
             }
             
             {
@@ -140,9 +210,9 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(1 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(1 == sequence.ranges[0].max);
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(1 == sequence.getRanges()[0].max);
             }
             
             {
@@ -153,9 +223,9 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(1 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(3 == sequence.ranges[0].max);
+                DJV_ASSERT(1 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(3 == sequence.getRanges()[0].max);
             }
             
             {
@@ -166,11 +236,11 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(2 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(1 == sequence.ranges[0].max);
-                DJV_ASSERT(3 == sequence.ranges[1].min);
-                DJV_ASSERT(3 == sequence.ranges[1].max);
+                DJV_ASSERT(2 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(1 == sequence.getRanges()[0].max);
+                DJV_ASSERT(3 == sequence.getRanges()[1].min);
+                DJV_ASSERT(3 == sequence.getRanges()[1].max);
             }
             
             {
@@ -181,13 +251,13 @@ namespace djv
                     ss << sequence;
                     _print(ss.str());
                 }
-                DJV_ASSERT(3 == sequence.ranges.size());
-                DJV_ASSERT(1 == sequence.ranges[0].min);
-                DJV_ASSERT(3 == sequence.ranges[0].max);
-                DJV_ASSERT(5 == sequence.ranges[1].min);
-                DJV_ASSERT(6 == sequence.ranges[1].max);
-                DJV_ASSERT(8 == sequence.ranges[2].min);
-                DJV_ASSERT(8 == sequence.ranges[2].max);
+                DJV_ASSERT(3 == sequence.getRanges().size());
+                DJV_ASSERT(1 == sequence.getRanges()[0].min);
+                DJV_ASSERT(3 == sequence.getRanges()[0].max);
+                DJV_ASSERT(5 == sequence.getRanges()[1].min);
+                DJV_ASSERT(6 == sequence.getRanges()[1].max);
+                DJV_ASSERT(8 == sequence.getRanges()[2].min);
+                DJV_ASSERT(8 == sequence.getRanges()[2].max);
             }
             
             {
@@ -250,6 +320,83 @@ namespace djv
                 DJV_ASSERT(range == range2);
             }
         }
+
+        void FrameTest::_benchmark()
+        {
+            // Create a sequence with many ranges, like a render with missing
+            // frames.
+            const size_t rangeCount = 10000;
+            std::vector<Frame::Number> frames;
+            for (size_t i = 0; i < rangeCount; ++i)
+            {
+                for (size_t j = 0; j < 3; ++j)
+                {
+                    frames.push_back(i * 4 + j);
+                }
+            }
+
+            auto t0 = std::chrono::steady_clock::now();
+            const Frame::Sequence sequence = Frame::fromFrames(frames);
+            auto t1 = std::chrono::steady_clock::now();
+            DJV_ASSERT(rangeCount == sequence.getRanges().size());
+            {
+                std::stringstream ss;
+                ss << "fromFrames: " << std::chrono::duration<float, std::milli>(t1 - t0).count() << "ms";
+                _print(ss.str());
+            }
+
+            t0 = std::chrono::steady_clock::now();
+            const size_t size = sequence.getSize();
+            Frame::Number sum = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                sum += sequence.getIndex(sequence.getFrame(i));
+            }
+            t1 = std::chrono::steady_clock::now();
+            DJV_ASSERT(static_cast<Frame::Number>(size * (size - 1) / 2) == sum);
+            {
+                std::stringstream ss;
+                ss << "getFrame/getIndex: " << std::chrono::duration<float, std::milli>(t1 - t0).count() << "ms";
+                _print(ss.str());
+            }
+
+            t0 = std::chrono::steady_clock::now();
+            const auto frames2 = Frame::toFrames(sequence);
+            t1 = std::chrono::steady_clock::now();
+            DJV_ASSERT(frames == frames2);
+            {
+                std::stringstream ss;
+                ss << "toFrames: " << std::chrono::duration<float, std::milli>(t1 - t0).count() << "ms";
+                _print(ss.str());
+            }
+
+            // Add the frames in reverse order as individual ranges.
+            t0 = std::chrono::steady_clock::now();
+            Frame::Sequence sequence2;
+            for (auto i = frames.rbegin(); i != frames.rend(); ++i)
+            {
+                sequence2.add(Frame::Range(*i));
+            }
+            t1 = std::chrono::steady_clock::now();
+            DJV_ASSERT(sequence == sequence2);
+            {
+                std::stringstream ss;
+                ss << "add: " << std::chrono::duration<float, std::milli>(t1 - t0).count() << "ms";
+                _print(ss.str());
+            }
+
+            t0 = std::chrono::steady_clock::now();
+            Frame::Sequence sequence3(sequence.getRanges());
+            sequence3.addRange(Frame::Range(-10, -5));
+            sequence3.sort();
+            t1 = std::chrono::steady_clock::now();
+            DJV_ASSERT(rangeCount + 1 == sequence3.getRanges().size());
+            {
+                std::stringstream ss;
+                ss << "sort: " << std::chrono::duration<float, std::milli>(t1 - t0).count() << "ms";
+                _print(ss.str());
+            }
+        }
                 
     } // namespace CoreTest
 } // namespace djv
@@ -44,9 +44,11 @@ namespace djv
             
         private:
             void _sequence();
+            void _index();
             void _util();
             void _conversion();
             void _serialize();
+            void _benchmark();
         };
         
     } // namespace CoreTest
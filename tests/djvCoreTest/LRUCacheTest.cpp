@@ -0,0 +1,210 @@
+//------------------------------------------------------------------------------
+// Copyright (c) 2004-2019 Darby Johnston
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions, and the following disclaimer.
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions, and the following disclaimer in the documentation
+//   and/or other materials provided with the distribution.
+// * Neither the names of the copyright holders nor the names of any
+//   contributors may be used to endorse or promote products derived from this
+//   software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//------------------------------------------------------------------------------
+
+#include <djvCoreTest/LRUCacheTest.h>
+
+#include <djvCore/LRUCache.h>
+
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+using namespace djv::Core;
+
+namespace djv
+{
+    namespace CoreTest
+    {
+        LRUCacheTest::LRUCacheTest(const std::shared_ptr<Core::Context>& context) :
+            ITest("djv::CoreTest::LRUCacheTest", context)
+        {}
+        
+        void LRUCacheTest::run(const std::vector<std::string>& args)
+        {
+            _cache();
+            _cost();
+            _sharded();
+            _throughput();
+        }
+
+        void LRUCacheTest::_cache()
+        {
+            {
+                Memory::LRUCache<int, std::string> cache;
+                cache.add(1, "a");
+                cache.add(2, "b");
+                cache.add(3, "c");
+                DJV_ASSERT(3 == cache.getSize());
+                DJV_ASSERT(cache.contains(2));
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3, 2, 1 }));
+                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "c", "b", "a" }));
+                std::string value;
+                DJV_ASSERT(!cache.get(0, value));
+                DJV_ASSERT(cache.get(1, value));
+                DJV_ASSERT("a" == value);
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 1, 3, 2 }));
+                DJV_ASSERT(1 == cache.getHitCount());
+                DJV_ASSERT(1 == cache.getMissCount());
+                cache.resetCounters();
+                DJV_ASSERT(0 == cache.getHitCount());
+                DJV_ASSERT(0 == cache.getMissCount());
+            }
+            
+            {
+                Memory::LRUCache<int, std::string> cache;
+                cache.setMax(2);
+                cache.add(1, "a");
+                cache.add(2, "b");
+                cache.add(3, "c");
+                std::string value;
+                DJV_ASSERT(!cache.get(1, value));
+                DJV_ASSERT(cache.get(2, value));
+                DJV_ASSERT(value == "b");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
+                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "b", "c" }));
+                DJV_ASSERT(100.F == cache.getPercentageUsed());
+                cache.add(4, "d");
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 4, 2 }));
+            }
+
+            {
+                Memory::LRUCache<int, std::string> cache;
+                cache.add(1, "a");
+                cache.add(2, "b");
+                cache.add(1, "c");
+                DJV_ASSERT(2 == cache.getSize());
+                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 1, 2 }));
+                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "c", "b" }));
+                cache.remove(1);
+                DJV_ASSERT(!cache.contains(1));
+                DJV_ASSERT(1 == cache.getSize());
+                DJV_ASSERT(1 == cache.getCost());
+                cache.clear();
+                DJV_ASSERT(0 == cache.getSize());
+                DJV_ASSERT(0 == cache.getCost());
+            }
+        }
+
+        void LRUCacheTest::_cost()
+        {
+            Memory::LRUCache<int, std::string> cache;
+            cache.setMax(10);
+            cache.setCostFunction(
+                [](const std::string& value)
+                {
+                    return value.size();
+                });
+            cache.add(1, "aaaa");
+            cache.add(2, "bbbb");
+            DJV_ASSERT(8 == cache.getCost());
+            DJV_ASSERT(80.F == cache.getPercentageUsed());
+            cache.add(3, "cccc");
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 3, 2 }));
+            DJV_ASSERT(8 == cache.getCost());
+            cache.add(2, "bb");
+            DJV_ASSERT(6 == cache.getCost());
+            cache.setMax(4);
+            DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2 }));
+            DJV_ASSERT(2 == cache.getCost());
+        }
+
+        void LRUCacheTest::_sharded()
+        {
+            {
+                Memory::ShardedLRUCache<int, int> cache(4);
+                DJV_ASSERT(4 == cache.getShardCount());
+                cache.setMax(100);
+                DJV_ASSERT(100 == cache.getMax());
+                for (int i = 0; i < 10; ++i)
+                {
+                    cache.add(i, i * 2);
+                }
+                DJV_ASSERT(10 == cache.getSize());
+                int value = 0;
+                DJV_ASSERT(cache.get(5, value));
+                DJV_ASSERT(10 == value);
+                DJV_ASSERT(!cache.get(10, value));
+                DJV_ASSERT(1 == cache.getHitCount());
+                DJV_ASSERT(1 == cache.getMissCount());
+                cache.remove(5);
+                DJV_ASSERT(!cache.contains(5));
+                cache.clear();
+                DJV_ASSERT(0 == cache.getSize());
+            }
+
+            {
+                Memory::ShardedLRUCache<int, int> cache;
+                cache.setMax(1000);
+                std::vector<std::thread> threads;
+                for (int t = 0; t < 4; ++t)
+                {
+                    threads.push_back(std::thread(
+                        [&cache, t]
+                        {
+                            for (int i = 0; i < 10000; ++i)
+                            {
+                                const int key = t * 10000 + i;
+                                cache.add(key, key);
+                                int value = 0;
+                                cache.get(key, value);
+                            }
+                        }));
+                }
+                for (auto& i : threads)
+                {
+                    i.join();
+                }
+                DJV_ASSERT(cache.getSize() <= 1000 + cache.getShardCount());
+                DJV_ASSERT(40000 == cache.getHitCount() + cache.getMissCount());
+            }
+        }
+
+        void LRUCacheTest::_throughput()
+        {
+            const size_t count = 1000000;
+            Memory::LRUCache<size_t, size_t> cache;
+            cache.setMax(count / 10);
+            const auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                cache.add(i, i);
+                size_t value = 0;
+                cache.get(i / 2, value);
+            }
+            const auto end = std::chrono::steady_clock::now();
+            const std::chrono::duration<float> delta = end - start;
+            std::stringstream ss;
+            ss << "throughput: " << (delta.count() > 0.F ? (count * 2 / delta.count()) : 0.F) << " ops/sec, " <<
+                "hits: " << cache.getHitCount() << ", misses: " << cache.getMissCount();
+            _print(ss.str());
+        }
+        
+    } // namespace CoreTest
+} // namespace djv
+
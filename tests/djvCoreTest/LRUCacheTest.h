@@ -27,46 +27,27 @@
 // POSSIBILITY OF SUCH DAMAGE.
 //------------------------------------------------------------------------------
 
-#include <djvCoreTest/CacheTest.h>
+#pragma once
 
-#include <djvCore/Cache.h>
-
-using namespace djv::Core;
+#include <djvTestLib/Test.h>
 
 namespace djv
 {
     namespace CoreTest
     {
-        CacheTest::CacheTest(const std::shared_ptr<Core::Context>& context) :
-            ITest("djv::CoreTest::CacheTest", context)
-        {}
-        
-        void CacheTest::run(const std::vector<std::string>& args)
+        class LRUCacheTest : public Test::ITest
         {
-            {
-                Memory::Cache<int, std::string> cache;
-                cache.add(1, "a");
-                cache.add(2, "b");
-                cache.add(3, "c");
-                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 1, 2, 3 }));
-                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "a", "b", "c" }));
-                std::string key;
-                DJV_ASSERT(!cache.get(0, key));
-            }
+        public:
+            LRUCacheTest(const std::shared_ptr<Core::Context>&);
             
-            {
-                Memory::Cache<int, std::string> cache;
-                cache.setMax(2);
-                cache.add(1, "a");
-                cache.add(2, "b");
-                cache.add(3, "c");
-                std::string value;
-                cache.get(2, value);
-                DJV_ASSERT(value == "b");
-                DJV_ASSERT(cache.getKeys() == std::vector<int>({ 2, 3 }));
-                DJV_ASSERT(cache.getValues() == std::vector<std::string>({ "b", "c" }));
-            }
-        }
+            void run(const std::vector<std::string>&) override;
+
+        private:
+            void _cache();
+            void _cost();
+            void _sharded();
+            void _throughput();
+        };
         
     } // namespace CoreTest
 } // namespace djv
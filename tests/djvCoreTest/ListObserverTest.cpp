@@ -31,6 +31,9 @@
 
 #include <djvCore/ListObserver.h>
 
+#include <chrono>
+#include <sstream>
+
 using namespace djv::Core;
 
 namespace djv
@@ -42,6 +45,43 @@ namespace djv
         {}
         
         void ListObserverTest::run(const std::vector<std::string>& args)
+        {
+            _observer();
+            _changes();
+            _benchmark();
+        }
+
+        namespace
+        {
+            void applyChanges(std::vector<int>& out, const std::vector<int>& value, const std::vector<ListChange>& changes)
+            {
+                for (const auto& i : changes)
+                {
+                    switch (i.type)
+                    {
+                    case ListChangeType::Reset:
+                        out = value;
+                        break;
+                    case ListChangeType::Insert:
+                        out.insert(out.begin() + i.index, value.begin() + i.index, value.begin() + i.index + i.count);
+                        break;
+                    case ListChangeType::Remove:
+                        out.erase(out.begin() + i.index, out.begin() + i.index + i.count);
+                        break;
+                    case ListChangeType::Update:
+                        for (size_t j = i.index; j < i.index + i.count; ++j)
+                        {
+                            out[j] = value[j];
+                        }
+                        break;
+                    default: break;
+                    }
+                }
+            }
+
+        } // namespace
+
+        void ListObserverTest::_observer()
         {
             std::vector<int> value;
             auto subject = ListSubject<int>::create(value);
@@ -71,6 +111,138 @@ namespace djv
             }
             DJV_ASSERT(0 == subject->getObserversCount());
         }
+
+        void ListObserverTest::_changes()
+        {
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 2, 3 }), std::vector<int>({ 1, 2, 3 })).empty());
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 2, 3 }), std::vector<int>({ 1, 4, 2, 3 })) ==
+                std::vector<ListChange>({ ListChange(ListChangeType::Insert, 1, 1) }));
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 2, 3 }), std::vector<int>({ 1, 3 })) ==
+                std::vector<ListChange>({ ListChange(ListChangeType::Remove, 1, 1) }));
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 2, 3 }), std::vector<int>({ 1, 4, 3 })) ==
+                std::vector<ListChange>({ ListChange(ListChangeType::Update, 1, 1) }));
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 2, 3 }), std::vector<int>({ 4, 5, 6, 7, 8 })) ==
+                std::vector<ListChange>({
+                    ListChange(ListChangeType::Update, 0, 3),
+                    ListChange(ListChangeType::Insert, 3, 2) }));
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 2, 3, 4 }), std::vector<int>()) ==
+                std::vector<ListChange>({ ListChange(ListChangeType::Remove, 0, 4) }));
+            DJV_ASSERT(getListChanges(std::vector<int>({ 1, 1 }), std::vector<int>({ 1, 1, 1 })) ==
+                std::vector<ListChange>({ ListChange(ListChangeType::Insert, 2, 1) }));
+
+            auto subject = ListSubject<int>::create(std::vector<int>({ 1, 2, 3 }));
+            std::vector<int> mirror;
+            std::vector<ListChange> changes;
+            auto observer = ListObserver<int>::createChanges(
+                subject,
+                [&mirror, &changes](const std::vector<int>& value, const std::vector<ListChange>& value2)
+                {
+                    applyChanges(mirror, value, value2);
+                    changes = value2;
+                });
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Reset, 0, 3) }));
+            DJV_ASSERT(subject->get() == mirror);
+
+            subject->pushBack(4);
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Insert, 3, 1) }));
+            DJV_ASSERT(subject->get() == mirror);
+            subject->insertItems(1, { 5, 6 });
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Insert, 1, 2) }));
+            DJV_ASSERT(subject->get() == mirror);
+            subject->removeItems(0, 2);
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Remove, 0, 2) }));
+            DJV_ASSERT(subject->get() == mirror);
+            subject->setItem(1, 7);
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Update, 1, 1) }));
+            DJV_ASSERT(subject->get() == mirror);
+            subject->removeItem(0);
+            DJV_ASSERT(subject->get() == mirror);
+            DJV_ASSERT(subject->setIfChanged(std::vector<int>({ 8, 7, 3, 9, 10 })));
+            DJV_ASSERT(subject->get() == mirror);
+            subject->clear();
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Remove, 0, 5) }));
+            DJV_ASSERT(subject->get() == mirror);
+            subject->setAlways(std::vector<int>({ 1, 2 }));
+            DJV_ASSERT(changes == std::vector<ListChange>({ ListChange(ListChangeType::Reset, 0, 2) }));
+            DJV_ASSERT(subject->get() == mirror);
+
+            std::vector<int> value;
+            auto observer2 = ListObserver<int>::create(
+                subject,
+                [&value](const std::vector<int>& value2)
+                {
+                    value = value2;
+                });
+            subject->pushBack(3);
+            DJV_ASSERT(subject->get() == value);
+            DJV_ASSERT(subject->get() == mirror);
+        }
+
+        void ListObserverTest::_benchmark()
+        {
+            const size_t size = 100000;
+            const size_t count = 100;
+            std::vector<int> value(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                value[i] = static_cast<int>(i);
+            }
+            auto subject = ListSubject<int>::create(value);
+
+            size_t copies = 0;
+            auto observer = ListObserver<int>::create(
+                subject,
+                [&copies](const std::vector<int>& value)
+                {
+                    std::vector<int> tmp = value;
+                    copies += tmp.size();
+                });
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                subject->pushBack(static_cast<int>(i));
+            }
+            auto end = std::chrono::steady_clock::now();
+            std::chrono::duration<float> fullDelta = end - start;
+            observer.reset();
+
+            std::vector<int> mirror;
+            auto observer2 = ListObserver<int>::createChanges(
+                subject,
+                [&mirror](const std::vector<int>& value, const std::vector<ListChange>& changes)
+                {
+                    applyChanges(mirror, value, changes);
+                });
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                subject->pushBack(static_cast<int>(i));
+            }
+            end = std::chrono::steady_clock::now();
+            std::chrono::duration<float> changesDelta = end - start;
+            DJV_ASSERT(subject->get() == mirror);
+
+            start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto tmp = subject->get();
+                tmp[tmp.size() / 2] = -static_cast<int>(i);
+                subject->setIfChanged(std::move(tmp));
+            }
+            end = std::chrono::steady_clock::now();
+            std::chrono::duration<float> diffDelta = end - start;
+            DJV_ASSERT(subject->get() == mirror);
+
+            std::stringstream ss;
+            ss << "full list notifications (" << size << " items): " << (fullDelta.count() * 1000.F / count) << "ms";
+            _print(ss.str());
+            ss.str(std::string());
+            ss << "change notifications (" << size << " items): " << (changesDelta.count() * 1000.F / count) << "ms";
+            _print(ss.str());
+            ss.str(std::string());
+            ss << "diffed notifications (" << size << " items): " << (diffDelta.count() * 1000.F / count) << "ms";
+            _print(ss.str());
+        }
         
     } // namespace CoreTest
 } // namespace djv
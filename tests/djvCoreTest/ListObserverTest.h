@@ -41,6 +41,11 @@ namespace djv
             ListObserverTest(const std::shared_ptr<Core::Context>&);
             
             void run(const std::vector<std::string>&) override;
+
+        private:
+            void _observer();
+            void _changes();
+            void _benchmark();
         };
         
     } // namespace CoreTest
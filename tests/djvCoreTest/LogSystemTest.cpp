@@ -32,6 +32,9 @@
 #include <djvCore/Context.h>
 #include <djvCore/LogSystem.h>
 
+#include <sstream>
+#include <thread>
+
 using namespace djv::Core;
 
 namespace djv
@@ -78,7 +81,61 @@ namespace djv
 
                 _tickFor(std::chrono::milliseconds(500));
 
+                size_t historyPos = 0;
+                {
+                    const auto history = system->getHistory(historyPos);
+                    DJV_ASSERT(history.size() >= 3);
+                    const auto& error = history[history.size() - 1];
+                    DJV_ASSERT("LogSystemTest" == error.prefix);
+                    DJV_ASSERT("Error" == error.text);
+                    DJV_ASSERT(LogLevel::Error == error.level);
+                    DJV_ASSERT(LogLevel::Warning == history[history.size() - 2].level);
+                    DJV_ASSERT(system->getHistory(historyPos).empty());
+                }
+
                 system->setConsoleOutput(false);
+
+                DJV_ASSERT(LogLevel::Information == system->getVerbosity());
+                DJV_ASSERT(system->isEnabled(LogLevel::Information));
+                system->setVerbosity(LogLevel::Warning);
+                DJV_ASSERT(!system->isEnabled(LogLevel::Information));
+                DJV_ASSERT(system->isEnabled(LogLevel::Error));
+                const size_t writtenCount = system->getWrittenCount();
+                system->log("LogSystemTest", "Filtered");
+                system->log("LogSystemTest", "Warning", LogLevel::Warning);
+                system->setVerbosity(LogLevel::Information);
+
+                std::vector<std::thread> threads;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    threads.push_back(std::thread(
+                        [system]
+                        {
+                            for (size_t j = 0; j < 10000; ++j)
+                            {
+                                system->log("LogSystemTest", "Message");
+                            }
+                        }));
+                }
+                for (auto& i : threads)
+                {
+                    i.join();
+                }
+
+                _tickFor(std::chrono::milliseconds(2000));
+
+                {
+                    std::stringstream ss;
+                    ss << "written: " << system->getWrittenCount() - writtenCount << ", dropped: " << system->getDroppedCount();
+                    _print(ss.str());
+                }
+                DJV_ASSERT(system->getWrittenCount() - writtenCount + system->getDroppedCount() >= 40001);
+
+                {
+                    const auto history = system->getHistory(historyPos);
+                    DJV_ASSERT(history.size() > 0);
+                    DJV_ASSERT(history.size() <= 10000);
+                }
             }
         }
                 
@@ -79,6 +79,41 @@ namespace djv
                 DJV_ASSERT(subject->isEmpty());
             }
             DJV_ASSERT(0 == subject->getObserversCount());
+
+            {
+                MapChanges<int> changes = getMapChanges(
+                    std::map<int, std::string>({ { 1, "one" }, { 2, "two" }, { 3, "three" } }),
+                    std::map<int, std::string>({ { 2, "Two" }, { 3, "three" }, { 4, "four" } }));
+                DJV_ASSERT(std::vector<int>({ 4 }) == changes.inserted);
+                DJV_ASSERT(std::vector<int>({ 1 }) == changes.removed);
+                DJV_ASSERT(std::vector<int>({ 2 }) == changes.updated);
+                DJV_ASSERT(!changes.reset);
+                DJV_ASSERT(getMapChanges(value, value).isEmpty());
+            }
+
+            {
+                MapChanges<int> changes;
+                auto observer = MapObserver<int, std::string>::createChanges(
+                    subject,
+                    [&changes](const std::map<int, std::string>&, const MapChanges<int>& value)
+                    {
+                        changes = value;
+                    });
+                DJV_ASSERT(changes.reset);
+                subject->setItem(1, "one");
+                DJV_ASSERT(std::vector<int>({ 1 }) == changes.inserted);
+                subject->setItem(1, "One");
+                DJV_ASSERT(std::vector<int>({ 1 }) == changes.updated);
+                DJV_ASSERT(subject->setIfChanged(std::map<int, std::string>({ { 1, "One" }, { 2, "two" } })));
+                DJV_ASSERT(std::vector<int>({ 2 }) == changes.inserted);
+                DJV_ASSERT(changes.updated.empty());
+                subject->removeItem(1);
+                DJV_ASSERT(std::vector<int>({ 1 }) == changes.removed);
+                subject->clear();
+                DJV_ASSERT(std::vector<int>({ 2 }) == changes.removed);
+                subject->setAlways(std::map<int, std::string>({ { 3, "three" } }));
+                DJV_ASSERT(changes.reset);
+            }
         }
         
     } // namespace CoreTest
@@ -31,7 +31,10 @@
 
 #include <djvCore/Memory.h>
 
+#include <chrono>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 using namespace djv::Core;
 
@@ -48,6 +51,7 @@ namespace djv
             _label();
             _enum();
             _endian();
+            _endianBlock();
             _hash();
         }
         
@@ -170,6 +174,70 @@ namespace djv
             }
         }
         
+        namespace
+        {
+            void endianReference(const uint8_t* in, uint8_t* out, size_t size, size_t wordSize)
+            {
+                for (size_t i = 0; i < size; ++i, in += wordSize, out += wordSize)
+                {
+                    for (size_t j = 0; j < wordSize; ++j)
+                    {
+                        out[j] = in[wordSize - 1 - j];
+                    }
+                }
+            }
+
+        } // namespace
+
+        void MemoryTest::_endianBlock()
+        {
+            for (size_t wordSize : { 2, 4, 8 })
+            {
+                for (size_t offset = 0; offset < 3; ++offset)
+                {
+                    for (size_t size = 1; size < 80; ++size)
+                    {
+                        std::vector<uint8_t> in(size * wordSize + offset);
+                        for (size_t i = 0; i < in.size(); ++i)
+                        {
+                            in[i] = static_cast<uint8_t>(i * 31 + size);
+                        }
+                        std::vector<uint8_t> reference(in.size());
+                        endianReference(in.data() + offset, reference.data() + offset, size, wordSize);
+
+                        std::vector<uint8_t> out(in.size());
+                        Memory::endian(in.data() + offset, out.data() + offset, size, wordSize);
+                        DJV_ASSERT(0 == memcmp(out.data() + offset, reference.data() + offset, size * wordSize));
+
+                        out = in;
+                        Memory::endian(out.data() + offset, size, wordSize);
+                        DJV_ASSERT(0 == memcmp(out.data() + offset, reference.data() + offset, size * wordSize));
+                    }
+                }
+            }
+
+            {
+                const size_t byteCount = 64 * Memory::megabyte;
+                std::vector<uint8_t> in(byteCount);
+                std::vector<uint8_t> out(byteCount);
+                for (size_t wordSize : { 2, 4, 8 })
+                {
+                    auto t0 = std::chrono::steady_clock::now();
+                    endianReference(in.data(), out.data(), byteCount / wordSize, wordSize);
+                    auto t1 = std::chrono::steady_clock::now();
+                    Memory::endian(in.data(), out.data(), byteCount / wordSize, wordSize);
+                    auto t2 = std::chrono::steady_clock::now();
+                    const std::chrono::duration<float> reference = t1 - t0;
+                    const std::chrono::duration<float> block = t2 - t1;
+                    std::stringstream ss;
+                    ss << "endian " << wordSize << " byte words: " <<
+                        static_cast<size_t>(byteCount / Memory::megabyte / reference.count()) << " MB/s (scalar), " <<
+                        static_cast<size_t>(byteCount / Memory::megabyte / block.count()) << " MB/s";
+                    _print(ss.str());
+                }
+            }
+        }
+        
         void MemoryTest::_hash()
         {
             size_t hash = 0;
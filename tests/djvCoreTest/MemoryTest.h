@@ -46,6 +46,7 @@ namespace djv
             void _label();
             void _enum();
             void _endian();
+            void _endianBlock();
             void _hash();
         };
         
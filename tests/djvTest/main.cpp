@@ -29,7 +29,6 @@
 
 #include <djvCoreTest/AnimationTest.h>
 #include <djvCoreTest/BBoxTest.h>
-#include <djvCoreTest/CacheTest.h>
 #include <djvCoreTest/ContextTest.h>
 #include <djvCoreTest/DirectoryModelTest.h>
 #include <djvCoreTest/DirectoryWatcherTest.h>
@@ -42,6 +41,7 @@
 #include <djvCoreTest/FrameTest.h>
 #include <djvCoreTest/IEventSystemTest.h>
 #include <djvCoreTest/ISystemTest.h>
+#include <djvCoreTest/LRUCacheTest.h>
 #include <djvCoreTest/ListObserverTest.h>
 #include <djvCoreTest/LogSystemTest.h>
 #include <djvCoreTest/MapObserverTest.h>
@@ -68,10 +68,16 @@
 #include <djvAVTest/IOTest.h>
 #include <djvAVTest/ImageConvertTest.h>
 #include <djvAVTest/ImageDataTest.h>
+#include <djvAVTest/ImageDiffTest.h>
+#include <djvAVTest/ImagePyramidTest.h>
+#include <djvAVTest/ImageResampleTest.h>
 #include <djvAVTest/ImageTest.h>
+#include <djvAVTest/OCIOProcessorTest.h>
 #include <djvAVTest/OCIOSystemTest.h>
 #include <djvAVTest/OCIOTest.h>
+#include <djvAVTest/OpenGLPixelBufferTest.h>
 #include <djvAVTest/PixelTest.h>
+#include <djvAVTest/PrefetchControllerTest.h>
 #include <djvAVTest/Render2DTest.h>
 #include <djvAVTest/ThumbnailSystemTest.h>
 #include <djvAVTest/TagsTest.h>
@@ -82,6 +88,7 @@
 #include <djvUI/UISystem.h>
 
 #include <djvAV/AVSystem.h>
+#include <djvAV/GLFWSystem.h>
 
 #include <djvCore/Context.h>
 #include <djvCore/Error.h>
@@ -100,12 +107,13 @@ int main(int argc, char ** argv)
         }
         auto context = Core::Context::create(args);
         auto avSystem = AV::AVSystem::create(context);
+        // The tests use OpenGL directly, so GLFW is created before them.
+        auto glfwSystem = context->getSystemT<AV::GLFW::System>();
         auto uiSystem = UI::UISystem::create(context);
         
         std::vector<std::shared_ptr<Test::ITest> > tests;
         tests.emplace_back(new CoreTest::AnimationTest(context));
         tests.emplace_back(new CoreTest::BBoxTest(context));
-        tests.emplace_back(new CoreTest::CacheTest(context));
         tests.emplace_back(new CoreTest::DirectoryModelTest(context));
         tests.emplace_back(new CoreTest::DirectoryWatcherTest(context));
         tests.emplace_back(new CoreTest::DrivesModelTest(context));
@@ -117,6 +125,7 @@ int main(int argc, char ** argv)
         tests.emplace_back(new CoreTest::FrameTest(context));
         tests.emplace_back(new CoreTest::IEventSystemTest(context));
         tests.emplace_back(new CoreTest::ISystemTest(context));
+        tests.emplace_back(new CoreTest::LRUCacheTest(context));
         tests.emplace_back(new CoreTest::ListObserverTest(context));
         tests.emplace_back(new CoreTest::LogSystemTest(context));
         tests.emplace_back(new CoreTest::MapObserverTest(context));
@@ -143,10 +152,16 @@ int main(int argc, char ** argv)
         tests.emplace_back(new AVTest::IOTest(context));
         tests.emplace_back(new AVTest::ImageConvertTest(context));
         tests.emplace_back(new AVTest::ImageDataTest(context));
+        tests.emplace_back(new AVTest::ImageDiffTest(context));
+        tests.emplace_back(new AVTest::ImagePyramidTest(context));
+        tests.emplace_back(new AVTest::ImageResampleTest(context));
         tests.emplace_back(new AVTest::ImageTest(context));
+        tests.emplace_back(new AVTest::OCIOProcessorTest(context));
         tests.emplace_back(new AVTest::OCIOSystemTest(context));
         tests.emplace_back(new AVTest::OCIOTest(context));
+        tests.emplace_back(new AVTest::OpenGLPixelBufferTest(context));
         tests.emplace_back(new AVTest::PixelTest(context));
+        tests.emplace_back(new AVTest::PrefetchControllerTest(context));
         tests.emplace_back(new AVTest::Render2DTest(context));
         tests.emplace_back(new AVTest::ThumbnailSystemTest(context));
         tests.emplace_back(new AVTest::TagsTest(context));